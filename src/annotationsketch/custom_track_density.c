@@ -0,0 +1,155 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <math.h>
+#include "annotationsketch/custom_track_density.h"
+#include "annotationsketch/custom_track_rep.h"
+#include "core/class_alloc_lock.h"
+#include "core/ma_api.h"
+#include "core/mathsupport_api.h"
+#include "core/minmax_api.h"
+#include "core/unused_api.h"
+
+struct GtCustomTrackDensity {
+  const GtCustomTrack parent_instance;
+  GtUword height;
+  GtStr *title,
+        *type;
+  GtArray *ranges;
+};
+
+#define gt_custom_track_density_cast(ct)\
+        gt_custom_track_cast(gt_custom_track_density_class(), ct)
+
+int gt_custom_track_density_sketch(GtCustomTrack *ct, GtGraphics *graphics,
+                                   unsigned int start_ypos, GtRange viewrange,
+                                   GtStyle *style, GtError *err)
+{
+  int had_err = 0;
+  GtCustomTrackDensity *ctd;
+  GtUword i, nof_bins, vlen, maxval = 0;
+  GtRange value_range = {0, 1};
+  GtColor color;
+  double *data, cur;
+  gt_assert(ct && graphics && viewrange.start <= viewrange.end);
+  gt_error_check(err);
+  ctd = gt_custom_track_density_cast(ct);
+
+  /* one bin per pixel column, at least two to be able to draw a curve */
+  nof_bins = (GtUword) floor(gt_graphics_get_image_width(graphics)
+                               - 2*gt_graphics_get_xmargins(graphics));
+  nof_bins = GT_MAX(nof_bins, 2);
+  vlen = gt_range_length(&viewrange);
+
+  color.red = color.green = color.blue = 0.5;
+  color.alpha = 1.0;
+  if (gt_style_get_color(style, gt_str_get(ctd->type), "fill", &color, NULL,
+                         err) == GT_STYLE_QUERY_ERROR) {
+    return -1;
+  }
+
+  /* add +1/-1 at the first/last covered bin, then take prefix sums, so each
+     range is accounted for in constant time regardless of its length */
+  data = gt_calloc(nof_bins + 1, sizeof (double));
+  for (i = 0; i < gt_array_size(ctd->ranges); i++) {
+    GtRange *rng = (GtRange*) gt_array_get(ctd->ranges, i);
+    GtUword sbin, ebin;
+    if (!gt_range_overlap(rng, &viewrange))
+      continue;
+    sbin = (GT_MAX(rng->start, viewrange.start) - viewrange.start)
+             * nof_bins / vlen;
+    ebin = (GT_MIN(rng->end, viewrange.end) - viewrange.start)
+             * nof_bins / vlen;
+    data[sbin] += 1.0;
+    data[GT_MIN(ebin, nof_bins - 1) + 1] -= 1.0;
+  }
+  cur = 0.0;
+  for (i = 0; i < nof_bins; i++) {
+    cur += data[i];
+    data[i] = cur;
+    maxval = GT_MAX(maxval, (GtUword) cur);
+  }
+  if (maxval > 0)
+    value_range.end = maxval;
+
+  gt_graphics_draw_curve_data(graphics,
+                              gt_graphics_get_xmargins(graphics),
+                              start_ypos,
+                              color,
+                              data,
+                              nof_bins,
+                              value_range,
+                              ctd->height);
+  gt_free(data);
+  return had_err;
+}
+
+GtUword gt_custom_track_density_get_height(GtCustomTrack *ct)
+{
+  GtCustomTrackDensity *ctd;
+  ctd = gt_custom_track_density_cast(ct);
+  return ctd->height;
+}
+
+const char* gt_custom_track_density_get_title(GtCustomTrack *ct)
+{
+  GtCustomTrackDensity *ctd;
+  ctd = gt_custom_track_density_cast(ct);
+  return gt_str_get(ctd->title);
+}
+
+void gt_custom_track_density_delete(GtCustomTrack *ct)
+{
+  GtCustomTrackDensity *ctd;
+  if (!ct) return;
+  ctd = gt_custom_track_density_cast(ct);
+  gt_str_delete(ctd->title);
+  gt_str_delete(ctd->type);
+  gt_array_delete(ctd->ranges);
+}
+
+const GtCustomTrackClass* gt_custom_track_density_class(void)
+{
+  static const GtCustomTrackClass *ctc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!ctc)
+  {
+    ctc = gt_custom_track_class_new(sizeof (GtCustomTrackDensity),
+                                    gt_custom_track_density_sketch,
+                                    gt_custom_track_density_get_height,
+                                    gt_custom_track_density_get_title,
+                                    gt_custom_track_density_delete);
+  }
+  gt_class_alloc_lock_leave();
+  return ctc;
+}
+
+GtCustomTrack* gt_custom_track_density_new(const char *title,
+                                           const char *type,
+                                           GtArray *ranges,
+                                           GtUword height)
+{
+  GtCustomTrackDensity *ctd;
+  GtCustomTrack *ct;
+  gt_assert(title && type && ranges);
+  ct = gt_custom_track_create(gt_custom_track_density_class());
+  ctd = gt_custom_track_density_cast(ct);
+  ctd->height = height;
+  ctd->title = gt_str_new_cstr(title);
+  ctd->type = gt_str_new_cstr(type);
+  ctd->ranges = gt_array_ref(ranges);
+  return ct;
+}
@@ -0,0 +1,37 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef CUSTOM_TRACK_DENSITY_API_H
+#define CUSTOM_TRACK_DENSITY_API_H
+
+#include "annotationsketch/custom_track_api.h"
+#include "core/array_api.h"
+
+/* Implements the <GtCustomTrack> interface. This custom track summarizes a
+   set of feature ranges as a coverage plot, merging all features falling
+   into the same pixel column into one bin. It is used to draw overview
+   images of large ranges in which single features cannot be told apart. */
+typedef struct GtCustomTrackDensity GtCustomTrackDensity;
+
+/* Creates a new <GtCustomTrackDensity> with title <title> and height
+   <height> summarizing the <GtRange>s in <ranges>. The curve colour is taken
+   from the ``fill'' setting of style section <type>. A new reference to
+   <ranges> is taken. */
+GtCustomTrack* gt_custom_track_density_new(const char *title,
+                                           const char *type,
+                                           GtArray *ranges,
+                                           GtUword height);
+#endif
@@ -25,6 +25,7 @@
 #define TRACK_VSPACE_DEFAULT      15
 #define CAPTION_BAR_SPACE_DEFAULT  7
 #define MIN_LEN_BLOCK_DEFAULT     20
+#define LOD_TRACK_HEIGHT_DEFAULT  30
 #define ARROW_WIDTH_DEFAULT        6
 #define STROKE_WIDTH_DEFAULT     0.5
 #define FONT_SIZE_DEFAULT          8
@@ -19,6 +19,7 @@
 
 #include "annotationsketch/canvas.h"
 #include "annotationsketch/canvas_cairo_file.h"
+#include "annotationsketch/custom_track_density.h"
 #include "annotationsketch/diagram.h"
 #include "extended/feature_index_memory_api.h"
 #include "annotationsketch/line_breaker_captions.h"
@@ -36,6 +37,7 @@
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "extended/feature_node.h"
+#include "extended/feature_node_iterator_api.h"
 #include "extended/genome_node.h"
 #include "extended/gff3_defines.h"
 
@@ -932,6 +934,140 @@ void gt_diagram_add_custom_track(GtDiagram *diagram, GtCustomTrack* ctrack)
   gt_rwlock_unlock(diagram->lock);
 }
 
+/* feature ranges collected for one density track */
+typedef struct {
+  GtArray *ranges;
+  const char *type;
+} DensityInfo;
+
+static void densityinfo_delete(void *value)
+{
+  DensityInfo *di = (DensityInfo*) value;
+  if (!di) return;
+  gt_array_delete(di->ranges);
+  gt_free(di);
+}
+
+static int density_add_node(GtDiagram *d, GtHashmap *densities,
+                            GtFeatureNode *node, const char *basename,
+                            bool is_root, GtStr *key, GtError *err)
+{
+  const char *type;
+  DensityInfo *di;
+  GtRange rng;
+  bool *collapse;
+  if (gt_feature_node_is_pseudo(node))
+    return 0;
+  type = gt_feature_node_get_type(node);
+  /* collapsed types are drawn inside their parents' blocks, so they do not
+     get a track of their own */
+  if ((collapse = (bool*) gt_hashmap_get(d->collapsingtypes, type)) == NULL) {
+    collapse = gt_malloc(sizeof (bool));
+    *collapse = false;
+    if (gt_style_get_bool(d->style, type, "collapse_to_parent", collapse,
+                          NULL, err) == GT_STYLE_QUERY_ERROR) {
+      gt_free(collapse);
+      return -1;
+    }
+    gt_hashmap_add(d->collapsingtypes, (void*) type, collapse);
+  }
+  if (!is_root && *collapse)
+    return 0;
+  gt_str_reset(key);
+  gt_str_append_cstr(key, basename);
+  gt_str_append_char(key, GT_FILENAME_TYPE_SEPARATOR);
+  gt_str_append_cstr(key, type);
+  if (!(di = gt_hashmap_get(densities, gt_str_get(key)))) {
+    di = gt_malloc(sizeof (DensityInfo));
+    di->ranges = gt_array_new(sizeof (GtRange));
+    di->type = type;
+    gt_hashmap_add(densities, gt_cstr_dup(gt_str_get(key)), di);
+  }
+  rng = gt_genome_node_get_range((GtGenomeNode*) node);
+  gt_array_add(di->ranges, rng);
+  return 0;
+}
+
+static int density_add_tree(GtDiagram *d, GtHashmap *densities,
+                            GtFeatureNode *root, const char *basename,
+                            GtStr *key, GtError *err)
+{
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *node;
+  int had_err = 0;
+  fni = gt_feature_node_iterator_new(root);
+  while (!had_err && (node = gt_feature_node_iterator_next(fni))) {
+    had_err = density_add_node(d, densities, node, basename, node == root,
+                               key, err);
+  }
+  gt_feature_node_iterator_delete(fni);
+  return had_err;
+}
+
+typedef struct {
+  GtArray *tracks;
+  GtUword height;
+} DensityTrackInfo;
+
+static int density_make_track(void *key, void *value, void *data,
+                              GT_UNUSED GtError *err)
+{
+  DensityInfo *di = (DensityInfo*) value;
+  DensityTrackInfo *dti = (DensityTrackInfo*) data;
+  GtCustomTrack *ct;
+  ct = gt_custom_track_density_new((const char*) key, di->type, di->ranges,
+                                   dti->height);
+  gt_array_add(dti->tracks, ct);
+  return 0;
+}
+
+GtArray* gt_diagram_get_density_tracks(GtDiagram *diagram, GtUword height,
+                                       GtError *err)
+{
+  GtHashmap *densities;
+  GtStr *key;
+  DensityTrackInfo dti;
+  GtUword i;
+  int had_err = 0;
+  gt_assert(diagram);
+  gt_error_check(err);
+
+  densities = gt_hashmap_new(GT_HASH_STRING, gt_free_func, densityinfo_delete);
+  key = gt_str_new();
+  gt_rwlock_wrlock(diagram->lock);
+  for (i = 0; !had_err && i < gt_array_size(diagram->features); i++) {
+    GtFeatureNode *root, *child;
+    char *basename;
+    root = *(GtFeatureNode**) gt_array_get(diagram->features, i);
+    basename = gt_basename(gt_genome_node_get_filename((GtGenomeNode*) root));
+    if (gt_feature_node_is_pseudo(root)) {
+      /* the children of a pseudo node are the actual top-level features */
+      GtFeatureNodeIterator *fni = gt_feature_node_iterator_new_direct(root);
+      while (!had_err && (child = gt_feature_node_iterator_next(fni))) {
+        had_err = density_add_tree(diagram, densities, child, basename, key,
+                                   err);
+      }
+      gt_feature_node_iterator_delete(fni);
+    } else
+      had_err = density_add_tree(diagram, densities, root, basename, key, err);
+    gt_free(basename);
+  }
+  gt_rwlock_unlock(diagram->lock);
+  gt_str_delete(key);
+
+  if (had_err) {
+    gt_hashmap_delete(densities);
+    return NULL;
+  }
+  dti.tracks = gt_array_new(sizeof (GtCustomTrack*));
+  dti.height = height;
+  had_err = gt_hashmap_foreach_in_key_order(densities, density_make_track,
+                                            &dti, NULL);
+  gt_assert(!had_err); /* density_make_track() is sane */
+  gt_hashmap_delete(densities);
+  return dti.tracks;
+}
+
 typedef struct {
   GtFeatureIndex *fi;
   GtError *err;
@@ -990,6 +1126,22 @@ int gt_diagram_unit_test(GtError *err)
   gt_diagram_unit_test_sketch_func(&sh);
   gt_ensure(sh.errstatus == 0);
 
+  /* level of detail: summarize tracks as density plots */
+  if (!had_err) {
+    GtArray *tracks;
+    GtUword i;
+    tracks = gt_diagram_get_density_tracks(sh.d, 30, err);
+    gt_ensure(tracks && gt_array_size(tracks) > 0);
+    for (i = 0; tracks && i < gt_array_size(tracks); i++)
+      gt_custom_track_delete(*(GtCustomTrack**) gt_array_get(tracks, i));
+    gt_array_delete(tracks);
+  }
+  if (!had_err) {
+    gt_style_set_num(sh.sty, "format", "lod_bases_per_pixel", 1);
+    gt_diagram_unit_test_sketch_func(&sh);
+    gt_ensure(sh.errstatus == 0);
+  }
+
   gt_style_delete(sh.sty);
   gt_diagram_delete(sh.d);
   gt_feature_index_delete(sh.fi);
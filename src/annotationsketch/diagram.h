@@ -26,6 +26,11 @@
 
 GtHashmap* gt_diagram_get_blocks(GtDiagram *diagram, GtError *err);
 GtArray*   gt_diagram_get_custom_tracks(const GtDiagram *diagram);
+/* Returns a new array of <GtCustomTrack>s, one per track key, summarizing the
+   feature ranges in <diagram> as coverage plots of height <height>. Used to
+   render overviews without building blocks. Returns NULL on error. */
+GtArray*   gt_diagram_get_density_tracks(GtDiagram *diagram, GtUword height,
+                                         GtError *err);
 void       gt_diagram_reset(GtDiagram *diagram);
 int        gt_diagram_unit_test(GtError*);
 
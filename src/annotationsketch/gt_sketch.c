@@ -32,9 +32,12 @@
 #include "core/warning_api.h"
 #include "extended/add_introns_stream_api.h"
 #include "extended/bed_in_stream.h"
+#include "extended/feature_index_file_api.h"
 #include "extended/feature_index_memory_api.h"
 #include "extended/feature_stream_api.h"
 #include "extended/gff3_in_stream.h"
+#include "extended/gff3_region_in_stream_api.h"
+#include "extended/gff3_region_index.h"
 #include "extended/gff3_out_stream_api.h"
 #include "extended/gtf_in_stream.h"
 #include "extended/sort_stream_api.h"
@@ -104,6 +107,7 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
     "gff",
     "bed",
     "gtf",
+    "featureindex",
     NULL
   };
   gt_assert(arguments);
@@ -177,7 +181,9 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
 
   /* -input */
   option = gt_option_new_choice("input", "input data format\n"
-                                       "choose from gff|bed|gtf",
+                                       "choose from gff|bed|gtf|featureindex\n"
+                                       "(featureindex: a file created by "
+                                       "gt mkfeatureindex -backend file)",
                              arguments->input, inputs[0], inputs);
   gt_option_parser_add_option(op, option);
 
@@ -219,7 +225,7 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
   return op;
 }
 
-static int gt_sketch_arguments_check(GT_UNUSED int rest_argc,
+static int gt_sketch_arguments_check(int rest_argc,
                                      void *tool_arguments,
                                      GT_UNUSED GtError *err)
 {
@@ -236,6 +242,18 @@ static int gt_sketch_arguments_check(GT_UNUSED int rest_argc,
                       arguments->start, arguments->end);
     had_err = -1;
   }
+  if (!had_err && strcmp(gt_str_get(arguments->input), "featureindex") == 0) {
+    if (rest_argc != 2) {
+      gt_error_set(err, "option -input featureindex requires exactly one "
+                   "feature index file");
+      had_err = -1;
+    }
+    else if (arguments->pipe || arguments->addintrons) {
+      gt_error_set(err, "options -pipe and -addintrons cannot be used with "
+                   "-input featureindex");
+      had_err = -1;
+    }
+  }
 
   return had_err;
 }
@@ -289,13 +307,32 @@ static int gt_sketch_runner(int argc, const char **argv, int parsed_args,
   }
 
   file = argv[parsed_args];
-  if (!had_err) {
+  if (!had_err && strcmp(gt_str_get(arguments->input), "featureindex") == 0) {
+    /* the features are mapped from a persistent index file */
+    if (!(features = gt_feature_index_file_new(argv[parsed_args + 1], err)))
+      had_err = -1;
+  }
+  else if (!had_err) {
     /* create feature index */
     features = gt_feature_index_memory_new();
     parsed_args++;
 
     /* create an input stream */
-    if (strcmp(gt_str_get(arguments->input), "gff") == 0)
+    if (strcmp(gt_str_get(arguments->input), "gff") == 0 &&
+        argc - parsed_args == 1 && gt_str_length(arguments->seqid) &&
+        arguments->start != GT_UNDEF_UWORD &&
+        gt_gff3_region_index_exists(argv[parsed_args]))
+    {
+      /* indexed BGZF file: only load the features overlapping the range */
+      GtRange range;
+      range.start = arguments->start;
+      range.end = arguments->end;
+      in_stream = gt_gff3_region_in_stream_new(argv[parsed_args],
+                                               gt_str_get(arguments->seqid),
+                                               &range, err);
+      if (!in_stream)
+        had_err = -1;
+    } else if (strcmp(gt_str_get(arguments->input), "gff") == 0)
     {
       in_stream = gt_gff3_in_stream_new_unsorted(argc - parsed_args,
                                                  argv + parsed_args);
@@ -315,7 +352,9 @@ static int gt_sketch_runner(int argc, const char **argv, int parsed_args,
         in_stream = gt_gtf_in_stream_new(argv[parsed_args]);
     }
     last_stream = in_stream;
+  }
 
+  if (!had_err && in_stream) {
     /* create add introns stream if -addintrons was used */
     if (arguments->addintrons) {
       sort_stream = gt_sort_stream_new(last_stream);
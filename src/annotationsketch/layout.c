@@ -61,7 +61,8 @@ struct GtLayout {
   GtTextWidthCalculator *twc;
   bool own_twc,
        layout_done;
-  GtArray *custom_tracks;
+  GtArray *custom_tracks,
+          *density_tracks;
   GtHashmap *tracks,
             *blocks;
   GtRange viewrange;
@@ -234,6 +235,50 @@ static int check_width(unsigned int width, GtStyle *style, GtError *err)
   return had_err;
 }
 
+/* Level of detail: if the style sets format.lod_bases_per_pixel to a positive
+   value and the diagram range exceeds that many bases per pixel, tracks are
+   rendered as density plots. */
+static int use_lod(GtLayout *layout, bool *lod, GtError *err)
+{
+  double margins = MARGINS_DEFAULT,
+         bpp_threshold = 0;
+  if (gt_style_get_num(layout->style, "format", "lod_bases_per_pixel",
+                       &bpp_threshold, NULL, err) == GT_STYLE_QUERY_ERROR
+        || gt_style_get_num(layout->style, "format", "margins", &margins,
+                            NULL, err) == GT_STYLE_QUERY_ERROR) {
+    return -1;
+  }
+  /* without room for drawing, there is no meaningful resolution */
+  *lod = gt_double_smaller_double(2*margins, layout->width)
+           && gt_double_smaller_double(0, bpp_threshold)
+           && gt_double_smaller_double(bpp_threshold,
+                                       gt_range_length(&layout->viewrange)
+                                         / (layout->width - 2*margins));
+  return 0;
+}
+
+static int layout_new_lod(GtLayout *layout, GtDiagram *diagram, GtError *err)
+{
+  GtArray *custom_tracks;
+  double height = LOD_TRACK_HEIGHT_DEFAULT;
+  if (gt_style_get_num(layout->style, "format", "lod_track_height", &height,
+                       NULL, err) == GT_STYLE_QUERY_ERROR) {
+    return -1;
+  }
+  layout->density_tracks = gt_diagram_get_density_tracks(diagram,
+                                                         (GtUword) height,
+                                                         err);
+  if (!layout->density_tracks)
+    return -1;
+  custom_tracks = gt_diagram_get_custom_tracks(diagram);
+  layout->custom_tracks = gt_array_new(sizeof (GtCustomTrack*));
+  gt_array_add_array(layout->custom_tracks, custom_tracks);
+  gt_array_add_array(layout->custom_tracks, layout->density_tracks);
+  /* no blocks are laid out in this mode */
+  layout->blocks = gt_hashmap_new(GT_HASH_STRING, NULL, NULL);
+  return 0;
+}
+
 GtLayout* gt_layout_new(GtDiagram *diagram,
                         unsigned int width,
                         GtStyle *style,
@@ -263,6 +308,7 @@ GtLayout* gt_layout_new_with_twc(GtDiagram *diagram,
 {
   GtLayout *layout;
   GtHashmap *blocks;
+  bool lod = false;
   gt_assert(diagram);
   gt_assert(style);
   gt_assert(twc);
@@ -283,10 +329,27 @@ GtLayout* gt_layout_new_with_twc(GtDiagram *diagram,
   layout->lock = gt_rwlock_new();
   layout->own_twc = false;
   layout->layout_done = false;
-  layout->custom_tracks = gt_array_ref(gt_diagram_get_custom_tracks(diagram));
   /* XXX: use other container type here! */
   layout->tracks = gt_hashmap_new(GT_HASH_STRING, gt_free_func,
                                   (GtFree) gt_track_delete);
+  if (use_lod(layout, &lod, err) < 0) {
+    gt_hashmap_delete(layout->tracks);
+    gt_rwlock_delete(layout->lock);
+    gt_free(layout);
+    return NULL;
+  }
+  if (lod) {
+    /* too many bases per pixel to tell features apart, summarize each track
+       as a density plot instead of building and laying out blocks */
+    if (layout_new_lod(layout, diagram, err) < 0) {
+      gt_hashmap_delete(layout->tracks);
+      gt_rwlock_delete(layout->lock);
+      gt_free(layout);
+      return NULL;
+    }
+    return layout;
+  }
+  layout->custom_tracks = gt_array_ref(gt_diagram_get_custom_tracks(diagram));
   blocks = gt_diagram_get_blocks(diagram, err);
   if (!blocks) {
     gt_array_delete(layout->custom_tracks);
@@ -306,6 +369,14 @@ void gt_layout_delete(GtLayout *layout)
     gt_text_width_calculator_delete(layout->twc);
   gt_hashmap_delete(layout->tracks);
   gt_array_delete(layout->custom_tracks);
+  if (layout->density_tracks) {
+    GtUword i;
+    for (i = 0; i < gt_array_size(layout->density_tracks); i++) {
+      gt_custom_track_delete(*(GtCustomTrack**)
+                                 gt_array_get(layout->density_tracks, i));
+    }
+    gt_array_delete(layout->density_tracks);
+  }
   if (layout->blocks)
     gt_hashmap_delete(layout->blocks);
   gt_rwlock_unlock(layout->lock);
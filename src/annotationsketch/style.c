@@ -26,6 +26,7 @@
 #include "core/assert_api.h"
 #include "core/cstr_api.h"
 #include "core/ensure_api.h"
+#include "core/hashmap_api.h"
 #include "core/log.h"
 #include "core/ma_api.h"
 #include "core/thread_api.h"
@@ -80,8 +81,25 @@ struct GtStyle
   GtRWLock *lock, *clone_lock;
   bool unsafe;
   char *filename;
+  GtHashmap *cache; /* maps sections to maps from keys to cache entries */
+  GtUword generation;
 };
 
+/* A style value as read from the Lua state, so that repeated queries do not
+   have to look it up there again. Values which are functions are called for
+   each query instead. */
+typedef struct {
+  bool is_function,
+       has_str,
+       has_num,
+       has_bool,
+       has_color;
+  char *str;
+  double num;
+  bool boolean;
+  GtColor color;
+} GtStyleCacheEntry;
+
 static void style_lua_new_table(lua_State *L, const char *key)
 {
   lua_pushstring(L, key);
@@ -89,6 +107,33 @@ static void style_lua_new_table(lua_State *L, const char *key)
   lua_settable(L, -3);
 }
 
+static void style_cache_entry_delete(GtStyleCacheEntry *entry)
+{
+  if (!entry) return;
+  gt_free(entry->str);
+  gt_free(entry);
+}
+
+/* Must be called with the write lock held whenever <key> in <section> is
+   changed. */
+static void style_cache_remove(GtStyle *sty, const char *section,
+                               const char *key)
+{
+  GtHashmap *keys;
+  sty->generation++;
+  if (sty->cache && (keys = gt_hashmap_get(sty->cache, section)))
+    gt_hashmap_remove(keys, key);
+}
+
+/* Must be called with the write lock held whenever the style table may have
+   been replaced. */
+static void style_cache_reset(GtStyle *sty)
+{
+  sty->generation++;
+  if (sty->cache)
+    gt_hashmap_reset(sty->cache);
+}
+
 static const luaL_Reg luasecurelibs[] = {
   /* Think very hard before adding additional Lua libraries to this list, it
      might compromise application security! Do not add the 'io', 'os', or
@@ -141,6 +186,8 @@ GtStyle* gt_style_new(GtError *err)
   sty->lock = gt_rwlock_new();
   sty->unsafe = false;
   sty->clone_lock = gt_rwlock_new();
+  sty->cache = gt_hashmap_new(GT_HASH_STRING, gt_free_func,
+                              (GtFree) gt_hashmap_delete);
 
   default_formats = gt_str_new_cstr(gt_default_format_style);
   had_err = gt_style_load_str(sty, default_formats, err);
@@ -157,6 +204,9 @@ GtStyle* gt_style_new_with_state(lua_State *L)
   sty->L = L;
   sty->unsafe = true;
   sty->lock = gt_rwlock_new();
+  /* the style table of a shared Lua state can be changed by scripts without
+     notice, hence values are not cached */
+  sty->cache = NULL;
   return sty;
 }
 
@@ -169,6 +219,16 @@ GtStyle* gt_style_ref(GtStyle *style)
   return style;
 }
 
+GtUword gt_style_get_generation(GtStyle *style)
+{
+  GtUword generation;
+  gt_assert(style);
+  gt_rwlock_rdlock(style->lock);
+  generation = style->generation;
+  gt_rwlock_unlock(style->lock);
+  return generation;
+}
+
 void gt_style_unsafe_mode(GtStyle *style)
 {
   gt_assert(style);
@@ -237,6 +297,7 @@ int gt_style_load_file(GtStyle *sty, const char *filename, GtError *err)
   gt_rwlock_unlock(sty->lock);
   gt_rwlock_wrlock(sty->lock);
   sty->filename = gt_cstr_dup(filename);
+  style_cache_reset(sty);
   gt_log_log("Trying to load style file: %s...", filename);
   if (luaL_loadfile(sty->L, filename) || lua_pcall(sty->L, 0, 0, 0)) {
     gt_error_set(err, "cannot run style file: %s", lua_tostring(sty->L, -1));
@@ -311,6 +372,80 @@ static int style_find_section_for_getting(const GtStyle *sty,
   return depth;
 }
 
+static GtStyleCacheEntry* style_cache_entry_new(const GtStyle *sty,
+                                                const char *section,
+                                                const char *key)
+{
+  GtStyleCacheEntry *entry = gt_calloc(1, sizeof *entry);
+  int i;
+  if ((i = style_find_section_for_getting(sty, section)) < 0)
+    return entry;
+  lua_getfield(sty->L, -1, key);
+  if (lua_isfunction(sty->L, -1))
+    entry->is_function = true;
+  else if (!lua_isnil(sty->L, -1)) {
+    /* keep the conversions Lua would apply, e.g. numeric strings */
+    if (lua_isnumber(sty->L, -1)) {
+      entry->has_num = true;
+      entry->num = lua_tonumber(sty->L, -1);
+    }
+    if (lua_isstring(sty->L, -1)) {
+      entry->has_str = true;
+      entry->str = gt_cstr_dup(lua_tostring(sty->L, -1));
+    }
+    if (lua_isboolean(sty->L, -1)) {
+      entry->has_bool = true;
+      entry->boolean = lua_toboolean(sty->L, -1);
+    }
+    if (lua_istable(sty->L, -1)) {
+      entry->has_color = true;
+      entry->color.red = entry->color.green = entry->color.blue =
+        entry->color.alpha = 0.5;
+      lua_getfield(sty->L, -1, "red");
+      if (!lua_isnil(sty->L, -1) && lua_isnumber(sty->L, -1))
+        entry->color.red = lua_tonumber(sty->L,-1);
+      lua_pop(sty->L, 1);
+      lua_getfield(sty->L, -1, "green");
+      if (!lua_isnil(sty->L, -1) && lua_isnumber(sty->L, -1))
+        entry->color.green = lua_tonumber(sty->L,-1);
+      lua_pop(sty->L, 1);
+      lua_getfield(sty->L, -1, "blue");
+      if (!lua_isnil(sty->L, -1) && lua_isnumber(sty->L, -1))
+        entry->color.blue = lua_tonumber(sty->L,-1);
+      lua_pop(sty->L, 1);
+      lua_getfield(sty->L, -1, "alpha");
+      if (!lua_isnil(sty->L, -1) && lua_isnumber(sty->L, -1))
+        entry->color.alpha = lua_tonumber(sty->L,-1);
+      lua_pop(sty->L, 1);
+    }
+  }
+  lua_pop(sty->L, i + 1);
+  return entry;
+}
+
+/* Returns the cache entry for <key> in <section>, reading it from the Lua
+   state on first use. Returns NULL if <sty> does not cache values. Must be
+   called with the write lock held. */
+static GtStyleCacheEntry* style_cache_get(const GtStyle *sty,
+                                          const char *section,
+                                          const char *key)
+{
+  GtHashmap *keys;
+  GtStyleCacheEntry *entry;
+  if (!sty->cache)
+    return NULL;
+  if (!(keys = gt_hashmap_get(sty->cache, section))) {
+    keys = gt_hashmap_new(GT_HASH_STRING, gt_free_func,
+                          (GtFree) style_cache_entry_delete);
+    gt_hashmap_add(sty->cache, gt_cstr_dup(section), keys);
+  }
+  if (!(entry = gt_hashmap_get(keys, key))) {
+    entry = style_cache_entry_new(sty, section, key);
+    gt_hashmap_add(keys, gt_cstr_dup(key), entry);
+  }
+  return entry;
+}
+
 GtStyleQueryStatus gt_style_get_color_with_track(const GtStyle *sty,
                                                  const char *section,
                                                  const char *key,
@@ -322,6 +457,7 @@ GtStyleQueryStatus gt_style_get_color_with_track(const GtStyle *sty,
 #ifndef NDEBUG
   int stack_size;
 #endif
+  GtStyleCacheEntry *entry;
   int i = 0;
   gt_assert(sty && section && key && color);
   gt_error_check(err);
@@ -331,6 +467,13 @@ GtStyleQueryStatus gt_style_get_color_with_track(const GtStyle *sty,
 #endif
   /* set default colors */
   color->red = 0.5; color->green = 0.5; color->blue = 0.5; color->alpha = 0.5;
+  if ((entry = style_cache_get(sty, section, key)) && !entry->is_function) {
+    gt_rwlock_unlock(sty->lock);
+    if (!entry->has_color)
+      return GT_STYLE_QUERY_NOT_SET;
+    *color = entry->color;
+    return GT_STYLE_QUERY_OK;
+  }
   /* get section */
   i = style_find_section_for_getting(sty, section);
   /* could not get section, return default */
@@ -415,6 +558,7 @@ void gt_style_set_color(GtStyle *sty, const char *section, const char *key,
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
 #endif
+  style_cache_remove(sty, section, key);
   i = style_find_section_for_setting(sty, section);
   lua_getfield(sty->L, -1, key);
   i++;
@@ -450,6 +594,7 @@ GtStyleQueryStatus gt_style_get_str_with_track(const GtStyle *sty,
 #ifndef NDEBUG
   int stack_size;
 #endif
+  GtStyleCacheEntry *entry;
   int i = 0;
   gt_assert(sty && key && section);
   gt_error_check(err);
@@ -457,6 +602,13 @@ GtStyleQueryStatus gt_style_get_str_with_track(const GtStyle *sty,
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
 #endif
+  if ((entry = style_cache_get(sty, section, key)) && !entry->is_function) {
+    gt_rwlock_unlock(sty->lock);
+    if (!entry->has_str)
+      return GT_STYLE_QUERY_NOT_SET;
+    gt_str_set(text, entry->str);
+    return GT_STYLE_QUERY_OK;
+  }
   /* get section */
   i = style_find_section_for_getting(sty, section);
   /* could not get section, return default */
@@ -525,6 +677,7 @@ void gt_style_set_str(GtStyle *sty, const char *section, const char *key,
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
 #endif
+  style_cache_remove(sty, section, key);
   i = style_find_section_for_setting(sty, section);
   lua_pushstring(sty->L, key);
   lua_pushstring(sty->L, gt_str_get(value));
@@ -544,6 +697,7 @@ GtStyleQueryStatus gt_style_get_num_with_track(const GtStyle *sty,
 #ifndef NDEBUG
   int stack_size;
 #endif
+  GtStyleCacheEntry *entry;
   int i = 0;
   gt_assert(sty && key && section && val);
   gt_error_check(err);
@@ -551,6 +705,13 @@ GtStyleQueryStatus gt_style_get_num_with_track(const GtStyle *sty,
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
 #endif
+  if ((entry = style_cache_get(sty, section, key)) && !entry->is_function) {
+    gt_rwlock_unlock(sty->lock);
+    if (!entry->has_num)
+      return GT_STYLE_QUERY_NOT_SET;
+    *val = entry->num;
+    return GT_STYLE_QUERY_OK;
+  }
   /* get section */
   i = style_find_section_for_getting(sty, section);
   /* could not get section, return default */
@@ -624,6 +785,7 @@ void gt_style_set_num(GtStyle *sty, const char *section, const char *key,
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
 #endif
+  style_cache_remove(sty, section, key);
   i = style_find_section_for_setting(sty, section);
   lua_pushstring(sty->L, key);
   lua_pushnumber(sty->L, number);
@@ -643,6 +805,7 @@ GtStyleQueryStatus gt_style_get_bool_with_track(const GtStyle *sty,
 #ifndef NDEBUG
   int stack_size;
 #endif
+  GtStyleCacheEntry *entry;
   int i = 0;
   gt_assert(sty && key && section);
   gt_error_check(err);
@@ -650,6 +813,13 @@ GtStyleQueryStatus gt_style_get_bool_with_track(const GtStyle *sty,
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
 #endif
+  if ((entry = style_cache_get(sty, section, key)) && !entry->is_function) {
+    gt_rwlock_unlock(sty->lock);
+    if (!entry->has_bool)
+      return GT_STYLE_QUERY_NOT_SET;
+    *val = entry->boolean;
+    return GT_STYLE_QUERY_OK;
+  }
   /* get section */
   i = style_find_section_for_getting(sty, section);
   /* could not get section, return default */
@@ -718,6 +888,7 @@ void gt_style_set_bool(GtStyle *sty, const char *section, const char *key,
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
 #endif
+  style_cache_remove(sty, section, key);
   i = style_find_section_for_setting(sty, section);
   lua_pushstring(sty->L, key);
   lua_pushboolean(sty->L, val);
@@ -737,6 +908,7 @@ void gt_style_unset(GtStyle *sty, const char *section, const char *key)
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
 #endif
+  style_cache_remove(sty, section, key);
   lua_getglobal(sty->L, "style");
   if (!lua_isnil(sty->L, -1)) {
     gt_assert(lua_istable(sty->L, -1));
@@ -794,6 +966,7 @@ int gt_style_load_str(GtStyle *sty, GtStr *instr, GtError *err)
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);;
 #endif
+  style_cache_reset(sty);
   if (luaL_loadbuffer(sty->L, gt_str_get(instr), gt_str_length(instr), "str") ||
       lua_pcall(sty->L, 0, 0, 0)) {
     gt_error_set(err, "cannot run style buffer: %s",
@@ -938,6 +1111,43 @@ int gt_style_unit_test(GtError *err)
                                    testerr) != GT_STYLE_QUERY_ERROR);
   gt_ensure((strcmp(gt_str_get(str),"")==0));
 
+  /* cached values follow changes */
+  gt_style_set_num(sty, "format", "margins", 12.0);
+  gt_ensure(gt_style_get_num(sty, "format", "margins", &num, NULL,
+                             testerr) == GT_STYLE_QUERY_OK);
+  gt_ensure(num == 12.0);
+  gt_style_unset(sty, "format", "margins");
+  gt_ensure(gt_style_get_num(sty, "format", "margins", &num, NULL,
+                             testerr) == GT_STYLE_QUERY_NOT_SET);
+  gt_str_set(sty_buffer, "style.format.margins = 13");
+  gt_ensure(gt_style_load_str(sty, sty_buffer, testerr) == 0);
+  gt_ensure(gt_style_get_num(sty, "format", "margins", &num, NULL,
+                             testerr) == GT_STYLE_QUERY_OK);
+  gt_ensure(num == 13.0);
+  /* numbers and strings are converted as in Lua */
+  gt_str_set(str, "14");
+  gt_style_set_str(sty, "format", "margins", str);
+  gt_ensure(gt_style_get_num(sty, "format", "margins", &num, NULL,
+                             testerr) == GT_STYLE_QUERY_OK);
+  gt_ensure(num == 14.0);
+  gt_ensure(gt_style_get_bool(sty, "format", "margins", &val, NULL,
+                              testerr) == GT_STYLE_QUERY_NOT_SET);
+
+  /* functions are called on every query */
+  gt_str_set(sty_buffer, "count = 0\n"
+                         "style.format.counter = function()\n"
+                         "  count = count + 1\n"
+                         "  return count\n"
+                         "end");
+  gt_ensure(gt_style_load_str(sty, sty_buffer, testerr) == 0);
+  gt_ensure(gt_style_get_num(sty, "format", "counter", &num, NULL,
+                             testerr) == GT_STYLE_QUERY_OK);
+  gt_ensure(num == 1.0);
+  gt_ensure(gt_style_get_num(sty, "format", "counter", &num, NULL,
+                             testerr) == GT_STYLE_QUERY_OK);
+  gt_ensure(num == 2.0);
+  gt_ensure(!gt_error_is_set(testerr));
+
   /* mem cleanup */
   gt_error_delete(testerr);
   gt_str_delete(test1);
@@ -960,6 +1170,7 @@ void gt_style_delete_without_state(GtStyle *sty)
     return;
   }
   gt_free(sty->filename);
+  gt_hashmap_delete(sty->cache);
   gt_rwlock_unlock(sty->lock);
   gt_rwlock_delete(sty->lock);
   gt_rwlock_delete(sty->clone_lock);
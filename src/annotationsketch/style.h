@@ -27,6 +27,11 @@
    instead of creating a new one. */
 GtStyle*       gt_style_new_with_state(lua_State*);
 
+/* Returns a counter which is increased whenever a value of <style> is set or
+   unset or a style is loaded into it, so that results derived from it can be
+   invalidated. Changes made to a shared Lua state directly are not noticed. */
+GtUword            gt_style_get_generation(GtStyle *style);
+
 int                gt_style_unit_test(GtError*);
 
 /* Deletes a GtStyle object but leaves the internal Lua state intact. */
@@ -0,0 +1,534 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <limits.h>
+#include <string.h>
+#include "annotationsketch/canvas_cairo_file_api.h"
+#include "annotationsketch/diagram_api.h"
+#include "annotationsketch/layout_api.h"
+#include "annotationsketch/style.h"
+#include "annotationsketch/tile_renderer.h"
+#include "core/array_api.h"
+#include "core/cstr_api.h"
+#include "core/ensure_api.h"
+#include "core/hashmap_api.h"
+#include "core/ma_api.h"
+#include "core/md5_encoder_api.h"
+#include "core/minmax_api.h"
+#include "core/multithread_api.h"
+#include "core/thread_api.h"
+#include "extended/feature_index.h"
+#include "extended/feature_index_memory_api.h"
+#include "extended/feature_node.h"
+#include "extended/genome_node.h"
+
+typedef struct GtTileRendererEntry GtTileRendererEntry;
+
+struct GtTileRendererEntry {
+  char *key;
+  GtStr *image;
+  GtTileRendererEntry *prev,
+                      *next;
+};
+
+struct GtTileRenderer {
+  GtFeatureIndex *feature_index;
+  GtStyle *style;
+  GtUword tile_width,
+          tile_length,
+          max_tiles,
+          num_of_tiles,
+          hits,
+          misses;
+  GtHashmap *tiles;            /* maps keys to entries */
+  GtTileRendererEntry *first,  /* most recently used */
+                      *last;   /* least recently used */
+  char style_hash[33];         /* MD5 of the style contents */
+  GtUword style_generation;    /* of the style when <style_hash> was computed */
+  bool style_hash_valid;
+  GtMutex *mutex;
+};
+
+typedef struct {
+  GtTileRenderer *tile_renderer;
+  const char *seqid;
+  GtUword zoom,
+          next_job;
+  GtArray *jobs;
+  GtStr *key_prefix;
+  GtError *err;
+} GtTileRendererJobs;
+
+GtTileRenderer* gt_tile_renderer_new(GtFeatureIndex *feature_index,
+                                     GtStyle *style, GtUword tile_width,
+                                     GtUword tile_length, GtUword max_tiles)
+{
+  GtTileRenderer *tr;
+  gt_assert(feature_index && style && tile_width && tile_length && max_tiles);
+  tr = gt_calloc(1, sizeof *tr);
+  tr->feature_index = gt_feature_index_ref(feature_index);
+  tr->style = gt_style_ref(style);
+  tr->tile_width = tile_width;
+  tr->tile_length = tile_length;
+  tr->max_tiles = max_tiles;
+  /* entries own their keys and are deleted on eviction */
+  tr->tiles = gt_hashmap_new(GT_HASH_STRING, NULL, NULL);
+  tr->mutex = gt_mutex_new();
+  return tr;
+}
+
+GtRange gt_tile_renderer_get_tile_range(const GtTileRenderer *tr,
+                                        GtUword zoom, GtUword tile)
+{
+  GtRange range;
+  GtUword length;
+  gt_assert(tr && zoom < sizeof (GtUword) * CHAR_BIT);
+  length = tr->tile_length << zoom;
+  range.start = tile * length + 1;
+  range.end = range.start + length - 1;
+  return range;
+}
+
+static void tile_renderer_unlink(GtTileRenderer *tr, GtTileRendererEntry *e)
+{
+  if (e->prev)
+    e->prev->next = e->next;
+  else
+    tr->first = e->next;
+  if (e->next)
+    e->next->prev = e->prev;
+  else
+    tr->last = e->prev;
+  e->prev = e->next = NULL;
+}
+
+static void tile_renderer_push_front(GtTileRenderer *tr,
+                                     GtTileRendererEntry *e)
+{
+  e->prev = NULL;
+  e->next = tr->first;
+  if (tr->first)
+    tr->first->prev = e;
+  tr->first = e;
+  if (!tr->last)
+    tr->last = e;
+}
+
+static void tile_renderer_entry_delete(GtTileRendererEntry *e)
+{
+  if (!e) return;
+  gt_str_delete(e->image);
+  gt_free(e->key);
+  gt_free(e);
+}
+
+/* must be called with the mutex locked */
+static GtTileRendererEntry* tile_renderer_cache_get(GtTileRenderer *tr,
+                                                    const char *key)
+{
+  GtTileRendererEntry *e;
+  if ((e = gt_hashmap_get(tr->tiles, key))) {
+    tile_renderer_unlink(tr, e);
+    tile_renderer_push_front(tr, e);
+  }
+  return e;
+}
+
+/* must be called with the mutex locked, takes ownership of <image> */
+static void tile_renderer_cache_add(GtTileRenderer *tr, const char *key,
+                                    GtStr *image)
+{
+  GtTileRendererEntry *e;
+  if (tile_renderer_cache_get(tr, key)) {
+    /* rendered concurrently */
+    gt_str_delete(image);
+    return;
+  }
+  e = gt_calloc(1, sizeof *e);
+  e->key = gt_cstr_dup(key);
+  e->image = image;
+  tile_renderer_push_front(tr, e);
+  gt_hashmap_add(tr->tiles, e->key, e);
+  tr->num_of_tiles++;
+  while (tr->num_of_tiles > tr->max_tiles) {
+    e = tr->last;
+    tile_renderer_unlink(tr, e);
+    gt_hashmap_remove(tr->tiles, e->key);
+    tile_renderer_entry_delete(e);
+    tr->num_of_tiles--;
+  }
+}
+
+/* must be called with the mutex locked, hashes the style contents only if the
+   style has been changed since the last call */
+static int tile_renderer_update_style_hash(GtTileRenderer *tr, GtError *err)
+{
+  GtMD5Encoder *enc;
+  GtStr *style_str;
+  GtUword generation;
+  unsigned char output[16];
+  int had_err;
+  gt_error_check(err);
+
+  generation = gt_style_get_generation(tr->style);
+  if (tr->style_hash_valid && tr->style_generation == generation)
+    return 0;
+  style_str = gt_str_new();
+  had_err = gt_style_to_str(tr->style, style_str, err);
+  if (!had_err) {
+    const char *s = gt_str_get(style_str);
+    GtUword i, len = gt_str_length(style_str);
+    enc = gt_md5_encoder_new();
+    for (i = 0; len - i > 64; i += 64)
+      gt_md5_encoder_add_block(enc, s + i, 64);
+    gt_md5_encoder_add_block(enc, s + i, len - i);
+    gt_md5_encoder_finish(enc, output, tr->style_hash);
+    gt_md5_encoder_delete(enc);
+    tr->style_generation = generation;
+    tr->style_hash_valid = true;
+  }
+  gt_str_delete(style_str);
+  return had_err;
+}
+
+/* the key of a tile consists of <key_prefix> and the tile number, must be
+   called with the mutex locked */
+static int tile_renderer_key_prefix(GtTileRenderer *tr, const char *seqid,
+                                    GtUword zoom, GtStr *key_prefix,
+                                    GtError *err)
+{
+  int had_err;
+  gt_error_check(err);
+
+  had_err = tile_renderer_update_style_hash(tr, err);
+  if (!had_err) {
+    gt_str_reset(key_prefix);
+    gt_str_append_cstr(key_prefix, seqid);
+    gt_str_append_char(key_prefix, '\t');
+    gt_str_append_uword(key_prefix, zoom);
+    gt_str_append_char(key_prefix, '\t');
+    gt_str_append_uword(key_prefix,
+                        gt_feature_index_get_generation(tr->feature_index));
+    gt_str_append_char(key_prefix, '\t');
+    gt_str_append_cstr(key_prefix, tr->style_hash);
+    gt_str_append_char(key_prefix, '\t');
+  }
+  return had_err;
+}
+
+static void tile_renderer_key(GtStr *key, const GtStr *key_prefix,
+                              GtUword tile)
+{
+  gt_str_reset(key);
+  gt_str_append_str(key, key_prefix);
+  gt_str_append_uword(key, tile);
+}
+
+static int tile_renderer_render(GtTileRenderer *tr, GtStyle *style,
+                                const char *seqid, const GtRange *range,
+                                GtStr *image, GtError *err)
+{
+  GtDiagram *d = NULL;
+  GtLayout *l = NULL;
+  GtCanvas *canvas = NULL;
+  GtUword height;
+  int had_err = 0;
+  gt_error_check(err);
+
+  if (!(d = gt_diagram_new(tr->feature_index, seqid, range, style, err)))
+    had_err = -1;
+  if (!had_err && !(l = gt_layout_new(d, tr->tile_width, style, err)))
+    had_err = -1;
+  if (!had_err)
+    had_err = gt_layout_get_height(l, &height, err);
+  if (!had_err && !(canvas = gt_canvas_cairo_file_new(style, GT_GRAPHICS_PNG,
+                                                      tr->tile_width, height,
+                                                      NULL, err))) {
+    had_err = -1;
+  }
+  if (!had_err)
+    had_err = gt_layout_sketch(l, canvas, err);
+  if (!had_err)
+    had_err = gt_canvas_cairo_file_to_stream((GtCanvasCairoFile*) canvas,
+                                             image);
+  gt_canvas_delete(canvas);
+  gt_layout_delete(l);
+  gt_diagram_delete(d);
+  return had_err;
+}
+
+int gt_tile_renderer_get_tile(GtTileRenderer *tr, const char *seqid,
+                              GtUword zoom, GtUword tile, GtStr *image,
+                              GtError *err)
+{
+  GtTileRendererEntry *e;
+  GtStr *key_prefix, *key, *rendered;
+  GtStyle *style;
+  GtRange range;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(tr && seqid && image);
+
+  key_prefix = gt_str_new();
+  key = gt_str_new();
+  gt_mutex_lock(tr->mutex);
+  had_err = tile_renderer_key_prefix(tr, seqid, zoom, key_prefix, err);
+  if (had_err)
+    gt_mutex_unlock(tr->mutex);
+  else {
+    tile_renderer_key(key, key_prefix, tile);
+    if ((e = tile_renderer_cache_get(tr, gt_str_get(key)))) {
+      gt_str_append_str(image, e->image);
+      tr->hits++;
+      gt_mutex_unlock(tr->mutex);
+      gt_str_delete(key);
+      gt_str_delete(key_prefix);
+      return 0;
+    }
+    tr->misses++;
+    gt_mutex_unlock(tr->mutex);
+    /* rendering runs unlocked, so it must not use the Lua state of the shared
+       style (see tile_renderer_worker()) */
+    range = gt_tile_renderer_get_tile_range(tr, zoom, tile);
+    rendered = gt_str_new();
+    if (!(style = gt_style_clone(tr->style, err)))
+      had_err = -1;
+    if (!had_err)
+      had_err = tile_renderer_render(tr, style, seqid, &range, rendered, err);
+    gt_style_delete(style);
+    if (!had_err) {
+      gt_str_append_str(image, rendered);
+      gt_mutex_lock(tr->mutex);
+      tile_renderer_cache_add(tr, gt_str_get(key), rendered);
+      gt_mutex_unlock(tr->mutex);
+    }
+    else
+      gt_str_delete(rendered);
+  }
+  gt_str_delete(key);
+  gt_str_delete(key_prefix);
+  return had_err;
+}
+
+static void* tile_renderer_worker(void *data)
+{
+  GtTileRendererJobs *jobs = (GtTileRendererJobs*) data;
+  GtTileRenderer *tr = jobs->tile_renderer;
+  GtStyle *style;
+  GtStr *key;
+  GtError *err;
+  int had_err = 0;
+
+  /* the Lua state of a style must not be shared between threads */
+  err = gt_error_new();
+  key = gt_str_new();
+  if (!(style = gt_style_clone(tr->style, err)))
+    had_err = -1;
+  while (!had_err) {
+    GtUword tile;
+    GtRange range;
+    GtStr *image;
+    gt_mutex_lock(tr->mutex);
+    if (gt_error_is_set(jobs->err) ||
+        jobs->next_job == gt_array_size(jobs->jobs)) {
+      gt_mutex_unlock(tr->mutex);
+      break;
+    }
+    tile = *(GtUword*) gt_array_get(jobs->jobs, jobs->next_job++);
+    gt_mutex_unlock(tr->mutex);
+    range = gt_tile_renderer_get_tile_range(tr, jobs->zoom, tile);
+    image = gt_str_new();
+    had_err = tile_renderer_render(tr, style, jobs->seqid, &range, image, err);
+    if (!had_err) {
+      tile_renderer_key(key, jobs->key_prefix, tile);
+      gt_mutex_lock(tr->mutex);
+      tile_renderer_cache_add(tr, gt_str_get(key), image);
+      gt_mutex_unlock(tr->mutex);
+    }
+    else
+      gt_str_delete(image);
+  }
+  if (had_err) {
+    gt_mutex_lock(tr->mutex);
+    if (!gt_error_is_set(jobs->err))
+      gt_error_set(jobs->err, "%s", gt_error_get(err));
+    gt_mutex_unlock(tr->mutex);
+  }
+  gt_style_delete(style);
+  gt_str_delete(key);
+  gt_error_delete(err);
+  return NULL;
+}
+
+int gt_tile_renderer_prepare(GtTileRenderer *tr, const char *seqid,
+                             GtUword zoom, const GtRange *range, GtError *err)
+{
+  GtTileRendererJobs jobs;
+  GtStr *key;
+  GtUword tile, first_tile, last_tile, length;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(tr && seqid && range && range->start <= range->end);
+
+  jobs.tile_renderer = tr;
+  jobs.seqid = seqid;
+  jobs.zoom = zoom;
+  jobs.next_job = 0;
+  jobs.jobs = gt_array_new(sizeof (GtUword));
+  jobs.key_prefix = gt_str_new();
+  jobs.err = err;
+  key = gt_str_new();
+  gt_mutex_lock(tr->mutex);
+  had_err = tile_renderer_key_prefix(tr, seqid, zoom, jobs.key_prefix, err);
+  if (had_err)
+    gt_mutex_unlock(tr->mutex);
+  else {
+    length = tr->tile_length << zoom;
+    first_tile = range->start ? (range->start - 1) / length : 0;
+    last_tile = range->end ? (range->end - 1) / length : 0;
+    /* tiles beyond the cache capacity would only evict each other, so only
+       the first ones are rendered */
+    last_tile = GT_MIN(last_tile, first_tile + tr->max_tiles - 1);
+    for (tile = first_tile; tile <= last_tile; tile++) {
+      tile_renderer_key(key, jobs.key_prefix, tile);
+      if (!tile_renderer_cache_get(tr, gt_str_get(key)))
+        gt_array_add(jobs.jobs, tile);
+    }
+    gt_mutex_unlock(tr->mutex);
+    if (gt_array_size(jobs.jobs) > 0)
+      had_err = gt_multithread(tile_renderer_worker, &jobs, err);
+    if (!had_err && gt_error_is_set(err))
+      had_err = -1;
+  }
+  gt_str_delete(key);
+  gt_str_delete(jobs.key_prefix);
+  gt_array_delete(jobs.jobs);
+  return had_err;
+}
+
+void gt_tile_renderer_clear(GtTileRenderer *tr)
+{
+  GtTileRendererEntry *e, *next;
+  gt_assert(tr);
+  gt_mutex_lock(tr->mutex);
+  for (e = tr->first; e != NULL; e = next) {
+    next = e->next;
+    tile_renderer_entry_delete(e);
+  }
+  tr->first = tr->last = NULL;
+  tr->num_of_tiles = 0;
+  gt_hashmap_reset(tr->tiles);
+  gt_mutex_unlock(tr->mutex);
+}
+
+void gt_tile_renderer_delete(GtTileRenderer *tr)
+{
+  if (!tr) return;
+  gt_tile_renderer_clear(tr);
+  gt_hashmap_delete(tr->tiles);
+  gt_mutex_delete(tr->mutex);
+  gt_style_delete(tr->style);
+  gt_feature_index_delete(tr->feature_index);
+  gt_free(tr);
+}
+
+int gt_tile_renderer_unit_test(GtError *err)
+{
+  GtFeatureIndex *fi;
+  GtGenomeNode *gn;
+  GtTileRenderer *tr;
+  GtStyle *style;
+  GtStr *image, *image2;
+  GtRange range;
+  GtUword style_generation;
+  int had_err = 0;
+  gt_error_check(err);
+
+  if (!(style = gt_style_new(err)))
+    return -1;
+  fi = gt_feature_index_memory_new();
+  gn = gt_feature_node_new_standard_gene();
+  had_err = gt_feature_index_add_feature_node(fi, (GtFeatureNode*) gn, err);
+  gt_genome_node_delete(gn);
+  tr = gt_tile_renderer_new(fi, style, 200, 1000, 4);
+  image = gt_str_new();
+  image2 = gt_str_new();
+
+  range = gt_tile_renderer_get_tile_range(tr, 1, 2);
+  gt_ensure(range.start == 4001 && range.end == 6000);
+
+  /* repeated requests are served from the cache */
+  if (!had_err)
+    had_err = gt_tile_renderer_get_tile(tr, "ctg123", 0, 1, image, err);
+  gt_ensure(gt_str_length(image) > 8);
+  gt_ensure(memcmp(gt_str_get(image), "\211PNG", 4) == 0);
+  gt_ensure(tr->misses == 1 && tr->hits == 0);
+  if (!had_err)
+    had_err = gt_tile_renderer_get_tile(tr, "ctg123", 0, 1, image2, err);
+  gt_ensure(tr->misses == 1 && tr->hits == 1);
+  gt_ensure(gt_str_cmp(image, image2) == 0);
+  gt_ensure(tr->style_hash_valid);
+  style_generation = tr->style_generation;
+
+  /* unknown sequences are reported */
+  if (!had_err) {
+    GtError *testerr = gt_error_new();
+    gt_ensure(gt_tile_renderer_get_tile(tr, "foo", 0, 1, image2, testerr));
+    gt_ensure(gt_error_is_set(testerr));
+    gt_error_delete(testerr);
+  }
+
+  /* prepared tiles are cached up to the cache capacity */
+  range.start = 1;
+  range.end = 10000;
+  if (!had_err)
+    had_err = gt_tile_renderer_prepare(tr, "ctg123", 0, &range, err);
+  gt_ensure(tr->num_of_tiles == 4);
+  gt_str_reset(image2);
+  if (!had_err)
+    had_err = gt_tile_renderer_get_tile(tr, "ctg123", 0, 3, image2, err);
+  gt_ensure(tr->hits == 2);
+
+  /* changes to the feature index or the style invalidate the cache */
+  if (!had_err) {
+    GtStr *seqid = gt_str_new_cstr("ctg123");
+    gn = gt_feature_node_new(seqid, "gene", 1500, 1800, GT_STRAND_FORWARD);
+    had_err = gt_feature_index_add_feature_node(fi, (GtFeatureNode*) gn, err);
+    gt_genome_node_delete(gn);
+    gt_str_delete(seqid);
+  }
+  gt_str_reset(image2);
+  if (!had_err)
+    had_err = gt_tile_renderer_get_tile(tr, "ctg123", 0, 1, image2, err);
+  gt_ensure(tr->misses == 2);
+  gt_ensure(gt_str_cmp(image, image2) != 0);
+  gt_style_set_num(style, "format", "track_vspace", 30);
+  gt_str_reset(image2);
+  if (!had_err)
+    had_err = gt_tile_renderer_get_tile(tr, "ctg123", 0, 1, image2, err);
+  gt_ensure(tr->misses == 3);
+  gt_ensure(tr->style_generation != style_generation);
+
+  gt_tile_renderer_clear(tr);
+  gt_ensure(tr->num_of_tiles == 0);
+
+  gt_str_delete(image);
+  gt_str_delete(image2);
+  gt_tile_renderer_delete(tr);
+  gt_feature_index_delete(fi);
+  gt_style_delete(style);
+  return had_err;
+}
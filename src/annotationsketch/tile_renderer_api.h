@@ -0,0 +1,67 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef TILE_RENDERER_API_H
+#define TILE_RENDERER_API_H
+
+#include "annotationsketch/style_api.h"
+#include "core/range_api.h"
+#include "core/str_api.h"
+#include "extended/feature_index_api.h"
+
+/* The <GtTileRenderer> class renders the features of a <GtFeatureIndex> as
+   PNG images of fixed genomic tiles, as needed by genome browsers. At zoom
+   level 0 a tile covers <tile_length> bases, each further zoom level doubles
+   the number of bases per tile. Tile <t> starts at position
+   <t * tile_length * 2^zoom + 1>. Rendered tiles are kept in a cache of
+   limited size from which the least recently used tile is evicted. Cached
+   tiles are keyed by sequence, zoom level, tile number, the contents of the
+   style and the generation of the feature index, so that changes to either
+   of them are never served from stale tiles. */
+typedef struct GtTileRenderer GtTileRenderer;
+
+/* Returns a new <GtTileRenderer> rendering the features of <feature_index>
+   using <style> into tiles <tile_width> pixels wide, with <tile_length>
+   bases per tile at zoom level 0. At most <max_tiles> rendered tiles are
+   cached. */
+GtTileRenderer* gt_tile_renderer_new(GtFeatureIndex *feature_index,
+                                     GtStyle *style, GtUword tile_width,
+                                     GtUword tile_length, GtUword max_tiles);
+/* Returns the sequence range covered by tile number <tile> at <zoom> level. */
+GtRange         gt_tile_renderer_get_tile_range(const GtTileRenderer
+                                                *tile_renderer,
+                                                GtUword zoom, GtUword tile);
+/* Appends the PNG image data of tile number <tile> of sequence <seqid> at
+   <zoom> level to <image>, rendering the tile unless it is cached.
+   Returns 0 on success, -1 otherwise and sets <err> accordingly. */
+int             gt_tile_renderer_get_tile(GtTileRenderer *tile_renderer,
+                                          const char *seqid, GtUword zoom,
+                                          GtUword tile, GtStr *image,
+                                          GtError *err);
+/* Renders all tiles of sequence <seqid> at <zoom> level overlapping <range>
+   which are not cached yet and adds them to the cache. The tiles are laid out
+   and rendered concurrently by <gt_jobs> threads. If more tiles are needed
+   than fit into the cache, only the first ones are rendered.
+   Returns 0 on success, -1 otherwise and sets <err> accordingly. */
+int             gt_tile_renderer_prepare(GtTileRenderer *tile_renderer,
+                                         const char *seqid, GtUword zoom,
+                                         const GtRange *range, GtError *err);
+/* Removes all tiles from the cache of <tile_renderer>. */
+void            gt_tile_renderer_clear(GtTileRenderer *tile_renderer);
+/* Deletes <tile_renderer>. */
+void            gt_tile_renderer_delete(GtTileRenderer *tile_renderer);
+
+#endif
@@ -0,0 +1,288 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/assert_api.h"
+#include "core/bounded_queue.h"
+#include "core/ensure_api.h"
+#include "core/ma_api.h"
+#include "core/thread_api.h"
+
+#ifdef GT_THREADS_ENABLED
+#include <pthread.h>
+#endif
+
+#define GT_BOUNDED_QUEUE_CACHELINE  64
+
+/* the producer only writes <tail>, the consumer only writes <head>; both are
+   kept on separate cache lines to avoid false sharing */
+#define gt_bounded_queue_load(PTR) \
+        __atomic_load_n(PTR, __ATOMIC_ACQUIRE)
+#define gt_bounded_queue_store(PTR, VAL) \
+        __atomic_store_n(PTR, VAL, __ATOMIC_RELEASE)
+
+/* A thread which finds the queue full (empty) increments <waiters>, checks
+   again and only then sleeps on <changed>. The other side checks <waiters>
+   after each successful operation and wakes it up under <lock>. As both sides
+   order these accesses sequentially consistent, no wake-up is lost. */
+struct GtBoundedQueue {
+  void **contents;
+  GtUword mask;
+#ifdef GT_THREADS_ENABLED
+  pthread_mutex_t lock;
+  pthread_cond_t changed;
+#endif
+  unsigned int waiters;
+  bool closed;
+  char pad0[GT_BOUNDED_QUEUE_CACHELINE];
+  GtUword head;
+  char pad1[GT_BOUNDED_QUEUE_CACHELINE - sizeof (GtUword)];
+  GtUword tail;
+  char pad2[GT_BOUNDED_QUEUE_CACHELINE - sizeof (GtUword)];
+};
+
+GtBoundedQueue* gt_bounded_queue_new(GtUword capacity)
+{
+  GtBoundedQueue *queue;
+  GtUword size = 1UL;
+  gt_assert(capacity > 0);
+  while (size < capacity)
+    size <<= 1;
+  queue = gt_calloc(1, sizeof *queue);
+  queue->contents = gt_calloc((size_t) size, sizeof (void*));
+  queue->mask = size - 1;
+#ifdef GT_THREADS_ENABLED
+  (void) pthread_mutex_init(&queue->lock, NULL);
+  (void) pthread_cond_init(&queue->changed, NULL);
+#endif
+  return queue;
+}
+
+bool gt_bounded_queue_try_add(GtBoundedQueue *queue, void *elem)
+{
+  GtUword tail, head;
+  gt_assert(queue);
+  tail = queue->tail;
+  head = gt_bounded_queue_load(&queue->head);
+  if (tail - head > queue->mask)
+    return false;
+  queue->contents[tail & queue->mask] = elem;
+  gt_bounded_queue_store(&queue->tail, tail + 1);
+  return true;
+}
+
+bool gt_bounded_queue_try_get(GtBoundedQueue *queue, void **elem)
+{
+  GtUword tail, head;
+  gt_assert(queue && elem);
+  head = queue->head;
+  tail = gt_bounded_queue_load(&queue->tail);
+  if (head == tail)
+    return false;
+  *elem = queue->contents[head & queue->mask];
+  gt_bounded_queue_store(&queue->head, head + 1);
+  return true;
+}
+
+GtUword gt_bounded_queue_size(const GtBoundedQueue *queue)
+{
+  GtUword tail, head;
+  gt_assert(queue);
+  head = gt_bounded_queue_load(&queue->head);
+  tail = gt_bounded_queue_load(&queue->tail);
+  return tail - head;
+}
+
+GtUword gt_bounded_queue_capacity(const GtBoundedQueue *queue)
+{
+  gt_assert(queue);
+  return queue->mask + 1;
+}
+
+#ifdef GT_THREADS_ENABLED
+/* wake up the other side if it waits for the queue to change */
+static void bounded_queue_notify(GtBoundedQueue *queue)
+{
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  if (__atomic_load_n(&queue->waiters, __ATOMIC_SEQ_CST)) {
+    (void) pthread_mutex_lock(&queue->lock);
+    (void) pthread_cond_broadcast(&queue->changed);
+    (void) pthread_mutex_unlock(&queue->lock);
+  }
+}
+
+/* block until <queue> is not full (<full> is true) or not empty (<full> is
+   false) or it has been closed */
+static void bounded_queue_wait(GtBoundedQueue *queue, bool full)
+{
+  GtUword head, tail;
+  (void) pthread_mutex_lock(&queue->lock);
+  (void) __atomic_add_fetch(&queue->waiters, 1U, __ATOMIC_SEQ_CST);
+  head = __atomic_load_n(&queue->head, __ATOMIC_SEQ_CST);
+  tail = __atomic_load_n(&queue->tail, __ATOMIC_SEQ_CST);
+  if (!__atomic_load_n(&queue->closed, __ATOMIC_SEQ_CST)
+        && (full ? tail - head > queue->mask : head == tail))
+    (void) pthread_cond_wait(&queue->changed, &queue->lock);
+  (void) __atomic_sub_fetch(&queue->waiters, 1U, __ATOMIC_SEQ_CST);
+  (void) pthread_mutex_unlock(&queue->lock);
+}
+#endif
+
+bool gt_bounded_queue_add(GtBoundedQueue *queue, void *elem)
+{
+  gt_assert(queue);
+  for (;;) {
+    if (gt_bounded_queue_load(&queue->closed))
+      return false;
+    if (gt_bounded_queue_try_add(queue, elem)) {
+#ifdef GT_THREADS_ENABLED
+      bounded_queue_notify(queue);
+#endif
+      return true;
+    }
+#ifdef GT_THREADS_ENABLED
+    bounded_queue_wait(queue, true);
+#else
+    return false;
+#endif
+  }
+}
+
+bool gt_bounded_queue_get(GtBoundedQueue *queue, void **elem)
+{
+  gt_assert(queue && elem);
+  for (;;) {
+    /* elements added before closing are still delivered */
+    bool closed = gt_bounded_queue_load(&queue->closed);
+    if (gt_bounded_queue_try_get(queue, elem)) {
+#ifdef GT_THREADS_ENABLED
+      bounded_queue_notify(queue);
+#endif
+      return true;
+    }
+    if (closed)
+      return false;
+#ifdef GT_THREADS_ENABLED
+    bounded_queue_wait(queue, false);
+#else
+    return false;
+#endif
+  }
+}
+
+void gt_bounded_queue_close(GtBoundedQueue *queue)
+{
+  gt_assert(queue);
+  __atomic_store_n(&queue->closed, true, __ATOMIC_SEQ_CST);
+#ifdef GT_THREADS_ENABLED
+  (void) pthread_mutex_lock(&queue->lock);
+  (void) pthread_cond_broadcast(&queue->changed);
+  (void) pthread_mutex_unlock(&queue->lock);
+#endif
+}
+
+bool gt_bounded_queue_is_closed(const GtBoundedQueue *queue)
+{
+  gt_assert(queue);
+  return gt_bounded_queue_load(&queue->closed);
+}
+
+void gt_bounded_queue_delete(GtBoundedQueue *queue)
+{
+  if (!queue) return;
+#ifdef GT_THREADS_ENABLED
+  (void) pthread_cond_destroy(&queue->changed);
+  (void) pthread_mutex_destroy(&queue->lock);
+#endif
+  gt_free(queue->contents);
+  gt_free(queue);
+}
+
+#define GT_BOUNDED_QUEUE_TEST_ELEMS 100000UL
+
+#ifdef GT_THREADS_ENABLED
+static void* bounded_queue_test_producer(void *data)
+{
+  GtBoundedQueue *queue = data;
+  GtUword i;
+  for (i = 1; i <= GT_BOUNDED_QUEUE_TEST_ELEMS; i++) {
+    if (!gt_bounded_queue_add(queue, (void*) i))
+      break;
+  }
+  gt_bounded_queue_close(queue);
+  return NULL;
+}
+#endif
+
+int gt_bounded_queue_unit_test(GtError *err)
+{
+  GtBoundedQueue *q;
+  GtUword i;
+  void *elem = NULL;
+  int had_err = 0;
+  gt_error_check(err);
+
+  /* capacity is rounded up */
+  q = gt_bounded_queue_new(5);
+  gt_ensure(gt_bounded_queue_capacity(q) == 8);
+  gt_ensure(!gt_bounded_queue_size(q));
+  gt_ensure(!gt_bounded_queue_try_get(q, &elem));
+
+  /* fill, overflow, drain with wraparound */
+  for (i = 0; !had_err && i < 8; i++)
+    gt_ensure(gt_bounded_queue_try_add(q, (void*) i));
+  gt_ensure(!gt_bounded_queue_try_add(q, (void*) 8));
+  gt_ensure(gt_bounded_queue_size(q) == 8);
+  for (i = 0; !had_err && i < 5; i++) {
+    gt_ensure(gt_bounded_queue_try_get(q, &elem));
+    gt_ensure(elem == (void*) i);
+  }
+  for (i = 8; !had_err && i < 13; i++)
+    gt_ensure(gt_bounded_queue_try_add(q, (void*) i));
+  for (i = 5; !had_err && i < 13; i++) {
+    gt_ensure(gt_bounded_queue_try_get(q, &elem));
+    gt_ensure(elem == (void*) i);
+  }
+  gt_ensure(!gt_bounded_queue_try_get(q, &elem));
+  gt_bounded_queue_delete(q);
+
+#ifdef GT_THREADS_ENABLED
+  /* one producer, one consumer */
+  if (!had_err) {
+    GtThread *producer;
+    q = gt_bounded_queue_new(16);
+    if (!(producer = gt_thread_new(bounded_queue_test_producer, q, err)))
+      had_err = -1;
+    for (i = 1; !had_err && i <= GT_BOUNDED_QUEUE_TEST_ELEMS; i++) {
+      gt_ensure(gt_bounded_queue_get(q, &elem));
+      gt_ensure(elem == (void*) i);
+    }
+    if (!had_err) {
+      /* the producer closed the queue after the last element */
+      gt_ensure(!gt_bounded_queue_get(q, &elem));
+      gt_ensure(gt_bounded_queue_is_closed(q));
+    }
+    if (producer) {
+      /* closing the queue makes a blocked producer give up */
+      gt_bounded_queue_close(q);
+      gt_thread_join(producer);
+      gt_thread_delete(producer);
+    }
+    gt_bounded_queue_delete(q);
+  }
+#endif
+
+  return had_err;
+}
@@ -0,0 +1,65 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <stdbool.h>
+#include "core/error_api.h"
+#include "core/types_api.h"
+
+/* <GtBoundedQueue> objects are fixed-capacity First-In-First-Out queues of
+   pointers for exactly one producer thread and one consumer thread, which
+   makes them suitable for connecting the stages of a pipeline running on
+   separate threads. Adding and removing is lock-free, a mutex and a condition
+   variable are only used to put a side to sleep while the queue is full or
+   empty. */
+typedef struct GtBoundedQueue GtBoundedQueue;
+
+/* Return a new <GtBoundedQueue> which can hold at least <capacity> elements.
+   The capacity is rounded up to the next power of two. */
+GtBoundedQueue* gt_bounded_queue_new(GtUword capacity);
+/* Add <elem> to <queue> if it is not full. Returns false if <queue> is full.
+   Must only be called by the producer thread. */
+bool            gt_bounded_queue_try_add(GtBoundedQueue *queue, void *elem);
+/* Remove the first element from <queue> and store it in <elem>. Returns false
+   if <queue> is empty. Must only be called by the consumer thread. */
+bool            gt_bounded_queue_try_get(GtBoundedQueue *queue, void **elem);
+/* Return the number of elements in <queue>. If called concurrently to
+   additions or removals, the result is only a snapshot. */
+GtUword         gt_bounded_queue_size(const GtBoundedQueue *queue);
+/* Return the capacity of <queue>. */
+GtUword         gt_bounded_queue_capacity(const GtBoundedQueue *queue);
+/* Add <elem> to <queue>, waiting until there is room for it. Returns false
+   without adding <elem> if <queue> has been closed. Without thread support
+   this never waits and returns false if <queue> is full. Must only be called
+   by the producer thread. */
+bool            gt_bounded_queue_add(GtBoundedQueue *queue, void *elem);
+/* Remove the first element from <queue> and store it in <elem>, waiting until
+   there is one. Returns false if <queue> is empty and has been closed. Without
+   thread support this never waits and returns false if <queue> is empty. Must
+   only be called by the consumer thread. */
+bool            gt_bounded_queue_get(GtBoundedQueue *queue, void **elem);
+/* Close <queue>: waiting threads are woken up, further additions fail and
+   removals fail as soon as <queue> is empty. May be called by both sides. */
+void            gt_bounded_queue_close(GtBoundedQueue *queue);
+/* Return true if <queue> has been closed. */
+bool            gt_bounded_queue_is_closed(const GtBoundedQueue *queue);
+/* Delete <queue>. Elements contained in <queue> are not freed! */
+void            gt_bounded_queue_delete(GtBoundedQueue *queue);
+int             gt_bounded_queue_unit_test(GtError *err);
+
+#endif
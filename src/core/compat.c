@@ -18,6 +18,7 @@
 #include <sys/stat.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <stdio.h>
 #include <unistd.h>
 #include <stdlib.h>
 #ifdef _WIN32
@@ -53,3 +54,20 @@ GtUword gt_pagesize(void)
   return si.dwPageSize;
 #endif
 }
+
+FILE* gt_fmemopen_read(void *buf, size_t size)
+{
+  FILE *fp;
+#ifndef _WIN32
+  fp = fmemopen(buf, size, "r");
+#else
+  if ((fp = tmpfile()) != NULL) {
+    if (fwrite(buf, sizeof (char), size, fp) != size) {
+      (void) fclose(fp);
+      return NULL;
+    }
+    rewind(fp);
+  }
+#endif
+  return fp;
+}
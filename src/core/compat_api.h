@@ -17,6 +17,7 @@
 #ifndef COMPAT_API_H
 #define COMPAT_API_H
 
+#include <stdio.h>
 #include "core/types_api.h"
 
 /* Compat module */
@@ -41,5 +42,9 @@
 int     gt_mkstemp(char *templ);
 /* Returns the page size of the current platform. */
 GtUword gt_pagesize(void);
+/* Returns a stream for reading the <size> bytes at <buf>, or NULL on error.
+   Platforms without fmemopen(3) get a copy in a temporary file. <buf> must
+   stay valid until the stream is closed with fclose(3). */
+FILE*   gt_fmemopen_read(void *buf, size_t size);
 
 #endif
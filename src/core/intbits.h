@@ -235,6 +235,26 @@ static const unsigned char ReversedByte[256] =
   return out;
 }
 
+/* Returns the number of leading zeros of <bs>, which must not be 0. */
+/*@unused@*/
+static inline unsigned int gt_intbits_leading_zeros(GtBitsequence bs)
+{
+#ifdef __GNUC__
+#if defined (_LP64) || defined (_WIN64)
+  return (unsigned int) __builtin_clzll((unsigned long long) bs);
+#else
+  return (unsigned int) __builtin_clz((unsigned int) bs);
+#endif
+#else
+  unsigned int count = 0;
+  while ((bs & GT_FIRSTBIT) == 0) {
+    bs <<= 1;
+    count++;
+  }
+  return count;
+#endif
+}
+
 /*@unused@*/
 static inline GtBitsequence gt_intbits_reverse_unitwise(GtBitsequence bs)
 {
@@ -0,0 +1,421 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <stdlib.h>
+#include "core/ensure_api.h"
+#include "core/fptr_api.h"
+#include "core/interval_index.h"
+#include "core/interval_tree.h"
+#include "core/ma_api.h"
+#include "core/mathsupport_api.h"
+#include "core/minmax_api.h"
+#include "core/unused_api.h"
+
+/* subtrees of this height are scanned linearly */
+#define GT_INTERVAL_INDEX_SCAN_LEVEL  3
+#define GT_INTERVAL_INDEX_STACK_SIZE  64
+
+typedef struct {
+  GtUword start,
+          end,
+          max_end; /* maximum end in the implicit subtree of this interval */
+  void *data;
+} GtIntervalIndexEntry;
+
+struct GtIntervalIndex {
+  GtArray *entries;
+  GtUword max_level;
+  bool built;
+};
+
+GtIntervalIndex* gt_interval_index_new(void)
+{
+  GtIntervalIndex *ii = gt_malloc(sizeof *ii);
+  ii->entries = gt_array_new(sizeof (GtIntervalIndexEntry));
+  ii->max_level = 0;
+  ii->built = true;
+  return ii;
+}
+
+void gt_interval_index_add(GtIntervalIndex *ii, GtUword start, GtUword end,
+                           void *data)
+{
+  GtIntervalIndexEntry entry;
+  gt_assert(ii && start <= end);
+  entry.start = start;
+  entry.end = entry.max_end = end;
+  entry.data = data;
+  gt_array_add(ii->entries, entry);
+  ii->built = false;
+}
+
+static int interval_index_entry_cmp(const void *a, const void *b)
+{
+  const GtIntervalIndexEntry *ea = a, *eb = b;
+  if (ea->start != eb->start)
+    return ea->start < eb->start ? -1 : 1;
+  if (ea->end != eb->end)
+    return ea->end < eb->end ? -1 : 1;
+  return 0;
+}
+
+/* computes the maximum end positions of the implicit tree in which the
+   intervals at level k are those with index (2^k - 1) mod 2^(k+1), returns the
+   height of the tree */
+static GtUword interval_index_augment(GtIntervalIndexEntry *a, GtUword n)
+{
+  GtUword i, k, last_i = 0, last = 0;
+  if (n == 0)
+    return 0;
+  for (i = 0; i < n; i += 2) {
+    last_i = i;
+    last = a[i].max_end = a[i].end;
+  }
+  for (k = 1; (1UL << k) <= n; k++) {
+    GtUword x = 1UL << (k - 1), step = x << 2;
+    for (i = (x << 1) - 1; i < n; i += step) {
+      GtUword end = GT_MAX(a[i].end, a[i - x].max_end);
+      a[i].max_end = GT_MAX(end, i + x < n ? a[i + x].max_end : last);
+    }
+    last_i = (last_i >> k & 1) ? last_i - x : last_i + x;
+    if (last_i < n && a[last_i].max_end > last)
+      last = a[last_i].max_end;
+  }
+  return k - 1;
+}
+
+void gt_interval_index_build(GtIntervalIndex *ii)
+{
+  gt_assert(ii);
+  if (ii->built)
+    return;
+  gt_array_sort_stable(ii->entries, interval_index_entry_cmp);
+  ii->max_level = interval_index_augment(gt_array_get_space(ii->entries),
+                                         gt_array_size(ii->entries));
+  ii->built = true;
+}
+
+bool gt_interval_index_remove(GtIntervalIndex *ii, GtUword start,
+                              GtUword end, const void *data)
+{
+  GtIntervalIndexEntry *a;
+  GtUword i, n, left = 0, right;
+  gt_assert(ii);
+  a = gt_array_get_space(ii->entries);
+  n = right = gt_array_size(ii->entries);
+  if (ii->built) {
+    /* find the first interval not smaller than the given one */
+    while (left < right) {
+      GtUword mid = left + (right - left) / 2;
+      if (a[mid].start < start || (a[mid].start == start && a[mid].end < end))
+        left = mid + 1;
+      else
+        right = mid;
+    }
+  }
+  for (i = left; i < n; i++) {
+    if (a[i].start == start && a[i].end == end && a[i].data == data) {
+      gt_array_rem(ii->entries, i);
+      ii->built = false;
+      return true;
+    }
+    if (ii->built && (a[i].start != start || a[i].end != end))
+      break;
+  }
+  return false;
+}
+
+GtUword gt_interval_index_size(const GtIntervalIndex *ii)
+{
+  gt_assert(ii);
+  return gt_array_size(ii->entries);
+}
+
+void* gt_interval_index_get(const GtIntervalIndex *ii, GtUword i)
+{
+  gt_assert(ii && ii->built && i < gt_array_size(ii->entries));
+  return ((GtIntervalIndexEntry*) gt_array_get(ii->entries, i))->data;
+}
+
+GtUword gt_interval_index_iterate_overlapping(const GtIntervalIndex *ii,
+                                              GtUword start, GtUword end,
+                                              GtIntervalIndexIteratorFunc func,
+                                              void *info)
+{
+  const GtIntervalIndexEntry *a;
+  struct {
+    GtUword x,
+            k;
+    bool visited;
+  } stack[GT_INTERVAL_INDEX_STACK_SIZE];
+  GtUword n, count = 0;
+  int t = 0;
+  gt_assert(ii && ii->built && func);
+
+  if (!(n = gt_array_size(ii->entries)))
+    return 0;
+  a = gt_array_get_space(ii->entries);
+  /* in-order traversal, left subtrees are skipped if their maximum end lies
+     before the query, right subtrees if the root starts after it */
+  stack[t].x = (1UL << ii->max_level) - 1;
+  stack[t].k = ii->max_level;
+  stack[t++].visited = false;
+  while (t > 0) {
+    GtUword x, k;
+    bool visited;
+    t--;
+    x = stack[t].x;
+    k = stack[t].k;
+    visited = stack[t].visited;
+    if (k <= GT_INTERVAL_INDEX_SCAN_LEVEL) {
+      GtUword i, i0 = x >> k << k, i1 = GT_MIN(i0 + (1UL << (k + 1)) - 1, n);
+      for (i = i0; i < i1 && a[i].start <= end; i++) {
+        if (start <= a[i].end) {
+          func(a[i].data, a[i].start, a[i].end, info);
+          count++;
+        }
+      }
+    }
+    else if (!visited) {
+      GtUword left = x - (1UL << (k - 1));
+      stack[t].x = x;
+      stack[t].k = k;
+      stack[t++].visited = true;
+      if (left >= n || a[left].max_end >= start) {
+        stack[t].x = left;
+        stack[t].k = k - 1;
+        stack[t++].visited = false;
+      }
+    }
+    else if (x < n && a[x].start <= end) {
+      if (start <= a[x].end) {
+        func(a[x].data, a[x].start, a[x].end, info);
+        count++;
+      }
+      stack[t].x = x + (1UL << (k - 1));
+      stack[t].k = k - 1;
+      stack[t++].visited = false;
+    }
+  }
+  return count;
+}
+
+static void interval_index_collect(void *data, GT_UNUSED GtUword start,
+                                   GT_UNUSED GtUword end, void *info)
+{
+  gt_array_add((GtArray*) info, data);
+}
+
+void gt_interval_index_find_all_overlapping(const GtIntervalIndex *ii,
+                                            GtUword start, GtUword end,
+                                            GtArray *results)
+{
+  gt_assert(results);
+  (void) gt_interval_index_iterate_overlapping(ii, start, end,
+                                               interval_index_collect, results);
+}
+
+int gt_interval_index_iterate_overlapping_batch(const GtIntervalIndex *ii,
+                                                const GtRange *ranges,
+                                                GtUword num_of_ranges,
+                                                GtIntervalIndexBatchFunc func,
+                                                void *info)
+{
+  const GtIntervalIndexEntry *a;
+  GtUword n, q, next = 0, num_of_active = 0, *active;
+  int rval = 0;
+  gt_assert(ii && ii->built && (ranges || !num_of_ranges) && func);
+
+  if (!(n = gt_array_size(ii->entries)) || !num_of_ranges)
+    return 0;
+  a = gt_array_get_space(ii->entries);
+  /* <active> holds the intervals which started before the end of a previous
+     query and did not end before the start of the current one, in the order
+     of their start positions */
+  active = gt_malloc(sizeof (GtUword) * n);
+  for (q = 0; !rval && q < num_of_ranges; q++) {
+    GtUword i, kept = 0;
+    gt_assert(q == 0 || ranges[q-1].start <= ranges[q].start);
+    while (next < n && a[next].start <= ranges[q].end)
+      active[num_of_active++] = next++;
+    for (i = 0; !rval && i < num_of_active; i++) {
+      const GtIntervalIndexEntry *e = a + active[i];
+      /* query starts are sorted, so intervals ending before this query will
+         not overlap later ones */
+      if (e->end < ranges[q].start)
+        continue;
+      active[kept++] = active[i];
+      if (e->start <= ranges[q].end)
+        rval = func(q, e->data, info);
+    }
+    num_of_active = kept;
+  }
+  gt_free(active);
+  return rval;
+}
+
+void gt_interval_index_delete(GtIntervalIndex *ii)
+{
+  if (!ii) return;
+  gt_array_delete(ii->entries);
+  gt_free(ii);
+}
+
+static int interval_index_test_batch(GtUword query_num, void *data,
+                                     void *info)
+{
+  GtArray **results = (GtArray**) gt_array_get_space((GtArray*) info);
+  gt_array_add(results[query_num], data);
+  return 0;
+}
+
+/* stops after the second reported interval */
+static int interval_index_test_batch_stop(GT_UNUSED GtUword query_num,
+                                          GT_UNUSED void *data, void *info)
+{
+  GtUword *count = (GtUword*) info;
+  return ++*count == 2UL ? -1 : 0;
+}
+
+int gt_interval_index_unit_test(GT_UNUSED GtError *err)
+{
+  GtIntervalIndex *ii;
+  GtIntervalTree *it;
+  GtArray *ranges, *res_ii, *res_it, *batch_results;
+  GtRange *queries;
+  GtUword i, j, num_of_ranges = 3000, num_of_queries = 2000,
+          max_pos = 90000, width = 700, query_width = 5000;
+  int had_err = 0, rval;
+  gt_error_check(err);
+
+  /* empty index */
+  ii = gt_interval_index_new();
+  gt_interval_index_build(ii);
+  res_ii = gt_array_new(sizeof (GtRange*));
+  gt_interval_index_find_all_overlapping(ii, 0, 100, res_ii);
+  gt_ensure(gt_array_size(res_ii) == 0);
+  gt_interval_index_delete(ii);
+
+  /* compare random queries with the interval tree */
+  ranges = gt_array_new(sizeof (GtRange));
+  for (i = 0; i < num_of_ranges; i++) {
+    GtRange rng;
+    rng.start = gt_rand_max(max_pos);
+    rng.end = rng.start + gt_rand_max(width);
+    gt_array_add(ranges, rng);
+  }
+  ii = gt_interval_index_new();
+  it = gt_interval_tree_new(NULL);
+  for (i = 0; i < num_of_ranges; i++) {
+    GtRange *rng = gt_array_get(ranges, i);
+    gt_interval_index_add(ii, rng->start, rng->end, rng);
+    gt_interval_tree_insert(it, gt_interval_tree_node_new(rng, rng->start,
+                                                          rng->end));
+  }
+  gt_interval_index_build(ii);
+  gt_ensure(gt_interval_index_size(ii) == num_of_ranges);
+  for (i = 1; !had_err && i < num_of_ranges; i++) {
+    GtRange *prev = gt_interval_index_get(ii, i-1),
+            *cur = gt_interval_index_get(ii, i);
+    gt_ensure(prev->start <= cur->start);
+  }
+  res_it = gt_array_new(sizeof (GtRange*));
+  queries = gt_malloc(sizeof (GtRange) * num_of_queries);
+  for (i = 0; i < num_of_queries; i++) {
+    queries[i].start = gt_rand_max(max_pos);
+    queries[i].end = queries[i].start + gt_rand_max(query_width);
+  }
+  for (i = 0; !had_err && i < num_of_queries; i++) {
+    gt_array_reset(res_ii);
+    gt_array_reset(res_it);
+    gt_interval_index_find_all_overlapping(ii, queries[i].start,
+                                           queries[i].end, res_ii);
+    gt_interval_tree_find_all_overlapping(it, queries[i].start,
+                                          queries[i].end, res_it);
+    gt_ensure(gt_array_size(res_ii) == gt_array_size(res_it));
+    for (j = 0; !had_err && j < gt_array_size(res_ii); j++) {
+      GtRange *rng = *(GtRange**) gt_array_get(res_ii, j);
+      gt_ensure(gt_range_overlap(rng, queries + i));
+      if (j > 0) {
+        GtRange *prev = *(GtRange**) gt_array_get(res_ii, j-1);
+        gt_ensure(prev->start <= rng->start);
+      }
+    }
+  }
+
+  /* removed intervals are not reported anymore */
+  if (!had_err) {
+    GtRange *rng = gt_array_get(ranges, 0);
+    gt_ensure(gt_interval_index_remove(ii, rng->start, rng->end, rng));
+    gt_ensure(!gt_interval_index_remove(ii, rng->start, rng->end, rng));
+    gt_interval_index_build(ii);
+    gt_ensure(gt_interval_index_size(ii) == num_of_ranges - 1);
+    gt_array_reset(res_ii);
+    gt_interval_index_find_all_overlapping(ii, rng->start, rng->end, res_ii);
+    for (j = 0; !had_err && j < gt_array_size(res_ii); j++)
+      gt_ensure(*(GtRange**) gt_array_get(res_ii, j) != rng);
+    gt_interval_index_add(ii, rng->start, rng->end, rng);
+    gt_interval_index_build(ii);
+  }
+
+  /* batch queries yield the same results as single queries */
+  if (!had_err) {
+    qsort(queries, num_of_queries, sizeof (GtRange),
+          (GtCompare) gt_range_compare);
+    batch_results = gt_array_new(sizeof (GtArray*));
+    for (i = 0; i < num_of_queries; i++) {
+      GtArray *a = gt_array_new(sizeof (GtRange*));
+      gt_array_add(batch_results, a);
+    }
+    rval = gt_interval_index_iterate_overlapping_batch(ii, queries,
+                                                       num_of_queries,
+                                                      interval_index_test_batch,
+                                                       batch_results);
+    gt_ensure(rval == 0);
+    for (i = 0; !had_err && i < num_of_queries; i++) {
+      GtArray *a = *(GtArray**) gt_array_get(batch_results, i);
+      gt_array_reset(res_ii);
+      gt_interval_index_find_all_overlapping(ii, queries[i].start,
+                                             queries[i].end, res_ii);
+      gt_ensure(gt_array_size(a) == gt_array_size(res_ii));
+      for (j = 0; !had_err && j < gt_array_size(a); j++) {
+        gt_ensure(*(GtRange**) gt_array_get(a, j) ==
+                  *(GtRange**) gt_array_get(res_ii, j));
+      }
+    }
+    for (i = 0; i < num_of_queries; i++)
+      gt_array_delete(*(GtArray**) gt_array_get(batch_results, i));
+    gt_array_delete(batch_results);
+  }
+  if (!had_err) {
+    /* the batch query stops at the first non-zero return value */
+    GtUword count = 0;
+    rval = gt_interval_index_iterate_overlapping_batch(ii, queries,
+                                                       num_of_queries,
+                                                 interval_index_test_batch_stop,
+                                                       &count);
+    gt_ensure(rval == -1);
+    gt_ensure(count == 2UL);
+  }
+
+  gt_free(queries);
+  gt_array_delete(res_ii);
+  gt_array_delete(res_it);
+  gt_array_delete(ranges);
+  gt_interval_tree_delete(it);
+  gt_interval_index_delete(ii);
+  return had_err;
+}
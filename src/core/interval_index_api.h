@@ -0,0 +1,96 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef INTERVAL_INDEX_API_H
+#define INTERVAL_INDEX_API_H
+
+#include <stdbool.h>
+#include "core/array_api.h"
+#include "core/range_api.h"
+#include "core/types_api.h"
+
+/* The <GtIntervalIndex> class is a static alternative to the <GtIntervalTree>.
+   Intervals are collected first and then sorted into a single array which is
+   augmented to an implicit interval tree (as in cgranges by Heng Li), so that
+   queries traverse contiguous memory instead of following pointers. Adding or
+   removing an interval after <gt_interval_index_build()> requires another call
+   to it. Use the <GtIntervalTree> if insertions and removals are interleaved
+   with queries. */
+typedef struct GtIntervalIndex GtIntervalIndex;
+
+/* Called for each interval from <start> to <end> with associated <data>
+   overlapping a query. */
+typedef void (*GtIntervalIndexIteratorFunc)(void *data, GtUword start,
+                                            GtUword end, void *info);
+/* Called for each interval with associated <data> overlapping the query range
+   with index <query_num> in a batch query. A non-zero return value stops the
+   query. */
+typedef int  (*GtIntervalIndexBatchFunc)(GtUword query_num, void *data,
+                                         void *info);
+
+/* Creates a new empty <GtIntervalIndex>. */
+GtIntervalIndex* gt_interval_index_new(void);
+/* Adds the interval from <start> to <end> with associated <data> to
+   <interval_index>. */
+void             gt_interval_index_add(GtIntervalIndex *interval_index,
+                                       GtUword start, GtUword end, void *data);
+/* Sorts the intervals in <interval_index> by start and end position (keeping
+   the order in which they were added for equal intervals) and computes the
+   implicit tree. Must be called before querying. */
+void             gt_interval_index_build(GtIntervalIndex *interval_index);
+/* Removes the interval from <start> to <end> with associated <data> from
+   <interval_index>. Returns false if there is no such interval. The index has
+   to be built again before the next query. */
+bool             gt_interval_index_remove(GtIntervalIndex *interval_index,
+                                          GtUword start, GtUword end,
+                                          const void *data);
+/* Returns the number of intervals in <interval_index>. */
+GtUword          gt_interval_index_size(const GtIntervalIndex *interval_index);
+/* Returns the data associated with the <i>-th interval in sorted order. */
+void*            gt_interval_index_get(const GtIntervalIndex *interval_index,
+                                       GtUword i);
+/* Adds the data pointers of all intervals in <interval_index> overlapping the
+   range from <start> to <end> to <results>, sorted by start position. */
+void             gt_interval_index_find_all_overlapping(
+                                         const GtIntervalIndex *interval_index,
+                                         GtUword start, GtUword end,
+                                         GtArray *results);
+/* Calls <func> for all intervals in <interval_index> overlapping the range
+   from <start> to <end>, in the order of their start positions. <info> is
+   passed to <func>. Returns the number of overlapping intervals. */
+GtUword          gt_interval_index_iterate_overlapping(
+                                         const GtIntervalIndex *interval_index,
+                                         GtUword start, GtUword end,
+                                         GtIntervalIndexIteratorFunc func,
+                                         void *info);
+/* Calls <func> for all pairs of query ranges from <ranges> and intervals in
+   <interval_index> which overlap. The <num_of_ranges> ranges must be sorted
+   by start position. All queries are answered in a single sweep over the
+   intervals, which is faster than single queries if the ranges are dense
+   (e.g., tiles of a sequence). For each query, <func> is called in the order
+   of the start positions of the intervals. If <func> returns a non-zero value,
+   no further intervals are reported and this value is returned, otherwise 0
+   is returned. */
+int              gt_interval_index_iterate_overlapping_batch(
+                                         const GtIntervalIndex *interval_index,
+                                         const GtRange *ranges,
+                                         GtUword num_of_ranges,
+                                         GtIntervalIndexBatchFunc func,
+                                         void *info);
+/* Deletes <interval_index>. The associated data is not freed. */
+void             gt_interval_index_delete(GtIntervalIndex *interval_index);
+
+#endif
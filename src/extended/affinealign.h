@@ -43,7 +43,9 @@ typedef struct {
    and constant cost values. Use of this function requires input sequences
    <useq> and <vseq> and lengths <ulen> and <vlen>. The cost values are
    specified by <matchcost>, <mismatchcost>, <gap_opening_cost> and
-   <gap_extension_cost>. Returns an object of the <GtAlignment> class. */
+   <gap_extension_cost>. Returns an object of the <GtAlignment> class.
+   The DP table is allocated for each call, use
+   <gt_affinealign_with_Management()> to align many sequence pairs. */
 GtAlignment* gt_affinealign(const GtUchar *u, GtUword ulen,
                             const GtUchar *v, GtUword vlen,
                             GtUword matchcost, GtUword mismatchcost,
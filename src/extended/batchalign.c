@@ -0,0 +1,545 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "core/assert_api.h"
+#include "core/chardef_api.h"
+#include "core/divmodmul_api.h"
+#include "core/ensure_api.h"
+#include "core/ma_api.h"
+#include "core/mathsupport_api.h"
+#include "core/minmax_api.h"
+#include "extended/batchalign.h"
+#include "extended/linearalign.h"
+#include "extended/linearalign_affinegapcost.h"
+
+/* Without alignments, the pairs are sorted by their length and each group
+   of GT_BATCHALIGN_LANES consecutive pairs is aligned by the recurrences of
+   Gotoh, where lane l of each vector of 16-bit cost values belongs to pair l
+   of the group. The DP-matrix of a group has the maximal length of the
+   sequences in each dimension; the cost of each pair is taken from the row
+   and column given by its own lengths. Groups whose cost values may exceed
+   16 bits and all pairs without SIMD support are aligned one at a time. */
+
+#ifdef __SSE2__
+#define GT_BATCHALIGN_LANES     8
+#define GT_BATCHALIGN_INFINITY  INT16_MAX
+#endif
+
+typedef struct
+{
+  const GtUchar *useq, *vseq;
+  GtUword ulen, vlen;
+} GtBatchalignPair;
+
+typedef struct
+{
+  GtUword key, idx;
+} GtBatchalignOrder;
+
+struct GtBatchalign
+{
+  const GtScoreHandler *scorehandler;
+  GtUword matchcost,
+          mismatchcost,
+          gap_opening,
+          gap_extension,
+          nextfree,
+          allocated,
+          numofalignments;
+  GtBatchalignPair *pairs;
+  GtUword *distances;
+  GtAlignment **alignments;
+  GtBatchalignOrder *order;
+  bool alignments_valid;
+};
+
+GtBatchalign *gt_batchalign_new(const GtScoreHandler *scorehandler)
+{
+  GtBatchalign *batchalign;
+
+  gt_assert(scorehandler != NULL &&
+            !gt_scorehandler_has_scorematrix(scorehandler));
+  gt_assert(gt_scorehandler_get_matchscore(scorehandler) >= 0 &&
+            gt_scorehandler_get_mismatchscore(scorehandler) >= 0 &&
+            gt_scorehandler_get_gap_opening(scorehandler) >= 0 &&
+            gt_scorehandler_get_gapscore(scorehandler) >= 0);
+  batchalign = gt_malloc(sizeof *batchalign);
+  batchalign->scorehandler = scorehandler;
+  batchalign->matchcost
+    = (GtUword) gt_scorehandler_get_matchscore(scorehandler);
+  batchalign->mismatchcost
+    = (GtUword) gt_scorehandler_get_mismatchscore(scorehandler);
+  batchalign->gap_opening
+    = (GtUword) gt_scorehandler_get_gap_opening(scorehandler);
+  batchalign->gap_extension
+    = (GtUword) gt_scorehandler_get_gapscore(scorehandler);
+  batchalign->nextfree = 0;
+  batchalign->allocated = 0;
+  batchalign->numofalignments = 0;
+  batchalign->pairs = NULL;
+  batchalign->distances = NULL;
+  batchalign->alignments = NULL;
+  batchalign->order = NULL;
+  batchalign->alignments_valid = false;
+  return batchalign;
+}
+
+void gt_batchalign_delete(GtBatchalign *batchalign)
+{
+  if (batchalign != NULL)
+  {
+    GtUword idx;
+
+    for (idx = 0; idx < batchalign->numofalignments; idx++)
+    {
+      gt_alignment_delete(batchalign->alignments[idx]);
+    }
+    gt_free(batchalign->alignments);
+    gt_free(batchalign->pairs);
+    gt_free(batchalign->distances);
+    gt_free(batchalign->order);
+    gt_free(batchalign);
+  }
+}
+
+void gt_batchalign_reset(GtBatchalign *batchalign)
+{
+  gt_assert(batchalign != NULL);
+  batchalign->nextfree = 0;
+  batchalign->alignments_valid = false;
+}
+
+void gt_batchalign_add(GtBatchalign *batchalign,
+                       const GtUchar *useq, GtUword ulen,
+                       const GtUchar *vseq, GtUword vlen)
+{
+  GtBatchalignPair *pair;
+
+  gt_assert(batchalign != NULL);
+  if (batchalign->nextfree == batchalign->allocated)
+  {
+    batchalign->allocated = (GtUword) (batchalign->allocated * 1.2) + 32;
+    batchalign->pairs = gt_realloc(batchalign->pairs,
+                                   sizeof *batchalign->pairs *
+                                   batchalign->allocated);
+    batchalign->distances = gt_realloc(batchalign->distances,
+                                       sizeof *batchalign->distances *
+                                       batchalign->allocated);
+    batchalign->order = gt_realloc(batchalign->order,
+                                   sizeof *batchalign->order *
+                                   batchalign->allocated);
+  }
+  pair = batchalign->pairs + batchalign->nextfree++;
+  pair->useq = useq;
+  pair->ulen = ulen;
+  pair->vseq = vseq;
+  pair->vlen = vlen;
+  batchalign->alignments_valid = false;
+}
+
+GtUword gt_batchalign_size(const GtBatchalign *batchalign)
+{
+  gt_assert(batchalign != NULL);
+  return batchalign->nextfree;
+}
+
+GtUword gt_batchalign_distance(const GtBatchalign *batchalign, GtUword idx)
+{
+  gt_assert(batchalign != NULL && idx < batchalign->nextfree);
+  return batchalign->distances[idx];
+}
+
+const GtAlignment *gt_batchalign_alignment(const GtBatchalign *batchalign,
+                                           GtUword idx)
+{
+  gt_assert(batchalign != NULL && idx < batchalign->nextfree);
+  return batchalign->alignments_valid ? batchalign->alignments[idx] : NULL;
+}
+
+static GtUword gt_batchalign_gapcost(const GtBatchalign *batchalign,
+                                     GtUword length)
+{
+  return length == 0 ? 0
+                     : batchalign->gap_opening +
+                       length * batchalign->gap_extension;
+}
+
+/* the recurrences of Gotoh for a single pair in linear space */
+static GtUword gt_batchalign_distance_single(const GtBatchalign *batchalign,
+                                             GtLinspaceManagement
+                                               *spacemanager,
+                                             const GtBatchalignPair *pair)
+{
+  const GtUword gap_opening = batchalign->gap_opening,
+                gap_extension = batchalign->gap_extension,
+                infinity = GT_UWORD_MAX >> 2;
+  GtUword i, j, *rtab, *dtab;
+
+  gt_linspace_management_check(spacemanager, GT_MULT2(pair->vlen) + 1, 0,
+                               sizeof *rtab, 0, 0);
+  rtab = gt_linspace_management_get_valueTabspace(spacemanager);
+  dtab = rtab + pair->vlen + 1;
+  for (j = 0; j <= pair->vlen; j++)
+  {
+    rtab[j] = gt_batchalign_gapcost(batchalign, j);
+    dtab[j] = infinity;
+  }
+  for (i = 1; i <= pair->ulen; i++)
+  {
+    const GtUchar a = pair->useq[i-1];
+    GtUword diagonal = rtab[0], itab = infinity;
+
+    rtab[0] = gt_batchalign_gapcost(batchalign, i);
+    for (j = 1; j <= pair->vlen; j++)
+    {
+      const GtUchar b = pair->vseq[j-1];
+      GtUword rvalue;
+
+      dtab[j] = GT_MIN(rtab[j] + gap_opening, dtab[j]) + gap_extension;
+      itab = GT_MIN(rtab[j-1] + gap_opening, itab) + gap_extension;
+      rvalue = diagonal + (a == b && !GT_ISSPECIAL(a)
+                             ? batchalign->matchcost
+                             : batchalign->mismatchcost);
+      diagonal = rtab[j];
+      rtab[j] = GT_MIN3(rvalue, dtab[j], itab);
+    }
+  }
+  return rtab[pair->vlen];
+}
+
+#ifdef __SSE2__
+static int16_t gt_batchalign_lane_char(const GtUchar *seq, GtUword len,
+                                       GtUword pos, int16_t special)
+{
+  if (pos >= len)
+  {
+    return special - 2;
+  }
+  return GT_ISSPECIAL(seq[pos]) ? special : (int16_t) seq[pos];
+}
+
+/* align the pairs <order>[0..<numofpairs>-1] with one pair per lane */
+static void gt_batchalign_distance_lanes(GtBatchalign *batchalign,
+                                         GtLinspaceManagement *spacemanager,
+                                         const GtBatchalignOrder *order,
+                                         GtUword numofpairs,
+                                         GtUword maxulen,
+                                         GtUword maxvlen)
+{
+  int16_t lanes[GT_BATCHALIGN_LANES];
+  const GtBatchalignPair *pairs[GT_BATCHALIGN_LANES];
+  const __m128i gap_open_extend
+                  = _mm_set1_epi16((int16_t) (batchalign->gap_opening +
+                                              batchalign->gap_extension)),
+                gap_extend
+                  = _mm_set1_epi16((int16_t) batchalign->gap_extension),
+                mismatch = _mm_set1_epi16((int16_t) batchalign->mismatchcost),
+                match_bonus
+                  = _mm_set1_epi16((int16_t) (batchalign->mismatchcost -
+                                              batchalign->matchcost)),
+                infinity = _mm_set1_epi16(GT_BATCHALIGN_INFINITY);
+  __m128i *rtab, *dtab, *vprofile;
+  GtUword i, j, lane;
+  size_t addr;
+
+  gt_assert(numofpairs > 0 && numofpairs <= GT_BATCHALIGN_LANES);
+  for (lane = 0; lane < GT_BATCHALIGN_LANES; lane++)
+  {
+    pairs[lane] = lane < numofpairs ? batchalign->pairs + order[lane].idx
+                                    : NULL;
+  }
+  /* one additional vector for the alignment */
+  gt_linspace_management_check(spacemanager, 3 * (maxvlen + 1), 0,
+                               sizeof *rtab, 0, 0);
+  addr = (size_t) gt_linspace_management_get_valueTabspace(spacemanager);
+  rtab = (__m128i *) ((addr + 15) & ~((size_t) 15));
+  dtab = rtab + maxvlen + 1;
+  vprofile = dtab + maxvlen + 1;
+  for (j = 1; j <= maxvlen; j++)
+  {
+    for (lane = 0; lane < GT_BATCHALIGN_LANES; lane++)
+    {
+      lanes[lane] = pairs[lane] == NULL
+                      ? -2
+                      : gt_batchalign_lane_char(pairs[lane]->vseq,
+                                                pairs[lane]->vlen, j - 1, -2);
+    }
+    _mm_store_si128(vprofile + j - 1,
+                    _mm_loadu_si128((const __m128i *) lanes));
+  }
+  for (j = 0; j <= maxvlen; j++)
+  {
+    rtab[j] = _mm_set1_epi16((int16_t) gt_batchalign_gapcost(batchalign, j));
+    dtab[j] = infinity;
+  }
+  for (i = 1; i <= maxulen; i++)
+  {
+    __m128i uchars, diagonal = rtab[0], itab = infinity, rvalue;
+
+    for (lane = 0; lane < GT_BATCHALIGN_LANES; lane++)
+    {
+      lanes[lane] = pairs[lane] == NULL
+                      ? -1
+                      : gt_batchalign_lane_char(pairs[lane]->useq,
+                                                pairs[lane]->ulen, i - 1, -1);
+    }
+    uchars = _mm_loadu_si128((const __m128i *) lanes);
+    rtab[0] = _mm_set1_epi16((int16_t) gt_batchalign_gapcost(batchalign, i));
+    rvalue = rtab[0];
+    for (j = 1; j <= maxvlen; j++)
+    {
+      const __m128i equal = _mm_cmpeq_epi16(uchars, vprofile[j - 1]),
+                    replacement = _mm_sub_epi16(mismatch,
+                                                _mm_and_si128(equal,
+                                                              match_bonus));
+      __m128i dvalue = _mm_min_epi16(_mm_adds_epi16(rtab[j], gap_open_extend),
+                                     _mm_adds_epi16(dtab[j], gap_extend));
+
+      itab = _mm_min_epi16(_mm_adds_epi16(rvalue, gap_open_extend),
+                           _mm_adds_epi16(itab, gap_extend));
+      dtab[j] = dvalue;
+      rvalue = _mm_min_epi16(_mm_adds_epi16(diagonal, replacement),
+                             _mm_min_epi16(dvalue, itab));
+      diagonal = rtab[j];
+      rtab[j] = rvalue;
+    }
+    for (lane = 0; lane < numofpairs; lane++)
+    {
+      if (pairs[lane]->ulen == i)
+      {
+        _mm_storeu_si128((__m128i *) lanes, rtab[pairs[lane]->vlen]);
+        batchalign->distances[order[lane].idx] = (GtUword) lanes[lane];
+      }
+    }
+  }
+}
+#endif
+
+static int gt_batchalign_order_compare(const void *va, const void *vb)
+{
+  const GtBatchalignOrder *a = va, *b = vb;
+
+  if (a->key < b->key)
+  {
+    return -1;
+  }
+  if (a->key > b->key)
+  {
+    return 1;
+  }
+  return a->idx < b->idx ? -1 : (a->idx > b->idx ? 1 : 0);
+}
+
+static void gt_batchalign_compute_distances(GtBatchalign *batchalign,
+                                            GtLinspaceManagement
+                                              *spacemanager)
+{
+  GtUword idx, numofpairs = 0;
+
+  for (idx = 0; idx < batchalign->nextfree; idx++)
+  {
+    const GtBatchalignPair *pair = batchalign->pairs + idx;
+
+    if (pair->ulen == 0 || pair->vlen == 0)
+    {
+      batchalign->distances[idx]
+        = gt_batchalign_gapcost(batchalign, pair->ulen + pair->vlen);
+    } else
+    {
+      batchalign->order[numofpairs].key = GT_MAX(pair->ulen, pair->vlen);
+      batchalign->order[numofpairs++].idx = idx;
+    }
+  }
+  qsort(batchalign->order, (size_t) numofpairs, sizeof *batchalign->order,
+        gt_batchalign_order_compare);
+#ifdef __SSE2__
+  for (idx = 0; idx < numofpairs; idx += GT_BATCHALIGN_LANES)
+  {
+    const GtUword width = GT_MIN(numofpairs - idx, GT_BATCHALIGN_LANES);
+    GtUword lane, maxulen = 0, maxvlen = 0;
+
+    for (lane = 0; lane < width; lane++)
+    {
+      const GtBatchalignPair *pair
+        = batchalign->pairs + batchalign->order[idx + lane].idx;
+
+      maxulen = GT_MAX(maxulen, pair->ulen);
+      maxvlen = GT_MAX(maxvlen, pair->vlen);
+    }
+    /* all values of the DP-matrix are bounded by the cost of aligning
+       through gaps only */
+    if (3 * batchalign->gap_opening +
+        (maxulen + maxvlen + 1) * batchalign->gap_extension +
+        batchalign->mismatchcost < (GtUword) GT_BATCHALIGN_INFINITY)
+    {
+      gt_batchalign_distance_lanes(batchalign, spacemanager,
+                                   batchalign->order + idx, width,
+                                   maxulen, maxvlen);
+    } else
+    {
+      for (lane = 0; lane < width; lane++)
+      {
+        const GtUword pairnum = batchalign->order[idx + lane].idx;
+
+        batchalign->distances[pairnum]
+          = gt_batchalign_distance_single(batchalign, spacemanager,
+                                          batchalign->pairs + pairnum);
+      }
+    }
+  }
+#else
+  for (idx = 0; idx < numofpairs; idx++)
+  {
+    const GtUword pairnum = batchalign->order[idx].idx;
+
+    batchalign->distances[pairnum]
+      = gt_batchalign_distance_single(batchalign, spacemanager,
+                                      batchalign->pairs + pairnum);
+  }
+#endif
+}
+
+void gt_batchalign_compute(GtBatchalign *batchalign,
+                           GtLinspaceManagement *spacemanager,
+                           bool with_alignments)
+{
+  GtUword idx;
+
+  gt_assert(batchalign != NULL && spacemanager != NULL);
+  if (!with_alignments)
+  {
+    gt_batchalign_compute_distances(batchalign, spacemanager);
+    batchalign->alignments_valid = false;
+    return;
+  }
+  if (batchalign->numofalignments < batchalign->nextfree)
+  {
+    batchalign->alignments = gt_realloc(batchalign->alignments,
+                                        sizeof *batchalign->alignments *
+                                        batchalign->nextfree);
+    for (idx = batchalign->numofalignments; idx < batchalign->nextfree; idx++)
+    {
+      batchalign->alignments[idx] = gt_alignment_new();
+    }
+    batchalign->numofalignments = batchalign->nextfree;
+  }
+  /* the traceback is inherently sequential, the square space algorithms
+     used for short sequences share the space of <spacemanager> */
+  for (idx = 0; idx < batchalign->nextfree; idx++)
+  {
+    const GtBatchalignPair *pair = batchalign->pairs + idx;
+
+    gt_alignment_reset(batchalign->alignments[idx]);
+    if (pair->ulen == 0 && pair->vlen == 0)
+    {
+      gt_alignment_set_seqs(batchalign->alignments[idx], pair->useq, 0,
+                            pair->vseq, 0);
+      batchalign->distances[idx] = 0;
+      continue;
+    }
+    batchalign->distances[idx]
+      = (batchalign->gap_opening > 0
+           ? gt_linearalign_affinegapcost_compute_generic
+           : gt_linearalign_compute_generic)
+          (spacemanager, batchalign->scorehandler,
+           batchalign->alignments[idx],
+           pair->useq, 0, pair->ulen, pair->vseq, 0, pair->vlen);
+  }
+  batchalign->alignments_valid = true;
+}
+
+int gt_batchalign_unit_test(GtError *err)
+{
+  int had_err = 0;
+  const GtUword costs[][4] = {{0, 1, 0, 1},
+                              {0, 4, 6, 2},
+                              {1, 3, 0, 2},
+                              {2, 7, 5, 1},
+                              {0, 1, 300, 150}},
+                numofcosts = sizeof costs/sizeof costs[0],
+                numofpairs = 50,
+                maxlen = 160;
+  const GtUchar characters[] = "acgt";
+  GtUchar *sequences = gt_malloc(sizeof *sequences * 2 * numofpairs * maxlen);
+  GtUword lengths[2 * 50], idx, cidx;
+  GtLinspaceManagement *spacemanager = gt_linspace_management_new();
+
+  gt_error_check(err);
+  for (idx = 0; idx < 2 * numofpairs; idx++)
+  {
+    GtUchar *seq = sequences + idx * maxlen;
+    GtUword pos;
+
+    lengths[idx] = idx % 17 == 0 ? 0 : gt_rand_max(maxlen);
+    for (pos = 0; pos < lengths[idx]; pos++)
+    {
+      if (idx % 2 == 1 && pos < lengths[idx-1] && gt_rand_max(9) > 0)
+      {
+        seq[pos] = seq[pos - maxlen];
+      } else
+      {
+        seq[pos] = gt_rand_max(49) == 0 ? (GtUchar) GT_WILDCARD
+                                        : (GtUchar) gt_rand_max(3);
+      }
+    }
+  }
+  for (cidx = 0; !had_err && cidx < numofcosts; cidx++)
+  {
+    GtScoreHandler *scorehandler
+      = gt_scorehandler_new((GtWord) costs[cidx][0], (GtWord) costs[cidx][1],
+                            (GtWord) costs[cidx][2], (GtWord) costs[cidx][3]);
+    GtBatchalign *batchalign = gt_batchalign_new(scorehandler);
+    GtUword *distances = gt_malloc(sizeof *distances * numofpairs);
+
+    for (idx = 0; idx < numofpairs; idx++)
+    {
+      gt_batchalign_add(batchalign,
+                        sequences + GT_MULT2(idx) * maxlen,
+                        lengths[GT_MULT2(idx)],
+                        sequences + (GT_MULT2(idx) + 1) * maxlen,
+                        lengths[GT_MULT2(idx) + 1]);
+    }
+    gt_ensure(gt_batchalign_size(batchalign) == numofpairs);
+    gt_batchalign_compute(batchalign, spacemanager, false);
+    for (idx = 0; !had_err && idx < numofpairs; idx++)
+    {
+      distances[idx] = gt_batchalign_distance(batchalign, idx);
+      gt_ensure(gt_batchalign_alignment(batchalign, idx) == NULL);
+    }
+    gt_batchalign_compute(batchalign, spacemanager, true);
+    for (idx = 0; !had_err && idx < numofpairs; idx++)
+    {
+      const GtAlignment *align = gt_batchalign_alignment(batchalign, idx);
+
+      gt_ensure(align != NULL);
+      gt_ensure(gt_batchalign_distance(batchalign, idx) == distances[idx]);
+      gt_ensure(gt_scorehandler_eval_alignmentscore(scorehandler, align,
+                                                    characters)
+                == (GtWord) distances[idx]);
+    }
+    gt_free(distances);
+    gt_batchalign_delete(batchalign);
+    gt_scorehandler_delete(scorehandler);
+  }
+  gt_linspace_management_delete(spacemanager);
+  gt_free(sequences);
+  return had_err;
+}
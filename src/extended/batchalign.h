@@ -0,0 +1,66 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef BATCHALIGN_H
+#define BATCHALIGN_H
+
+#include "core/error_api.h"
+#include "core/types_api.h"
+#include "extended/alignment.h"
+#include "extended/linspace_management.h"
+#include "extended/scorehandler.h"
+
+/* The <GtBatchalign> class collects many pairs of short sequences and
+   computes their global alignment costs (with linear gap costs if the gap
+   opening cost is 0 and affine gap costs otherwise) in one call. Without
+   alignments, the pairs are grouped by length and aligned with one pair per
+   SIMD lane (if available), which is much faster than aligning them one by
+   one. */
+typedef struct GtBatchalign GtBatchalign;
+
+/* Return a new <GtBatchalign> object for the cost values of <scorehandler>,
+   which must not contain a score matrix and must live as long as the
+   object. */
+GtBatchalign*   gt_batchalign_new(const GtScoreHandler *scorehandler);
+/* Delete the given <batchalign>. */
+void            gt_batchalign_delete(GtBatchalign *batchalign);
+/* Remove all pairs from <batchalign>. */
+void            gt_batchalign_reset(GtBatchalign *batchalign);
+/* Add the pair of <useq> of length <ulen> and <vseq> of length <vlen> to
+   <batchalign>. The sequences are not copied. */
+void            gt_batchalign_add(GtBatchalign *batchalign,
+                                  const GtUchar *useq, GtUword ulen,
+                                  const GtUchar *vseq, GtUword vlen);
+/* Return the number of pairs in <batchalign>. */
+GtUword         gt_batchalign_size(const GtBatchalign *batchalign);
+/* Compute the costs of optimal global alignments of all pairs of
+   <batchalign> using the space of <spacemanager>. If <with_alignments> is
+   true, an optimal alignment is also computed for each pair. */
+void            gt_batchalign_compute(GtBatchalign *batchalign,
+                                      GtLinspaceManagement *spacemanager,
+                                      bool with_alignments);
+/* Return the cost of an optimal alignment of pair <idx> of <batchalign>, as
+   computed by the last call of <gt_batchalign_compute()>. */
+GtUword         gt_batchalign_distance(const GtBatchalign *batchalign,
+                                       GtUword idx);
+/* Return the alignment of pair <idx> of <batchalign>, as computed by the
+   last call of <gt_batchalign_compute()> with alignments, or NULL. */
+const GtAlignment *gt_batchalign_alignment(const GtBatchalign *batchalign,
+                                           GtUword idx);
+
+int             gt_batchalign_unit_test(GtError *err);
+
+#endif
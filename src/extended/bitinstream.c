@@ -63,9 +63,6 @@ GtBitInStream *gt_bitinstream_new(const char* path,
   bitstream->read_bits = 0;
   gt_bitinstream_reinit(bitstream,
                         offset);
-
-  bitstream->bufferlength = (bitstream->pages_to_map * bitstream->pagesize) /
-                            sizeof (*bitstream->bitseqbuffer);
   return bitstream;
 }
 
@@ -81,12 +78,16 @@ void gt_bitinstream_reinit(GtBitInStream *bitstream,
 
   gt_fa_xmunmap(bitstream->bitseqbuffer);
 
-  if (bitstream->cur_filepos + mapsize > bitstream->filesize) {
+  /* the length has to be reset, as a previous chunk might have been the last
+     one */
+  if (bitstream->cur_filepos + mapsize >= bitstream->filesize) {
     mapsize = bitstream->filesize - bitstream->cur_filepos;
-    bitstream->bufferlength = (GtUword)  mapsize /
-                                sizeof (*bitstream->bitseqbuffer);
     bitstream->last_chunk = true;
   }
+  else
+    bitstream->last_chunk = false;
+  bitstream->bufferlength = (GtUword) mapsize /
+                              sizeof (*bitstream->bitseqbuffer);
   bitstream->bitseqbuffer =
     gt_fa_xmmap_read_range(bitstream->path,
                            mapsize,
@@ -98,18 +99,18 @@ void gt_bitinstream_reinit(GtBitInStream *bitstream,
   bitstream->cur_bitseq = 0;
 }
 
-int gt_bitinstream_get_next_bit(GtBitInStream *bitstream,
-                                bool * bit)
+/* Moves to the next word if all bits of the current one are read. Returns
+   false if there are no more bits to read. */
+static inline bool bitinstream_fill(GtBitInStream *bitstream)
 {
-  const int eof = 0, more_to_read = 1;
   if (bitstream->cur_bit == GT_INTWORDSIZE) {
-    if (bitstream->cur_bitseq < bitstream->bufferlength - 1) {
+    if (bitstream->cur_bitseq + 1 < bitstream->bufferlength) {
       bitstream->cur_bit = 0;
       bitstream->cur_bitseq++;
     }
     else {
       if (bitstream->last_chunk) {
-        return eof;
+        return false;
       }
       else {
         gt_bitinstream_reinit(bitstream,
@@ -119,13 +120,81 @@ int gt_bitinstream_get_next_bit(GtBitInStream *bitstream,
       }
     }
   }
-  gt_assert(bitstream->cur_bitseq != bitstream->bufferlength);
+  gt_assert(bitstream->cur_bitseq < bitstream->bufferlength);
+  return true;
+}
+
+int gt_bitinstream_get_next_bit(GtBitInStream *bitstream,
+                                bool * bit)
+{
+  const int eof = 0, more_to_read = 1;
+  if (!bitinstream_fill(bitstream))
+    return eof;
   *bit = GT_ISBITSET(bitstream->bitseqbuffer[bitstream->cur_bitseq],
                      bitstream->cur_bit++) != 0;
   bitstream->read_bits++;
   return more_to_read;
 }
 
+unsigned int gt_bitinstream_peek_bits(GtBitInStream *bitstream,
+                                      GtBitsequence *bits)
+{
+  unsigned int numofbits;
+
+  if (!bitinstream_fill(bitstream)) {
+    *bits = 0;
+    return 0;
+  }
+  *bits = bitstream->bitseqbuffer[bitstream->cur_bitseq] << bitstream->cur_bit;
+  numofbits = (unsigned int) (GT_INTWORDSIZE - bitstream->cur_bit);
+  /* the next word is only available if it belongs to the mapped chunk */
+  if (bitstream->cur_bit > 0 &&
+      bitstream->cur_bitseq + 1 < bitstream->bufferlength) {
+    *bits |= bitstream->bitseqbuffer[bitstream->cur_bitseq + 1] >> numofbits;
+    numofbits = (unsigned int) GT_INTWORDSIZE;
+  }
+  return numofbits;
+}
+
+void gt_bitinstream_skip_bits(GtBitInStream *bitstream,
+                              unsigned int numofbits)
+{
+  gt_assert(numofbits <= (unsigned int) GT_INTWORDSIZE);
+  bitstream->cur_bit += (int) numofbits;
+  bitstream->read_bits += numofbits;
+  if (bitstream->cur_bit > GT_INTWORDSIZE) {
+    bitstream->cur_bit -= GT_INTWORDSIZE;
+    bitstream->cur_bitseq++;
+    gt_assert(bitstream->cur_bitseq < bitstream->bufferlength);
+  }
+}
+
+int gt_bitinstream_get_next_bits(GtBitInStream *bitstream,
+                                 unsigned int numofbits,
+                                 GtBitsequence *bits)
+{
+  const int eof = 0, more_to_read = 1;
+  GtBitsequence peeked;
+  bool bit;
+
+  gt_assert(numofbits <= (unsigned int) GT_INTWORDSIZE);
+  *bits = 0;
+  if (numofbits == 0)
+    return more_to_read;
+  if (gt_bitinstream_peek_bits(bitstream, &peeked) >= numofbits) {
+    *bits = peeked >> (GT_INTWORDSIZE - numofbits);
+    gt_bitinstream_skip_bits(bitstream, numofbits);
+    return more_to_read;
+  }
+  /* the bits are split between two chunks or the stream ends */
+  for (; numofbits > 0; numofbits--) {
+    if (gt_bitinstream_get_next_bit(bitstream, &bit) != 1)
+      return eof;
+    *bits = (*bits << 1) | (bit ? (GtBitsequence) 1 : 0);
+  }
+  return more_to_read;
+}
+
 void gt_bitinstream_delete(GtBitInStream *bitstream)
 {
   if (bitstream != NULL) {
@@ -44,6 +44,25 @@ void           gt_bitinstream_reinit(GtBitInStream *bitstream,
 int            gt_bitinstream_get_next_bit(GtBitInStream *bitstream,
                                            bool *bit);
 
+/* Sets <bits> to the next bits of <bitstream> without consuming them, the
+   next bit being the most significant one. Returns the number of valid bits,
+   which is <GT_INTWORDSIZE> except at the end of a mapped chunk, or 0 if there
+   are no more bits to read. */
+unsigned int   gt_bitinstream_peek_bits(GtBitInStream *bitstream,
+                                        GtBitsequence *bits);
+
+/* Consumes <numofbits> bits, which must not be more than the number of valid
+   bits returned by the last call to <gt_bitinstream_peek_bits()>. */
+void           gt_bitinstream_skip_bits(GtBitInStream *bitstream,
+                                        unsigned int numofbits);
+
+/* Reads the next <numofbits> bits, at most <GT_INTWORDSIZE>, into the least
+   significant bits of <bits>. Returns 0 if there are not enough bits left and
+   1 if successfully read all bits. */
+int            gt_bitinstream_get_next_bits(GtBitInStream *bitstream,
+                                            unsigned int numofbits,
+                                            GtBitsequence *bits);
+
 /* Deletes <bitstream> and frees all associated memory. */
 void           gt_bitinstream_delete(GtBitInStream *bitstream);
 
@@ -98,13 +98,13 @@ void gt_bitoutstream_flush(GtBitOutStream *bitstream)
 void gt_bitoutstream_flush_advance(GtBitOutStream *bitstream)
 {
   GtWord fpos;
-  bool is_not_at_pageborder = (ftell(bitstream->fp) % bitstream->pagesize) != 0;
 
   gt_assert(bitstream);
 
   gt_bitoutstream_flush(bitstream);
 
-  if (is_not_at_pageborder) {
+  /* the flush might have moved the position away from a page border */
+  if ((ftell(bitstream->fp) % bitstream->pagesize) != 0) {
     fpos = (ftell(bitstream->fp) / bitstream->pagesize + 1) *
            bitstream->pagesize;
     gt_xfseek(bitstream->fp, fpos, SEEK_SET);
@@ -25,6 +25,7 @@
 #include "core/fa_api.h"
 #include "core/log_api.h"
 #include "core/ma_api.h"
+#include "core/multithread_api.h"
 #include "core/safearith_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
@@ -235,6 +236,7 @@ static GtCondenseq *condenseq_new_empty(const GtAlphabet *alph)
   condenseq->id_len = GT_UNDEF_UWORD;
 
   condenseq->buffer = NULL;
+  condenseq->cache = NULL;
   condenseq->filename = NULL;
   condenseq->links = NULL;
   condenseq->orig_ids = NULL;
@@ -375,6 +377,195 @@ void gt_condenseq_add_link_to_db(GtCondenseq *condenseq, GtCondenseqLink link)
   condenseq->lds_nelems++;
 }
 
+typedef struct {
+  GtUchar *seq;
+  GtUword  id,
+           len,
+           prev,
+           next;
+  bool     is_link;
+} GtCondenseqCacheEntry;
+
+/* The entries form a list ordered by their last use, starting with the most
+   recently used one. Unused entries are kept in a list linked by <next>. */
+struct GtCondenseqCache {
+  GtCondenseqCacheEntry *entries;
+  GtMutex               *mutex;
+  GtUword               *link_slots,
+                        *unique_slots,
+                         allocated,
+                         nextfree,
+                         free_list,
+                         first,
+                         last,
+                         maxsize,
+                         size,
+                         hits,
+                         misses;
+};
+
+static GtCondenseqCache *condenseq_cache_new(const GtCondenseq *condenseq,
+                                             GtUword maxsize)
+{
+  GtUword idx;
+  GtCondenseqCache *cache = gt_malloc(sizeof (*cache));
+  cache->entries = NULL;
+  cache->mutex = gt_mutex_new();
+  cache->link_slots = gt_malloc(sizeof (*cache->link_slots) *
+                                condenseq->lds_nelems);
+  for (idx = 0; idx < condenseq->lds_nelems; idx++)
+    cache->link_slots[idx] = GT_UNDEF_UWORD;
+  cache->unique_slots = gt_malloc(sizeof (*cache->unique_slots) *
+                                  condenseq->uds_nelems);
+  for (idx = 0; idx < condenseq->uds_nelems; idx++)
+    cache->unique_slots[idx] = GT_UNDEF_UWORD;
+  cache->allocated =
+    cache->nextfree =
+    cache->size =
+    cache->hits =
+    cache->misses = 0;
+  cache->free_list =
+    cache->first =
+    cache->last = GT_UNDEF_UWORD;
+  cache->maxsize = maxsize;
+  return cache;
+}
+
+static void condenseq_cache_delete(GtCondenseqCache *cache)
+{
+  if (cache != NULL) {
+    GtUword slot;
+    gt_log_log("condenseq cache: " GT_WU " hits, " GT_WU " misses, " GT_WU
+               " symbols cached", cache->hits, cache->misses, cache->size);
+    for (slot = cache->first;
+         slot != GT_UNDEF_UWORD;
+         slot = cache->entries[slot].next)
+      gt_free(cache->entries[slot].seq);
+    gt_free(cache->entries);
+    gt_free(cache->link_slots);
+    gt_free(cache->unique_slots);
+    gt_mutex_delete(cache->mutex);
+    gt_free(cache);
+  }
+}
+
+static void condenseq_cache_unlink(GtCondenseqCache *cache, GtUword slot)
+{
+  GtCondenseqCacheEntry *entry = cache->entries + slot;
+  if (entry->prev != GT_UNDEF_UWORD)
+    cache->entries[entry->prev].next = entry->next;
+  else
+    cache->first = entry->next;
+  if (entry->next != GT_UNDEF_UWORD)
+    cache->entries[entry->next].prev = entry->prev;
+  else
+    cache->last = entry->prev;
+}
+
+static void condenseq_cache_push_front(GtCondenseqCache *cache, GtUword slot)
+{
+  GtCondenseqCacheEntry *entry = cache->entries + slot;
+  entry->prev = GT_UNDEF_UWORD;
+  entry->next = cache->first;
+  if (cache->first != GT_UNDEF_UWORD)
+    cache->entries[cache->first].prev = slot;
+  else
+    cache->last = slot;
+  cache->first = slot;
+}
+
+/* copies <length> symbols starting at <offset> of the cached element to
+   <buffer>, returns false if the element is not cached */
+static bool condenseq_cache_get(GtCondenseqCache *cache,
+                                bool is_link,
+                                GtUword id,
+                                GtUword offset,
+                                GtUword length,
+                                GtUchar *buffer)
+{
+  GtUword slot;
+  bool found = false;
+  gt_mutex_lock(cache->mutex);
+  slot = is_link ? cache->link_slots[id] : cache->unique_slots[id];
+  if (slot != GT_UNDEF_UWORD) {
+    GtCondenseqCacheEntry *entry = cache->entries + slot;
+    gt_assert(offset + length <= entry->len);
+    memcpy(buffer, entry->seq + offset, sizeof (*buffer) * length);
+    if (slot != cache->first) {
+      condenseq_cache_unlink(cache, slot);
+      condenseq_cache_push_front(cache, slot);
+    }
+    cache->hits++;
+    found = true;
+  }
+  else
+    cache->misses++;
+  gt_mutex_unlock(cache->mutex);
+  return found;
+}
+
+/* takes ownership of <seq>, which is the decoded element of length <len> */
+static void condenseq_cache_add(GtCondenseqCache *cache,
+                                bool is_link,
+                                GtUword id,
+                                GtUchar *seq,
+                                GtUword len)
+{
+  GtUword *slots = is_link ? cache->link_slots : cache->unique_slots;
+  gt_mutex_lock(cache->mutex);
+  /* another thread might have added the element in the meantime */
+  if (slots[id] != GT_UNDEF_UWORD || len > cache->maxsize)
+    gt_free(seq);
+  else {
+    GtUword slot;
+    GtCondenseqCacheEntry *entry;
+    while (cache->size + len > cache->maxsize) {
+      slot = cache->last;
+      entry = cache->entries + slot;
+      condenseq_cache_unlink(cache, slot);
+      if (entry->is_link)
+        cache->link_slots[entry->id] = GT_UNDEF_UWORD;
+      else
+        cache->unique_slots[entry->id] = GT_UNDEF_UWORD;
+      cache->size -= entry->len;
+      gt_free(entry->seq);
+      entry->next = cache->free_list;
+      cache->free_list = slot;
+    }
+    if (cache->free_list != GT_UNDEF_UWORD) {
+      slot = cache->free_list;
+      cache->free_list = cache->entries[slot].next;
+    }
+    else {
+      if (cache->nextfree == cache->allocated) {
+        cache->allocated = gt_condenseq_array_size_increase(cache->allocated);
+        cache->entries = gt_realloc(cache->entries,
+                                    sizeof (*cache->entries) *
+                                    cache->allocated);
+      }
+      slot = cache->nextfree++;
+    }
+    entry = cache->entries + slot;
+    entry->seq = seq;
+    entry->id = id;
+    entry->len = len;
+    entry->is_link = is_link;
+    slots[id] = slot;
+    cache->size += len;
+    condenseq_cache_push_front(cache, slot);
+  }
+  gt_mutex_unlock(cache->mutex);
+}
+
+void gt_condenseq_set_cache_size(GtCondenseq *condenseq, GtUword maxsize)
+{
+  gt_assert(condenseq != NULL);
+  condenseq_cache_delete(condenseq->cache);
+  condenseq->cache = NULL;
+  if (maxsize > 0)
+    condenseq->cache = condenseq_cache_new(condenseq, maxsize);
+}
+
 void gt_condenseq_delete(GtCondenseq *condenseq)
 {
   if (condenseq != NULL) {
@@ -388,6 +579,7 @@ void gt_condenseq_delete(GtCondenseq *condenseq)
     gt_alphabet_delete(condenseq->alphabet);
     gt_encseq_delete(condenseq->unique_es);
     gt_free(condenseq->buffer);
+    condenseq_cache_delete(condenseq->cache);
     gt_free(condenseq->filename);
     gt_free(condenseq->links);
     gt_free(condenseq->orig_ids);
@@ -689,7 +881,17 @@ static GtUword condenseq_unique_extract_encoded(const GtCondenseq *cs,
   else
     endpos = startpos + targetlength - 1;
 
-  gt_encseq_extract_encoded(cs->unique_es, buffer, startpos, endpos);
+  if (cs->cache == NULL || (GtUword) unique.len > cs->cache->maxsize)
+    gt_encseq_extract_encoded(cs->unique_es, buffer, startpos, endpos);
+  else if (!condenseq_cache_get(cs->cache, false, id, startoffset,
+                                endpos - startpos + 1, buffer)) {
+    GtUchar *seq = gt_malloc(sizeof (*seq) * unique.len);
+    gt_encseq_extract_encoded(cs->unique_es, seq, startpos - startoffset,
+                              startpos - startoffset + unique.len - 1);
+    memcpy(buffer, seq + startoffset,
+           sizeof (*buffer) * (endpos - startpos + 1));
+    condenseq_cache_add(cs->cache, false, id, seq, (GtUword) unique.len);
+  }
   return endpos - startpos + 1;
 }
 
@@ -717,19 +919,37 @@ static GtUword condenseq_link_extract_encoded(const GtCondenseq *cs,
     endpos = link.len - 1;
   else
     endpos = startoffset + targetlength - 1;
-  written =
-    gt_editscript_get_sub_sequence_v(editscript, cs->unique_es,
-                                     unique_startpos + link.unique_offset,
-                                     GT_READMODE_FORWARD, startoffset,
-                                     endpos, buffer);
-  gt_assert(written == endpos - startoffset + 1);
+  written = endpos - startoffset + 1;
+  if (cs->cache == NULL || (GtUword) link.len > cs->cache->maxsize) {
+    GT_UNUSED GtUword seqlen =
+      gt_editscript_get_sub_sequence_v(editscript, cs->unique_es,
+                                       unique_startpos + link.unique_offset,
+                                       GT_READMODE_FORWARD, startoffset,
+                                       endpos, buffer);
+    gt_assert(seqlen == written);
+  }
+  else if (!condenseq_cache_get(cs->cache, true, id, startoffset, written,
+                                buffer)) {
+    GtUchar *seq = gt_malloc(sizeof (*seq) * link.len);
+    GT_UNUSED GtUword seqlen =
+      gt_editscript_get_sub_sequence_v(editscript, cs->unique_es,
+                                       unique_startpos + link.unique_offset,
+                                       GT_READMODE_FORWARD, 0,
+                                       (GtUword) link.len - 1, seq);
+    gt_assert(seqlen == (GtUword) link.len);
+    memcpy(buffer, seq + startoffset, sizeof (*buffer) * written);
+    condenseq_cache_add(cs->cache, true, id, seq, (GtUword) link.len);
+  }
   return written;
 }
 
-const GtUchar *gt_condenseq_extract_encoded_range(GtCondenseq *condenseq,
-                                                  GtRange range)
+/* writes the encoded range <range> to <buf>, does not use the buffers of
+   <condenseq> so it can be called from several threads */
+static void condenseq_extract_encoded_range_to_buffer(
+                                                   const GtCondenseq *condenseq,
+                                                   GtRange range,
+                                                   GtUchar *buf)
 {
-  GtUchar *buf;
   GtUword nextsep,
           linkid = 0,
           uniqueid,
@@ -749,16 +969,6 @@ const GtUchar *gt_condenseq_extract_encoded_range(GtCondenseq *condenseq,
 
   length = range.end - range.start + 1;
 
-  /* TODO DW check if there is another way than using this buffer, so we could
-     use const for condenseq here. */
-  if (condenseq->ubuffer == NULL || condenseq->ubuffsize < length) {
-    condenseq->ubuffer = gt_realloc(condenseq->ubuffer,
-                                    sizeof (*condenseq->ubuffer) * length);
-    condenseq->ubuffsize = length;
-  }
-
-  buf = condenseq->ubuffer;
-
   unique = &condenseq->uniques[uniqueid];
 
   if (unique->orig_startpos + unique->len <= range.start) {
@@ -824,7 +1034,116 @@ const GtUchar *gt_condenseq_extract_encoded_range(GtCondenseq *condenseq,
     }
   }
   gt_assert(buffoffset == length);
-  return buf;
+}
+
+const GtUchar *gt_condenseq_extract_encoded_range(GtCondenseq *condenseq,
+                                                  GtRange range)
+{
+  GtUword length;
+
+  gt_assert(condenseq != NULL);
+  gt_assert(range.start <= range.end);
+  length = range.end - range.start + 1;
+
+  /* TODO DW check if there is another way than using this buffer, so we could
+     use const for condenseq here. */
+  if (condenseq->ubuffer == NULL || condenseq->ubuffsize < length) {
+    condenseq->ubuffer = gt_realloc(condenseq->ubuffer,
+                                    sizeof (*condenseq->ubuffer) * length);
+    condenseq->ubuffsize = length;
+  }
+  condenseq_extract_encoded_range_to_buffer(condenseq, range,
+                                            condenseq->ubuffer);
+  return condenseq->ubuffer;
+}
+
+typedef struct {
+  const GtCondenseq *condenseq;
+  const GtRange     *ranges;
+  GtUchar          **buffers;
+  GtMutex           *mutex;
+  const GtAlphabet  *alphabet;
+  GtUword            next_range,
+                     num_ranges;
+  char               separator;
+} GtCondenseqExtractRangesInfo;
+
+static void *condenseq_extract_ranges_thread(void *data)
+{
+  GtCondenseqExtractRangesInfo *info = data;
+  GtUword idx;
+
+  while (true) {
+    gt_mutex_lock(info->mutex);
+    idx = info->next_range++;
+    gt_mutex_unlock(info->mutex);
+    if (idx >= info->num_ranges)
+      break;
+    condenseq_extract_encoded_range_to_buffer(info->condenseq,
+                                              info->ranges[idx],
+                                              info->buffers[idx]);
+    /* decode in place */
+    if (info->alphabet != NULL) {
+      GtUword pos, length = gt_range_length(info->ranges + idx);
+      GtUchar *buf = info->buffers[idx];
+      for (pos = 0; pos < length; pos++) {
+        if (buf[pos] == (GtUchar) GT_SEPARATOR)
+          buf[pos] = (GtUchar) info->separator;
+        else
+          buf[pos] = (GtUchar) gt_alphabet_decode(info->alphabet, buf[pos]);
+      }
+    }
+  }
+  return NULL;
+}
+
+static int condenseq_extract_ranges(GtCondenseq *condenseq,
+                                    const GtRange *ranges,
+                                    GtUword num_ranges,
+                                    GtUchar **buffers,
+                                    const GtAlphabet *alphabet,
+                                    char separator,
+                                    GtError *err)
+{
+  int had_err = 0;
+  GtCondenseqExtractRangesInfo info;
+
+  gt_assert(condenseq != NULL);
+  gt_assert(num_ranges == 0 || (ranges != NULL && buffers != NULL));
+  info.condenseq = condenseq;
+  info.ranges = ranges;
+  info.buffers = buffers;
+  info.alphabet = alphabet;
+  info.separator = separator;
+  info.next_range = 0;
+  info.num_ranges = num_ranges;
+  info.mutex = gt_mutex_new();
+  if (num_ranges > 0)
+    had_err = gt_multithread(condenseq_extract_ranges_thread, &info, err);
+  gt_mutex_delete(info.mutex);
+  return had_err;
+}
+
+int gt_condenseq_extract_encoded_ranges(GtCondenseq *condenseq,
+                                        const GtRange *ranges,
+                                        GtUword num_ranges,
+                                        GtUchar **buffers,
+                                        GtError *err)
+{
+  return condenseq_extract_ranges(condenseq, ranges, num_ranges, buffers,
+                                  NULL, '\0', err);
+}
+
+int gt_condenseq_extract_decoded_ranges(GtCondenseq *condenseq,
+                                        const GtRange *ranges,
+                                        GtUword num_ranges,
+                                        char **buffers,
+                                        char separator,
+                                        GtError *err)
+{
+  return condenseq_extract_ranges(condenseq, ranges, num_ranges,
+                                  (GtUchar **) buffers, condenseq->alphabet,
+                                  separator, err);
 }
 
 const GtUchar *gt_condenseq_extract_encoded(GtCondenseq *condenseq,
@@ -103,6 +103,30 @@ const char*        gt_condenseq_extract_decoded(GtCondenseq *condenseq,
 const char*        gt_condenseq_extract_decoded_range(GtCondenseq *condenseq,
                                                       GtRange range,
                                                       char separator);
+/* Extracts the encoded representations of the <num_ranges> (inclusive) ranges
+   <ranges> of <condenseq> into <buffers>, where <buffers[i]> has to provide
+   space for the length of <ranges[i]>. The ranges are extracted by <gt_jobs>
+   threads. Sequence separators are set to GT_SEPARATOR. Returns 0 on success
+   and sets <err> on failure. */
+int                gt_condenseq_extract_encoded_ranges(GtCondenseq *condenseq,
+                                                       const GtRange *ranges,
+                                                       GtUword num_ranges,
+                                                       GtUchar **buffers,
+                                                       GtError *err);
+/* Like <gt_condenseq_extract_encoded_ranges()> but writes the decoded
+   representations, using <separator> for sequence separators. */
+int                gt_condenseq_extract_decoded_ranges(GtCondenseq *condenseq,
+                                                       const GtRange *ranges,
+                                                       GtUword num_ranges,
+                                                       char **buffers,
+                                                       char separator,
+                                                       GtError *err);
+/* Keep up to <maxsize> symbols of completely decoded uniques and links of
+   <condenseq> in memory, so repeated extraction of the same elements does not
+   need to apply their editscripts again. If the limit is reached the least
+   recently used elements are removed. 0 disables the cache (default). */
+void               gt_condenseq_set_cache_size(GtCondenseq *condenseq,
+                                               GtUword maxsize);
 /* Function type used to process redundant seqs, should return != 0 on error
    and set <err> accordingly. */
 typedef int (GtCondenseqProcessExtractedSeqs)(void *data,
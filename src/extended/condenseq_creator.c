@@ -18,6 +18,7 @@
 #include <string.h>
 #include <stddef.h>
 
+#include "core/array_api.h"
 #include "core/arraydef_api.h"
 #include "core/disc_distri_api.h"
 #include "core/divmodmul_api.h"
@@ -25,10 +26,12 @@
 #include "core/log_api.h"
 #include "core/logger.h"
 #include "core/ma_api.h"
+#include "core/minmax_api.h"
 #include "core/range_api.h"
 #include "core/safearith_api.h"
 #include "core/showtime.h"
 #include "core/str_array.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "extended/kmer_database.h"
@@ -49,8 +52,6 @@
 /* outputs the diagonals data structure after every update */
 /* #define GT_CONDENSEQ_CREATOR_DIAGS_DEBUG */
 
-static GtUword ces_c_xdrops = 0;
-
 #define GT_CES_C_SPARSE_DIAGS_RESIZE(A, MINELEMS) \
   if (A->nextfree + MINELEMS >= A->allocated) { \
     A->allocated *= 1.2; \
@@ -294,7 +295,16 @@ typedef int
                                    GtCondenseqLink *best_link,
                                    GtError *err);
 
+/* a unique (<link.editscript> is NULL) or link found for a sequence of a
+   batch, which is added to the condenseq once the batch is complete */
+typedef struct {
+  GtCondenseqLink link;
+  GtUword         unique_start,
+                  unique_len;
+} CesCBatchElem;
+
 struct GtCondenseqCreator {
+  GtArray            *batch_elems;
   GtEncseq           *input_es;
   GtKmerDatabase     *kmer_db;
   GtKmercodeiterator *adding_iter, *main_kmer_iter;
@@ -307,7 +317,9 @@ struct GtCondenseqCreator {
   gt_condenseq_creator_extend_fkt extend;
   GtCondenseqCreatorXdrop         xdrop;
   GtCondenseqCreatorWindow        window;
-  GtUword                         current_orig_start,
+  GtXdropArbitraryscores          scores;
+  GtUword                         batch_size,
+                                  current_orig_start,
                                   current_seq_len,
                                   current_seq_pos,
                                   current_seq_start,
@@ -320,7 +332,9 @@ struct GtCondenseqCreator {
                                   mean_fraction,
                                   min_d,
                                   max_d,
-                                  min_nu_kmers;
+                                  min_nu_kmers,
+                                  last_seqnum,
+                                  xdrops;
   unsigned int                    kmersize,
                                   windowsize,
                                   cleanup_percent;
@@ -481,7 +495,7 @@ static int ces_c_xdrop(GtCondenseqCreator *ces_c,
                                  ces_c->input_es,
                                  i - subject_bounds.start,
                                  subject_bounds.start);
-    ces_c_xdrops++;
+    ces_c->xdrops++;
     gt_evalxdroparbitscoresextend(!forward,
                                   &left_xdrop,
                                   xdrop->left_xdrop_res,
@@ -497,7 +511,7 @@ static int ces_c_xdrop(GtCondenseqCreator *ces_c,
                                  ces_c->input_es,
                                  subject_bounds.end - i,
                                  i);
-    ces_c_xdrops++;
+    ces_c->xdrops++;
     gt_evalxdroparbitscoresextend(forward,
                                   &right_xdrop,
                                   xdrop->right_xdrop_res,
@@ -610,7 +624,7 @@ static int ces_c_extend_seeds_window(GtCondenseqCreator *ces_c,
                  querypos,
                  query_bounds.end,
                  ces_c->windowsize,
-                 ces_c_xdrops);
+                 ces_c->xdrops);
     had_err = -1;
   }
 
@@ -981,6 +995,8 @@ GtCondenseqCreator *gt_condenseq_creator_new(GtUword initsize,
     return NULL;
   }
   ces_c->adding_iter = NULL;
+  ces_c->batch_elems = NULL;
+  ces_c->batch_size = 0;
   ces_c->ces = NULL;
   ces_c->current_orig_start = 0;
   ces_c->cleanup_percent = GT_DIAGS_CLEAN_LIMIT;
@@ -991,6 +1007,7 @@ GtCondenseqCreator *gt_condenseq_creator_new(GtUword initsize,
   ces_c->initsize = initsize;
   ces_c->kmer_db = NULL;
   ces_c->kmersize = kmersize;
+  ces_c->last_seqnum = GT_UNDEF_UWORD;
   ces_c->logger = logger;
   ces_c->main_kmer_iter = NULL;
   ces_c->main_pos = 0;
@@ -1009,6 +1026,8 @@ GtCondenseqCreator *gt_condenseq_creator_new(GtUword initsize,
   ces_c->window.count = 0;
   ces_c->window.next = 0;
   ces_c->windowsize = windowsize;
+  ces_c->xdrops = 0;
+  ces_c->scores = *scores;
 
   ces_c->extend = ces_c_extend_seeds_diags;
 
@@ -1136,6 +1155,14 @@ void gt_condenseq_creator_set_mean_fraction(
   condenseq_creator->mean_fraction = fraction;
 }
 
+void gt_condenseq_creator_set_batch_size(
+                                          GtCondenseqCreator *condenseq_creator,
+                                          GtUword batch_size)
+{
+  gt_assert(condenseq_creator != NULL);
+  condenseq_creator->batch_size = batch_size;
+}
+
 void gt_condenseq_creator_delete(GtCondenseqCreator *condenseq_creator)
 {
   if (condenseq_creator != NULL) {
@@ -1247,6 +1274,38 @@ static void ces_c_add_kmers(GtCondenseqCreator *ces_c,
                                   ces_c->ces->uds_nelems - 1);
 }
 
+/* in batch workers uniques and links are only recorded, so the condenseq and
+   the kmer database stay unchanged while the batch is processed */
+static void ces_c_add_unique(GtCondenseqCreator *ces_c,
+                             GtUword start,
+                             GtUword len)
+{
+  if (ces_c->batch_elems != NULL) {
+    CesCBatchElem elem;
+    elem.link.editscript = NULL;
+    elem.unique_start = start;
+    elem.unique_len = len;
+    gt_array_add(ces_c->batch_elems, elem);
+  }
+  else {
+    gt_condenseq_add_unique_to_db(ces_c->ces, start, (ces_unsigned) len);
+    ces_c_add_kmers(ces_c, start, start + len);
+  }
+}
+
+static void ces_c_add_link(GtCondenseqCreator *ces_c,
+                           GtCondenseqLink link)
+{
+  if (ces_c->batch_elems != NULL) {
+    CesCBatchElem elem;
+    elem.link = link;
+    elem.unique_start = elem.unique_len = 0;
+    gt_array_add(ces_c->batch_elems, elem);
+  }
+  else
+    gt_condenseq_add_link_to_db(ces_c->ces, link);
+}
+
 static CesCState ces_c_handle_seqend(GtCondenseqCreator *ces_c,
                                      GtError *err)
 {
@@ -1257,18 +1316,16 @@ static CesCState ces_c_handle_seqend(GtCondenseqCreator *ces_c,
   length += ces_c->main_pos - ces_c->current_orig_start;
   if (length != 0) {
     GT_CES_LENCHECK_STATE(length);
-    if (state != GT_CONDENSEQ_CREATOR_ERROR) {
-      gt_condenseq_add_unique_to_db(ces_c->ces,
-                                    ces_c->current_orig_start,
-                                    length);
-      if (length >= ces_c->min_align_len)
-        ces_c_add_kmers(ces_c, ces_c->current_orig_start,
-                        ces_c->current_orig_start + length);
-    }
+    if (state != GT_CONDENSEQ_CREATOR_ERROR)
+      ces_c_add_unique(ces_c, ces_c->current_orig_start, length);
   }
   if (state != GT_CONDENSEQ_CREATOR_ERROR) {
     ces_c->main_seqnum++;
-    state = ces_c_skip_short_seqs(ces_c);
+    if (ces_c->last_seqnum != GT_UNDEF_UWORD &&
+        ces_c->main_seqnum > ces_c->last_seqnum)
+      state = GT_CONDENSEQ_CREATOR_EOD;
+    else
+      state = ces_c_skip_short_seqs(ces_c);
     if (state == GT_CONDENSEQ_CREATOR_CONT) {
       state = ces_c_reset_pos_and_iter_to_current_seq(ces_c);
     }
@@ -1324,12 +1381,9 @@ static CesCState ces_c_extend_seed_kmer(GtCondenseqCreator *ces_c,
       }
       else {
         GT_CES_LENCHECK_STATE(leading_unique_len);
-        if (state != GT_CONDENSEQ_CREATOR_ERROR) {
-          gt_condenseq_add_unique_to_db(ces_c->ces,
-                                        ces_c->current_orig_start,
-                                        leading_unique_len);
-          ces_c_add_kmers(ces_c, ces_c->current_orig_start, link.orig_startpos);
-        }
+        if (state != GT_CONDENSEQ_CREATOR_ERROR)
+          ces_c_add_unique(ces_c, ces_c->current_orig_start,
+                           leading_unique_len);
       }
     }
 
@@ -1363,7 +1417,7 @@ static CesCState ces_c_extend_seed_kmer(GtCondenseqCreator *ces_c,
                                                          link.orig_startpos,
                                                          GT_READMODE_FORWARD);
       gt_multieoplist_delete(linkops);
-      gt_condenseq_add_link_to_db(ces_c->ces, link);
+      ces_c_add_link(ces_c, link);
 
       if (state != GT_CONDENSEQ_CREATOR_EOD &&
           remaining < ces_c->min_align_len) {
@@ -1528,6 +1582,283 @@ static int ces_c_init_kmer_db(GtCondenseqCreator *ces_c, GtError *err)
   return had_err;
 }
 
+/* a copy of the creator which processes sequences of a batch on its own, it
+   shares the input, the condenseq and the kmer database, which are not changed
+   while the batch is processed */
+static GtCondenseqCreator *ces_c_batch_worker_new(GtCondenseqCreator *ces_c)
+{
+  GtCondenseqCreator *worker = gt_malloc(sizeof (*worker));
+
+  *worker = *ces_c;
+  worker->batch_elems = gt_array_new(sizeof (CesCBatchElem));
+  worker->xdrops = 0;
+  worker->adding_iter = NULL;
+  worker->main_kmer_iter = gt_kmercodeiterator_encseq_new(ces_c->input_es,
+                                                          GT_READMODE_FORWARD,
+                                                          ces_c->kmersize,
+                                                          0);
+  ces_c_xdrop_init(&worker->scores, ces_c->xdrop.xdropscore, &worker->xdrop);
+  worker->window.count = 0;
+  worker->window.next = 0;
+  worker->window.idxs = gt_calloc((size_t) ces_c->windowsize,
+                                  sizeof (*worker->window.idxs));
+  worker->window.pos_arrs = gt_calloc((size_t) ces_c->windowsize,
+                                      sizeof (*worker->window.pos_arrs));
+  worker->diagonals = NULL;
+  if (ces_c->diagonals != NULL) {
+    gt_assert(ces_c->diagonals->full == NULL);
+    worker->diagonals = gt_malloc(sizeof (*worker->diagonals));
+    worker->diagonals->full = NULL;
+    worker->diagonals->sparse =
+      ces_c_sparse_diags_new((size_t) ces_c->initsize);
+  }
+  worker->add = worker->replace = worker->delete = NULL;
+#ifdef GT_CONDENSEQ_CREATOR_DIST_DEBUG
+  if (gt_log_enabled()) {
+    worker->add = gt_disc_distri_new();
+    worker->replace = gt_disc_distri_new();
+    worker->delete = gt_disc_distri_new();
+  }
+#endif
+  return worker;
+}
+
+static void ces_c_batch_worker_delete(GtCondenseqCreator *worker)
+{
+  GtUword idx;
+
+  for (idx = 0; idx < gt_array_size(worker->batch_elems); idx++) {
+    CesCBatchElem *elem = gt_array_get(worker->batch_elems, idx);
+    gt_editscript_delete(elem->link.editscript);
+  }
+  gt_array_delete(worker->batch_elems);
+  gt_kmercodeiterator_delete(worker->main_kmer_iter);
+  ces_c_diags_delete(worker->diagonals);
+  /* the shared members are owned by the creator */
+  worker->kmer_db = NULL;
+  worker->diagonals = NULL;
+  gt_condenseq_creator_delete(worker);
+}
+
+/* process sequence <seqnum> from position <startpos> on, records the found
+   uniques and links in <worker->batch_elems> */
+static int ces_c_batch_worker_analyse_seq(GtCondenseqCreator *worker,
+                                          GtUword seqnum,
+                                          GtUword startpos,
+                                          GtError *err)
+{
+  const GtKmercode *main_kmercode = NULL;
+  CesCState state;
+  int had_err = 0;
+
+  worker->main_seqnum =
+    worker->last_seqnum = seqnum;
+  worker->current_seq_start = gt_condenseq_seqstartpos(worker->ces, seqnum);
+  worker->current_seq_len = gt_condenseq_seqlength(worker->ces, seqnum);
+  if (worker->current_seq_len < worker->min_align_len) {
+    gt_assert(startpos == worker->current_seq_start);
+    ces_c_add_unique(worker, startpos, worker->current_seq_len);
+    return had_err;
+  }
+  if (worker->diagonals != NULL) {
+    CesCSparseDiags *diags = worker->diagonals->sparse;
+    diags->nextfree =
+      diags->add_nextfree =
+      diags->marked = 0;
+    gt_rbtree_clear(diags->add_tree);
+  }
+  state = ces_c_reset_pos_and_iter(worker, startpos);
+  gt_assert(state == GT_CONDENSEQ_CREATOR_RESET);
+  state = GT_CONDENSEQ_CREATOR_CONT;
+  while (state == GT_CONDENSEQ_CREATOR_CONT &&
+         (main_kmercode =
+          gt_kmercodeiterator_encseq_next(worker->main_kmer_iter)) != NULL) {
+    state = ces_c_process_kmer(worker, main_kmercode, err);
+    while (state == GT_CONDENSEQ_CREATOR_RESET &&
+           (main_kmercode =
+            gt_kmercodeiterator_encseq_next(worker->main_kmer_iter)) != NULL) {
+      state = ces_c_process_kmer(worker, main_kmercode, err);
+    }
+    if (state != GT_CONDENSEQ_CREATOR_ERROR) {
+      worker->main_pos++;
+      worker->current_seq_pos++;
+    }
+  }
+  if (state == GT_CONDENSEQ_CREATOR_ERROR)
+    had_err = -1;
+  if (!had_err && state != GT_CONDENSEQ_CREATOR_EOD) {
+    had_err = -1;
+    gt_error_set(err, "Processing of kmers stopped, but end of sequence "
+                 GT_WU " not reached", seqnum);
+  }
+  return had_err;
+}
+
+typedef struct {
+  GtCondenseqCreator  *worker;
+  GtArray            **seq_elems;
+  GtMutex             *mutex;
+  GtUword             *next_seq,
+                       first_seqnum,
+                       first_startpos,
+                       num_of_seqs;
+  GtError             *err;
+  int                  had_err;
+} CesCBatchThreadInfo;
+
+static void *ces_c_batch_thread(void *data)
+{
+  CesCBatchThreadInfo *info = data;
+
+  while (!info->had_err) {
+    GtUword idx, seqnum, startpos;
+    GtArray *swap;
+
+    gt_mutex_lock(info->mutex);
+    idx = (*info->next_seq)++;
+    gt_mutex_unlock(info->mutex);
+    if (idx >= info->num_of_seqs)
+      break;
+    seqnum = info->first_seqnum + idx;
+    startpos = idx == 0 ? info->first_startpos :
+               gt_condenseq_seqstartpos(info->worker->ces, seqnum);
+    gt_assert(gt_array_size(info->seq_elems[idx]) == 0);
+    swap = info->seq_elems[idx];
+    info->seq_elems[idx] = info->worker->batch_elems;
+    info->worker->batch_elems = swap;
+    info->had_err = ces_c_batch_worker_analyse_seq(info->worker, seqnum,
+                                                   startpos, info->err);
+    swap = info->seq_elems[idx];
+    info->seq_elems[idx] = info->worker->batch_elems;
+    info->worker->batch_elems = swap;
+  }
+  return NULL;
+}
+
+/* Processes the remaining sequences in batches of <ces_c->batch_size>. The
+   sequences of a batch are compared only against the uniques found before the
+   batch, so they can be processed independently by <gt_jobs> threads. The
+   results are added in the order of the sequences, which makes the output
+   independent of the number of threads. */
+static int ces_c_analyse_batches(GtCondenseqCreator *ces_c, GtTimer *timer,
+                                 GtError *err)
+{
+  int had_err = 0;
+  GtUword idx, thread_idx, numthreads = 1UL,
+          seqnum = ces_c->main_seqnum,
+          startpos = ces_c->main_pos,
+          num_of_seqs = ces_c->ces->orig_num_seq;
+  GtArray **seq_elems;
+  CesCBatchThreadInfo *infos;
+  GtMutex *mutex = gt_mutex_new();
+
+  gt_assert(ces_c->batch_size > 0);
+#ifdef GT_THREADS_ENABLED
+  numthreads = GT_MIN((GtUword) gt_jobs, ces_c->batch_size);
+#endif
+  gt_logger_log(ces_c->logger, "compress batches of " GT_WU " sequences with "
+                GT_WU " thread(s)", ces_c->batch_size, numthreads);
+  seq_elems = gt_malloc(sizeof (*seq_elems) * ces_c->batch_size);
+  for (idx = 0; idx < ces_c->batch_size; idx++)
+    seq_elems[idx] = gt_array_new(sizeof (CesCBatchElem));
+  infos = gt_calloc((size_t) numthreads, sizeof (*infos));
+  for (thread_idx = 0; thread_idx < numthreads; thread_idx++) {
+    infos[thread_idx].worker = ces_c_batch_worker_new(ces_c);
+    infos[thread_idx].seq_elems = seq_elems;
+    infos[thread_idx].mutex = mutex;
+    infos[thread_idx].err = thread_idx == 0 ? err : gt_error_new();
+  }
+
+  while (!had_err && seqnum < num_of_seqs) {
+    GtUword next_seq = 0,
+            batch_seqs = GT_MIN(ces_c->batch_size, num_of_seqs - seqnum);
+#ifdef GT_THREADS_ENABLED
+    GtThread **threads = gt_calloc((size_t) numthreads, sizeof (*threads));
+#endif
+
+    if (gt_showtime_enabled())
+      gt_timer_show_progress_formatted(timer, stderr,
+                                       "analyse data, search hits, batch at "
+                                       "sequence " GT_WU, seqnum);
+    for (thread_idx = 0; thread_idx < numthreads; thread_idx++) {
+      infos[thread_idx].next_seq = &next_seq;
+      infos[thread_idx].first_seqnum = seqnum;
+      infos[thread_idx].first_startpos = startpos;
+      infos[thread_idx].num_of_seqs = batch_seqs;
+    }
+#ifdef GT_THREADS_ENABLED
+    for (thread_idx = 1UL; thread_idx < numthreads; thread_idx++)
+      threads[thread_idx] = gt_thread_new(ces_c_batch_thread,
+                                          infos + thread_idx, NULL);
+#endif
+    (void) ces_c_batch_thread(infos);
+#ifdef GT_THREADS_ENABLED
+    for (thread_idx = 1UL; thread_idx < numthreads; thread_idx++) {
+      if (threads[thread_idx] != NULL) {
+        gt_thread_join(threads[thread_idx]);
+        gt_thread_delete(threads[thread_idx]);
+      }
+      else
+        (void) ces_c_batch_thread(infos + thread_idx);
+    }
+    gt_free(threads);
+#endif
+    for (thread_idx = 0; !had_err && thread_idx < numthreads; thread_idx++) {
+      if (infos[thread_idx].had_err) {
+        had_err = -1;
+        if (thread_idx > 0)
+          gt_error_set(err, "%s", gt_error_get(infos[thread_idx].err));
+      }
+    }
+    /* add the results in input order */
+    for (idx = 0; idx < batch_seqs; idx++) {
+      GtUword elem_idx;
+      for (elem_idx = 0; elem_idx < gt_array_size(seq_elems[idx]);
+           elem_idx++) {
+        CesCBatchElem *elem = gt_array_get(seq_elems[idx], elem_idx);
+        if (had_err)
+          gt_editscript_delete(elem->link.editscript);
+        else if (elem->link.editscript == NULL)
+          ces_c_add_unique(ces_c, elem->unique_start, elem->unique_len);
+        else
+          ces_c_add_link(ces_c, elem->link);
+      }
+      gt_array_reset(seq_elems[idx]);
+    }
+    if (!had_err) {
+      gt_kmer_database_flush(ces_c->kmer_db);
+      seqnum += batch_seqs;
+      if (seqnum < num_of_seqs)
+        startpos = gt_condenseq_seqstartpos(ces_c->ces, seqnum);
+      gt_log_log(GT_WU " sequences processed, " GT_WU " uniques, " GT_WU
+                 " links", seqnum, ces_c->ces->uds_nelems,
+                 ces_c->ces->lds_nelems);
+    }
+  }
+
+  for (thread_idx = 0; thread_idx < numthreads; thread_idx++) {
+    GtCondenseqCreator *worker = infos[thread_idx].worker;
+    ces_c->xdrops += worker->xdrops;
+    if (worker->min_d < ces_c->min_d)
+      ces_c->min_d = worker->min_d;
+    if (worker->max_d > ces_c->max_d)
+      ces_c->max_d = worker->max_d;
+    ces_c_batch_worker_delete(worker);
+    if (thread_idx > 0)
+      gt_error_delete(infos[thread_idx].err);
+  }
+  gt_free(infos);
+  for (idx = 0; idx < ces_c->batch_size; idx++)
+    gt_array_delete(seq_elems[idx]);
+  gt_free(seq_elems);
+  gt_mutex_delete(mutex);
+  if (!had_err) {
+    ces_c->main_seqnum = num_of_seqs;
+    ces_c->main_pos = ces_c->ces->orig_len;
+  }
+  return had_err;
+}
+
 /* scan the seq and fill tables */
 static int ces_c_analyse(GtCondenseqCreator *ces_c, GtTimer *timer,
                          GtError *err)
@@ -1545,14 +1876,19 @@ static int ces_c_analyse(GtCondenseqCreator *ces_c, GtTimer *timer,
   had_err = ces_c_init_kmer_db(ces_c, err);
   if (!had_err &&
       !gt_kmercodeiterator_inputexhausted(ces_c->main_kmer_iter)) {
-    GtUword percentile;
-    const GtUword percent = ces_c->ces->orig_len / 100;
     gt_log_log(GT_WU " initial kmer positions in kmer_db",
                gt_kmer_database_get_kmer_count(ces_c->kmer_db));
     gt_log_log(GT_WU " initial bytes for kmer_db",
                gt_kmer_database_get_used_size(ces_c->kmer_db));
     gt_log_log(GT_WU " initial bytes allocated size of kmer_db",
                gt_kmer_database_get_byte_size(ces_c->kmer_db));
+    if (ces_c->batch_size > 0)
+      had_err = ces_c_analyse_batches(ces_c, timer, err);
+  }
+  if (!had_err && ces_c->batch_size == 0 &&
+      !gt_kmercodeiterator_inputexhausted(ces_c->main_kmer_iter)) {
+    GtUword percentile;
+    const GtUword percent = ces_c->ces->orig_len / 100;
     percentile = ces_c->main_pos / percent;
     /* we are now within one sequence, and the rest of it is long enough, or we
        are at the beginning of a sequence that is long enough */
@@ -1581,7 +1917,7 @@ static int ces_c_analyse(GtCondenseqCreator *ces_c, GtTimer *timer,
           gt_log_log(GT_WU "%% processed.", percentile);
           gt_log_log(GT_WU " kmer positions in unique (kmer_db)",
                      gt_kmer_database_get_kmer_count(ces_c->kmer_db));
-          gt_log_log(GT_WU " times xdrop was called", ces_c_xdrops);
+          gt_log_log(GT_WU " times xdrop was called", ces_c->xdrops);
           gt_log_log(GT_WU " uniques", ces_c->ces->uds_nelems);
           gt_log_log(GT_WU " links", ces_c->ces->lds_nelems);
           if (gt_showtime_enabled()) {
@@ -1653,6 +1989,11 @@ int gt_condenseq_creator_create(GtCondenseqCreator *condenseq_creator,
   gt_assert(condenseq_creator != NULL);
   gt_assert(encseq != NULL);
 
+  if (condenseq_creator->batch_size > 0 && condenseq_creator->use_full_diags) {
+    gt_error_set(err, "full diagonals can not be used with batches");
+    return -1;
+  }
+
   gt_logger_log(logger, "number of kmer-pos cutoff setting:");
   if (condenseq_creator->cutoff_value == GT_UNDEF_UWORD)
     gt_logger_log(logger, "mean/" GT_WU, condenseq_creator->mean_fraction);
@@ -1725,7 +2066,7 @@ int gt_condenseq_creator_create(GtCondenseqCreator *condenseq_creator,
   else
     condenseq_creator->diagonals = NULL;
 
-  ces_c_xdrops = 0;
+  condenseq_creator->xdrops = 0;
   had_err = ces_c_analyse(condenseq_creator, timer, err);
 
   if (!had_err) {
@@ -1733,7 +2074,7 @@ int gt_condenseq_creator_create(GtCondenseqCreator *condenseq_creator,
       gt_timer_show_progress(timer, "write data, alphabet", stderr);
     gt_log_log(GT_WU " kmer positions in final kmer_db",
                gt_kmer_database_get_kmer_count(condenseq_creator->kmer_db));
-    gt_log_log(GT_WU " xdrop calls.", ces_c_xdrops);
+    gt_log_log(GT_WU " xdrop calls.", condenseq_creator->xdrops);
     gt_log_log(GT_WU " uniques", condenseq_creator->ces->uds_nelems);
     gt_log_log(GT_WU " links", condenseq_creator->ces->lds_nelems);
     gt_log_log(GT_WU " bytes in final kmer_db",
@@ -106,6 +106,14 @@ void                gt_condenseq_creator_disable_prune(
 void                gt_condenseq_creator_set_mean_fraction(
                                           GtCondenseqCreator *condenseq_creator,
                                           GtUword fraction);
+/* Process the sequences after the initial unique in batches of <batch_size>
+   sequences, which are compared against the uniques found before the batch
+   only. The sequences of a batch are processed by <gt_jobs> threads, the
+   result is the same for any number of threads. 0 (default) processes all
+   sequences one after another. Can not be combined with full diagonals. */
+void                gt_condenseq_creator_set_batch_size(
+                                          GtCondenseqCreator *condenseq_creator,
+                                          GtUword batch_size);
 /* Percentage of sparse diagonals that is allowed to be outside of used ranges
    and marked for deletion. 0 <= <percent> < 100. */
 void gt_condenseq_creator_set_diags_clean_limit(
@@ -57,8 +57,13 @@ typedef struct {
   ces_unsigned    len;
 } GtCondenseqUnique;
 
+/* bounded cache of decoded uniques and links, see gt_condenseq_set_cache_size()
+   */
+typedef struct GtCondenseqCache GtCondenseqCache;
+
 struct GtCondenseq {
   GtAlphabet        *alphabet;
+  GtCondenseqCache  *cache;
   GtCondenseqLink   *links;
   GtCondenseqUnique *uniques;
   GtEncseq          *unique_es;
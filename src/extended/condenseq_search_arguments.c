@@ -24,8 +24,9 @@
 #include "extended/condenseq_search_arguments.h"
 
 struct GtCondenseqSearchArguments {
-  GtStr *dbpath;
-  bool   verbose;
+  GtStr  *dbpath;
+  GtUword cachesize;
+  bool    verbose;
 };
 
 GtCondenseqSearchArguments *gt_condenseq_search_arguments_new(void)
@@ -49,9 +50,12 @@ GtCondenseq *gt_condenseq_search_arguments_read_condenseq(
                    GtLogger *logger,
                    GtError *err)
 {
-  return gt_condenseq_new_from_file(
-                                 gt_str_get(condenseq_search_arguments->dbpath),
-                                 logger, err);
+  GtCondenseq *ces =
+    gt_condenseq_new_from_file(gt_str_get(condenseq_search_arguments->dbpath),
+                               logger, err);
+  if (ces != NULL)
+    gt_condenseq_set_cache_size(ces, condenseq_search_arguments->cachesize);
+  return ces;
 }
 
 bool gt_condenseq_search_arguments_verbose(
@@ -71,6 +75,13 @@ void gt_condenseq_search_register_options(
   gt_option_is_mandatory(option);
   gt_option_parser_add_option(option_parser, option);
 
+  /* -cachesize */
+  option = gt_option_new_uword("cachesize", "number of symbols of decoded "
+                               "uniques and links to keep in memory during "
+                               "extraction, 0 disables the cache",
+                               &condenseq_search_arguments->cachesize, 0);
+  gt_option_parser_add_option(option_parser, option);
+
   /* -verbose */
   option = gt_option_new_bool("verbose", "verbose output",
                               &condenseq_search_arguments->verbose, false);
@@ -34,12 +34,13 @@ GtCondenseqSearchArguments* gt_condenseq_search_arguments_new(void);
 void                        gt_condenseq_search_arguments_delete(
                         GtCondenseqSearchArguments *condenseq_search_arguments);
 
-/* register the options -db for the mandatory input archive and -verbose for
-   verbose output */
+/* register the options -db for the mandatory input archive, -cachesize for
+   the size of the cache of decoded elements and -verbose for verbose output */
 void                        gt_condenseq_search_register_options(
                          GtCondenseqSearchArguments *condenseq_search_arguments,
                          GtOptionParser *option_parser);
-/* Returns the <GtCondenseq> object read from file given by -db option */
+/* Returns the <GtCondenseq> object read from file given by -db option, with
+   the cache size given by -cachesize */
 GtCondenseq*                gt_condenseq_search_arguments_read_condenseq(
                    const GtCondenseqSearchArguments *condenseq_search_arguments,
                    GtLogger *logger,
@@ -40,9 +40,11 @@ GtBittab* gt_elias_gamma_encode(GtUword x)
   gt_assert(x > 0);
   length_in_bits = (GtUword) gt_determinebitspervalue(x);
   code = gt_bittab_new(length_in_bits + length_in_bits - 1UL);
+  /* the bits are stored in the order they are read by the decoder: the
+     leading zeros followed by <x> with the most significant bit first */
   for (idx = 0; idx < length_in_bits; idx++)
     if (((x >> idx) & 1))
-      gt_bittab_set_bit(code, idx);
+      gt_bittab_set_bit(code, length_in_bits + length_in_bits - 2UL - idx);
   return code;
 }
 
@@ -95,6 +97,28 @@ int gt_elias_gamma_bitwise_decoder_next(GtEliasGammaBitwiseDecoder *egbd,
   return 1;
 }
 
+unsigned int gt_elias_gamma_bitwise_decoder_next_bits(
+                                         GtEliasGammaBitwiseDecoder *egbd,
+                                         GtBitsequence bits,
+                                         unsigned int numofbits,
+                                         GtUword *x)
+{
+  unsigned int leading_zeros,
+               length_in_bits;
+  gt_assert(egbd);
+  gt_assert(egbd->status == LEADING_ZEROS && egbd->length_in_bits == 0);
+
+  if (bits == 0)
+    return 0;
+  leading_zeros = gt_intbits_leading_zeros(bits);
+  length_in_bits = leading_zeros + leading_zeros + 1U;
+  if (length_in_bits > numofbits)
+    return 0;
+  *x = (GtUword) ((bits << leading_zeros) >>
+                  (GT_INTWORDSIZE - 1 - leading_zeros));
+  return length_in_bits;
+}
+
 void gt_elias_gamma_bitwise_decoder_delete(GtEliasGammaBitwiseDecoder *egbd)
 {
   gt_free(egbd);
@@ -106,27 +130,51 @@ int gt_elias_gamma_unit_test(GtError *err)
       had_err = 0;
   GtUword idx,
                 idx_j,
+                size,
                 unit_test_x_size = 100UL,
                 number = unit_test_x_size + 1;
   GtBittab *code;
+  GtBitsequence bits;
   GtEliasGammaBitwiseDecoder *egbd = gt_elias_gamma_bitwise_decoder_new();
 
-  for (idx = 1UL; idx <= unit_test_x_size; idx++) {
+  for (idx = 1UL; !had_err && idx <= unit_test_x_size; idx++) {
     code = gt_elias_gamma_encode(idx);
-    for (idx_j = gt_bittab_size(code) - 1; idx_j != 0 ; idx_j--) {
-      if (gt_bittab_bit_is_set(code, idx_j))
+    size = gt_bittab_size(code);
+    bits = 0;
+    for (idx_j = 0; !had_err && idx_j < size - 1; idx_j++) {
+      if (gt_bittab_bit_is_set(code, idx_j)) {
         stat = gt_elias_gamma_bitwise_decoder_next(egbd, true, &number);
+        bits |= GT_FIRSTBIT >> idx_j;
+      }
       else
         stat = gt_elias_gamma_bitwise_decoder_next(egbd, false, &number);
       gt_ensure(stat == 1);
     }
 
-    if (gt_bittab_bit_is_set(code, idx_j))
+    if (gt_bittab_bit_is_set(code, idx_j)) {
       stat = gt_elias_gamma_bitwise_decoder_next(egbd, true, &number);
+      bits |= GT_FIRSTBIT >> idx_j;
+    }
     else
       stat = gt_elias_gamma_bitwise_decoder_next(egbd, false, &number);
     gt_ensure(stat == 0);
     gt_ensure(number == idx);
+
+    /* decode the whole code at once, followed by arbitrary bits */
+    number = 0;
+    gt_ensure(gt_elias_gamma_bitwise_decoder_next_bits(egbd, bits,
+                                                       (unsigned int) size,
+                                                       &number) == size);
+    gt_ensure(number == idx);
+    bits |= ~((GtBitsequence) 0) >> size;
+    gt_ensure(gt_elias_gamma_bitwise_decoder_next_bits(
+                                            egbd, bits,
+                                            (unsigned int) GT_INTWORDSIZE,
+                                            &number) == size);
+    gt_ensure(number == idx);
+    gt_ensure(gt_elias_gamma_bitwise_decoder_next_bits(egbd, bits,
+                                                       (unsigned int) size - 1,
+                                                       &number) == 0);
     gt_bittab_delete(code);
   }
   gt_elias_gamma_bitwise_decoder_delete(egbd);
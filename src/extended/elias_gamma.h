@@ -21,6 +21,7 @@
 
 #include "core/bittab_api.h"
 #include "core/error_api.h"
+#include "core/intbits.h"
 
 /* The <GtEliasGammaBitwiseDecoder> class is used to decode Elias gamma encoded
    integers. For details see Elias, Peter: "Universal codeword sets and
@@ -45,6 +46,16 @@ int                         gt_elias_gamma_bitwise_decoder_next(
                                                GtEliasGammaBitwiseDecoder *egbd,
                                                bool bit, GtUword *x);
 
+/* Decodes a whole code word at once from the <numofbits> most significant
+   bits of <bits>, using the number of leading zeros. Writes its value to <x>
+   and returns the length of the code word, or 0 if it is longer than
+   <numofbits>. <egbd> must not be inside a code word. */
+unsigned int                gt_elias_gamma_bitwise_decoder_next_bits(
+                                               GtEliasGammaBitwiseDecoder *egbd,
+                                               GtBitsequence bits,
+                                               unsigned int numofbits,
+                                               GtUword *x);
+
 /* Deletes <egbd> and frees all associated memory. */
 void                        gt_elias_gamma_bitwise_decoder_delete(
                                               GtEliasGammaBitwiseDecoder *egbd);
@@ -1170,29 +1170,56 @@ static inline int encdesc_read_bits(GtBitInStream *instream,
                                     GtBitsequence *bitseq,
                                     GtError *err) {
   int had_err = 0;
-  unsigned readbits;
+
+  if (gt_bitinstream_get_next_bits(instream, bits_to_read, bitseq) != 1) {
+    gt_error_set(err, "could not get next bit");
+    had_err = -1;
+  }
+  return had_err;
+}
+
+/* Reads the next code of <huffman> from <instream>, bit by bit only if the code
+   crosses the end of a mapped chunk. */
+static int encdesc_read_huffman(GtBitInStream *instream,
+                                GtHuffman *huffman,
+                                GtUword *symbol,
+                                GtError *err)
+{
+  int stat = -1,
+      had_err = 0;
   bool bit;
+  GtBitsequence bits;
+  GtHuffmanBitwiseDecoder *huff_bitwise_decoder;
+  unsigned int numofbits = gt_bitinstream_peek_bits(instream, &bits);
 
-  for (readbits = 0, *bitseq = 0;
-       !had_err && readbits < bits_to_read;
-       readbits++) {
-    *bitseq = *bitseq << 1;
-    if (gt_bitinstream_get_next_bit(instream,
-                                    &bit) != 1) {
+  if ((numofbits = gt_huffman_decode_bits(huffman, bits, numofbits,
+                                          symbol)) > 0) {
+    gt_bitinstream_skip_bits(instream, numofbits);
+    return had_err;
+  }
+  huff_bitwise_decoder = gt_huffman_bitwise_decoder_new(huffman, err);
+  while (!had_err && stat != 0) {
+    if (gt_bitinstream_get_next_bit(instream, &bit) != 1) {
       gt_error_set(err, "could not get next bit");
       had_err = -1;
     }
-    else if (bit)
-      *bitseq = *bitseq | (GtBitsequence) 1;
+    else {
+      stat = gt_huffman_bitwise_decoder_next(huff_bitwise_decoder, bit,
+                                             symbol, err);
+      if (stat == -1) {
+        had_err = -1;
+        gt_assert(gt_error_is_set(err));
+      }
+    }
   }
+  gt_huffman_bitwise_decoder_delete(huff_bitwise_decoder);
   return had_err;
 }
 
 static int encdesc_next_desc(GtEncdesc *encdesc, GtStr *desc, GtError *err)
 {
-  int stat, had_err = 0;
-  bool bit,
-       sampled = false;
+  int had_err = 0;
+  bool sampled = false;
   GtWord tmp = 0;
   GtUword cur_field_num,
           fieldlen = 0,
@@ -1202,7 +1229,6 @@ static int encdesc_next_desc(GtEncdesc *encdesc, GtStr *desc, GtError *err)
           zero_count = 0,
           tmp_symbol = 0;
   GtBitsequence bitseq;
-  GtHuffmanBitwiseDecoder *huff_bitwise_decoder;
 
   if (encdesc->cur_desc == encdesc->num_of_descs) {
     gt_error_set(err,"nothing done, eof?");
@@ -1227,6 +1253,11 @@ static int encdesc_next_desc(GtEncdesc *encdesc, GtStr *desc, GtError *err)
 
   if (had_err)
     gt_error_set(err, "sampling did not work, input data corrupt?");
+  /* gt_encdesc_decode() might have moved the decoder to a sample */
+  else if (encdesc->sampling != NULL &&
+           encdesc->cur_desc ==
+             gt_sampling_get_current_elementnum(encdesc->sampling))
+    sampled = true;
 
   if (desc != NULL)
     gt_str_reset(desc);
@@ -1254,24 +1285,9 @@ static int encdesc_next_desc(GtEncdesc *encdesc, GtStr *desc, GtError *err)
     }
     if (cur_field->is_numeric) {
       if (cur_field->has_zero_padding && !cur_field->fieldlen_is_const) {
-        huff_bitwise_decoder = gt_huffman_bitwise_decoder_new(
-                                            cur_field->huffman_zero_count, err);
-        stat = -1;
-        while (!had_err && stat != 0) {
-          if (gt_bitinstream_get_next_bit(encdesc->bitinstream, &bit) != 1) {
-            gt_error_set(err, "could not get next bit");
-            had_err = -1;
-          }
-          else {
-            stat = gt_huffman_bitwise_decoder_next(huff_bitwise_decoder, bit,
-                                                   &zero_count, err);
-            if (stat == -1) {
-              had_err = -1;
-              gt_assert(gt_error_is_set(err));
-            }
-          }
-        }
-        gt_huffman_bitwise_decoder_delete(huff_bitwise_decoder);
+        had_err = encdesc_read_huffman(encdesc->bitinstream,
+                                       cur_field->huffman_zero_count,
+                                       &zero_count, err);
         for (idx = 0;
              !had_err && desc != NULL && idx < zero_count;
              idx++)
@@ -1290,27 +1306,10 @@ static int encdesc_next_desc(GtEncdesc *encdesc, GtStr *desc, GtError *err)
         if (!cur_field->is_value_const || !cur_field->is_delta_const) {
           if (cur_field->bits_per_num) {
             if (cur_field->use_hc) {
-              huff_bitwise_decoder =
-                gt_huffman_bitwise_decoder_new(cur_field->huffman_num, err);
-              stat = 1;
-              while (!had_err && stat != 0) {
-                if (gt_bitinstream_get_next_bit(encdesc->bitinstream,
-                                                &bit) != 1) {
-                  gt_error_set(err, "could not get next bit");
-                  had_err = -1;
-                }
-                else {
-                  stat = gt_huffman_bitwise_decoder_next(huff_bitwise_decoder,
-                                                         bit, &tmp_symbol, err);
-                  if (stat == -1) {
-                    had_err = -1;
-                    gt_assert(gt_error_is_set(err));
-                  }
-                  else
-                    tmp = (GtWord) tmp_symbol;
-                }
-              }
-              gt_huffman_bitwise_decoder_delete(huff_bitwise_decoder);
+              had_err = encdesc_read_huffman(encdesc->bitinstream,
+                                             cur_field->huffman_num,
+                                             &tmp_symbol, err);
+              tmp = (GtWord) tmp_symbol;
             }
             else {
               had_err = encdesc_read_bits(encdesc->bitinstream,
@@ -1373,30 +1372,14 @@ static int encdesc_next_desc(GtEncdesc *encdesc, GtStr *desc, GtError *err)
           gt_str_append_char(desc, cur_field->data[idx]);
       }
       else {
-        huff_bitwise_decoder = gt_huffman_bitwise_decoder_new(
-                                            cur_field->huffman_chars[idx], err);
-        stat = -1;
-        while (!had_err && stat != 0) {
-          if (gt_bitinstream_get_next_bit(encdesc->bitinstream, &bit) != 1) {
-            gt_error_set(err, "could not get next bit");
-            had_err = -1;
-          }
-          else {
-            stat = gt_huffman_bitwise_decoder_next(huff_bitwise_decoder,
-                                                   bit, &tmp_symbol, err);
-            if (stat == -1) {
-              gt_assert(gt_error_is_set(err));
-              had_err = stat;
-            }
-            else
-              tmp = (GtWord) tmp_symbol;
-          }
-        }
+        had_err = encdesc_read_huffman(encdesc->bitinstream,
+                                       cur_field->huffman_chars[idx],
+                                       &tmp_symbol, err);
+        tmp = (GtWord) tmp_symbol;
         if (!had_err && desc != NULL) {
           gt_assert(tmp < 256L);
           gt_str_append_char(desc, (char) tmp);
         }
-        gt_huffman_bitwise_decoder_delete(huff_bitwise_decoder);
       }
     }
     if (!had_err && desc != NULL)
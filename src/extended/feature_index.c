@@ -40,6 +40,7 @@ struct GtFeatureIndexClass {
   GtFeatureIndexRemoveNodeFunc remove_node;
   GtFeatureIndexGetFeatsForSeqidFunc get_features_for_seqid;
   GtFeatureIndexGetFeatsForRangeFunc get_features_for_range;
+  GtFeatureIndexGetFeatsForRangesFunc get_features_for_ranges;
   GtFeatureIndexGetFirstSeqidFunc get_first_seqid;
   GtFeatureIndexSaveFunc save_func;
   GtFeatureIndexGetSeqidsFunc get_seqids;
@@ -51,6 +52,7 @@ struct GtFeatureIndexClass {
 
 struct GtFeatureIndexMembers {
   unsigned int reference_count;
+  GtUword generation;
   GtRWLock *lock;
 };
 
@@ -97,6 +99,17 @@ const GtFeatureIndexClass* gt_feature_index_class_new(size_t size,
   return c_class;
 }
 
+void gt_feature_index_class_set_get_features_for_ranges_func(
+                                         const GtFeatureIndexClass *fic,
+                                         GtFeatureIndexGetFeatsForRangesFunc
+                                                 get_features_for_ranges)
+{
+  gt_assert(fic);
+  /* classes are allocated by gt_feature_index_class_new() */
+  ((GtFeatureIndexClass*) fic)->get_features_for_ranges =
+                                                        get_features_for_ranges;
+}
+
 GtFeatureIndex* gt_feature_index_create(const GtFeatureIndexClass *fic)
 {
   GtFeatureIndex *fi;
@@ -144,6 +157,7 @@ int  gt_feature_index_add_region_node(GtFeatureIndex *feature_index,
   gt_rwlock_wrlock(feature_index->pvt->lock);
   ret = feature_index->c_class->add_region_node(feature_index, region_node,
                                                 err);
+  feature_index->pvt->generation++;
   gt_rwlock_unlock(feature_index->pvt->lock);
   return ret;
 }
@@ -157,6 +171,7 @@ int  gt_feature_index_add_feature_node(GtFeatureIndex *feature_index,
   gt_rwlock_wrlock(feature_index->pvt->lock);
   ret = feature_index->c_class->add_feature_node(feature_index, feature_node,
                                                  err);
+  feature_index->pvt->generation++;
   gt_rwlock_unlock(feature_index->pvt->lock);
   return ret;
 }
@@ -168,6 +183,7 @@ int  gt_feature_index_remove_node(GtFeatureIndex *feature_index,
   gt_assert(feature_index && feature_index->c_class && node);
   gt_rwlock_wrlock(feature_index->pvt->lock);
   ret = feature_index->c_class->remove_node(feature_index, node, err);
+  feature_index->pvt->generation++;
   gt_rwlock_unlock(feature_index->pvt->lock);
   return ret;
 }
@@ -231,6 +247,69 @@ int gt_feature_index_get_features_for_range(GtFeatureIndex *feature_index,
   return ret;
 }
 
+/* used for classes without a batch query method */
+static int feature_index_get_features_for_ranges_single(GtFeatureIndex *fi,
+                                                        const char *seqid,
+                                                        const GtRange *ranges,
+                                                        GtUword num_of_ranges,
+                                                       GtFeatureIndexRangesFunc
+                                                        func,
+                                                        void *data,
+                                                        GtError *err)
+{
+  GtArray *results;
+  GtUword i, j;
+  int had_err = 0;
+  results = gt_array_new(sizeof (GtFeatureNode*));
+  for (i = 0; !had_err && i < num_of_ranges; i++) {
+    gt_array_reset(results);
+    had_err = fi->c_class->get_features_for_range(fi, results, seqid,
+                                                  ranges + i, err);
+    for (j = 0; !had_err && j < gt_array_size(results); j++) {
+      had_err = func(i, *(GtFeatureNode**) gt_array_get(results, j), data,
+                     err);
+    }
+  }
+  gt_array_delete(results);
+  return had_err;
+}
+
+int gt_feature_index_get_features_for_ranges(GtFeatureIndex *feature_index,
+                                             const char *seqid,
+                                             const GtRange *ranges,
+                                             GtUword num_of_ranges,
+                                             GtFeatureIndexRangesFunc func,
+                                             void *data, GtError *err)
+{
+  int ret;
+  gt_error_check(err);
+  gt_assert(feature_index && feature_index->c_class && seqid && func);
+  gt_assert(ranges || !num_of_ranges);
+#ifndef NDEBUG
+  {
+    GtUword i;
+    for (i = 0; i < num_of_ranges; i++) {
+      gt_assert(gt_range_length(ranges + i) > 0);
+      gt_assert(i == 0 || ranges[i-1].start <= ranges[i].start);
+    }
+  }
+#endif
+  gt_rwlock_rdlock(feature_index->pvt->lock);
+  if (feature_index->c_class->get_features_for_ranges) {
+    ret = feature_index->c_class->get_features_for_ranges(feature_index, seqid,
+                                                          ranges,
+                                                          num_of_ranges, func,
+                                                          data, err);
+  }
+  else {
+    ret = feature_index_get_features_for_ranges_single(feature_index, seqid,
+                                                       ranges, num_of_ranges,
+                                                       func, data, err);
+  }
+  gt_rwlock_unlock(feature_index->pvt->lock);
+  return ret;
+}
+
 char* gt_feature_index_get_first_seqid(const GtFeatureIndex
                                              *feature_index,
                                               GtError *err)
@@ -307,6 +386,16 @@ int  gt_feature_index_has_seqid(const GtFeatureIndex *feature_index,
   return ret;
 }
 
+GtUword gt_feature_index_get_generation(const GtFeatureIndex *feature_index)
+{
+  GtUword generation;
+  gt_assert(feature_index);
+  gt_rwlock_rdlock(feature_index->pvt->lock);
+  generation = feature_index->pvt->generation;
+  gt_rwlock_unlock(feature_index->pvt->lock);
+  return generation;
+}
+
 void* gt_feature_index_cast(GT_UNUSED const GtFeatureIndexClass *fic,
                             GtFeatureIndex *fi)
 {
@@ -424,6 +513,30 @@ static void* gt_feature_index_unit_test_query(void *data)
   return NULL;
 }
 
+#define GT_FI_TEST_TILE_WIDTH 100000
+
+static int gt_feature_index_unit_test_ranges(GtUword range_num,
+                                             GtFeatureNode *fn, void *data,
+                                             GT_UNUSED GtError *err)
+{
+  GtArray **results = (GtArray**) data;
+  gt_array_add(results[range_num], fn);
+  return 0;
+}
+
+/* fails on the second feature */
+static int gt_feature_index_unit_test_ranges_fail(GT_UNUSED GtUword range_num,
+                                                  GT_UNUSED GtFeatureNode *fn,
+                                                  void *data, GtError *err)
+{
+  GtUword *count = (GtUword*) data;
+  if (++*count == 2UL) {
+    gt_error_set(err, "second feature");
+    return -1;
+  }
+  return 0;
+}
+
 /* to be called from implementing class! */
 int gt_feature_index_unit_test(GtFeatureIndex *fi, GtError *err)
 {
@@ -490,6 +603,60 @@ int gt_feature_index_unit_test(GtFeatureIndex *fi, GtError *err)
     gt_multithread(gt_feature_index_unit_test_query, &sh, err);
   gt_ensure(sh.error_count == 0);
 
+  /* test batch query over tiles covering the region */
+  if (!had_err) {
+    GtUword j, num_of_tiles = (GT_FI_TEST_END - GT_FI_TEST_START + 1)
+                              / GT_FI_TEST_TILE_WIDTH;
+    GtRange *tiles = gt_malloc(sizeof (GtRange) * num_of_tiles);
+    GtArray **results = gt_malloc(sizeof (GtArray*) * num_of_tiles),
+            *arr = gt_array_new(sizeof (GtFeatureNode*));
+    for (j = 0; j < num_of_tiles; j++) {
+      tiles[j].start = GT_FI_TEST_START + j * GT_FI_TEST_TILE_WIDTH;
+      tiles[j].end = tiles[j].start + GT_FI_TEST_TILE_WIDTH - 1;
+      results[j] = gt_array_new(sizeof (GtFeatureNode*));
+    }
+    gt_ensure(gt_feature_index_get_features_for_ranges(fi, GT_FI_TEST_SEQID,
+                                                       tiles, num_of_tiles,
+                                             gt_feature_index_unit_test_ranges,
+                                                       results, err) == 0);
+    for (j = 0; !had_err && j < num_of_tiles; j++) {
+      GtUword k;
+      gt_array_reset(arr);
+      gt_ensure(gt_feature_index_get_features_for_range(fi, arr,
+                                                        GT_FI_TEST_SEQID,
+                                                        tiles + j, err) == 0);
+      gt_ensure(gt_array_size(arr) == gt_array_size(results[j]));
+      for (k = 0; !had_err && k < gt_array_size(results[j]); k++) {
+        GtGenomeNode *gn = *(GtGenomeNode**) gt_array_get(results[j], k);
+        GtRange rng = gt_genome_node_get_range(gn);
+        gt_ensure(gt_range_overlap(&rng, tiles + j));
+        if (k > 0) {
+          GtGenomeNode *prev = *(GtGenomeNode**) gt_array_get(results[j],
+                                                              k - 1);
+          gt_ensure(gt_genome_node_get_start(prev) <= rng.start);
+        }
+      }
+    }
+    if (!had_err) {
+      /* the batch query stops at the first error */
+      GtError *testerr = gt_error_new();
+      GtUword count = 0;
+      gt_ensure(gt_feature_index_get_features_for_ranges(fi, GT_FI_TEST_SEQID,
+                                                         tiles, num_of_tiles,
+                                        gt_feature_index_unit_test_ranges_fail,
+                                                         &count,
+                                                         testerr) == -1);
+      gt_ensure(count == 2UL);
+      gt_ensure(strcmp(gt_error_get(testerr), "second feature") == 0);
+      gt_error_delete(testerr);
+    }
+    for (j = 0; j < num_of_tiles; j++)
+      gt_array_delete(results[j]);
+    gt_free(results);
+    gt_free(tiles);
+    gt_array_delete(arr);
+  }
+
   gt_mutex_delete(sh.mutex);
   gt_error_delete(sh.err);
   gt_str_array_delete(seqids);
@@ -24,6 +24,10 @@ typedef struct GtFeatureIndexClass GtFeatureIndexClass;
 #include "extended/feature_index_api.h"
 
 GtFeatureIndex* gt_feature_index_ref(GtFeatureIndex*);
+/* Returns a counter which is increased whenever nodes are added to or removed
+   from <feature_index>, so that results derived from it can be invalidated. */
+GtUword         gt_feature_index_get_generation(const GtFeatureIndex
+                                                *feature_index);
 int             gt_feature_index_unit_test(GtFeatureIndex *fi, GtError *err);
 int             gt_feature_index_mt_unit_test(GtFeatureIndex *fi, GtError *err);
 
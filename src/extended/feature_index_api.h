@@ -34,6 +34,14 @@
    be sorted by feature start position. */
 typedef struct GtFeatureIndex GtFeatureIndex;
 
+/* Callback function for <gt_feature_index_get_features_for_ranges()>, called
+   with the position <range_num> of a query range in the list of query ranges
+   and a <feature_node> overlapping it. <data> is passed through. Returning a
+   non-zero value stops the lookup, <err> should be set in this case. */
+typedef int (*GtFeatureIndexRangesFunc)(GtUword range_num,
+                                        GtFeatureNode *feature_node,
+                                        void *data, GtError *err);
+
 /* Add <region_node> to <feature_index>. */
 int         gt_feature_index_add_region_node(GtFeatureIndex *feature_index,
                                              GtRegionNode *region_node,
@@ -64,6 +72,26 @@ int         gt_feature_index_get_features_for_range(GtFeatureIndex
                                                     const char *seqid,
                                                     const GtRange *range,
                                                     GtError*);
+/* Look up genome features in <feature_index> for sequence region <seqid> in
+   each of the <num_of_ranges> ranges in <ranges>, which must be sorted by start
+   position, and call <func> with <data> for every pair of range and
+   overlapping feature. Ranges are processed in order, features for a range
+   are reported sorted by start position. Implementations answer all ranges in
+   a single sweep over the features of <seqid> where possible, so that tiling
+   a whole sequence takes time linear in the number of features and ranges.
+   Whether the reported features belong to <feature_index> is the same as for
+   <gt_feature_index_get_features_for_range()>.
+   Returns 0 on success, or the non-zero value returned by <func> or -1 and
+   sets <err> otherwise. */
+int         gt_feature_index_get_features_for_ranges(GtFeatureIndex
+                                                     *feature_index,
+                                                     const char *seqid,
+                                                     const GtRange *ranges,
+                                                     GtUword num_of_ranges,
+                                                     GtFeatureIndexRangesFunc
+                                                     func,
+                                                     void *data,
+                                                     GtError *err);
 /* Returns the first sequence region identifier added to <feature_index>. */
 char*       gt_feature_index_get_first_seqid(const GtFeatureIndex
                                              *feature_index,
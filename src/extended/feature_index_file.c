@@ -0,0 +1,1030 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "core/array_api.h"
+#include "core/class_alloc_lock.h"
+#include "core/compat_api.h"
+#include "core/cstr_api.h"
+#include "core/cstr_table.h"
+#include "core/ensure_api.h"
+#include "core/fa_api.h"
+#include "core/file_api.h"
+#include "core/fileutils_api.h"
+#include "core/hashmap_api.h"
+#include "core/ma_api.h"
+#include "core/minmax_api.h"
+#include "core/queue_api.h"
+#include "core/str_api.h"
+#include "core/thread_api.h"
+#include "core/unused_api.h"
+#include "core/xansi_api.h"
+#include "extended/feature_index_file.h"
+#include "extended/feature_index_memory_api.h"
+#include "extended/feature_index_rep.h"
+#include "extended/feature_node.h"
+#include "extended/feature_node_iterator_api.h"
+#include "extended/genome_node.h"
+#include "extended/gff3_defines.h"
+#include "extended/gff3_parser.h"
+#include "extended/gff3_visitor.h"
+#include "extended/meta_node_api.h"
+
+#define GT_FEATURE_INDEX_FILE_MAGIC       "GTFIDX\0\3"
+#define GT_FEATURE_INDEX_FILE_MAGIC_LEN   8
+/* subtrees of at most this height are scanned linearly during a query */
+#define GT_FEATURE_INDEX_FILE_SCAN_LEVEL  3
+/* two stack entries per level of the implicit interval tree */
+#define GT_FEATURE_INDEX_FILE_STACK_SIZE  128
+
+/* The file consists of a header, the table of sequence regions sorted by
+   seqid, the feature table and a text section holding the seqids and the
+   GFF3 representation of each top-level feature. All tables consist of
+   64-bit words, so they can be accessed directly in the mapped file. */
+typedef struct {
+  char magic[GT_FEATURE_INDEX_FILE_MAGIC_LEN];
+  GtUint64 num_of_seqs,
+           first_seq,
+           num_of_features,
+           seqs_offset,
+           features_offset,
+           text_offset,
+           text_length;
+} GtFeatureIndexFileHeader;
+
+typedef struct {
+  GtUint64 seqid_offset,
+           seqid_length,
+           first_feature,
+           num_of_features,
+           max_level,
+           range_start,
+           range_end,
+           orig_start,
+           orig_end,
+           has_orig_range;
+} GtFeatureIndexFileSeq;
+
+/* Features of a sequence region are sorted by start position. <max_end> is
+   the maximum end position in the subtree of the implicit interval tree
+   rooted at this feature (see Li, cgranges), so that queries run directly on
+   the mapped file. */
+typedef struct {
+  GtUint64 start,
+           end,
+           max_end,
+           text_offset,
+           text_length;
+} GtFeatureIndexFileFeature;
+
+struct GtFeatureIndexFile {
+  const GtFeatureIndex parent_instance;
+  GtStr *filename;
+  /* building */
+  GtFeatureIndex *memory;
+  GtArray *added; /* feature nodes in the order they were added */
+  /* querying */
+  void *map;
+  size_t map_length;
+  const GtFeatureIndexFileHeader *header;
+  const GtFeatureIndexFileSeq *seqs;
+  const GtFeatureIndexFileFeature *features;
+  const char *text;
+  GtFeatureNode **nodes; /* materialized feature trees */
+  GtMutex *mutex; /* protects <nodes> */
+};
+
+#define gt_feature_index_file_cast(FI)\
+        gt_feature_index_cast(gt_feature_index_file_class(), FI)
+
+static int feature_index_file_read_only(const GtFeatureIndexFile *fif,
+                                        GtError *err)
+{
+  gt_error_set(err, "feature index file \"%s\" cannot be modified",
+               gt_str_get(fif->filename));
+  return -1;
+}
+
+static const GtFeatureIndexFileSeq*
+feature_index_file_find_seq(const GtFeatureIndexFile *fif, const char *seqid)
+{
+  GtUword left = 0, right = (GtUword) fif->header->num_of_seqs;
+  size_t len = strlen(seqid);
+  while (left < right) {
+    GtUword mid = left + (right - left) / 2;
+    const GtFeatureIndexFileSeq *seq = fif->seqs + mid;
+    int cmp = strncmp(fif->text + seq->seqid_offset, seqid,
+                      GT_MIN((size_t) seq->seqid_length, len));
+    if (cmp == 0)
+      cmp = seq->seqid_length < len ? -1 : (seq->seqid_length > len ? 1 : 0);
+    if (cmp == 0)
+      return seq;
+    if (cmp < 0)
+      left = mid + 1;
+    else
+      right = mid;
+  }
+  return NULL;
+}
+
+/* augments the sorted <features> to an implicit interval tree and returns
+   its height */
+static GtUint64 feature_index_file_index_features(GtFeatureIndexFileFeature
+                                                                     *features,
+                                                  GtUint64 n)
+{
+  GtUint64 i, k, last_i = 0, last = 0;
+  if (n == 0)
+    return 0;
+  for (i = 0; i < n; i += 2) {
+    last_i = i;
+    last = features[i].max_end = features[i].end;
+  }
+  for (k = 1; (1ULL << k) <= n; k++) {
+    GtUint64 x = 1ULL << (k - 1), step = x << 2;
+    for (i = (x << 1) - 1; i < n; i += step) {
+      GtUint64 end = features[i].end,
+               left_end = features[i - x].max_end,
+               right_end = i + x < n ? features[i + x].max_end : last;
+      end = GT_MAX(end, left_end);
+      features[i].max_end = GT_MAX(end, right_end);
+    }
+    last_i = (last_i >> k & 1) ? last_i - x : last_i + x;
+    if (last_i < n && features[last_i].max_end > last)
+      last = features[last_i].max_end;
+  }
+  return k - 1;
+}
+
+/* Called with the number <idx> of each feature overlapping a query. A
+   non-zero return value stops the query. */
+typedef int (*FeatureIndexFileOverlapFunc)(GtUword idx, void *info);
+
+/* Calls <func> for all features of <seq> overlapping the range from <qstart>
+   to <qend>, in the order of their start positions. The implicit interval
+   tree is traversed in order in the mapped file. Returns the first non-zero
+   return value of <func>, or 0. */
+static int feature_index_file_iterate_overlapping(const GtFeatureIndexFile
+                                                  *fif,
+                                                  const GtFeatureIndexFileSeq
+                                                  *seq,
+                                                  GtUint64 qstart,
+                                                  GtUint64 qend,
+                                                  FeatureIndexFileOverlapFunc
+                                                  func,
+                                                  void *info)
+{
+  struct {
+    GtUint64 x, k;
+    bool visited;
+  } stack[GT_FEATURE_INDEX_FILE_STACK_SIZE];
+  const GtFeatureIndexFileFeature *a = fif->features + seq->first_feature;
+  GtUint64 n = seq->num_of_features;
+  int t = 0, rval = 0;
+
+  if (n == 0)
+    return 0;
+  stack[t].k = seq->max_level;
+  stack[t].x = (1ULL << seq->max_level) - 1;
+  stack[t++].visited = false;
+  while (!rval && t > 0) {
+    GtUint64 x, k;
+    bool visited;
+    t--;
+    x = stack[t].x;
+    k = stack[t].k;
+    visited = stack[t].visited;
+    if (k <= GT_FEATURE_INDEX_FILE_SCAN_LEVEL) {
+      GtUint64 i, i0 = x >> k << k, i1 = i0 + (1ULL << (k + 1)) - 1;
+      if (i1 > n)
+        i1 = n;
+      for (i = i0; !rval && i < i1 && a[i].start <= qend; i++) {
+        if (qstart <= a[i].end)
+          rval = func((GtUword) (seq->first_feature + i), info);
+      }
+    }
+    else if (!visited) {
+      GtUint64 left = x - (1ULL << (k - 1));
+      stack[t].x = x;
+      stack[t].k = k;
+      stack[t++].visited = true;
+      if (left >= n || a[left].max_end >= qstart) {
+        stack[t].x = left;
+        stack[t].k = k - 1;
+        stack[t++].visited = false;
+      }
+    }
+    else if (x < n && a[x].start <= qend) {
+      if (qstart <= a[x].end)
+        rval = func((GtUword) (seq->first_feature + x), info);
+      stack[t].x = x + (1ULL << (k - 1));
+      stack[t].k = k - 1;
+      stack[t++].visited = false;
+    }
+  }
+  return rval;
+}
+
+/* Returns the tree of feature <idx>, parsing it on first use. Each call
+   parses with its own parser outside of the lock, so that concurrent lookups
+   of different features do not wait for each other. The lock is held only to
+   look up and to install a tree in the cache; if two threads parse the same
+   feature, the tree of the first one is kept. */
+static GtFeatureNode* feature_index_file_materialize(GtFeatureIndexFile *fif,
+                                                     GtUword idx,
+                                                     GtError *err)
+{
+  const GtFeatureIndexFileFeature *feature = fif->features + idx;
+  GtFeatureNode *fn = NULL;
+  GtGFF3Parser *parser;
+  GtCstrTable *used_types;
+  GtQueue *nodes;
+  GtUint64 line_number = 0;
+  GtStr *text;
+  GtFile *fpin;
+  FILE *memfp;
+  int had_err = 0, status_code = 0;
+
+  gt_mutex_lock(fif->mutex);
+  fn = fif->nodes[idx];
+  gt_mutex_unlock(fif->mutex);
+  if (fn)
+    return fn;
+  text = gt_str_new_cstr(GT_GFF_VERSION_PREFIX" "GT_GFF_VERSION_STRING"\n");
+  gt_str_append_cstr_nt(text, fif->text + feature->text_offset,
+                        (GtUword) feature->text_length);
+  if (!(memfp = gt_fmemopen_read(gt_str_get_mem(text),
+                                 (size_t) gt_str_length(text)))) {
+    gt_error_set(err, "cannot read feature from index file \"%s\"",
+                 gt_str_get(fif->filename));
+    gt_str_delete(text);
+    return NULL;
+  }
+  fpin = gt_file_new_from_fileptr(memfp);
+  nodes = gt_queue_new();
+  parser = gt_gff3_parser_new(NULL);
+  used_types = gt_cstr_table_new();
+  while (!had_err && status_code != EOF) {
+    had_err = gt_gff3_parser_parse_genome_nodes(parser, &status_code, nodes,
+                                                used_types, fif->filename,
+                                                &line_number, fpin, err);
+    while (gt_queue_size(nodes)) {
+      GtGenomeNode *gn = gt_queue_get(nodes);
+      if (!had_err && !fn && gt_feature_node_try_cast(gn))
+        fn = (GtFeatureNode*) gn;
+      else
+        gt_genome_node_delete(gn);
+    }
+  }
+  gt_cstr_table_delete(used_types);
+  gt_gff3_parser_delete(parser);
+  gt_queue_delete(nodes);
+  gt_file_delete_without_handle(fpin);
+  (void) fclose(memfp);
+  gt_str_delete(text);
+  if (!had_err && !fn) {
+    gt_error_set(err, "corrupt feature in index file \"%s\"",
+                 gt_str_get(fif->filename));
+    had_err = -1;
+  }
+  if (had_err) {
+    gt_genome_node_delete((GtGenomeNode*) fn);
+    return NULL;
+  }
+  gt_mutex_lock(fif->mutex);
+  if (fif->nodes[idx]) {
+    gt_genome_node_delete((GtGenomeNode*) fn);
+    fn = fif->nodes[idx];
+  }
+  else
+    fif->nodes[idx] = fn;
+  gt_mutex_unlock(fif->mutex);
+  return fn;
+}
+
+int gt_feature_index_file_add_region_node(GtFeatureIndex *gfi,
+                                          GtRegionNode *rn, GtError *err)
+{
+  GtFeatureIndexFile *fif = gt_feature_index_file_cast(gfi);
+  if (!fif->memory)
+    return feature_index_file_read_only(fif, err);
+  return gt_feature_index_add_region_node(fif->memory, rn, err);
+}
+
+int gt_feature_index_file_add_feature_node(GtFeatureIndex *gfi,
+                                           GtFeatureNode *fn, GtError *err)
+{
+  GtFeatureIndexFile *fif = gt_feature_index_file_cast(gfi);
+  if (!fif->memory)
+    return feature_index_file_read_only(fif, err);
+  if (gt_feature_index_add_feature_node(fif->memory, fn, err))
+    return -1;
+  gt_array_add(fif->added, fn);
+  gt_genome_node_ref((GtGenomeNode*) fn);
+  return 0;
+}
+
+int gt_feature_index_file_remove_node(GtFeatureIndex *gfi, GtFeatureNode *fn,
+                                      GtError *err)
+{
+  GtFeatureIndexFile *fif = gt_feature_index_file_cast(gfi);
+  GtUword i;
+  if (!fif->memory)
+    return feature_index_file_read_only(fif, err);
+  for (i = 0; i < gt_array_size(fif->added); i++) {
+    if (*(GtFeatureNode**) gt_array_get(fif->added, i) == fn) {
+      gt_array_rem(fif->added, i);
+      gt_genome_node_delete((GtGenomeNode*) fn);
+      break;
+    }
+  }
+  return gt_feature_index_remove_node(fif->memory, fn, err);
+}
+
+GtArray* gt_feature_index_file_get_features_for_seqid(GtFeatureIndex *gfi,
+                                                      const char *seqid,
+                                                      GtError *err)
+{
+  GtFeatureIndexFile *fif = gt_feature_index_file_cast(gfi);
+  const GtFeatureIndexFileSeq *seq;
+  GtArray *a;
+  GtUword i;
+  gt_assert(seqid);
+  if (fif->memory)
+    return gt_feature_index_get_features_for_seqid(fif->memory, seqid, err);
+  a = gt_array_new(sizeof (GtFeatureNode*));
+  if ((seq = feature_index_file_find_seq(fif, seqid))) {
+    for (i = 0; i < seq->num_of_features; i++) {
+      GtFeatureNode *fn;
+      if (!(fn = feature_index_file_materialize(fif,
+                                                seq->first_feature + i, err))) {
+        gt_array_delete(a);
+        return NULL;
+      }
+      gt_array_add(a, fn);
+    }
+  }
+  return a;
+}
+
+typedef struct {
+  GtFeatureIndexFile *fif;
+  GtArray *results;
+  GtError *err;
+} FeatureIndexFileCollectInfo;
+
+static int feature_index_file_collect(GtUword idx, void *info)
+{
+  FeatureIndexFileCollectInfo *ci = (FeatureIndexFileCollectInfo*) info;
+  GtFeatureNode *fn;
+  if (!(fn = feature_index_file_materialize(ci->fif, idx, ci->err)))
+    return -1;
+  gt_array_add(ci->results, fn);
+  return 0;
+}
+
+int gt_feature_index_file_get_features_for_range(GtFeatureIndex *gfi,
+                                                 GtArray *results,
+                                                 const char *seqid,
+                                                 const GtRange *qry_range,
+                                                 GtError *err)
+{
+  GtFeatureIndexFile *fif = gt_feature_index_file_cast(gfi);
+  const GtFeatureIndexFileSeq *seq;
+  FeatureIndexFileCollectInfo info;
+  gt_error_check(err);
+  gt_assert(results && seqid && qry_range);
+
+  if (fif->memory) {
+    return gt_feature_index_get_features_for_range(fif->memory, results,
+                                                   seqid, qry_range, err);
+  }
+  if (!(seq = feature_index_file_find_seq(fif, seqid))) {
+    gt_error_set(err, "feature index does not contain the given sequence id");
+    return -1;
+  }
+  info.fif = fif;
+  info.results = results;
+  info.err = err;
+  return feature_index_file_iterate_overlapping(fif, seq,
+                                                (GtUint64) qry_range->start,
+                                                (GtUint64) qry_range->end,
+                                                feature_index_file_collect,
+                                                &info);
+}
+
+typedef struct {
+  GtFeatureIndexFile *fif;
+  GtFeatureIndexRangesFunc func;
+  GtUword query_num;
+  void *data;
+  GtError *err;
+} FeatureIndexFileRangesInfo;
+
+static int feature_index_file_report_range(GtUword idx, void *info)
+{
+  FeatureIndexFileRangesInfo *ri = (FeatureIndexFileRangesInfo*) info;
+  GtFeatureNode *fn;
+  if (!(fn = feature_index_file_materialize(ri->fif, idx, ri->err)))
+    return -1;
+  return ri->func(ri->query_num, fn, ri->data, ri->err);
+}
+
+static int feature_index_file_get_features_for_ranges(GtFeatureIndex *gfi,
+                                                      const char *seqid,
+                                                      const GtRange *ranges,
+                                                      GtUword num_of_ranges,
+                                                      GtFeatureIndexRangesFunc
+                                                      func,
+                                                      void *data,
+                                                      GtError *err)
+{
+  GtFeatureIndexFile *fif = gt_feature_index_file_cast(gfi);
+  const GtFeatureIndexFileSeq *seq;
+  FeatureIndexFileRangesInfo info;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(seqid && func);
+
+  if (fif->memory) {
+    return gt_feature_index_get_features_for_ranges(fif->memory, seqid, ranges,
+                                                    num_of_ranges, func, data,
+                                                    err);
+  }
+  if (!(seq = feature_index_file_find_seq(fif, seqid))) {
+    gt_error_set(err, "feature index does not contain the given sequence id");
+    return -1;
+  }
+  info.fif = fif;
+  info.func = func;
+  info.data = data;
+  info.err = err;
+  for (info.query_num = 0; !had_err && info.query_num < num_of_ranges;
+       info.query_num++) {
+    had_err = feature_index_file_iterate_overlapping(fif, seq,
+                                           (GtUint64) ranges[info.query_num]
+                                                                       .start,
+                                           (GtUint64) ranges[info.query_num]
+                                                                         .end,
+                                           feature_index_file_report_range,
+                                           &info);
+  }
+  return had_err;
+}
+
+char* gt_feature_index_file_get_first_seqid(const GtFeatureIndex *gfi,
+                                            GtError *err)
+{
+  GtFeatureIndexFile *fif = gt_feature_index_file_cast((GtFeatureIndex*) gfi);
+  const GtFeatureIndexFileSeq *seq;
+  if (fif->memory)
+    return gt_feature_index_get_first_seqid(fif->memory, err);
+  if (fif->header->num_of_seqs == 0) {
+    gt_error_set(err, "no sequence regions in index");
+    return NULL;
+  }
+  seq = fif->seqs + fif->header->first_seq;
+  return gt_cstr_dup_nt(fif->text + seq->seqid_offset,
+                        (GtUword) seq->seqid_length);
+}
+
+GtStrArray* gt_feature_index_file_get_seqids(const GtFeatureIndex *gfi,
+                                             GtError *err)
+{
+  GtFeatureIndexFile *fif = gt_feature_index_file_cast((GtFeatureIndex*) gfi);
+  GtStrArray *seqids;
+  GtUword i;
+  if (fif->memory)
+    return gt_feature_index_get_seqids(fif->memory, err);
+  seqids = gt_str_array_new();
+  for (i = 0; i < fif->header->num_of_seqs; i++) {
+    gt_str_array_add_cstr_nt(seqids, fif->text + fif->seqs[i].seqid_offset,
+                             (GtUword) fif->seqs[i].seqid_length);
+  }
+  return seqids;
+}
+
+int gt_feature_index_file_get_range_for_seqid(GtFeatureIndex *gfi,
+                                              GtRange *range,
+                                              const char *seqid,
+                                              GtError *err)
+{
+  GtFeatureIndexFile *fif = gt_feature_index_file_cast(gfi);
+  const GtFeatureIndexFileSeq *seq;
+  gt_assert(range && seqid);
+  if (fif->memory)
+    return gt_feature_index_get_range_for_seqid(fif->memory, range, seqid, err);
+  if (!(seq = feature_index_file_find_seq(fif, seqid))) {
+    gt_error_set(err, "feature index does not contain the given sequence id");
+    return -1;
+  }
+  range->start = (GtUword) seq->range_start;
+  range->end = (GtUword) seq->range_end;
+  return 0;
+}
+
+int gt_feature_index_file_get_orig_range_for_seqid(GtFeatureIndex *gfi,
+                                                   GtRange *range,
+                                                   const char *seqid,
+                                                   GtError *err)
+{
+  GtFeatureIndexFile *fif = gt_feature_index_file_cast(gfi);
+  const GtFeatureIndexFileSeq *seq;
+  gt_assert(range && seqid);
+  if (fif->memory) {
+    return gt_feature_index_get_orig_range_for_seqid(fif->memory, range, seqid,
+                                                     err);
+  }
+  if (!(seq = feature_index_file_find_seq(fif, seqid))) {
+    gt_error_set(err, "feature index does not contain the given sequence id");
+    return -1;
+  }
+  if (seq->has_orig_range) {
+    range->start = (GtUword) seq->orig_start;
+    range->end = (GtUword) seq->orig_end;
+  }
+  return 0;
+}
+
+int gt_feature_index_file_has_seqid(const GtFeatureIndex *gfi,
+                                    bool *has_seqid,
+                                    const char *seqid,
+                                    GtError *err)
+{
+  GtFeatureIndexFile *fif = gt_feature_index_file_cast((GtFeatureIndex*) gfi);
+  gt_assert(has_seqid && seqid);
+  if (fif->memory)
+    return gt_feature_index_has_seqid(fif->memory, has_seqid, seqid, err);
+  *has_seqid = feature_index_file_find_seq(fif, seqid) != NULL;
+  return 0;
+}
+
+static int feature_index_file_compare(const void *v1, const void *v2)
+{
+  return gt_genome_node_compare((GtGenomeNode**) v1, (GtGenomeNode**) v2);
+}
+
+int gt_feature_index_file_save(GtFeatureIndex *gfi, GtError *err)
+{
+  GtFeatureIndexFile *fif = gt_feature_index_file_cast(gfi);
+  GtFeatureIndexFileHeader header;
+  GtArray *seqs, *features, *nodes;
+  GtStrArray *seqids = NULL;
+  GtNodeVisitor *gff3_visitor;
+  GtGenomeNode *gn;
+  char *first_seqid = NULL;
+  GtStr *text;
+  GtHashmap *seqid2node;
+  GtUword i, j;
+  FILE *fp;
+  int had_err = 0;
+  gt_error_check(err);
+
+  if (!fif->memory)
+    return feature_index_file_read_only(fif, err);
+  /* sorting is stable, so features with equal ranges keep their order */
+  nodes = gt_array_clone(fif->added);
+  gt_array_sort_stable(nodes, feature_index_file_compare);
+  /* the nodes of a sequence region are contiguous, remember the first one */
+  seqid2node = gt_hashmap_new(GT_HASH_STRING, NULL, NULL);
+  for (j = gt_array_size(nodes); j > 0; j--) {
+    GtGenomeNode *node = *(GtGenomeNode**) gt_array_get(nodes, j - 1);
+    const char *seqid = gt_str_get(gt_genome_node_get_seqid(node));
+    if (gt_hashmap_get(seqid2node, seqid))
+      gt_hashmap_remove(seqid2node, seqid);
+    gt_hashmap_add(seqid2node, (void*) seqid, (void*) j);
+  }
+  seqs = gt_array_new(sizeof (GtFeatureIndexFileSeq));
+  features = gt_array_new(sizeof (GtFeatureIndexFileFeature));
+  text = gt_str_new();
+  gff3_visitor = gt_gff3_visitor_new_to_str(text);
+  gt_gff3_visitor_retain_id_attributes((GtGFF3Visitor*) gff3_visitor);
+  /* the text section starts with a GFF3 header, so that the version pragma
+     does not end up in the text of the first feature */
+  gn = gt_meta_node_new(GT_GFF_VERSION_DIRECTIVE, GT_GFF_VERSION_STRING);
+  had_err = gt_genome_node_accept(gn, gff3_visitor, err);
+  gt_genome_node_delete(gn);
+  memset(&header, 0, sizeof header);
+  memcpy(header.magic, GT_FEATURE_INDEX_FILE_MAGIC,
+         GT_FEATURE_INDEX_FILE_MAGIC_LEN);
+
+  if (!had_err && !(seqids = gt_feature_index_get_seqids(fif->memory, err)))
+    had_err = -1;
+  if (!had_err && gt_str_array_size(seqids) > 0 &&
+      !(first_seqid = gt_feature_index_get_first_seqid(fif->memory, err)))
+    had_err = -1;
+  for (i = 0; !had_err && i < gt_str_array_size(seqids); i++) {
+    const char *seqid = gt_str_array_get(seqids, i);
+    GtFeatureIndexFileSeq seq;
+    GtRange range;
+    memset(&seq, 0, sizeof seq);
+    if (strcmp(seqid, first_seqid) == 0)
+      header.first_seq = (GtUint64) i;
+    seq.seqid_offset = (GtUint64) gt_str_length(text);
+    seq.seqid_length = (GtUint64) strlen(seqid);
+    gt_str_append_cstr(text, seqid);
+    seq.first_feature = (GtUint64) gt_array_size(features);
+    for (j = (GtUword) gt_hashmap_get(seqid2node, seqid);
+         !had_err && j > 0 && j <= gt_array_size(nodes); j++) {
+      GtGenomeNode *node = *(GtGenomeNode**) gt_array_get(nodes, j - 1);
+      GtFeatureIndexFileFeature feature;
+      if (strcmp(gt_str_get(gt_genome_node_get_seqid(node)), seqid))
+        break;
+      range = gt_genome_node_get_range(node);
+      feature.start = (GtUint64) range.start;
+      feature.end = (GtUint64) range.end;
+      feature.max_end = feature.end;
+      feature.text_offset = (GtUint64) gt_str_length(text);
+      had_err = gt_genome_node_accept(node, gff3_visitor, err);
+      feature.text_length = (GtUint64) gt_str_length(text)
+                            - feature.text_offset;
+      gt_array_add(features, feature);
+    }
+    seq.num_of_features = (GtUint64) gt_array_size(features)
+                          - seq.first_feature;
+    if (!had_err && seq.num_of_features > 0) {
+      seq.max_level = feature_index_file_index_features(
+                                    gt_array_get(features, seq.first_feature),
+                                    seq.num_of_features);
+    }
+    if (!had_err) {
+      had_err = gt_feature_index_get_range_for_seqid(fif->memory, &range,
+                                                     seqid, err);
+      seq.range_start = (GtUint64) range.start;
+      seq.range_end = (GtUint64) range.end;
+    }
+    if (!had_err) {
+      range.start = range.end = 0;
+      had_err = gt_feature_index_get_orig_range_for_seqid(fif->memory, &range,
+                                                          seqid, err);
+      seq.has_orig_range = range.start > 0 ? 1 : 0;
+      seq.orig_start = (GtUint64) range.start;
+      seq.orig_end = (GtUint64) range.end;
+    }
+    gt_array_add(seqs, seq);
+  }
+
+  if (!had_err) {
+    header.num_of_seqs = (GtUint64) gt_array_size(seqs);
+    header.num_of_features = (GtUint64) gt_array_size(features);
+    header.seqs_offset = (GtUint64) sizeof header;
+    header.features_offset = header.seqs_offset + header.num_of_seqs
+                             * sizeof (GtFeatureIndexFileSeq);
+    header.text_offset = header.features_offset + header.num_of_features
+                         * sizeof (GtFeatureIndexFileFeature);
+    header.text_length = (GtUint64) gt_str_length(text);
+    if (!(fp = gt_fa_fopen(gt_str_get(fif->filename), "wb", err)))
+      had_err = -1;
+    else {
+      gt_xfwrite_one(&header, fp);
+      if (header.num_of_seqs > 0) {
+        gt_xfwrite(gt_array_get_space(seqs), sizeof (GtFeatureIndexFileSeq),
+                   (size_t) header.num_of_seqs, fp);
+      }
+      if (header.num_of_features > 0) {
+        gt_xfwrite(gt_array_get_space(features),
+                   sizeof (GtFeatureIndexFileFeature),
+                   (size_t) header.num_of_features, fp);
+      }
+      gt_xfwrite(gt_str_get_mem(text), sizeof (char),
+                 (size_t) header.text_length, fp);
+      gt_fa_xfclose(fp);
+    }
+  }
+  gt_free(first_seqid);
+  gt_str_array_delete(seqids);
+  gt_node_visitor_delete(gff3_visitor);
+  gt_str_delete(text);
+  gt_array_delete(features);
+  gt_array_delete(seqs);
+  gt_array_delete(nodes);
+  gt_hashmap_delete(seqid2node);
+  return had_err;
+}
+
+void gt_feature_index_file_delete(GtFeatureIndex *gfi)
+{
+  GtFeatureIndexFile *fif;
+  GtUword i;
+  if (!gfi) return;
+  fif = gt_feature_index_file_cast(gfi);
+  gt_feature_index_delete(fif->memory);
+  if (fif->added) {
+    for (i = 0; i < gt_array_size(fif->added); i++)
+      gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(fif->added, i));
+    gt_array_delete(fif->added);
+  }
+  if (fif->nodes) {
+    for (i = 0; i < fif->header->num_of_features; i++)
+      gt_genome_node_delete((GtGenomeNode*) fif->nodes[i]);
+    gt_free(fif->nodes);
+  }
+  gt_mutex_delete(fif->mutex);
+  gt_fa_xmunmap(fif->map);
+  gt_str_delete(fif->filename);
+}
+
+const GtFeatureIndexClass* gt_feature_index_file_class(void)
+{
+  static const GtFeatureIndexClass *fic = NULL;
+  gt_class_alloc_lock_enter();
+  if (!fic) {
+    fic = gt_feature_index_class_new(sizeof (GtFeatureIndexFile),
+                     gt_feature_index_file_add_region_node,
+                     gt_feature_index_file_add_feature_node,
+                     gt_feature_index_file_remove_node,
+                     gt_feature_index_file_get_features_for_seqid,
+                     gt_feature_index_file_get_features_for_range,
+                     gt_feature_index_file_get_first_seqid,
+                     gt_feature_index_file_save,
+                     gt_feature_index_file_get_seqids,
+                     gt_feature_index_file_get_range_for_seqid,
+                     gt_feature_index_file_get_orig_range_for_seqid,
+                     gt_feature_index_file_has_seqid,
+                     gt_feature_index_file_delete);
+    gt_feature_index_class_set_get_features_for_ranges_func(fic,
+                                   feature_index_file_get_features_for_ranges);
+  }
+  gt_class_alloc_lock_leave();
+  return fic;
+}
+
+GtFeatureIndex* gt_feature_index_file_new_empty(const char *filename)
+{
+  GtFeatureIndexFile *fif;
+  GtFeatureIndex *fi;
+  gt_assert(filename);
+  fi = gt_feature_index_create(gt_feature_index_file_class());
+  fif = gt_feature_index_file_cast(fi);
+  fif->filename = gt_str_new_cstr(filename);
+  fif->memory = gt_feature_index_memory_new();
+  fif->added = gt_array_new(sizeof (GtFeatureNode*));
+  return fi;
+}
+
+static int feature_index_file_check(const GtFeatureIndexFile *fif,
+                                    GtError *err)
+{
+  const GtFeatureIndexFileHeader *header = fif->header;
+  const GtFeatureIndexFileFeature *features;
+  GtUword i;
+  if (fif->map_length < sizeof *header ||
+      memcmp(header->magic, GT_FEATURE_INDEX_FILE_MAGIC,
+             GT_FEATURE_INDEX_FILE_MAGIC_LEN)) {
+    gt_error_set(err, "file \"%s\" is not a feature index file",
+                 gt_str_get(fif->filename));
+    return -1;
+  }
+  /* the table sizes are checked against the file length before they are
+     multiplied, so that corrupt counts cannot overflow the offsets */
+  if (header->num_of_seqs > (fif->map_length - sizeof *header)
+                            / sizeof (GtFeatureIndexFileSeq) ||
+      header->num_of_features > (fif->map_length - sizeof *header)
+                                / sizeof (GtFeatureIndexFileFeature) ||
+      header->seqs_offset != sizeof *header ||
+      header->features_offset != header->seqs_offset + header->num_of_seqs
+                                 * sizeof (GtFeatureIndexFileSeq) ||
+      header->text_offset != header->features_offset + header->num_of_features
+                             * sizeof (GtFeatureIndexFileFeature) ||
+      header->text_offset > fif->map_length ||
+      header->text_length != fif->map_length - header->text_offset ||
+      (header->num_of_seqs > 0 && header->first_seq >= header->num_of_seqs)) {
+    gt_error_set(err, "feature index file \"%s\" is corrupt",
+                 gt_str_get(fif->filename));
+    return -1;
+  }
+  for (i = 0; i < header->num_of_seqs; i++) {
+    const GtFeatureIndexFileSeq *seq = fif->seqs + i;
+    if (seq->seqid_length > header->text_length ||
+        seq->seqid_offset > header->text_length - seq->seqid_length ||
+        seq->num_of_features > header->num_of_features ||
+        seq->first_feature > header->num_of_features - seq->num_of_features ||
+        seq->max_level >= GT_FEATURE_INDEX_FILE_STACK_SIZE / 2 ||
+        (seq->num_of_features > 0 &&
+         seq->num_of_features >> seq->max_level >= 2)) {
+      gt_error_set(err, "feature index file \"%s\" is corrupt",
+                   gt_str_get(fif->filename));
+      return -1;
+    }
+  }
+  features = (const GtFeatureIndexFileFeature*)
+             ((const char*) fif->map + header->features_offset);
+  for (i = 0; i < header->num_of_features; i++) {
+    if (features[i].text_length > header->text_length ||
+        features[i].text_offset
+        > header->text_length - features[i].text_length) {
+      gt_error_set(err, "feature index file \"%s\" is corrupt",
+                   gt_str_get(fif->filename));
+      return -1;
+    }
+  }
+  return 0;
+}
+
+GtFeatureIndex* gt_feature_index_file_new(const char *filename, GtError *err)
+{
+  GtFeatureIndexFile *fif;
+  GtFeatureIndex *fi;
+  void *map;
+  size_t len;
+  gt_error_check(err);
+  gt_assert(filename);
+
+  if (!(map = gt_fa_mmap_read(filename, &len, err)))
+    return NULL;
+  fi = gt_feature_index_create(gt_feature_index_file_class());
+  fif = gt_feature_index_file_cast(fi);
+  fif->filename = gt_str_new_cstr(filename);
+  fif->map = map;
+  fif->map_length = len;
+  fif->header = map;
+  fif->seqs = (const GtFeatureIndexFileSeq*) ((char*) map + sizeof
+                                              (GtFeatureIndexFileHeader));
+  if (feature_index_file_check(fif, err)) {
+    gt_feature_index_delete(fi);
+    return NULL;
+  }
+  fif->features = (const GtFeatureIndexFileFeature*)
+                  ((char*) map + fif->header->features_offset);
+  fif->text = (const char*) map + fif->header->text_offset;
+  fif->nodes = gt_calloc((size_t) fif->header->num_of_features + 1,
+                         sizeof (GtFeatureNode*));
+  fif->mutex = gt_mutex_new();
+  return fi;
+}
+
+static int collect_ranges(GtUword range_num, GtFeatureNode *fn, void *data,
+                          GT_UNUSED GtError *err)
+{
+  GtArray **batch = (GtArray**) data;
+  gt_array_add(batch[range_num], fn);
+  return 0;
+}
+
+static GtUword count_nodes(GtFeatureNode *fn)
+{
+  GtFeatureNodeIterator *fni = gt_feature_node_iterator_new(fn);
+  GtUword count = 0;
+  while (gt_feature_node_iterator_next(fni))
+    count++;
+  gt_feature_node_iterator_delete(fni);
+  return count;
+}
+
+int gt_feature_index_file_unit_test(GtError *err)
+{
+  GtFeatureIndex *fi = NULL, *fi2 = NULL;
+  GtArray *res, *res2;
+  GtStr *filename, *seqid;
+  GtGenomeNode *gn;
+  GtError *testerr;
+  GtRange range, range2;
+  GtUword i, j;
+  FILE *fp;
+  bool has_seqid;
+  int had_err = 0;
+  gt_error_check(err);
+
+  /* run generic feature index tests */
+  filename = gt_str_new();
+  fp = gt_xtmpfp(filename);
+  gt_fa_xfclose(fp);
+  fi = gt_feature_index_file_new_empty(gt_str_get(filename));
+  had_err = gt_feature_index_unit_test(fi, err);
+  gt_feature_index_delete(fi);
+
+  /* write random features and a gene with children, compare queries */
+  if (!had_err) {
+    fi = gt_feature_index_file_new_empty(gt_str_get(filename));
+    seqid = gt_str_new_cstr("seq2");
+    gn = gt_region_node_new(seqid, 1, 1000000);
+    gt_ensure(!gt_feature_index_add_region_node(fi, (GtRegionNode*) gn, err));
+    gt_genome_node_delete(gn);
+    for (i = 0; i < 1000UL; i++) {
+      GtUword start = 1 + random() % 990000;
+      gn = gt_feature_node_new(seqid, "gene", start,
+                               start + random() % 10000, GT_STRAND_FORWARD);
+      gt_ensure(!gt_feature_index_add_feature_node(fi, (GtFeatureNode*) gn,
+                                                   err));
+      gt_genome_node_delete(gn);
+    }
+    gn = gt_feature_node_new_standard_gene();
+    gt_ensure(!gt_feature_index_add_feature_node(fi, (GtFeatureNode*) gn,
+                                                 err));
+    gt_genome_node_delete(gn);
+    gt_str_delete(seqid);
+    gt_ensure(!gt_feature_index_save(fi, err));
+  }
+  if (!had_err && !(fi2 = gt_feature_index_file_new(gt_str_get(filename),
+                                                    err)))
+    had_err = -1;
+  if (!had_err) {
+    GtStrArray *seqids = gt_feature_index_get_seqids(fi2, err);
+    char *first = gt_feature_index_get_first_seqid(fi2, err);
+    gt_ensure(gt_str_array_size(seqids) == 2);
+    gt_ensure(strcmp(gt_str_array_get(seqids, 0), "ctg123") == 0);
+    gt_ensure(strcmp(first, "seq2") == 0);
+    gt_ensure(!gt_feature_index_has_seqid(fi2, &has_seqid, "seq2", err));
+    gt_ensure(has_seqid);
+    gt_ensure(!gt_feature_index_has_seqid(fi2, &has_seqid, "seq3", err));
+    gt_ensure(!has_seqid);
+    gt_ensure(!gt_feature_index_get_orig_range_for_seqid(fi2, &range, "seq2",
+                                                         err));
+    gt_ensure(range.start == 1 && range.end == 1000000);
+    gt_ensure(!gt_feature_index_get_range_for_seqid(fi, &range, "ctg123",
+                                                    err));
+    gt_ensure(!gt_feature_index_get_range_for_seqid(fi2, &range2, "ctg123",
+                                                    err));
+    gt_ensure(gt_range_compare(&range, &range2) == 0);
+    gt_free(first);
+    gt_str_array_delete(seqids);
+  }
+  res = gt_array_new(sizeof (GtFeatureNode*));
+  res2 = gt_array_new(sizeof (GtFeatureNode*));
+  for (i = 0; !had_err && i < 100UL; i++) {
+    range.start = 1 + random() % 1000000;
+    range.end = range.start + random() % 50000;
+    gt_array_reset(res);
+    gt_array_reset(res2);
+    gt_ensure(!gt_feature_index_get_features_for_range(fi, res, "seq2", &range,
+                                                       err));
+    gt_ensure(!gt_feature_index_get_features_for_range(fi2, res2, "seq2",
+                                                       &range, err));
+    gt_ensure(gt_array_size(res) == gt_array_size(res2));
+    for (j = 0; !had_err && j < gt_array_size(res); j++) {
+      gt_ensure(gt_feature_node_is_similar(
+                                  *(GtFeatureNode**) gt_array_get(res, j),
+                                  *(GtFeatureNode**) gt_array_get(res2, j)));
+    }
+  }
+  if (!had_err) {
+    /* batch queries over tiles yield the same features as single queries */
+    GtRange tiles[100];
+    GtArray *batch[100];
+    for (i = 0; i < 100UL; i++) {
+      tiles[i].start = 1 + i * 10000;
+      tiles[i].end = tiles[i].start + 12000;
+      batch[i] = gt_array_new(sizeof (GtFeatureNode*));
+    }
+    gt_ensure(!gt_feature_index_get_features_for_ranges(fi2, "seq2", tiles,
+                                                        100, collect_ranges,
+                                                        batch, err));
+    for (i = 0; !had_err && i < 100UL; i++) {
+      gt_array_reset(res2);
+      gt_ensure(!gt_feature_index_get_features_for_range(fi2, res2, "seq2",
+                                                         tiles + i, err));
+      gt_ensure(gt_array_size(res2) == gt_array_size(batch[i]));
+      for (j = 0; !had_err && j < gt_array_size(res2); j++) {
+        gt_ensure(*(GtFeatureNode**) gt_array_get(res2, j) ==
+                  *(GtFeatureNode**) gt_array_get(batch[i], j));
+      }
+    }
+    for (i = 0; i < 100UL; i++)
+      gt_array_delete(batch[i]);
+  }
+  if (!had_err) {
+    /* the node trees are restored, although the parents of the standard
+       gene have no ID attributes */
+    range.start = 1;
+    range.end = 10000;
+    gt_array_reset(res2);
+    gt_ensure(!gt_feature_index_get_features_for_range(fi2, res2, "ctg123",
+                                                       &range, err));
+    gt_ensure(gt_array_size(res2) == 1);
+    gn = gt_feature_node_new_standard_gene();
+    gt_ensure(count_nodes(*(GtFeatureNode**) gt_array_get(res2, 0)) ==
+              count_nodes((GtFeatureNode*) gn));
+    gt_genome_node_delete(gn);
+  }
+  if (!had_err) {
+    /* mapped indices are read only */
+    testerr = gt_error_new();
+    gn = gt_feature_node_new_standard_gene();
+    gt_ensure(gt_feature_index_add_feature_node(fi2, (GtFeatureNode*) gn,
+                                                testerr));
+    gt_ensure(gt_error_is_set(testerr));
+    gt_genome_node_delete(gn);
+    gt_error_delete(testerr);
+  }
+  gt_array_delete(res);
+  gt_array_delete(res2);
+  gt_feature_index_delete(fi);
+  gt_feature_index_delete(fi2);
+  gt_xremove(gt_str_get(filename));
+  gt_str_delete(filename);
+  return had_err;
+}
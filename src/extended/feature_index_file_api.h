@@ -0,0 +1,40 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef FEATURE_INDEX_FILE_API_H
+#define FEATURE_INDEX_FILE_API_H
+
+#include "extended/feature_index_api.h"
+
+/* The <GtFeatureIndexFile> class implements a <GtFeatureIndex> which is
+   stored in a single file. The file is mapped into memory when it is opened,
+   so queries are answered without reading or parsing the annotation first.
+   For each sequence region the features are kept in an array sorted by start
+   position, from which a <GtIntervalIndex> is built on the first query of the
+   region. The feature node trees themselves are only materialized when they
+   are returned by a query.
+   Returned nodes belong to the index. */
+typedef struct GtFeatureIndexFile GtFeatureIndexFile;
+
+/* Creates a new <GtFeatureIndexFile> object by mapping the existing index file
+   <filename>. The index cannot be modified. Returns NULL and sets <err> on
+   error. */
+GtFeatureIndex* gt_feature_index_file_new(const char *filename, GtError *err);
+/* Creates a new empty <GtFeatureIndexFile> object which collects features in
+   memory until it is written to <filename> by <gt_feature_index_save()>. */
+GtFeatureIndex* gt_feature_index_file_new_empty(const char *filename);
+
+#endif
@@ -38,6 +38,13 @@ typedef int         (*GtFeatureIndexGetFeatsForRangeFunc)(GtFeatureIndex*,
                                                           const char*,
                                                           const GtRange*,
                                                           GtError*);
+typedef int         (*GtFeatureIndexGetFeatsForRangesFunc)(GtFeatureIndex*,
+                                                           const char*,
+                                                           const GtRange*,
+                                                           GtUword,
+                                                      GtFeatureIndexRangesFunc,
+                                                           void*,
+                                                           GtError*);
 typedef char*       (*GtFeatureIndexGetFirstSeqidFunc)(const GtFeatureIndex*,
                                                        GtError*);
 typedef int         (*GtFeatureIndexSaveFunc)(GtFeatureIndex*, GtError*);
@@ -89,6 +96,14 @@ const GtFeatureIndexClass* gt_feature_index_class_new(size_t size,
                                                  has_seqid,
                                          GtFeatureIndexFreeFunc
                                                  free);
+/* Sets a method answering a sorted list of range queries at once. Without it,
+   <gt_feature_index_get_features_for_ranges()> queries the ranges one by
+   one. Must be called while the class is created, before any instance of
+   it exists. */
+void            gt_feature_index_class_set_get_features_for_ranges_func(
+                                         const GtFeatureIndexClass *fic,
+                                         GtFeatureIndexGetFeatsForRangesFunc
+                                                 get_features_for_ranges);
 GtFeatureIndex* gt_feature_index_create(const GtFeatureIndexClass*);
 void*           gt_feature_index_cast(const GtFeatureIndexClass*,
                                       GtFeatureIndex*);
@@ -0,0 +1,166 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <stdio.h>
+#include "core/assert_api.h"
+#include "core/class_alloc_lock.h"
+#include "core/compat_api.h"
+#include "core/cstr_table.h"
+#include "core/file_api.h"
+#include "core/ma_api.h"
+#include "core/queue_api.h"
+#include "core/str_api.h"
+#include "extended/gff3_parser.h"
+#include "extended/gff3_region_in_stream.h"
+#include "extended/gff3_region_index.h"
+
+struct GtGFF3RegionInStream {
+  const GtNodeStream parent_instance;
+  GtStr *filename,
+        *text;
+  FILE *memfp;
+  GtFile *fpin;
+  GtUint64 line_number;
+  GtUword num_of_features;
+  GtQueue *genome_node_buffer;
+  GtGFF3Parser *gff3_parser;
+  GtCstrTable *used_types;
+  bool eof;
+};
+
+#define gff3_region_in_stream_cast(NS)\
+        gt_node_stream_cast(gt_gff3_region_in_stream_class(), NS)
+
+static int gff3_region_in_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
+                                      GtError *err)
+{
+  GtGFF3RegionInStream *is = gff3_region_in_stream_cast(ns);
+  int had_err = 0, status_code;
+  gt_error_check(err);
+
+  /* read two nodes at a time, so that pseudo-nodes are joined before they are
+     delivered */
+  if (!is->eof && !gt_queue_size(is->genome_node_buffer)) {
+    had_err = gt_gff3_parser_parse_genome_nodes(is->gff3_parser, &status_code,
+                                                is->genome_node_buffer,
+                                                is->used_types, is->filename,
+                                                &is->line_number, is->fpin,
+                                                err);
+    if (!had_err && status_code != EOF) {
+      had_err = gt_gff3_parser_parse_genome_nodes(is->gff3_parser,
+                                                  &status_code,
+                                                  is->genome_node_buffer,
+                                                  is->used_types,
+                                                  is->filename,
+                                                  &is->line_number, is->fpin,
+                                                  err);
+    }
+    if (!had_err && status_code == EOF)
+      is->eof = true;
+  }
+  if (had_err)
+    return had_err;
+  *gn = gt_queue_size(is->genome_node_buffer)
+        ? gt_queue_get(is->genome_node_buffer)
+        : NULL;
+  return 0;
+}
+
+static void gff3_region_in_stream_free(GtNodeStream *ns)
+{
+  GtGFF3RegionInStream *is = gff3_region_in_stream_cast(ns);
+  while (gt_queue_size(is->genome_node_buffer))
+    gt_genome_node_delete(gt_queue_get(is->genome_node_buffer));
+  gt_queue_delete(is->genome_node_buffer);
+  gt_gff3_parser_delete(is->gff3_parser);
+  gt_cstr_table_delete(is->used_types);
+  /* the file pointer does not belong to the file allocator */
+  gt_file_delete_without_handle(is->fpin);
+  if (is->memfp)
+    (void) fclose(is->memfp);
+  gt_str_delete(is->text);
+  gt_str_delete(is->filename);
+}
+
+const GtNodeStreamClass* gt_gff3_region_in_stream_class(void)
+{
+  static const GtNodeStreamClass *nsc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!nsc) {
+    nsc = gt_node_stream_class_new(sizeof (GtGFF3RegionInStream),
+                                   gff3_region_in_stream_free,
+                                   gff3_region_in_stream_next);
+  }
+  gt_class_alloc_lock_leave();
+  return nsc;
+}
+
+GtNodeStream* gt_gff3_region_in_stream_new(const char *filename,
+                                           const char *seqid,
+                                           const GtRange *range,
+                                           GtError *err)
+{
+  GtGFF3RegionInStream *is;
+  GtGFF3RegionIndex *ri;
+  GtNodeStream *ns;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(filename && seqid && range);
+
+  if (!gt_gff3_region_index_exists(filename)) {
+    gt_error_set(err, "no index found for file \"%s\" (create it with "
+                 "\"gt gff3_index\")", filename);
+    return NULL;
+  }
+  if (!(ri = gt_gff3_region_index_new_from_file(filename, err)))
+    return NULL;
+
+  ns = gt_node_stream_create(gt_gff3_region_in_stream_class(), true);
+  is = gff3_region_in_stream_cast(ns);
+  is->filename = gt_str_new_cstr(filename);
+  is->text = gt_str_new();
+  is->genome_node_buffer = gt_queue_new();
+  is->gff3_parser = gt_gff3_parser_new(NULL);
+  is->used_types = gt_cstr_table_new();
+
+  had_err = gt_gff3_region_index_extract(ri, filename, seqid, range, is->text,
+                                         &is->num_of_features, err);
+  gt_gff3_region_index_delete(ri);
+  if (!had_err) {
+    if (gt_str_length(is->text) == 0)
+      is->eof = true;
+    else if (!(is->memfp = gt_fmemopen_read(gt_str_get_mem(is->text),
+                                            (size_t)
+                                            gt_str_length(is->text)))) {
+      gt_error_set(err, "cannot read extracted region of file \"%s\"",
+                   filename);
+      had_err = -1;
+    }
+    else
+      is->fpin = gt_file_new_from_fileptr(is->memfp);
+  }
+  if (had_err) {
+    gt_node_stream_delete(ns);
+    return NULL;
+  }
+  return ns;
+}
+
+GtUword gt_gff3_region_in_stream_num_of_features(GtGFF3RegionInStream *is)
+{
+  gt_assert(is);
+  return is->num_of_features;
+}
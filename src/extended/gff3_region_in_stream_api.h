@@ -0,0 +1,44 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef GFF3_REGION_IN_STREAM_API_H
+#define GFF3_REGION_IN_STREAM_API_H
+
+#include "core/range_api.h"
+#include "extended/node_stream_api.h"
+
+/* Implements the <GtNodeStream> interface. A <GtGFF3RegionInStream> delivers
+   the top-level features on a single sequence region which overlap a given
+   range from a BGZF compressed, sorted GFF3 file. Instead of parsing the whole
+   file, it uses the file's region index (see <gt gff3_index>) to seek directly
+   to the first overlapping feature. The stream is sorted and starts with the
+   sequence region node of the given sequence region (if the file contains a
+   ##sequence-region line for it). */
+typedef struct GtGFF3RegionInStream GtGFF3RegionInStream;
+
+/* Create a <GtGFF3RegionInStream> delivering all top-level features on
+   <seqid> in BGZF compressed <filename> which overlap <range>. Returns NULL
+   and sets <err> if <filename> has no index or cannot be read. */
+GtNodeStream* gt_gff3_region_in_stream_new(const char *filename,
+                                           const char *seqid,
+                                           const GtRange *range,
+                                           GtError *err);
+/* Return the number of top-level features selected by <gff3_region_in_stream>
+   using the index. */
+GtUword       gt_gff3_region_in_stream_num_of_features(GtGFF3RegionInStream
+                                                       *gff3_region_in_stream);
+
+#endif
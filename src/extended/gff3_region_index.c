@@ -0,0 +1,789 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <samtools/bgzf.h>
+#include "core/array_api.h"
+#include "core/cstr_api.h"
+#include "core/ensure_api.h"
+#include "core/fa_api.h"
+#include "core/fileutils_api.h"
+#include "core/hashmap_api.h"
+#include "core/ma_api.h"
+#include "core/parseutils_api.h"
+#include "core/str_array_api.h"
+#include "core/xansi_api.h"
+#include "extended/gff3_defines.h"
+#include "extended/gff3_region_index.h"
+
+#define GT_GFF3_REGION_INDEX_MAGIC        "GTI\1"
+#define GT_GFF3_REGION_INDEX_WINDOW_SHIFT 14
+#define GT_GFF3_REGION_INDEX_UNDEF        (~(GtUint64) 0)
+#define GT_GFF3_REGION_INDEX_BUFSIZE      65536
+
+typedef struct {
+  char *seqid;
+  GtUword first_window;
+  GtArray *offsets; /* of <GtUint64>, one per window from <first_window> on */
+} GtGFF3RegionIndexSeq;
+
+struct GtGFF3RegionIndex {
+  GtArray *seqs; /* of <GtGFF3RegionIndexSeq*>, in file order */
+  GtHashmap *seqid2seq;
+  GtUint64 header_end;
+};
+
+/* reads a BGZF compressed GFF3 file one top-level feature at a time */
+typedef struct {
+  BGZF *fp;
+  GtStr *line,
+        *seqid,
+        *id, /* of the first line of the group */
+        *lines;
+  GtRange range;
+  GtUint64 line_offset,
+           group_offset;
+  bool line_pending,
+       eof;
+} GFF3GroupReader;
+
+static int gff3_group_reader_read_line(GFF3GroupReader *gr)
+{
+  int cc;
+  gt_str_reset(gr->line);
+  gr->line_offset = (GtUint64) bgzf_tell(gr->fp);
+  while ((cc = bgzf_getc(gr->fp)) >= 0) {
+    if (cc == '\n')
+      return 0;
+    gt_str_append_char(gr->line, cc);
+  }
+  if (cc == -1 && gt_str_length(gr->line) > 0)
+    return 0; /* last line without newline */
+  return cc == -1 ? 1 : -1;
+}
+
+static const char* gff3_group_reader_find_attribute(const char *attributes,
+                                                    const char *tag)
+{
+  const char *p = attributes;
+  while ((p = strstr(p, tag)) != NULL) {
+    if (p == attributes || p[-1] == ';')
+      return p;
+    p++;
+  }
+  return NULL;
+}
+
+static bool gff3_group_reader_has_attribute(const char *attributes,
+                                            const char *tag)
+{
+  return gff3_group_reader_find_attribute(attributes, tag) != NULL;
+}
+
+/* parses seqid, start, end, the ID, and the presence of a parent from a
+   feature line, returns -1 if the line is malformed */
+static int gff3_group_reader_parse_line(const GtStr *line, GtStr *seqid,
+                                        GtRange *range, GtStr *id,
+                                        bool *has_parent)
+{
+  const char *cline = gt_str_get(line), *col[9];
+  GtUword i, start, end;
+  const char *value;
+  char *tab;
+  col[0] = cline;
+  for (i = 1; i < 9UL; i++) {
+    if (!(tab = strchr(col[i-1], '\t')))
+      return -1;
+    col[i] = tab + 1;
+  }
+  gt_str_reset(seqid);
+  gt_str_append_cstr_nt(seqid, col[0], (GtUword) (col[1] - col[0] - 1));
+  start = strtoul(col[3], NULL, 10);
+  end = strtoul(col[4], NULL, 10);
+  if (start == 0 || end < start)
+    return -1;
+  range->start = start;
+  range->end = end;
+  gt_str_reset(id);
+  if ((value = gff3_group_reader_find_attribute(col[8], GT_GFF_ID"="))) {
+    value += strlen(GT_GFF_ID"=");
+    gt_str_append_cstr_nt(id, value, (GtUword) strcspn(value, ";"));
+  }
+  *has_parent = gff3_group_reader_has_attribute(col[8], GT_GFF_PARENT"=") ||
+                gff3_group_reader_has_attribute(col[8], GT_GFF_DERIVES_FROM"=");
+  return 0;
+}
+
+/* Reads the next top-level feature group, which consists of a top-level
+   feature line, the lines of its descendants, and further lines of the
+   top-level feature if it is a multi-line feature. Returns 1 if a group was
+   read, 0 at the end of the file or the feature section, and -1 on error. If
+   <header_end> is given, the offset of the first feature line is stored in
+   it. */
+static int gff3_group_reader_next(GFF3GroupReader *gr, bool keep_lines,
+                                  GtUint64 *header_end, GtError *err)
+{
+  GtStr *line_seqid = NULL, *line_id = NULL;
+  GtRange line_range;
+  bool has_parent, in_group = false;
+  int rval = 0;
+
+  gt_str_reset(gr->lines);
+  line_seqid = gt_str_new();
+  line_id = gt_str_new();
+  while (!gr->eof) {
+    const char *cline;
+    if (!gr->line_pending) {
+      if ((rval = gff3_group_reader_read_line(gr)) == -1) {
+        gt_error_set(err, "error reading BGZF file");
+        break;
+      }
+      if (rval == 1) {
+        gr->eof = true;
+        rval = 0;
+        break;
+      }
+    }
+    gr->line_pending = false;
+    cline = gt_str_get(gr->line);
+    if (gt_str_length(gr->line) == 0)
+      continue;
+    if (strcmp(cline, GT_GFF_TERMINATOR) == 0) {
+      if (in_group)
+        break;
+      continue;
+    }
+    if (strncmp(cline, GT_GFF_FASTA_DIRECTIVE,
+                strlen(GT_GFF_FASTA_DIRECTIVE)) == 0 || cline[0] == '>') {
+      gr->eof = true;
+      break;
+    }
+    if (cline[0] == '#') {
+      if (in_group && keep_lines) {
+        gt_str_append_str(gr->lines, gr->line);
+        gt_str_append_char(gr->lines, '\n');
+      }
+      continue;
+    }
+    if (gff3_group_reader_parse_line(gr->line, line_seqid, &line_range,
+                                     line_id, &has_parent)) {
+      gt_error_set(err, "malformed GFF3 feature line: %s", cline);
+      rval = -1;
+      break;
+    }
+    if (in_group && (gt_str_cmp(line_seqid, gr->seqid) ||
+                     (!has_parent && (!gt_str_length(line_id) ||
+                                      gt_str_cmp(line_id, gr->id))))) {
+      /* this line starts the next group */
+      gr->line_pending = true;
+      break;
+    }
+    if (!in_group) {
+      in_group = true;
+      if (header_end && *header_end == GT_GFF3_REGION_INDEX_UNDEF)
+        *header_end = gr->line_offset;
+      gr->group_offset = gr->line_offset;
+      gt_str_reset(gr->seqid);
+      gt_str_append_str(gr->seqid, line_seqid);
+      gt_str_reset(gr->id);
+      gt_str_append_str(gr->id, line_id);
+      gr->range = line_range;
+    }
+    else
+      gr->range = gt_range_join(&gr->range, &line_range);
+    if (keep_lines) {
+      gt_str_append_str(gr->lines, gr->line);
+      gt_str_append_char(gr->lines, '\n');
+    }
+  }
+  gt_str_delete(line_id);
+  gt_str_delete(line_seqid);
+  if (rval == -1)
+    return -1;
+  return in_group ? 1 : 0;
+}
+
+static int gff3_group_reader_init(GFF3GroupReader *gr, const char *gff3file,
+                                  GtError *err)
+{
+  memset(gr, 0, sizeof *gr);
+  if (bgzf_check_bgzf(gff3file) != 1) {
+    gt_error_set(err, "file \"%s\" is not BGZF compressed", gff3file);
+    return -1;
+  }
+  if (!(gr->fp = bgzf_open(gff3file, "r"))) {
+    gt_error_set(err, "cannot open BGZF file \"%s\"", gff3file);
+    return -1;
+  }
+  gr->line = gt_str_new();
+  gr->seqid = gt_str_new();
+  gr->id = gt_str_new();
+  gr->lines = gt_str_new();
+  return 0;
+}
+
+static int gff3_group_reader_seek(GFF3GroupReader *gr, GtUint64 offset,
+                                  GtError *err)
+{
+  gr->line_pending = false;
+  gr->eof = false;
+  if (bgzf_seek(gr->fp, (int64_t) offset, SEEK_SET) != 0) {
+    gt_error_set(err, "cannot seek in BGZF file");
+    return -1;
+  }
+  return 0;
+}
+
+static void gff3_group_reader_clean(GFF3GroupReader *gr)
+{
+  if (gr->fp)
+    (void) bgzf_close(gr->fp);
+  gt_str_delete(gr->line);
+  gt_str_delete(gr->seqid);
+  gt_str_delete(gr->id);
+  gt_str_delete(gr->lines);
+}
+
+static GtGFF3RegionIndexSeq* gff3_region_index_seq_new(const char *seqid)
+{
+  GtGFF3RegionIndexSeq *seq = gt_malloc(sizeof *seq);
+  seq->seqid = gt_cstr_dup(seqid);
+  seq->first_window = 0;
+  seq->offsets = gt_array_new(sizeof (GtUint64));
+  return seq;
+}
+
+static void gff3_region_index_seq_delete(GtGFF3RegionIndexSeq *seq)
+{
+  if (!seq) return;
+  gt_free(seq->seqid);
+  gt_array_delete(seq->offsets);
+  gt_free(seq);
+}
+
+static GtGFF3RegionIndex* gff3_region_index_new(void)
+{
+  GtGFF3RegionIndex *ri = gt_malloc(sizeof *ri);
+  ri->seqs = gt_array_new(sizeof (GtGFF3RegionIndexSeq*));
+  ri->seqid2seq = gt_hashmap_new(GT_HASH_STRING, NULL, NULL);
+  ri->header_end = GT_GFF3_REGION_INDEX_UNDEF;
+  return ri;
+}
+
+static GtGFF3RegionIndexSeq* gff3_region_index_add_seq(GtGFF3RegionIndex *ri,
+                                                       const char *seqid)
+{
+  GtGFF3RegionIndexSeq *seq = gff3_region_index_seq_new(seqid);
+  gt_array_add(ri->seqs, seq);
+  gt_hashmap_add(ri->seqid2seq, seq->seqid, seq);
+  return seq;
+}
+
+static void gff3_region_index_seq_add_group(GtGFF3RegionIndexSeq *seq,
+                                            const GtRange *range,
+                                            GtUint64 offset)
+{
+  GtUword w, first = (range->start - 1) >> GT_GFF3_REGION_INDEX_WINDOW_SHIFT,
+          last = (range->end - 1) >> GT_GFF3_REGION_INDEX_WINDOW_SHIFT;
+  GtUint64 undef = GT_GFF3_REGION_INDEX_UNDEF;
+  /* groups arrive sorted by start, the first one determines the first window */
+  if (!gt_array_size(seq->offsets))
+    seq->first_window = first;
+  gt_assert(first >= seq->first_window);
+  while (seq->first_window + gt_array_size(seq->offsets) <= last)
+    gt_array_add(seq->offsets, undef);
+  for (w = first; w <= last; w++) {
+    GtUint64 *o = gt_array_get(seq->offsets, w - seq->first_window);
+    if (*o == GT_GFF3_REGION_INDEX_UNDEF)
+      *o = offset;
+  }
+}
+
+/* empty windows point to the next non-empty one, so that every lookup of a
+   window inside the array yields a valid starting point */
+static void gff3_region_index_seq_fill(GtGFF3RegionIndexSeq *seq)
+{
+  GtUword w = gt_array_size(seq->offsets);
+  GtUint64 next = GT_GFF3_REGION_INDEX_UNDEF;
+  while (w-- > 0) {
+    GtUint64 *o = gt_array_get(seq->offsets, w);
+    if (*o == GT_GFF3_REGION_INDEX_UNDEF)
+      *o = next;
+    else
+      next = *o;
+  }
+}
+
+GtGFF3RegionIndex* gt_gff3_region_index_new_from_gff3(const char *gff3file,
+                                                      GtError *err)
+{
+  GtGFF3RegionIndex *ri;
+  GtGFF3RegionIndexSeq *seq = NULL;
+  GFF3GroupReader gr;
+  GtUword last_start = 0, i;
+  int rval, had_err;
+  gt_error_check(err);
+  gt_assert(gff3file);
+
+  if ((had_err = gff3_group_reader_init(&gr, gff3file, err))) {
+    gff3_group_reader_clean(&gr);
+    return NULL;
+  }
+  ri = gff3_region_index_new();
+  while ((rval = gff3_group_reader_next(&gr, false, &ri->header_end,
+                                        err)) == 1) {
+    if (!seq || strcmp(seq->seqid, gt_str_get(gr.seqid))) {
+      if (gt_hashmap_get(ri->seqid2seq, gt_str_get(gr.seqid))) {
+        gt_error_set(err, "file \"%s\" is not sorted: features on sequence "
+                     "region \"%s\" are not contiguous", gff3file,
+                     gt_str_get(gr.seqid));
+        rval = -1;
+        break;
+      }
+      seq = gff3_region_index_add_seq(ri, gt_str_get(gr.seqid));
+      last_start = 0;
+    }
+    if (gr.range.start < last_start) {
+      gt_error_set(err, "file \"%s\" is not sorted: feature starting at "
+                   GT_WU" on sequence region \"%s\" follows one starting at "
+                   GT_WU, gff3file, gr.range.start, seq->seqid, last_start);
+      rval = -1;
+      break;
+    }
+    last_start = gr.range.start;
+    gff3_region_index_seq_add_group(seq, &gr.range, gr.group_offset);
+  }
+  gff3_group_reader_clean(&gr);
+  if (rval == -1) {
+    gt_gff3_region_index_delete(ri);
+    return NULL;
+  }
+  for (i = 0; i < gt_array_size(ri->seqs); i++)
+    gff3_region_index_seq_fill(*(GtGFF3RegionIndexSeq**)
+                               gt_array_get(ri->seqs, i));
+  return ri;
+}
+
+int gt_gff3_region_index_write(const GtGFF3RegionIndex *ri,
+                               const char *gff3file, GtError *err)
+{
+  GtStr *indexfile;
+  GtUint64 num;
+  GtUword i;
+  FILE *fp;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(ri && gff3file);
+
+  indexfile = gt_str_new_cstr(gff3file);
+  gt_str_append_cstr(indexfile, GT_GFF3_REGION_INDEX_SUFFIX);
+  if (!(fp = gt_fa_fopen(gt_str_get(indexfile), "wb", err)))
+    had_err = -1;
+  if (!had_err) {
+    gt_xfwrite(GT_GFF3_REGION_INDEX_MAGIC, sizeof (char),
+               strlen(GT_GFF3_REGION_INDEX_MAGIC), fp);
+    gt_xfwrite_one(&ri->header_end, fp);
+    num = (GtUint64) gt_array_size(ri->seqs);
+    gt_xfwrite_one(&num, fp);
+    for (i = 0; i < gt_array_size(ri->seqs); i++) {
+      GtGFF3RegionIndexSeq *seq = *(GtGFF3RegionIndexSeq**)
+                                  gt_array_get(ri->seqs, i);
+      num = (GtUint64) strlen(seq->seqid);
+      gt_xfwrite_one(&num, fp);
+      gt_xfwrite(seq->seqid, sizeof (char), (size_t) num, fp);
+      num = (GtUint64) seq->first_window;
+      gt_xfwrite_one(&num, fp);
+      num = (GtUint64) gt_array_size(seq->offsets);
+      gt_xfwrite_one(&num, fp);
+      if (num > 0)
+        gt_xfwrite(gt_array_get_space(seq->offsets), sizeof (GtUint64),
+                   (size_t) num, fp);
+    }
+    gt_fa_xfclose(fp);
+  }
+  gt_str_delete(indexfile);
+  return had_err;
+}
+
+GtGFF3RegionIndex* gt_gff3_region_index_new_from_file(const char *gff3file,
+                                                      GtError *err)
+{
+  GtGFF3RegionIndex *ri = NULL;
+  char magic[sizeof (GT_GFF3_REGION_INDEX_MAGIC)];
+  GtUint64 num_of_seqs, len, i;
+  GtStr *indexfile;
+  off_t filesize = 0;
+  FILE *fp;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(gff3file);
+
+  indexfile = gt_str_new_cstr(gff3file);
+  gt_str_append_cstr(indexfile, GT_GFF3_REGION_INDEX_SUFFIX);
+  if (!(fp = gt_fa_fopen(gt_str_get(indexfile), "rb", err)))
+    had_err = -1;
+  else
+    filesize = gt_file_size(gt_str_get(indexfile));
+#define GFF3_REGION_INDEX_CORRUPT\
+        {\
+          gt_error_set(err, "corrupt index file \"%s\"",\
+                       gt_str_get(indexfile));\
+          had_err = -1;\
+        }
+#define GFF3_REGION_INDEX_READ(PTR, NMEMB)\
+        if (!had_err && fread(PTR, sizeof (*(PTR)), (size_t) (NMEMB), fp)\
+                        != (size_t) (NMEMB))\
+          GFF3_REGION_INDEX_CORRUPT
+/* a length field must not exceed the rest of the file */
+#define GFF3_REGION_INDEX_CHECK_LENGTH(LEN, SIZE)\
+        if (!had_err && (LEN) > (GtUint64) (filesize - ftell(fp)) / (SIZE))\
+          GFF3_REGION_INDEX_CORRUPT
+  GFF3_REGION_INDEX_READ(magic, strlen(GT_GFF3_REGION_INDEX_MAGIC));
+  if (!had_err && strncmp(magic, GT_GFF3_REGION_INDEX_MAGIC,
+                          strlen(GT_GFF3_REGION_INDEX_MAGIC))) {
+    gt_error_set(err, "file \"%s\" is not a GFF3 region index",
+                 gt_str_get(indexfile));
+    had_err = -1;
+  }
+  if (!had_err)
+    ri = gff3_region_index_new();
+  GFF3_REGION_INDEX_READ(&ri->header_end, 1);
+  GFF3_REGION_INDEX_READ(&num_of_seqs, 1);
+  GFF3_REGION_INDEX_CHECK_LENGTH(num_of_seqs, 3 * sizeof (GtUint64));
+  for (i = 0; !had_err && i < num_of_seqs; i++) {
+    GtGFF3RegionIndexSeq *seq;
+    char *seqid;
+    GFF3_REGION_INDEX_READ(&len, 1);
+    GFF3_REGION_INDEX_CHECK_LENGTH(len, sizeof (char));
+    if (had_err)
+      break;
+    seqid = gt_malloc(sizeof (char) * (len + 1));
+    GFF3_REGION_INDEX_READ(seqid, len);
+    seqid[len] = '\0';
+    if (!had_err && gt_hashmap_get(ri->seqid2seq, seqid))
+      GFF3_REGION_INDEX_CORRUPT;
+    if (!had_err) {
+      seq = gff3_region_index_add_seq(ri, seqid);
+      GFF3_REGION_INDEX_READ(&len, 1);
+      seq->first_window = (GtUword) len;
+      GFF3_REGION_INDEX_READ(&len, 1);
+      GFF3_REGION_INDEX_CHECK_LENGTH(len, sizeof (GtUint64));
+      if (!had_err && len > 0) {
+        GtUint64 *offsets = gt_malloc(sizeof (GtUint64) * len), j;
+        GFF3_REGION_INDEX_READ(offsets, len);
+        for (j = 0; !had_err && j < len; j++)
+          gt_array_add(seq->offsets, offsets[j]);
+        gt_free(offsets);
+      }
+    }
+    gt_free(seqid);
+  }
+#undef GFF3_REGION_INDEX_CHECK_LENGTH
+#undef GFF3_REGION_INDEX_READ
+#undef GFF3_REGION_INDEX_CORRUPT
+  if (fp)
+    gt_fa_xfclose(fp);
+  gt_str_delete(indexfile);
+  if (had_err) {
+    gt_gff3_region_index_delete(ri);
+    return NULL;
+  }
+  return ri;
+}
+
+bool gt_gff3_region_index_exists(const char *gff3file)
+{
+  return gt_file_exists_with_suffix(gff3file, GT_GFF3_REGION_INDEX_SUFFIX);
+}
+
+GtUword gt_gff3_region_index_num_of_seqids(const GtGFF3RegionIndex *ri)
+{
+  gt_assert(ri);
+  return gt_array_size(ri->seqs);
+}
+
+static bool gff3_region_index_is_wanted_directive(const GtStr *line,
+                                                  const char *seqid)
+{
+  const char *cline = gt_str_get(line);
+  if (strncmp(cline, GT_GFF_VERSION_PREFIX,
+              strlen(GT_GFF_VERSION_PREFIX)) == 0)
+    return true;
+  if (strncmp(cline, GT_GFF_SEQUENCE_REGION,
+              strlen(GT_GFF_SEQUENCE_REGION)) == 0) {
+    const char *p = cline + strlen(GT_GFF_SEQUENCE_REGION);
+    size_t len = strlen(seqid);
+    while (*p == ' ' || *p == '\t')
+      p++;
+    return strncmp(p, seqid, len) == 0 && (p[len] == ' ' || p[len] == '\t' ||
+                                           p[len] == '\0');
+  }
+  return false;
+}
+
+int gt_gff3_region_index_extract(const GtGFF3RegionIndex *ri,
+                                 const char *gff3file, const char *seqid,
+                                 const GtRange *range, GtStr *text,
+                                 GtUword *num_of_features, GtError *err)
+{
+  GtGFF3RegionIndexSeq *seq;
+  GFF3GroupReader gr;
+  GtUword window, count = 0;
+  int rval = 0, had_err;
+  gt_error_check(err);
+  gt_assert(ri && gff3file && seqid && range && text);
+
+  had_err = gff3_group_reader_init(&gr, gff3file, err);
+
+  /* copy the relevant header directives */
+  while (!had_err && ri->header_end != GT_GFF3_REGION_INDEX_UNDEF) {
+    if ((rval = gff3_group_reader_read_line(&gr)) == -1) {
+      gt_error_set(err, "error reading BGZF file \"%s\"", gff3file);
+      had_err = -1;
+    }
+    if (rval != 0 || gr.line_offset >= ri->header_end)
+      break;
+    if (gff3_region_index_is_wanted_directive(gr.line, seqid)) {
+      gt_str_append_str(text, gr.line);
+      gt_str_append_char(text, '\n');
+    }
+  }
+
+  /* copy the overlapping top-level features */
+  seq = gt_hashmap_get(ri->seqid2seq, seqid);
+  window = (range->start - 1) >> GT_GFF3_REGION_INDEX_WINDOW_SHIFT;
+  if (seq)
+    window = window < seq->first_window ? 0 : window - seq->first_window;
+  if (!had_err && seq && window < gt_array_size(seq->offsets)) {
+    had_err = gff3_group_reader_seek(&gr,
+                                     *(GtUint64*) gt_array_get(seq->offsets,
+                                                               window),
+                                     err);
+    while (!had_err && (rval = gff3_group_reader_next(&gr, true, NULL,
+                                                      err)) == 1) {
+      if (strcmp(gt_str_get(gr.seqid), seqid) || gr.range.start > range->end)
+        break;
+      if (gt_range_overlap(&gr.range, range)) {
+        gt_str_append_str(text, gr.lines);
+        gt_str_append_cstr(text, GT_GFF_TERMINATOR"\n");
+        count++;
+      }
+    }
+    if (rval == -1)
+      had_err = -1;
+  }
+  gff3_group_reader_clean(&gr);
+  if (!had_err && num_of_features)
+    *num_of_features = count;
+  return had_err;
+}
+
+int gt_gff3_region_index_bgzip(const char *infile, const char *outfile,
+                               GtError *err)
+{
+  char *buf;
+  size_t nread;
+  FILE *in;
+  BGZF *out;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(infile && outfile);
+
+  if (!(in = gt_fa_fopen(infile, "rb", err)))
+    return -1;
+  if (!(out = bgzf_open(outfile, "w"))) {
+    gt_error_set(err, "cannot open BGZF file \"%s\" for writing", outfile);
+    gt_fa_xfclose(in);
+    return -1;
+  }
+  buf = gt_malloc(sizeof (char) * GT_GFF3_REGION_INDEX_BUFSIZE);
+  while (!had_err &&
+         (nread = fread(buf, sizeof (char), GT_GFF3_REGION_INDEX_BUFSIZE, in))
+         > 0) {
+    if (bgzf_write(out, buf, (int) nread) != (int) nread) {
+      gt_error_set(err, "cannot write BGZF file \"%s\"", outfile);
+      had_err = -1;
+    }
+  }
+  if (bgzf_close(out) != 0 && !had_err) {
+    gt_error_set(err, "cannot write BGZF file \"%s\"", outfile);
+    had_err = -1;
+  }
+  gt_free(buf);
+  gt_fa_xfclose(in);
+  return had_err;
+}
+
+void gt_gff3_region_index_delete(GtGFF3RegionIndex *ri)
+{
+  GtUword i;
+  if (!ri) return;
+  for (i = 0; i < gt_array_size(ri->seqs); i++)
+    gff3_region_index_seq_delete(*(GtGFF3RegionIndexSeq**)
+                                 gt_array_get(ri->seqs, i));
+  gt_array_delete(ri->seqs);
+  gt_hashmap_delete(ri->seqid2seq);
+  gt_free(ri);
+}
+
+static const char *gff3_region_index_test_file =
+  "##gff-version   3\n"
+  "##sequence-region   seq1 1 100000\n"
+  "##sequence-region   seq2 1 50000\n"
+  "seq1\t.\tgene\t100\t200\t.\t+\t.\tID=g1\n"
+  "seq1\t.\tmRNA\t100\t200\t.\t+\t.\tParent=g1\n"
+  "###\n"
+  "seq1\t.\tgene\t20000\t90000\t.\t+\t.\tID=g2\n"
+  "###\n"
+  "seq1\t.\tgene\t40000\t40100\t.\t+\t.\tID=g3\n"
+  "seq2\t.\tgene\t10\t20\t.\t+\t.\tID=g4\n"
+  "seq2\t.\tmatch\t30000\t30100\t.\t+\t.\tID=m1\n"
+  "seq2\t.\tmatch\t30200\t30300\t.\t+\t.\tID=m1\n"
+  "###\n"
+  "seq3\t.\tgene\t500000\t500100\t.\t+\t.\tID=g5\n";
+
+int gt_gff3_region_index_unit_test(GtError *err)
+{
+  GtGFF3RegionIndex *ri = NULL, *ri2 = NULL;
+  GtStr *plainfile, *bgzffile, *text;
+  GtUword num = 0;
+  GtRange range;
+  FILE *fp;
+  int had_err = 0;
+  gt_error_check(err);
+
+  plainfile = gt_str_new();
+  fp = gt_xtmpfp(plainfile);
+  gt_xfputs(gff3_region_index_test_file, fp);
+  gt_fa_xfclose(fp);
+  bgzffile = gt_str_clone(plainfile);
+  gt_str_append_cstr(bgzffile, ".gz");
+  text = gt_str_new();
+
+  had_err = gt_gff3_region_index_bgzip(gt_str_get(plainfile),
+                                       gt_str_get(bgzffile), err);
+  if (!had_err) {
+    /* plain files cannot be indexed */
+    GtError *testerr = gt_error_new();
+    gt_ensure(!gt_gff3_region_index_new_from_gff3(gt_str_get(plainfile),
+                                                  testerr));
+    gt_ensure(gt_error_is_set(testerr));
+    gt_error_delete(testerr);
+  }
+  if (!had_err &&
+      !(ri = gt_gff3_region_index_new_from_gff3(gt_str_get(bgzffile), err)))
+    had_err = -1;
+  if (!had_err)
+    had_err = gt_gff3_region_index_write(ri, gt_str_get(bgzffile), err);
+  if (!had_err) {
+    gt_ensure(gt_gff3_region_index_exists(gt_str_get(bgzffile)));
+    if (!(ri2 = gt_gff3_region_index_new_from_file(gt_str_get(bgzffile),
+                                                   err)))
+      had_err = -1;
+  }
+  if (!had_err) {
+    gt_ensure(gt_gff3_region_index_num_of_seqids(ri2) == 3);
+    /* feature spanning many windows */
+    range.start = 50000; range.end = 60000;
+    had_err = gt_gff3_region_index_extract(ri2, gt_str_get(bgzffile), "seq1",
+                                           &range, text, &num, err);
+    gt_ensure(num == 1);
+    gt_ensure(strstr(gt_str_get(text), "ID=g2") != NULL);
+    gt_ensure(strstr(gt_str_get(text), "ID=g3") == NULL);
+    gt_ensure(strstr(gt_str_get(text), "seq1 1 100000") != NULL);
+    gt_ensure(strstr(gt_str_get(text), "seq2 1 50000") == NULL);
+  }
+  if (!had_err) {
+    /* feature with child, group not terminated by ### */
+    gt_str_reset(text);
+    range.start = 150; range.end = 40050;
+    had_err = gt_gff3_region_index_extract(ri2, gt_str_get(bgzffile), "seq1",
+                                           &range, text, &num, err);
+    gt_ensure(num == 3);
+    gt_ensure(strstr(gt_str_get(text), "Parent=g1") != NULL);
+    gt_ensure(strstr(gt_str_get(text), "ID=g4") == NULL);
+  }
+  if (!had_err) {
+    gt_str_reset(text);
+    range.start = 1; range.end = 100;
+    had_err = gt_gff3_region_index_extract(ri2, gt_str_get(bgzffile), "seq2",
+                                           &range, text, &num, err);
+    gt_ensure(num == 1);
+    gt_ensure(strstr(gt_str_get(text), "ID=g4") != NULL);
+  }
+  if (!had_err) {
+    /* the lines of a multi-line feature form a single group */
+    gt_str_reset(text);
+    range.start = 30250; range.end = 30260;
+    had_err = gt_gff3_region_index_extract(ri2, gt_str_get(bgzffile), "seq2",
+                                           &range, text, &num, err);
+    gt_ensure(num == 1);
+    gt_ensure(strstr(gt_str_get(text), "\t30000\t30100\t") != NULL);
+    gt_ensure(strstr(gt_str_get(text), "\t30200\t30300\t") != NULL);
+  }
+  if (!had_err) {
+    /* no overlap, inside and beyond the indexed windows */
+    range.start = 95000; range.end = 99000;
+    had_err = gt_gff3_region_index_extract(ri2, gt_str_get(bgzffile), "seq1",
+                                           &range, text, &num, err);
+    gt_ensure(num == 0);
+    range.start = 99000; range.end = 99500;
+    if (!had_err)
+      had_err = gt_gff3_region_index_extract(ri2, gt_str_get(bgzffile),
+                                             "seq1", &range, text, &num, err);
+    gt_ensure(num == 0);
+  }
+  if (!had_err) {
+    /* query starting before the first indexed window */
+    gt_str_reset(text);
+    range.start = 1; range.end = 600000;
+    had_err = gt_gff3_region_index_extract(ri2, gt_str_get(bgzffile), "seq3",
+                                           &range, text, &num, err);
+    gt_ensure(num == 1);
+    gt_ensure(strstr(gt_str_get(text), "ID=g5") != NULL);
+  }
+  if (!had_err) {
+    /* length fields exceeding the file are rejected */
+    GtUint64 values[3] = { 0, 1, 1ULL << 40 };
+    GtError *testerr = gt_error_new();
+    gt_str_reset(text);
+    gt_str_append_str(text, bgzffile);
+    gt_str_append_cstr(text, GT_GFF3_REGION_INDEX_SUFFIX);
+    fp = gt_fa_xfopen(gt_str_get(text), "wb");
+    gt_xfwrite(GT_GFF3_REGION_INDEX_MAGIC, sizeof (char),
+               strlen(GT_GFF3_REGION_INDEX_MAGIC), fp);
+    gt_xfwrite(values, sizeof (GtUint64), 3, fp);
+    gt_fa_xfclose(fp);
+    gt_ensure(!gt_gff3_region_index_new_from_file(gt_str_get(bgzffile),
+                                                  testerr));
+    gt_ensure(gt_error_is_set(testerr));
+    gt_error_delete(testerr);
+  }
+
+  gt_gff3_region_index_delete(ri);
+  gt_gff3_region_index_delete(ri2);
+  gt_xremove(gt_str_get(plainfile));
+  if (gt_file_exists(gt_str_get(bgzffile)))
+    gt_xremove(gt_str_get(bgzffile));
+  gt_str_append_cstr(bgzffile, GT_GFF3_REGION_INDEX_SUFFIX);
+  if (gt_file_exists(gt_str_get(bgzffile)))
+    gt_xremove(gt_str_get(bgzffile));
+  gt_str_delete(plainfile);
+  gt_str_delete(bgzffile);
+  gt_str_delete(text);
+  return had_err;
+}
@@ -0,0 +1,75 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef GFF3_REGION_INDEX_H
+#define GFF3_REGION_INDEX_H
+
+#include "core/error_api.h"
+#include "core/range_api.h"
+#include "core/str_api.h"
+#include "core/types_api.h"
+
+/* Suffix of the index file belonging to a BGZF compressed GFF3 file. */
+#define GT_GFF3_REGION_INDEX_SUFFIX ".gti"
+
+/* A <GtGFF3RegionIndex> allows random access to the top-level features of a
+   BGZF compressed, coordinate-sorted GFF3 file (as written by
+   <gt gff3 -sort>, compressed with <bgzip> or <gt gff3_index -compress>).
+   Similar to the linear index of tabix, the index stores for each sequence
+   region and each window of 16 kb (from the window containing the first
+   feature on) the virtual file offset of the first top-level feature
+   overlapping the window. Top-level features are delimited
+   by ### lines or by lines without a Parent attribute. */
+typedef struct GtGFF3RegionIndex GtGFF3RegionIndex;
+
+/* Scan the BGZF compressed GFF3 file <gff3file> and return an index for it.
+   Returns NULL and sets <err> if the file is not BGZF compressed or not
+   sorted. */
+GtGFF3RegionIndex* gt_gff3_region_index_new_from_gff3(const char *gff3file,
+                                                      GtError *err);
+/* Read the index belonging to <gff3file> from <gff3file>.gti. */
+GtGFF3RegionIndex* gt_gff3_region_index_new_from_file(const char *gff3file,
+                                                      GtError *err);
+/* Write <ri> to <gff3file>.gti. */
+int                gt_gff3_region_index_write(const GtGFF3RegionIndex *ri,
+                                              const char *gff3file,
+                                              GtError *err);
+/* Returns true if an index file exists for <gff3file>. */
+bool               gt_gff3_region_index_exists(const char *gff3file);
+/* Return the number of sequence regions indexed in <ri>. */
+GtUword            gt_gff3_region_index_num_of_seqids(
+                                                 const GtGFF3RegionIndex *ri);
+/* Append to <text> the GFF3 lines of all top-level features on <seqid> in
+   BGZF compressed <gff3file> which overlap <range>, each terminated by a ###
+   line. The ##gff-version and the matching ##sequence-region directives of the
+   header are prepended. Returns the number of top-level features in
+   <num_of_features> (if not NULL). */
+int                gt_gff3_region_index_extract(const GtGFF3RegionIndex *ri,
+                                                const char *gff3file,
+                                                const char *seqid,
+                                                const GtRange *range,
+                                                GtStr *text,
+                                                GtUword *num_of_features,
+                                                GtError *err);
+/* Compress the plain text GFF3 file <infile> into the BGZF file <outfile>. */
+int                gt_gff3_region_index_bgzip(const char *infile,
+                                              const char *outfile,
+                                              GtError *err);
+void               gt_gff3_region_index_delete(GtGFF3RegionIndex *ri);
+
+int                gt_gff3_region_index_unit_test(GtError *err);
+
+#endif
@@ -315,7 +315,10 @@ static int store_ids(GtFeatureNode *fn, void *data, GtError *err)
                           gt_feature_node_get_multi_representative(fn));
       if (!id) {
         /* the representative does not have its own id yet -> create it */
-        if (gff3_visitor->retain_ids) {
+        if (gff3_visitor->retain_ids &&
+            gt_feature_node_get_attribute(
+                                gt_feature_node_get_multi_representative(fn),
+                                "ID")) {
           id = make_id_unique(gff3_visitor,
                               gt_feature_node_get_multi_representative(fn));
         }
@@ -331,7 +334,7 @@ static int store_ids(GtFeatureNode *fn, void *data, GtError *err)
       }
     }
     else {
-      if (gff3_visitor->retain_ids)
+      if (gff3_visitor->retain_ids && gt_feature_node_get_attribute(fn, "ID"))
         id = make_id_unique(gff3_visitor, fn);
       else
         id = create_unique_id(gff3_visitor, fn);
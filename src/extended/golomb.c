@@ -175,6 +175,57 @@ int gt_golomb_bitwise_decoder_next(GtGolombBitwiseDecoder *gbwd,
   return -1;
 }
 
+/* Returns the <numofbits> bits of <bits> starting at bit <start>, counted from
+   the most significant bit. */
+static inline GtUword golomb_extract_bits(GtBitsequence bits,
+                                          unsigned int start,
+                                          unsigned int numofbits)
+{
+  if (numofbits == 0)
+    return 0;
+  return (GtUword) ((bits << start) >> (GT_INTWORDSIZE - numofbits));
+}
+
+unsigned int gt_golomb_bitwise_decoder_next_bits(GtGolombBitwiseDecoder *gbwd,
+                                                 GtBitsequence bits,
+                                                 unsigned int numofbits,
+                                                 GtUword *x)
+{
+  unsigned int quotient,
+               pos,
+               len;
+  GtUword remain;
+  gt_assert(gbwd);
+  gt_assert(gbwd->status == IN_Q && gbwd->quotient == 0);
+
+  /* the quotient is unary coded by 1s terminated by a 0 */
+  if (~bits == 0)
+    return 0;
+  quotient = gt_intbits_leading_zeros(~bits);
+  pos = quotient + 1U;
+  len = (unsigned int) gbwd->len;
+
+  if (len == 0) {
+    if (pos + 1U > numofbits)
+      return 0;
+    *x = (GtUword) quotient * gbwd->median + golomb_extract_bits(bits, pos, 1U);
+    return pos + 1U;
+  }
+  if (pos + len - 1U > numofbits)
+    return 0;
+  remain = golomb_extract_bits(bits, pos, len - 1U);
+  if (remain < gbwd->two_pow_len - gbwd->median) {
+    *x = (GtUword) quotient * gbwd->median + remain;
+    return pos + len - 1U;
+  }
+  if (pos + len > numofbits)
+    return 0;
+  remain = golomb_extract_bits(bits, pos, len) -
+           (gbwd->two_pow_len - gbwd->median);
+  *x = (GtUword) quotient * gbwd->median + remain;
+  return pos + len;
+}
+
 void gt_golomb_delete(GtGolomb *golomb)
 {
   gt_free(golomb);
@@ -198,6 +249,8 @@ int gt_golomb_unit_test(GtError *err)
                 idx_k,
                 number = unit_test_x_size + 1,
                 unit_test_b_size = 256UL;
+  unsigned int size;
+  GtBitsequence bits;
 
   for (idx_j = 1UL; !had_err && idx_j <= unit_test_b_size; idx_j++) {
     golomb = gt_golomb_new(idx_j);
@@ -214,6 +267,24 @@ int gt_golomb_unit_test(GtError *err)
 
       gt_ensure(stat == 0);
       gt_ensure(number == idx_k);
+
+      /* decode the whole code at once, followed by set bits */
+      size = (unsigned int) gt_bittab_size(code);
+      if (size < (unsigned int) GT_INTWORDSIZE) {
+        bits = ~((GtBitsequence) 0) >> size;
+        for (idx_i = 0; idx_i < (GtUword) size; idx_i++) {
+          if (gt_bittab_bit_is_set(code, idx_i))
+            bits |= GT_FIRSTBIT >> idx_i;
+        }
+        number = unit_test_x_size + 1;
+        gt_ensure(gt_golomb_bitwise_decoder_next_bits(
+                                            gbwd, bits,
+                                            (unsigned int) GT_INTWORDSIZE,
+                                            &number) == size);
+        gt_ensure(number == idx_k);
+        gt_ensure(gt_golomb_bitwise_decoder_next_bits(gbwd, bits, size - 1,
+                                                      &number) == 0);
+      }
       gt_bittab_delete(code);
     }
     gt_golomb_bitwise_decoder_delete(gbwd);
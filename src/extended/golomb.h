@@ -21,6 +21,7 @@
 
 #include "core/bittab_api.h"
 #include "core/error_api.h"
+#include "core/intbits.h"
 
 /* The <GtGolomb> class stores information to encode integers with Golomb
    encoding. See Golomb, S.W. (1966), Run-length encodings. */
@@ -57,6 +58,16 @@ int                     gt_golomb_bitwise_decoder_next(
                                                    GtGolombBitwiseDecoder *gbwd,
                                                    bool bit, GtUword *x);
 
+/* Decodes a whole code word at once from the <numofbits> most significant
+   bits of <bits>. Writes its decoding to <x> and returns the length of the
+   code word, or 0 if it is longer than <numofbits>. <gbwd> must not be inside
+   a code word. */
+unsigned int            gt_golomb_bitwise_decoder_next_bits(
+                                                   GtGolombBitwiseDecoder *gbwd,
+                                                   GtBitsequence bits,
+                                                   unsigned int numofbits,
+                                                   GtUword *x);
+
 /* Deletes <gcbd>. */
 void                    gt_golomb_bitwise_decoder_delete(
                                                   GtGolombBitwiseDecoder *gbwd);
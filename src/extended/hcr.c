@@ -35,6 +35,7 @@
 #include "core/intbits.h"
 #include "core/log_api.h"
 #include "core/ma_api.h"
+#include "core/multithread_api.h"
 #include "core/safearith_api.h"
 #include "core/seq_iterator_fastq_api.h"
 #include "core/str_array.h"
@@ -55,6 +56,7 @@
 #define HCR_DESCSEPSEQ '@'
 #define HCR_DESCSEPQUAL '+'
 #define HCR_PAGES_PER_CHUNK 10UL
+#define HCR_DECODE_BLOCKS_PER_JOB 4UL
 
 typedef struct GtBaseQualDistr {
   GtUint64 **distr;
@@ -1024,6 +1026,239 @@ int gt_hcr_decoder_decode(GtHcrDecoder *hcr_dec, GtUword readnum,
   return had_err;
 }
 
+static void hcr_append_formatted(GtStr *out, const char *line, GtUword width)
+{
+  GtUword i, cur_width;
+
+  for (i = 0, cur_width = 0; line[i] != '\0'; i++, cur_width++) {
+    if (width != 0 && cur_width == width) {
+      cur_width = 0;
+      gt_str_append_char(out, '\n');
+    }
+    gt_str_append_char(out, line[i]);
+  }
+  gt_str_append_char(out, '\n');
+}
+
+/* reads <first_read> to <last_read> of one sample, which can be decoded
+   independently of all other samples */
+typedef struct HcrDecodeBlock {
+  GtStr   *seqquals;
+  GtUword *ends,
+           sample,
+           first_read,
+           last_read;
+  size_t   startofsample;
+} HcrDecodeBlock;
+
+typedef struct HcrDecodeThreadInfo {
+  GtHcrSeqDecoder *seq_dec;
+  HcrDecodeBlock  *blocks;
+  GtError         *err;
+  GtMutex         *mutex;
+  GtUword          next_block,
+                   num_of_blocks,
+                   width;
+  int              had_err;
+} HcrDecodeThreadInfo;
+
+/* Decodes the sequences and qualities of the blocks with a private data
+   iterator and huffman decoder. The huffman tree and file infos of the shared
+   decoder are only read. */
+static void *hcr_decode_blocks_thread(void *data)
+{
+  HcrDecodeThreadInfo *info = data;
+  GtHcrSeqDecoder seq_dec = *info->seq_dec;
+  GtError *err = gt_error_new();
+  GtUword idx, readnum, max_readlength = 0;
+  char *seq, *qual;
+  int had_err = 0;
+
+  for (idx = 0; idx < seq_dec.num_of_files; idx++) {
+    if (seq_dec.fileinfos[idx].readlength > max_readlength)
+      max_readlength = seq_dec.fileinfos[idx].readlength;
+  }
+  seq = gt_malloc(sizeof (*seq) * (max_readlength + 1));
+  qual = gt_malloc(sizeof (*qual) * (max_readlength + 1));
+  seq_dec.sampling = NULL;
+  seq_dec.symbols = NULL;
+  seq_dec.data_iter =
+    decoder_init_data_iterator((GtWord) info->seq_dec->data_iter->start,
+                               (GtWord) info->seq_dec->data_iter->end,
+                               seq_dec.filename);
+  seq_dec.huff_dec =
+    gt_huffman_decoder_new_from_memory(seq_dec.huffman,
+                                       get_next_file_chunk_for_huffman,
+                                       seq_dec.data_iter, err);
+  if (seq_dec.huff_dec == NULL)
+    had_err = -1;
+
+  while (!had_err) {
+    HcrDecodeBlock *block;
+
+    gt_mutex_lock(info->mutex);
+    idx = info->next_block++;
+    if (info->had_err)
+      idx = info->num_of_blocks;
+    gt_mutex_unlock(info->mutex);
+    if (idx >= info->num_of_blocks)
+      break;
+    block = info->blocks + idx;
+    reset_data_iterator_to_pos(seq_dec.data_iter, block->startofsample);
+    had_err = gt_huffman_decoder_get_new_mem_chunk(seq_dec.huff_dec, err);
+    seq_dec.cur_read = block->sample;
+    for (readnum = block->sample;
+         !had_err && readnum <= block->last_read;
+         readnum++) {
+      if (hcr_next_seq_qual(&seq_dec, seq, qual, err) == -1)
+        had_err = -1;
+      else if (readnum >= block->first_read) {
+        hcr_append_formatted(block->seqquals, seq, info->width);
+        gt_str_append_char(block->seqquals, HCR_DESCSEPQUAL);
+        gt_str_append_char(block->seqquals, '\n');
+        hcr_append_formatted(block->seqquals, qual, info->width);
+        block->ends[readnum - block->first_read] =
+          gt_str_length(block->seqquals);
+      }
+    }
+  }
+  if (had_err) {
+    gt_mutex_lock(info->mutex);
+    if (!info->had_err) {
+      info->had_err = had_err;
+      gt_error_set(info->err, "%s", gt_error_get(err));
+    }
+    gt_mutex_unlock(info->mutex);
+  }
+
+  gt_huffman_decoder_delete(seq_dec.huff_dec);
+  data_iterator_delete(seq_dec.data_iter);
+  gt_array_delete(seq_dec.symbols);
+  gt_free(seq);
+  gt_free(qual);
+  gt_error_delete(err);
+  return NULL;
+}
+
+/* Splits the range <start>..<end> at the samples of <sampling>. */
+static HcrDecodeBlock *hcr_decode_blocks_new(GtSampling *sampling,
+                                             GtUword start, GtUword end,
+                                             GtUword *num_of_blocks)
+{
+  HcrDecodeBlock *blocks = NULL;
+  GtUword sample, next_sample, allocated = 0;
+  size_t startofsample;
+
+  *num_of_blocks = 0;
+  gt_sampling_get_page(sampling, start, &sample, &startofsample);
+  while (true) {
+    HcrDecodeBlock *block;
+
+    if (*num_of_blocks == allocated) {
+      allocated += allocated / 2 + 16UL;
+      blocks = gt_realloc(blocks, sizeof (*blocks) * allocated);
+    }
+    block = blocks + (*num_of_blocks)++;
+    block->seqquals = NULL;
+    block->ends = NULL;
+    block->sample = sample;
+    block->startofsample = startofsample;
+    block->first_read = sample < start ? start : sample;
+    /* next element number is 0 for the last sample */
+    next_sample = gt_sampling_get_next_elementnum(sampling);
+    if (next_sample == 0 || end < next_sample) {
+      block->last_read = end;
+      break;
+    }
+    block->last_read = next_sample - 1;
+    (void) gt_sampling_get_next_sample(sampling, &sample, &startofsample);
+  }
+  return blocks;
+}
+
+/* Decodes the reads <start> to <end> in blocks between samples, which are
+   decoded by <gt_jobs> threads. To bound the memory, only
+   <gt_jobs> * HCR_DECODE_BLOCKS_PER_JOB blocks are kept in memory at a time.
+   Descriptions are decoded serially when the blocks are written in order, so
+   the output does not depend on the number of threads. */
+static int hcr_decode_range_parallel(GtHcrDecoder *hcr_dec, FILE *output,
+                                     GtUword start, GtUword end,
+                                     GtUword width, GtError *err)
+{
+  int had_err = 0;
+  GtHcrSeqDecoder *seq_dec = hcr_dec->seq_dec;
+  HcrDecodeBlock *blocks;
+  HcrDecodeThreadInfo info;
+  GtStr *desc = gt_str_new();
+  GtUword idx, round_start, round_size, num_of_blocks, readnum,
+          max_round_size = (GtUword) gt_jobs * HCR_DECODE_BLOCKS_PER_JOB;
+  GtUword nearestsample;
+  size_t startofnearestsample;
+
+  blocks = hcr_decode_blocks_new(seq_dec->sampling, start, end,
+                                 &num_of_blocks);
+  gt_log_log("decode " GT_WU " blocks with " GT_WU " threads", num_of_blocks,
+             (GtUword) gt_jobs);
+  info.seq_dec = seq_dec;
+  info.err = err;
+  info.mutex = gt_mutex_new();
+  info.width = width;
+  info.had_err = 0;
+
+  for (round_start = 0;
+       !had_err && round_start < num_of_blocks;
+       round_start += round_size) {
+    round_size = num_of_blocks - round_start < max_round_size ?
+                 num_of_blocks - round_start : max_round_size;
+    for (idx = round_start; idx < round_start + round_size; idx++) {
+      blocks[idx].seqquals = gt_str_new();
+      blocks[idx].ends = gt_malloc(sizeof (*blocks[idx].ends) *
+                                   (blocks[idx].last_read -
+                                    blocks[idx].first_read + 1));
+    }
+    info.blocks = blocks + round_start;
+    info.num_of_blocks = round_size;
+    info.next_block = 0;
+    had_err = gt_multithread(hcr_decode_blocks_thread, &info, err);
+    if (!had_err)
+      had_err = info.had_err;
+
+    for (idx = round_start; idx < round_start + round_size; idx++) {
+      HcrDecodeBlock *block = blocks + idx;
+      GtUword prev_end = 0;
+      for (readnum = block->first_read;
+           !had_err && readnum <= block->last_read;
+           readnum++) {
+        GtUword cur_end = block->ends[readnum - block->first_read];
+        gt_xfputc(HCR_DESCSEPSEQ, output);
+        if (hcr_dec->encdesc != NULL) {
+          had_err = gt_encdesc_decode(hcr_dec->encdesc, readnum, desc, err);
+          if (!had_err)
+            gt_xfputs(gt_str_get(desc), output);
+        }
+        else
+          fprintf(output, ""GT_WU"", readnum);
+        gt_xfputc('\n', output);
+        gt_xfwrite(gt_str_get(block->seqquals) + prev_end, sizeof (char),
+                   (size_t) (cur_end - prev_end), output);
+        prev_end = cur_end;
+      }
+      gt_str_delete(block->seqquals);
+      gt_free(block->ends);
+    }
+  }
+
+  /* the sampling was moved, restore the state expected by
+     hcr_next_seq_qual() for the read following cur_read - 1 */
+  gt_sampling_get_page(seq_dec->sampling,
+                       seq_dec->cur_read > 0 ? seq_dec->cur_read - 1 : 0,
+                       &nearestsample, &startofnearestsample);
+  gt_mutex_delete(info.mutex);
+  gt_free(blocks);
+  gt_str_delete(desc);
+  return had_err;
+}
+
 int gt_hcr_decoder_decode_range(GtHcrDecoder *hcr_dec, const char *name,
                                 GtUword start, GtUword end, GtUword width,
                                 GtTimer *timer, GtError *err)
@@ -1049,6 +1284,13 @@ int gt_hcr_decoder_decode_range(GtHcrDecoder *hcr_dec, const char *name,
   if (output == NULL)
     had_err = -1;
 
+  /* without sampling the reads can only be decoded from the start */
+  if (!had_err && seq_dec->sampling != NULL) {
+    had_err = hcr_decode_range_parallel(hcr_dec, output, start, end, width,
+                                        err);
+    start = end + 1;
+  }
+
   for (cur_read = start; had_err == 0 && cur_read <= end; cur_read++) {
     if (gt_hcr_decoder_decode(hcr_dec, cur_read, seq, qual, desc, err) != 0)
       had_err = -1;
@@ -93,7 +93,9 @@ int           gt_hcr_decoder_decode(GtHcrDecoder *hcr_dec,
 /* Decodes the hcr encoded file starting at record number <start> until record
    number <end> and writes the decoding to a file with base name <name>. If
    <width> is not 0 output of sequences and qualities will have that width. Be
-   advised to not use this if the data should be machine readable. */
+   advised to not use this if the data should be machine readable. If the file
+   was encoded with sampling, the reads between two samples are decoded as
+   independent blocks by <gt_jobs> threads. */
 int           gt_hcr_decoder_decode_range(GtHcrDecoder *hcr_dec,
                                           const char *name, GtUword start,
                                           GtUword end, GtUword width,
@@ -30,6 +30,11 @@
 #include "extended/huffcode.h"
 #include "extended/rbtree_api.h"
 
+/* maximal number of bits used to index the decoding table */
+#define GT_HUFFMAN_LOOKUP_BITS 10U
+/* maximal number of symbols decoded by one table lookup */
+#define GT_HUFFMAN_LOOKUP_SYMBOLS 4U
+
 typedef struct GtHuffmanSymbol {
   GtUint64 freq;
   GtUword      symbol;
@@ -48,13 +53,28 @@ typedef struct GtHuffmanTree {
   unsigned int          reference_count;
 } GtHuffmanTree;
 
+/* Entry of the table for decoding, indexed by the next lookup_bits bits of
+   the input. If numofsymbols > 0 the bits start with the codes of the given
+   symbols and bits[i] is the number of bits used by the codes of symbols
+   0 to i. Otherwise the bits are a prefix of a longer code and node is the
+   inner node of the tree reached by them. */
+typedef struct GtHuffmanLookup {
+  GtUword        symbols[GT_HUFFMAN_LOOKUP_SYMBOLS];
+  GtHuffmanTree *node;
+  unsigned char  bits[GT_HUFFMAN_LOOKUP_SYMBOLS],
+                 numofsymbols;
+} GtHuffmanLookup;
+
 struct GtHuffman {
-  uint64_t       num_of_text_bits,    /* total bits needed to represent the text
-                                       */
-                 num_of_text_symbols; /* total number of characters in text */
-  GtHuffmanTree *root_huffman_tree;   /* stores the final huffmantree */
-  GtRBTree      *rbt_root;            /* red black tree */
-  GtHuffmanCode *code_tab;            /* table for encoding */
+  uint64_t         num_of_text_bits,    /* total bits needed to represent the
+                                           text */
+                   num_of_text_symbols; /* total number of characters in text */
+  GtHuffmanTree   *root_huffman_tree;   /* stores the final huffmantree */
+  GtRBTree        *rbt_root;            /* red black tree */
+  GtHuffmanCode   *code_tab;            /* table for encoding */
+  GtHuffmanLookup *lookup_tab;          /* table for decoding, NULL if the tree
+                                           has only one node */
+  unsigned int     lookup_bits;
   GtUword  num_of_coded_symbols, /* number of nodes in red black tree, */
                                       /* e.g. symbols with frequency > 0*/
                  num_of_symbols;      /* symbols with frequency >= 0 */
@@ -334,6 +354,51 @@ static int visit_huffman_leaves_rec(GtHuffmanTree *h_tree,
   return had_err;
 }
 
+static void huffman_lookup_tab_init(GtHuffman *huff)
+{
+  GtUword idx, num_of_entries, i;
+  unsigned int max_bits = 0;
+
+  huff->lookup_tab = NULL;
+  huff->lookup_bits = 0;
+  if (huff->root_huffman_tree == NULL ||
+      huff->root_huffman_tree->leftchild == NULL)
+    return;
+
+  for (i = 0; i < huff->num_of_symbols; i++) {
+    if (huff->code_tab[i].numofbits > max_bits)
+      max_bits = huff->code_tab[i].numofbits;
+  }
+  huff->lookup_bits = max_bits < GT_HUFFMAN_LOOKUP_BITS ?
+                      max_bits : GT_HUFFMAN_LOOKUP_BITS;
+  num_of_entries = 1UL << huff->lookup_bits;
+  huff->lookup_tab = gt_malloc(sizeof (*huff->lookup_tab) * num_of_entries);
+
+  for (idx = 0; idx < num_of_entries; idx++) {
+    GtHuffmanLookup *entry = huff->lookup_tab + idx;
+    GtHuffmanTree *node = huff->root_huffman_tree;
+    unsigned int bit;
+
+    entry->numofsymbols = 0;
+    for (bit = 0;
+         bit < huff->lookup_bits &&
+         entry->numofsymbols < GT_HUFFMAN_LOOKUP_SYMBOLS;
+         bit++) {
+      if ((idx >> (huff->lookup_bits - 1 - bit)) & 1UL)
+        node = node->rightchild;
+      else
+        node = node->leftchild;
+      if (node->leftchild == NULL) {
+        entry->symbols[entry->numofsymbols] = node->symbol.symbol;
+        gt_safe_assign(entry->bits[entry->numofsymbols], bit + 1);
+        entry->numofsymbols++;
+        node = huff->root_huffman_tree;
+      }
+    }
+    entry->node = node;
+  }
+}
+
 GtHuffman *gt_huffman_new(const void *distribution,
                           GtDistrFunc distr_func,
                           GtUword num_of_symbols)
@@ -356,6 +421,7 @@ GtHuffman *gt_huffman_new(const void *distribution,
   huffman_tree_set_codes_rec(huff->root_huffman_tree);
   (void) gt_huffman_iterate(huff, calc_size, huff);
   (void) gt_huffman_iterate(huff, store_codes, huff);
+  huffman_lookup_tab_init(huff);
 
   return huff;
 }
@@ -365,6 +431,7 @@ void gt_huffman_delete(GtHuffman *huffman)
   if (huffman != NULL) {
     gt_rbtree_delete(huffman->rbt_root);
     gt_free(huffman->code_tab);
+    gt_free(huffman->lookup_tab);
   }
   gt_free(huffman);
 }
@@ -505,9 +572,11 @@ int gt_huffman_decoder_next(GtHuffmanDecoder *huff_decoder,
   int had_err = 0,
       bits_to_read = GT_INTWORDSIZE;
   GtUword read_symbols = 0;
+  const GtHuffman *huffman;
 
   gt_assert((symbols_to_read > 0) && huff_decoder &&
             (gt_array_elem_size(symbols) == sizeof (GtUword)));
+  huffman = huff_decoder->huffman;
 
   if (huff_decoder->cur_bitseq == huff_decoder->length - 1)
     gt_safe_assign(bits_to_read, (GT_INTWORDSIZE - huff_decoder->pad_length));
@@ -529,6 +598,32 @@ int gt_huffman_decoder_next(GtHuffmanDecoder *huff_decoder,
     /* huffman was initialized with empty dist */
     gt_assert(huff_decoder->cur_node != NULL);
 
+    /* decode up to GT_HUFFMAN_LOOKUP_SYMBOLS symbols with one table lookup if
+       the next lookup_bits bits are in the current bitsequence */
+    if (huffman->lookup_tab != NULL &&
+        huff_decoder->cur_node == huffman->root_huffman_tree &&
+        huff_decoder->cur_bit + huffman->lookup_bits <=
+          (GtUword) bits_to_read) {
+      GtHuffmanLookup *entry =
+        huffman->lookup_tab +
+        ((huff_decoder->bitsequence[huff_decoder->cur_bitseq] <<
+          huff_decoder->cur_bit) >> (GT_INTWORDSIZE - huffman->lookup_bits));
+      if (entry->numofsymbols == 0) {
+        huff_decoder->cur_node = entry->node;
+        huff_decoder->cur_bit += huffman->lookup_bits;
+      }
+      else {
+        unsigned int idx;
+        for (idx = 0;
+             idx < (unsigned int) entry->numofsymbols &&
+             read_symbols < symbols_to_read;
+             idx++, read_symbols++)
+          gt_array_add(symbols, entry->symbols[idx]);
+        huff_decoder->cur_bit += entry->bits[idx - 1];
+      }
+      continue;
+    }
+
     if (!had_err && huff_decoder->cur_bit == (GtUword) bits_to_read) {
       huff_decoder->cur_bitseq++;
 
@@ -637,6 +732,60 @@ int gt_huffman_bitwise_decoder_next(GtHuffmanBitwiseDecoder *hbwd,
   return status;
 }
 
+unsigned int gt_huffman_decode_bits(const GtHuffman *huffman,
+                                    GtBitsequence bits,
+                                    unsigned int numofbits,
+                                    GtUword *symbol)
+{
+  const GtHuffmanTree *node;
+  unsigned int used_bits = 0;
+
+  gt_assert(huffman != NULL && huffman->root_huffman_tree != NULL);
+  gt_assert(numofbits <= (unsigned int) GT_INTWORDSIZE);
+  node = huffman->root_huffman_tree;
+
+  /* as in the bitwise decoder, a tree with only one node uses one bit */
+  if (node->leftchild == NULL) {
+    if (numofbits == 0)
+      return 0;
+    *symbol = node->symbol.symbol;
+    return 1U;
+  }
+  if (numofbits >= huffman->lookup_bits) {
+    const GtHuffmanLookup *entry =
+      huffman->lookup_tab + (bits >> (GT_INTWORDSIZE - huffman->lookup_bits));
+    if (entry->numofsymbols > 0) {
+      *symbol = entry->symbols[0];
+      return (unsigned int) entry->bits[0];
+    }
+    node = entry->node;
+    used_bits = huffman->lookup_bits;
+  }
+  while (used_bits < numofbits) {
+    if (GT_ISBITSET(bits, used_bits))
+      node = node->rightchild;
+    else
+      node = node->leftchild;
+    used_bits++;
+    if (node->leftchild == NULL) {
+      *symbol = node->symbol.symbol;
+      return used_bits;
+    }
+  }
+  return 0;
+}
+
+unsigned int gt_huffman_bitwise_decoder_next_bits(
+                                                  GtHuffmanBitwiseDecoder *hbwd,
+                                                  GtBitsequence bits,
+                                                  unsigned int numofbits,
+                                                  GtUword *symbol)
+{
+  gt_assert(hbwd != NULL);
+  gt_assert(hbwd->cur_node == hbwd->huffman->root_huffman_tree);
+  return gt_huffman_decode_bits(hbwd->huffman, bits, numofbits, symbol);
+}
+
 void gt_huffman_bitwise_decoder_delete(GtHuffmanBitwiseDecoder *hbwd)
 {
   gt_free(hbwd);
@@ -680,6 +829,15 @@ static int test_bitwise(GtError *err)
     gt_ensure(j == (GtUword) length2);
     gt_ensure(symbol == i);
     length1 = length2;
+    if (!had_err) {
+      bitseq <<= GT_INTWORDSIZE - length2;
+      gt_ensure(gt_huffman_bitwise_decoder_next_bits(hbwd, bitseq, length2,
+                                                     &symbol) == length2);
+      gt_ensure(symbol == i);
+      gt_ensure(gt_huffman_bitwise_decoder_next_bits(hbwd, bitseq,
+                                                     length2 - 1,
+                                                     &symbol) == 0);
+    }
   }
 
   stat = gt_huffman_bitwise_decoder_next(hbwd, true, &symbol, err);
@@ -955,6 +1113,94 @@ int test_mem(GtError *err)
   return had_err;
 }
 
+/* fibonacci frequencies lead to codes longer than GT_HUFFMAN_LOOKUP_BITS,
+   which are decoded partly by table lookup and partly bitwise */
+static int test_long_codes(GtError *err)
+{
+  int had_err = 0,
+      decoder_stat;
+  unsigned int code_len,
+               bits_remain = (unsigned int) GT_INTWORDSIZE;
+  GtUword idx,
+          symbol,
+          bitpos,
+          total_bits;
+  const GtUword dist_size = 20UL,
+                num_of_symbols = 2000UL;
+  GtUint64 distribution[20];
+  GtBitsequence buffer = 0,
+                code;
+  GtArray *codes = gt_array_new(sizeof (GtBitsequence)),
+          *decoded = gt_array_new(sizeof (GtUword));
+  GtHuffman *huff;
+  GtHuffmanDecoder *huffdec;
+
+  distribution[0] = distribution[1] = 1ULL;
+  for (idx = 2UL; idx < dist_size; idx++)
+    distribution[idx] = distribution[idx - 1] + distribution[idx - 2];
+  huff = gt_huffman_new(distribution, unit_test_distr_func, dist_size);
+  gt_huffman_encode(huff, 0, &code, &code_len);
+  gt_ensure(code_len > GT_HUFFMAN_LOOKUP_BITS);
+
+  for (idx = 0; idx < num_of_symbols; idx++) {
+    symbol = (idx * 7UL) % dist_size;
+    gt_huffman_encode(huff, symbol, &code, &code_len);
+    if (bits_remain < code_len) {
+      unsigned int overhang = code_len - bits_remain;
+      buffer |= code >> overhang;
+      gt_array_add(codes, buffer);
+      buffer = 0;
+      bits_remain = (unsigned int) GT_INTWORDSIZE - overhang;
+    }
+    else
+      bits_remain -= code_len;
+    buffer |= code << bits_remain;
+  }
+  gt_array_add(codes, buffer);
+
+  huffdec = gt_huffman_decoder_new(huff, gt_array_get_space(codes),
+                                   gt_array_size(codes), 0,
+                                   (GtUword) bits_remain);
+  decoder_stat = gt_huffman_decoder_next(huffdec, decoded, num_of_symbols,
+                                         err);
+  gt_ensure(decoder_stat == 1);
+  gt_ensure(gt_array_size(decoded) == num_of_symbols);
+  for (idx = 0; !had_err && idx < num_of_symbols; idx++) {
+    gt_ensure(*(GtUword *) gt_array_get(decoded, idx) ==
+              (idx * 7UL) % dist_size);
+  }
+  if (!had_err) {
+    decoder_stat = gt_huffman_decoder_next(huffdec, decoded, 1UL, err);
+    gt_ensure(decoder_stat == 0);
+  }
+
+  /* decode the same data with windows of up to GT_INTWORDSIZE bits */
+  total_bits = gt_array_size(codes) * GT_INTWORDSIZE - bits_remain;
+  for (idx = 0, bitpos = 0; !had_err && idx < num_of_symbols; idx++) {
+    GtUword word = bitpos / GT_INTWORDSIZE,
+            offset = bitpos % GT_INTWORDSIZE;
+    unsigned int numofbits;
+    code = *(GtBitsequence *) gt_array_get(codes, word) << offset;
+    if (offset > 0 && word + 1 < gt_array_size(codes))
+      code |= *(GtBitsequence *) gt_array_get(codes, word + 1) >>
+              (GT_INTWORDSIZE - offset);
+    numofbits = total_bits - bitpos < (GtUword) GT_INTWORDSIZE ?
+                (unsigned int) (total_bits - bitpos) :
+                (unsigned int) GT_INTWORDSIZE;
+    code_len = gt_huffman_decode_bits(huff, code, numofbits, &symbol);
+    gt_ensure(code_len > 0);
+    gt_ensure(symbol == (idx * 7UL) % dist_size);
+    bitpos += code_len;
+  }
+  gt_ensure(bitpos == total_bits);
+
+  gt_huffman_decoder_delete(huffdec);
+  gt_huffman_delete(huff);
+  gt_array_delete(codes);
+  gt_array_delete(decoded);
+  return had_err;
+}
+
 int gt_huffman_unit_test(GtError *err)
 {
   int had_err = 0;
@@ -964,5 +1210,8 @@ int gt_huffman_unit_test(GtError *err)
   if (!had_err)
     had_err = test_mem(err);
 
+  if (!had_err)
+    had_err = test_long_codes(err);
+
   return had_err;
 }
@@ -92,6 +92,16 @@ GtUword    gt_huffman_numofsymbols(const GtHuffman *huffman);
 /* Returns the number of symbols with frequency >= 0. */
 GtUword    gt_huffman_totalnumofsymbols(const GtHuffman *huffman);
 
+/* Decodes the symbol whose code starts at the most significant bit of <bits>,
+   of which the <numofbits> most significant bits are valid. Writes the symbol
+   to <symbol> and returns the length of its code, or 0 if the code is longer
+   than <numofbits>. Codes with at most 10 bits are decoded with a single table
+   lookup. */
+unsigned int gt_huffman_decode_bits(const GtHuffman *huffman,
+                                    GtBitsequence bits,
+                                    unsigned int numofbits,
+                                    GtUword *symbol);
+
 /* Deletes <huffman>. */
 void       gt_huffman_delete(GtHuffman *huffman);
 
@@ -164,6 +174,16 @@ int                      gt_huffman_bitwise_decoder_next(
                                                   GtUword *symbol,
                                                   GtError *err);
 
+/* Decodes a whole code at once like <gt_huffman_decode_bits()>, returns the
+   number of bits used or 0 if <numofbits> did not suffice. <hbwd> must not be
+   inside a code, i.e. the last call to <gt_huffman_bitwise_decoder_next()> must
+   have returned 0. */
+unsigned int             gt_huffman_bitwise_decoder_next_bits(
+                                                  GtHuffmanBitwiseDecoder *hbwd,
+                                                  GtBitsequence bits,
+                                                  unsigned int numofbits,
+                                                  GtUword *symbol);
+
 /* Deletes <hbwd>. */
 void                     gt_huffman_bitwise_decoder_delete(
                                                  GtHuffmanBitwiseDecoder *hbwd);
@@ -73,18 +73,15 @@ static int i2m_change_target_seqids(GtFeatureNode *fn, const char *target,
   for (i = 0; !had_err && i < gt_str_array_size(target_ids); i++) {
     GtStr *seqid;
     GtUword offset;
-    const char *md5;
     GtRange *range;
     seqid = gt_str_array_get_str(target_ids, i);
     range = gt_array_get(target_ranges, i);
-    if (!(md5 = gt_region_mapping_get_md5_fingerprint(region_mapping, seqid,
-                                                      range, &offset, err))) {
-      had_err = -1;
-    }
+    gt_str_set(md5str, GT_MD5_SEQID_PREFIX);
+    had_err = gt_region_mapping_append_md5_fingerprint(region_mapping,
+                                                       md5str, seqid, range,
+                                                       &offset, err);
     if (!had_err) {
       GtRange transformed_range;
-      gt_str_set(md5str, GT_MD5_SEQID_PREFIX);
-      gt_str_append_cstr(md5str, md5);
       gt_str_append_char(md5str, GT_MD5_SEQID_SEPARATOR);
       gt_str_append_str(md5str, seqid);
       gt_str_array_set(target_ids, i, md5str);
@@ -139,15 +136,12 @@ static int seqid_to_md5(GtGenomeNode *gn, GtRegionMapping *region_mapping,
   if (!gt_md5_seqid_has_prefix(gt_str_get(seqid))) {
     /* seqid is not already a MD5 seqid -> change id */
     GtUword offset;
-    const char *md5;
     GtRange range = gt_genome_node_get_range(gn);
-    if (!(md5 = gt_region_mapping_get_md5_fingerprint(region_mapping, seqid,
-                                                      &range, &offset, err))) {
-      had_err = -1;
-    }
+    GtStr *new_seqid = gt_str_new_cstr(GT_MD5_SEQID_PREFIX);
+    had_err = gt_region_mapping_append_md5_fingerprint(region_mapping,
+                                                       new_seqid, seqid,
+                                                       &range, &offset, err);
     if (!had_err) {
-      GtStr *new_seqid = gt_str_new_cstr(GT_MD5_SEQID_PREFIX);
-      gt_str_append_cstr(new_seqid, md5);
       gt_str_append_char(new_seqid, GT_MD5_SEQID_SEPARATOR);
       gt_str_append_str(new_seqid, seqid);
       if (gt_feature_node_try_cast(gn)) {
@@ -163,8 +157,8 @@ static int seqid_to_md5(GtGenomeNode *gn, GtRegionMapping *region_mapping,
       }
       else
         gt_genome_node_change_seqid(gn, new_seqid);
-      gt_str_delete(new_seqid);
     }
+    gt_str_delete(new_seqid);
   }
   return had_err;
 }
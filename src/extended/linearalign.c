@@ -31,8 +31,13 @@
 #endif
 #include "core/unused_api.h"
 #include "core/divmodmul_api.h"
+#include "core/ensure_api.h"
+#include "core/mathsupport_api.h"
 #include "match/squarededist.h"
 #include "extended/alignment.h"
+#include "extended/diagonalbandalign.h"
+#include "extended/diagonalbandalign_affinegapcost.h"
+#include "extended/linearalign_affinegapcost.h"
 #include "extended/maxcoordvalue.h"
 #include "extended/reconstructalignment.h"
 #include "extended/squarealign.h"
@@ -57,66 +62,66 @@ static void firstEDtabRtabcolumn(GtUword *EDtabcolumn,
   }
 }
 
+/* The diagonal and the horizontal transitions into a cell only depend on the
+   previous column. So they are evaluated first for the whole column, from
+   bottom to top in place, such that there is no dependency between the
+   iterations of the inner loop. The vertical transitions are added in a
+   second pass. */
 static void nextEDtabRtabcolumn(GtUword *EDtabcolumn,
                                 GtUword *Rtabcolumn,
                                 GtUword colindex,
                                 GtUword midcolumn,
-                                GtUchar b,
+                                const GtWord *replacement,
                                 const GtUchar *useq,
-                                GtUword ustart,
                                 GtUword ulen,
-                                const GtScoreHandler *scorehandler)
+                                GtUword gapcost)
 {
-  GtUword rowindex, val, gapcost,
-          northwestEDtabentry,
-          westEDtabentry,
-          northwestRtabentry,
-          westRtabentry = 0;
-
-  gt_assert(scorehandler);
-  gapcost = gt_scorehandler_get_gapscore(scorehandler);
-
-  westEDtabentry = EDtabcolumn[0];
-  EDtabcolumn[0] += gapcost;
+  GtUword rowindex, val;
 
   if (colindex > midcolumn)
   {
-    Rtabcolumn[0] = 0;
-  }
-
-  for (rowindex = 1UL; rowindex <= ulen; rowindex++) {
-    northwestEDtabentry = westEDtabentry;
-    northwestRtabentry  = westRtabentry;
-    westEDtabentry = EDtabcolumn[rowindex];
-    westRtabentry  = Rtabcolumn[rowindex];
-    EDtabcolumn[rowindex] += gapcost; /* 1. recurrence */
-
-    /* 2. recurrence: */
-    val = northwestEDtabentry + gt_scorehandler_get_replacement(scorehandler,
-                                                    useq[ustart+rowindex-1], b);
-    if (val <= EDtabcolumn[rowindex])
+    for (rowindex = ulen; rowindex > 0; rowindex--)
     {
-      EDtabcolumn[rowindex] = val;
-      if (colindex > midcolumn)
+      val = EDtabcolumn[rowindex-1] + replacement[useq[rowindex-1]];
+      if (val <= EDtabcolumn[rowindex] + gapcost)
+      {
+        EDtabcolumn[rowindex] = val;
+        Rtabcolumn[rowindex] = Rtabcolumn[rowindex-1];
+      } else
       {
-        Rtabcolumn[rowindex] = northwestRtabentry;
+        EDtabcolumn[rowindex] += gapcost;
       }
     }
-    /* 3. recurrence: */
-    if ((val = EDtabcolumn[rowindex-1]+gapcost) < EDtabcolumn[rowindex])
+    Rtabcolumn[0] = 0;
+    EDtabcolumn[0] += gapcost;
+    for (rowindex = 1UL; rowindex <= ulen; rowindex++)
     {
-      EDtabcolumn[rowindex] = val;
-      if (colindex > midcolumn)
+      if ((val = EDtabcolumn[rowindex-1] + gapcost) < EDtabcolumn[rowindex])
       {
+        EDtabcolumn[rowindex] = val;
         Rtabcolumn[rowindex] = Rtabcolumn[rowindex-1];
       }
     }
+  } else
+  {
+    for (rowindex = ulen; rowindex > 0; rowindex--)
+    {
+      val = EDtabcolumn[rowindex-1] + replacement[useq[rowindex-1]];
+      EDtabcolumn[rowindex] = GT_MIN(val, EDtabcolumn[rowindex] + gapcost);
+    }
+    EDtabcolumn[0] += gapcost;
+    for (rowindex = 1UL; rowindex <= ulen; rowindex++)
+    {
+      val = EDtabcolumn[rowindex-1] + gapcost;
+      EDtabcolumn[rowindex] = GT_MIN(val, EDtabcolumn[rowindex]);
+    }
   }
 }
 
 static GtUword evaluateallEDtabRtabcolumns(GtUword *EDtabcolumn,
                                            GtUword *Rtabcolumn,
                                            const GtScoreHandler *scorehandler,
+                                           const GtWord * const *repltable,
                                            GtUword midcol,
                                            const GtUchar *useq,
                                            GtUword ustart,
@@ -134,8 +139,8 @@ static GtUword evaluateallEDtabRtabcolumns(GtUword *EDtabcolumn,
   for (colindex = 1UL; colindex <= vlen; colindex++)
   {
     nextEDtabRtabcolumn(EDtabcolumn, Rtabcolumn, colindex, midcol,
-                        vseq[vstart+colindex-1], useq, ustart,
-                        ulen, scorehandler);
+                        repltable[vseq[vstart+colindex-1]], useq + ustart,
+                        ulen, gapcost);
   }
   return EDtabcolumn[ulen];
 }
@@ -177,16 +182,17 @@ static void determineCtab0(GtUword *Ctab, const GtScoreHandler *scorehandler,
 typedef struct{
   GtLinspaceManagement *spacemanager;
   const GtScoreHandler *scorehandler;
+  const GtWord * const *repltable;
   const GtUchar        *useq, *vseq;
   GtUword              ustart, ulen, vstart, vlen,
                        *Ctab, rowoffset,
-                       threadidx, /* ensures threads do not overlap */
-                       *threadcount;
+                       threadidx; /* ensures threads do not overlap */
 }GtLinearCrosspointthreadinfo;
 
 static GtLinearCrosspointthreadinfo
             set_LinearCrosspointthreadinfo(GtLinspaceManagement *spacemanager,
                                            const GtScoreHandler *scorehandler,
+                                           const GtWord * const *repltable,
                                            const GtUchar *useq,
                                            GtUword ustart,
                                            GtUword ulen,
@@ -195,12 +201,12 @@ static GtLinearCrosspointthreadinfo
                                            GtUword vlen,
                                            GtUword *Ctab,
                                            GtUword rowoffset,
-                                           GtUword threadidx,
-                                           GtUword *threadcount)
+                                           GtUword threadidx)
 {
   GtLinearCrosspointthreadinfo threadinfo;
   threadinfo.spacemanager = spacemanager;
   threadinfo.scorehandler = scorehandler;
+  threadinfo.repltable = repltable;
   threadinfo.useq = useq;
   threadinfo.ustart = ustart;
   threadinfo.ulen = ulen;
@@ -210,12 +216,12 @@ static GtLinearCrosspointthreadinfo
   threadinfo.Ctab = Ctab;
   threadinfo.rowoffset = rowoffset;
   threadinfo.threadidx = threadidx;
-  threadinfo.threadcount = threadcount;
 
   return threadinfo;
 }
 static GtUword evaluatelinearcrosspoints(GtLinspaceManagement *spacemanager,
                                          const GtScoreHandler *scorehandler,
+                                         const GtWord * const *repltable,
                                          const GtUchar *useq,
                                          GtUword ustart,
                                          GtUword ulen,
@@ -224,8 +230,7 @@ static GtUword evaluatelinearcrosspoints(GtLinspaceManagement *spacemanager,
                                          GtUword vlen,
                                          GtUword *Ctab,
                                          GtUword rowoffset,
-                                         GT_UNUSED GtUword threadidx,
-                                         GT_UNUSED GtUword *threadcount);
+                                         GtUword threadidx);
 
 static void *evaluatelinearcrosspoints_thread_caller(void *data)
 {
@@ -233,6 +238,7 @@ static void *evaluatelinearcrosspoints_thread_caller(void *data)
                                          (GtLinearCrosspointthreadinfo *) data;
   (void) evaluatelinearcrosspoints(threadinfo->spacemanager,
                                    threadinfo->scorehandler,
+                                   threadinfo->repltable,
                                    threadinfo->useq,
                                    threadinfo->ustart,
                                    threadinfo-> ulen,
@@ -241,8 +247,7 @@ static void *evaluatelinearcrosspoints_thread_caller(void *data)
                                    threadinfo->vlen,
                                    threadinfo->Ctab,
                                    threadinfo->rowoffset,
-                                   threadinfo->threadidx,
-                                   threadinfo->threadcount);
+                                   threadinfo->threadidx);
   return NULL;
 }
 #endif
@@ -250,19 +255,19 @@ static void *evaluatelinearcrosspoints_thread_caller(void *data)
 /* evaluate crosspoints in recursive way */
 static GtUword evaluatelinearcrosspoints(GtLinspaceManagement *spacemanager,
                                          const GtScoreHandler *scorehandler,
+                                         const GtWord * const *repltable,
                                          const GtUchar *useq,
                                          GtUword ustart, GtUword ulen,
                                          const GtUchar *vseq,
                                          GtUword vstart, GtUword vlen,
                                          GtUword *Ctab,
                                          GtUword rowoffset,
-                                         GT_UNUSED GtUword threadidx,
-                                         GT_UNUSED GtUword *threadcount)
+                                         GT_UNUSED GtUword threadidx)
 {
   GtUword midrow, midcol, distance, *EDtabcolumn = NULL, *Rtabcolumn = NULL;
 #ifdef GT_THREADS_ENABLED
-  GtThread *t1 = NULL, *t2 = NULL;
-  GtLinearCrosspointthreadinfo threadinfo1, threadinfo2;
+  GtThread *t1 = NULL;
+  GtLinearCrosspointthreadinfo threadinfo1;
 #endif
 
   if (vlen >= 2UL)
@@ -275,21 +280,22 @@ static GtUword evaluatelinearcrosspoints(GtLinspaceManagement *spacemanager,
       return rowoffset;
     }
 
-#ifdef GT_THREADS_ENABLED
-    if (gt_jobs == 1)
-    {
-#endif
-      if (gt_linspace_management_checksquare(spacemanager, ulen,vlen,
-                                             sizeof (GtUword),
-                                             sizeof (Rtabcolumn)))
-      { /* product of subsquences is lower than space allocated already or
-         * lower than timesquarfactor * ulen*/
-        return gt_squarealign_ctab(spacemanager, scorehandler, Ctab, useq,
-                                   ustart, ulen, vseq, vstart, vlen, rowoffset);
-      }
-#ifdef GT_THREADS_ENABLED
+    if (gt_linspace_management_fits_square(spacemanager, ulen, vlen,
+                                           sizeof (GtUword),
+                                           sizeof (Rtabcolumn)))
+    { /* product of subsquences is lower than space allocated already or
+       * lower than timesquarfactor * ulen, this does not depend on the number
+       * of threads, so that the crosspoints do not either */
+      GtLinspaceManagement *squarespace
+        = gt_linspace_management_get_square(spacemanager, ulen, vlen,
+                                            sizeof (GtUword),
+                                            sizeof (Rtabcolumn));
+      distance = gt_squarealign_ctab(squarespace, scorehandler, Ctab, useq,
+                                     ustart, ulen, vseq, vstart, vlen,
+                                     rowoffset);
+      gt_linspace_management_put_square(spacemanager, squarespace);
+      return distance;
     }
-#endif
 
     midcol = GT_DIV2(vlen);
     Rtabcolumn = gt_linspace_management_get_rTabspace(spacemanager);
@@ -298,64 +304,65 @@ static GtUword evaluatelinearcrosspoints(GtLinspaceManagement *spacemanager,
     EDtabcolumn = EDtabcolumn + rowoffset + threadidx;
 
     distance = evaluateallEDtabRtabcolumns(EDtabcolumn, Rtabcolumn,
-                                           scorehandler, midcol,
+                                           scorehandler, repltable, midcol,
                                            useq, ustart, ulen,
                                            vseq, vstart, vlen);
     midrow = Rtabcolumn[ulen];
     Ctab[midcol] = rowoffset + midrow;
 
 #ifdef GT_THREADS_ENABLED
-    if (*threadcount + 2 > gt_jobs)
+    /* the upper left corner is evaluated by an additional thread, if one is
+       available and the subproblem is large enough, while the current thread
+       continues with the bottom right corner */
+    if (gt_linspace_management_reserve_thread(spacemanager, midrow, midcol))
+    {
+      threadinfo1 = set_LinearCrosspointthreadinfo(spacemanager, scorehandler,
+                                                   repltable,
+                                                   useq, ustart, midrow,
+                                                   vseq, vstart, midcol,
+                                                   Ctab, rowoffset,
+                                                   threadidx);
+      t1 = gt_thread_new(evaluatelinearcrosspoints_thread_caller,
+                         &threadinfo1, NULL);
+      if (t1 == NULL)
+        gt_linspace_management_release_thread(spacemanager);
+    }
+    if (t1 == NULL)
     {
 #endif
       /* upper left corner */
-      (void) evaluatelinearcrosspoints(spacemanager, scorehandler,
+      (void) evaluatelinearcrosspoints(spacemanager, scorehandler, repltable,
                                        useq, ustart, midrow,
                                        vseq, vstart, midcol,
                                        Ctab, rowoffset,
-                                       threadidx, threadcount);
-
-      /* bottom right corner */
-      (void) evaluatelinearcrosspoints(spacemanager, scorehandler,
-                                       useq, ustart + midrow,
-                                       ulen - midrow,
-                                       vseq, vstart + midcol,
-                                       vlen - midcol,
-                                       Ctab + midcol,
-                                       rowoffset + midrow,
-                                       threadidx, threadcount);
+                                       threadidx);
 #ifdef GT_THREADS_ENABLED
     }
-    else
-    {
-      threadinfo1 = set_LinearCrosspointthreadinfo(spacemanager, scorehandler,
-                                                   useq, ustart, midrow,
-                                                   vseq, vstart, midcol,
-                                                   Ctab, rowoffset,
-                                                   threadidx, threadcount);
-      (*threadcount)++;
-      t1 = gt_thread_new(evaluatelinearcrosspoints_thread_caller,
-                         &threadinfo1, NULL);
-
-      threadinfo2 = set_LinearCrosspointthreadinfo(spacemanager, scorehandler,
-                                                   useq, ustart + midrow,
-                                                   ulen - midrow,
-                                                   vseq, vstart + midcol,
-                                                   vlen - midcol,
-                                                   Ctab + midcol,
-                                                   rowoffset + midrow,
-                                                   threadidx + GT_DIV2(midcol),
-                                                   threadcount);
-      (*threadcount)++;
-      t2 = gt_thread_new(evaluatelinearcrosspoints_thread_caller,
-                         &threadinfo2, NULL);
+#endif
 
+#ifdef GT_THREADS_ENABLED
+    if (t1 != NULL)
+    {
+      /* shift the columns of the bottom right corner, such that they do not
+         overlap with those of the concurrently evaluated upper left corner */
+      threadidx += GT_DIV2(midcol);
+    }
+#endif
+    /* bottom right corner */
+    (void) evaluatelinearcrosspoints(spacemanager, scorehandler, repltable,
+                                     useq, ustart + midrow,
+                                     ulen - midrow,
+                                     vseq, vstart + midcol,
+                                     vlen - midcol,
+                                     Ctab + midcol,
+                                     rowoffset + midrow,
+                                     threadidx);
+#ifdef GT_THREADS_ENABLED
+    if (t1 != NULL)
+    {
       gt_thread_join(t1);
-      (*threadcount)--;
-      gt_thread_join(t2);
-      (*threadcount)--;
       gt_thread_delete(t1);
-      gt_thread_delete(t2);
+      gt_linspace_management_release_thread(spacemanager);
     }
 #endif
     return distance;
@@ -374,7 +381,8 @@ GtUword gt_calc_linearalign(GtLinspaceManagement *spacemanager,
                             GtUword vstart,
                             GtUword vlen)
 {
-  GtUword distance, gapcost, *Ctab, *EDtabcolumn, *Rtabcolumn, threadcount = 1;
+  GtUword distance, gapcost, *Ctab, *EDtabcolumn, *Rtabcolumn;
+  const GtWord * const *repltable;
 
   gt_assert(scorehandler);
   gt_linspace_management_set_ulen(spacemanager,ulen);
@@ -416,10 +424,13 @@ GtUword gt_calc_linearalign(GtLinspaceManagement *spacemanager,
   Ctab = gt_linspace_management_get_crosspointTabspace(spacemanager);
 
   Ctab[vlen] = ulen;
-  distance = evaluatelinearcrosspoints(spacemanager, scorehandler,
+  repltable = gt_linspace_management_get_repltable(spacemanager, scorehandler,
+                                                   useq + ustart, ulen,
+                                                   vseq + vstart, vlen);
+  distance = evaluatelinearcrosspoints(spacemanager, scorehandler, repltable,
                                        useq, ustart, ulen,
                                        vseq, vstart, vlen,
-                                       Ctab, 0, 0, &threadcount);
+                                       Ctab, 0, 0);
 
   determineCtab0(Ctab, scorehandler, vseq[vstart], useq, ustart);
   gt_reconstructalignment_from_Ctab(align, Ctab, useq, ustart, vseq, vstart,
@@ -866,3 +877,134 @@ void gt_linearalign_check_local(GT_UNUSED bool forward,
   }
   gt_alignment_delete(align);
 }
+
+#define GT_LINEARALIGN_TEST_PAIRS  32
+#define GT_LINEARALIGN_TEST_MAXLEN 200
+
+static void gt_linearalign_random_pair(GtUchar *useq, GtUword ulen,
+                                       GtUchar *vseq, GtUword vlen)
+{
+  GtUword idx;
+
+  for (idx = 0; idx < ulen; idx++)
+    useq[idx] = (GtUchar) gt_rand_max(3);
+  for (idx = 0; idx < vlen; idx++)
+    vseq[idx] = idx < ulen && gt_rand_max(9) > 0 ? useq[idx]
+                                                : (GtUchar) gt_rand_max(3);
+}
+
+/* align pairs of random sequences of length at most
+   GT_LINEARALIGN_TEST_MAXLEN by the linear space and the diagonal band
+   algorithms using the given <spacemanager>; the square space algorithms are
+   used for the small subproblems; if <warmup> is set, the pairs of maximal
+   length and those consisting of a single character and a sequence of maximal
+   length are aligned first */
+static void gt_linearalign_align_all(GtLinspaceManagement *spacemanager,
+                                     GtAlignment *align,
+                                     const GtScoreHandler *linear,
+                                     const GtScoreHandler *affine,
+                                     bool warmup)
+{
+  GtUchar useq[GT_LINEARALIGN_TEST_MAXLEN],
+          vseq[GT_LINEARALIGN_TEST_MAXLEN];
+  GtUword ulen, vlen, pair;
+
+  for (pair = 0; pair < GT_LINEARALIGN_TEST_PAIRS; pair++)
+  {
+    GtWord left_dist, right_dist;
+
+    if (warmup && pair < 3UL)
+    {
+      ulen = pair == 2UL ? 1UL : GT_LINEARALIGN_TEST_MAXLEN;
+      vlen = pair == 1UL ? 1UL : GT_LINEARALIGN_TEST_MAXLEN;
+    } else
+    {
+      ulen = 1 + gt_rand_max(GT_LINEARALIGN_TEST_MAXLEN - 1);
+      vlen = 1 + gt_rand_max(GT_LINEARALIGN_TEST_MAXLEN - 1);
+    }
+    gt_linearalign_random_pair(useq, ulen, vseq, vlen);
+    left_dist = -(GtWord) ulen;
+    right_dist = (GtWord) vlen;
+    gt_alignment_reset(align);
+    (void) gt_linearalign_compute_generic(spacemanager, linear, align,
+                                          useq, 0, ulen, vseq, 0, vlen);
+    gt_alignment_reset(align);
+    (void) gt_linearalign_affinegapcost_compute_generic(spacemanager, affine,
+                                                        align, useq, 0, ulen,
+                                                        vseq, 0, vlen);
+    gt_alignment_reset(align);
+    gt_diagonalbandalign_compute_generic(spacemanager, linear, align,
+                                         useq, 0, ulen, vseq, 0, vlen,
+                                         left_dist, right_dist);
+    gt_alignment_reset(align);
+    gt_diagonalbandalign_affinegapcost_compute_generic(spacemanager, affine,
+                                                       align,
+                                                       useq, 0, ulen,
+                                                       vseq, 0, vlen,
+                                                       left_dist, right_dist);
+  }
+}
+
+int gt_linearalign_unit_test(GtError *err)
+{
+  GtLinspaceManagementPool *pool;
+  GtLinspaceManagement *spacemanager, *warmed, *presized;
+  GtScoreHandler *linear, *affine;
+  GtAlignment *align;
+  GtUword allocations;
+  int had_err = 0;
+
+  gt_error_check(err);
+  linear = gt_scorehandler_new(0, 1, 0, 1);
+  affine = gt_scorehandler_new(0, 4, 6, 2);
+  align = gt_alignment_new();
+  pool = gt_linspace_management_pool_new();
+
+  /* a manager returned to the pool is handed out again */
+  warmed = gt_linspace_management_pool_get(pool);
+  gt_ensure(gt_linspace_management_get_allocations(warmed) == 0);
+  gt_linearalign_align_all(warmed, align, linear, affine, true);
+  gt_ensure(gt_linspace_management_get_allocations(warmed) > 0);
+  gt_linspace_management_pool_put(pool, warmed);
+  spacemanager = gt_linspace_management_pool_get(pool);
+  gt_ensure(spacemanager == warmed);
+
+  /* a warmed manager and a new one sized by the high-water mark of the pool
+     do not allocate space in steady state */
+  if (!had_err)
+  {
+    allocations = gt_linspace_management_get_allocations(spacemanager);
+    gt_linearalign_align_all(spacemanager, align, linear, affine, false);
+    gt_ensure(gt_linspace_management_get_allocations(spacemanager)
+              == allocations);
+  }
+  presized = gt_linspace_management_pool_get(pool);
+  gt_ensure(presized != spacemanager);
+  if (!had_err)
+  {
+    allocations = gt_linspace_management_get_allocations(presized);
+    gt_linearalign_align_all(presized, align, linear, affine, false);
+    gt_ensure(gt_linspace_management_get_allocations(presized)
+              == allocations);
+  }
+
+  /* growing a manager beyond its space peak allocates space */
+  if (!had_err)
+  {
+    GtUword ulen = gt_linspace_management_get_spacepeak(presized)
+                   / sizeof (GtUword);
+
+    allocations = gt_linspace_management_get_allocations(presized);
+    gt_linspace_management_check(presized, ulen, 1UL, sizeof (GtUword),
+                                 sizeof (GtUword *), sizeof (GtUword));
+    gt_ensure(gt_linspace_management_get_allocations(presized)
+              > allocations);
+  }
+  gt_linspace_management_pool_put(pool, presized);
+  gt_linspace_management_pool_put(pool, spacemanager);
+  gt_linspace_management_pool_delete(pool);
+  gt_alignment_delete(align);
+  gt_scorehandler_delete(linear);
+  gt_scorehandler_delete(affine);
+  return had_err;
+}
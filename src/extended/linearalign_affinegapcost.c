@@ -146,23 +146,40 @@ static void firstAtabRtabcolumn(GtAffinealignDPentry *Atabcolumn,
   }
 }
 
+/* Returns the same edge as <gt_linearalign_affinegapcost_set_edge()> and
+   stores the minimum of the three values in <minvalue>. */
+static inline GtAffineAlignEdge affine_minedge(GtWord *minvalue,
+                                               GtWord Rdist,
+                                               GtWord Ddist,
+                                               GtWord Idist)
+{
+  if ((GtUword) Rdist <= (GtUword) Ddist && (GtUword) Rdist <= (GtUword) Idist)
+  {
+    *minvalue = Rdist;
+    return Affine_R;
+  }
+  if ((GtUword) Ddist <= (GtUword) Idist)
+  {
+    *minvalue = Ddist;
+    return Affine_D;
+  }
+  *minvalue = Idist;
+  return Affine_I;
+}
+
 static void nextAtabRtabcolumn(GtAffinealignDPentry *Atabcolumn,
                                GtAffineAlignRtabentry *Rtabcolumn,
-                               const GtScoreHandler *scorehandler,
+                               GtUword gap_opening,
+                               GtUword gap_extension,
+                               const GtWord *replacement,
                                const GtUchar *useq,
-                               GtUword ustart,
                                GtUword ulen,
-                               GtUchar b,
                                GtUword midcolumn,
                                GtUword colindex)
 {
   GtAffinealignDPentry northwestAffinealignDPentry, westAffinealignDPentry;
   GtAffineAlignRtabentry northwestRtabentry, westRtabentry;
   GtWord rowindex, rcost, rdist, ddist, idist, minvalue;
-  GtUword gap_opening, gap_extension;
-
-  gap_opening = gt_scorehandler_get_gap_opening(scorehandler);
-  gap_extension = gt_scorehandler_get_gapscore(scorehandler);
 
   northwestAffinealignDPentry = Atabcolumn[0];
   northwestRtabentry = Rtabcolumn[0];
@@ -191,58 +208,78 @@ static void nextAtabRtabcolumn(GtAffinealignDPentry *Atabcolumn,
     Rtabcolumn[0].val_R.edge = Affine_X;
     Rtabcolumn[0].val_D.edge = Affine_X;
     Rtabcolumn[0].val_I.edge = Rtabcolumn[0].val_I.edge;
+  } else
+  {
+    /* the backtracing edges are only required to update the Rtab entries
+       right of the middle column, so here only the values are computed.
+       As add_safe_max is monotone, the minimum can be taken before adding
+       the costs. */
+    GtWord northwestRvalue = northwestAffinealignDPentry.Rvalue,
+           northwestDvalue = northwestAffinealignDPentry.Dvalue,
+           northwestIvalue = northwestAffinealignDPentry.Ivalue,
+           opengap = (GtWord) (gap_opening + gap_extension);
+
+    for (rowindex = 1; rowindex <= ulen; rowindex++)
+    {
+      GtAffinealignDPentry *entry = Atabcolumn + rowindex;
+      const GtAffinealignDPentry *north = entry - 1;
+      GtWord westRvalue = entry->Rvalue,
+             westDvalue = entry->Dvalue,
+             westIvalue = entry->Ivalue;
+
+      rcost = replacement[useq[rowindex-1]];
+      entry->Rvalue = add_safe_max(GT_MIN3(northwestRvalue, northwestDvalue,
+                                           northwestIvalue), rcost);
+      rdist = add_safe_max(GT_MIN(north->Rvalue, north->Ivalue), opengap);
+      ddist = add_safe_max(north->Dvalue, gap_extension);
+      entry->Dvalue = GT_MIN(rdist, ddist);
+      rdist = add_safe_max(GT_MIN(westRvalue, westDvalue), opengap);
+      idist = add_safe_max(westIvalue, gap_extension);
+      entry->Ivalue = GT_MIN(rdist, idist);
+      northwestRvalue = westRvalue;
+      northwestDvalue = westDvalue;
+      northwestIvalue = westIvalue;
+    }
+    return;
   }
 
   for (rowindex = 1; rowindex <= ulen; rowindex++)
   {
-    westAffinealignDPentry = Atabcolumn[rowindex];
+    GtAffinealignDPentry *entry = Atabcolumn + rowindex;
+    const GtAffinealignDPentry *north = entry - 1;
+
+    westAffinealignDPentry = *entry;
     westRtabentry = Rtabcolumn[rowindex];
 
-    rcost = gt_scorehandler_get_replacement(scorehandler,
-                                            useq[ustart+rowindex-1], b);
-    rdist = add_safe_max(northwestAffinealignDPentry.Rvalue, rcost);
-    ddist = add_safe_max(northwestAffinealignDPentry.Dvalue, rcost);
-    idist = add_safe_max(northwestAffinealignDPentry.Ivalue, rcost);
-
-    minvalue = GT_MIN3(rdist, ddist, idist);
-    Atabcolumn[rowindex].Rvalue = minvalue;
-    Atabcolumn[rowindex].Redge = gt_linearalign_affinegapcost_set_edge(rdist,
-                                                                       ddist,
-                                                                       idist);
-
-    rdist = add_safe_max(Atabcolumn[rowindex-1].Rvalue,
-                         gap_extension + gap_opening);
-    ddist = add_safe_max(Atabcolumn[rowindex-1].Dvalue,gap_extension);
-    idist = add_safe_max(Atabcolumn[rowindex-1].Ivalue,
-                         gap_extension + gap_opening);
-
-    minvalue = GT_MIN3(rdist, ddist, idist);
-    Atabcolumn[rowindex].Dvalue = minvalue;
-    Atabcolumn[rowindex].Dedge = gt_linearalign_affinegapcost_set_edge(rdist,
-                                                                       ddist,
-                                                                       idist);
+    /* as add_safe_max is monotone, the replacement cost can be added after
+       choosing the edge */
+    rcost = replacement[useq[rowindex-1]];
+    entry->Redge = affine_minedge(&minvalue,
+                                  northwestAffinealignDPentry.Rvalue,
+                                  northwestAffinealignDPentry.Dvalue,
+                                  northwestAffinealignDPentry.Ivalue);
+    entry->Rvalue = add_safe_max(minvalue, rcost);
+
+    rdist = add_safe_max(north->Rvalue, gap_extension + gap_opening);
+    ddist = add_safe_max(north->Dvalue, gap_extension);
+    idist = add_safe_max(north->Ivalue, gap_extension + gap_opening);
+    entry->Dedge = affine_minedge(&minvalue, rdist, ddist, idist);
+    entry->Dvalue = minvalue;
 
     rdist = add_safe_max(westAffinealignDPentry.Rvalue,
                          gap_extension + gap_opening);
     ddist = add_safe_max(westAffinealignDPentry.Dvalue,
                          gap_extension + gap_opening);
     idist = add_safe_max(westAffinealignDPentry.Ivalue, gap_extension);
-
-    minvalue = GT_MIN3(rdist, ddist, idist);
-    Atabcolumn[rowindex].Ivalue = minvalue;
-    Atabcolumn[rowindex].Iedge = gt_linearalign_affinegapcost_set_edge(rdist,
-                                                                       ddist,
-                                                                       idist);
-
-    if (colindex > midcolumn)
-    {
-      Rtabcolumn[rowindex].val_R = get_Rtabentry(&northwestRtabentry,
-                                                  Atabcolumn[rowindex].Redge);
-      Rtabcolumn[rowindex].val_D = get_Rtabentry(&Rtabcolumn[rowindex-1],
-                                                  Atabcolumn[rowindex].Dedge);
-      Rtabcolumn[rowindex].val_I = get_Rtabentry(&westRtabentry,
-                                                  Atabcolumn[rowindex].Iedge);
-    }
+    entry->Iedge = affine_minedge(&minvalue, rdist, ddist, idist);
+    entry->Ivalue = minvalue;
+
+    Rtabcolumn[rowindex].val_R = get_Rtabentry(&northwestRtabentry,
+                                               entry->Redge);
+    Rtabcolumn[rowindex].val_D = get_Rtabentry(&Rtabcolumn[rowindex-1],
+                                               entry->Dedge);
+    Rtabcolumn[rowindex].val_I = get_Rtabentry(&westRtabentry,
+                                               entry->Iedge);
     northwestAffinealignDPentry = westAffinealignDPentry;
     northwestRtabentry = westRtabentry;
   }
@@ -251,6 +288,7 @@ static void nextAtabRtabcolumn(GtAffinealignDPentry *Atabcolumn,
 static GtUword evaluateallAtabRtabcolumns(GtAffinealignDPentry *Atabcolumn,
                                           GtAffineAlignRtabentry *Rtabcolumn,
                                           const GtScoreHandler *scorehandler,
+                                          const GtWord * const *repltable,
                                           const GtUchar *useq,
                                           GtUword ustart,
                                           GtUword ulen,
@@ -272,9 +310,10 @@ static GtUword evaluateallAtabRtabcolumns(GtAffinealignDPentry *Atabcolumn,
   {
     nextAtabRtabcolumn(Atabcolumn,
                        Rtabcolumn,
-                       scorehandler,
-                       useq, ustart,ulen,
-                       vseq[vstart+colindex-1],
+                       gap_opening,
+                       gap_extension,
+                       repltable[vseq[vstart+colindex-1]],
+                       useq + ustart, ulen,
                        midcolumn,
                        colindex);
   }
@@ -315,15 +354,17 @@ GtAffineAlignEdge gt_linearalign_affinegapcost_minAdditionalCosts(
 typedef struct{
   GtLinspaceManagement *spacemanager;
   const GtScoreHandler *scorehandler;
+  const GtWord * const *repltable;
   const GtUchar *useq, * vseq;
   GtUword ustart, ulen, vstart, vlen,
-          *Ctab, rowoffset, *threadcount;
+          *Ctab, rowoffset;
   GtAffineAlignEdge from_edge, to_edge;
 }GtAffineCrosspointthreadinfo;
 
 static GtAffineCrosspointthreadinfo
               set_AffineCrosspointthreadinfo(GtLinspaceManagement *spacemanager,
                                              const GtScoreHandler *scorehandler,
+                                             const GtWord * const *repltable,
                                              const GtUchar *useq,
                                              GtUword ustart,
                                              GtUword ulen,
@@ -333,12 +374,12 @@ static GtAffineCrosspointthreadinfo
                                              GtUword *Ctab,
                                              GtUword rowoffset,
                                              GtAffineAlignEdge from_edge,
-                                             GtAffineAlignEdge to_edge,
-                                             GtUword *threadcount)
+                                             GtAffineAlignEdge to_edge)
 {
   GtAffineCrosspointthreadinfo threadinfo;
   threadinfo.spacemanager = spacemanager;
   threadinfo.scorehandler = scorehandler;
+  threadinfo.repltable = repltable;
   threadinfo.useq = useq;
   threadinfo.ustart = ustart;
   threadinfo.ulen = ulen;
@@ -349,12 +390,12 @@ static GtAffineCrosspointthreadinfo
   threadinfo.rowoffset = rowoffset;
   threadinfo.from_edge = from_edge;
   threadinfo.to_edge = to_edge;
-  threadinfo.threadcount = threadcount;
 
   return threadinfo;
 }
 static GtUword evaluateaffinecrosspoints(GtLinspaceManagement *spacemanager,
                                          const GtScoreHandler *scorehandler,
+                                         const GtWord * const *repltable,
                                          const GtUchar *useq,
                                          GtUword ustart,
                                          GtUword ulen,
@@ -364,8 +405,7 @@ static GtUword evaluateaffinecrosspoints(GtLinspaceManagement *spacemanager,
                                          GtUword *Ctab,
                                          GtUword rowoffset,
                                          GtAffineAlignEdge from_edge,
-                                         GtAffineAlignEdge to_edge,
-                                         GtUword *threadcount);
+                                         GtAffineAlignEdge to_edge);
 
 static void *evaluateaffinecrosspoints_thread_caller(void *data)
 {
@@ -373,6 +413,7 @@ static void *evaluateaffinecrosspoints_thread_caller(void *data)
                                          (GtAffineCrosspointthreadinfo *) data;
   (void) evaluateaffinecrosspoints(threadinfo->spacemanager,
                                    threadinfo->scorehandler,
+                                   threadinfo->repltable,
                                    threadinfo->useq,
                                    threadinfo->ustart,
                                    threadinfo-> ulen,
@@ -382,8 +423,7 @@ static void *evaluateaffinecrosspoints_thread_caller(void *data)
                                    threadinfo->Ctab,
                                    threadinfo->rowoffset,
                                    threadinfo->from_edge,
-                                   threadinfo->to_edge,
-                                   threadinfo->threadcount);
+                                   threadinfo->to_edge);
   return NULL;
 }
 #endif
@@ -391,6 +431,7 @@ static void *evaluateaffinecrosspoints_thread_caller(void *data)
 /* evaluate crosspoints in recursive way */
 static GtUword evaluateaffinecrosspoints(GtLinspaceManagement *spacemanager,
                                          const GtScoreHandler *scorehandler,
+                                         const GtWord * const *repltable,
                                          const GtUchar *useq,
                                          GtUword ustart,
                                          GtUword ulen,
@@ -400,44 +441,43 @@ static GtUword evaluateaffinecrosspoints(GtLinspaceManagement *spacemanager,
                                          GtUword *Ctab,
                                          GtUword rowoffset,
                                          GtAffineAlignEdge from_edge,
-                                         GtAffineAlignEdge to_edge,
-                                         GT_UNUSED GtUword *threadcount)
+                                         GtAffineAlignEdge to_edge)
 {
-  GtUword  midrow = 0, midcol = GT_DIV2(vlen), distance, colindex;
+  GtUword  midrow = 0, midcol = GT_DIV2(vlen), distance, colindex,
+           upperleft_ulen = 0, upperleft_vlen = 0;
   GtAffineAlignEdge bottomtype, midtype = Affine_X;
   GtAffinealignDPentry *Atabcolumn = NULL;
   GtAffineAlignRtabentry *Rtabcolumn = NULL;
+  bool upperleft = false;
 
 #ifdef GT_THREADS_ENABLED
-  GtThread *t1 = NULL, *t2 = NULL;
-  GtAffineCrosspointthreadinfo threadinfo1, threadinfo2;
+  GtThread *t1 = NULL;
+  GtAffineCrosspointthreadinfo threadinfo1;
 #endif
 
   if (vlen >= 2UL)
   {
-#ifdef GT_THREADS_ENABLED
-    if (gt_jobs == 1)
+    if (gt_linspace_management_fits_square(spacemanager, ulen, vlen,
+                                           sizeof (*Atabcolumn),
+                                           sizeof (*Rtabcolumn)))
     {
-#endif
-      if (gt_linspace_management_checksquare(spacemanager, ulen, vlen,
-                                             sizeof (*Atabcolumn),
-                                             sizeof (*Rtabcolumn)))
-      {
-        gt_affinealign_ctab(spacemanager, scorehandler, Ctab,
-                            useq, ustart, ulen, vseq, vstart, vlen,
-                            rowoffset, from_edge, to_edge);
-        return 0;
-      }
-#ifdef GT_THREADS_ENABLED
-   }
-#endif
+      GtLinspaceManagement *squarespace
+        = gt_linspace_management_get_square(spacemanager, ulen, vlen,
+                                            sizeof (*Atabcolumn),
+                                            sizeof (*Rtabcolumn));
+      gt_affinealign_ctab(squarespace, scorehandler, Ctab,
+                          useq, ustart, ulen, vseq, vstart, vlen,
+                          rowoffset, from_edge, to_edge);
+      gt_linspace_management_put_square(spacemanager, squarespace);
+      return 0;
+    }
     Rtabcolumn = gt_linspace_management_get_rTabspace(spacemanager);
     Atabcolumn = gt_linspace_management_get_valueTabspace(spacemanager);
     Rtabcolumn = Rtabcolumn + rowoffset;
     Atabcolumn = Atabcolumn + rowoffset;
 
     distance = evaluateallAtabRtabcolumns(Atabcolumn,Rtabcolumn,
-                                          scorehandler,
+                                          scorehandler, repltable,
                                           useq, ustart, ulen,
                                           vseq, vstart, vlen,
                                           midcol, from_edge);
@@ -468,122 +508,75 @@ static GtUword evaluateaffinecrosspoints(GtLinspaceManagement *spacemanager,
         Ctab[colindex] = Ctab[midcol];
     }
     else{/* upper left corner */
+      upperleft = true;
       switch (midtype) {
         case Affine_R:
           if (midcol > 1)
             Ctab[midcol-1] = Ctab[midcol] == 0 ? 0: Ctab[midcol] - 1;
-
-#ifdef GT_THREADS_ENABLED
-          if (*threadcount + 1 > gt_jobs)
-          {
-#endif
-            (void) evaluateaffinecrosspoints(spacemanager, scorehandler,
-                                             useq, ustart, midrow-1,
-                                             vseq, vstart, midcol-1,
-                                             Ctab, rowoffset,
-                                             from_edge, midtype,
-                                             threadcount);
-#ifdef GT_THREADS_ENABLED
-          }
-          else
-          {
-            threadinfo1=set_AffineCrosspointthreadinfo(spacemanager,
-                                                       scorehandler,
-                                                       useq, ustart, midrow-1,
-                                                       vseq, vstart, midcol-1,
-                                                       Ctab, rowoffset,
-                                                       from_edge, midtype,
-                                                       threadcount);
-            (*threadcount)++;
-            t1 = gt_thread_new(evaluateaffinecrosspoints_thread_caller,
-                               &threadinfo1, NULL);
-          }
-#endif
+          upperleft_ulen = midrow - 1;
+          upperleft_vlen = midcol - 1;
           break;
         case Affine_D:
-#ifdef GT_THREADS_ENABLED
-          if (*threadcount + 1 > gt_jobs)
-          {
-#endif
-          (void) evaluateaffinecrosspoints(spacemanager, scorehandler,
-                                           useq, ustart, midrow-1,
-                                           vseq, vstart, midcol,
-                                           Ctab, rowoffset,
-                                           from_edge,midtype,
-                                           threadcount);
-#ifdef GT_THREADS_ENABLED
-         }
-         else
-         {
-           threadinfo1=set_AffineCrosspointthreadinfo(spacemanager,
-                                                      scorehandler,
-                                                      useq, ustart, midrow-1,
-                                                      vseq, vstart, midcol,
-                                                      Ctab, rowoffset,
-                                                      from_edge, midtype,
-                                                      threadcount);
-
-           (*threadcount)++;
-           t1 = gt_thread_new(evaluateaffinecrosspoints_thread_caller,
-                               &threadinfo1, NULL);
-          }
-#endif
+          upperleft_ulen = midrow - 1;
+          upperleft_vlen = midcol;
           break;
         case Affine_I:
           if (midcol > 1)
             Ctab[midcol-1] = Ctab[midcol];
-          (void) evaluateaffinecrosspoints(spacemanager, scorehandler,
-                                           useq, ustart, midrow,
-                                           vseq, vstart, midcol-1,
-                                           Ctab, rowoffset,
-                                           from_edge, midtype,
-                                           threadcount);
+          upperleft_ulen = midrow;
+          upperleft_vlen = midcol - 1;
           break;
         case Affine_X: /*never reach this line*/
                 gt_assert(false);
       }
-    }
-   /*bottom right corner */
 #ifdef GT_THREADS_ENABLED
-    if (*threadcount + 1 > gt_jobs)
-    {
+      /* the upper left corner is evaluated by an additional thread, if one is
+         available and the subproblem is large enough. Only if the crosspoint
+         is not reached by an insertion, the rows of the upper left corner
+         are disjoint from those of the bottom right corner. */
+      if (midtype != Affine_I &&
+          gt_linspace_management_reserve_thread(spacemanager, upperleft_ulen,
+                                                upperleft_vlen))
+      {
+        threadinfo1 = set_AffineCrosspointthreadinfo(spacemanager,
+                                                     scorehandler, repltable,
+                                                     useq, ustart,
+                                                     upperleft_ulen,
+                                                     vseq, vstart,
+                                                     upperleft_vlen,
+                                                     Ctab, rowoffset,
+                                                     from_edge, midtype);
+        t1 = gt_thread_new(evaluateaffinecrosspoints_thread_caller,
+                           &threadinfo1, NULL);
+        if (t1 == NULL)
+          gt_linspace_management_release_thread(spacemanager);
+        else
+          upperleft = false;
+      }
 #endif
-      (void) evaluateaffinecrosspoints(spacemanager, scorehandler,
-                                          useq, ustart+midrow, ulen-midrow,
-                                          vseq, vstart+midcol, vlen-midcol,
-                                          Ctab+midcol,rowoffset+midrow,
-                                          midtype, to_edge, threadcount);
-#ifdef GT_THREADS_ENABLED
-    }
-    else
-    {
-      threadinfo2 = set_AffineCrosspointthreadinfo(spacemanager, scorehandler,
-                                                   useq, ustart + midrow,
-                                                   ulen - midrow,
-                                                   vseq, vstart + midcol,
-                                                   vlen - midcol,
-                                                   Ctab + midcol,
-                                                   rowoffset + midrow,
-                                                   midtype, to_edge,
-                                                   threadcount);
-      (*threadcount)++;
-      t2 = gt_thread_new(evaluateaffinecrosspoints_thread_caller,
-                         &threadinfo2, NULL);
+      if (upperleft)
+      {
+        (void) evaluateaffinecrosspoints(spacemanager, scorehandler,
+                                         repltable,
+                                         useq, ustart, upperleft_ulen,
+                                         vseq, vstart, upperleft_vlen,
+                                         Ctab, rowoffset,
+                                         from_edge, midtype);
+      }
     }
-
+   /*bottom right corner */
+    (void) evaluateaffinecrosspoints(spacemanager, scorehandler, repltable,
+                                     useq, ustart+midrow, ulen-midrow,
+                                     vseq, vstart+midcol, vlen-midcol,
+                                     Ctab+midcol,rowoffset+midrow,
+                                     midtype, to_edge);
+#ifdef GT_THREADS_ENABLED
     if (t1 != NULL)
     {
       gt_thread_join(t1);
-      (*threadcount)--;
       gt_thread_delete(t1);
+      gt_linspace_management_release_thread(spacemanager);
     }
-    if (t2 != NULL)
-    {
-      gt_thread_join(t2);
-      (*threadcount)--;
-      gt_thread_delete(t2);
-    }
-
 #endif
     return distance;
   }
@@ -629,8 +622,9 @@ GtUword gt_calc_affinealign_linear(GtLinspaceManagement *spacemanager,
                                    GtUword vstart,
                                    GtUword vlen)
 {
-  GtUword distance, *Ctab, threadcount = 1;
+  GtUword distance, *Ctab;
   GtWord gap_extension, gap_opening;
+  const GtWord * const *repltable;
   GtAffinealignDPentry *Atabcolumn;
   GtAffineAlignRtabentry *Rtabcolumn;
 
@@ -671,11 +665,16 @@ GtUword gt_calc_affinealign_linear(GtLinspaceManagement *spacemanager,
                                  sizeof (*Rtabcolumn), sizeof (*Ctab));
     Ctab = gt_linspace_management_get_crosspointTabspace(spacemanager);
     Ctab[vlen] = ulen;
+    repltable = gt_linspace_management_get_repltable(spacemanager,
+                                                     scorehandler,
+                                                     useq + ustart, ulen,
+                                                     vseq + vstart, vlen);
     distance = evaluateaffinecrosspoints(spacemanager, scorehandler,
+                                         repltable,
                                          useq, ustart, ulen,
                                          vseq, vstart, vlen,
                                          Ctab, 0, Affine_X,
-                                         Affine_X, &threadcount);
+                                         Affine_X);
 
     affine_determineCtab0(Ctab, spacemanager, scorehandler,
                           useq, ustart, vseq, vstart);
@@ -16,11 +16,28 @@
 */
 
 #include <ctype.h>
+#include <limits.h>
 #include <string.h>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+#include "core/assert_api.h"
+#include "core/divmodmul_api.h"
 #include "core/ma_api.h"
+#include "core/minmax_api.h"
+#include "core/thread_api.h"
+#include "core/unused_api.h"
 #include "extended/maxcoordvalue.h"
 #include "extended/linspace_management.h"
 
+/* minimal number of DP cells of a subproblem, for which an additional thread
+   is started; below, the thread start and join overhead outweighs the gain
+   (determined by benchmarking gt dev linspace_align on long DNA sequences) */
+#define GT_LINSPACE_MANAGEMENT_THREAD_MINCELLS (1UL << 22)
+
+/* tabs of at least this size are advised to be backed by huge pages */
+#define GT_LINSPACE_MANAGEMENT_HUGEPAGE_SIZE   ((size_t) 1 << 21)
+
 struct GtLinspaceManagement{
   void             *valueTabspace,
                    *rTabspace,
@@ -31,7 +48,16 @@ struct GtLinspaceManagement{
                    rTabsize,
                    crosspointTabsize,
                    spacepeak; /*sum of space in bytes*/
+  GtUword          allocations; /* number of (re)allocations of space */
   GtMaxcoordvalue *maxscoordvaluespace;
+  GtWord          **repltable;
+#ifdef GT_THREADS_ENABLED
+  GtMutex          *threadmutex;
+  GtUword          threadsinuse;
+  GtLinspaceManagementPool *squarepool; /* private space for square space
+                                           subproblems of concurrent threads,
+                                           created on first use */
+#endif
 };
 
 GtLinspaceManagement* gt_linspace_management_new()
@@ -42,12 +68,19 @@ GtLinspaceManagement* gt_linspace_management_new()
   spacemanager->rTabspace = NULL;
   spacemanager->crosspointTabspace = NULL;
   spacemanager->maxscoordvaluespace = NULL;
+  spacemanager->repltable = NULL;
   spacemanager->valueTabsize = 0;
   spacemanager->rTabsize = 0;
   spacemanager->crosspointTabsize = 0;
   spacemanager->timesquarefactor = 1;
   spacemanager->ulen = 0;
   spacemanager->spacepeak = 0;
+  spacemanager->allocations = 0;
+#ifdef GT_THREADS_ENABLED
+  spacemanager->threadmutex = gt_mutex_new();
+  spacemanager->threadsinuse = 1;
+  spacemanager->squarepool = NULL;
+#endif
   return spacemanager;
 }
 
@@ -60,6 +93,18 @@ void gt_linspace_management_delete(GtLinspaceManagement *spacemanager)
     if (spacemanager->crosspointTabspace != NULL)
       gt_free(spacemanager->crosspointTabspace);
     gt_maxcoordvalue_delete(spacemanager->maxscoordvaluespace);
+    if (spacemanager->repltable != NULL)
+    {
+      unsigned int b;
+
+      for (b = 0; b <= UCHAR_MAX; b++)
+        gt_free(spacemanager->repltable[b]);
+      gt_free(spacemanager->repltable);
+    }
+#ifdef GT_THREADS_ENABLED
+    gt_mutex_delete(spacemanager->threadmutex);
+    gt_linspace_management_pool_delete(spacemanager->squarepool);
+#endif
     gt_free(spacemanager);
   }
 }
@@ -72,6 +117,48 @@ size_t gt_linspace_management_get_spacepeak(const GtLinspaceManagement
   return spacemanager->spacepeak;
 }
 
+/* Advise the kernel to back the part of the tab at <ptr> of <size> bytes,
+   which covers complete huge pages, by transparent huge pages. This saves
+   TLB misses when filling large DP-matrices in square space. */
+static void gt_linspace_management_advise_hugepages(GT_UNUSED void *ptr,
+                                                    GT_UNUSED size_t size)
+{
+#if defined (__linux__) && defined (MADV_HUGEPAGE)
+  const size_t pagesize = GT_LINSPACE_MANAGEMENT_HUGEPAGE_SIZE;
+  size_t start, end;
+
+  if (size < GT_MULT2(pagesize))
+  {
+    return;
+  }
+  start = ((size_t) ptr + pagesize - 1) & ~(pagesize - 1);
+  end = ((size_t) ptr + size) & ~(pagesize - 1);
+  if (start < end)
+  {
+    (void) madvise((void *) start, end - start, MADV_HUGEPAGE);
+  }
+#endif
+}
+
+/* Enlarge the tab at <*tabspace> of <*tabsize> bytes to at least <required>
+   bytes. The tab grows by at least a quarter of its size, so that sequences
+   of slowly increasing length only lead to a logarithmic number of
+   reallocations until the high-water mark is reached. */
+static void gt_linspace_management_grow(GtLinspaceManagement *spacemanager,
+                                        void **tabspace, size_t *tabsize,
+                                        size_t required)
+{
+  if (*tabsize < required)
+  {
+    size_t newsize = GT_MAX(required, *tabsize + GT_DIV4(*tabsize));
+
+    *tabspace = gt_realloc(*tabspace, newsize);
+    *tabsize = newsize;
+    spacemanager->allocations++;
+    gt_linspace_management_advise_hugepages(*tabspace, newsize);
+  }
+}
+
 /* resize space */
 static void gt_linspace_management_check_generic(GtLinspaceManagement
                                                  *spacemanager,
@@ -87,29 +174,22 @@ static void gt_linspace_management_check_generic(GtLinspaceManagement
 
   gt_assert(spacemanager != NULL);
 
-  if (spacemanager->valueTabsize < (ulen+1)*valuesize)
-  {
-    spacemanager->valueTabspace = gt_realloc(spacemanager->valueTabspace,
-                                            (ulen+1)*valuesize);
-    spacemanager->valueTabsize = (ulen+1)*valuesize;
-  }
-
-  if (spacemanager->rTabsize < (ulen+1)*rtabsize)
-  {
-    spacemanager->rTabspace = gt_realloc(spacemanager->rTabspace,
-                                        (ulen+1)*rtabsize);
-    spacemanager->rTabsize = (ulen+1)*rtabsize;
-  }
-  if (spacemanager->crosspointTabsize < (vlen+1)*crosspointsize)
-  {
-    spacemanager->crosspointTabspace =
-           gt_realloc(spacemanager->crosspointTabspace,(vlen+1)*crosspointsize);
-    spacemanager->crosspointTabsize = (vlen+1)*crosspointsize;
-  }
+  gt_linspace_management_grow(spacemanager, &spacemanager->valueTabspace,
+                              &spacemanager->valueTabsize,
+                              (ulen+1)*valuesize);
+  gt_linspace_management_grow(spacemanager, &spacemanager->rTabspace,
+                              &spacemanager->rTabsize,
+                              (ulen+1)*rtabsize);
+  gt_linspace_management_grow(spacemanager, &spacemanager->crosspointTabspace,
+                              &spacemanager->crosspointTabsize,
+                              (vlen+1)*crosspointsize);
   if (local)
   {
     if (spacemanager->maxscoordvaluespace == NULL)
+    {
       spacemanager->maxscoordvaluespace = gt_maxcoordvalue_new();
+      spacemanager->allocations++;
+    }
     else
       gt_maxcoordvalue_reset(spacemanager->maxscoordvaluespace);
   }
@@ -152,22 +232,40 @@ void  gt_linspace_management_check_local(GtLinspaceManagement *spacemanager,
   spacemanager->ulen = ulen;
 }
 
+/* the row pointers are stored in the rTab space, which may be smaller
+   than required if the valueTab space was enlarged by other users */
+static bool fits_allocated_square(const GtLinspaceManagement *spacemanager,
+                                  GtUword ulen, GtUword vlen,
+                                  size_t valuesize, size_t rsize)
+{
+  return (ulen+1)*(vlen+1)*valuesize <= spacemanager->valueTabsize &&
+         (ulen+1)*rsize <= spacemanager->rTabsize;
+}
+
+/* A fixed minimal size of square space subproblems of up to 2^22 cells did
+   not measurably change the runtime of gt dev linspace_align on DNA sequences
+   of 20 kb, hence the base case is only controlled by the timesquarefactor */
+static bool fits_timesquarefactor(const GtLinspaceManagement *spacemanager,
+                                  GtUword ulen, GtUword vlen)
+{
+  return (ulen+1)*(vlen+1) <=
+         (spacemanager->ulen+1)*spacemanager->timesquarefactor;
+}
+
 static bool checksquare(GtLinspaceManagement *spacemanager,
                         GtUword ulen, GtUword vlen,
                         size_t valuesize, size_t rsize,
                         bool local)
 {
-  GtUword TSfactor;
   gt_assert(spacemanager);
 
-  TSfactor = spacemanager->timesquarefactor;
-  if ((ulen+1)*(vlen+1)*valuesize <= spacemanager->valueTabsize)
+  if (fits_allocated_square(spacemanager, ulen, vlen, valuesize, rsize))
   {
     if (local)
       gt_maxcoordvalue_reset(spacemanager->maxscoordvaluespace);
     return true;
   }
-  else if ((ulen+1)*(vlen+1) <= (spacemanager->ulen+1)*TSfactor)
+  else if (fits_timesquarefactor(spacemanager, ulen, vlen))
   {
     if (!local)
     {
@@ -203,6 +301,61 @@ bool gt_linspace_management_checksquare_local(
   return checksquare(spacemanager, ulen, vlen, valuesize, rsize,true);
 }
 
+/* The space of <spacemanager> only grows by <checksquare()> if
+   <fits_timesquarefactor()> holds, hence the result does not depend on
+   earlier calls of <checksquare()> for the same alignment. */
+bool gt_linspace_management_fits_square(const GtLinspaceManagement
+                                                                 *spacemanager,
+                                        GtUword ulen, GtUword vlen,
+                                        size_t valuesize, size_t rsize)
+{
+  gt_assert(spacemanager);
+  return fits_allocated_square(spacemanager, ulen, vlen, valuesize, rsize) ||
+         fits_timesquarefactor(spacemanager, ulen, vlen);
+}
+
+GtLinspaceManagement* gt_linspace_management_get_square(GtLinspaceManagement
+                                                                 *spacemanager,
+                                                        GtUword ulen,
+                                                        GtUword vlen,
+                                                        size_t valuesize,
+                                                        size_t rsize)
+{
+  GtLinspaceManagement *squarespace = spacemanager;
+
+  gt_assert(gt_linspace_management_fits_square(spacemanager, ulen, vlen,
+                                               valuesize, rsize));
+#ifdef GT_THREADS_ENABLED
+  if (gt_jobs > 1)
+  {
+    /* the space of <spacemanager> holds the columns of concurrently evaluated
+       subproblems */
+    gt_mutex_lock(spacemanager->threadmutex);
+    if (spacemanager->squarepool == NULL)
+      spacemanager->squarepool = gt_linspace_management_pool_new();
+    gt_mutex_unlock(spacemanager->threadmutex);
+    squarespace = gt_linspace_management_pool_get(spacemanager->squarepool);
+    gt_linspace_management_check_generic(squarespace, (ulen+1)*(vlen+1)-1,
+                                         vlen, valuesize, rsize, 0, false);
+    return squarespace;
+  }
+#endif
+  (void) checksquare(spacemanager, ulen, vlen, valuesize, rsize, false);
+  return squarespace;
+}
+
+void gt_linspace_management_put_square(GT_UNUSED GtLinspaceManagement
+                                                                 *spacemanager,
+                                       GtLinspaceManagement *squarespace)
+{
+#ifdef GT_THREADS_ENABLED
+  if (squarespace != spacemanager)
+    gt_linspace_management_pool_put(spacemanager->squarepool, squarespace);
+#else
+  gt_assert(squarespace == spacemanager);
+#endif
+}
+
 void gt_linspace_management_set_ulen(GtLinspaceManagement *spacemanager,
                                      GtUword ulen)
 {
@@ -234,6 +387,13 @@ void *gt_linspace_management_get_crosspointTabspace(const GtLinspaceManagement
   return NULL;
 }
 
+GtUword gt_linspace_management_get_allocations(const GtLinspaceManagement
+                                                                  *spacemanager)
+{
+  gt_assert(spacemanager != NULL);
+  return spacemanager->allocations;
+}
+
 size_t gt_linspace_management_get_valueTabsize(const GtLinspaceManagement
                                                                   *spacemanager)
 {
@@ -250,6 +410,38 @@ void *gt_linspace_management_get_maxspace(const GtLinspaceManagement
   return NULL;
 }
 
+const GtWord * const *gt_linspace_management_get_repltable(
+                                      GtLinspaceManagement *spacemanager,
+                                      const GtScoreHandler *scorehandler,
+                                      const GtUchar *useq, GtUword ulen,
+                                      const GtUchar *vseq, GtUword vlen)
+{
+  GtUword idx;
+  unsigned int b;
+
+  gt_assert(spacemanager != NULL);
+  if (spacemanager->repltable == NULL)
+  {
+    spacemanager->repltable = gt_calloc((size_t) (UCHAR_MAX+1),
+                                        sizeof *spacemanager->repltable);
+    spacemanager->allocations++;
+  }
+  /* count the rows which are allocated when filling the table */
+  for (idx = 0; idx < vlen; idx++)
+  {
+    b = vseq[idx];
+    if (spacemanager->repltable[b] == NULL)
+    {
+      spacemanager->repltable[b]
+        = gt_malloc(sizeof **spacemanager->repltable * (UCHAR_MAX+1));
+      spacemanager->allocations++;
+    }
+  }
+  gt_scorehandler_replacement_table_fill(scorehandler, spacemanager->repltable,
+                                         useq, ulen, vseq, vlen);
+  return (const GtWord * const *) spacemanager->repltable;
+}
+
 #ifndef NDEBUG
 static bool gt_linspace_management_check_space(
                          const GtLinspaceManagement *spacemanager,
@@ -282,3 +474,180 @@ void gt_linspace_management_set_TSfactor(GtLinspaceManagement *spacemanager,
   gt_assert(spacemanager != NULL);
   spacemanager->timesquarefactor = timesquarefactor;
 }
+
+bool gt_linspace_management_reserve_thread(GT_UNUSED GtLinspaceManagement
+                                                                 *spacemanager,
+                                           GT_UNUSED GtUword ulen,
+                                           GT_UNUSED GtUword vlen)
+{
+#ifdef GT_THREADS_ENABLED
+  bool reserved = false;
+
+  gt_assert(spacemanager != NULL);
+  if (gt_jobs > 1 &&
+      (ulen+1)*(vlen+1) >= GT_LINSPACE_MANAGEMENT_THREAD_MINCELLS)
+  {
+    gt_mutex_lock(spacemanager->threadmutex);
+    if (spacemanager->threadsinuse < gt_jobs)
+    {
+      spacemanager->threadsinuse++;
+      reserved = true;
+    }
+    gt_mutex_unlock(spacemanager->threadmutex);
+  }
+  return reserved;
+#else
+  return false;
+#endif
+}
+
+void gt_linspace_management_release_thread(GT_UNUSED GtLinspaceManagement
+                                                                 *spacemanager)
+{
+#ifdef GT_THREADS_ENABLED
+  gt_assert(spacemanager != NULL);
+  gt_mutex_lock(spacemanager->threadmutex);
+  gt_assert(spacemanager->threadsinuse > 1);
+  spacemanager->threadsinuse--;
+  gt_mutex_unlock(spacemanager->threadmutex);
+#endif
+}
+
+struct GtLinspaceManagementPool
+{
+  GtLinspaceManagement **idle;
+  GtUword              numofidle,
+                       allocatedidle;
+  size_t               valueTabsize, /* high-water marks of the tabs of */
+                       rTabsize,     /* all managers returned so far */
+                       crosspointTabsize;
+  bool                 local,
+                       replrows[UCHAR_MAX+1]; /* rows of replacement tables
+                                                 in use so far */
+  GtMutex             *mutex;
+};
+
+GtLinspaceManagementPool* gt_linspace_management_pool_new(void)
+{
+  GtLinspaceManagementPool *pool = gt_malloc(sizeof *pool);
+
+  pool->idle = NULL;
+  pool->numofidle = 0;
+  pool->allocatedidle = 0;
+  pool->valueTabsize = 0;
+  pool->rTabsize = 0;
+  pool->crosspointTabsize = 0;
+  pool->local = false;
+  memset(pool->replrows, 0, sizeof pool->replrows);
+  pool->mutex = gt_mutex_new();
+  return pool;
+}
+
+void gt_linspace_management_pool_delete(GtLinspaceManagementPool *pool)
+{
+  if (pool != NULL)
+  {
+    GtUword idx;
+
+    for (idx = 0; idx < pool->numofidle; idx++)
+    {
+      gt_linspace_management_delete(pool->idle[idx]);
+    }
+    gt_free(pool->idle);
+    gt_mutex_delete(pool->mutex);
+    gt_free(pool);
+  }
+}
+
+GtLinspaceManagement* gt_linspace_management_pool_get(
+                                                GtLinspaceManagementPool *pool)
+{
+  GtLinspaceManagement *spacemanager;
+  size_t valueTabsize, rTabsize, crosspointTabsize, space;
+  bool local, replrows[UCHAR_MAX+1];
+  unsigned int b;
+
+  gt_assert(pool != NULL);
+  gt_mutex_lock(pool->mutex);
+  spacemanager = pool->numofidle > 0 ? pool->idle[--pool->numofidle] : NULL;
+  valueTabsize = pool->valueTabsize;
+  rTabsize = pool->rTabsize;
+  crosspointTabsize = pool->crosspointTabsize;
+  local = pool->local;
+  memcpy(replrows, pool->replrows, sizeof replrows);
+  gt_mutex_unlock(pool->mutex);
+  if (spacemanager == NULL)
+  {
+    spacemanager = gt_linspace_management_new();
+  }
+  /* size all tabs to the high-water mark, so that the calling thread does
+     not allocate space while aligning sequences of the lengths seen so far */
+  gt_linspace_management_grow(spacemanager, &spacemanager->valueTabspace,
+                              &spacemanager->valueTabsize, valueTabsize);
+  gt_linspace_management_grow(spacemanager, &spacemanager->rTabspace,
+                              &spacemanager->rTabsize, rTabsize);
+  gt_linspace_management_grow(spacemanager, &spacemanager->crosspointTabspace,
+                              &spacemanager->crosspointTabsize,
+                              crosspointTabsize);
+  if (local && spacemanager->maxscoordvaluespace == NULL)
+  {
+    spacemanager->maxscoordvaluespace = gt_maxcoordvalue_new();
+    spacemanager->allocations++;
+  }
+  for (b = 0; b <= UCHAR_MAX; b++)
+  {
+    if (replrows[b])
+    {
+      if (spacemanager->repltable == NULL)
+      {
+        spacemanager->repltable = gt_calloc((size_t) (UCHAR_MAX+1),
+                                            sizeof *spacemanager->repltable);
+        spacemanager->allocations++;
+      }
+      if (spacemanager->repltable[b] == NULL)
+      {
+        spacemanager->repltable[b]
+          = gt_malloc(sizeof **spacemanager->repltable * (UCHAR_MAX+1));
+        spacemanager->allocations++;
+      }
+    }
+  }
+  space = spacemanager->valueTabsize + spacemanager->rTabsize +
+          spacemanager->crosspointTabsize;
+  if (space > spacemanager->spacepeak)
+    spacemanager->spacepeak = space;
+  return spacemanager;
+}
+
+void gt_linspace_management_pool_put(GtLinspaceManagementPool *pool,
+                                     GtLinspaceManagement *spacemanager)
+{
+  gt_assert(pool != NULL && spacemanager != NULL);
+  gt_mutex_lock(pool->mutex);
+  pool->valueTabsize = GT_MAX(pool->valueTabsize, spacemanager->valueTabsize);
+  pool->rTabsize = GT_MAX(pool->rTabsize, spacemanager->rTabsize);
+  pool->crosspointTabsize = GT_MAX(pool->crosspointTabsize,
+                                   spacemanager->crosspointTabsize);
+  if (spacemanager->maxscoordvaluespace != NULL)
+  {
+    pool->local = true;
+  }
+  if (spacemanager->repltable != NULL)
+  {
+    unsigned int b;
+
+    for (b = 0; b <= UCHAR_MAX; b++)
+    {
+      if (spacemanager->repltable[b] != NULL)
+        pool->replrows[b] = true;
+    }
+  }
+  if (pool->numofidle == pool->allocatedidle)
+  {
+    pool->allocatedidle = pool->allocatedidle * 1.2 + 4;
+    pool->idle = gt_realloc(pool->idle,
+                            sizeof *pool->idle * pool->allocatedidle);
+  }
+  pool->idle[pool->numofidle++] = spacemanager;
+  gt_mutex_unlock(pool->mutex);
+}
@@ -19,6 +19,7 @@
 #define LINSPACE_MANAGEMENT_H
 
 #include "core/types_api.h"
+#include "extended/scorehandler.h"
 
 /* The <GtLinspaceManagement> interface. All useful uitlities for different
    algorithms, which work in linear space */
@@ -79,6 +80,34 @@ bool          gt_linspace_management_checksquare_local(GtLinspaceManagement
                                                        GtUword vlen,
                                                        size_t valuesize,
                                                        size_t rsize);
+/* Return true if <gt_linspace_management_checksquare()> would return true for
+   the given arguments, without changing the space of <spacemanager>. Hence
+   this function can be called by concurrent threads. */
+bool          gt_linspace_management_fits_square(const GtLinspaceManagement
+                                                 *spacemanager,
+                                                 GtUword ulen, GtUword vlen,
+                                                 size_t valuesize,
+                                                 size_t rsize);
+/* Return a <GtLinspaceManagement> with enough space to use square space
+   functions in global case for sequence lengths <ulen> and <vlen>, for which
+   <gt_linspace_management_fits_square()> must hold. This is <spacemanager>
+   itself, resized as by <gt_linspace_management_checksquare()>, unless
+   <gt_jobs> is larger than 1. In that case the space of <spacemanager> can be
+   in use by other threads and the calling thread gets private space instead.
+   Either way, the result must be released by
+   <gt_linspace_management_put_square()>. */
+GtLinspaceManagement* gt_linspace_management_get_square(GtLinspaceManagement
+                                                        *spacemanager,
+                                                        GtUword ulen,
+                                                        GtUword vlen,
+                                                        size_t valuesize,
+                                                        size_t rsize);
+/* Release <squarespace> obtained by <gt_linspace_management_get_square()>
+   for <spacemanager>. */
+void          gt_linspace_management_put_square(GtLinspaceManagement
+                                                *spacemanager,
+                                                GtLinspaceManagement
+                                                *squarespace);
 /* Set sequence length <ulen> for the given <spacemanager>. */
 void          gt_linspace_management_set_ulen(GtLinspaceManagement
                                               *spacemanager,
@@ -98,12 +127,26 @@ void*         gt_linspace_management_get_crosspointTabspace(
 void*         gt_linspace_management_get_maxspace(const GtLinspaceManagement
                                                   *spacemanager);
 
+/* Return the replacement table of <scorehandler> for the characters of
+   <useq>[0..<ulen>-1] and <vseq>[0..<vlen>-1] (see
+   <gt_scorehandler_replacement_table_fill()>), which is stored in the space
+   of the given <spacemanager> and valid until the next call. */
+const GtWord * const *gt_linspace_management_get_repltable(
+                                      GtLinspaceManagement *spacemanager,
+                                      const GtScoreHandler *scorehandler,
+                                      const GtUchar *useq, GtUword ulen,
+                                      const GtUchar *vseq, GtUword vlen);
+
 /* Change allocated linear space of the of given <spacemanager> in 2dim matrix
    of size (<ulen>+1)*(<vlen>+1) and return pointer to these space. */
 GtUword**     gt_linspace_management_change_to_square(GtLinspaceManagement
                                                       *spacemanager,
                                                       GtUword ulen,
                                                       GtUword vlen);
+/* Return the number of times space was allocated or enlarged by the given
+   <spacemanager> since its creation. */
+GtUword       gt_linspace_management_get_allocations(const GtLinspaceManagement
+                                                                 *spacemanager);
 /* Return size of valueTab space of the given <spacemanager>. */
 size_t        gt_linspace_management_get_valueTabsize(const GtLinspaceManagement
                                                       *spacemanager);
@@ -111,6 +154,42 @@ size_t        gt_linspace_management_get_valueTabsize(const GtLinspaceManagement
 void          gt_linspace_management_set_TSfactor(GtLinspaceManagement
                                                   *spacemanager,
                                                   GtUword timesquarefactor);
+/* Try to reserve an additional thread for evaluating a subproblem of size
+   <ulen> times <vlen> of a divide and conquer algorithm using the given
+   <spacemanager>. Returns true if fewer than <gt_jobs> threads are in use
+   and the subproblem is large enough to outweigh the cost of starting a
+   thread. Every successful reservation must be released by
+   <gt_linspace_management_release_thread()>. Always returns false if
+   threads are not enabled. */
+bool          gt_linspace_management_reserve_thread(GtLinspaceManagement
+                                                    *spacemanager,
+                                                    GtUword ulen,
+                                                    GtUword vlen);
+/* Release a thread reserved by <gt_linspace_management_reserve_thread()>. */
+void          gt_linspace_management_release_thread(GtLinspaceManagement
+                                                    *spacemanager);
+
+/* The <GtLinspaceManagementPool> class keeps <GtLinspaceManagement> objects
+   for reuse, so that threads aligning sequences concurrently do not allocate
+   space once the lengths of the sequences have reached their maximum. */
+typedef struct GtLinspaceManagementPool GtLinspaceManagementPool;
+
+/* Return a new, empty <GtLinspaceManagementPool>. */
+GtLinspaceManagementPool* gt_linspace_management_pool_new(void);
+/* Delete the given <pool> and all <GtLinspaceManagement> objects in it. */
+void          gt_linspace_management_pool_delete(GtLinspaceManagementPool
+                                                 *pool);
+/* Return a <GtLinspaceManagement> object for exclusive use by the calling
+   thread. It is taken from the <pool> if available, or created otherwise.
+   Its space is at least as large as that of any object returned to the
+   <pool> so far. This function is thread-safe. */
+GtLinspaceManagement* gt_linspace_management_pool_get(GtLinspaceManagementPool
+                                                      *pool);
+/* Return <spacemanager> obtained by <gt_linspace_management_pool_get()> to
+   the <pool> for reuse. This function is thread-safe. */
+void          gt_linspace_management_pool_put(GtLinspaceManagementPool *pool,
+                                              GtLinspaceManagement
+                                              *spacemanager);
 
 #define add_safe(val1, val2, exception) (((val1) != (exception))\
                                            ? (val1) + (val2)\
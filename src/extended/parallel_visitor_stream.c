@@ -0,0 +1,387 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/class_alloc_lock.h"
+#include "core/ensure_api.h"
+#include "core/ma_api.h"
+#include "core/multithread_api.h"
+#include "core/str_api.h"
+#include "core/thread_api.h"
+#include "core/undef_api.h"
+#include "core/unused_api.h"
+#include "extended/array_in_stream_api.h"
+#include "extended/array_out_stream_api.h"
+#include "extended/feature_node.h"
+#include "extended/feature_node_iterator_api.h"
+#include "extended/node_stream_api.h"
+#include "extended/parallel_visitor_stream.h"
+
+#define GT_PARALLEL_VISITOR_STREAM_DEFAULT_BATCH_SIZE 256
+
+struct GtParallelVisitorStream {
+  const GtNodeStream parent_instance;
+  GtNodeStream *in_stream;
+  GtArray *chains, /* one array of visitors per worker */
+          *batch;
+  GtUword batch_size,
+          nextout;
+  bool in_done;
+};
+
+typedef struct {
+  GtParallelVisitorStream *pvs;
+  GtMutex *mutex;
+  GtUword next_node,
+          next_chain,
+          err_node;
+  GtError *err;
+} ParallelVisitorStreamInfo;
+
+#define parallel_visitor_stream_cast(NS)\
+        gt_node_stream_cast(gt_parallel_visitor_stream_class(), NS)
+
+static void* parallel_visitor_stream_worker(void *data)
+{
+  ParallelVisitorStreamInfo *info = data;
+  GtArray *chain;
+  GtError *err;
+  GtUword i, j;
+  int had_err;
+
+  gt_mutex_lock(info->mutex);
+  chain = *(GtArray**) gt_array_get(info->pvs->chains, info->next_chain++);
+  gt_mutex_unlock(info->mutex);
+  err = gt_error_new();
+
+  for (;;) {
+    gt_mutex_lock(info->mutex);
+    if (info->err_node != GT_UNDEF_UWORD
+          || info->next_node == gt_array_size(info->pvs->batch)) {
+      gt_mutex_unlock(info->mutex);
+      break;
+    }
+    i = info->next_node++;
+    gt_mutex_unlock(info->mutex);
+
+    had_err = 0;
+    for (j = 0; !had_err && j < gt_array_size(chain); j++) {
+      had_err = gt_genome_node_accept(*(GtGenomeNode**)
+                                                 gt_array_get(info->pvs->batch,
+                                                              i),
+                                      *(GtNodeVisitor**) gt_array_get(chain, j),
+                                      err);
+    }
+    if (had_err) {
+      /* report the error of the first failing node */
+      gt_mutex_lock(info->mutex);
+      if (info->err_node == GT_UNDEF_UWORD || i < info->err_node) {
+        info->err_node = i;
+        gt_error_set(info->err, "%s", gt_error_get(err));
+      }
+      gt_mutex_unlock(info->mutex);
+      gt_error_unset(err);
+    }
+  }
+  gt_error_delete(err);
+  return NULL;
+}
+
+/* feature node graphs handed to different workers may share their sequence
+   ID, whose reference count must not be changed concurrently */
+static void parallel_visitor_stream_privatize_seqid(GtGenomeNode *gn)
+{
+  GtFeatureNode *fn, *node;
+  GtFeatureNodeIterator *fni;
+  GtStr *seqid;
+  if (!(fn = gt_feature_node_try_cast(gn)))
+    return;
+  seqid = gt_str_clone(gt_genome_node_get_seqid(gn));
+  fni = gt_feature_node_iterator_new(fn);
+  while ((node = gt_feature_node_iterator_next(fni)))
+    gt_genome_node_change_seqid((GtGenomeNode*) node, seqid);
+  gt_feature_node_iterator_delete(fni);
+  gt_str_delete(seqid);
+}
+
+static int parallel_visitor_stream_process_batch(GtParallelVisitorStream *pvs,
+                                                 GtError *err)
+{
+  ParallelVisitorStreamInfo info;
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+
+  if (gt_array_size(pvs->chains) > 1) {
+    for (i = 0; i < gt_array_size(pvs->batch); i++) {
+      parallel_visitor_stream_privatize_seqid(*(GtGenomeNode**)
+                                                  gt_array_get(pvs->batch, i));
+    }
+  }
+  info.pvs = pvs;
+  info.mutex = gt_mutex_new();
+  info.next_node = info.next_chain = 0;
+  info.err_node = GT_UNDEF_UWORD;
+  info.err = err;
+  had_err = gt_multithread(parallel_visitor_stream_worker, &info, err);
+  if (!had_err && info.err_node != GT_UNDEF_UWORD)
+    had_err = -1;
+  gt_mutex_delete(info.mutex);
+  return had_err;
+}
+
+static int parallel_visitor_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
+                                        GtError *err)
+{
+  GtParallelVisitorStream *pvs;
+  GtGenomeNode *node;
+  int had_err = 0;
+  gt_error_check(err);
+  pvs = parallel_visitor_stream_cast(ns);
+
+  if (pvs->nextout == gt_array_size(pvs->batch)) {
+    gt_array_reset(pvs->batch);
+    pvs->nextout = 0;
+    while (!had_err && !pvs->in_done
+             && gt_array_size(pvs->batch) < pvs->batch_size) {
+      had_err = gt_node_stream_next(pvs->in_stream, &node, err);
+      if (!had_err) {
+        if (node)
+          gt_array_add(pvs->batch, node);
+        else
+          pvs->in_done = true;
+      }
+    }
+    if (!had_err && gt_array_size(pvs->batch) > 0)
+      had_err = parallel_visitor_stream_process_batch(pvs, err);
+  }
+  if (had_err)
+    return had_err;
+  if (pvs->nextout < gt_array_size(pvs->batch))
+    *gn = *(GtGenomeNode**) gt_array_get(pvs->batch, pvs->nextout++);
+  else
+    *gn = NULL;
+  return 0;
+}
+
+static void parallel_visitor_stream_free(GtNodeStream *ns)
+{
+  GtParallelVisitorStream *pvs = parallel_visitor_stream_cast(ns);
+  GtUword i, j;
+  /* nodes not delivered yet are still owned by us */
+  for (i = pvs->nextout; i < gt_array_size(pvs->batch); i++)
+    gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(pvs->batch, i));
+  gt_array_delete(pvs->batch);
+  for (i = 0; i < gt_array_size(pvs->chains); i++) {
+    GtArray *chain = *(GtArray**) gt_array_get(pvs->chains, i);
+    for (j = 0; j < gt_array_size(chain); j++)
+      gt_node_visitor_delete(*(GtNodeVisitor**) gt_array_get(chain, j));
+    gt_array_delete(chain);
+  }
+  gt_array_delete(pvs->chains);
+  gt_node_stream_delete(pvs->in_stream);
+}
+
+const GtNodeStreamClass* gt_parallel_visitor_stream_class(void)
+{
+  static const GtNodeStreamClass *nsc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!nsc) {
+    nsc = gt_node_stream_class_new(sizeof (GtParallelVisitorStream),
+                                   parallel_visitor_stream_free,
+                                   parallel_visitor_stream_next);
+  }
+  gt_class_alloc_lock_leave();
+  return nsc;
+}
+
+GtNodeStream* gt_parallel_visitor_stream_new(GtNodeStream *in_stream,
+                                        GtUword batch_size,
+                                        GtParallelVisitorStreamWorkerFunc func,
+                                        void *data, GtError *err)
+{
+  GtParallelVisitorStream *pvs;
+  GtNodeStream *ns;
+  unsigned int i;
+  int had_err = 0;
+  gt_assert(in_stream && func);
+  gt_error_check(err);
+  ns = gt_node_stream_create(gt_parallel_visitor_stream_class(),
+                             gt_node_stream_is_sorted(in_stream));
+  pvs = parallel_visitor_stream_cast(ns);
+  pvs->in_stream = gt_node_stream_ref(in_stream);
+  pvs->batch_size = batch_size
+                      ? batch_size
+                      : GT_PARALLEL_VISITOR_STREAM_DEFAULT_BATCH_SIZE;
+  pvs->batch = gt_array_new(sizeof (GtGenomeNode*));
+  pvs->chains = gt_array_new(sizeof (GtArray*));
+  for (i = 0; !had_err && i < gt_jobs; i++) {
+    GtArray *chain = gt_array_new(sizeof (GtNodeVisitor*));
+    gt_array_add(pvs->chains, chain);
+    had_err = func(chain, data, err);
+  }
+  if (had_err) {
+    gt_node_stream_delete(ns);
+    return NULL;
+  }
+  return ns;
+}
+
+/* test visitor: sets the score of each feature to its start position */
+typedef struct {
+  const GtNodeVisitor parent_instance;
+  GtUword fail_at;
+} ParallelVisitorStreamTestVisitor;
+
+static const GtNodeVisitorClass* parallel_visitor_stream_test_visitor_class(
+                                                                          void);
+
+#define parallel_visitor_stream_test_visitor_cast(NV)\
+        gt_node_visitor_cast(parallel_visitor_stream_test_visitor_class(), NV)
+
+static int parallel_visitor_stream_test_visitor_feature_node(GtNodeVisitor *nv,
+                                                             GtFeatureNode *fn,
+                                                             GtError *err)
+{
+  ParallelVisitorStreamTestVisitor *tv;
+  GtGenomeNode *child;
+  GtUword start;
+  tv = parallel_visitor_stream_test_visitor_cast(nv);
+  start = gt_genome_node_get_start((GtGenomeNode*) fn);
+  if (start == tv->fail_at) {
+    gt_error_set(err, "failed at "GT_WU, start);
+    return -1;
+  }
+  gt_feature_node_set_score(fn, (float) start);
+  child = gt_feature_node_new(gt_genome_node_get_seqid((GtGenomeNode*) fn),
+                              "exon", start, start + 1, GT_STRAND_FORWARD);
+  gt_feature_node_add_child(fn, (GtFeatureNode*) child);
+  return 0;
+}
+
+static const GtNodeVisitorClass* parallel_visitor_stream_test_visitor_class(
+                                                                           void)
+{
+  static const GtNodeVisitorClass *nvc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!nvc) {
+    nvc = gt_node_visitor_class_new(sizeof (ParallelVisitorStreamTestVisitor),
+                                    NULL,
+                                    NULL,
+                              parallel_visitor_stream_test_visitor_feature_node,
+                                    NULL,
+                                    NULL,
+                                    NULL);
+  }
+  gt_class_alloc_lock_leave();
+  return nvc;
+}
+
+static int parallel_visitor_stream_test_worker(GtArray *visitors, void *data,
+                                               GT_UNUSED GtError *err)
+{
+  GtNodeVisitor *nv;
+  ParallelVisitorStreamTestVisitor *tv;
+  nv = gt_node_visitor_create(parallel_visitor_stream_test_visitor_class());
+  tv = parallel_visitor_stream_test_visitor_cast(nv);
+  tv->fail_at = *(GtUword*) data;
+  gt_array_add(visitors, nv);
+  return 0;
+}
+
+#define GT_PARALLEL_VISITOR_STREAM_TEST_NODES 1000UL
+
+static GtArray* parallel_visitor_stream_test_nodes(GtStr *seqid)
+{
+  GtArray *nodes = gt_array_new(sizeof (GtGenomeNode*));
+  GtGenomeNode *gn;
+  GtUword i;
+  for (i = 0; i < GT_PARALLEL_VISITOR_STREAM_TEST_NODES; i++) {
+    gn = gt_feature_node_new(seqid, "gene", 10 * i + 1, 10 * i + 5,
+                             GT_STRAND_FORWARD);
+    gt_array_add(nodes, gn);
+  }
+  return nodes;
+}
+
+int gt_parallel_visitor_stream_unit_test(GtError *err)
+{
+  GtNodeStream *in_stream, *pvs, *out_stream;
+  GtArray *nodes, *result;
+  GtStr *seqid;
+  GtUword i, fail_at;
+  int had_err = 0;
+  gt_error_check(err);
+
+  seqid = gt_str_new_cstr("seq1");
+
+  /* all nodes are visited and delivered in order */
+  nodes = parallel_visitor_stream_test_nodes(seqid);
+  result = gt_array_new(sizeof (GtGenomeNode*));
+  fail_at = GT_UNDEF_UWORD;
+  in_stream = gt_array_in_stream_new(nodes, NULL, err);
+  pvs = gt_parallel_visitor_stream_new(in_stream, 64,
+                                       parallel_visitor_stream_test_worker,
+                                       &fail_at, err);
+  gt_ensure(pvs != NULL);
+  out_stream = gt_array_out_stream_all_new(pvs, result, err);
+  if (!had_err)
+    had_err = gt_node_stream_pull(out_stream, err);
+  gt_ensure(gt_array_size(result) == GT_PARALLEL_VISITOR_STREAM_TEST_NODES);
+  for (i = 0; !had_err && i < gt_array_size(result); i++) {
+    GtFeatureNode *fn = *(GtFeatureNode**) gt_array_get(result, i);
+    gt_ensure(gt_genome_node_get_start((GtGenomeNode*) fn) == 10 * i + 1);
+    gt_ensure(gt_feature_node_score_is_defined(fn));
+    gt_ensure(gt_feature_node_number_of_children(fn) == 1);
+    gt_ensure(!gt_str_cmp(gt_genome_node_get_seqid((GtGenomeNode*) fn),
+                          seqid));
+  }
+  gt_node_stream_delete(out_stream);
+  gt_node_stream_delete(pvs);
+  gt_node_stream_delete(in_stream);
+  for (i = 0; i < gt_array_size(result); i++)
+    gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(result, i));
+  gt_array_delete(result);
+  gt_array_delete(nodes);
+
+  /* an error in a visitor is reported and no nodes are leaked */
+  if (!had_err) {
+    GtGenomeNode *gn;
+    GtUword delivered = 0;
+    int rval;
+    nodes = parallel_visitor_stream_test_nodes(seqid);
+    fail_at = 10 * 100 + 1;
+    in_stream = gt_array_in_stream_new(nodes, &delivered, err);
+    pvs = gt_parallel_visitor_stream_new(in_stream, 64,
+                                         parallel_visitor_stream_test_worker,
+                                         &fail_at, err);
+    gt_ensure(pvs != NULL);
+    while (!(rval = gt_node_stream_next(pvs, &gn, err)) && gn)
+      gt_genome_node_delete(gn);
+    gt_ensure(rval != 0);
+    if (!had_err)
+      gt_error_unset(err);
+    gt_node_stream_delete(pvs);
+    gt_node_stream_delete(in_stream);
+    /* nodes not pulled from the array are still owned by it */
+    gt_ensure(delivered < GT_PARALLEL_VISITOR_STREAM_TEST_NODES);
+    for (i = delivered; i < gt_array_size(nodes); i++)
+      gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(nodes, i));
+    gt_array_delete(nodes);
+  }
+
+  gt_str_delete(seqid);
+  return had_err;
+}
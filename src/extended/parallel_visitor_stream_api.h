@@ -0,0 +1,51 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef PARALLEL_VISITOR_STREAM_API_H
+#define PARALLEL_VISITOR_STREAM_API_H
+
+#include "core/array_api.h"
+#include "extended/node_stream_api.h"
+#include "extended/node_visitor_api.h"
+
+/* Implements the <GtNodeStream> interface. A <GtParallelVisitorStream> reads
+   batches of nodes from its input stream and lets <gt_jobs> worker threads
+   pass each node through a chain of <GtNodeVisitor>s. Every worker owns its
+   own chain, so the visitors themselves need not be thread-safe, but the
+   resources they share (e.g. a <GtRegionMapping>) must be. Before a batch is
+   processed, each feature node graph gets a private copy of its sequence ID,
+   so visitors may attach new features to different graphs concurrently.
+   The nodes are delivered in input order. */
+typedef struct GtParallelVisitorStream GtParallelVisitorStream;
+
+/* Function used to set up the visitor chain of a worker. It is called once
+   per worker and must append the <GtNodeVisitor>s of the chain (in the order
+   in which they are to be applied) to <visitors>. The
+   <GtParallelVisitorStream> takes ownership of the visitors. */
+typedef int (*GtParallelVisitorStreamWorkerFunc)(GtArray *visitors,
+                                                 void *data, GtError *err);
+
+/* Create a <GtParallelVisitorStream> which reads up to <batch_size> nodes at
+   a time from <in_stream> and processes them with <gt_jobs> visitor chains
+   created by <func> (with <data> passed to it). If <batch_size> is 0, a
+   default size is used. Returns NULL and sets <err> if a chain could not be
+   created. */
+GtNodeStream* gt_parallel_visitor_stream_new(GtNodeStream *in_stream,
+                                        GtUword batch_size,
+                                        GtParallelVisitorStreamWorkerFunc func,
+                                        void *data, GtError *err);
+
+#endif
@@ -0,0 +1,310 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/array_api.h"
+#include "core/bounded_queue.h"
+#include "core/class_alloc_lock.h"
+#include "core/ensure_api.h"
+#include "core/ma_api.h"
+#include "core/str_api.h"
+#include "core/thread_api.h"
+#include "core/unused_api.h"
+#include "extended/array_in_stream_api.h"
+#include "extended/array_out_stream_api.h"
+#include "extended/feature_node.h"
+#include "extended/feature_node_iterator_api.h"
+#include "extended/feature_node_rep.h"
+#include "extended/genome_node_rep.h"
+#include "extended/node_stream_api.h"
+#include "extended/pipeline_stream.h"
+
+#define GT_PIPELINE_STREAM_DEFAULT_QUEUE_SIZE 256
+
+struct GtPipelineStream {
+  const GtNodeStream parent_instance;
+  GtNodeStream *in_stream;
+  GtBoundedQueue *queue; /* closed by the producer after the last node and by
+                            the consumer to abort the producer */
+  GtThread *producer;
+  GtError *producer_err;
+  int producer_had_err;
+  bool started;
+};
+
+#define pipeline_stream_cast(NS)\
+        gt_node_stream_cast(gt_pipeline_stream_class(), NS)
+
+#ifdef GT_THREADS_ENABLED
+typedef struct {
+  GtStr *orig,
+        *copy;
+} PipelineStreamStrCopy;
+
+static GtStr* pipeline_stream_str_copy(PipelineStreamStrCopy *sc, GtStr *orig)
+{
+  if (orig != sc->orig) {
+    gt_str_delete(sc->orig);
+    gt_str_delete(sc->copy);
+    sc->orig = gt_str_ref(orig);
+    sc->copy = gt_str_clone(orig);
+  }
+  return sc->copy;
+}
+
+static void pipeline_stream_str_copy_reset(PipelineStreamStrCopy *sc)
+{
+  gt_str_delete(sc->orig);
+  gt_str_delete(sc->copy);
+  sc->orig = sc->copy = NULL;
+}
+
+static void pipeline_stream_privatize_node(GtGenomeNode *gn,
+                                           PipelineStreamStrCopy *seqid,
+                                           PipelineStreamStrCopy *filename,
+                                           PipelineStreamStrCopy *source)
+{
+  GtFeatureNode *fn;
+  GtStr *str;
+  if ((str = gt_genome_node_get_seqid(gn)))
+    gt_genome_node_change_seqid(gn, pipeline_stream_str_copy(seqid, str));
+  if (gn->filename) {
+    str = pipeline_stream_str_copy(filename, gn->filename);
+    gt_str_delete(gn->filename);
+    gn->filename = gt_str_ref(str);
+  }
+  if ((fn = gt_feature_node_try_cast(gn)) && fn->source) {
+    str = pipeline_stream_str_copy(source, fn->source);
+    gt_str_delete(fn->source);
+    fn->source = gt_str_ref(str);
+  }
+}
+
+/* The strings for sequence IDs, sources and file names are shared between
+   all nodes created by a parser, but the reference counts of strings must not
+   be changed concurrently. Therefore all nodes reachable from <gn> get their
+   own copies before they are handed over to the consumer thread, which may
+   delete them while the producer creates new references. */
+static void pipeline_stream_privatize_strings(GtGenomeNode *gn)
+{
+  PipelineStreamStrCopy seqid = {NULL, NULL},
+                        filename = {NULL, NULL},
+                        source = {NULL, NULL};
+  GtFeatureNode *fn, *node;
+  GtFeatureNodeIterator *fni;
+  if ((fn = gt_feature_node_try_cast(gn))) {
+    fni = gt_feature_node_iterator_new(fn);
+    while ((node = gt_feature_node_iterator_next(fni))) {
+      pipeline_stream_privatize_node((GtGenomeNode*) node, &seqid, &filename,
+                                     &source);
+    }
+    gt_feature_node_iterator_delete(fni);
+  }
+  else
+    pipeline_stream_privatize_node(gn, &seqid, &filename, &source);
+  pipeline_stream_str_copy_reset(&seqid);
+  pipeline_stream_str_copy_reset(&filename);
+  pipeline_stream_str_copy_reset(&source);
+}
+
+static void* pipeline_stream_producer(void *data)
+{
+  GtPipelineStream *ps = data;
+  GtGenomeNode *gn = NULL;
+  int had_err;
+
+  while (!(had_err = gt_node_stream_next(ps->in_stream, &gn,
+                                         ps->producer_err)) && gn) {
+    pipeline_stream_privatize_strings(gn);
+    /* queued nodes are deleted by the consumer */
+    if (!gt_bounded_queue_add(ps->queue, gn)) {
+      /* the consumer is gone, we still own <gn> */
+      gt_genome_node_delete(gn);
+      break;
+    }
+  }
+  ps->producer_had_err = had_err;
+  /* publishes <producer_had_err> to the consumer */
+  gt_bounded_queue_close(ps->queue);
+  return NULL;
+}
+
+static int pipeline_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
+                                GtError *err)
+{
+  GtPipelineStream *ps;
+  void *elem;
+  gt_error_check(err);
+  ps = pipeline_stream_cast(ns);
+  if (!ps->started) {
+    ps->started = true;
+    if (!(ps->producer = gt_thread_new(pipeline_stream_producer, ps, err)))
+      return -1;
+  }
+  if (gt_bounded_queue_get(ps->queue, &elem)) {
+    *gn = elem;
+    return 0;
+  }
+  /* the producer has finished and all its nodes have been delivered */
+  if (ps->producer_had_err) {
+    gt_error_set(err, "%s", gt_error_get(ps->producer_err));
+    return ps->producer_had_err;
+  }
+  *gn = NULL;
+  return 0;
+}
+#else
+static int pipeline_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
+                                GtError *err)
+{
+  GtPipelineStream *ps;
+  gt_error_check(err);
+  ps = pipeline_stream_cast(ns);
+  return gt_node_stream_next(ps->in_stream, gn, err);
+}
+#endif
+
+static void pipeline_stream_free(GtNodeStream *ns)
+{
+  GtPipelineStream *ps = pipeline_stream_cast(ns);
+  void *elem;
+#ifdef GT_THREADS_ENABLED
+  if (ps->producer) {
+    gt_bounded_queue_close(ps->queue);
+    gt_thread_join(ps->producer);
+    gt_thread_delete(ps->producer);
+  }
+#endif
+  while (gt_bounded_queue_try_get(ps->queue, &elem))
+    gt_genome_node_delete(elem);
+  gt_bounded_queue_delete(ps->queue);
+  gt_error_delete(ps->producer_err);
+  gt_node_stream_delete(ps->in_stream);
+}
+
+const GtNodeStreamClass* gt_pipeline_stream_class(void)
+{
+  static const GtNodeStreamClass *nsc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!nsc) {
+    nsc = gt_node_stream_class_new(sizeof (GtPipelineStream),
+                                   pipeline_stream_free,
+                                   pipeline_stream_next);
+  }
+  gt_class_alloc_lock_leave();
+  return nsc;
+}
+
+GtNodeStream* gt_pipeline_stream_new(GtNodeStream *in_stream,
+                                     GtUword queue_size)
+{
+  GtPipelineStream *ps;
+  GtNodeStream *ns;
+  gt_assert(in_stream);
+  ns = gt_node_stream_create(gt_pipeline_stream_class(),
+                             gt_node_stream_is_sorted(in_stream));
+  ps = pipeline_stream_cast(ns);
+  ps->in_stream = gt_node_stream_ref(in_stream);
+  ps->queue = gt_bounded_queue_new(queue_size
+                                   ? queue_size
+                                   : GT_PIPELINE_STREAM_DEFAULT_QUEUE_SIZE);
+  ps->producer_err = gt_error_new();
+  return ns;
+}
+
+#define GT_PIPELINE_STREAM_TEST_NODES 1000UL
+
+static GtArray* pipeline_stream_test_nodes(GtStr *seqid, GtStr *source)
+{
+  GtArray *nodes = gt_array_new(sizeof (GtGenomeNode*));
+  GtGenomeNode *gn;
+  GtUword i;
+  for (i = 0; i < GT_PIPELINE_STREAM_TEST_NODES; i++) {
+    gn = gt_feature_node_new(seqid, "gene", 10 * i + 1, 10 * i + 5,
+                             GT_STRAND_FORWARD);
+    gt_feature_node_set_source((GtFeatureNode*) gn, source);
+    gt_array_add(nodes, gn);
+  }
+  return nodes;
+}
+
+int gt_pipeline_stream_unit_test(GtError *err)
+{
+  GtNodeStream *in_stream, *pipe1, *pipe2, *out_stream;
+  GtArray *nodes, *copy, *result;
+  GtGenomeNode *gn;
+  GtStr *seqid, *source;
+  GtUword i, delivered;
+  int had_err = 0;
+  gt_error_check(err);
+
+  seqid = gt_str_new_cstr("seq1");
+  source = gt_str_new_cstr("src");
+
+  /* two chained stages deliver all nodes in order */
+  nodes = pipeline_stream_test_nodes(seqid, source);
+  copy = gt_array_clone(nodes);
+  result = gt_array_new(sizeof (GtGenomeNode*));
+  in_stream = gt_array_in_stream_new(nodes, NULL, err);
+  pipe1 = gt_pipeline_stream_new(in_stream, 4);
+  pipe2 = gt_pipeline_stream_new(pipe1, 0);
+  out_stream = gt_array_out_stream_all_new(pipe2, result, err);
+  had_err = gt_node_stream_pull(out_stream, err);
+  gt_ensure(gt_array_size(result) == GT_PIPELINE_STREAM_TEST_NODES);
+  for (i = 0; !had_err && i < gt_array_size(result); i++) {
+    gn = *(GtGenomeNode**) gt_array_get(result, i);
+    gt_ensure(gn == *(GtGenomeNode**) gt_array_get(copy, i));
+#ifdef GT_THREADS_ENABLED
+    /* shared strings have been replaced by private copies */
+    gt_ensure(gt_genome_node_get_seqid(gn) != seqid);
+    gt_ensure(!gt_str_cmp(gt_genome_node_get_seqid(gn), seqid));
+    gt_ensure(((GtFeatureNode*) gn)->source != source);
+    gt_ensure(!strcmp(gt_feature_node_get_source((GtFeatureNode*) gn),
+                      "src"));
+#endif
+  }
+  gt_node_stream_delete(out_stream);
+  gt_node_stream_delete(pipe2);
+  gt_node_stream_delete(pipe1);
+  gt_node_stream_delete(in_stream);
+  for (i = 0; i < gt_array_size(result); i++)
+    gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(result, i));
+  gt_array_delete(result);
+  gt_array_delete(copy);
+  gt_array_delete(nodes);
+
+  /* deleting a partially consumed pipeline frees all remaining nodes */
+  if (!had_err) {
+    nodes = pipeline_stream_test_nodes(seqid, source);
+    delivered = 0;
+    in_stream = gt_array_in_stream_new(nodes, &delivered, err);
+    pipe1 = gt_pipeline_stream_new(in_stream, 8);
+    had_err = gt_node_stream_next(pipe1, &gn, err);
+    gt_ensure(gn != NULL);
+    gt_genome_node_delete(gn);
+    gt_node_stream_delete(pipe1);
+    gt_ensure(delivered < GT_PIPELINE_STREAM_TEST_NODES);
+    /* nodes not pulled by the producer are still owned by the array */
+    for (i = delivered; i < gt_array_size(nodes); i++)
+      gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(nodes, i));
+    gt_node_stream_delete(in_stream);
+    gt_array_delete(nodes);
+  }
+
+  gt_str_delete(source);
+  gt_str_delete(seqid);
+  return had_err;
+}
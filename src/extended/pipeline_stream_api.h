@@ -0,0 +1,42 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef PIPELINE_STREAM_API_H
+#define PIPELINE_STREAM_API_H
+
+#include "extended/node_stream_api.h"
+
+/* Implements the <GtNodeStream> interface. A <GtPipelineStream> decouples
+   <in_stream> (and all streams before it) from the streams consuming its
+   output: all nodes of <in_stream> are pulled on a separate thread and handed
+   over through a bounded lock-free queue. Inserting <GtPipelineStream>s
+   between the stages of a stream chain therefore lets the stages run
+   concurrently on different cores. The node order is preserved.
+   Ownership of the nodes passes through the queue, so no additional
+   reference counting is necessary. Stages before a <GtPipelineStream> must
+   not modify nodes after they have been passed on, nor keep references to
+   them (as a <GtGFF3InStream> checking the ID attributes does).
+   If GenomeTools is compiled without thread support, a <GtPipelineStream>
+   simply passes the nodes through. */
+typedef struct GtPipelineStream GtPipelineStream;
+
+/* Create a <GtPipelineStream> which pulls the nodes from <in_stream> on a
+   separate thread and buffers up to <queue_size> of them. If <queue_size> is
+   0, a default size is used. */
+GtNodeStream* gt_pipeline_stream_new(GtNodeStream *in_stream,
+                                     GtUword queue_size);
+
+#endif
@@ -1558,6 +1558,15 @@ static int rcr_huff_read(GtHuffmanBitwiseDecoder *hbwd,
   bool bit;
   int had_err = 0,
       stat = -1;
+  GtBitsequence bits;
+  unsigned int numofbits = gt_bitinstream_peek_bits(bitstream, &bits);
+
+  /* decode the whole code at once, unless it crosses a mapped chunk */
+  if ((numofbits = gt_huffman_bitwise_decoder_next_bits(hbwd, bits, numofbits,
+                                                        val)) > 0) {
+    gt_bitinstream_skip_bits(bitstream, numofbits);
+    return had_err;
+  }
   while (!had_err && stat != 0) {
     if (RCR_NEXT_BIT(bit)) {
       stat = gt_huffman_bitwise_decoder_next(hbwd, bit, val, err);
@@ -1595,6 +1604,14 @@ static int rcr_golomb_read(GtGolombBitwiseDecoder *gbwd,
   bool bit;
   int had_err = 0,
       stat = -1;
+  GtBitsequence bits;
+  unsigned int numofbits = gt_bitinstream_peek_bits(bitstream, &bits);
+
+  if ((numofbits = gt_golomb_bitwise_decoder_next_bits(gbwd, bits, numofbits,
+                                                       val)) > 0) {
+    gt_bitinstream_skip_bits(bitstream, numofbits);
+    return had_err;
+  }
   while (!had_err && stat != 0) {
     if (RCR_NEXT_BIT(bit)) {
       stat = gt_golomb_bitwise_decoder_next(gbwd, bit, val);
@@ -1734,6 +1751,15 @@ static inline int rcr_elias_read(GtEliasGammaBitwiseDecoder *ebwd,
   bool bit;
   int had_err = 0,
       stat = -1;
+  GtBitsequence bits;
+  unsigned int numofbits = gt_bitinstream_peek_bits(bitstream, &bits);
+
+  if ((numofbits = gt_elias_gamma_bitwise_decoder_next_bits(ebwd, bits,
+                                                            numofbits,
+                                                            symbol)) > 0) {
+    gt_bitinstream_skip_bits(bitstream, numofbits);
+    return had_err;
+  }
   while (!had_err && stat != 0) {
     if (RCR_NEXT_BIT(bit))
       stat = gt_elias_gamma_bitwise_decoder_next(ebwd, bit, symbol);
@@ -1981,7 +2007,7 @@ static int rcr_write_decoding_to_file(GtRcrDecoder *rcr_dec, GtError *err)
     gt_str_reset(qname);
     /* read read name */
     if (!had_err && rcr_dec->encdesc != NULL) {
-      if (gt_encdesc_decode(rcr_dec->encdesc, cur_read, qname, err) != 1) {
+      if (gt_encdesc_decode(rcr_dec->encdesc, cur_read, qname, err) != 0) {
         had_err = -1;
       }
     }
@@ -29,6 +29,7 @@
 #include "core/md5_seqid_api.h"
 #include "core/seq_col.h"
 #include "core/str_array.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "extended/mapping.h"
@@ -53,6 +54,7 @@ struct GtRegionMapping {
   GtUword rawlength,
                 rawoffset;
   unsigned int reference_count;
+  GtMutex *lock; /* serializes access to the currently loaded sequences */
 };
 
 GtRegionMapping* gt_region_mapping_new_mapping(GtStr *mapping_filename,
@@ -62,6 +64,7 @@ GtRegionMapping* gt_region_mapping_new_mapping(GtStr *mapping_filename,
   gt_error_check(err);
   gt_assert(mapping_filename);
   rm = gt_calloc(1, sizeof (GtRegionMapping));
+  rm->lock = gt_mutex_new();
   rm->mapping = gt_mapping_new(mapping_filename, "mapping",
                                GT_MAPPINGTYPE_STRING, err);
   if (!rm->mapping) {
@@ -78,6 +81,7 @@ GtRegionMapping* gt_region_mapping_new_seqfiles(GtStrArray *sequence_filenames,
   gt_assert(sequence_filenames);
   gt_assert(!(matchdesc && usedesc));
   rm = gt_calloc(1, sizeof (GtRegionMapping));
+  rm->lock = gt_mutex_new();
   rm->sequence_filenames = gt_str_array_ref(sequence_filenames);
   rm->matchdesc = matchdesc;
   rm->matchdescstart = false;
@@ -92,6 +96,7 @@ GtRegionMapping* gt_region_mapping_new_encseq(GtEncseq *encseq, bool matchdesc,
   gt_assert(encseq);
   gt_assert(!(matchdesc && usedesc));
   rm = gt_calloc(1, sizeof (GtRegionMapping));
+  rm->lock = gt_mutex_new();
   rm->encseq = gt_encseq_ref(encseq);
   rm->matchdesc = matchdesc;
   rm->usedesc = usedesc;
@@ -114,6 +119,7 @@ GtRegionMapping* gt_region_mapping_new_rawseq(const char *rawseq,
   GtRegionMapping *rm;
   gt_assert(rawseq);
   rm = gt_calloc(1, sizeof (GtRegionMapping));
+  rm->lock = gt_mutex_new();
   rm->userawseq = true;
   rm->rawseq = rawseq;
   rm->rawlength = length;
@@ -213,9 +219,9 @@ static int update_seq_col_if_necessary(GtRegionMapping *rm, GtStr *seqid,
   return had_err;
 }
 
-int gt_region_mapping_get_sequence(GtRegionMapping *rm, char **seq,
-                                   GtStr *seqid, GtUword start,
-                                   GtUword end, GtError *err)
+static int region_mapping_get_sequence(GtRegionMapping *rm, char **seq,
+                                       GtStr *seqid, GtUword start,
+                                       GtUword end, GtError *err)
 {
   int had_err = 0;
   GtUword offset = 1;
@@ -350,9 +356,9 @@ int gt_region_mapping_get_sequence(GtRegionMapping *rm, char **seq,
   return had_err;
 }
 
-int gt_region_mapping_get_sequence_length(GtRegionMapping *rm,
-                                          GtUword *length, GtStr *seqid,
-                                          GtError *err)
+static int region_mapping_get_sequence_length(GtRegionMapping *rm,
+                                              GtUword *length, GtStr *seqid,
+                                              GtError *err)
 {
   GtUword filenum, seqnum;
   int had_err;
@@ -412,8 +418,8 @@ int gt_region_mapping_get_sequence_length(GtRegionMapping *rm,
   return had_err;
 }
 
-int gt_region_mapping_get_description(GtRegionMapping *rm, GtStr *desc,
-                                      GtStr *seqid, GtError *err)
+static int region_mapping_get_description(GtRegionMapping *rm, GtStr *desc,
+                                          GtStr *seqid, GtError *err)
 {
   int had_err = 0;
   gt_error_check(err);
@@ -484,11 +490,11 @@ int gt_region_mapping_get_description(GtRegionMapping *rm, GtStr *desc,
   return had_err;
 }
 
-const char* gt_region_mapping_get_md5_fingerprint(GtRegionMapping *rm,
-                                                  GtStr *seqid,
-                                                  const GtRange *range,
-                                                  GtUword *offset,
-                                                  GtError *err)
+static const char* region_mapping_get_md5_fingerprint(GtRegionMapping *rm,
+                                                      GtStr *seqid,
+                                                      const GtRange *range,
+                                                      GtUword *offset,
+                                                      GtError *err)
 {
   const char *md5 = NULL;
   int had_err;
@@ -565,6 +571,75 @@ const char* gt_region_mapping_get_md5_fingerprint(GtRegionMapping *rm,
   return md5;
 }
 
+int gt_region_mapping_get_sequence(GtRegionMapping *rm, char **seq,
+                                   GtStr *seqid, GtUword start,
+                                   GtUword end, GtError *err)
+{
+  int had_err;
+  gt_assert(rm);
+  gt_mutex_lock(rm->lock);
+  had_err = region_mapping_get_sequence(rm, seq, seqid, start, end, err);
+  gt_mutex_unlock(rm->lock);
+  return had_err;
+}
+
+int gt_region_mapping_get_sequence_length(GtRegionMapping *rm,
+                                          GtUword *length, GtStr *seqid,
+                                          GtError *err)
+{
+  int had_err;
+  gt_assert(rm);
+  gt_mutex_lock(rm->lock);
+  had_err = region_mapping_get_sequence_length(rm, length, seqid, err);
+  gt_mutex_unlock(rm->lock);
+  return had_err;
+}
+
+int gt_region_mapping_get_description(GtRegionMapping *rm, GtStr *desc,
+                                      GtStr *seqid, GtError *err)
+{
+  int had_err;
+  gt_assert(rm);
+  gt_mutex_lock(rm->lock);
+  had_err = region_mapping_get_description(rm, desc, seqid, err);
+  gt_mutex_unlock(rm->lock);
+  return had_err;
+}
+
+const char* gt_region_mapping_get_md5_fingerprint(GtRegionMapping *rm,
+                                                  GtStr *seqid,
+                                                  const GtRange *range,
+                                                  GtUword *offset,
+                                                  GtError *err)
+{
+  const char *md5;
+  gt_assert(rm);
+  gt_mutex_lock(rm->lock);
+  md5 = region_mapping_get_md5_fingerprint(rm, seqid, range, offset, err);
+  gt_mutex_unlock(rm->lock);
+  return md5;
+}
+
+int gt_region_mapping_append_md5_fingerprint(GtRegionMapping *rm, GtStr *md5,
+                                             GtStr *seqid, const GtRange *range,
+                                             GtUword *offset, GtError *err)
+{
+  const char *fingerprint;
+  int had_err = 0;
+  gt_assert(rm && md5);
+  gt_mutex_lock(rm->lock);
+  /* the fingerprint is owned by the sequence collection, which may be
+     replaced by the next lookup, so copy it before releasing the lock */
+  fingerprint = region_mapping_get_md5_fingerprint(rm, seqid, range, offset,
+                                                   err);
+  if (fingerprint)
+    gt_str_append_cstr(md5, fingerprint);
+  else
+    had_err = -1;
+  gt_mutex_unlock(rm->lock);
+  return had_err;
+}
+
 void gt_region_mapping_delete(GtRegionMapping *rm)
 {
   if (!rm) return;
@@ -580,5 +655,6 @@ void gt_region_mapping_delete(GtRegionMapping *rm)
   gt_encseq_delete(rm->encseq);
   gt_seq_col_delete(rm->seq_col);
   gt_seqid2seqnum_mapping_delete(rm->seqid2seqnum_mapping);
+  gt_mutex_delete(rm->lock);
   gt_free(rm);
 }
@@ -100,6 +100,21 @@ const char*      gt_region_mapping_get_md5_fingerprint(GtRegionMapping
                                                        GtUword *offset,
                                                        GtError *err);
 
+/* Use <region_mapping> to get the MD5 fingerprint of the sequence with the
+   sequence ID <seqid> and its corresponding <range>. The fingerprint is
+   appended to <md5> and the offset of the sequence is stored in <offset>.
+   Unlike the fingerprint returned by <gt_region_mapping_get_md5_fingerprint()>,
+   which can be invalidated by a lookup in another thread, <md5> is safe to use
+   if <region_mapping> is shared between threads.
+   In the case of an error, -1 is returned and <err> is set accordingly. */
+int              gt_region_mapping_append_md5_fingerprint(GtRegionMapping
+                                                          *region_mapping,
+                                                          GtStr *md5,
+                                                          GtStr *seqid,
+                                                          const GtRange *range,
+                                                          GtUword *offset,
+                                                          GtError *err);
+
 /* Delete <region_mapping>. */
 void             gt_region_mapping_delete(GtRegionMapping *region_mapping);
 
@@ -219,33 +219,28 @@ static void get_pagewise_page(GtSampling *sampling,
                               GtUword *sampled_element,
                               size_t *position)
 {
-  GtWord start = (GtWord) -1,
-         end, middle;
+  GtUword start = 0,
+          end = sampling->numofsamples,
+          middle;
 
   gt_assert(sampling->numofsamples != 0);
-  /* should not overflow, because this is a small table indexing into a larger
-     one. */
-  gt_safe_assign(end, sampling->numofsamples);
-  middle = GT_DIV2(end);
-  while (end - start > (GtWord) 1) {
-    if (element_num < sampling->page_sampling[middle]) {
-      start = middle;
-    }
-    else {
-      end = middle;
-    }
+  gt_assert(sampling->page_sampling[0] == 0);
+  /* find the last sample with an element number not larger than
+     element_num */
+  while (end - start > 1UL) {
     middle = start + GT_DIV2(end - start);
-  }
-  if (middle < 0) {
-    middle = 0;
+    if (element_num < sampling->page_sampling[middle])
+      end = middle;
+    else
+      start = middle;
   }
   *sampled_element =
     sampling->current_sample_elementnum =
-    sampling->page_sampling[middle];
+    sampling->page_sampling[start];
 
-  sampling->current_sample_num = (GtUword) middle;
+  sampling->current_sample_num = start;
 
-  *position = sampling->samplingtab[middle];
+  *position = sampling->samplingtab[start];
 }
 
 void gt_sampling_get_page(GtSampling *sampling,
@@ -15,6 +15,7 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 #include <ctype.h>
+#include <limits.h>
 #include "core/chardef_api.h"
 #include "core/divmodmul_api.h"
 #include "core/ma_api.h"
@@ -102,6 +103,12 @@ GtWord gt_scorehandler_get_mismatchscore(const GtScoreHandler *scorehandler)
   return scorehandler->mismatchscore;
 }
 
+bool gt_scorehandler_has_scorematrix(const GtScoreHandler *scorehandler)
+{
+  gt_assert(scorehandler != NULL);
+  return scorehandler->scorematrix != NULL ? true : false;
+}
+
 GtWord gt_scorehandler_get_replacement(const GtScoreHandler *scorehandler,
                                        GtUchar a, GtUchar b)
 {
@@ -126,6 +133,46 @@ GtWord gt_scorehandler_get_replacement(const GtScoreHandler *scorehandler,
   return gt_score_matrix_get_score(scorehandler->scorematrix,a,b);
 }
 
+void gt_scorehandler_replacement_table_fill(const GtScoreHandler
+                                             *scorehandler,
+                                            GtWord **table,
+                                            const GtUchar *useq,
+                                            GtUword ulen,
+                                            const GtUchar *vseq,
+                                            GtUword vlen)
+{
+  bool occurs_in_u[UCHAR_MAX+1] = {false},
+       filled[UCHAR_MAX+1] = {false};
+  GtUword idx;
+  unsigned int a;
+
+  gt_assert(scorehandler != NULL && table != NULL);
+  for (idx = 0; idx < ulen; idx++)
+  {
+    occurs_in_u[useq[idx]] = true;
+  }
+  for (idx = 0; idx < vlen; idx++)
+  {
+    GtUchar b = vseq[idx];
+
+    if (!filled[b])
+    {
+      if (table[b] == NULL)
+      {
+        table[b] = gt_malloc(sizeof **table * (UCHAR_MAX+1));
+      }
+      for (a = 0; a <= UCHAR_MAX; a++)
+      {
+        table[b][a] = occurs_in_u[a]
+                        ? gt_scorehandler_get_replacement(scorehandler,
+                                                          (GtUchar) a, b)
+                        : 0;
+      }
+      filled[b] = true;
+    }
+  }
+}
+
 GtScoreHandler *gt_scorehandler2costhandler(const GtScoreHandler *scorehandler)
 {
   GtScoreHandler *costhandler;
@@ -52,11 +52,27 @@ GtWord          gt_scorehandler_get_gapscore(const GtScoreHandler
 GtWord gt_scorehandler_get_matchscore(const GtScoreHandler *scorehandler);
 /* Return mismatchscore value for the given <scorehandler>. */
 GtWord gt_scorehandler_get_mismatchscore(const GtScoreHandler *scorehandler);
+/* Return true if a score matrix was added to the given <scorehandler>. */
+bool            gt_scorehandler_has_scorematrix(const GtScoreHandler
+                                                *scorehandler);
 /* Return replacement score value for the given characters <a> and <b>. */
 GtWord          gt_scorehandler_get_replacement(const GtScoreHandler
                                                 *scorehandler,
                                                 GtUchar a,
                                                 GtUchar b);
+/* Fill the given <table> of <UCHAR_MAX>+1 rows with replacement score values
+   for all pairs of characters occurring in <useq>[0..<ulen>-1] and
+   <vseq>[0..<vlen>-1], such that <table>[b][a] equals the replacement score
+   of <a> and <b> as delivered by <gt_scorehandler_get_replacement()>. Rows of
+   characters occurring in <vseq> are allocated if they are <NULL>, all other
+   rows are left unchanged. */
+void            gt_scorehandler_replacement_table_fill(const GtScoreHandler
+                                                       *scorehandler,
+                                                       GtWord **table,
+                                                       const GtUchar *useq,
+                                                       GtUword ulen,
+                                                       const GtUchar *vseq,
+                                                       GtUword vlen);
 /* Return a <GtScoreHandler> object, which is generated by transforming score
    values of the given <scorehandler> to cost values. */
 GtScoreHandler *gt_scorehandler2costhandler(const GtScoreHandler *scorehandler);
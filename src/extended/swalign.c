@@ -16,9 +16,15 @@
 */
 
 #include <limits.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 #include "core/array2dim_api.h"
 #include "core/assert_api.h"
 #include "core/chardef_api.h"
+#include "core/ensure_api.h"
+#include "core/ma_api.h"
+#include "core/mathsupport_api.h"
 #include "core/minmax_api.h"
 #include "core/undef_api.h"
 #include "extended/swalign.h"
@@ -156,3 +162,506 @@ GtAlignment* gt_swalign(GtSeq *u, GtSeq *v, const GtScoreFunction *sf)
                               gt_score_function_get_insertion_score(sf),
                               gt_seq_get_alphabet(u), gt_seq_get_alphabet(v));
 }
+
+/* The profile follows the striped layout of Farrar (Bioinformatics 23(2),
+   2007): lane l of vector s holds query position s + l * seglen, so that the
+   dependencies along the query only have to be resolved between segments.
+   Scores are first computed with 16 unsigned 8-bit lanes and recomputed
+   with 8 signed 16-bit lanes if they saturate. */
+
+#ifdef __SSE2__
+#define SWALIGN_LANES8  16
+#define SWALIGN_LANES16 8
+#endif
+
+struct GtSWAlignProfile {
+  GtSeq *v;
+  const GtScoreFunction *sf;
+  const int **scores;
+  int deletion_score,
+      insertion_score;
+  unsigned int u_alpha_size;
+  GtUword vlen;
+  GtWord *row, /* workspaces of the scalar kernel and the traceback */
+         *col;
+  unsigned char *tb;
+  GtUword col_size,
+          tb_size;
+#ifdef __SSE2__
+  bool use8,
+       use16;
+  unsigned char bias;
+  GtUword seglen8,
+          seglen16;
+  __m128i *profile8, *profile16,
+          *h8, *h16; /* two columns each */
+  void *mem8, *mem16;
+#endif
+};
+
+static inline unsigned int swalign_code(GtUchar c, unsigned int alpha_size)
+{
+  return (unsigned int) ((c == GT_WILDCARD) ? alpha_size - 1 : c);
+}
+
+#ifdef __SSE2__
+/* returns <nof_vectors> 16-byte aligned vectors, <*mem> is to be freed */
+static __m128i* swalign_alloc_vectors(GtUword nof_vectors, void **mem)
+{
+  size_t addr;
+  *mem = gt_calloc((size_t) nof_vectors + 1, sizeof (__m128i));
+  addr = (size_t) *mem;
+  addr = (addr + 15) & ~((size_t) 15);
+  return (__m128i*) addr;
+}
+
+static void swalign_profile_init_simd(GtSWAlignProfile *p,
+                                      const GtUchar *v_enc,
+                                      unsigned int v_alpha_size)
+{
+  int minscore = 0, maxscore = 0;
+  unsigned int c;
+  GtUword j, s, l;
+
+  for (c = 0; c < p->u_alpha_size; c++) {
+    for (j = 0; j < p->vlen; j++) {
+      int sc = p->scores[c][swalign_code(v_enc[j], v_alpha_size)];
+      minscore = GT_MIN(minscore, sc);
+      maxscore = GT_MAX(maxscore, sc);
+    }
+  }
+  /* the kernels subtract gap costs with saturation at zero */
+  if (p->deletion_score > 0 || p->insertion_score > 0)
+    return;
+  p->use16 = maxscore - minscore < SHRT_MAX
+               && -p->deletion_score < SHRT_MAX
+               && -p->insertion_score < SHRT_MAX;
+  p->use8 = maxscore - minscore < UCHAR_MAX
+              && -p->deletion_score < UCHAR_MAX
+              && -p->insertion_score < UCHAR_MAX;
+  p->bias = (unsigned char) -minscore;
+
+  if (p->use8) {
+    p->seglen8 = (p->vlen + SWALIGN_LANES8 - 1) / SWALIGN_LANES8;
+    p->profile8 = swalign_alloc_vectors((GtUword) (p->u_alpha_size + 2)
+                                          * p->seglen8, &p->mem8);
+    p->h8 = p->profile8 + p->u_alpha_size * p->seglen8;
+    for (c = 0; c < p->u_alpha_size; c++) {
+      unsigned char *vec = (unsigned char*) (p->profile8 + c * p->seglen8);
+      for (s = 0; s < p->seglen8; s++) {
+        for (l = 0; l < (GtUword) SWALIGN_LANES8; l++) {
+          j = s + l * p->seglen8;
+          /* padding positions get the minimal score */
+          vec[s * SWALIGN_LANES8 + l] = (unsigned char)
+            (j < p->vlen
+               ? p->scores[c][swalign_code(v_enc[j], v_alpha_size)] - minscore
+               : 0);
+        }
+      }
+    }
+  }
+  if (p->use16) {
+    p->seglen16 = (p->vlen + SWALIGN_LANES16 - 1) / SWALIGN_LANES16;
+    p->profile16 = swalign_alloc_vectors((GtUword) (p->u_alpha_size + 2)
+                                           * p->seglen16, &p->mem16);
+    p->h16 = p->profile16 + p->u_alpha_size * p->seglen16;
+    for (c = 0; c < p->u_alpha_size; c++) {
+      short *vec = (short*) (p->profile16 + c * p->seglen16);
+      for (s = 0; s < p->seglen16; s++) {
+        for (l = 0; l < (GtUword) SWALIGN_LANES16; l++) {
+          j = s + l * p->seglen16;
+          vec[s * SWALIGN_LANES16 + l] = (short)
+            (j < p->vlen
+               ? p->scores[c][swalign_code(v_enc[j], v_alpha_size)]
+               : minscore);
+        }
+      }
+    }
+  }
+}
+
+/* returns the maximal score, or -1 if the lanes saturated */
+static GtWord swalign_score_simd8(GtSWAlignProfile *p, const GtUchar *u,
+                                  GtUword ulen)
+{
+  const GtUword seglen = p->seglen8;
+  __m128i *hload = p->h8, *hstore = p->h8 + seglen, *tmp,
+          vzero = _mm_setzero_si128(),
+          vbias = _mm_set1_epi8((char) p->bias),
+          vdel = _mm_set1_epi8((char) -p->deletion_score),
+          vins = _mm_set1_epi8((char) -p->insertion_score),
+          vmax = vzero, vh, ve, vf;
+  unsigned char lanes[SWALIGN_LANES8];
+  GtUword i, s;
+  unsigned int l, maxscore = 0;
+
+  for (s = 0; s < seglen; s++)
+    hstore[s] = vzero;
+  for (i = 0; i < ulen; i++) {
+    const __m128i *prof = p->profile8
+                            + swalign_code(u[i], p->u_alpha_size) * seglen;
+    vf = vzero;
+    /* diagonal predecessor of the first segment */
+    vh = _mm_slli_si128(hstore[seglen - 1], 1);
+    tmp = hload; hload = hstore; hstore = tmp;
+    for (s = 0; s < seglen; s++) {
+      vh = _mm_adds_epu8(vh, prof[s]);
+      vh = _mm_subs_epu8(vh, vbias);
+      ve = _mm_subs_epu8(hload[s], vdel);
+      vh = _mm_max_epu8(vh, ve);
+      vh = _mm_max_epu8(vh, vf);
+      vmax = _mm_max_epu8(vmax, vh);
+      hstore[s] = vh;
+      vf = _mm_subs_epu8(vh, vins);
+      vh = hload[s];
+    }
+    /* propagate insertions across segment boundaries */
+    vf = _mm_slli_si128(vf, 1);
+    s = 0;
+    while (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_subs_epu8(vf, hstore[s]),
+                                            vzero)) != 0xFFFF) {
+      hstore[s] = _mm_max_epu8(hstore[s], vf);
+      vf = _mm_subs_epu8(vf, vins);
+      if (++s == seglen) {
+        s = 0;
+        vf = _mm_slli_si128(vf, 1);
+      }
+    }
+  }
+  _mm_storeu_si128((__m128i*) lanes, vmax);
+  for (l = 0; l < (unsigned int) SWALIGN_LANES8; l++)
+    maxscore = GT_MAX(maxscore, (unsigned int) lanes[l]);
+  if (maxscore + p->bias >= UCHAR_MAX)
+    return -1;
+  return (GtWord) maxscore;
+}
+
+static GtWord swalign_score_simd16(GtSWAlignProfile *p, const GtUchar *u,
+                                   GtUword ulen)
+{
+  const GtUword seglen = p->seglen16;
+  __m128i *hload = p->h16, *hstore = p->h16 + seglen, *tmp,
+          vzero = _mm_setzero_si128(),
+          vdel = _mm_set1_epi16((short) -p->deletion_score),
+          vins = _mm_set1_epi16((short) -p->insertion_score),
+          vmax = vzero, vh, ve, vf;
+  short lanes[SWALIGN_LANES16];
+  GtUword i, s;
+  unsigned int l;
+  GtWord maxscore = 0;
+
+  for (s = 0; s < seglen; s++)
+    hstore[s] = vzero;
+  for (i = 0; i < ulen; i++) {
+    const __m128i *prof = p->profile16
+                            + swalign_code(u[i], p->u_alpha_size) * seglen;
+    vf = vzero;
+    vh = _mm_slli_si128(hstore[seglen - 1], 2);
+    tmp = hload; hload = hstore; hstore = tmp;
+    for (s = 0; s < seglen; s++) {
+      vh = _mm_adds_epi16(vh, prof[s]);
+      ve = _mm_subs_epi16(hload[s], vdel);
+      vh = _mm_max_epi16(vh, ve);
+      vh = _mm_max_epi16(vh, vf);
+      vh = _mm_max_epi16(vh, vzero);
+      vmax = _mm_max_epi16(vmax, vh);
+      hstore[s] = vh;
+      vf = _mm_subs_epi16(vh, vins);
+      vh = hload[s];
+    }
+    vf = _mm_slli_si128(vf, 2);
+    s = 0;
+    while (_mm_movemask_epi8(_mm_cmpgt_epi16(vf, hstore[s])) != 0) {
+      hstore[s] = _mm_max_epi16(hstore[s], vf);
+      vf = _mm_subs_epi16(vf, vins);
+      if (++s == seglen) {
+        s = 0;
+        vf = _mm_slli_si128(vf, 2);
+      }
+    }
+  }
+  _mm_storeu_si128((__m128i*) lanes, vmax);
+  for (l = 0; l < (unsigned int) SWALIGN_LANES16; l++)
+    maxscore = GT_MAX(maxscore, (GtWord) lanes[l]);
+  if (maxscore >= SHRT_MAX)
+    return -1;
+  return maxscore;
+}
+#endif
+
+static GtWord swalign_score_scalar(GtSWAlignProfile *p, const GtUchar *u,
+                                   GtUword ulen)
+{
+  const GtUchar *v_enc = gt_seq_get_encoded(p->v);
+  unsigned int v_alpha_size = gt_alphabet_size(gt_seq_get_alphabet(p->v));
+  GtWord maxscore = 0, diag, up, h;
+  GtUword i, j;
+
+  for (j = 0; j <= p->vlen; j++)
+    p->row[j] = 0;
+  for (i = 0; i < ulen; i++) {
+    const int *scores = p->scores[swalign_code(u[i], p->u_alpha_size)];
+    diag = 0;
+    for (j = 1; j <= p->vlen; j++) {
+      up = p->row[j];
+      h = diag + scores[swalign_code(v_enc[j-1], v_alpha_size)];
+      h = GT_MAX(h, up + p->deletion_score);
+      h = GT_MAX(h, p->row[j-1] + p->insertion_score);
+      h = GT_MAX(h, 0);
+      p->row[j] = h;
+      maxscore = GT_MAX(maxscore, h);
+      diag = up;
+    }
+  }
+  return maxscore;
+}
+
+GtSWAlignProfile* gt_swalign_profile_new(GtSeq *v, const GtAlphabet *u_alpha,
+                                         const GtScoreFunction *sf)
+{
+  GtSWAlignProfile *p;
+  gt_assert(v && u_alpha && sf);
+  p = gt_calloc((size_t) 1, sizeof (GtSWAlignProfile));
+  p->v = v;
+  p->sf = sf;
+  p->scores = gt_score_function_get_scores(sf);
+  p->deletion_score = gt_score_function_get_deletion_score(sf);
+  p->insertion_score = gt_score_function_get_insertion_score(sf);
+  p->u_alpha_size = gt_alphabet_size(u_alpha);
+  p->vlen = gt_seq_length(v);
+  p->row = gt_malloc((size_t) (p->vlen + 1) * sizeof (GtWord));
+#ifdef __SSE2__
+  if (p->vlen > 0) {
+    swalign_profile_init_simd(p, gt_seq_get_encoded(v),
+                              gt_alphabet_size(gt_seq_get_alphabet(v)));
+  }
+#endif
+  return p;
+}
+
+GtWord gt_swalign_profile_score(GtSWAlignProfile *p, GtSeq *u)
+{
+  const GtUchar *u_enc;
+  GtUword ulen;
+  gt_assert(p && u);
+  ulen = gt_seq_length(u);
+  if (ulen == 0 || p->vlen == 0)
+    return 0;
+  u_enc = gt_seq_get_encoded(u);
+#ifdef __SSE2__
+  if (p->use8) {
+    GtWord score = swalign_score_simd8(p, u_enc, ulen);
+    if (score >= 0)
+      return score;
+  }
+  if (p->use16) {
+    GtWord score = swalign_score_simd16(p, u_enc, ulen);
+    if (score >= 0)
+      return score;
+  }
+#endif
+  return swalign_score_scalar(p, u_enc, ulen);
+}
+
+#define SWALIGN_TB_REPLACEMENT 1
+#define SWALIGN_TB_DELETION    2
+#define SWALIGN_TB_INSERTION   4
+#define SWALIGN_TB_ZERO        8
+
+/* Recomputes the DP matrix with one byte per cell in the column order of
+   swalign_fill_table() up to the first cell reaching <maxscore>, which is the
+   end of the alignment gt_swalign() returns, and traces back from there. */
+static GtAlignment* swalign_recompute(GtSWAlignProfile *p, GtSeq *u,
+                                      GtWord maxscore)
+{
+  const GtUchar *u_enc = gt_seq_get_encoded(u),
+                *v_enc = gt_seq_get_encoded(p->v);
+  unsigned int v_alpha_size = gt_alphabet_size(gt_seq_get_alphabet(p->v));
+  GtUword i, j, ulen = gt_seq_length(u),
+          end_i = GT_UNDEF_UWORD, end_j = GT_UNDEF_UWORD;
+  GtRange urange, vrange;
+  GtAlignment *a;
+  GtWord diag, prev, h, rep, del, ins;
+
+  if (p->col_size < ulen + 1) {
+    p->col_size = ulen + 1;
+    p->col = gt_realloc(p->col, p->col_size * sizeof (GtWord));
+  }
+  if (p->tb_size < (ulen + 1) * (p->vlen + 1)) {
+    p->tb_size = (ulen + 1) * (p->vlen + 1);
+    p->tb = gt_realloc(p->tb, p->tb_size * sizeof (unsigned char));
+  }
+  for (i = 0; i <= ulen; i++) {
+    p->col[i] = 0;
+    p->tb[i] = SWALIGN_TB_ZERO;
+  }
+  for (j = 1; end_j == GT_UNDEF_UWORD && j <= p->vlen; j++) {
+    unsigned char *tb = p->tb + j * (ulen + 1);
+    unsigned int vval = swalign_code(v_enc[j-1], v_alpha_size);
+    tb[0] = SWALIGN_TB_ZERO;
+    diag = prev = 0;
+    for (i = 1; i <= ulen; i++) {
+      rep = diag + p->scores[swalign_code(u_enc[i-1], p->u_alpha_size)][vval];
+      del = prev + p->deletion_score;
+      ins = p->col[i] + p->insertion_score;
+      h = GT_MAX(GT_MAX(GT_MAX(rep, del), ins), 0);
+      tb[i] = (unsigned char) ((h == rep ? SWALIGN_TB_REPLACEMENT : 0)
+                               | (h == del ? SWALIGN_TB_DELETION : 0)
+                               | (h == ins ? SWALIGN_TB_INSERTION : 0)
+                               | (h == 0 ? SWALIGN_TB_ZERO : 0));
+      diag = p->col[i];
+      p->col[i] = prev = h;
+      if (h == maxscore) {
+        end_i = i;
+        end_j = j;
+        break;
+      }
+    }
+  }
+  gt_assert(end_i != GT_UNDEF_UWORD && end_j != GT_UNDEF_UWORD);
+
+  a = gt_alignment_new();
+  i = end_i;
+  j = end_j;
+  while (!(p->tb[j * (ulen + 1) + i] & SWALIGN_TB_ZERO)) {
+    unsigned char tb = p->tb[j * (ulen + 1) + i];
+    urange.start = i;
+    vrange.start = j;
+    if (tb & SWALIGN_TB_REPLACEMENT) {
+      gt_alignment_add_replacement(a);
+      i--;
+      j--;
+    }
+    else if (tb & SWALIGN_TB_DELETION) {
+      gt_alignment_add_deletion(a);
+      i--;
+    }
+    else {
+      gt_assert(tb & SWALIGN_TB_INSERTION);
+      gt_alignment_add_insertion(a);
+      j--;
+    }
+  }
+  /* transform the positions in the DP matrix to sequence positions */
+  urange.start--;
+  vrange.start--;
+  urange.end = end_i - 1;
+  vrange.end = end_j - 1;
+  gt_alignment_set_seqs(a,
+                        (const GtUchar *) (gt_seq_get_orig(u) + urange.start),
+                        urange.end - urange.start + 1,
+                        (const GtUchar *) (gt_seq_get_orig(p->v)
+                                           + vrange.start),
+                        vrange.end - vrange.start + 1);
+  gt_alignment_set_urange(a, urange);
+  gt_alignment_set_vrange(a, vrange);
+  return a;
+}
+
+void gt_swalign_batch(GtSWAlignProfile *p, GtSeq **targets,
+                      GtUword nof_targets, GtWord min_score,
+                      GtAlignment **alignments)
+{
+  GtUword i;
+  gt_assert(p && targets && alignments && min_score > 0);
+  for (i = 0; i < nof_targets; i++) {
+    GtWord score = gt_swalign_profile_score(p, targets[i]);
+    alignments[i] = NULL;
+    /* only hits reaching the threshold are traced back */
+    if (score >= min_score)
+      alignments[i] = swalign_recompute(p, targets[i], score);
+  }
+}
+
+void gt_swalign_profile_delete(GtSWAlignProfile *p)
+{
+  if (!p) return;
+  gt_free(p->row);
+  gt_free(p->col);
+  gt_free(p->tb);
+#ifdef __SSE2__
+  gt_free(p->mem8);
+  gt_free(p->mem16);
+#endif
+  gt_free(p);
+}
+
+static GtScoreFunction* swalign_test_scorefunc(GtAlphabet *a, int match,
+                                               int mismatch, int gap)
+{
+  GtScoreMatrix *sm = gt_score_matrix_new(a);
+  unsigned int m, n;
+  for (m = 0; m < gt_alphabet_size(a); m++) {
+    for (n = 0; n < gt_alphabet_size(a); n++)
+      gt_score_matrix_set_score(sm, m, n, (n == m ? match : mismatch));
+  }
+  return gt_score_function_new(sm, gap, gap);
+}
+
+int gt_swalign_unit_test(GtError *err)
+{
+  static const int params[][3] = { { 5, -10, -20 },
+                                   { 2, -1, -1 },
+                                   { 100, -30, -40 },
+                                   { 1000, -900, -700 } };
+  char useq[300], vseq[300];
+  GtAlphabet *a;
+  GtUword p, t;
+  int had_err = 0;
+  gt_error_check(err);
+
+  a = gt_alphabet_new_dna();
+  for (p = 0; !had_err && p < sizeof (params) / sizeof (params[0]); p++) {
+    GtScoreFunction *sf = swalign_test_scorefunc(a, params[p][0],
+                                                 params[p][1], params[p][2]);
+    for (t = 0; !had_err && t < 50UL; t++) {
+      GtUword i, ulen = 1 + gt_rand_max(200UL), vlen = 1 + gt_rand_max(120UL);
+      GtSeq *u, *v;
+      GtSWAlignProfile *prof;
+      GtAlignment *ali, *batch_ali;
+      GtWord score;
+      for (i = 0; i < vlen; i++)
+        vseq[i] = "acgtn"[gt_rand_max(t % 5 == 0 ? 4UL : 3UL)];
+      /* embed a mutated copy of the query */
+      for (i = 0; i < ulen; i++) {
+        if (i >= ulen / 4 && i - ulen / 4 < vlen && gt_rand_max(9UL) > 0)
+          useq[i] = vseq[i - ulen / 4];
+        else
+          useq[i] = "acgt"[gt_rand_max(3UL)];
+      }
+      u = gt_seq_new(useq, ulen, a);
+      v = gt_seq_new(vseq, vlen, a);
+      prof = gt_swalign_profile_new(v, a, sf);
+      score = gt_swalign_profile_score(prof, u);
+      gt_ensure(score == swalign_score_scalar(prof, gt_seq_get_encoded(u),
+                                              ulen));
+      ali = gt_swalign(u, v, sf);
+      gt_ensure((score == 0) == (ali == NULL));
+      gt_swalign_batch(prof, &u, 1UL, GT_MAX(score, 1), &batch_ali);
+      gt_ensure((batch_ali == NULL) == (ali == NULL));
+      if (!had_err && ali != NULL) {
+        gt_ensure(gt_alignment_eval(ali) == gt_alignment_eval(batch_ali));
+        gt_ensure(gt_alignment_get_length(ali)
+                    == gt_alignment_get_length(batch_ali));
+        gt_ensure(gt_alignment_get_urange(ali).start
+                    == gt_alignment_get_urange(batch_ali).start);
+        gt_ensure(gt_alignment_get_urange(ali).end
+                    == gt_alignment_get_urange(batch_ali).end);
+        gt_ensure(gt_alignment_get_vrange(ali).start
+                    == gt_alignment_get_vrange(batch_ali).start);
+        gt_ensure(gt_alignment_get_vrange(ali).end
+                    == gt_alignment_get_vrange(batch_ali).end);
+      }
+      gt_alignment_delete(batch_ali);
+      gt_swalign_batch(prof, &u, 1UL, score + 1, &batch_ali);
+      gt_ensure(batch_ali == NULL);
+      gt_alignment_delete(ali);
+      gt_swalign_profile_delete(prof);
+      gt_seq_delete(u);
+      gt_seq_delete(v);
+    }
+    gt_score_function_delete(sf);
+  }
+  gt_alphabet_delete(a);
+  return had_err;
+}
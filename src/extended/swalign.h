@@ -27,4 +27,29 @@
    If no such alignment was found, NULL is returned. */
 GtAlignment* gt_swalign(GtSeq *u, GtSeq *v, const GtScoreFunction*);
 
+/* A query profile of a sequence <v>, used to align <v> against many
+   sequences <u> with a striped SIMD kernel (if available). */
+typedef struct GtSWAlignProfile GtSWAlignProfile;
+
+/* Return a new profile for <v> and the score function <sf>, for aligning
+   against sequences over the alphabet <u_alpha>. <v> and <sf> must live as
+   long as the profile. */
+GtSWAlignProfile* gt_swalign_profile_new(GtSeq *v, const GtAlphabet *u_alpha,
+                                         const GtScoreFunction *sf);
+/* Return the score of an optimal local alignment of <u> and the profiled
+   sequence. */
+GtWord            gt_swalign_profile_score(GtSWAlignProfile *profile,
+                                           GtSeq *u);
+/* Align each of the <nof_targets> sequences in <targets> against the
+   profiled sequence. <alignments>[i] is set to the alignment
+   gt_swalign(targets[i], v, sf) would return if its score is at least
+   <min_score> (which must be positive), and to NULL otherwise. Only these
+   alignments are traced back. */
+void              gt_swalign_batch(GtSWAlignProfile *profile, GtSeq **targets,
+                                   GtUword nof_targets, GtWord min_score,
+                                   GtAlignment **alignments);
+void              gt_swalign_profile_delete(GtSWAlignProfile *profile);
+
+int               gt_swalign_unit_test(GtError *err);
+
 #endif
@@ -0,0 +1,1008 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/assert_api.h"
+#include "core/chardef_api.h"
+#include "core/divmodmul_api.h"
+#include "core/ensure_api.h"
+#include "core/ma_api.h"
+#include "core/mathsupport_api.h"
+#include "core/minmax_api.h"
+#include "extended/wavefrontalign.h"
+
+/* The wavefront alignment algorithm computes, for increasing cost values s,
+   the furthest reaching points of all alignments of cost s on each diagonal
+   of the DP-matrix. Diagonal k contains the cells (i,j) with j - i = k, the
+   offset of a cell is j. Besides the M-wavefront, which stores the furthest
+   reaching points of arbitrary alignments, the I- and D-wavefronts store the
+   furthest reaching points of alignments ending with an insertion or a
+   deletion, respectively. With penalties x for a mismatch and o + l * e for
+   a gap of length l, the wavefronts for cost s are
+     I_s(k) = max(M_{s-o-e}(k-1), I_{s-e}(k-1)) + 1
+     D_s(k) = max(M_{s-o-e}(k+1), D_{s-e}(k+1))
+     M_s(k) = max(M_{s-x}(k) + 1, I_s(k), D_s(k))
+   where M_s(k) is afterwards extended along the matching characters.
+
+   To obtain the alignment in space proportional to the distance, a forward
+   and a reverse wavefront search, which only keep the last few wavefronts,
+   are alternately advanced until they overlap on some diagonal. The cell of
+   the optimal overlap splits the problem into two subproblems, which are
+   solved recursively. Subproblems with small distance are solved by a
+   wavefront search keeping all wavefronts, followed by a traceback. Since an
+   optimal alignment may be split inside a gap, subproblems may start with a
+   gap already opened and may be required to end with a gap. */
+
+#define GT_WAVEFRONT_NULL         (-(GT_WORD_MAX >> 2))
+#define GT_WAVEFRONT_BASE_SCORE   256UL
+
+#define GT_WAVEFRONT_GET(WF,COMP,K)\
+        ((WF) != NULL && (K) >= (WF)->lo && (K) <= (WF)->hi\
+          ? (WF)->COMP[(K) - (WF)->lo]\
+          : GT_WAVEFRONT_NULL)
+
+typedef enum
+{
+  GtWavefrontM, /* no restriction on the first or last edit operation */
+  GtWavefrontI, /* start with an opened insertion or end with an insertion */
+  GtWavefrontD  /* start with an opened deletion or end with a deletion */
+} GtWavefrontState;
+
+typedef struct
+{
+  GtWord lo, hi, /* range of diagonals, empty if lo > hi */
+         *M, *I, *D;
+  GtUword allocated;
+} GtWavefront;
+
+typedef struct
+{
+  const GtUchar *useq, *vseq;
+  GtUword ulen, vlen;
+} GtWavefrontSeqpair;
+
+typedef struct
+{
+  GtUword score;
+  GtWavefrontState state;
+  GtWord diagonal, offset;
+} GtWavefrontBreakpoint;
+
+typedef struct
+{
+  GtUword mismatch,
+          gap_opening,
+          gap_extension,
+          max_penalty,
+          base_score,
+          cost;
+  GtWavefront *forward, *reverse, /* max_penalty + 1 wavefronts each */
+              *levels;            /* base_score + 1 wavefronts */
+  GtAlignment *align;
+  GtEoplist *eoplist;
+} GtWavefrontAligner;
+
+static GtWavefrontAligner *gt_wavefront_aligner_new(GtUword mismatch,
+                                                    GtUword gap_opening,
+                                                    GtUword gap_extension,
+                                                    GtUword base_score)
+{
+  GtWavefrontAligner *wfa = gt_malloc(sizeof *wfa);
+
+  gt_assert(mismatch > 0 && gap_extension > 0);
+  wfa->mismatch = mismatch;
+  wfa->gap_opening = gap_opening;
+  wfa->gap_extension = gap_extension;
+  wfa->max_penalty = GT_MAX(mismatch, gap_opening + gap_extension);
+  /* smaller distances do not guarantee that a breakpoint splits the
+     problem */
+  wfa->base_score = GT_MAX(base_score, GT_MULT2(wfa->max_penalty) + 2);
+  wfa->cost = 0;
+  wfa->forward = gt_calloc(wfa->max_penalty + 1, sizeof *wfa->forward);
+  wfa->reverse = gt_calloc(wfa->max_penalty + 1, sizeof *wfa->reverse);
+  wfa->levels = gt_calloc(wfa->base_score + 1, sizeof *wfa->levels);
+  wfa->align = NULL;
+  wfa->eoplist = NULL;
+  return wfa;
+}
+
+static void gt_wavefront_aligner_delete(GtWavefrontAligner *wfa)
+{
+  if (wfa != NULL)
+  {
+    GtUword idx;
+
+    for (idx = 0; idx <= wfa->max_penalty; idx++)
+    {
+      gt_free(wfa->forward[idx].M);
+      gt_free(wfa->reverse[idx].M);
+    }
+    for (idx = 0; idx <= wfa->base_score; idx++)
+    {
+      gt_free(wfa->levels[idx].M);
+    }
+    gt_free(wfa->forward);
+    gt_free(wfa->reverse);
+    gt_free(wfa->levels);
+    gt_free(wfa);
+  }
+}
+
+static void gt_wavefront_reserve(GtWavefront *wf, GtWord lo, GtWord hi)
+{
+  const GtUword width = (GtUword) (hi - lo + 1);
+
+  if (width > wf->allocated)
+  {
+    wf->allocated = width + (width >> 2) + 16;
+    wf->M = gt_realloc(wf->M, 3 * wf->allocated * sizeof *wf->M);
+  }
+  wf->I = wf->M + wf->allocated;
+  wf->D = wf->I + wf->allocated;
+  wf->lo = lo;
+  wf->hi = hi;
+}
+
+static bool gt_wavefront_is_empty(const GtWavefront *wf)
+{
+  return wf == NULL || wf->lo > wf->hi;
+}
+
+/* extend the offset on diagonal <k> along matching characters; in reverse
+   mode, the sequences are read from their ends */
+static GtWord gt_wavefront_extend(const GtWavefrontSeqpair *sp, bool reverse,
+                                  GtWord k, GtWord offset)
+{
+  GtUword j = (GtUword) offset, i = (GtUword) (offset - k);
+
+  gt_assert(i <= sp->ulen && j <= sp->vlen);
+  if (reverse)
+  {
+    const GtUchar *uptr = sp->useq + sp->ulen - i,
+                  *vptr = sp->vseq + sp->vlen - j;
+
+    while (i < sp->ulen && j < sp->vlen)
+    {
+      const GtUchar a = *--uptr;
+
+      if (a != *--vptr || GT_ISSPECIAL(a))
+      {
+        break;
+      }
+      i++;
+      j++;
+    }
+  } else
+  {
+    while (i < sp->ulen && j < sp->vlen)
+    {
+      const GtUchar a = sp->useq[i];
+
+      if (a != sp->vseq[j] || GT_ISSPECIAL(a))
+      {
+        break;
+      }
+      i++;
+      j++;
+    }
+  }
+  return (GtWord) j;
+}
+
+/* The wavefront for cost 0. For <forced> searches, the first edit operation
+   must be a gap of the type given by <state>, whose opening is accounted for
+   by the caller. */
+static void gt_wavefront_first(GtWavefront *wf, const GtWavefrontSeqpair *sp,
+                               bool reverse, GtWavefrontState state,
+                               bool forced)
+{
+  gt_wavefront_reserve(wf, 0, 0);
+  wf->M[0] = forced ? GT_WAVEFRONT_NULL
+                    : gt_wavefront_extend(sp, reverse, 0, 0);
+  wf->I[0] = state == GtWavefrontI ? 0 : GT_WAVEFRONT_NULL;
+  wf->D[0] = state == GtWavefrontD ? 0 : GT_WAVEFRONT_NULL;
+}
+
+static GtWord gt_wavefront_mismatch_source(const GtWavefront *wf_mismatch,
+                                           const GtWavefrontSeqpair *sp,
+                                           GtWord k)
+{
+  const GtWord offset = GT_WAVEFRONT_GET(wf_mismatch,M,k) + 1;
+
+  return offset <= 0 || offset > (GtWord) sp->vlen ||
+         offset - k > (GtWord) sp->ulen ? GT_WAVEFRONT_NULL : offset;
+}
+
+/* compute the wavefront <wf> for cost s from the wavefronts for the costs
+   s - mismatch, s - gap_opening - gap_extension and s - gap_extension,
+   which are NULL if the cost is negative */
+static void gt_wavefront_next(GtWavefront *wf,
+                              const GtWavefront *wf_mismatch,
+                              const GtWavefront *wf_open,
+                              const GtWavefront *wf_extend,
+                              const GtWavefrontSeqpair *sp,
+                              bool reverse)
+{
+  GtWord k, lo = GT_WORD_MAX, hi = -GT_WORD_MAX;
+
+  if (!gt_wavefront_is_empty(wf_mismatch))
+  {
+    lo = wf_mismatch->lo;
+    hi = wf_mismatch->hi;
+  }
+  if (!gt_wavefront_is_empty(wf_open))
+  {
+    lo = GT_MIN(lo, wf_open->lo - 1);
+    hi = GT_MAX(hi, wf_open->hi + 1);
+  }
+  if (!gt_wavefront_is_empty(wf_extend))
+  {
+    lo = GT_MIN(lo, wf_extend->lo - 1);
+    hi = GT_MAX(hi, wf_extend->hi + 1);
+  }
+  lo = GT_MAX(lo, -(GtWord) sp->ulen);
+  hi = GT_MIN(hi, (GtWord) sp->vlen);
+  if (lo > hi)
+  {
+    wf->lo = 1;
+    wf->hi = 0;
+    return;
+  }
+  gt_wavefront_reserve(wf, lo, hi);
+  for (k = lo; k <= hi; k++)
+  {
+    GtWord ins, del, best;
+
+    ins = GT_MAX(GT_WAVEFRONT_GET(wf_open,M,k-1),
+                 GT_WAVEFRONT_GET(wf_extend,I,k-1)) + 1;
+    if (ins <= 0 || ins > (GtWord) sp->vlen)
+    {
+      ins = GT_WAVEFRONT_NULL;
+    }
+    del = GT_MAX(GT_WAVEFRONT_GET(wf_open,M,k+1),
+                 GT_WAVEFRONT_GET(wf_extend,D,k+1));
+    if (del < 0 || del - k > (GtWord) sp->ulen)
+    {
+      del = GT_WAVEFRONT_NULL;
+    }
+    wf->I[k - lo] = ins;
+    wf->D[k - lo] = del;
+    best = GT_MAX3(gt_wavefront_mismatch_source(wf_mismatch,sp,k),ins,del);
+    wf->M[k - lo] = best < 0 ? GT_WAVEFRONT_NULL
+                             : gt_wavefront_extend(sp, reverse, k, best);
+  }
+}
+
+static void gt_wavefront_add_matches(GtWavefrontAligner *wfa, GtUword length)
+{
+  if (length > 0)
+  {
+    if (wfa->align != NULL)
+    {
+      gt_alignment_add_replacement_multi(wfa->align, length);
+    } else
+    {
+      gt_eoplist_match_add(wfa->eoplist, length);
+    }
+  }
+}
+
+static void gt_wavefront_add_mismatch(GtWavefrontAligner *wfa)
+{
+  if (wfa->align != NULL)
+  {
+    gt_alignment_add_replacement(wfa->align);
+  } else
+  {
+    gt_eoplist_mismatch_add(wfa->eoplist);
+  }
+}
+
+static void gt_wavefront_add_deletion(GtWavefrontAligner *wfa)
+{
+  if (wfa->align != NULL)
+  {
+    gt_alignment_add_deletion(wfa->align);
+  } else
+  {
+    gt_eoplist_deletion_add(wfa->eoplist);
+  }
+}
+
+static void gt_wavefront_add_insertion(GtWavefrontAligner *wfa)
+{
+  if (wfa->align != NULL)
+  {
+    gt_alignment_add_insertion(wfa->align);
+  } else
+  {
+    gt_eoplist_insertion_add(wfa->eoplist);
+  }
+}
+
+/* Edit operations are added from the end of the alignment to its start */
+static void gt_wavefront_traceback(GtWavefrontAligner *wfa,
+                                   const GtWavefrontSeqpair *sp,
+                                   GtUword score,
+                                   GtWavefrontState state)
+{
+  const GtUword gap_open_extend = wfa->gap_opening + wfa->gap_extension;
+  GtWord k = (GtWord) sp->vlen - (GtWord) sp->ulen,
+         offset = (GtWord) sp->vlen;
+
+  while (true)
+  {
+    const GtWavefront *wf = wfa->levels + score;
+
+    if (score == 0)
+    {
+      gt_assert(k == 0 && (state == GtWavefrontM || offset == 0));
+      gt_wavefront_add_matches(wfa, (GtUword) offset);
+      break;
+    }
+    if (state == GtWavefrontM)
+    {
+      const GtWord mis
+        = score >= wfa->mismatch
+            ? gt_wavefront_mismatch_source(wfa->levels + score - wfa->mismatch,
+                                           sp,k)
+            : GT_WAVEFRONT_NULL,
+                   ins = GT_WAVEFRONT_GET(wf,I,k),
+                   del = GT_WAVEFRONT_GET(wf,D,k),
+                   pre = GT_MAX3(mis,ins,del);
+
+      gt_assert(pre >= 0 && pre <= offset);
+      gt_wavefront_add_matches(wfa, (GtUword) (offset - pre));
+      offset = pre;
+      if (pre == mis)
+      {
+        gt_wavefront_add_mismatch(wfa);
+        score -= wfa->mismatch;
+        offset--;
+      } else
+      {
+        state = pre == ins ? GtWavefrontI : GtWavefrontD;
+      }
+    } else
+    {
+      const GtWavefront *wf_extend = score >= wfa->gap_extension
+                                       ? wfa->levels + score
+                                                     - wfa->gap_extension
+                                       : NULL;
+      if (state == GtWavefrontI)
+      {
+        gt_wavefront_add_insertion(wfa);
+        k--;
+        offset--;
+        if (GT_WAVEFRONT_GET(wf_extend,I,k) == offset)
+        {
+          score -= wfa->gap_extension;
+        } else
+        {
+          gt_assert(score >= gap_open_extend &&
+                    GT_WAVEFRONT_GET(wfa->levels + score - gap_open_extend,
+                                     M,k) == offset);
+          score -= gap_open_extend;
+          state = GtWavefrontM;
+        }
+      } else
+      {
+        gt_wavefront_add_deletion(wfa);
+        k++;
+        if (GT_WAVEFRONT_GET(wf_extend,D,k) == offset)
+        {
+          score -= wfa->gap_extension;
+        } else
+        {
+          gt_assert(score >= gap_open_extend &&
+                    GT_WAVEFRONT_GET(wfa->levels + score - gap_open_extend,
+                                     M,k) == offset);
+          score -= gap_open_extend;
+          state = GtWavefrontM;
+        }
+      }
+    }
+  }
+}
+
+static GtWavefront *gt_wavefront_source(GtWavefront *wavefronts,
+                                        GtUword numofwavefronts,
+                                        GtUword score,
+                                        GtUword penalty)
+{
+  return score >= penalty ? wavefronts + (score - penalty) % numofwavefronts
+                          : NULL;
+}
+
+/* Align <sp> keeping all wavefronts if the distance does not exceed
+   base_score. Returns false if the distance is larger. */
+static bool gt_wavefront_align_base(GtWavefrontAligner *wfa,
+                                    const GtWavefrontSeqpair *sp,
+                                    GtWavefrontState start_state,
+                                    GtWavefrontState end_state)
+{
+  const GtUword numofwavefronts = wfa->base_score + 1,
+                gap_open_extend = wfa->gap_opening + wfa->gap_extension;
+  const GtWord kend = (GtWord) sp->vlen - (GtWord) sp->ulen;
+  GtUword score;
+
+  for (score = 0; score <= wfa->base_score; score++)
+  {
+    GtWavefront *wf = wfa->levels + score;
+    GtWord endoffset;
+
+    if (score == 0)
+    {
+      gt_wavefront_first(wf, sp, false, start_state, false);
+    } else
+    {
+      gt_wavefront_next(wf,
+                        gt_wavefront_source(wfa->levels, numofwavefronts,
+                                            score, wfa->mismatch),
+                        gt_wavefront_source(wfa->levels, numofwavefronts,
+                                            score, gap_open_extend),
+                        gt_wavefront_source(wfa->levels, numofwavefronts,
+                                            score, wfa->gap_extension),
+                        sp, false);
+    }
+    switch (end_state)
+    {
+      case GtWavefrontI:
+        endoffset = GT_WAVEFRONT_GET(wf,I,kend);
+        break;
+      case GtWavefrontD:
+        endoffset = GT_WAVEFRONT_GET(wf,D,kend);
+        break;
+      default:
+        endoffset = GT_WAVEFRONT_GET(wf,M,kend);
+    }
+    if (endoffset == (GtWord) sp->vlen)
+    {
+      gt_wavefront_traceback(wfa, sp, score, end_state);
+      wfa->cost += score;
+      return true;
+    }
+  }
+  return false;
+}
+
+/* Record the overlap of a forward and a reverse wavefront on diagonal <k>
+   with furthest reaching offsets <fwd> and <rev>, if its cost <value> is
+   smaller than the best one found so far. The costs are monotone along the
+   diagonals, so every cell between the two furthest reaching points can be
+   used as breakpoint, except for cells at the border of the DP-matrix which
+   cannot be reached by alignments of the required form. Among these, the
+   cell closest to the middle antidiagonal is chosen. */
+static void gt_wavefront_breakpoint_update(GtWavefrontBreakpoint *bp,
+                                           GtWavefrontState state,
+                                           GtUword value,
+                                           GtWord k,
+                                           GtWord fwd,
+                                           GtWord rev,
+                                           const GtWavefrontSeqpair *sp,
+                                           GtWavefrontState end_state)
+{
+  const GtWord ulen = (GtWord) sp->ulen, vlen = (GtWord) sp->vlen;
+  GtWord jlow, jhigh, target;
+
+  if (fwd < 0 || rev < 0 || fwd + rev < vlen || value >= bp->score)
+  {
+    return;
+  }
+  jlow = GT_MAX(vlen - rev, GT_MAX(k, 0));
+  jhigh = GT_MIN(fwd, GT_MIN(vlen, ulen + k));
+  if (k == 0)
+  {
+    jlow = GT_MAX(jlow, 1);
+  }
+  if (k == vlen - ulen)
+  {
+    jhigh = GT_MIN(jhigh, vlen - 1);
+  }
+  if (state == GtWavefrontD)
+  {
+    jlow = GT_MAX(jlow, k + 1);
+  }
+  if (state == GtWavefrontD || end_state == GtWavefrontD)
+  {
+    jhigh = GT_MIN(jhigh, k + ulen - 1);
+  }
+  if (state == GtWavefrontI)
+  {
+    jlow = GT_MAX(jlow, 1);
+  }
+  if (state == GtWavefrontI || end_state == GtWavefrontI)
+  {
+    jhigh = GT_MIN(jhigh, vlen - 1);
+  }
+  if (jlow > jhigh)
+  {
+    return;
+  }
+  target = ((ulen + vlen) / 2 + k) / 2;
+  bp->score = value;
+  bp->state = state;
+  bp->diagonal = k;
+  bp->offset = GT_MIN(GT_MAX(target, jlow), jhigh);
+}
+
+static void gt_wavefront_breakpoint_check(GtWavefrontBreakpoint *bp,
+                                          const GtWavefront *fwd,
+                                          GtUword fwdscore,
+                                          const GtWavefront *rev,
+                                          GtUword revscore,
+                                          const GtWavefrontSeqpair *sp,
+                                          GtUword gap_opening,
+                                          GtWavefrontState end_state)
+{
+  const GtWord kend = (GtWord) sp->vlen - (GtWord) sp->ulen;
+  const GtUword value = fwdscore + revscore;
+  GtWord k, lo, hi;
+
+  if (gt_wavefront_is_empty(fwd) || gt_wavefront_is_empty(rev))
+  {
+    return;
+  }
+  lo = GT_MAX(fwd->lo, kend - rev->hi);
+  hi = GT_MIN(fwd->hi, kend - rev->lo);
+  for (k = lo; k <= hi; k++)
+  {
+    const GtWord kr = kend - k;
+
+    gt_wavefront_breakpoint_update(bp, GtWavefrontM, value, k,
+                                   fwd->M[k - fwd->lo], rev->M[kr - rev->lo],
+                                   sp, end_state);
+    if (value >= gap_opening)
+    {
+      gt_wavefront_breakpoint_update(bp, GtWavefrontI, value - gap_opening, k,
+                                     fwd->I[k - fwd->lo],
+                                     rev->I[kr - rev->lo], sp, end_state);
+      gt_wavefront_breakpoint_update(bp, GtWavefrontD, value - gap_opening, k,
+                                     fwd->D[k - fwd->lo],
+                                     rev->D[kr - rev->lo], sp, end_state);
+    }
+  }
+}
+
+/* Alternately advance the forward and the reverse search, always the one
+   with the smaller cost, and check the new wavefront for overlaps with the
+   wavefronts kept for the other direction. These are the last max_penalty + 1
+   wavefronts, which suffices to find an overlap of an optimal alignment
+   split at a point where the costs of the prefix and the suffix differ by
+   at most max_penalty. Once no later overlap can have a smaller cost than
+   the best one found, this is optimal. */
+static void gt_wavefront_breakpoint(GtWavefrontAligner *wfa,
+                                    GtWavefrontBreakpoint *bp,
+                                    const GtWavefrontSeqpair *sp,
+                                    GtWavefrontState start_state,
+                                    GtWavefrontState end_state)
+{
+  const GtUword numofwavefronts = wfa->max_penalty + 1,
+                gap_open_extend = wfa->gap_opening + wfa->gap_extension,
+                revshift = end_state == GtWavefrontM ? 0 : wfa->gap_opening;
+  GtUword fwdscore = 0, revscore = 0;
+
+  bp->score = GT_UWORD_MAX;
+  gt_wavefront_first(wfa->forward, sp, false, start_state, false);
+  gt_wavefront_first(wfa->reverse, sp, true, end_state,
+                     end_state != GtWavefrontM);
+  gt_wavefront_breakpoint_check(bp, wfa->forward, 0, wfa->reverse, revshift,
+                                sp, wfa->gap_opening, end_state);
+  while (bp->score == GT_UWORD_MAX ||
+         fwdscore + revscore + revshift + 1 < bp->score + wfa->max_penalty
+                                                        + wfa->gap_opening)
+  {
+    GtUword idx;
+
+    if (fwdscore <= revscore + revshift)
+    {
+      GtWavefront *wf;
+
+      fwdscore++;
+      wf = wfa->forward + fwdscore % numofwavefronts;
+      gt_wavefront_next(wf,
+                        gt_wavefront_source(wfa->forward, numofwavefronts,
+                                            fwdscore, wfa->mismatch),
+                        gt_wavefront_source(wfa->forward, numofwavefronts,
+                                            fwdscore, gap_open_extend),
+                        gt_wavefront_source(wfa->forward, numofwavefronts,
+                                            fwdscore, wfa->gap_extension),
+                        sp, false);
+      for (idx = 0; idx < numofwavefronts && idx <= revscore; idx++)
+      {
+        gt_wavefront_breakpoint_check(bp, wf, fwdscore,
+                                      wfa->reverse + (revscore - idx)
+                                                     % numofwavefronts,
+                                      revscore - idx + revshift, sp,
+                                      wfa->gap_opening, end_state);
+      }
+    } else
+    {
+      GtWavefront *wf;
+
+      revscore++;
+      wf = wfa->reverse + revscore % numofwavefronts;
+      gt_wavefront_next(wf,
+                        gt_wavefront_source(wfa->reverse, numofwavefronts,
+                                            revscore, wfa->mismatch),
+                        gt_wavefront_source(wfa->reverse, numofwavefronts,
+                                            revscore, gap_open_extend),
+                        gt_wavefront_source(wfa->reverse, numofwavefronts,
+                                            revscore, wfa->gap_extension),
+                        sp, true);
+      for (idx = 0; idx < numofwavefronts && idx <= fwdscore; idx++)
+      {
+        gt_wavefront_breakpoint_check(bp,
+                                      wfa->forward + (fwdscore - idx)
+                                                     % numofwavefronts,
+                                      fwdscore - idx, wf,
+                                      revscore + revshift, sp,
+                                      wfa->gap_opening, end_state);
+      }
+    }
+    gt_assert(fwdscore + revscore <=
+              GT_MULT2(wfa->max_penalty * (sp->ulen + sp->vlen + 2)));
+  }
+}
+
+static void gt_wavefront_align_rec(GtWavefrontAligner *wfa,
+                                   const GtUchar *useq, GtUword ulen,
+                                   const GtUchar *vseq, GtUword vlen,
+                                   GtWavefrontState start_state,
+                                   GtWavefrontState end_state)
+{
+  GtWavefrontSeqpair sp;
+  GtWavefrontBreakpoint bp;
+  GtUword idx, i, j;
+
+  if (ulen == 0 || vlen == 0)
+  {
+    if (ulen == 0 && vlen > 0)
+    {
+      gt_assert(end_state != GtWavefrontD);
+      for (idx = 0; idx < vlen; idx++)
+      {
+        gt_wavefront_add_insertion(wfa);
+      }
+      wfa->cost += vlen * wfa->gap_extension +
+                   (start_state == GtWavefrontI ? 0 : wfa->gap_opening);
+    } else
+    {
+      if (ulen > 0)
+      {
+        gt_assert(end_state != GtWavefrontI);
+        for (idx = 0; idx < ulen; idx++)
+        {
+          gt_wavefront_add_deletion(wfa);
+        }
+        wfa->cost += ulen * wfa->gap_extension +
+                     (start_state == GtWavefrontD ? 0 : wfa->gap_opening);
+      }
+    }
+    return;
+  }
+  sp.useq = useq;
+  sp.ulen = ulen;
+  sp.vseq = vseq;
+  sp.vlen = vlen;
+  if (gt_wavefront_align_base(wfa, &sp, start_state, end_state))
+  {
+    return;
+  }
+  gt_wavefront_breakpoint(wfa, &bp, &sp, start_state, end_state);
+  gt_assert(bp.score != GT_UWORD_MAX);
+  j = (GtUword) bp.offset;
+  i = (GtUword) (bp.offset - bp.diagonal);
+  gt_assert(i <= ulen && j <= vlen && i + j > 0 && i + j < ulen + vlen);
+  /* the alignment is constructed backwards */
+  gt_wavefront_align_rec(wfa, useq + i, ulen - i, vseq + j, vlen - j,
+                         bp.state, end_state);
+  gt_wavefront_align_rec(wfa, useq, i, vseq, j, start_state, bp.state);
+}
+
+/* Global alignment costs with match cost m > 0 are transformed such that
+   matches are free: as 2 * #matches + 2 * #mismatches + #gapsymbols equals
+   ulen + vlen, the cost of every alignment equals
+   (m * (ulen + vlen) + 2(x - m) * #mismatches + 2o * #gaps
+                      + (2e - m) * #gapsymbols) / 2. */
+static GtWavefrontAligner *gt_wavefront_aligner_new_scorehandler(
+                                          const GtScoreHandler *scorehandler,
+                                          GtUword base_score)
+{
+  const GtWord matchcost = gt_scorehandler_get_matchscore(scorehandler),
+               mismatchcost = gt_scorehandler_get_mismatchscore(scorehandler),
+               gap_opening = gt_scorehandler_get_gap_opening(scorehandler),
+               gap_extension = gt_scorehandler_get_gapscore(scorehandler);
+
+  if (matchcost == 0)
+  {
+    return gt_wavefront_aligner_new((GtUword) mismatchcost,
+                                    (GtUword) gap_opening,
+                                    (GtUword) gap_extension,
+                                    base_score);
+  }
+  return gt_wavefront_aligner_new((GtUword) GT_MULT2(mismatchcost - matchcost),
+                                  (GtUword) GT_MULT2(gap_opening),
+                                  (GtUword) (GT_MULT2(gap_extension)
+                                             - matchcost),
+                                  base_score);
+}
+
+int gt_wavefrontalign_check_scorehandler(const GtScoreHandler *scorehandler,
+                                         GtError *err)
+{
+  GtWord matchcost, mismatchcost, gap_opening, gap_extension;
+
+  gt_error_check(err);
+  gt_assert(scorehandler != NULL);
+  matchcost = gt_scorehandler_get_matchscore(scorehandler);
+  mismatchcost = gt_scorehandler_get_mismatchscore(scorehandler);
+  gap_opening = gt_scorehandler_get_gap_opening(scorehandler);
+  gap_extension = gt_scorehandler_get_gapscore(scorehandler);
+  if (gt_scorehandler_has_scorematrix(scorehandler))
+  {
+    gt_error_set(err, "wavefront alignment requires constant cost values");
+    return -1;
+  }
+  if (matchcost < 0 || mismatchcost <= matchcost || gap_opening < 0 ||
+      GT_MULT2(gap_extension) <= matchcost)
+  {
+    gt_error_set(err, "wavefront alignment requires nonnegative costs with "
+                      "mismatch cost > match cost and "
+                      "2 * gap extension cost > match cost");
+    return -1;
+  }
+  return 0;
+}
+
+static GtUword gt_wavefront_compute_generic(const GtScoreHandler *scorehandler,
+                                            GtUword base_score,
+                                            GtAlignment *align,
+                                            const GtUchar *useq,
+                                            GtUword ulen,
+                                            const GtUchar *vseq,
+                                            GtUword vlen)
+{
+  GtWavefrontAligner *wfa;
+  GtUword distance;
+  const GtWord matchcost = gt_scorehandler_get_matchscore(scorehandler);
+
+  gt_assert(align != NULL);
+  gt_alignment_set_seqs(align, useq, ulen, vseq, vlen);
+  wfa = gt_wavefront_aligner_new_scorehandler(scorehandler, base_score);
+  wfa->align = align;
+  gt_wavefront_align_rec(wfa, useq, ulen, vseq, vlen,
+                         GtWavefrontM, GtWavefrontM);
+  distance = matchcost == 0 ? wfa->cost
+                            : (wfa->cost + (GtUword) matchcost * (ulen + vlen))
+                              / 2;
+  gt_wavefront_aligner_delete(wfa);
+  return distance;
+}
+
+GtUword gt_wavefrontalign_compute_generic(const GtScoreHandler *scorehandler,
+                                          GtAlignment *align,
+                                          const GtUchar *useq,
+                                          GtUword ustart,
+                                          GtUword ulen,
+                                          const GtUchar *vseq,
+                                          GtUword vstart,
+                                          GtUword vlen)
+{
+  gt_assert(scorehandler != NULL);
+  return gt_wavefront_compute_generic(scorehandler, GT_WAVEFRONT_BASE_SCORE,
+                                      align, useq + ustart, ulen,
+                                      vseq + vstart, vlen);
+}
+
+GtUword gt_wavefrontalign_unit_eoplist(GtEoplist *eoplist,
+                                       const GtUchar *useq,
+                                       GtUword ulen,
+                                       const GtUchar *vseq,
+                                       GtUword vlen)
+{
+  GtWavefrontAligner *wfa;
+  GtUword distance;
+  const GtUword firstindex = gt_eoplist_length(eoplist);
+
+  gt_assert(eoplist != NULL);
+  wfa = gt_wavefront_aligner_new(1, 0, 1, GT_WAVEFRONT_BASE_SCORE);
+  wfa->eoplist = eoplist;
+  gt_wavefront_align_rec(wfa, useq, ulen, vseq, vlen,
+                         GtWavefrontM, GtWavefrontM);
+  gt_eoplist_reverse_end(eoplist, firstindex);
+  distance = wfa->cost;
+  gt_wavefront_aligner_delete(wfa);
+  return distance;
+}
+
+/* cost of an optimal global alignment of <useq> and <vseq> computed by the
+   recurrences of Gotoh in quadratic space */
+static GtUword gt_wavefront_gotoh_distance(const GtUchar *useq, GtUword ulen,
+                                           const GtUchar *vseq, GtUword vlen,
+                                           GtUword matchcost,
+                                           GtUword mismatchcost,
+                                           GtUword gap_opening,
+                                           GtUword gap_extension)
+{
+  const GtUword infinity = GT_UWORD_MAX >> 2, width = vlen + 1;
+  GtUword i, j, distance,
+          *R = gt_malloc(sizeof *R * 3 * (ulen + 1) * width),
+          *D = R + (ulen + 1) * width,
+          *I = D + (ulen + 1) * width;
+
+  for (i = 0; i <= ulen; i++)
+  {
+    for (j = 0; j <= vlen; j++)
+    {
+      const GtUword idx = i * width + j;
+
+      if (i == 0 && j == 0)
+      {
+        R[idx] = 0;
+        D[idx] = I[idx] = infinity;
+        continue;
+      }
+      D[idx] = i == 0 ? infinity
+                      : GT_MIN3(R[idx - width] + gap_opening,
+                                D[idx - width], I[idx - width] + gap_opening)
+                        + gap_extension;
+      I[idx] = j == 0 ? infinity
+                      : GT_MIN3(R[idx - 1] + gap_opening,
+                                D[idx - 1] + gap_opening, I[idx - 1])
+                        + gap_extension;
+      R[idx] = i == 0 || j == 0
+                 ? infinity
+                 : GT_MIN3(R[idx - width - 1], D[idx - width - 1],
+                           I[idx - width - 1])
+                   + (useq[i-1] == vseq[j-1] && !GT_ISSPECIAL(useq[i-1])
+                        ? matchcost : mismatchcost);
+    }
+  }
+  distance = GT_MIN3(R[ulen * width + vlen], D[ulen * width + vlen],
+                     I[ulen * width + vlen]);
+  gt_free(R);
+  return distance;
+}
+
+static void gt_wavefront_random_sequence(GtUchar *seq, GtUword len)
+{
+  GtUword idx;
+
+  for (idx = 0; idx < len; idx++)
+  {
+    seq[idx] = gt_rand_max(99) == 0 ? (GtUchar) GT_WILDCARD
+                                    : (GtUchar) gt_rand_max(3);
+  }
+}
+
+/* derive <vseq> from <useq> by random edit operations */
+static GtUword gt_wavefront_mutate_sequence(GtUchar *vseq, GtUword maxlen,
+                                            const GtUchar *useq, GtUword ulen,
+                                            GtUword errorpercentage)
+{
+  GtUword i = 0, vlen = 0;
+
+  while (i < ulen && vlen < maxlen)
+  {
+    if (gt_rand_max(99) < errorpercentage)
+    {
+      switch (gt_rand_max(2))
+      {
+        case 0:
+          vseq[vlen++] = (GtUchar) gt_rand_max(3);
+          i++;
+          break;
+        case 1:
+          i++;
+          break;
+        default:
+          vseq[vlen++] = (GtUchar) gt_rand_max(3);
+      }
+    } else
+    {
+      vseq[vlen++] = useq[i++];
+    }
+  }
+  return vlen;
+}
+
+int gt_wavefrontalign_unit_test(GtError *err)
+{
+  int had_err = 0;
+  const GtUword costs[][4] = {{0, 1, 0, 1},
+                              {0, 4, 6, 2},
+                              {0, 3, 0, 2},
+                              {1, 3, 0, 2},
+                              {1, 4, 3, 2}},
+                numofcosts = sizeof costs/sizeof costs[0],
+                maxlen = 120;
+  const GtUchar characters[] = "acgt";
+  GtUchar useq[120], vseq[120];
+  GtAlignment *align = gt_alignment_new();
+  GtEoplist *eoplist = gt_eoplist_new();
+  GtEoplistReader *eoplist_reader = gt_eoplist_reader_new();
+  GtUword trial;
+
+  gt_error_check(err);
+  for (trial = 0; !had_err && trial < 200; trial++)
+  {
+    const GtUword ulen = gt_rand_max(maxlen);
+    GtUword vlen, cidx;
+
+    gt_wavefront_random_sequence(useq, ulen);
+    if (trial % 4 == 0)
+    {
+      vlen = gt_rand_max(maxlen);
+      gt_wavefront_random_sequence(vseq, vlen);
+    } else
+    {
+      vlen = gt_wavefront_mutate_sequence(vseq, maxlen, useq, ulen,
+                                          gt_rand_max(40));
+    }
+    for (cidx = 0; !had_err && cidx < numofcosts; cidx++)
+    {
+      GtScoreHandler *scorehandler
+        = gt_scorehandler_new((GtWord) costs[cidx][0], (GtWord) costs[cidx][1],
+                              (GtWord) costs[cidx][2], (GtWord) costs[cidx][3]);
+      const GtUword expected
+        = gt_wavefront_gotoh_distance(useq, ulen, vseq, vlen, costs[cidx][0],
+                                      costs[cidx][1], costs[cidx][2],
+                                      costs[cidx][3]);
+      GtUword distance;
+
+      gt_ensure(gt_wavefrontalign_check_scorehandler(scorehandler, err) == 0);
+      gt_alignment_reset(align);
+      /* the smallest base score enforces the recursive division */
+      distance = gt_wavefront_compute_generic(scorehandler, 0, align, useq,
+                                              ulen, vseq, vlen);
+      gt_ensure(distance == expected);
+      gt_ensure(gt_scorehandler_eval_alignmentscore(scorehandler, align,
+                                                    characters)
+                == (GtWord) expected);
+      gt_alignment_reset(align);
+      distance = gt_wavefrontalign_compute_generic(scorehandler, align, useq,
+                                                   0, ulen, vseq, 0, vlen);
+      gt_ensure(distance == expected);
+      gt_ensure(gt_scorehandler_eval_alignmentscore(scorehandler, align,
+                                                    characters)
+                == (GtWord) expected);
+      gt_scorehandler_delete(scorehandler);
+    }
+    if (!had_err)
+    {
+      const GtUword expected
+        = gt_wavefront_gotoh_distance(useq, ulen, vseq, vlen, 0, 1, 0, 1);
+      GtUword distance;
+
+      gt_eoplist_reset(eoplist);
+      distance = gt_wavefrontalign_unit_eoplist(eoplist, useq, ulen, vseq,
+                                                vlen);
+      gt_ensure(distance == expected);
+      gt_ensure(gt_eoplist_deletions_count(eoplist) + vlen ==
+                gt_eoplist_insertions_count(eoplist) + ulen);
+      if (!had_err)
+      {
+        gt_eoplist_set_sequences(eoplist, useq, 0, ulen, vseq, 0, vlen);
+        gt_eoplist_verify(eoplist, eoplist_reader, distance);
+      }
+    }
+  }
+  gt_eoplist_reader_delete(eoplist_reader);
+  gt_eoplist_delete(eoplist);
+  gt_alignment_delete(align);
+  return had_err;
+}
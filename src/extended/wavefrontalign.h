@@ -0,0 +1,65 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef WAVEFRONTALIGN_H
+#define WAVEFRONTALIGN_H
+
+#include "core/error_api.h"
+#include "core/types_api.h"
+#include "extended/alignment.h"
+#include "extended/scorehandler.h"
+#include "match/ft-eoplist.h"
+
+/* Checks if the cost values of <scorehandler> can be handled by the
+   wavefront alignment algorithm. This requires constant cost values (no
+   substitution matrix), a mismatch cost larger than the match cost and a gap
+   extension cost larger than half of the match cost. Returns 0 if this is the
+   case, otherwise -1 and <err> is set. */
+int     gt_wavefrontalign_check_scorehandler(const GtScoreHandler *scorehandler,
+                                             GtError *err);
+
+/* Computes a global alignment of the encoded sequences <useq> and <vseq>
+   with the wavefront alignment algorithm, with the regions to align given by
+   their start positions <ustart> and <vstart> and lengths <ulen> and <vlen>.
+   The cost values are given by <scorehandler>, which must pass
+   <gt_wavefrontalign_check_scorehandler()>. A gap opening cost of 0 leads to
+   linear gap costs, otherwise a gap of length l costs gap opening plus l
+   times gap extension. The time is proportional to the sum of the sequence
+   lengths times the distance, the space is proportional to the distance.
+   The alignment is stored in <align>. Returns the distance of the
+   alignment. */
+GtUword gt_wavefrontalign_compute_generic(const GtScoreHandler *scorehandler,
+                                          GtAlignment *align,
+                                          const GtUchar *useq,
+                                          GtUword ustart,
+                                          GtUword ulen,
+                                          const GtUchar *vseq,
+                                          GtUword vstart,
+                                          GtUword vlen);
+
+/* Computes an optimal unit cost alignment of the encoded sequences
+   <useq>[0..<ulen>-1] and <vseq>[0..<vlen>-1] with the wavefront alignment
+   algorithm and appends the edit operations to <eoplist>. Returns the unit
+   edit distance. */
+GtUword gt_wavefrontalign_unit_eoplist(GtEoplist *eoplist,
+                                       const GtUchar *useq,
+                                       GtUword ulen,
+                                       const GtUchar *vseq,
+                                       GtUword vlen);
+
+int     gt_wavefrontalign_unit_test(GtError *err);
+
+#endif
@@ -168,6 +168,7 @@ extern "C" {
 #include "annotationsketch/canvas_cairo_file_api.h"
 #include "annotationsketch/color_api.h"
 #include "annotationsketch/custom_track_api.h"
+#include "annotationsketch/custom_track_density_api.h"
 #include "annotationsketch/custom_track_gc_content_api.h"
 #include "annotationsketch/custom_track_script_wrapper_api.h"
 #include "annotationsketch/diagram_api.h"
@@ -178,6 +179,7 @@ extern "C" {
 #include "annotationsketch/style_api.h"
 #include "annotationsketch/text_width_calculator_api.h"
 #include "annotationsketch/text_width_calculator_cairo_api.h"
+#include "annotationsketch/tile_renderer_api.h"
 #endif
 
 #ifdef __cplusplus
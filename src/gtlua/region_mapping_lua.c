@@ -168,24 +168,30 @@ static int region_mapping_lua_get_md5_fingerprint(lua_State *L)
 {
   GtRegionMapping **region_mapping;
   GtError *err;
-  GtStr *seqidstr;
+  GtStr *seqidstr, *md5;
   GtRange *rng = NULL;
   GtUword offset;
-  const char *md5 = NULL, *seqid;
+  const char *seqid;
+  int had_err;
   gt_assert(L);
   region_mapping = check_region_mapping(L, 1);
   seqid = luaL_checkstring(L, 2);
   if (lua_gettop(L) == 3)
     rng = check_range(L, 3);
   seqidstr = gt_str_new_cstr(seqid);
+  md5 = gt_str_new();
   err = gt_error_new();
-  md5 = gt_region_mapping_get_md5_fingerprint(*region_mapping, seqidstr,
-                                              rng, &offset, err);
+  had_err = gt_region_mapping_append_md5_fingerprint(*region_mapping, md5,
+                                                     seqidstr, rng, &offset,
+                                                     err);
   gt_str_delete(seqidstr);
-  if (!md5)
+  if (had_err) {
+    gt_str_delete(md5);
     return gt_lua_error(L, err);
+  }
   gt_error_delete(err);
-  lua_pushstring(L, md5);
+  lua_pushstring(L, gt_str_get(md5));
+  gt_str_delete(md5);
   lua_pushnumber(L, offset);
   return 2;
 }
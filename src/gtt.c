@@ -25,6 +25,7 @@
 #include "core/bitpackarray.h"
 #include "core/bitpackstring.h"
 #include "core/bittab.h"
+#include "core/bounded_queue.h"
 #include "core/bsearch.h"
 #include "core/codon_iterator_encseq_api.h"
 #include "core/codon_iterator_simple_api.h"
@@ -42,6 +43,7 @@
 #include "core/grep_api.h"
 #include "core/hashmap_api.h"
 #include "core/hashtable.h"
+#include "core/interval_index.h"
 #include "core/interval_tree.h"
 #include "core/mathsupport_api.h"
 #include "core/md5_seqid_api.h"
@@ -55,6 +57,7 @@
 #include "core/translator.h"
 #include "extended/alignment.h"
 #include "extended/anno_db_gfflike_api.h"
+#include "extended/batchalign.h"
 #include "extended/compressed_bitsequence.h"
 #include "extended/editscript.h"
 #include "extended/elias_gamma.h"
@@ -62,18 +65,23 @@
 #include "extended/evaluator.h"
 #include "extended/feature_in_stream.h"
 #include "extended/feature_index.h"
+#include "extended/feature_index_file.h"
 #include "extended/feature_index_memory.h"
 #include "extended/feature_node.h"
 #include "extended/feature_node_iterator_api.h"
 #include "extended/genome_node.h"
 #include "extended/gff3_escaping_api.h"
+#include "extended/gff3_region_index.h"
 #include "extended/golomb.h"
 #include "extended/hmm.h"
 #include "extended/huffcode.h"
 #include "extended/intset.h"
 #include "extended/kmer_database.h"
+#include "extended/linearalign.h"
 #include "extended/luaserialize.h"
 #include "extended/multieoplist.h"
+#include "extended/parallel_visitor_stream.h"
+#include "extended/pipeline_stream.h"
 #include "extended/popcount_tab.h"
 #include "extended/priority_queue.h"
 #include "extended/ranked_list.h"
@@ -81,13 +89,17 @@
 #include "extended/rmq.h"
 #include "extended/splicedseq.h"
 #include "extended/string_matching.h"
+#include "extended/swalign.h"
 #include "extended/tag_value_map.h"
 #include "extended/uint64hashtable.h"
+#include "extended/wavefrontalign.h"
 #include "ltr/gt_ltrclustering.h"
 #include "ltr/gt_ltrdigest.h"
 #include "ltr/gt_ltrharvest.h"
 #include "ltr/ltrdigest_pbs_visitor.h"
+#include "ltr/pdom_profile.h"
 #include "match/karlin_altschul_stat.h"
+#include "match/rdj-spmbuffer.h"
 #include "match/rdj-spmlist.h"
 #include "match/rdj-strgraph.h"
 #include "match/shu-encseq-gc.h"
@@ -117,6 +129,7 @@
 #include "tools/gt_genomediff.h"
 #include "tools/gt_gff3.h"
 #include "tools/gt_gff3_to_gtf.h"
+#include "tools/gt_gff3_index.h"
 #include "tools/gt_gff3validator.h"
 #include "tools/gt_gtf_to_gff3.h"
 #include "tools/gt_hop.h"
@@ -175,6 +188,7 @@
 #include "annotationsketch/image_info.h"
 #include "annotationsketch/rec_map.h"
 #include "annotationsketch/style.h"
+#include "annotationsketch/tile_renderer.h"
 #include "annotationsketch/track.h"
 #endif
 
@@ -214,6 +228,7 @@ GtToolbox* gtt_tools(void)
   gt_toolbox_add_tool(tools, "genomediff", gt_genomediff());
   gt_toolbox_add_tool(tools, "gff3", gt_gff3());
   gt_toolbox_add_tool(tools, "gff3_to_gtf", gt_gff3_to_gtf());
+  gt_toolbox_add_tool(tools, "gff3_index", gt_gff3_index());
   gt_toolbox_add_tool(tools, "gff3validator", gt_gff3validator());
   gt_toolbox_add_tool(tools, "gtf_to_gff3", gt_gtf_to_gff3());
   gt_toolbox_add_tool(tools, "hop", gt_hop());
@@ -266,10 +281,8 @@ GtToolbox* gtt_tools(void)
   gt_toolbox_add_tool(tools, "sketch", gt_sketch());
   gt_toolbox_add_tool(tools, "sketch_page", gt_sketch_page());
 #endif
-#if defined (HAVE_MYSQL) || defined (HAVE_SQLITE)
   gt_toolbox_add_tool(tools, "featureindex", gt_featureindex());
   gt_toolbox_add_tool(tools, "mkfeatureindex", gt_mkfeatureindex());
-#endif
 
   return tools;
 }
@@ -289,11 +302,14 @@ GtHashmap* gtt_unit_tests(void)
                                                    gt_array2dim_sparse_example);
   gt_hashmap_add(unit_tests, "array3dim example", gt_array3dim_example);
   gt_hashmap_add(unit_tests, "basename module", gt_basename_unit_test);
+  gt_hashmap_add(unit_tests, "batch alignment", gt_batchalign_unit_test);
   gt_hashmap_add(unit_tests, "bit pack array class", gt_bitpackarray_unit_test);
   gt_hashmap_add(unit_tests, "bit pack string module",
                                                     gt_bitPackString_unit_test);
   gt_hashmap_add(unit_tests, "bittab class", gt_bittab_unit_test);
   gt_hashmap_add(unit_tests, "bittab example", gt_bittab_example);
+  gt_hashmap_add(unit_tests, "bounded queue class",
+                                                  gt_bounded_queue_unit_test);
   gt_hashmap_add(unit_tests, "bsearch module", gt_bsearch_unit_test);
   gt_hashmap_add(unit_tests, "codon iterator class, simple",
                                             gt_codon_iterator_simple_unit_test);
@@ -327,20 +343,28 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "feature node class", gt_feature_node_unit_test);
   gt_hashmap_add(unit_tests, "feature in stream class",
                                                 gt_feature_in_stream_unit_test);
+  gt_hashmap_add(unit_tests, "file feature index class",
+                                               gt_feature_index_file_unit_test);
   gt_hashmap_add(unit_tests, "genome node class", gt_genome_node_unit_test);
   gt_hashmap_add(unit_tests, "gff3 escaping module",
                                                     gt_gff3_escaping_unit_test);
+  gt_hashmap_add(unit_tests, "gff3 region index class",
+                                               gt_gff3_region_index_unit_test);
   gt_hashmap_add(unit_tests, "grep module", gt_grep_unit_test);
   gt_hashmap_add(unit_tests, "golomb class", gt_golomb_unit_test);
   gt_hashmap_add(unit_tests, "hashmap class", gt_hashmap_unit_test);
   gt_hashmap_add(unit_tests, "hashtable class", gt_hashtable_unit_test);
   gt_hashmap_add(unit_tests, "hmm class", gt_hmm_unit_test);
   gt_hashmap_add(unit_tests, "huffman coding class", gt_huffman_unit_test);
+  gt_hashmap_add(unit_tests, "interval index class",
+                                                   gt_interval_index_unit_test);
   gt_hashmap_add(unit_tests, "interval tree class", gt_interval_tree_unit_test);
   gt_hashmap_add(unit_tests, "intset classes", gt_intset_unit_test);
   gt_hashmap_add(unit_tests, "karlin altschul class",
                                              gt_karlin_altschul_stat_unit_test);
   gt_hashmap_add(unit_tests, "kmer_database class", gt_kmer_database_unit_test);
+  gt_hashmap_add(unit_tests, "linear space alignment module",
+                                                      gt_linearalign_unit_test);
   gt_hashmap_add(unit_tests, "Lua serializer module",
                                                    gt_lua_serializer_unit_test);
   gt_hashmap_add(unit_tests, "mathsupport module", gt_mathsupport_unit_test);
@@ -349,8 +373,15 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "MD5 seqid module", gt_md5_seqid_unit_test);
   gt_hashmap_add(unit_tests, "rdj: suffix-prefix matches list module",
                                                           gt_spmlist_unit_test);
+  gt_hashmap_add(unit_tests, "rdj: suffix-prefix matches buffer class",
+                                                        gt_spmbuffer_unit_test);
   gt_hashmap_add(unit_tests, "PBS finder module",
                                             gt_ltrdigest_pbs_visitor_unit_test);
+  gt_hashmap_add(unit_tests, "parallel visitor stream class",
+                                         gt_parallel_visitor_stream_unit_test);
+  gt_hashmap_add(unit_tests, "pdom profile class", gt_pdom_profile_unit_test);
+  gt_hashmap_add(unit_tests, "pipeline stream class",
+                                                 gt_pipeline_stream_unit_test);
   gt_hashmap_add(unit_tests, "popcount sorted tab", gt_popcount_tab_unit_test);
   gt_hashmap_add(unit_tests, "quality module", gt_quality_unit_test);
   gt_hashmap_add(unit_tests, "queue class", gt_queue_unit_test);
@@ -370,6 +401,7 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "string class", gt_str_unit_test);
   gt_hashmap_add(unit_tests, "string matching module",
                                                   gt_string_matching_unit_test);
+  gt_hashmap_add(unit_tests, "Smith-Waterman module", gt_swalign_unit_test);
   gt_hashmap_add(unit_tests, "symbol module", gt_symbol_unit_test);
   gt_hashmap_add(unit_tests, "tag value map class", gt_tag_value_map_unit_test);
   gt_hashmap_add(unit_tests, "tag value map example", gt_tag_value_map_example);
@@ -377,6 +409,8 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "translator class", gt_translator_unit_test);
   gt_hashmap_add(unit_tests, "transtable class", gt_trans_table_unit_test);
   gt_hashmap_add(unit_tests, "uint64hashtable", gt_uint64hashtable_unit_test);
+  gt_hashmap_add(unit_tests, "wavefront alignment",
+                                                   gt_wavefrontalign_unit_test);
   gt_hashmap_add(unit_tests, "xdrop", gt_xdrop_unit_test);
 #ifndef WITHOUT_CAIRO
   gt_hashmap_add(unit_tests, "block class", gt_block_unit_test);
@@ -387,6 +421,8 @@ GtHashmap* gtt_unit_tests(void)
                                              gt_feature_index_memory_unit_test);
   gt_hashmap_add(unit_tests, "imageinfo class", gt_image_info_unit_test);
   gt_hashmap_add(unit_tests, "line class", gt_line_unit_test);
+  gt_hashmap_add(unit_tests, "tile renderer class",
+                                                    gt_tile_renderer_unit_test);
   gt_hashmap_add(unit_tests, "track class", gt_track_unit_test);
 #endif
 #if defined (HAVE_MYSQL) || defined (HAVE_SQLITE)
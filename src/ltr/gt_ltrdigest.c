@@ -32,6 +32,7 @@
 #include "core/warning_api.h"
 #include "extended/gff3_in_stream.h"
 #include "extended/gff3_out_stream_api.h"
+#include "extended/parallel_visitor_stream_api.h"
 #include "extended/region_mapping.h"
 #include "extended/seqid2file_api.h"
 #include "extended/visitor_stream.h"
@@ -46,7 +47,7 @@
 #include "ltr/pdom_model_set.h"
 
 typedef struct GtLTRdigestOptions {
-  GtStr *trna_lib, *prefix, *cutoffs;
+  GtStr *trna_lib, *prefix, *cutoffs, *pdom_engine;
   bool verbose,
        write_alignments,
        write_aaseqs,
@@ -91,6 +92,7 @@ static void* gt_ltrdigest_arguments_new(void)
   arguments->trna_lib = gt_str_new();
   arguments->prefix = gt_str_new();
   arguments->cutoffs = gt_str_new();
+  arguments->pdom_engine = gt_str_new();
   arguments->ofi = gt_output_file_info_new();
   arguments->hmm_files = gt_str_array_new();
   arguments->s2fi = gt_seqid2file_info_new();
@@ -104,6 +106,7 @@ static void gt_ltrdigest_arguments_delete(void *tool_arguments)
   gt_str_delete(arguments->trna_lib);
   gt_str_delete(arguments->prefix);
   gt_str_delete(arguments->cutoffs);
+  gt_str_delete(arguments->pdom_engine);
   gt_str_array_delete(arguments->hmm_files);
   gt_file_delete(arguments->outfp);
   gt_output_file_info_delete(arguments->ofi);
@@ -117,7 +120,8 @@ static GtOptionParser* gt_ltrdigest_option_parser_new(void *tool_arguments)
   GtOptionParser *op;
   GtOption *o, *ot, *oto;
   GtOption *oh, *oc, *oeval;
-  static const char *cutoffs[] = {"NONE", "GA", "TC", NULL};
+  static const char *cutoffs[] = {"NONE", "GA", "TC", NULL},
+                    *engines[] = {"hmmer", "builtin", NULL};
   static GtRange pptlen_defaults           = { 8UL, 30UL},
                  uboxlen_defaults          = { 3UL, 30UL},
                  pbsalilen_defaults        = {11UL, 30UL},
@@ -306,6 +310,15 @@ static GtOptionParser* gt_ltrdigest_option_parser_new(void *tool_arguments)
   gt_option_is_extended_option(oeval);
   gt_option_imply(oeval, oh);
 
+  o = gt_option_new_choice("pdomengine", "pHMM search engine\n"
+                                         "choose from hmmer (run hmmscan) | "
+                                         "builtin (search HMMER3 models "
+                                         "in-process)",
+                           arguments->pdom_engine, engines[0], engines);
+  gt_option_parser_add_option(op, o);
+  gt_option_is_extended_option(o);
+  gt_option_imply(o, oh);
+
   o = gt_option_new_bool("aliout",
                          "output pHMM to amino acid sequence alignments",
                          &arguments->write_alignments,
@@ -429,6 +442,75 @@ int gt_ltrdigest_arguments_check(GT_UNUSED int rest_argc, void *tool_arguments,
   return had_err;
 }
 
+typedef struct {
+  GtLTRdigestOptions *arguments;
+  GtRegionMapping *rmap;
+  GtPdomModelSet *ms;
+} GtLTRdigestWorkerInfo;
+
+/* sets up the pdom, PBS and PPT visitors of one worker */
+static int gt_ltrdigest_worker_visitors(GtArray *visitors, void *data,
+                                        GtError *err)
+{
+  GtLTRdigestWorkerInfo *info = data;
+  GtLTRdigestOptions *arguments = info->arguments;
+  GtNodeVisitor *nv;
+  int had_err = 0;
+  gt_error_check(err);
+
+  if (info->ms != NULL) {
+    nv = gt_ltrdigest_pdom_visitor_new(info->ms, arguments->evalue_cutoff,
+                                       arguments->chain_max_gap_length,
+                                       arguments->cutoff, info->rmap, err);
+    if (nv == NULL)
+      had_err = -1;
+    if (!had_err) {
+      gt_ltrdigest_pdom_visitor_set_source_tag((GtLTRdigestPdomVisitor*) nv,
+                                               GT_LTRDIGEST_TAG);
+      if (arguments->output_all_chains)
+        gt_ltrdigest_pdom_visitor_output_all_chains((GtLTRdigestPdomVisitor*)
+                                                                            nv);
+      gt_array_add(visitors, nv);
+    }
+  }
+
+  if (!had_err && arguments->trna_lib_bs) {
+    nv = gt_ltrdigest_pbs_visitor_new(info->rmap, arguments->pbs_radius,
+                                      arguments->max_edist,
+                                      arguments->alilen,
+                                      arguments->offsetlen,
+                                      arguments->trnaoffsetlen,
+                                      arguments->ali_score_match,
+                                      arguments->ali_score_mismatch,
+                                      arguments->ali_score_insertion,
+                                      arguments->ali_score_deletion,
+                                      arguments->trna_lib_bs, err);
+    if (nv != NULL)
+      gt_array_add(visitors, nv);
+    else
+      had_err = -1;
+  }
+
+  if (!had_err) {
+    nv = gt_ltrdigest_ppt_visitor_new(info->rmap, arguments->ppt_len,
+                                      arguments->ubox_len,
+                                      arguments->ppt_pyrimidine_prob,
+                                      arguments->ppt_purine_prob,
+                                      arguments->bkg_a_prob,
+                                      arguments->bkg_g_prob,
+                                      arguments->bkg_t_prob,
+                                      arguments->bkg_c_prob,
+                                      arguments->ubox_u_prob,
+                                      arguments->ppt_radius,
+                                      arguments->max_ubox_dist, err);
+    if (nv != NULL)
+      gt_array_add(visitors, nv);
+    else
+      had_err = -1;
+  }
+  return had_err;
+}
+
 static int gt_ltrdigest_runner(GT_UNUSED int argc, const char **argv,
                                int parsed_args, void *tool_arguments,
                                GtError *err)
@@ -437,9 +519,7 @@ static int gt_ltrdigest_runner(GT_UNUSED int argc, const char **argv,
   GtNodeStream *gff3_in_stream  = NULL,
                *check_stream    = NULL,
                *gff3_out_stream = NULL,
-               *pdom_stream     = NULL,
-               *ppt_stream      = NULL,
-               *pbs_stream      = NULL,
+               *annotate_stream = NULL,
                *tab_out_stream  = NULL,
                *sa_stream       = NULL,
                *last_stream     = NULL;
@@ -527,60 +607,27 @@ static int gt_ltrdigest_runner(GT_UNUSED int argc, const char **argv,
   }
 
   if (!had_err && gt_str_array_size(arguments->hmm_files) > 0) {
-    GtNodeVisitor *pdom_v;
-    ms = gt_pdom_model_set_new(arguments->hmm_files, arguments->force_recreate,
-                               err);
-    if (ms != NULL) {
-      pdom_v = gt_ltrdigest_pdom_visitor_new(ms, arguments->evalue_cutoff,
-                                             arguments->chain_max_gap_length,
-                                             arguments->cutoff, rmap, err);
-      if (pdom_v == NULL)
-        had_err = -1;
-      if (!had_err) {
-        gt_ltrdigest_pdom_visitor_set_source_tag((GtLTRdigestPdomVisitor*)
-                                                                        pdom_v,
-                                                 GT_LTRDIGEST_TAG);
-        if (arguments->output_all_chains)
-          gt_ltrdigest_pdom_visitor_output_all_chains((GtLTRdigestPdomVisitor*)
-                                                                        pdom_v);
-        last_stream = pdom_stream = gt_visitor_stream_new(last_stream, pdom_v);
-      }
-    } else had_err = -1;
-  }
-
-  if (!had_err && arguments->trna_lib_bs) {
-    GtNodeVisitor *pbs_v;
-    pbs_v = gt_ltrdigest_pbs_visitor_new(rmap, arguments->pbs_radius,
-                                         arguments->max_edist,
-                                         arguments->alilen,
-                                         arguments->offsetlen,
-                                         arguments->trnaoffsetlen,
-                                         arguments->ali_score_match,
-                                         arguments->ali_score_mismatch,
-                                         arguments->ali_score_insertion,
-                                         arguments->ali_score_deletion,
-                                         arguments->trna_lib_bs, err);
-    if (pbs_v != NULL)
-      last_stream = pbs_stream = gt_visitor_stream_new(last_stream, pbs_v);
+    if (strcmp(gt_str_get(arguments->pdom_engine), "builtin") == 0)
+      ms = gt_pdom_model_set_new_builtin(arguments->hmm_files, err);
     else
+      ms = gt_pdom_model_set_new(arguments->hmm_files,
+                                 arguments->force_recreate, err);
+    if (ms == NULL)
       had_err = -1;
   }
 
+  /* candidates are independent, so let each of the gt_jobs workers annotate
+     its share of them with its own visitors */
   if (!had_err) {
-    GtNodeVisitor *ppt_v;
-    ppt_v = gt_ltrdigest_ppt_visitor_new(rmap, arguments->ppt_len,
-                                         arguments->ubox_len,
-                                         arguments->ppt_pyrimidine_prob,
-                                         arguments->ppt_purine_prob,
-                                         arguments->bkg_a_prob,
-                                         arguments->bkg_g_prob,
-                                         arguments->bkg_t_prob,
-                                         arguments->bkg_c_prob,
-                                         arguments->ubox_u_prob,
-                                         arguments->ppt_radius,
-                                         arguments->max_ubox_dist, err);
-    if (ppt_v != NULL)
-      last_stream = ppt_stream = gt_visitor_stream_new(last_stream, ppt_v);
+    GtLTRdigestWorkerInfo info;
+    info.arguments = arguments;
+    info.rmap = rmap;
+    info.ms = ms;
+    annotate_stream = gt_parallel_visitor_stream_new(last_stream, 0,
+                                                   gt_ltrdigest_worker_visitors,
+                                                     &info, err);
+    if (annotate_stream != NULL)
+      last_stream = annotate_stream;
     else
       had_err = -1;
   }
@@ -648,15 +695,13 @@ static int gt_ltrdigest_runner(GT_UNUSED int argc, const char **argv,
     }
   }
 
-  gt_pdom_model_set_delete(ms);
   gt_node_stream_delete(gff3_out_stream);
-  gt_node_stream_delete(ppt_stream);
-  gt_node_stream_delete(pbs_stream);
   gt_node_stream_delete(sa_stream);
-  gt_node_stream_delete(pdom_stream);
+  gt_node_stream_delete(annotate_stream);
   gt_node_stream_delete(tab_out_stream);
   gt_node_stream_delete(check_stream);
   gt_node_stream_delete(gff3_in_stream);
+  gt_pdom_model_set_delete(ms);
   gt_bioseq_delete(arguments->trna_lib_bs);
   gt_region_mapping_delete(rmap);
 
@@ -48,6 +48,7 @@ typedef struct {
                 mindistance,
                 maxdistance,
                 numofboundaries,
+                windowsize,
                 offset;
   double similaritythreshold;
   int xdropbelowscore;
@@ -210,7 +211,8 @@ static GtOptionParser* gt_ltrharvest_option_parser_new(void *tool_arguments)
            *optionout,
            *optionoutinner,
            *optiongff3,
-           *optionscan;
+           *optionscan,
+           *optionwindowsize;
   GtRange default_ltrsearchseqrange = {0,0};
   static const char *overlaps[] = {
     "best", /* the default */
@@ -474,6 +476,21 @@ static GtOptionParser* gt_ltrharvest_option_parser_new(void *tool_arguments)
   gt_option_parser_add_option(op, optionscan);
   gt_option_is_extended_option(optionscan);
 
+  /* -windowsize */
+  optionwindowsize = gt_option_new_uword("windowsize",
+                                         "search for seeds in overlapping "
+                                         "windows of the given length, "
+                                         "building a suffix array for each "
+                                         "window on the fly; then the index "
+                                         "only needs to contain the encoded "
+                                         "sequence (0 = use the suffix array "
+                                         "of the index)",
+                                         &arguments->windowsize,
+                                         0UL);
+  gt_option_parser_add_option(op, optionwindowsize);
+  gt_option_is_extended_option(optionwindowsize);
+  gt_option_exclude(optionwindowsize, optionscan);
+
   /* implications */
   gt_option_imply(optionmaxtsd, optionmintsd);
   gt_option_imply(optionmotifmis, optionmotif);
@@ -622,6 +639,7 @@ static int gt_ltrharvest_runner(GT_UNUSED int argc,
                                          arguments->nooverlaps,
                                          arguments->bestoverlaps,
                                          arguments->scan,
+                                         arguments->windowsize,
                                          arguments->offset,
                                          arguments->minlengthTSD,
                                          arguments->maxlengthTSD,
@@ -61,6 +61,11 @@ struct GtLTRdigestPBSVisitor{
       ali_score_insertion,
       ali_score_deletion;
   GtBioseq *trna_lib;
+  GtAlphabet *alpha;
+  GtScoreFunction *sf;
+  GtSeq **trnas_from3;
+  GtSWAlignProfile **profiles;
+  GtWord min_ali_score;
 };
 
 typedef struct {
@@ -279,65 +284,41 @@ static int gt_pbs_hit_compare(const void *h1, const void *h2)
 }
 
 static GtPBSResults* gt_pbs_find(GtLTRdigestPBSVisitor *lv, const char *seq,
-                          const char *rev_seq, GtError *err)
+                                 const char *rev_seq)
 {
-  GtSeq *seq_forward, *seq_rev;
+  GtSeq *targets[2];
+  GtAlignment *alis[2];
   GtPBSResults *results;
   GtUword j;
-  GtAlignment *ali;
-  GtAlphabet *a = gt_alphabet_new_dna();
-  GtScoreFunction *sf;
   gt_assert(lv && seq && rev_seq);
 
-  sf = gt_dna_scorefunc_new(a, lv->ali_score_match, lv->ali_score_mismatch,
-                            lv->ali_score_insertion, lv->ali_score_deletion);
-
   results = gt_pbs_results_new();
 
-  seq_forward = gt_seq_new(seq + (lv->leftltrlen)
-                               - (lv->radius),
-                           (GtUword) (2 * lv->radius + 1),
-                           a);
+  targets[0] = gt_seq_new(seq + (lv->leftltrlen)
+                              - (lv->radius),
+                          (GtUword) (2 * lv->radius + 1),
+                          lv->alpha);
 
-  seq_rev     = gt_seq_new(rev_seq + (lv->rightltrlen)
-                                   - (lv->radius),
-                           (GtUword) (2 * lv->radius + 1),
-                           a);
+  targets[1] = gt_seq_new(rev_seq + (lv->rightltrlen)
+                                  - (lv->radius),
+                          (GtUword) (2 * lv->radius + 1),
+                          lv->alpha);
 
   for (j = 0; j < gt_bioseq_number_of_sequences(lv->trna_lib); j++)
   {
-    GtSeq *trna_seq, *trna_from3;
-    char *trna_from3_full;
-    GtUword trna_seqlen;
-
-    trna_seq = gt_bioseq_get_seq(lv->trna_lib, j);
-    trna_seqlen = gt_seq_length(trna_seq);
-
-    trna_from3_full = gt_calloc((size_t) trna_seqlen, sizeof (char));
-    memcpy(trna_from3_full, gt_seq_get_orig(trna_seq),
-           sizeof (char) * trna_seqlen);
-    (void) gt_reverse_complement(trna_from3_full, trna_seqlen, err);
-    trna_from3 = gt_seq_new_own(trna_from3_full, trna_seqlen, a);
-
-    ali = gt_swalign(seq_forward, trna_from3, sf);
-    gt_pbs_add_hit(lv, results->hits, ali, trna_seqlen,
-                   gt_seq_get_description(trna_seq), GT_STRAND_FORWARD,
-                   results);
-    gt_alignment_delete(ali);
-
-    ali = gt_swalign(seq_rev, trna_from3, sf);
-    gt_pbs_add_hit(lv, results->hits, ali, trna_seqlen,
-                   gt_seq_get_description(trna_seq), GT_STRAND_REVERSE,
-                   results);
-    gt_alignment_delete(ali);
-
-    gt_seq_delete(trna_seq);
-    gt_seq_delete(trna_from3);
+    GtUword trna_seqlen = gt_bioseq_get_sequence_length(lv->trna_lib, j);
+    const char *desc = gt_bioseq_get_description(lv->trna_lib, j);
+
+    gt_swalign_batch(lv->profiles[j], targets, 2UL, lv->min_ali_score, alis);
+    gt_pbs_add_hit(lv, results->hits, alis[0], trna_seqlen, desc,
+                   GT_STRAND_FORWARD, results);
+    gt_pbs_add_hit(lv, results->hits, alis[1], trna_seqlen, desc,
+                   GT_STRAND_REVERSE, results);
+    gt_alignment_delete(alis[0]);
+    gt_alignment_delete(alis[1]);
   }
-  gt_seq_delete(seq_forward);
-  gt_seq_delete(seq_rev);
-  gt_score_function_delete(sf);
-  gt_alphabet_delete(a);
+  gt_seq_delete(targets[0]);
+  gt_seq_delete(targets[1]);
   gt_array_sort(results->hits, gt_pbs_hit_compare);
   return results;
 }
@@ -473,8 +454,7 @@ static int gt_ltrdigest_pbs_visitor_feature_node(GtNodeVisitor *nv,
       strncpy(rev_seq, gt_str_get(seq), (size_t) seqlen * sizeof (char));
       (void) gt_reverse_complement(rev_seq, seqlen, NULL);
 
-      pbs_results = gt_pbs_find(lv, gt_str_get(seq), (const char*) rev_seq,
-                                err);
+      pbs_results = gt_pbs_find(lv, gt_str_get(seq), (const char*) rev_seq);
        if (gt_pbs_results_get_number_of_hits(pbs_results) > 0)
        {
         pbs_attach_results_to_gff3(lv, pbs_results, lv->ltr_retrotrans,
@@ -493,9 +473,18 @@ static int gt_ltrdigest_pbs_visitor_feature_node(GtNodeVisitor *nv,
 static void gt_ltrdigest_pbs_visitor_free(GtNodeVisitor *nv)
 {
   GT_UNUSED GtLTRdigestPBSVisitor *lv;
+  GtUword i;
   if (!nv) return;
   lv = gt_ltrdigest_pbs_visitor_cast(nv);
   gt_str_delete(lv->tag);
+  for (i = 0; i < gt_bioseq_number_of_sequences(lv->trna_lib); i++) {
+    gt_swalign_profile_delete(lv->profiles[i]);
+    gt_seq_delete(lv->trnas_from3[i]);
+  }
+  gt_free(lv->profiles);
+  gt_free(lv->trnas_from3);
+  gt_score_function_delete(lv->sf);
+  gt_alphabet_delete(lv->alpha);
 }
 
 const GtNodeVisitorClass* gt_ltrdigest_pbs_visitor_class(void)
@@ -528,7 +517,14 @@ GtNodeVisitor* gt_ltrdigest_pbs_visitor_new(GtRegionMapping *rmap,
 {
   GtNodeVisitor *nv = NULL;
   GtLTRdigestPBSVisitor *lv;
+  GtUword i, nof_trnas, min_matches;
+  int min_penalty;
   gt_assert(rmap && trna_lib);
+  /* descriptions are cached on first access, do it now so that the library
+     is only read during the search */
+  nof_trnas = gt_bioseq_number_of_sequences(trna_lib);
+  for (i = 0; i < nof_trnas; i++)
+    (void) gt_bioseq_get_description(trna_lib, i);
   nv = gt_node_visitor_create(gt_ltrdigest_pbs_visitor_class());
   lv = gt_ltrdigest_pbs_visitor_cast(nv);
   lv->tag = gt_str_new_cstr(GT_LTRDIGEST_TAG);
@@ -543,6 +539,36 @@ GtNodeVisitor* gt_ltrdigest_pbs_visitor_new(GtRegionMapping *rmap,
   lv->ali_score_insertion = ali_score_insertion;
   lv->ali_score_deletion = ali_score_deletion;
   lv->trna_lib = trna_lib;
+
+  /* Profile the 3' ends of all tRNAs once. The alphabet is private to the
+     visitor, as visitors may run in different threads. */
+  lv->alpha = gt_alphabet_new_dna();
+  lv->sf = gt_dna_scorefunc_new(lv->alpha, ali_score_match,
+                                ali_score_mismatch, ali_score_insertion,
+                                ali_score_deletion);
+  lv->trnas_from3 = gt_calloc((size_t) nof_trnas, sizeof (GtSeq*));
+  lv->profiles = gt_calloc((size_t) nof_trnas, sizeof (GtSWAlignProfile*));
+  for (i = 0; i < nof_trnas; i++) {
+    GtUword trna_seqlen = gt_bioseq_get_sequence_length(trna_lib, i);
+    char *trna_from3_full = gt_bioseq_get_sequence(trna_lib, i);
+    (void) gt_reverse_complement(trna_from3_full, trna_seqlen, NULL);
+    lv->trnas_from3[i] = gt_seq_new_own(trna_from3_full, trna_seqlen,
+                                        lv->alpha);
+    lv->profiles[i] = gt_swalign_profile_new(lv->trnas_from3[i], lv->alpha,
+                                             lv->sf);
+  }
+
+  /* Any alignment passing the length and distance filters scores at least
+     this much, so weaker hits need no traceback. */
+  min_penalty = GT_MIN(GT_MIN(ali_score_mismatch, ali_score_insertion),
+                       GT_MIN(ali_score_deletion, 0));
+  min_matches = alilen.start > (GtUword) max_edist
+                  ? alilen.start - (GtUword) max_edist : 0;
+  lv->min_ali_score = 1;
+  if (ali_score_match > 0) {
+    lv->min_ali_score = GT_MAX(1, (GtWord) min_matches * ali_score_match
+                                    + (GtWord) max_edist * min_penalty);
+  }
   return nv;
 }
 
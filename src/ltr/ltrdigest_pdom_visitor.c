@@ -18,6 +18,7 @@
 
 #include <ctype.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <signal.h>
 #include <string.h>
 #include <sys/types.h>
@@ -777,6 +778,10 @@ static int gt_ltrdigest_checkpipe(int *fdpair, GtError *err)
     gt_error_set(err, "could not create pipe, please check for number of "
                       "allowed file descriptors: %s", strerror(errno));
     had_err = -1;
+  } else {
+    /* keep the pipes of concurrent visitors out of other HMMER children */
+    (void) fcntl(fdpair[0], F_SETFD, FD_CLOEXEC);
+    (void) fcntl(fdpair[1], F_SETFD, FD_CLOEXEC);
   }
   return had_err;
 }
@@ -786,11 +791,171 @@ static void gt_ltrdigest_checkdup(int fd)
   if (dup(fd) == -1) {
     perror("could not duplicate file descriptor, please check "
            "for number of allowed file descriptors");
-    exit(EXIT_FAILURE);
+    _exit(EXIT_FAILURE);
   }
 }
 #endif
 
+static int gt_ltrdigest_pdom_visitor_search_hmmer(GtLTRdigestPdomVisitor *lv,
+                                                  GtError *err)
+{
+  int had_err = 0;
+#ifndef _WIN32
+  FILE *instream;
+  GtHMMERParseStatus *pstatus;
+  int pid, pc[2], cp[2], rstatus = 0;
+  GtUword i;
+
+  gt_pdom_model_set_lock(lv->model);
+  had_err = gt_ltrdigest_checkpipe(pc, err);
+  if (!had_err) {
+    had_err = gt_ltrdigest_checkpipe(cp,err);
+  }
+  if (had_err)
+    gt_pdom_model_set_unlock(lv->model);
+  if (!had_err) {
+    switch ((pid = (int) fork())) {
+      case -1:
+        gt_pdom_model_set_unlock(lv->model);
+        gt_error_set(err, "can't fork new HMMER process");
+        had_err = -1;
+        break;
+      case 0:    /* child */
+        (void) close(1);    /* close current stdout. */
+        gt_ltrdigest_checkdup(cp[1]);  /* make stdout go to
+                                               write end of pipe. */
+        (void) close(0);    /* close current stdin. */
+        gt_ltrdigest_checkdup(pc[0]);  /* make stdin come from
+                                               read end of pipe. */
+        (void) close(pc[0]);
+        (void) close(pc[1]);
+        (void) close(cp[0]);
+        (void) close(cp[1]);
+        (void) execvp("hmmscan", lv->args); /* XXX: read path from env */
+        perror("couldn't execute hmmscan");
+        _exit(EXIT_FAILURE);
+      default:    /* parent */
+        gt_pdom_model_set_unlock(lv->model);
+        for (i = 0UL; i < 3UL; i++) {
+          char buf[5];
+          GT_UNUSED ssize_t written;
+          (void) sprintf(buf, ">"GT_WU"%c\n", i, '+');
+          written = write(pc[1], buf, 4 * sizeof (char));
+          written = write(pc[1], gt_str_get(lv->fwd[i]),
+                        (size_t) gt_str_length(lv->fwd[i]) * sizeof (char));
+          written = write(pc[1], "\n", 1 * sizeof (char));
+          (void) sprintf(buf, ">"GT_WU"%c\n", i, '-');
+          written = write(pc[1], buf, 4 * sizeof (char));
+          written = write(pc[1], gt_str_get(lv->rev[i]),
+                        (size_t) gt_str_length(lv->rev[i]) * sizeof (char));
+          written = write(pc[1], "\n", 1 * sizeof (char));
+        }
+        (void) close(pc[0]);
+        (void) close(pc[1]);
+        (void) close(cp[1]);
+        instream = fdopen(cp[0], "r");
+        pstatus = gt_hmmer_parse_status_new();
+        had_err = gt_ltrdigest_pdom_visitor_parse_output(lv, pstatus,
+                                                         instream, err);
+        (void) fclose(instream);
+        /* other visitors may have HMMER children running concurrently */
+        if (waitpid(pid, &rstatus, 0) == -1 || !WIFEXITED(rstatus)
+              || WEXITSTATUS(rstatus) != 0) {
+          had_err = -1;
+          gt_error_set(err, "HMMER child process terminated with error");
+        }
+        if (!had_err)
+          had_err = gt_ltrdigest_pdom_visitor_process_hits(lv, pstatus,
+                                                           err);
+        gt_hmmer_parse_status_delete(pstatus);
+    }
+  }
+#else
+  /* XXX */
+  gt_error_set(err, "HMMER call not implemented on Windows\n");
+  had_err = -1;
+#endif
+  return had_err;
+}
+
+/* Searches all six translations with the in-process profile engine, feeding
+   the hits into the same chaining code used for hmmscan results. */
+static int gt_ltrdigest_pdom_visitor_search_builtin(GtLTRdigestPdomVisitor *lv,
+                                                    GtError *err)
+{
+  int had_err = 0;
+#ifndef _WIN32
+  GtHMMERParseStatus *pstatus;
+  GtArray *hits;
+  GtUword i, j, m, nof_models;
+  double min_score, max_evalue;
+
+  pstatus = gt_hmmer_parse_status_new();
+  hits = gt_array_new(sizeof (GtPdomProfileHit));
+  nof_models = gt_pdom_model_set_size(lv->model);
+  for (m = 0; m < nof_models; m++) {
+    const GtPdomProfile *p = gt_pdom_model_set_get(lv->model, m);
+    min_score = -DBL_MAX;
+    max_evalue = DBL_MAX;
+    switch (lv->cutoff) {
+      case GT_PHMM_CUTOFF_GA:
+        (void) gt_pdom_profile_get_ga(p, &min_score);
+        break;
+      case GT_PHMM_CUTOFF_TC:
+        (void) gt_pdom_profile_get_tc(p, &min_score);
+        break;
+      case GT_PHMM_CUTOFF_NONE:
+        max_evalue = lv->eval_cutoff;
+        break;
+    }
+    gt_str_reset(pstatus->cur_model);
+    gt_str_append_cstr(pstatus->cur_model, gt_pdom_profile_get_name(p));
+    for (i = 0; i < 6UL; i++) {
+      GtStr *seq;
+      char seqname[3];
+      pstatus->frame = (unsigned int) (i / 2);
+      if (i % 2 == 0) {
+        pstatus->strand = GT_STRAND_FORWARD;
+        seq = lv->fwd[pstatus->frame];
+      } else {
+        pstatus->strand = GT_STRAND_REVERSE;
+        seq = lv->rev[pstatus->frame];
+      }
+      (void) snprintf(seqname, (size_t) 3, "%u%c", pstatus->frame,
+                      GT_STRAND_CHARS[pstatus->strand]);
+      gt_array_reset(hits);
+      (void) gt_pdom_profile_search(p, gt_str_get(seq), gt_str_length(seq),
+                                    seqname, nof_models, min_score,
+                                    max_evalue, hits);
+      for (j = 0; j < gt_array_size(hits); j++) {
+        GtPdomProfileHit *h = gt_array_get(hits, j);
+        GtHMMERSingleHit *shit = gt_calloc((size_t) 1, sizeof (*shit));
+        shit->hmmfrom = h->hmmfrom;
+        shit->hmmto = h->hmmto;
+        shit->alifrom = h->alifrom;
+        shit->alito = h->alito;
+        shit->score = h->score;
+        shit->evalue = h->evalue;
+        shit->strand = pstatus->strand;
+        shit->frame = (GtUword) pstatus->frame;
+        shit->reported = true;
+        shit->alignment = h->alignment;
+        shit->aastring = h->aastring;
+        shit->chains = gt_array_new(sizeof (GtUword));
+        gt_hmmer_parse_status_add_hit(pstatus, shit);
+      }
+    }
+  }
+  had_err = gt_ltrdigest_pdom_visitor_process_hits(lv, pstatus, err);
+  gt_array_delete(hits);
+  gt_hmmer_parse_status_delete(pstatus);
+#else
+  gt_error_set(err, "protein domain search not implemented on Windows\n");
+  had_err = -1;
+#endif
+  return had_err;
+}
+
 static int gt_ltrdigest_pdom_visitor_feature_node(GtNodeVisitor *nv,
                                                   GtFeatureNode *fn,
                                                   GtError *err)
@@ -820,11 +985,6 @@ static int gt_ltrdigest_pdom_visitor_feature_node(GtNodeVisitor *nv,
     GtTranslatorStatus status;
     GtUword seqlen;
     char translated, *rev_seq;
-#ifndef _WIN32
-    FILE *instream;
-    GtHMMERParseStatus *pstatus;
-    int pid, pc[2], cp[2], rstatus = 0;
-#endif
     unsigned int frame;
     GtStr *seq;
 
@@ -877,70 +1037,10 @@ static int gt_ltrdigest_pdom_visitor_feature_node(GtNodeVisitor *nv,
 
       /* run HMMER and handle results */
       if (!had_err) {
-  #ifndef _WIN32
-        had_err = gt_ltrdigest_checkpipe(pc, err);
-      }
-      if (!had_err) {
-        had_err = gt_ltrdigest_checkpipe(cp,err);
-      }
-      if (!had_err) {
-        switch ((pid = (int) fork())) {
-          case -1:
-            gt_error_set(err, "can't fork new HMMER process");
-            had_err = -1;
-            break;
-          case 0:    /* child */
-            (void) close(1);    /* close current stdout. */
-            gt_ltrdigest_checkdup(cp[1]);  /* make stdout go to
-                                                   write end of pipe. */
-            (void) close(0);    /* close current stdin. */
-            gt_ltrdigest_checkdup(pc[0]);  /* make stdin come from
-                                                   read end of pipe. */
-            (void) close(pc[0]);
-            (void) close(pc[1]);
-            (void) close(cp[0]);
-            (void) close(cp[1]);
-            (void) execvp("hmmscan", lv->args); /* XXX: read path from env */
-            perror("couldn't execute hmmscan");
-            exit(EXIT_FAILURE);
-          default:    /* parent */
-            for (i = 0UL; i < 3UL; i++) {
-              char buf[5];
-              GT_UNUSED ssize_t written;
-              (void) sprintf(buf, ">"GT_WU"%c\n", i, '+');
-              written = write(pc[1], buf, 4 * sizeof (char));
-              written = write(pc[1], gt_str_get(lv->fwd[i]),
-                            (size_t) gt_str_length(lv->fwd[i]) * sizeof (char));
-              written = write(pc[1], "\n", 1 * sizeof (char));
-              (void) sprintf(buf, ">"GT_WU"%c\n", i, '-');
-              written = write(pc[1], buf, 4 * sizeof (char));
-              written = write(pc[1], gt_str_get(lv->rev[i]),
-                            (size_t) gt_str_length(lv->rev[i]) * sizeof (char));
-              written = write(pc[1], "\n", 1 * sizeof (char));
-            }
-            (void) close(pc[0]);
-            (void) close(pc[1]);
-            (void) close(cp[1]);
-            instream = fdopen(cp[0], "r");
-            pstatus = gt_hmmer_parse_status_new();
-            had_err = gt_ltrdigest_pdom_visitor_parse_output(lv, pstatus,
-                                                             instream, err);
-            (void) fclose(instream);
-            wait(&rstatus);
-            if (WEXITSTATUS(rstatus) != 0) {
-              had_err = -1;
-              gt_error_set(err, "HMMER child process terminated with error");
-            }
-            if (!had_err)
-              had_err = gt_ltrdigest_pdom_visitor_process_hits(lv, pstatus,
-                                                               err);
-            gt_hmmer_parse_status_delete(pstatus);
-        }
-  #else
-        /* XXX */
-        gt_error_set(err, "HMMER call not implemented on Windows\n");
-        had_err = -1;
-  #endif
+        if (gt_pdom_model_set_is_builtin(lv->model))
+          had_err = gt_ltrdigest_pdom_visitor_search_builtin(lv, err);
+        else
+          had_err = gt_ltrdigest_pdom_visitor_search_hmmer(lv, err);
       }
     } else {
       gt_warning("%s (%s, line %u) is too short to be "
@@ -1021,24 +1121,44 @@ GtNodeVisitor* gt_ltrdigest_pdom_visitor_new(GtPdomModelSet *model,
   int had_err = 0, i, rval;
   gt_assert(model && rmap);
 
-  rval = system("hmmscan -h > /dev/null");
-  if (rval == -1) {
-    gt_error_set(err, "error executing system(hmmscan)");
-    return NULL;
-  }
+  if (gt_pdom_model_set_is_builtin(model)) {
+    GtUword m;
+    for (m = 0; cutoff != GT_PHMM_CUTOFF_NONE
+                  && m < gt_pdom_model_set_size(model); m++) {
+      const GtPdomProfile *p = gt_pdom_model_set_get(model, m);
+      double val;
+      if (cutoff == GT_PHMM_CUTOFF_GA && !gt_pdom_profile_get_ga(p, &val)) {
+        gt_error_set(err, "model %s has no GA cutoff",
+                     gt_pdom_profile_get_name(p));
+        return NULL;
+      }
+      if (cutoff == GT_PHMM_CUTOFF_TC && !gt_pdom_profile_get_tc(p, &val)) {
+        gt_error_set(err, "model %s has no TC cutoff",
+                     gt_pdom_profile_get_name(p));
+        return NULL;
+      }
+    }
+  } else {
+    rval = system("hmmscan -h > /dev/null");
+    if (rval == -1) {
+      gt_error_set(err, "error executing system(hmmscan)");
+      return NULL;
+    }
 #ifndef _WIN32
-  if (WEXITSTATUS(rval) != 0) {
-    gt_error_set(err, "cannot find the hmmscan executable in PATH");
-    return NULL;
-  }
+    if (WEXITSTATUS(rval) != 0) {
+      gt_error_set(err, "cannot find the hmmscan executable in PATH");
+      return NULL;
+    }
 #else
-  /* XXX */
-  gt_error_set(err, "hmmscan for Windows not implemented");
-  return NULL;
+    /* XXX */
+    gt_error_set(err, "hmmscan for Windows not implemented");
+    return NULL;
 #endif
+  }
 
   nv = gt_node_visitor_create(gt_ltrdigest_pdom_visitor_class());
   lv = gt_ltrdigest_pdom_visitor_cast(nv);
+  lv->model = model;
   lv->eval_cutoff = eval_cutoff;
   lv->cutoff = cutoff;
   lv->chain_max_gap_length = chain_max_gap_length;
@@ -1052,10 +1172,10 @@ GtNodeVisitor* gt_ltrdigest_pdom_visitor_new(GtPdomModelSet *model,
     lv->rev[i] = gt_str_new();
   }
 
-  if (!had_err) {
-    cmd = gt_str_new_cstr("hmmscan --cpu ");
-    gt_str_append_uint(cmd, gt_jobs);
-    gt_str_append_cstr(cmd, " ");
+  if (!had_err && !gt_pdom_model_set_is_builtin(model)) {
+    /* candidates are distributed over gt_jobs visitors, so every hmmscan
+       instance gets a single CPU */
+    cmd = gt_str_new_cstr("hmmscan --cpu 1 ");
     switch (cutoff) {
       case GT_PHMM_CUTOFF_GA:
         gt_str_append_cstr(cmd, "--cut_ga");
@@ -19,6 +19,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 #include "core/array_api.h"
 #include "core/arraydef_api.h"
 #include "core/assert_api.h"
@@ -26,6 +27,7 @@
 #include "core/encseq_api.h"
 #include "core/error_api.h"
 #include "core/log.h"
+#include "core/ma_api.h"
 #include "core/mathsupport_api.h"
 #include "core/md5_seqid_api.h"
 #include "core/minmax_api.h"
@@ -43,6 +45,7 @@
 #include "match/esa-maxpairs.h"
 #include "match/esa-mmsearch.h"
 #include "match/greedyedist.h"
+#include "match/sfx-sain.h"
 #include "match/xdrop.h"
 #include "ltr/ltrharvest_stream.h"
 
@@ -135,7 +138,9 @@ struct GtLTRharvestStream
   const LTRboundaries **bdptrtab;
   GtArrayLTRboundaries arrayLTRboundaries;
   const GtEncseq *encseq;
+  GtEncseq *windowencseq;
   Sequentialsuffixarrayreader *ssar;
+  GtUword windowsize;
   bool verbosemode,
        nooverlaps,
        bestoverlaps,
@@ -243,6 +248,271 @@ static void gt_subsimpleexactselfmatchstore(void *info,
   nextfreerepeatptr->len = gt_querymatch_querylen(querymatch);
 }
 
+/* The datatype LTRharvestWindow describes a stretch of a single sequence in
+   which maximal repeats are enumerated independently of the rest of the
+   encoded sequence. Adjacent windows of a sequence overlap by the maximal
+   length of an LTR element. */
+typedef struct
+{
+  GtUword start,  /* absolute start position of the window */
+          length, /* length of the window */
+          seqnum; /* number of the sequence containing the window */
+} LTRharvestWindow;
+
+GT_DECLAREARRAYSTRUCT(LTRharvestWindow);
+
+typedef struct
+{
+  GtArrayRepeat *repeats;
+  const RepeatInfo *repeatinfo;
+  GtUword offset,
+          seqnum;
+} WindowRepeatInfo;
+
+/* Collects all maximal repeats of a window satisfying the distance
+   constraints. Length and search range constraints are only checked after
+   merging repeats from overlapping windows, as a repeat touching a window
+   border may be a truncated copy of a longer one. */
+static int gt_windowexactselfmatchstore(void *info,
+                                        GT_UNUSED const GtGenericEncseq
+                                                              *genericencseq,
+                                        GtUword len, GtUword pos1,
+                                        GtUword pos2,
+                                        GT_UNUSED GtError *err)
+{
+  GtUword distance;
+  WindowRepeatInfo *wri = (WindowRepeatInfo *) info;
+
+  gt_error_check(err);
+  gt_assert(pos1 < pos2);
+  distance = pos2 - pos1;
+  if (wri->repeatinfo->dmin <= distance && distance <= wri->repeatinfo->dmax)
+  {
+    Repeat *nextfreerepeatptr;
+
+    GT_GETNEXTFREEINARRAY(nextfreerepeatptr,wri->repeats,Repeat,32);
+    nextfreerepeatptr->pos1 = wri->offset + pos1;
+    nextfreerepeatptr->offset = distance;
+    nextfreerepeatptr->len = len;
+    nextfreerepeatptr->contignumber = wri->seqnum;
+  }
+  return 0;
+}
+
+static int gt_ltrharvest_window_maxpairs(const GtEncseq *encseq,
+                                         const RepeatInfo *repeatinfo,
+                                         const LTRharvestWindow *window,
+                                         unsigned int minseedlength,
+                                         GtArrayRepeat *repeats,
+                                         GtError *err)
+{
+  GtSainSufLcpIterator *suflcpiterator;
+  WindowRepeatInfo wri;
+  GtUchar *sequence;
+  int had_err = 0;
+  gt_error_check(err);
+
+  sequence = gt_malloc(sizeof (*sequence) * window->length);
+  gt_encseq_extract_encoded(encseq, sequence, window->start,
+                            window->start + window->length - 1);
+  suflcpiterator = gt_sain_suf_lcp_iterator_new(true, sequence,
+                                         window->length,
+                                         GT_READMODE_FORWARD,
+                                         (GtUword)
+                                         gt_encseq_alphabetnumofchars(encseq),
+                                         err);
+  if (suflcpiterator == NULL)
+    had_err = -1;
+  if (!had_err) {
+    wri.repeats = repeats;
+    wri.repeatinfo = repeatinfo;
+    wri.offset = window->start;
+    wri.seqnum = window->seqnum;
+    had_err = gt_enumeratemaxpairs_sain(suflcpiterator, minseedlength,
+                                        gt_windowexactselfmatchstore, &wri,
+                                        err);
+  }
+  gt_sain_suf_lcp_iterator_delete(suflcpiterator);
+  gt_free(sequence);
+  return had_err;
+}
+
+typedef struct {
+  const GtEncseq *encseq;
+  const RepeatInfo *repeatinfo;
+  const GtArrayLTRharvestWindow *windows;
+  unsigned int minseedlength;
+  GtArrayRepeat *repeats;
+  GtMutex *mutex;
+  GtUword cur_window;
+  bool failed;
+  GtError *err;
+} GtLTRharvestWindowThreadInfo;
+
+static void* gt_ltrharvest_window_threadfunc(void *data)
+{
+  GtLTRharvestWindowThreadInfo *info = (GtLTRharvestWindowThreadInfo*) data;
+  GtArrayRepeat repeats;
+  GtError *err = gt_error_new();
+
+  GT_INITARRAY(&repeats, Repeat);
+  for (;;) {
+    const LTRharvestWindow *window;
+    int had_err;
+
+    gt_mutex_lock(info->mutex);
+    if (info->failed
+          || info->cur_window == info->windows->nextfreeLTRharvestWindow) {
+      gt_mutex_unlock(info->mutex);
+      break;
+    }
+    window = info->windows->spaceLTRharvestWindow + info->cur_window++;
+    gt_mutex_unlock(info->mutex);
+
+    had_err = gt_ltrharvest_window_maxpairs(info->encseq, info->repeatinfo,
+                                            window, info->minseedlength,
+                                            &repeats, err);
+    gt_mutex_lock(info->mutex);
+    if (had_err) {
+      if (!info->failed)
+        gt_error_set(info->err, "%s", gt_error_get(err));
+      info->failed = true;
+    } else if (repeats.nextfreeRepeat > 0) {
+      Repeat *dest;
+      GT_CHECKARRAYSPACEMULTI(info->repeats, Repeat, repeats.nextfreeRepeat);
+      dest = info->repeats->spaceRepeat + info->repeats->nextfreeRepeat;
+      memcpy(dest, repeats.spaceRepeat,
+             sizeof (Repeat) * repeats.nextfreeRepeat);
+      info->repeats->nextfreeRepeat += repeats.nextfreeRepeat;
+    }
+    gt_mutex_unlock(info->mutex);
+    repeats.nextfreeRepeat = 0;
+  }
+  GT_FREEARRAY(&repeats, Repeat);
+  gt_error_delete(err);
+  return NULL;
+}
+
+static int repeatcompare(const void *a, const void *b)
+{
+  const Repeat *ra = (const Repeat *) a,
+               *rb = (const Repeat *) b;
+
+  if (ra->contignumber != rb->contignumber)
+    return ra->contignumber < rb->contignumber ? -1 : 1;
+  if (ra->offset != rb->offset)
+    return ra->offset < rb->offset ? -1 : 1;
+  if (ra->pos1 != rb->pos1)
+    return ra->pos1 < rb->pos1 ? -1 : 1;
+  if (ra->len != rb->len)
+    return ra->len < rb->len ? -1 : 1;
+  return 0;
+}
+
+/* The following function merges repeats reported by overlapping windows.
+   Maximal repeats of a single window on the same diagonal never overlap, so
+   overlapping repeats on a diagonal are copies of the same repeat, possibly
+   truncated at a window border, and their union is the maximal repeat with
+   respect to the whole sequence. Afterwards the remaining constraints are
+   applied. */
+static void gt_mergewindowrepeats(RepeatInfo *repeatinfo)
+{
+  GtArrayRepeat *repeats = &repeatinfo->repeats;
+  Repeat *readptr, *writeptr = NULL;
+  GtUword i, nextfree = 0;
+
+  if (repeats->nextfreeRepeat == 0)
+    return;
+  qsort(repeats->spaceRepeat, (size_t) repeats->nextfreeRepeat,
+        sizeof (Repeat), repeatcompare);
+  for (i = 0; i < repeats->nextfreeRepeat; i++) {
+    readptr = repeats->spaceRepeat + i;
+    if (writeptr != NULL
+          && writeptr->contignumber == readptr->contignumber
+          && writeptr->offset == readptr->offset
+          && readptr->pos1 < writeptr->pos1 + writeptr->len) {
+      if (readptr->pos1 + readptr->len > writeptr->pos1 + writeptr->len)
+        writeptr->len = readptr->pos1 + readptr->len - writeptr->pos1;
+    } else {
+      writeptr = repeats->spaceRepeat + nextfree++;
+      *writeptr = *readptr;
+    }
+  }
+  repeats->nextfreeRepeat = nextfree;
+  nextfree = 0;
+  for (i = 0; i < repeats->nextfreeRepeat; i++) {
+    readptr = repeats->spaceRepeat + i;
+    if (readptr->len > repeatinfo->lmax)
+      continue;
+    if ((repeatinfo->ltrsearchseqrange.start > 0 ||
+         repeatinfo->ltrsearchseqrange.end > 0) &&
+        (readptr->pos1 < repeatinfo->ltrsearchseqrange.start ||
+         readptr->pos1 + readptr->offset + readptr->len - 1 >
+                                         repeatinfo->ltrsearchseqrange.end))
+      continue;
+    repeats->spaceRepeat[nextfree++] = *readptr;
+  }
+  repeats->nextfreeRepeat = nextfree;
+}
+
+/* Enumerates the maximal repeats (seeds) of all sequences by building a
+   suffix array for each window of at most <windowsize> symbols. */
+static int gt_enumeratewindowmaxpairs(const GtEncseq *encseq,
+                                      RepeatInfo *repeatinfo,
+                                      GtUword windowsize,
+                                      unsigned int minseedlength,
+                                      GtError *err)
+{
+  GtArrayLTRharvestWindow windows;
+  GtLTRharvestWindowThreadInfo threadinfo;
+  GtUword seqnum, overlap;
+  int had_err = 0;
+  gt_error_check(err);
+
+  overlap = repeatinfo->dmax + repeatinfo->lmax;
+  gt_assert(windowsize > overlap);
+  GT_INITARRAY(&windows, LTRharvestWindow);
+  for (seqnum = 0; seqnum < gt_encseq_num_of_sequences(encseq); seqnum++) {
+    GtUword seqstart = gt_encseq_seqstartpos(encseq, seqnum),
+            seqlength = gt_encseq_seqlength(encseq, seqnum),
+            start = 0;
+
+    while (start < seqlength) {
+      LTRharvestWindow *window;
+
+      GT_GETNEXTFREEINARRAY(window, &windows, LTRharvestWindow, 32);
+      window->start = seqstart + start;
+      window->length = GT_MIN(windowsize, seqlength - start);
+      window->seqnum = seqnum;
+      if (start + window->length == seqlength)
+        break;
+      start += windowsize - overlap;
+    }
+  }
+  gt_log_log("enumerating maximal repeats in "GT_WU" windows of length "
+             GT_WU" (overlap "GT_WU")", windows.nextfreeLTRharvestWindow,
+             windowsize, overlap);
+
+  threadinfo.encseq = encseq;
+  threadinfo.repeatinfo = repeatinfo;
+  threadinfo.windows = &windows;
+  threadinfo.minseedlength = minseedlength;
+  threadinfo.repeats = &repeatinfo->repeats;
+  threadinfo.mutex = gt_mutex_new();
+  threadinfo.cur_window = 0;
+  threadinfo.failed = false;
+  threadinfo.err = err;
+  had_err = gt_multithread(gt_ltrharvest_window_threadfunc, &threadinfo, err);
+  if (!had_err && threadinfo.failed)
+    had_err = -1;
+  gt_mutex_delete(threadinfo.mutex);
+  GT_FREEARRAY(&windows, LTRharvestWindow);
+
+  if (!had_err)
+    gt_mergewindowrepeats(repeatinfo);
+  return had_err;
+}
+
 static const LTRboundaries **compactboundaries(GtUword *numofboundaries,
                                                const GtArrayLTRboundaries *ltr)
 {
@@ -1257,7 +1527,14 @@ static int gt_ltrharvest_stream_next(GtNodeStream *ns,
   if (ltrh_stream->state == GT_LTRHARVEST_STREAM_STATE_START) {
     GT_INITARRAY(&ltrh_stream->repeatinfo.repeats, Repeat);
     ltrh_stream->prevseqnum = GT_UNDEF_UWORD;
-    if (!had_err && gt_enumeratemaxpairs(ltrh_stream->ssar,
+    if (ltrh_stream->windowsize > 0)
+    {
+      had_err = gt_enumeratewindowmaxpairs(ltrh_stream->encseq,
+                                  &ltrh_stream->repeatinfo,
+                                  ltrh_stream->windowsize,
+                                  (unsigned int) ltrh_stream->minseedlength,
+                                  err);
+    } else if (gt_enumeratemaxpairs(ltrh_stream->ssar,
                       (unsigned int) ltrh_stream->minseedlength,
                       gt_simpleexactselfmatchstore,
                       &ltrh_stream->repeatinfo,
@@ -1641,6 +1918,7 @@ static void gt_ltrharvest_stream_free(GtNodeStream *ns)
   GT_FREEARRAY(&ltrh_stream->arrayLTRboundaries, LTRboundaries);
   if (ltrh_stream->ssar != NULL)
     gt_freeSequentialsuffixarrayreader(&ltrh_stream->ssar);
+  gt_encseq_delete(ltrh_stream->windowencseq);
   if (ltrh_stream->bdptrtab != NULL)
     gt_free(ltrh_stream->bdptrtab);
 }
@@ -1705,6 +1983,7 @@ GtNodeStream* gt_ltrharvest_stream_new(GtStr *str_indexname,
                                        bool nooverlaps,
                                        bool bestoverlaps,
                                        bool scanfile,
+                                       GtUword windowsize,
                                        GtUword offset,
                                        unsigned int minlengthTSD,
                                        unsigned int maxlengthTSD,
@@ -1737,21 +2016,47 @@ GtNodeStream* gt_ltrharvest_stream_new(GtStr *str_indexname,
   /* init array for maximal repeats */
   GT_INITARRAY(&ltrh_stream->arrayLTRboundaries, LTRboundaries);
 
-  ltrh_stream->ssar =
-    gt_newSequentialsuffixarrayreaderfromfile(gt_str_get(str_indexname),
-                                                SARR_LCPTAB | SARR_SUFTAB |
-                                                SARR_ESQTAB |
-                                                SARR_SSPTAB | SARR_SDSTAB,
-                                                scanfile,
-                                                NULL,
-                                                err);
-  if (ltrh_stream->ssar == NULL)
+  ltrh_stream->windowsize = windowsize;
+  ltrh_stream->windowencseq = NULL;
+  ltrh_stream->ssar = NULL;
+
+  if (windowsize > 0)
   {
-    gt_node_stream_delete(ns);
-    return NULL;
+    /* in window mode only the encoded sequence is needed, the suffix arrays
+       are built on the fly for each window */
+    GtEncseqLoader *el = gt_encseq_loader_new();
+    gt_encseq_loader_do_not_require_des_tab(el);
+    gt_encseq_loader_require_ssp_tab(el);
+    gt_encseq_loader_require_sds_tab(el);
+    ltrh_stream->windowencseq = gt_encseq_loader_load(el,
+                                                     gt_str_get(str_indexname),
+                                                     err);
+    gt_encseq_loader_delete(el);
+    if (ltrh_stream->windowencseq == NULL)
+    {
+      gt_node_stream_delete(ns);
+      return NULL;
+    }
+    ltrh_stream->encseq = ltrh_stream->windowencseq;
+  } else
+  {
+    ltrh_stream->ssar =
+      gt_newSequentialsuffixarrayreaderfromfile(gt_str_get(str_indexname),
+                                                  SARR_LCPTAB | SARR_SUFTAB |
+                                                  SARR_ESQTAB |
+                                                  SARR_SSPTAB | SARR_SDSTAB,
+                                                  scanfile,
+                                                  NULL,
+                                                  err);
+    if (ltrh_stream->ssar == NULL)
+    {
+      gt_node_stream_delete(ns);
+      return NULL;
+    }
+    /* get encseq associated with suffix array */
+    ltrh_stream->encseq =
+      gt_encseqSequentialsuffixarrayreader(ltrh_stream->ssar);
   }
-  /* get encseq associated with suffix array */
-  ltrh_stream->encseq = gt_encseqSequentialsuffixarrayreader(ltrh_stream->ssar);
   /* let's print a warning if a mirrored index is used, this might have
      probably unintended effects if the user is reusing indexes from
      TIRvish */
@@ -1764,6 +2069,16 @@ GtNodeStream* gt_ltrharvest_stream_new(GtStr *str_indexname,
   ltrh_stream->repeatinfo.dmin = mindistance;
   ltrh_stream->repeatinfo.lmin = minltrlength;
   ltrh_stream->repeatinfo.lmax = maxltrlength;
+  if (windowsize > 0 && windowsize <= ltrh_stream->repeatinfo.dmax
+                                      + ltrh_stream->repeatinfo.lmax)
+  {
+    gt_error_set(err, "window size must be larger than the maximal length "
+                      "of an LTR element (maximal LTR length + maximal LTR "
+                      "distance = "GT_WU")",
+                 ltrh_stream->repeatinfo.dmax + ltrh_stream->repeatinfo.lmax);
+    gt_node_stream_delete(ns);
+    return NULL;
+  }
 
   /* encode motif according to encseq alphabet */
   had_err = gt_ltr_four_char_motif_encode(motif, ltrh_stream->encseq, err);
@@ -41,6 +41,7 @@ GtNodeStream* gt_ltrharvest_stream_new(GtStr *str_indexname,
                                        bool nooverlaps,
                                        bool bestoverlaps,
                                        bool scanfile,
+                                       GtUword windowsize,
                                        GtUword offset,
                                        unsigned int minlengthTSD,
                                        unsigned int maxlengthTSD,
@@ -22,12 +22,14 @@
 #ifndef _WIN32
 #include <sys/wait.h>
 #endif
+#include "core/array_api.h"
 #include "core/compat_api.h"
 #include "core/error_api.h"
 #include "core/fileutils_api.h"
 #include "core/ma_api.h"
 #include "core/md5_fingerprint_api.h"
 #include "core/str_array_api.h"
+#include "core/thread_api.h"
 #include "ltr/pdom_model_set.h"
 
 #define GT_HMM_INDEX_SUFFIX "h3i"
@@ -40,6 +42,8 @@
 struct GtPdomModelSet
 {
   GtStr *filename;
+  GtArray *profiles;
+  GtMutex *lock;
 };
 
 #define PDOM_MODEL_SET_HMMER_NOT_FOUND "Please make sure that all HMMER " \
@@ -87,13 +91,14 @@ GtPdomModelSet* gt_pdom_model_set_new(GtStrArray *hmmfiles, bool force,
   }
 
   pdom_model_set = gt_calloc((size_t) 1, sizeof (GtPdomModelSet));
+  pdom_model_set->lock = gt_mutex_new();
   concat_dbnames = gt_str_new();
   for (i = 0; !had_err && i < gt_str_array_size(hmmfiles); i++) {
     const char *filename = gt_str_array_get(hmmfiles, i);
     if (!gt_file_exists(filename)) {
       gt_error_set(err, "invalid HMM file: %s", filename);
       gt_str_delete(concat_dbnames);
-      gt_free(pdom_model_set);
+      gt_pdom_model_set_delete(pdom_model_set);
       return NULL;
     } else {
       FILE *fp;
@@ -105,7 +110,7 @@ GtPdomModelSet* gt_pdom_model_set_new(GtStrArray *hmmfiles, bool force,
       if (fp == NULL) {
         gt_error_set(err, "can't open HMM file: %s", filename);
         gt_str_delete(concat_dbnames);
-        gt_free(pdom_model_set);
+        gt_pdom_model_set_delete(pdom_model_set);
         return NULL;
       }
 
@@ -122,7 +127,7 @@ GtPdomModelSet* gt_pdom_model_set_new(GtStrArray *hmmfiles, bool force,
             gt_error_set(err, "invalid (non-protein) alphabet definition "
                               "in %s line "GT_WU, filename, lineno);
             gt_str_delete(concat_dbnames);
-            gt_free(pdom_model_set);
+            gt_pdom_model_set_delete(pdom_model_set);
             fclose(fp);
             return NULL;
           }
@@ -210,15 +215,82 @@ GtPdomModelSet* gt_pdom_model_set_new(GtStrArray *hmmfiles, bool force,
   return pdom_model_set;
 }
 
+GtPdomModelSet* gt_pdom_model_set_new_builtin(GtStrArray *hmmfiles,
+                                              GtError *err)
+{
+  GtPdomModelSet *pdom_model_set;
+  GtUword i;
+  int had_err = 0;
+  gt_assert(hmmfiles);
+  gt_error_check(err);
+
+  pdom_model_set = gt_calloc((size_t) 1, sizeof (GtPdomModelSet));
+  pdom_model_set->lock = gt_mutex_new();
+  pdom_model_set->profiles = gt_array_new(sizeof (GtPdomProfile*));
+  for (i = 0; !had_err && i < gt_str_array_size(hmmfiles); i++) {
+    const char *filename = gt_str_array_get(hmmfiles, i);
+    if (!gt_file_exists(filename)) {
+      gt_error_set(err, "invalid HMM file: %s", filename);
+      had_err = -1;
+    } else {
+      had_err = gt_pdom_profile_parse_file(pdom_model_set->profiles, filename,
+                                           err);
+    }
+  }
+  if (had_err) {
+    gt_pdom_model_set_delete(pdom_model_set);
+    pdom_model_set = NULL;
+  }
+  return pdom_model_set;
+}
+
 const char* gt_pdom_model_set_get_filename(GtPdomModelSet *set)
 {
-  gt_assert(set);
+  gt_assert(set && set->filename);
   return gt_str_get(set->filename);
 }
 
+bool gt_pdom_model_set_is_builtin(const GtPdomModelSet *set)
+{
+  gt_assert(set);
+  return set->profiles != NULL;
+}
+
+GtUword gt_pdom_model_set_size(const GtPdomModelSet *set)
+{
+  gt_assert(set && set->profiles);
+  return gt_array_size(set->profiles);
+}
+
+const GtPdomProfile* gt_pdom_model_set_get(const GtPdomModelSet *set,
+                                           GtUword idx)
+{
+  gt_assert(set && set->profiles && idx < gt_array_size(set->profiles));
+  return *(GtPdomProfile**) gt_array_get(set->profiles, idx);
+}
+
+void gt_pdom_model_set_lock(GtPdomModelSet *set)
+{
+  gt_assert(set);
+  gt_mutex_lock(set->lock);
+}
+
+void gt_pdom_model_set_unlock(GtPdomModelSet *set)
+{
+  gt_assert(set);
+  gt_mutex_unlock(set->lock);
+}
+
 void gt_pdom_model_set_delete(GtPdomModelSet *set)
 {
+  GtUword i;
   if (!set) return;
   gt_str_delete(set->filename);
+  gt_mutex_delete(set->lock);
+  if (set->profiles) {
+    for (i = 0; i < gt_array_size(set->profiles); i++)
+      gt_pdom_profile_delete(*(GtPdomProfile**) gt_array_get(set->profiles, i));
+    gt_array_delete(set->profiles);
+  }
   gt_free(set);
 }
@@ -18,11 +18,24 @@
 #ifndef PDOM_MODEL_SET_H
 #define PDOM_MODEL_SET_H
 
+#include "ltr/pdom_profile.h"
+
 typedef struct GtPdomModelSet GtPdomModelSet;
 
 GtPdomModelSet* gt_pdom_model_set_new(GtStrArray *hmmfiles,bool force,
                                       GtError *err);
+/* Returns a model set holding the profiles from <hmmfiles> (in HMMER3
+   format) in memory, to be searched without the HMMER executables. */
+GtPdomModelSet* gt_pdom_model_set_new_builtin(GtStrArray *hmmfiles,
+                                              GtError *err);
 const char*     gt_pdom_model_set_get_filename(GtPdomModelSet *set);
+bool            gt_pdom_model_set_is_builtin(const GtPdomModelSet *set);
+GtUword         gt_pdom_model_set_size(const GtPdomModelSet *set);
+const GtPdomProfile* gt_pdom_model_set_get(const GtPdomModelSet *set,
+                                           GtUword idx);
+/* Serializes the spawning of HMMER processes among all users of <set>. */
+void            gt_pdom_model_set_lock(GtPdomModelSet *set);
+void            gt_pdom_model_set_unlock(GtPdomModelSet *set);
 void            gt_pdom_model_set_delete(GtPdomModelSet *set);
 
 #endif
@@ -0,0 +1,871 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <ctype.h>
+#include <math.h>
+#include <string.h>
+#include "core/ensure_api.h"
+#include "core/ma_api.h"
+#include "core/minmax_api.h"
+#include "core/unused_api.h"
+#include "ltr/pdom_profile.h"
+
+/* residues in HMMER3 order, followed by the codes for unknown residues and
+   for stop codons (which cannot be aligned) */
+#define GT_PDOM_PROFILE_ALPHABET      "ACDEFGHIKLMNPQRSTVWY"
+#define GT_PDOM_PROFILE_NOF_RESIDUES  20
+#define GT_PDOM_PROFILE_UNKNOWN       20
+#define GT_PDOM_PROFILE_STOP          21
+#define GT_PDOM_PROFILE_NOF_CODES     22
+
+/* transitions per node, in the order of the HMMER3 format */
+#define GT_PDOM_PROFILE_MM            0
+#define GT_PDOM_PROFILE_MI            1
+#define GT_PDOM_PROFILE_MD            2
+#define GT_PDOM_PROFILE_IM            3
+#define GT_PDOM_PROFILE_II            4
+#define GT_PDOM_PROFILE_DM            5
+#define GT_PDOM_PROFILE_DD            6
+#define GT_PDOM_PROFILE_NOF_TRANS     7
+
+/* maximal number of domains reported per profile and sequence */
+#define GT_PDOM_PROFILE_MAX_DOMAINS   16
+/* P-value threshold of the MSV filter, as in HMMER */
+#define GT_PDOM_PROFILE_MSV_PVALUE    0.02
+
+#define GT_PDOM_PROFILE_NEG_INF       ((float) -HUGE_VAL)
+#define GT_PDOM_PROFILE_LN2           0.69314718055994530942
+
+/* traceback encoding: predecessor of M in the lower two bits, of I and D in
+   the next two */
+#define GT_PDOM_PROFILE_TB_B          0
+#define GT_PDOM_PROFILE_TB_M          1
+#define GT_PDOM_PROFILE_TB_I          2
+#define GT_PDOM_PROFILE_TB_D          3
+#define GT_PDOM_PROFILE_TB_MASK       3
+#define GT_PDOM_PROFILE_TB_I_FROM_I   4
+#define GT_PDOM_PROFILE_TB_D_FROM_D   8
+
+/* amino acid background frequencies used by HMMER3 */
+static const double pdom_profile_bg[GT_PDOM_PROFILE_NOF_RESIDUES] = {
+  0.0787945, 0.0151600, 0.0535222, 0.0668298, 0.0397062,
+  0.0695071, 0.0229198, 0.0590092, 0.0594422, 0.0963728,
+  0.0237718, 0.0414386, 0.0482904, 0.0395639, 0.0540978,
+  0.0683364, 0.0540687, 0.0673417, 0.0114135, 0.0304133
+};
+
+struct GtPdomProfile {
+  GtStr *name;
+  GtUword length;
+  float *msc, /* match scores, GT_PDOM_PROFILE_NOF_CODES per node */
+        *tsc; /* transition scores, GT_PDOM_PROFILE_NOF_TRANS per node */
+  char *consensus;
+  double msv_mu, msv_lambda,
+         vit_mu, vit_lambda,
+         ga, tc;
+  bool has_msv_stats,
+       has_vit_stats,
+       has_ga,
+       has_tc;
+};
+
+#define pdom_profile_msc(P, K, C) \
+        (P)->msc[(K) * GT_PDOM_PROFILE_NOF_CODES + (C)]
+#define pdom_profile_tsc(P, K, T) \
+        (P)->tsc[(K) * GT_PDOM_PROFILE_NOF_TRANS + (T)]
+
+static GtPdomProfile* pdom_profile_new(void)
+{
+  GtPdomProfile *p = gt_calloc((size_t) 1, sizeof (GtPdomProfile));
+  p->name = gt_str_new();
+  return p;
+}
+
+void gt_pdom_profile_delete(GtPdomProfile *profile)
+{
+  if (!profile) return;
+  gt_str_delete(profile->name);
+  gt_free(profile->msc);
+  gt_free(profile->tsc);
+  gt_free(profile->consensus);
+  gt_free(profile);
+}
+
+/* Reads <n> values from <line> after skipping <skip> tokens. Values are
+   negative natural log probabilities, '*' denotes probability 0. Returns
+   the number of values read. */
+static GtUword pdom_profile_read_values(const char *line, GtUword skip,
+                                        double *values, GtUword n)
+{
+  const char *p = line;
+  GtUword i = 0, tok = 0;
+  while (*p != '\0' && i < n) {
+    while (isspace((int) *p))
+      p++;
+    if (*p == '\0')
+      break;
+    if (tok++ >= skip) {
+      if (*p == '*')
+        values[i++] = HUGE_VAL;
+      else {
+        char *end;
+        values[i] = strtod(p, &end);
+        if (end == p)
+          return i;
+        i++;
+      }
+    }
+    while (*p != '\0' && !isspace((int) *p))
+      p++;
+  }
+  return i;
+}
+
+/* Returns the first character of token <tok> of <line>, or '\0'. */
+static char pdom_profile_get_token_char(const char *line, GtUword tok)
+{
+  const char *p = line;
+  GtUword i = 0;
+  for (;;) {
+    while (isspace((int) *p))
+      p++;
+    if (*p == '\0')
+      return '\0';
+    if (i++ == tok)
+      return *p;
+    while (*p != '\0' && !isspace((int) *p))
+      p++;
+  }
+}
+
+static bool pdom_profile_has_prefix(const char *line, const char *prefix)
+{
+  return strncmp(line, prefix, strlen(prefix)) == 0;
+}
+
+static int pdom_profile_parse_node(GtPdomProfile *p, const GtStrArray *lines,
+                                   GtUword *lineno, GtUword k,
+                                   const char *source, GtError *err)
+{
+  double values[GT_PDOM_PROFILE_NOF_RESIDUES];
+  const char *line;
+  GtUword i;
+  gt_assert(k >= 1 && k <= p->length);
+  if (*lineno + 2 >= gt_str_array_size(lines)) {
+    gt_error_set(err, "%s: unexpected end of model %s", source,
+                 gt_str_get(p->name));
+    return -1;
+  }
+  /* match emissions, optionally followed by MAP CONS RF MM CS */
+  line = gt_str_array_get(lines, (*lineno)++);
+  if (pdom_profile_read_values(line, 1, values, GT_PDOM_PROFILE_NOF_RESIDUES)
+        != GT_PDOM_PROFILE_NOF_RESIDUES) {
+    gt_error_set(err, "%s: invalid match emission line for node "GT_WU
+                 " of model %s", source, k, gt_str_get(p->name));
+    return -1;
+  }
+  for (i = 0; i < GT_PDOM_PROFILE_NOF_RESIDUES; i++) {
+    pdom_profile_msc(p, k, i) = (float) (-values[i] - log(pdom_profile_bg[i]));
+  }
+  p->consensus[k] = pdom_profile_get_token_char(line,
+                                              GT_PDOM_PROFILE_NOF_RESIDUES + 2);
+  if (!isalpha((int) p->consensus[k])) {
+    GtUword best = 0;
+    for (i = 1; i < GT_PDOM_PROFILE_NOF_RESIDUES; i++) {
+      if (values[i] < values[best])
+        best = i;
+    }
+    p->consensus[k] = exp(-values[best]) >= 0.5
+                        ? GT_PDOM_PROFILE_ALPHABET[best]
+                        : tolower(GT_PDOM_PROFILE_ALPHABET[best]);
+  }
+  /* insert emissions are scored as background, see pdom_profile_viterbi() */
+  (*lineno)++;
+  /* transitions to the next node */
+  line = gt_str_array_get(lines, (*lineno)++);
+  if (pdom_profile_read_values(line, 0, values, GT_PDOM_PROFILE_NOF_TRANS)
+        != GT_PDOM_PROFILE_NOF_TRANS) {
+    gt_error_set(err, "%s: invalid transition line for node "GT_WU
+                 " of model %s", source, k, gt_str_get(p->name));
+    return -1;
+  }
+  for (i = 0; i < GT_PDOM_PROFILE_NOF_TRANS; i++)
+    pdom_profile_tsc(p, k, i) = (float) -values[i];
+  return 0;
+}
+
+static int pdom_profile_parse_one(GtPdomProfile *p, const GtStrArray *lines,
+                                  GtUword *lineno, const char *source,
+                                  GtError *err)
+{
+  const char *line;
+  double values[2];
+  GtUword k;
+  int had_err = 0;
+
+  /* header */
+  for (;;) {
+    if (*lineno >= gt_str_array_size(lines)) {
+      gt_error_set(err, "%s: unexpected end of file in model header", source);
+      return -1;
+    }
+    line = gt_str_array_get(lines, (*lineno)++);
+    if (pdom_profile_has_prefix(line, "NAME")) {
+      const char *name = line + 4;
+      while (isspace((int) *name))
+        name++;
+      gt_str_append_cstr(p->name, name);
+      while (gt_str_length(p->name) > 0
+               && isspace((int) gt_str_get(p->name)[gt_str_length(p->name)-1]))
+        gt_str_set_length(p->name, gt_str_length(p->name) - 1);
+    } else if (pdom_profile_has_prefix(line, "LENG")) {
+      if (pdom_profile_read_values(line, 1, values, 1) != 1 || values[0] < 1) {
+        gt_error_set(err, "%s: invalid LENG line: %s", source, line);
+        return -1;
+      }
+      p->length = (GtUword) values[0];
+    } else if (pdom_profile_has_prefix(line, "ALPH")) {
+      if (!strstr(line, "amino") && !strstr(line, "Amino")
+            && !strstr(line, "AMINO")) {
+        gt_error_set(err, "%s: invalid (non-protein) alphabet definition: %s",
+                     source, line);
+        return -1;
+      }
+    } else if (pdom_profile_has_prefix(line, "GA ")) {
+      p->has_ga = (pdom_profile_read_values(line, 1, values, 2) == 2);
+      p->ga = values[1];
+    } else if (pdom_profile_has_prefix(line, "TC ")) {
+      p->has_tc = (pdom_profile_read_values(line, 1, values, 2) == 2);
+      p->tc = values[1];
+    } else if (pdom_profile_has_prefix(line, "STATS LOCAL MSV")) {
+      p->has_msv_stats = (pdom_profile_read_values(line, 3, values, 2) == 2);
+      p->msv_mu = values[0];
+      p->msv_lambda = values[1];
+    } else if (pdom_profile_has_prefix(line, "STATS LOCAL VITERBI")) {
+      p->has_vit_stats = (pdom_profile_read_values(line, 3, values, 2) == 2);
+      p->vit_mu = values[0];
+      p->vit_lambda = values[1];
+    } else if (pdom_profile_has_prefix(line, "HMM ")) {
+      break;
+    }
+  }
+  if (p->length == 0) {
+    gt_error_set(err, "%s: model %s has no LENG line", source,
+                 gt_str_get(p->name));
+    return -1;
+  }
+  if (!p->has_vit_stats) {
+    gt_error_set(err, "%s: model %s is not calibrated (no STATS LOCAL VITERBI "
+                 "line)", source, gt_str_get(p->name));
+    return -1;
+  }
+
+  p->msc = gt_calloc((size_t) (p->length + 1) * GT_PDOM_PROFILE_NOF_CODES,
+                     sizeof (float));
+  p->tsc = gt_calloc((size_t) (p->length + 1) * GT_PDOM_PROFILE_NOF_TRANS,
+                     sizeof (float));
+  p->consensus = gt_calloc((size_t) p->length + 2, sizeof (char));
+
+  /* skip transition labels, optional COMPO line and node 0 (begin state),
+     which is not used in local mode */
+  (*lineno)++;
+  if (*lineno < gt_str_array_size(lines)
+        && pdom_profile_get_token_char(gt_str_array_get(lines, *lineno), 0)
+             == 'C') {
+    (*lineno)++;
+  }
+  *lineno += 2;
+
+  for (k = 1; !had_err && k <= p->length; k++)
+    had_err = pdom_profile_parse_node(p, lines, lineno, k, source, err);
+
+  if (!had_err) {
+    /* unknown residues score neutrally, stop codons cannot be aligned */
+    for (k = 1; k <= p->length; k++) {
+      pdom_profile_msc(p, k, GT_PDOM_PROFILE_UNKNOWN) = 0.0;
+      pdom_profile_msc(p, k, GT_PDOM_PROFILE_STOP) = GT_PDOM_PROFILE_NEG_INF;
+    }
+    if (*lineno >= gt_str_array_size(lines)
+          || !pdom_profile_has_prefix(gt_str_array_get(lines, *lineno), "//")) {
+      gt_error_set(err, "%s: missing end of model %s", source,
+                   gt_str_get(p->name));
+      had_err = -1;
+    } else
+      (*lineno)++;
+  }
+  return had_err;
+}
+
+int gt_pdom_profile_parse(GtArray *profiles, const GtStrArray *lines,
+                          const char *source, GtError *err)
+{
+  GtUword lineno = 0;
+  int had_err = 0;
+  gt_assert(profiles && lines && source);
+  gt_error_check(err);
+
+  while (!had_err && lineno < gt_str_array_size(lines)) {
+    const char *line = gt_str_array_get(lines, lineno);
+    GtPdomProfile *p;
+    if (line[0] == '\0') {
+      lineno++;
+      continue;
+    }
+    if (!pdom_profile_has_prefix(line, "HMMER3")) {
+      gt_error_set(err, "%s: expected HMMER3 model in line "GT_WU", the "
+                   "built-in search requires HMMER3 models (use hmmconvert "
+                   "to convert older formats)", source, lineno + 1);
+      had_err = -1;
+      break;
+    }
+    lineno++;
+    p = pdom_profile_new();
+    had_err = pdom_profile_parse_one(p, lines, &lineno, source, err);
+    if (had_err)
+      gt_pdom_profile_delete(p);
+    else
+      gt_array_add(profiles, p);
+  }
+  return had_err;
+}
+
+int gt_pdom_profile_parse_file(GtArray *profiles, const char *filename,
+                               GtError *err)
+{
+  GtStrArray *lines;
+  GtStr *line;
+  FILE *fp;
+  int had_err;
+  gt_assert(profiles && filename);
+  gt_error_check(err);
+
+  if (!(fp = fopen(filename, "r"))) {
+    gt_error_set(err, "can't open HMM file: %s", filename);
+    return -1;
+  }
+  lines = gt_str_array_new();
+  line = gt_str_new();
+  while (gt_str_read_next_line(line, fp) != EOF) {
+    gt_str_array_add(lines, line);
+    gt_str_reset(line);
+  }
+  (void) fclose(fp);
+  had_err = gt_pdom_profile_parse(profiles, lines, filename, err);
+  gt_str_delete(line);
+  gt_str_array_delete(lines);
+  return had_err;
+}
+
+const char* gt_pdom_profile_get_name(const GtPdomProfile *profile)
+{
+  gt_assert(profile);
+  return gt_str_get(profile->name);
+}
+
+GtUword gt_pdom_profile_length(const GtPdomProfile *profile)
+{
+  gt_assert(profile);
+  return profile->length;
+}
+
+bool gt_pdom_profile_get_ga(const GtPdomProfile *profile, double *cutoff)
+{
+  gt_assert(profile && cutoff);
+  if (profile->has_ga)
+    *cutoff = profile->ga;
+  return profile->has_ga;
+}
+
+bool gt_pdom_profile_get_tc(const GtPdomProfile *profile, double *cutoff)
+{
+  gt_assert(profile && cutoff);
+  if (profile->has_tc)
+    *cutoff = profile->tc;
+  return profile->has_tc;
+}
+
+static unsigned char pdom_profile_encode(char c)
+{
+  const char *pos;
+  if (c == '*')
+    return GT_PDOM_PROFILE_STOP;
+  pos = strchr(GT_PDOM_PROFILE_ALPHABET, toupper((int) c));
+  if (pos == NULL || c == '\0')
+    return GT_PDOM_PROFILE_UNKNOWN;
+  return (unsigned char) (pos - GT_PDOM_PROFILE_ALPHABET);
+}
+
+/* Gumbel survival function */
+static double pdom_profile_pvalue(double score, double mu, double lambda)
+{
+  return -expm1(-exp(-lambda * (score - mu)));
+}
+
+/* bit score of a path with <core> nats, given <unaligned> of <seqlen>
+   residues are emitted by the flanking states of a single-hit model */
+static double pdom_profile_bits(double core, GtUword seqlen,
+                                GtUword unaligned)
+{
+  double L = (double) seqlen,
+         flank, null;
+  flank = (double) unaligned * log(L / (L + 2.0)) + 2.0 * log(2.0 / (L + 2.0));
+  null = L * log(L / (L + 1.0)) + log(1.0 / (L + 1.0));
+  return (core + flank - null) / GT_PDOM_PROFILE_LN2;
+}
+
+/* Multi-segment ungapped filter (MSV), returns the bit score. */
+static double pdom_profile_msv(const GtPdomProfile *p,
+                               const unsigned char *dsq, GtUword seqlen,
+                               float *row)
+{
+  GtUword i, k, M = p->length;
+  double L = (double) seqlen,
+         tloop = log(L / (L + 3.0)),
+         tmove = log(3.0 / (L + 3.0)),
+         tentry = log(2.0 / ((double) M * (M + 1))),
+         xN = 0.0, xB, xE, xJ = -HUGE_VAL, xC = -HUGE_VAL, null;
+  for (k = 0; k <= M; k++)
+    row[k] = GT_PDOM_PROFILE_NEG_INF;
+  xB = xN + tmove;
+  for (i = 0; i < seqlen; i++) {
+    float diag = GT_PDOM_PROFILE_NEG_INF, cur;
+    xE = -HUGE_VAL;
+    for (k = 1; k <= M; k++) {
+      cur = GT_MAX(diag, (float) (xB + tentry))
+              + pdom_profile_msc(p, k, dsq[i]);
+      diag = row[k];
+      row[k] = cur;
+      if (cur > xE)
+        xE = cur;
+    }
+    xJ = GT_MAX(xJ + tloop, xE + log(0.5));
+    xC = GT_MAX(xC + tloop, xE + log(0.5));
+    xN = xN + tloop;
+    xB = GT_MAX(xN, xJ) + tmove;
+  }
+  null = L * log(L / (L + 1.0)) + log(1.0 / (L + 1.0));
+  return (xC + tmove - null) / GT_PDOM_PROFILE_LN2;
+}
+
+typedef struct {
+  float *pM, *pI, *pD,
+        *cM, *cI, *cD;
+  unsigned char *tb;
+} PdomProfileMatrix;
+
+/* Local single-hit Viterbi, fills the traceback and returns the best score
+   (in nats) of a path ending in match state <*end_k> at residue <*end_i>. */
+static double pdom_profile_viterbi(const GtPdomProfile *p,
+                                   const unsigned char *dsq, GtUword seqlen,
+                                   PdomProfileMatrix *mx,
+                                   GtUword *end_i, GtUword *end_k)
+{
+  GtUword i, k, M = p->length;
+  float tentry = (float) log(2.0 / ((double) M * (M + 1))),
+        best = GT_PDOM_PROFILE_NEG_INF;
+  float *tmp;
+
+  for (k = 0; k <= M; k++)
+    mx->pM[k] = mx->pI[k] = mx->pD[k] = GT_PDOM_PROFILE_NEG_INF;
+  *end_i = *end_k = 0;
+  for (i = 1; i <= seqlen; i++) {
+    unsigned char *tbrow = mx->tb + i * (M + 1);
+    /* insert states emit with background probability, i.e. score 0, but like
+       match states they cannot align stop codons, which also mask the residues
+       of domains already reported */
+    float isc = dsq[i-1] == GT_PDOM_PROFILE_STOP ? GT_PDOM_PROFILE_NEG_INF
+                                                 : 0.0;
+    mx->cM[0] = mx->cI[0] = mx->cD[0] = GT_PDOM_PROFILE_NEG_INF;
+    for (k = 1; k <= M; k++) {
+      float sc, msc = pdom_profile_msc(p, k, dsq[i-1]);
+      unsigned char tb = GT_PDOM_PROFILE_TB_B;
+      /* match state */
+      sc = tentry;
+      if (k > 1) {
+        float v;
+        v = mx->pM[k-1] + pdom_profile_tsc(p, k-1, GT_PDOM_PROFILE_MM);
+        if (v > sc) { sc = v; tb = GT_PDOM_PROFILE_TB_M; }
+        v = mx->pI[k-1] + pdom_profile_tsc(p, k-1, GT_PDOM_PROFILE_IM);
+        if (v > sc) { sc = v; tb = GT_PDOM_PROFILE_TB_I; }
+        v = mx->pD[k-1] + pdom_profile_tsc(p, k-1, GT_PDOM_PROFILE_DM);
+        if (v > sc) { sc = v; tb = GT_PDOM_PROFILE_TB_D; }
+      }
+      mx->cM[k] = sc + msc;
+      if (mx->cM[k] > best) {
+        best = mx->cM[k];
+        *end_i = i;
+        *end_k = k;
+      }
+      /* insert state */
+      if (k < M) {
+        float fromM = mx->pM[k] + pdom_profile_tsc(p, k, GT_PDOM_PROFILE_MI),
+              fromI = mx->pI[k] + pdom_profile_tsc(p, k, GT_PDOM_PROFILE_II);
+        if (fromI > fromM) {
+          mx->cI[k] = fromI + isc;
+          tb |= GT_PDOM_PROFILE_TB_I_FROM_I;
+        } else
+          mx->cI[k] = fromM + isc;
+      } else
+        mx->cI[k] = GT_PDOM_PROFILE_NEG_INF;
+      /* delete state */
+      if (k > 1) {
+        float fromM = mx->cM[k-1] + pdom_profile_tsc(p, k-1,
+                                                     GT_PDOM_PROFILE_MD),
+              fromD = mx->cD[k-1] + pdom_profile_tsc(p, k-1,
+                                                     GT_PDOM_PROFILE_DD);
+        if (fromD > fromM) {
+          mx->cD[k] = fromD;
+          tb |= GT_PDOM_PROFILE_TB_D_FROM_D;
+        } else
+          mx->cD[k] = fromM;
+      } else
+        mx->cD[k] = GT_PDOM_PROFILE_NEG_INF;
+      tbrow[k] = tb;
+    }
+    tmp = mx->pM; mx->pM = mx->cM; mx->cM = tmp;
+    tmp = mx->pI; mx->pI = mx->cI; mx->cI = tmp;
+    tmp = mx->pD; mx->pD = mx->cD; mx->cD = tmp;
+  }
+  return (double) best;
+}
+
+typedef enum {
+  PDOM_STATE_M,
+  PDOM_STATE_I,
+  PDOM_STATE_D
+} PdomProfileState;
+
+/* Traces back from <end_i>/<end_k> and writes the three alignment rows
+   (reversed) to <model>, <match> and <target>. */
+static void pdom_profile_traceback(const GtPdomProfile *p, const char *seq,
+                                   const unsigned char *dsq,
+                                   const PdomProfileMatrix *mx,
+                                   GtUword end_i, GtUword end_k,
+                                   GtPdomProfileHit *hit, GtStr *model,
+                                   GtStr *match, GtStr *target)
+{
+  GtUword i = end_i, k = end_k, M = p->length;
+  PdomProfileState state = PDOM_STATE_M;
+  for (;;) {
+    unsigned char tb = mx->tb[i * (M + 1) + k];
+    if (state == PDOM_STATE_M) {
+      char cons = p->consensus[k],
+           res = seq[i-1];
+      gt_str_append_char(model, cons);
+      gt_str_append_char(target, toupper((int) res));
+      if (toupper((int) res) == toupper((int) cons))
+        gt_str_append_char(match, cons);
+      else if (pdom_profile_msc(p, k, dsq[i-1]) > 0)
+        gt_str_append_char(match, '+');
+      else
+        gt_str_append_char(match, ' ');
+      switch (tb & GT_PDOM_PROFILE_TB_MASK) {
+        case GT_PDOM_PROFILE_TB_B:
+          hit->alifrom = i;
+          hit->hmmfrom = k;
+          return;
+        case GT_PDOM_PROFILE_TB_M:
+          state = PDOM_STATE_M;
+          break;
+        case GT_PDOM_PROFILE_TB_I:
+          state = PDOM_STATE_I;
+          break;
+        default:
+          state = PDOM_STATE_D;
+      }
+      i--;
+      k--;
+    } else if (state == PDOM_STATE_I) {
+      gt_str_append_char(model, '.');
+      gt_str_append_char(match, ' ');
+      gt_str_append_char(target, tolower((int) seq[i-1]));
+      state = (tb & GT_PDOM_PROFILE_TB_I_FROM_I) ? PDOM_STATE_I : PDOM_STATE_M;
+      i--;
+    } else {
+      gt_str_append_char(model, p->consensus[k]);
+      gt_str_append_char(match, ' ');
+      gt_str_append_char(target, '-');
+      state = (tb & GT_PDOM_PROFILE_TB_D_FROM_D) ? PDOM_STATE_D : PDOM_STATE_M;
+      k--;
+    }
+    gt_assert(i > 0 && k > 0);
+  }
+}
+
+static void pdom_profile_reverse(GtStr *s)
+{
+  char *c = gt_str_get(s), tmp;
+  GtUword i, n = gt_str_length(s);
+  for (i = 0; i < n / 2; i++) {
+    tmp = c[i];
+    c[i] = c[n - 1 - i];
+    c[n - 1 - i] = tmp;
+  }
+}
+
+static void pdom_profile_format_hit(const GtPdomProfile *p, const char *seqname,
+                                    GtPdomProfileHit *hit, GtStr *model,
+                                    GtStr *match, GtStr *target)
+{
+  char buf[BUFSIZ];
+  int width;
+  GtUword i;
+  pdom_profile_reverse(model);
+  pdom_profile_reverse(match);
+  pdom_profile_reverse(target);
+  width = (int) GT_MAX(gt_str_length(p->name), strlen(seqname));
+  hit->alignment = gt_str_new();
+  (void) snprintf(buf, BUFSIZ, "  %*s %5"GT_WUS" %s %-5"GT_WUS"\n", width,
+                  gt_str_get(p->name), hit->hmmfrom, gt_str_get(model),
+                  hit->hmmto);
+  gt_str_append_cstr(hit->alignment, buf);
+  (void) snprintf(buf, BUFSIZ, "  %*s %5s %s\n", width, "", "",
+                  gt_str_get(match));
+  gt_str_append_cstr(hit->alignment, buf);
+  (void) snprintf(buf, BUFSIZ, "  %*s %5"GT_WUS" %s %-5"GT_WUS"\n", width,
+                  seqname, hit->alifrom, gt_str_get(target), hit->alito);
+  gt_str_append_cstr(hit->alignment, buf);
+  hit->aastring = gt_str_new();
+  for (i = 0; i < gt_str_length(target); i++) {
+    char c = gt_str_get(target)[i];
+    if (c == '-' || c == '.')
+      continue;
+    /* insertions are lowercase in the alignment */
+    gt_str_append_char(hit->aastring, toupper((int) c));
+  }
+}
+
+GtUword gt_pdom_profile_search(const GtPdomProfile *profile,
+                               const char *seq, GtUword seqlen,
+                               const char *seqname, GtUword nof_profiles,
+                               double min_score, double max_evalue,
+                               GtArray *hits)
+{
+  PdomProfileMatrix mx;
+  unsigned char *dsq;
+  GtStr *model, *match, *target;
+  GtUword i, M, nof_hits = 0;
+  float *rows;
+  gt_assert(profile && seq && seqname && hits);
+
+  if (seqlen == 0)
+    return 0;
+  M = profile->length;
+  dsq = gt_malloc((size_t) seqlen * sizeof (unsigned char));
+  for (i = 0; i < seqlen; i++)
+    dsq[i] = pdom_profile_encode(seq[i]);
+  rows = gt_malloc((size_t) 6 * (M + 1) * sizeof (float));
+
+  /* cheap ungapped filter first */
+  if (profile->has_msv_stats) {
+    double msv = pdom_profile_msv(profile, dsq, seqlen, rows);
+    if (pdom_profile_pvalue(msv, profile->msv_mu, profile->msv_lambda)
+          > GT_PDOM_PROFILE_MSV_PVALUE) {
+      gt_free(rows);
+      gt_free(dsq);
+      return 0;
+    }
+  }
+
+  mx.pM = rows;
+  mx.pI = rows + (M + 1);
+  mx.pD = rows + 2 * (M + 1);
+  mx.cM = rows + 3 * (M + 1);
+  mx.cI = rows + 4 * (M + 1);
+  mx.cD = rows + 5 * (M + 1);
+  mx.tb = gt_malloc((size_t) (seqlen + 1) * (M + 1) * sizeof (unsigned char));
+  model = gt_str_new();
+  match = gt_str_new();
+  target = gt_str_new();
+
+  /* report the best domain, mask it and repeat */
+  while (nof_hits < GT_PDOM_PROFILE_MAX_DOMAINS) {
+    GtPdomProfileHit hit;
+    GtUword end_i, end_k;
+    double core, evalue;
+    core = pdom_profile_viterbi(profile, dsq, seqlen, &mx, &end_i, &end_k);
+    if (end_i == 0)
+      break;
+    gt_str_reset(model);
+    gt_str_reset(match);
+    gt_str_reset(target);
+    memset(&hit, 0, sizeof (hit));
+    hit.alito = end_i;
+    hit.hmmto = end_k;
+    pdom_profile_traceback(profile, seq, dsq, &mx, end_i, end_k, &hit, model,
+                           match, target);
+    hit.score = pdom_profile_bits(core, seqlen,
+                                  seqlen - (hit.alito - hit.alifrom + 1));
+    evalue = (double) nof_profiles
+               * pdom_profile_pvalue(hit.score, profile->vit_mu,
+                                     profile->vit_lambda);
+    hit.evalue = evalue;
+    if (hit.score < min_score || evalue > max_evalue)
+      break;
+    pdom_profile_format_hit(profile, seqname, &hit, model, match, target);
+    gt_array_add(hits, hit);
+    nof_hits++;
+    for (i = hit.alifrom - 1; i < hit.alito; i++)
+      dsq[i] = GT_PDOM_PROFILE_STOP;
+  }
+
+  gt_str_delete(model);
+  gt_str_delete(match);
+  gt_str_delete(target);
+  gt_free(mx.tb);
+  gt_free(rows);
+  gt_free(dsq);
+  return nof_hits;
+}
+
+/* Builds a calibrated HMMER3 model emitting <cons> with high probability. */
+static void pdom_profile_test_model(GtStrArray *lines, const char *name,
+                                    const char *cons)
+{
+  GtUword i, k, M = (GtUword) strlen(cons);
+  char buf[BUFSIZ];
+  GtStr *line = gt_str_new();
+  gt_str_array_add_cstr(lines, "HMMER3/f [3.1b2 | February 2015]");
+  (void) snprintf(buf, BUFSIZ, "NAME  %s", name);
+  gt_str_array_add_cstr(lines, buf);
+  (void) snprintf(buf, BUFSIZ, "LENG  "GT_WU, M);
+  gt_str_array_add_cstr(lines, buf);
+  gt_str_array_add_cstr(lines, "ALPH  amino");
+  gt_str_array_add_cstr(lines, "GA    10.00 10.00;");
+  gt_str_array_add_cstr(lines, "STATS LOCAL MSV       -9.0  0.70");
+  gt_str_array_add_cstr(lines, "STATS LOCAL VITERBI   -9.5  0.70");
+  gt_str_array_add_cstr(lines, "STATS LOCAL FORWARD   -3.5  0.70");
+  gt_str_array_add_cstr(lines, "HMM          A        C        D        E   "
+                               "     F        G        H        I        K"
+                               "        L        M        N        P        Q"
+                               "        R        S        T        V        W"
+                               "        Y");
+  gt_str_array_add_cstr(lines, "            m->m     m->i     m->d     i->m "
+                               "    i->i     d->m     d->d");
+  gt_str_array_add_cstr(lines, "  COMPO   2.5 2.5 2.5 2.5 2.5 2.5 2.5 2.5 2.5 "
+                               "2.5 2.5 2.5 2.5 2.5 2.5 2.5 2.5 2.5 2.5 2.5");
+  gt_str_array_add_cstr(lines, "          3.0 3.0 3.0 3.0 3.0 3.0 3.0 3.0 3.0 "
+                               "3.0 3.0 3.0 3.0 3.0 3.0 3.0 3.0 3.0 3.0 3.0");
+  gt_str_array_add_cstr(lines, "          0.01 5.0 5.0 0.7 0.7 0.0 *");
+  for (k = 1; k <= M; k++) {
+    gt_str_reset(line);
+    (void) snprintf(buf, BUFSIZ, "  "GT_WU, k);
+    gt_str_append_cstr(line, buf);
+    for (i = 0; i < GT_PDOM_PROFILE_NOF_RESIDUES; i++) {
+      gt_str_append_cstr(line, GT_PDOM_PROFILE_ALPHABET[i] == cons[k-1]
+                                 ? " 0.2" : " 4.6");
+    }
+    (void) snprintf(buf, BUFSIZ, " "GT_WU" %c - - -", k, cons[k-1]);
+    gt_str_append_cstr(line, buf);
+    gt_str_array_add(lines, line);
+    gt_str_array_add_cstr(lines, "          3.0 3.0 3.0 3.0 3.0 3.0 3.0 3.0 "
+                                 "3.0 3.0 3.0 3.0 3.0 3.0 3.0 3.0 3.0 3.0 3.0 "
+                                 "3.0");
+    gt_str_array_add_cstr(lines, k < M ? "          0.01 5.0 5.0 0.7 0.7 0.7 "
+                                         "0.7"
+                                       : "          0.0 * * 0.7 0.7 0.0 *");
+  }
+  gt_str_array_add_cstr(lines, "//");
+  gt_str_delete(line);
+}
+
+int gt_pdom_profile_unit_test(GtError *err)
+{
+  const char *cons = "WCHWMYCPKFWQHR";
+  GtArray *profiles, *hits;
+  GtStrArray *lines;
+  GtPdomProfile *p;
+  double cutoff = 0.0;
+  int had_err = 0, rval;
+  gt_error_check(err);
+
+  lines = gt_str_array_new();
+  profiles = gt_array_new(sizeof (GtPdomProfile*));
+  hits = gt_array_new(sizeof (GtPdomProfileHit));
+
+  pdom_profile_test_model(lines, "test_domain", cons);
+  pdom_profile_test_model(lines, "other_domain", "GGSGGSGGSGGS");
+  had_err = gt_pdom_profile_parse(profiles, lines, "test", err);
+  gt_ensure(gt_array_size(profiles) == 2);
+  if (!had_err) {
+    p = *(GtPdomProfile**) gt_array_get(profiles, 0);
+    gt_ensure(strcmp(gt_pdom_profile_get_name(p), "test_domain") == 0);
+    gt_ensure(gt_pdom_profile_length(p) == strlen(cons));
+    gt_ensure(gt_pdom_profile_get_ga(p, &cutoff) && cutoff == 10.0);
+    gt_ensure(!gt_pdom_profile_get_tc(p, &cutoff));
+    gt_ensure(strncmp(p->consensus + 1, cons, strlen(cons)) == 0);
+  }
+
+  /* embedded domain with one substitution */
+  if (!had_err) {
+    const char *seq = "MKLVAAEDSTRAWCHWMYCPKFAQHRSSDEAKTLLAE";
+    GtPdomProfileHit *hit;
+    p = *(GtPdomProfile**) gt_array_get(profiles, 0);
+    gt_ensure(gt_pdom_profile_search(p, seq, strlen(seq), "0+", 2, 0.0, 1.0,
+                                     hits) == 1);
+    if (!had_err) {
+      hit = gt_array_get(hits, 0);
+      gt_ensure(hit->hmmfrom == 1);
+      gt_ensure(hit->hmmto == strlen(cons));
+      gt_ensure(hit->alifrom == 13);
+      gt_ensure(hit->alito == 26);
+      gt_ensure(hit->score > 10.0);
+      gt_ensure(hit->evalue < 1e-3);
+      gt_ensure(strcmp(gt_str_get(hit->aastring), "WCHWMYCPKFAQHR") == 0);
+      gt_ensure(strstr(gt_str_get(hit->alignment), "test_domain") != NULL);
+    }
+  }
+
+  /* unrelated sequence */
+  if (!had_err) {
+    const char *seq = "MKLVAAEDSTRAEEDLLAKTLLAE";
+    GtUword i;
+    p = *(GtPdomProfile**) gt_array_get(profiles, 0);
+    for (i = 0; i < gt_array_size(hits); i++) {
+      GtPdomProfileHit *hit = gt_array_get(hits, i);
+      gt_str_delete(hit->alignment);
+      gt_str_delete(hit->aastring);
+    }
+    gt_array_reset(hits);
+    gt_ensure(gt_pdom_profile_search(p, seq, strlen(seq), "0+", 2, 0.0, 1.0,
+                                     hits) == 0);
+  }
+
+  /* invalid format */
+  if (!had_err) {
+    GtArray *tmp = gt_array_new(sizeof (GtPdomProfile*));
+    gt_str_array_reset(lines);
+    gt_str_array_add_cstr(lines, "HMMER2.0  [2.3.2]");
+    rval = gt_pdom_profile_parse(tmp, lines, "test", err);
+    gt_ensure(rval != 0);
+    gt_ensure(gt_array_size(tmp) == 0);
+    if (!had_err)
+      gt_error_unset(err);
+    gt_array_delete(tmp);
+  }
+
+  while (gt_array_size(hits) > 0) {
+    GtPdomProfileHit *hit = gt_array_pop(hits);
+    gt_str_delete(hit->alignment);
+    gt_str_delete(hit->aastring);
+  }
+  while (gt_array_size(profiles) > 0)
+    gt_pdom_profile_delete(*(GtPdomProfile**) gt_array_pop(profiles));
+  gt_array_delete(hits);
+  gt_array_delete(profiles);
+  gt_str_array_delete(lines);
+  return had_err;
+}
@@ -0,0 +1,77 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef PDOM_PROFILE_H
+#define PDOM_PROFILE_H
+
+#include <stdbool.h>
+#include "core/array_api.h"
+#include "core/error_api.h"
+#include "core/str_api.h"
+#include "core/str_array_api.h"
+
+/* A profile HMM in HMMER3 format, searched in-process by a Viterbi engine
+   as an alternative to running hmmscan. */
+typedef struct GtPdomProfile GtPdomProfile;
+
+/* A local alignment of a profile to an amino acid sequence. Coordinates are
+   1-based and inclusive, as in HMMER output. <alignment> and <aastring> are
+   owned by the hit. */
+typedef struct {
+  GtUword hmmfrom,
+          hmmto,
+          alifrom,
+          alito;
+  double score,  /* in bits */
+         evalue;
+  GtStr *alignment,
+        *aastring;
+} GtPdomProfileHit;
+
+/* Parses all profiles in HMMER3 text format from <lines> and appends them
+   (as <GtPdomProfile*>) to <profiles>. <source> is used in error messages.
+   Returns -1 and sets <err> on error. */
+int            gt_pdom_profile_parse(GtArray *profiles, const GtStrArray *lines,
+                                     const char *source, GtError *err);
+/* Like gt_pdom_profile_parse(), but reads the profiles from <filename>. */
+int            gt_pdom_profile_parse_file(GtArray *profiles,
+                                          const char *filename, GtError *err);
+
+const char*    gt_pdom_profile_get_name(const GtPdomProfile *profile);
+GtUword        gt_pdom_profile_length(const GtPdomProfile *profile);
+/* Returns true and stores the per-domain gathering (GA) or trusted (TC)
+   cutoff in <cutoff> if <profile> defines it. */
+bool           gt_pdom_profile_get_ga(const GtPdomProfile *profile,
+                                      double *cutoff);
+bool           gt_pdom_profile_get_tc(const GtPdomProfile *profile,
+                                      double *cutoff);
+
+/* Searches <profile> in the amino acid sequence <seq> of length <seqlen>
+   and appends all non-overlapping domain hits with a score of at least
+   <min_score> bits and an E-value of at most <max_evalue> to <hits> (as
+   <GtPdomProfileHit>), best hit first. E-values are computed for a database
+   of <nof_profiles> profiles. <seqname> is used to label the target line of
+   the alignment. Returns the number of hits added. */
+GtUword        gt_pdom_profile_search(const GtPdomProfile *profile,
+                                      const char *seq, GtUword seqlen,
+                                      const char *seqname,
+                                      GtUword nof_profiles, double min_score,
+                                      double max_evalue, GtArray *hits);
+
+void           gt_pdom_profile_delete(GtPdomProfile *profile);
+int            gt_pdom_profile_unit_test(GtError *err);
+
+#endif
@@ -162,6 +162,7 @@ struct GtDiagbandseedExtendParams
        always_polished_ends,
        verify_alignment,
        only_selected_seqpairs,
+       wfa_realign,
        cam_generic;
 };
 
@@ -333,6 +334,7 @@ GtDiagbandseedExtendParams *gt_diagbandseed_extend_params_new(
                                 bool always_polished_ends,
                                 bool verify_alignment,
                                 bool only_selected_seqpairs,
+                                bool wfa_realign,
                                 GtAniAccumulate *ani_accumulate)
 {
   GtDiagbandseedExtendParams *extp = gt_malloc(sizeof *extp);
@@ -359,6 +361,7 @@ GtDiagbandseedExtendParams *gt_diagbandseed_extend_params_new(
   extp->always_polished_ends = always_polished_ends;
   extp->verify_alignment = verify_alignment;
   extp->only_selected_seqpairs = only_selected_seqpairs;
+  extp->wfa_realign = wfa_realign;
   extp->ani_accumulate = ani_accumulate;
   return extp;
 }
@@ -4305,7 +4308,7 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
                                          extp->sensitivity);
       processinfo = (void *) xdropinfo;
     }
-    if (extp->extendxdrop || extp->verify_alignment ||
+    if (extp->extendxdrop || extp->verify_alignment || extp->wfa_realign ||
         gt_querymatch_alignment_display(extp->out_display_flag) ||
         gt_querymatch_trace_display(extp->out_display_flag) ||
         gt_querymatch_dtrace_display(extp->out_display_flag) ||
@@ -4334,6 +4337,10 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
                                        extp->always_polished_ends,
                                        extp->out_display_flag);
       }
+      if (extp->wfa_realign)
+      {
+        gt_querymatchoutoptions_wfa_set(querymoutopt);
+      }
     }
     /* process first mlist */
     gt_assert(seedpairlist != NULL);
@@ -110,6 +110,7 @@ GtDiagbandseedExtendParams *gt_diagbandseed_extend_params_new(
                                 bool always_polished_ends,
                                 bool verify_alignment,
                                 bool only_selected_seqpairs,
+                                bool wfa_realign,
                                 GtAniAccumulate *ani_accumulate);
 
 /* The destructors */
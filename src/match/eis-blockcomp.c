@@ -2511,6 +2511,15 @@ deleteBlockCompSeqHint(struct encIdxSeq *seq, union EISHint *hint)
   gt_free(hint);
 }
 
+/* without the mapping, super blocks are read through the one shared
+ * file pointer of the index */
+static bool
+blockCompSeqHintsAreIndependent(const struct encIdxSeq *seq)
+{
+  gt_assert(seq && seq->classInfo == &blockCompositionSeqClass);
+  return seqIdxUsesMMap(constEncIdxSeq2blockCompositionSeq(seq));
+}
+
 static int
 printBlock(Symbol *block, unsigned blockSize, FILE *fp)
 {
@@ -2742,6 +2751,7 @@ static const struct encIdxSeqClass blockCompositionSeqClass =
   .select = blockCompSeqSelect,
   .get = blockCompSeqGet,
   .newHint = newBlockCompSeqHint,
+  .hintsAreIndependent = blockCompSeqHintsAreIndependent,
   .deleteHint = deleteBlockCompSeqHint,
   .expose = blockCompSeqExpose,
   .seekToHeader = seekToHeader,
@@ -15,7 +15,10 @@
 */
 
 #include "core/encseq_metadata.h"
+#include "core/fileutils_api.h"
 #include "core/log.h"
+#include "core/warning_api.h"
+#include "core/xansi_api.h"
 #include "match/sarr-def.h"
 #include "match/esa-map.h"
 #include "match/eis-bitpackseqpos.h"
@@ -26,6 +29,8 @@
 #include "match/eis-bwtseq-priv.h"
 #include "match/eis-encidxseq.h"
 #include "match/eis-encidxseq-construct.h"
+#include "match/eis-interleavedrank.h"
+#include "match/eis-sasample.h"
 
 BWTSeq *
 gt_availBWTSeq(const struct bwtParam *params, GtLogger *verbosity,
@@ -155,6 +160,74 @@ gt_loadBWTSeq(const char *projectName, int BWTOptFlags,
   return bwtSeq;
 }
 
+static GtStr *
+interleavedRankIdxName(const char *projectName)
+{
+  GtStr *irxName = gt_str_new_cstr(projectName);
+  gt_str_append_cstr(irxName, IRI_FILE_SUFFIX);
+  return irxName;
+}
+
+/* an interleaved rank index is optional, if it cannot be used the
+ * block composition index answers all rank queries */
+static void
+loadInterleavedRankIdx(BWTSeq *bwtSeq, const char *projectName)
+{
+  GtStr *irxName = interleavedRankIdxName(projectName);
+  if (gt_file_exists(gt_str_get(irxName)))
+  {
+    GtError *irxErr = gt_error_new();
+    bwtSeq->rankIdx = gt_loadInterleavedRankIdx(projectName, bwtSeq->seqIdx,
+                                                bwtSeq->hint, irxErr);
+    if (bwtSeq->rankIdx == NULL)
+      gt_warning("%s, using block composition index for rank queries",
+                 gt_error_get(irxErr));
+    gt_error_delete(irxErr);
+  }
+  gt_str_delete(irxName);
+}
+
+static GtStr *
+saSampleIdxName(const char *projectName)
+{
+  GtStr *ssxName = gt_str_new_cstr(projectName);
+  gt_str_append_cstr(ssxName, SSI_FILE_SUFFIX);
+  return ssxName;
+}
+
+/* suffix array samples built after index construction replace the
+ * locate information stored in the index, they also make an index
+ * without locate information searchable for positions */
+static void
+loadSASampleIdx(BWTSeq *bwtSeq, const char *projectName)
+{
+  GtStr *ssxName = saSampleIdxName(projectName);
+  if (gt_file_exists(gt_str_get(ssxName)))
+  {
+    GtError *ssxErr = gt_error_new();
+    bwtSeq->saSample = gt_loadSASampleIdx(projectName, BWTSeqLength(bwtSeq),
+                                          ssxErr);
+    if (bwtSeq->saSample != NULL && BWTSeqHasLocateInformation(bwtSeq)
+        && SSIRot0Pos(bwtSeq->saSample) != BWTSeqTerminatorPos(bwtSeq))
+    {
+      gt_error_set(ssxErr, "suffix array sample table %s does not match "
+                   "the sequence index", gt_str_get(ssxName));
+      gt_deleteSASampleIdx(bwtSeq->saSample);
+      bwtSeq->saSample = NULL;
+    }
+    if (bwtSeq->saSample == NULL)
+      gt_warning("%s, using locate information of the index",
+                 gt_error_get(ssxErr));
+    else if (!BWTSeqHasLocateInformation(bwtSeq))
+    {
+      bwtSeq->rot0Pos = SSIRot0Pos(bwtSeq->saSample);
+      bwtSeq->locateSampleInterval = SSISampleRate(bwtSeq->saSample);
+    }
+    gt_error_delete(ssxErr);
+  }
+  gt_str_delete(ssxName);
+}
+
 BWTSeq *
 gt_loadBWTSeqForSA(const char *projectName, enum seqBaseEncoding encType,
                    int BWTOptFlags, const GtAlphabet *gtalphabet,
@@ -172,6 +245,11 @@ gt_loadBWTSeqForSA(const char *projectName, enum seqBaseEncoding encType,
   {
     bwtSeq = gt_newBWTSeq(seqIdx, alphabet,
                           GTAlphabetRangeSort[GT_ALPHABETHANDLING_DEFAULT]);
+    if (bwtSeq != NULL)
+    {
+      loadInterleavedRankIdx(bwtSeq, projectName);
+      loadSASampleIdx(bwtSeq, projectName);
+    }
   }
   if (!bwtSeq)
   {
@@ -269,13 +347,44 @@ gt_createBWTSeqFromSfxI(const struct bwtParam *params, sfxInterface *sfxi,
   return bwtSeq;
 }
 
+static int
+buildInterleavedRankIdx(BWTSeq *bwtSeq, const struct bwtParam *params,
+                        SASeqSrc *src, GtError *err)
+{
+  const char *projectName = gt_str_get(params->projectName);
+  Definedunsignedlong rot0Pos;
+  if (!(params->featureToggles & BWTInterleavedRank))
+  {
+    /* do not leave a rank index of an earlier construction behind */
+    GtStr *irxName = interleavedRankIdxName(projectName);
+    if (gt_file_exists(gt_str_get(irxName)))
+      gt_xremove(gt_str_get(irxName));
+    gt_str_delete(irxName);
+    return 0;
+  }
+  rot0Pos = SASSGetRot0Pos(src);
+  gt_assert(rot0Pos.defined);
+  if (gt_writeInterleavedRankIdx(bwtSeq->seqIdx, bwtSeq->hint,
+                                 rot0Pos.valueunsignedlong, projectName,
+                                 err) != 0)
+    return -1;
+  bwtSeq->rankIdx = gt_loadInterleavedRankIdx(projectName, bwtSeq->seqIdx,
+                                              bwtSeq->hint, err);
+  return bwtSeq->rankIdx == NULL ? -1 : 0;
+}
+
 static BWTSeq *
 gt_createBWTSeqFromSASS(const struct bwtParam *params, SASeqSrc *src,
                      SpecialsRankLookup *sprTable,
                      const enum rangeSortMode *rangeSort,
                      GtError *err)
 {
+  GtStr *ssxName = saSampleIdxName(gt_str_get(params->projectName));
   EISeq *seqIdx = NULL;
+  /* suffix array samples of an earlier index must be rebuilt */
+  if (gt_file_exists(gt_str_get(ssxName)))
+    gt_xremove(gt_str_get(ssxName));
+  gt_str_delete(ssxName);
   BWTSeq *bwtSeq = NULL;
   seqIdx = gt_createBWTSeqGeneric(params, gt_createEncIdxSeqGen, src,
                                rangeSort, sprTable, err);
@@ -288,6 +397,11 @@ gt_createBWTSeqFromSASS(const struct bwtParam *params, SASeqSrc *src,
       gt_deleteEncIdxSeq(seqIdx);
       gt_MRAEncDelete(alphabet);
     }
+    else if (buildInterleavedRankIdx(bwtSeq, params, src, err) != 0)
+    {
+      gt_deleteBWTSeq(bwtSeq);
+      bwtSeq = NULL;
+    }
   }
   return bwtSeq;
 }
@@ -18,7 +18,9 @@
 
 #include "core/chardef_api.h"
 #include "core/log.h"
+#include "core/ma_api.h"
 #include "core/minmax_api.h"
+#include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "core/xansi_api.h"
 #include "match/eis-specialsrank.h"
@@ -675,7 +677,9 @@ int
 gt_BWTSeqPosHasLocateInfo(const BWTSeq *bwtSeq, GtUword pos,
                        struct extBitsRetrieval *extBits)
 {
-  if (bwtSeq->featureToggles & BWTLocateBitmap)
+  if (bwtSeq->saSample != NULL)
+    return SSIIsSampled(bwtSeq->saSample, pos);
+  else if (bwtSeq->featureToggles & BWTLocateBitmap)
   {
     EISRetrieveExtraBits(bwtSeq->seqIdx, pos, EBRF_RETRIEVE_CWBITS, extBits,
                          bwtSeq->hint);
@@ -702,7 +706,18 @@ GtUword
 gt_BWTSeqLocateMatch(const BWTSeq *bwtSeq, GtUword pos,
                   struct extBitsRetrieval *extBits)
 {
-  if (bwtSeq->featureToggles & BWTLocateBitmap)
+  if (bwtSeq->saSample != NULL)
+  {
+    /* rows which cannot be LF-mapped by counts are always sampled */
+    GtUword nextLocate = pos, locateOffset = 0;
+    while (!SSIIsSampled(bwtSeq->saSample, nextLocate))
+    {
+      nextLocate = BWTSeqLFMap(bwtSeq, nextLocate, extBits);
+      ++locateOffset;
+    }
+    return SSIGetSample(bwtSeq->saSample, nextLocate) + locateOffset;
+  }
+  else if (bwtSeq->featureToggles & BWTLocateBitmap)
   {
     GtUword nextLocate = pos;
     unsigned locateOffset = 0;
@@ -772,6 +787,160 @@ gt_BWTSeqLocateMatch(const BWTSeq *bwtSeq, GtUword pos,
    return 0; /* shut up compiler */
 }
 
+struct BWTSeqLocateCache
+{
+  GtUword *rows, *positions, mask;
+};
+
+BWTSeqLocateCache *
+gt_newBWTSeqLocateCache(unsigned sizeLog2)
+{
+  BWTSeqLocateCache *cache = gt_malloc(sizeof (*cache));
+  GtUword idx, size = 1UL << sizeLog2;
+  cache->rows = gt_malloc(sizeof (*cache->rows) * size);
+  cache->positions = gt_malloc(sizeof (*cache->positions) * size);
+  for (idx = 0; idx < size; ++idx)
+    cache->rows[idx] = GT_UNDEF_UWORD;
+  cache->mask = size - 1;
+  return cache;
+}
+
+void
+gt_deleteBWTSeqLocateCache(BWTSeqLocateCache *cache)
+{
+  if (cache == NULL)
+    return;
+  gt_free(cache->rows);
+  gt_free(cache->positions);
+  gt_free(cache);
+}
+
+static inline bool
+BWTSeqLocateCacheGet(const BWTSeqLocateCache *cache, GtUword row,
+                     GtUword *pos)
+{
+  if (cache->rows[row & cache->mask] != row)
+    return false;
+  *pos = cache->positions[row & cache->mask];
+  return true;
+}
+
+/* LF-mapping a run of rows at once requires symbols sorted by value */
+static inline bool
+BWTSeqTransformedSymIsValueSorted(const BWTSeq *bwtSeq, Symbol tSym)
+{
+  return tSym != bwtSeq->bwtTerminatorFallback
+    && bwtSeq->rangeSort[MRAEncGetRangeOfSymbol(bwtSeq->alphabet, tSym)]
+       == SORTMODE_VALUE;
+}
+
+GtUword
+gt_BWTSeqLocateInterval(const BWTSeq *bwtSeq, GtUword start, GtUword end,
+                        GtUword *positions, BWTSeqLocateCache *cache)
+{
+  struct extBitsRetrieval extBits;
+  struct matchBound *runSpace, *runs, *nextRuns;
+  Symbol *runSyms;
+  GtUword *slotSpace, *slots, *nextSlots, width, idx, numRuns = 1,
+    locateOffset = 0;
+
+  gt_assert(bwtSeq && BWTSeqHasLocateInformation(bwtSeq));
+  if (start >= end)
+    return 0;
+  width = end - start;
+  runSpace = gt_malloc(sizeof (*runSpace) * width * 2);
+  runs = runSpace;
+  nextRuns = runSpace + width;
+  runSyms = gt_malloc(sizeof (*runSyms) * width);
+  slotSpace = gt_malloc(sizeof (*slotSpace) * width * 2);
+  slots = slotSpace;
+  nextSlots = slotSpace + width;
+  runs[0].start = start;
+  runs[0].end = end;
+  for (idx = 0; idx < width; ++idx)
+    slots[idx] = idx;
+  initExtBitsRetrieval(&extBits);
+  /* every level maps the rows not resolved so far one step to the left
+   * in the text, runs of rows stay runs of rows */
+  while (numRuns > 0)
+  {
+    GtUword runIdx, slotIdx = 0, numNextRuns = 0, numNextSlots = 0,
+      lastRow = GT_UNDEF_UWORD;
+    for (runIdx = 0; runIdx < numRuns; ++runIdx)
+    {
+      GtUword row;
+      for (row = runs[runIdx].start; row < runs[runIdx].end; ++row)
+      {
+        GtUword slot = slots[slotIdx++], pos;
+        Symbol tSym;
+        if (cache != NULL && BWTSeqLocateCacheGet(cache, row, &pos))
+        {
+          positions[slot] = pos + locateOffset;
+          continue;
+        }
+        if (gt_BWTSeqPosHasLocateInfo(bwtSeq, row, &extBits))
+        {
+          positions[slot] = gt_BWTSeqLocateMatch(bwtSeq, row, &extBits)
+            + locateOffset;
+          continue;
+        }
+        tSym = BWTSeqGetTransformedSym(bwtSeq, row);
+        if (!BWTSeqTransformedSymIsValueSorted(bwtSeq, tSym))
+        {
+          positions[slot] = gt_BWTSeqLocateMatch(bwtSeq, row, &extBits)
+            + locateOffset;
+          continue;
+        }
+        if (numNextRuns > 0 && row == lastRow + 1
+            && runSyms[numNextRuns - 1] == tSym)
+          nextRuns[numNextRuns - 1].end = row + 1;
+        else
+        {
+          nextRuns[numNextRuns].start = row;
+          nextRuns[numNextRuns].end = row + 1;
+          runSyms[numNextRuns++] = tSym;
+        }
+        lastRow = row;
+        nextSlots[numNextSlots++] = slot;
+      }
+    }
+    for (runIdx = 0; runIdx < numNextRuns; ++runIdx)
+    {
+      GtUwordPair occ
+        = BWTSeqTransformedPosPairOcc(bwtSeq, runSyms[runIdx],
+                                      nextRuns[runIdx].start,
+                                      nextRuns[runIdx].end);
+      gt_assert(occ.b - occ.a
+                == nextRuns[runIdx].end - nextRuns[runIdx].start);
+      nextRuns[runIdx].start = bwtSeq->count[runSyms[runIdx]] + occ.a;
+      nextRuns[runIdx].end = bwtSeq->count[runSyms[runIdx]] + occ.b;
+    }
+    {
+      struct matchBound *swapRuns = runs;
+      GtUword *swapSlots = slots;
+      runs = nextRuns;
+      nextRuns = swapRuns;
+      slots = nextSlots;
+      nextSlots = swapSlots;
+    }
+    numRuns = numNextRuns;
+    ++locateOffset;
+  }
+  destructExtBitsRetrieval(&extBits);
+  if (cache != NULL)
+  {
+    for (idx = 0; idx < width; ++idx)
+    {
+      cache->rows[(start + idx) & cache->mask] = start + idx;
+      cache->positions[(start + idx) & cache->mask] = positions[idx];
+    }
+  }
+  gt_free(runSpace);
+  gt_free(runSyms);
+  gt_free(slotSpace);
+  return width;
+}
+
 static inline BitOffset
 locateVarBits(const BWTSeq *bwtSeq, struct extBitsRetrieval *extBits)
 {
@@ -838,6 +1007,11 @@ gt_BWTSeqInitLocateHandling(BWTSeq *bwtSeq,
             "Localization of matches will not be supported!");
     bwtSeq->locateSampleInterval = 0;
     bwtSeq->featureToggles = BWTBaseFeatures;
+    /* suffix array samples added later still need the LF-mapping */
+    bwtSeq->bitsPerOrigRank = 0;
+    memcpy(bwtSeq->rangeSort, defaultRangeSort,
+           MRAEncGetNumRanges(bwtSeq->alphabet)
+           * sizeof (defaultRangeSort[0]));
   }
   else
   {
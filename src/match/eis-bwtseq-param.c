@@ -62,6 +62,13 @@ gt_registerPackedIndexOptions(GtOptionParser *op,
     sizeof (GtUword) * CHAR_BIT - 1);
   gt_option_parser_add_option(op, option);
 
+  option = gt_option_new_bool(
+    "irank", "store an additional rank index (.irx) which interleaves symbol "
+    "counts and packed symbols in cache lines\n"
+    "this speeds up searches for DNA at the cost of 2 or 4 bits per symbol",
+    &paramOutput->useInterleavedRank, false);
+  gt_option_parser_add_option(op, option);
+
   gt_registerCtxMapOptions(op, &paramOutput->final.ctxMapILog);
 
   paramOutput->final.projectName = projectName;
@@ -98,6 +105,8 @@ gt_computePackedIndexDefaults(struct bwtOptions *paramOutput, int extraToggles)
   if (paramOutput->final.sourceRankInterval >= 0
       || paramOutput->useSourceRank)
     paramOutput->final.featureToggles |= BWTReversiblySorted;
+  if (paramOutput->useInterleavedRank)
+    paramOutput->final.featureToggles |= BWTInterleavedRank;
   paramOutput->final.featureToggles |= extraToggles;
   paramOutput->final.seqParams.EISFeatureSet
     = gt_convertBWTOptFlags2EISFeatures(paramOutput->defaultOptimizationFlags);
@@ -90,6 +90,9 @@ enum BWTFeatures
                                   *   reverse establishment of context
                                   *   impossible.
                                   */
+  BWTInterleavedRank   = 1 << 3, /**< additionally store an interleaved
+                                  * rank index (see eis-interleavedrank.h)
+                                  * to speed up rank queries for DNA */
 };
 
 /**
@@ -126,6 +129,8 @@ struct bwtOptions
   bool useSourceRank;                   /**< did the user request extra
                                          * information for sort reversing of
                                          * rank-sorted symbols? */
+  bool useInterleavedRank;              /**< did the user request an
+                                         * interleaved rank index? */
  GtOption *useLocateBitmapOption;        /**< used to query wether the
                                          * option was set or left
                                          * unspecified in which case a
@@ -21,6 +21,8 @@
 #include "match/eis-bwtseq.h"
 #include "match/eis-bwtseq-extinfo.h"
 #include "match/eis-encidxseq.h"
+#include "match/eis-interleavedrank.h"
+#include "match/eis-sasample.h"
 #include "match/pckbucket.h"
 
 enum {
@@ -44,6 +46,10 @@ struct BWTSeq
   unsigned bitsPerOrigRank;
   enum rangeSortMode *rangeSort;
   Pckbuckettable *pckbuckettable;
+  InterleavedRankIdx *rankIdx;   /**< NULL unless an interleaved rank
+                                  * index was built for this sequence */
+  SASampleIdx *saSample;         /**< NULL unless suffix array samples
+                                  * were built for this sequence */
 };
 
 struct BWTSeqExactMatchesIterator
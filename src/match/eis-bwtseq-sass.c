@@ -19,6 +19,7 @@
 
 #include "match/eis-bwtseq.h"
 #include "match/eis-bwtseq-context.h"
+#include "match/eis-bwtseq-priv.h"
 #include "match/eis-bwtseq-sass.h"
 #include "match/eis-encidxseq.h"
 #include "match/eis-list-do.h"
@@ -105,6 +106,12 @@ gt_BWTSeqNewSASeqSrc(const BWTSeq *bwtSeq, const BWTSeqContextRetriever *ctxMap)
 {
   struct BWTSASeqSrc *newBWTSASeqSrc;
   gt_assert(bwtSeq);
+  /* without rank sorting of special symbols only the suffix array
+   * samples locate every position */
+  if (!BWTSeqHasLocateInformation(bwtSeq)
+      || (bwtSeq->saSample == NULL
+          && !(bwtSeq->featureToggles & BWTReversiblySorted)))
+    return NULL;
   newBWTSASeqSrc = gt_malloc(sizeof (*newBWTSASeqSrc));
   {
     RandomSeqAccessor origSeqAccess;
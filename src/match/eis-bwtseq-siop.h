@@ -46,6 +46,41 @@ BWTSeqHasLocateInformation(const BWTSeq *bwtSeq)
   return bwtSeq->locateSampleInterval != 0;
 }
 
+/* rank of a transformed symbol in the stored sequence, answered by the
+ * interleaved rank index if there is one for this symbol */
+static inline GtUword
+BWTSeqBaseRank(const BWTSeq *bwtSeq, Symbol tSym, GtUword pos)
+{
+  if (IRIHasRankSym(bwtSeq->rankIdx, tSym))
+    return IRIRank(bwtSeq->rankIdx, tSym, pos);
+  return EISSymTransformedRank(bwtSeq->seqIdx, tSym, pos, bwtSeq->hint);
+}
+
+static inline GtUwordPair
+BWTSeqBasePosPairRank(const BWTSeq *bwtSeq, Symbol tSym, GtUword posA,
+                      GtUword posB)
+{
+  if (IRIHasRankSym(bwtSeq->rankIdx, tSym))
+    return IRIPosPairRank(bwtSeq->rankIdx, tSym, posA, posB);
+  return EISSymTransformedPosPairRank(bwtSeq->seqIdx, tSym, posA, posB,
+                                      bwtSeq->hint);
+}
+
+static inline void
+BWTSeqPrefetchOcc(const BWTSeq *bwtSeq, GtUword pos)
+{
+  if (bwtSeq->rankIdx != NULL)
+    IRIPrefetch(bwtSeq->rankIdx, pos);
+}
+
+static inline Symbol
+BWTSeqGetTransformedSym(const BWTSeq *bwtSeq, GtUword pos)
+{
+  if (bwtSeq->rankIdx != NULL)
+    return IRIGetTransformedSym(bwtSeq->rankIdx, pos);
+  return EISGetTransformedSym(bwtSeq->seqIdx, pos, bwtSeq->hint);
+}
+
 static inline GtUword
 BWTSeqTransformedOcc(const BWTSeq *bwtSeq, Symbol tsym, GtUword pos)
 {
@@ -54,10 +89,10 @@ BWTSeqTransformedOcc(const BWTSeq *bwtSeq, Symbol tsym, GtUword pos)
    * 1. for the symbols mapped to the same value as the terminator
    * 2. for queries of the terminator itself */
   if (tsym < bwtSeq->bwtTerminatorFallback)
-    return EISSymTransformedRank(bwtSeq->seqIdx, tsym, pos, bwtSeq->hint);
+    return BWTSeqBaseRank(bwtSeq, tsym, pos);
   else if (tsym > bwtSeq->bwtTerminatorFallback
            && tsym != bwtSeq->alphabetSize - 1)
-    return EISSymTransformedRank(bwtSeq->seqIdx, tsym, pos, bwtSeq->hint);
+    return BWTSeqBaseRank(bwtSeq, tsym, pos);
   else if (tsym == bwtSeq->bwtTerminatorFallback)
     return EISSymTransformedRank(bwtSeq->seqIdx, tsym, pos, bwtSeq->hint)
       - ((pos > BWTSeqTerminatorPos(bwtSeq))?1:0);
@@ -77,12 +112,10 @@ BWTSeqTransformedPosPairOcc(const BWTSeq *bwtSeq, Symbol tSym,
    * 1. for the symbols mapped to the same value as the terminator
    * 2. for queries of the terminator itself */
   if (tSym < bwtSeq->bwtTerminatorFallback)
-    return EISSymTransformedPosPairRank(bwtSeq->seqIdx, tSym, posA, posB,
-                                        bwtSeq->hint);
+    return BWTSeqBasePosPairRank(bwtSeq, tSym, posA, posB);
   else if (tSym > bwtSeq->bwtTerminatorFallback
            && tSym != bwtSeq->alphabetSize - 1)
-    return EISSymTransformedPosPairRank(bwtSeq->seqIdx, tSym, posA, posB,
-                                        bwtSeq->hint);
+    return BWTSeqBasePosPairRank(bwtSeq, tSym, posA, posB);
   else if (tSym == bwtSeq->bwtTerminatorFallback)
     return EISSymTransformedPosPairRank(bwtSeq->seqIdx, tSym, posA, posB,
                                         bwtSeq->hint);
@@ -181,7 +214,7 @@ static inline GtUword
 BWTSeqLFMap(const BWTSeq *bwtSeq, GtUword LPos,
             struct extBitsRetrieval *extBits)
 {
-  Symbol tSym = EISGetTransformedSym(bwtSeq->seqIdx, LPos, bwtSeq->hint);
+  Symbol tSym = BWTSeqGetTransformedSym(bwtSeq, LPos);
   GtUword FPos;
   const MRAEnc *alphabet = BWTSeqGetAlphabet(bwtSeq);
   if (LPos != BWTSeqTerminatorPos(bwtSeq))
@@ -263,6 +296,9 @@ static inline Symbol
 BWTSeqGetSym(const BWTSeq *bwtSeq, GtUword pos)
 {
   gt_assert(bwtSeq);
+  if (bwtSeq->rankIdx != NULL)
+    return MRAEncRevMapSymbol(EISGetAlphabet(bwtSeq->seqIdx),
+                              IRIGetTransformedSym(bwtSeq->rankIdx, pos));
   return EISGetSym(bwtSeq->seqIdx, pos, bwtSeq->hint);
 }
 
@@ -19,11 +19,16 @@
 #include "match/dataalign.h"
 #include "core/error_api.h"
 #include "core/log.h"
+#include "core/ma_api.h"
+#include "core/minmax_api.h"
 #include "core/str_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "core/undef_api.h"
 #include "core/yarandom_api.h"
+#ifdef GT_THREADS_ENABLED
+#include "core/thread_api.h"
+#endif
 #include "match/eis-bitpackseqpos.h"
 #include "match/eis-bwtseq.h"
 #include "match/eis-bwtseq-extinfo.h"
@@ -31,6 +36,7 @@
 #include "match/eis-bwtseq-priv.h"
 #include "match/eis-bwtseq-context.h"
 #include "match/eis-encidxseq.h"
+#include "match/eis-interleavedrank.h"
 #include "match/eis-mrangealphabet.h"
 #include "match/eis-suffixerator-interface.h"
 #include "match/eis-suffixarray-interface.h"
@@ -125,6 +131,8 @@ gt_newBWTSeq(EISeq *seqIdx, MRAEnc *alphabet,
     * MRAEncGetNumRanges(alphabet);
   bwtSeq = gt_malloc(totalSize);
   bwtSeq->pckbuckettable = NULL;
+  bwtSeq->rankIdx = NULL;
+  bwtSeq->saSample = NULL;
   counts = (GtUword *)((char  *)bwtSeq + countsOffset);
   rangeSort = (enum rangeSortMode *)((char *)bwtSeq + rangeSortOffset);
   if (!initBWTSeqFromEncSeqIdx(bwtSeq, seqIdx, alphabet, counts, rangeSort,
@@ -140,11 +148,36 @@ void
 gt_deleteBWTSeq(BWTSeq *bwtSeq)
 {
   gt_MRAEncDelete(bwtSeq->alphabet);
+  gt_deleteInterleavedRankIdx(bwtSeq->rankIdx);
+  gt_deleteSASampleIdx(bwtSeq->saSample);
   deleteEISHint(bwtSeq->seqIdx, bwtSeq->hint);
   gt_deleteEncIdxSeq(bwtSeq->seqIdx);
   gt_free(bwtSeq);
 }
 
+BWTSeq *
+gt_newBWTSeqView(const BWTSeq *bwtSeq)
+{
+  BWTSeq *view;
+
+  gt_assert(bwtSeq);
+  if (!EISHintsAreIndependent(bwtSeq->seqIdx))
+    return NULL;
+  view = gt_malloc(sizeof (*view));
+  *view = *bwtSeq;
+  view->hint = newEISHint(bwtSeq->seqIdx);
+  return view;
+}
+
+void
+gt_deleteBWTSeqView(BWTSeq *view)
+{
+  if (view == NULL)
+    return;
+  deleteEISHint(view->seqIdx, view->hint);
+  gt_free(view);
+}
+
 typedef struct
 {
   const Mbtab **mbtab;
@@ -159,27 +192,37 @@ static const Mbtab *gt_prebwt_next(GtPrebwtstate *prebwt,unsigned int cc)
   return prebwt->mbtab[prebwt->depth] + prebwt->code;
 }
 
-static inline void
-getMatchBound(const BWTSeq *bwtSeq, const Symbol *query, size_t queryLen,
-              struct matchBound *match, bool forward)
+/* progress of the backward search of one query */
+typedef struct
 {
   const Symbol *qptr, *qend;
+  bool forward;
+} GtBWTSeqMatchState;
+
+/* matches the first symbol of the query and all following symbols
+ * covered by the table of precomputed bounds */
+static inline void
+matchBoundStart(const BWTSeq *bwtSeq, GtBWTSeqMatchState *state,
+                const Symbol *query, size_t queryLen, bool forward,
+                struct matchBound *match)
+{
   unsigned int cc;
   const Mbtab *mbptr;
   GtPrebwtstate prebwt;
 
   gt_assert(bwtSeq && query);
+  state->forward = forward;
   if (forward)
   {
-    qptr = query;
-    qend = query + queryLen;
+    state->qptr = query;
+    state->qend = query + queryLen;
   } else
   {
-    qptr = query + queryLen - 1;
-    qend = query - 1;
+    state->qptr = query + queryLen - 1;
+    state->qend = query - 1;
   }
-  gt_assert(GT_ISNOTSPECIAL(*qptr));
-  cc = (unsigned int) *qptr;
+  gt_assert(GT_ISNOTSPECIAL(*state->qptr));
+  cc = (unsigned int) *state->qptr;
   prebwt.mbtab = gt_bwtseq2mbtab((const FMindex *) bwtSeq);
   if (prebwt.mbtab != NULL)
   {
@@ -199,27 +242,217 @@ getMatchBound(const BWTSeq *bwtSeq, const Symbol *query, size_t queryLen,
     match->start = bwtSeq->count[cc];
     match->end   = bwtSeq->count[cc + 1];
   }
-  qptr = forward ? (qptr+1) : (qptr-1);
-  while (match->start < match->end && qptr != qend)
+  state->qptr = forward ? (state->qptr+1) : (state->qptr-1);
+  while (prebwt.mbtab != NULL && prebwt.depth < prebwt.maxdepth
+         && match->start < match->end && state->qptr != state->qend)
+  {
+    gt_assert(GT_ISNOTSPECIAL(*state->qptr));
+    mbptr = gt_prebwt_next(&prebwt, (unsigned int) *state->qptr);
+    match->start = mbptr->lowerbound;
+    match->end = mbptr->upperbound;
+    state->qptr = forward ? (state->qptr+1) : (state->qptr-1);
+  }
+}
+
+static inline bool
+matchBoundIsFinal(const GtBWTSeqMatchState *state,
+                  const struct matchBound *match)
+{
+  return match->start >= match->end || state->qptr == state->qend;
+}
+
+static inline void
+matchBoundStep(const BWTSeq *bwtSeq, GtBWTSeqMatchState *state,
+               struct matchBound *match)
+{
+  GtUwordPair occPair;
+  unsigned int cc;
+
+  gt_assert(GT_ISNOTSPECIAL(*state->qptr));
+  cc = (unsigned int) *state->qptr;
+  occPair = BWTSeqTransformedPosPairOcc(bwtSeq, (Symbol) cc, match->start,
+                                        match->end);
+  match->start = bwtSeq->count[cc] + occPair.a;
+  match->end   = bwtSeq->count[cc] + occPair.b;
+  state->qptr = state->forward ? (state->qptr+1) : (state->qptr-1);
+}
+
+static inline void
+getMatchBound(const BWTSeq *bwtSeq, const Symbol *query, size_t queryLen,
+              struct matchBound *match, bool forward)
+{
+  GtBWTSeqMatchState state;
+
+  matchBoundStart(bwtSeq, &state, query, queryLen, forward, match);
+  while (!matchBoundIsFinal(&state, match))
+    matchBoundStep(bwtSeq, &state, match);
+}
+
+/* number of queries advanced in lock-step by one thread, the rank
+ * data of one query is prefetched while the others are processed */
+#define GT_BWTSEQ_BATCH_WIDTH 16
+/* do not start a thread for less queries than this */
+#define GT_BWTSEQ_BATCH_MINPERTHREAD 1024UL
+
+typedef struct
+{
+  const BWTSeq *bwtSeq;
+  const Symbol *const *queries;
+  const size_t *queryLens;
+  GtUword from, to;
+  bool forward;
+  struct matchBound *bounds;
+} GtBWTSeqMatchBatch;
+
+static void
+matchBoundsBatchRange(const GtBWTSeqMatchBatch *batch)
+{
+  GtBWTSeqMatchState states[GT_BWTSEQ_BATCH_WIDTH];
+  GtUword slotquery[GT_BWTSEQ_BATCH_WIDTH], nextquery = batch->from;
+  unsigned int slot, activeslots = 0;
+  const BWTSeq *bwtSeq = batch->bwtSeq;
+
+  /* fill the slots, queries which are complete after the table lookup
+   * do not need a slot */
+  for (slot = 0; slot < GT_BWTSEQ_BATCH_WIDTH; slot++)
+  {
+    while (nextquery < batch->to)
+    {
+      struct matchBound *match = batch->bounds + nextquery;
+      matchBoundStart(bwtSeq, states + slot, batch->queries[nextquery],
+                      batch->queryLens[nextquery], batch->forward, match);
+      if (!matchBoundIsFinal(states + slot, match))
+      {
+        BWTSeqPrefetchOcc(bwtSeq, match->start);
+        BWTSeqPrefetchOcc(bwtSeq, match->end);
+        slotquery[slot] = nextquery++;
+        activeslots++;
+        break;
+      }
+      nextquery++;
+    }
+    if (nextquery >= batch->to)
+      break;
+  }
+  for (slot = activeslots; slot < GT_BWTSEQ_BATCH_WIDTH; slot++)
+    slotquery[slot] = GT_UNDEF_UWORD;
+  while (activeslots > 0)
   {
-    GtUwordPair occPair;
+    for (slot = 0; slot < GT_BWTSEQ_BATCH_WIDTH; slot++)
+    {
+      struct matchBound *match;
+      if (slotquery[slot] == GT_UNDEF_UWORD)
+        continue;
+      match = batch->bounds + slotquery[slot];
+      matchBoundStep(bwtSeq, states + slot, match);
+      while (matchBoundIsFinal(states + slot, match))
+      {
+        /* replace the finished query by the next unfinished one */
+        if (nextquery >= batch->to)
+        {
+          slotquery[slot] = GT_UNDEF_UWORD;
+          activeslots--;
+          break;
+        }
+        slotquery[slot] = nextquery;
+        match = batch->bounds + nextquery;
+        matchBoundStart(bwtSeq, states + slot, batch->queries[nextquery],
+                        batch->queryLens[nextquery], batch->forward, match);
+        nextquery++;
+      }
+      if (slotquery[slot] != GT_UNDEF_UWORD)
+      {
+        BWTSeqPrefetchOcc(bwtSeq, match->start);
+        BWTSeqPrefetchOcc(bwtSeq, match->end);
+      }
+    }
+  }
+}
 
-    gt_assert(GT_ISNOTSPECIAL(*qptr));
-    cc = (unsigned int) *qptr;
-    if (prebwt.mbtab != NULL && prebwt.depth < prebwt.maxdepth)
+#ifdef GT_THREADS_ENABLED
+static void *matchBoundsBatchThread(void *data)
+{
+  matchBoundsBatchRange((const GtBWTSeqMatchBatch *) data);
+  return NULL;
+}
+#endif
+
+void
+gt_BWTSeqMatchBoundsBatch(const BWTSeq *bwtSeq, const Symbol *const *queries,
+                          const size_t *queryLens, GtUword numQueries,
+                          bool forward, struct matchBound *bounds)
+{
+  GtBWTSeqMatchBatch batch;
+
+  gt_assert(bwtSeq && (numQueries == 0 || (queries && queryLens && bounds)));
+  batch.bwtSeq = bwtSeq;
+  batch.queries = queries;
+  batch.queryLens = queryLens;
+  batch.forward = forward;
+  batch.bounds = bounds;
+  batch.from = 0;
+  batch.to = numQueries;
+#ifdef GT_THREADS_ENABLED
+  /* the block composition index keeps a cache in the shared hint, so
+   * only the read-only interleaved rank index can be queried by several
+   * threads at once */
+  if (gt_jobs > 1U && bwtSeq->rankIdx != NULL
+      && numQueries >= 2 * GT_BWTSEQ_BATCH_MINPERTHREAD)
+  {
+    GtUword idx, numthreads = GT_MIN((GtUword) gt_jobs,
+                                     numQueries
+                                     / GT_BWTSEQ_BATCH_MINPERTHREAD);
+    GtBWTSeqMatchBatch *parts = gt_malloc(sizeof (*parts) * numthreads);
+    GtThread **threads = gt_malloc(sizeof (*threads) * numthreads);
+
+    for (idx = 0; idx < numthreads; idx++)
     {
-      mbptr = gt_prebwt_next(&prebwt,cc);
-      match->start = mbptr->lowerbound;
-      match->end = mbptr->upperbound;
-    } else
+      parts[idx] = batch;
+      parts[idx].from = numQueries * idx / numthreads;
+      parts[idx].to = numQueries * (idx + 1) / numthreads;
+    }
+    for (idx = 1UL; idx < numthreads; idx++)
+    {
+      threads[idx] = gt_thread_new(matchBoundsBatchThread, parts + idx, NULL);
+      if (threads[idx] == NULL)
+        matchBoundsBatchRange(parts + idx);
+    }
+    matchBoundsBatchRange(parts);
+    for (idx = 1UL; idx < numthreads; idx++)
     {
-      occPair = BWTSeqTransformedPosPairOcc(bwtSeq, (Symbol) cc, match->start,
-                                            match->end);
-      match->start = bwtSeq->count[cc] + occPair.a;
-      match->end   = bwtSeq->count[cc] + occPair.b;
+      if (threads[idx] != NULL)
+      {
+        gt_thread_join(threads[idx]);
+        gt_thread_delete(threads[idx]);
+      }
     }
-    qptr = forward ? (qptr+1) : (qptr-1);
+    gt_free(threads);
+    gt_free(parts);
+  }
+  else
+#endif
+  {
+    matchBoundsBatchRange(&batch);
+  }
+}
+
+GtUword
+gt_BWTSeqLocateBatch(const BWTSeq *bwtSeq, const struct matchBound *bounds,
+                     GtUword numBounds, GtUword *positions,
+                     BWTSeqLocateCache *cache)
+{
+  GtUword idx, numPositions = 0;
+
+  gt_assert(bwtSeq && BWTSeqHasLocateInformation(bwtSeq));
+  for (idx = 0; idx < numBounds; idx++)
+  {
+    if (bounds[idx].start < bounds[idx].end)
+      numPositions += gt_BWTSeqLocateInterval(bwtSeq, bounds[idx].start,
+                                              bounds[idx].end,
+                                              positions + numPositions,
+                                              cache);
   }
+  return numPositions;
 }
 
 GtUword gt_packedindexuniqueforward(const BWTSeq *bwtSeq,
@@ -64,6 +64,9 @@ typedef struct BWTSeq BWTSeq;
  * sequence index */
 typedef struct BWTSeqExactMatchesIterator BWTSeqExactMatchesIterator;
 
+/** Cache of suffix array values of recently located rows */
+typedef struct BWTSeqLocateCache BWTSeqLocateCache;
+
 /**
  * \brief Creates or loads an encoded indexed sequence object of the
  * BWT transform.
@@ -106,6 +109,24 @@ gt_loadBWTSeq(const char *projectName, int BWTOptFlags, GtLogger *verbosity,
 void
 gt_deleteBWTSeq(BWTSeq *bwtseq);
 
+/**
+ * \brief Create a view of a BWT sequence object which shares all index
+ * data with bwtSeq but uses a query hint of its own. Queries to
+ * distinct views can be issued from different threads at once.
+ * @param bwtSeq reference of object to share the index data of
+ * @return new view, which must not outlive bwtSeq, or NULL if the
+ * underlying sequence index cannot be queried concurrently
+ */
+BWTSeq *
+gt_newBWTSeqView(const BWTSeq *bwtSeq);
+
+/**
+ * \brief Deallocate a view created with gt_newBWTSeqView.
+ * @param view reference of object to delete
+ */
+void
+gt_deleteBWTSeqView(BWTSeq *view);
+
 /**
  * \brief Query BWT sequence object for availability of added
  * information to locate matches.
@@ -301,6 +322,84 @@ GtUword
 gt_BWTSeqMatchCount(const BWTSeq *bwtSeq, const Symbol *query, size_t queryLen,
                  bool forward);
 
+/**
+ * \brief Given a batch of query strings find the intervals of their
+ * matches in the suffix array.
+ *
+ * The backward searches of several queries are advanced in lock-step,
+ * so that the rank data needed by the next step of one query is
+ * prefetched while the other queries are processed. If the index has
+ * an interleaved rank index (see eis-interleavedrank.h), the batch is
+ * divided among gt_jobs threads.
+ * @param bwtSeq reference of object to query
+ * @param queries queries[i] is the symbol string of query i, it must
+ * not contain special symbols
+ * @param queryLens queryLens[i] is the length of queries[i], at least 1
+ * @param numQueries number of queries
+ * @param forward direction of processing the queries
+ * @param bounds bounds[i] receives the interval of matches of query i,
+ * which is empty if bounds[i].start >= bounds[i].end
+ */
+void
+gt_BWTSeqMatchBoundsBatch(const BWTSeq *bwtSeq, const Symbol *const *queries,
+                          const size_t *queryLens, GtUword numQueries,
+                          bool forward, struct matchBound *bounds);
+
+/**
+ * \brief Locate all rows of the suffix array interval [start, end).
+ *
+ * Neighbouring rows preceded by the same symbol are LF-mapped to
+ * neighbouring rows again, so instead of walking back from every row
+ * separately, such runs of rows are mapped together by two rank
+ * queries until every row has reached a sampled position. Requires
+ * locate information.
+ * @param bwtSeq reference of object to query
+ * @param start first row of the interval
+ * @param end row following the interval
+ * @param positions receives the positions of the rows in suffix array
+ * order, must have room for end - start values
+ * @param cache results of earlier calls to reuse and to update with
+ * the rows of this interval, may be NULL
+ * @return number of positions stored
+ */
+GtUword
+gt_BWTSeqLocateInterval(const BWTSeq *bwtSeq, GtUword start, GtUword end,
+                        GtUword *positions, BWTSeqLocateCache *cache);
+
+/**
+ * \brief Locate all matches of a batch of suffix array intervals as
+ * computed by gt_BWTSeqMatchBoundsBatch. Requires locate information.
+ * @param bwtSeq reference of object to query
+ * @param bounds intervals to locate
+ * @param numBounds number of intervals
+ * @param positions receives the positions of the matches of bounds[0]
+ * in suffix array order, followed by those of bounds[1] and so on, must
+ * have room for the sum of the interval sizes
+ * @param cache see gt_BWTSeqLocateInterval, may be NULL
+ * @return number of positions stored
+ */
+GtUword
+gt_BWTSeqLocateBatch(const BWTSeq *bwtSeq, const struct matchBound *bounds,
+                     GtUword numBounds, GtUword *positions,
+                     BWTSeqLocateCache *cache);
+
+/**
+ * \brief Create a cache for gt_BWTSeqLocateInterval, which keeps the
+ * suffix array value of one row per slot, rows are assigned to slots by
+ * their lowest bits.
+ * @param sizeLog2 logarithm of the number of slots
+ * @return new cache object
+ */
+BWTSeqLocateCache *
+gt_newBWTSeqLocateCache(unsigned sizeLog2);
+
+/**
+ * \brief Deallocate a cache object.
+ * @param cache reference of object to delete
+ */
+void
+gt_deleteBWTSeqLocateCache(BWTSeqLocateCache *cache);
+
 /**
  * \brief Given a pair of limiting positions in the suffix array and a
  * symbol, compute the interval reached by matching one symbol further.
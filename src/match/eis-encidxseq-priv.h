@@ -40,6 +40,7 @@ struct encIdxSeqClass
                    union EISHint *hint);
   Symbol (*get)(EISeq *seq, GtUword pos, EISHint hint);
   union EISHint *(*newHint)(const EISeq *seq);
+  bool (*hintsAreIndependent)(const EISeq *seq);
   void (*deleteHint)(EISeq *seq, EISHint hint);
   const MRAEnc *(*getAlphabet)(const EISeq *seq);
   void (*expose)(EISeq *seq, GtUword pos, int persistent,
@@ -158,6 +158,15 @@ newEISHint(const EISeq *seq)
   return seq->classInfo->newHint(seq);
 }
 
+static inline bool
+EISHintsAreIndependent(const EISeq *seq)
+{
+  if (seq->classInfo->hintsAreIndependent)
+    return seq->classInfo->hintsAreIndependent(seq);
+  else
+    return false;
+}
+
 static inline void
 deleteEISHint(EISeq *seq, EISHint hint)
 {
@@ -358,6 +358,15 @@ EISGetTransformedSym(EISeq *seq, GtUword pos, EISHint hint);
 static inline EISHint
 newEISHint(const EISeq *seq);
 
+/**
+ * \brief Tell whether queries to seq which use distinct hints may be
+ * issued concurrently by several threads.
+ * @param seq reference of sequence object to use
+ * @return true if all state modified by queries is kept in the hint
+ */
+static inline bool
+EISHintsAreIndependent(const EISeq *seq);
+
 /**
  * Deallocate hinting data.
  * @param seq sequence associated
@@ -0,0 +1,173 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef EIS_INTERLEAVEDRANK_PRIV_H
+#define EIS_INTERLEAVEDRANK_PRIV_H
+
+#include <inttypes.h>
+#include "core/assert_api.h"
+#include "match/eis-interleavedrank.h"
+
+enum {
+  IRI_MAX_RANK_SYMS = 4,
+  IRI_LINE_WORDS = 6,
+  IRI_SYMS_PER_LINE_2 = IRI_LINE_WORDS * 32,
+  IRI_SYMS_PER_LINE_4 = IRI_LINE_WORDS * 16,
+  /* the counts of a line are relative to its superblock, 2^22 lines
+   * hold less than 2^32 symbols even with 2 bits per symbol */
+  IRI_SUPERBLOCK_LINES_LOG = 22,
+};
+
+#define IRI_LOW_BITS_2 ((uint64_t) 0x5555555555555555ULL)
+#define IRI_LOW_BITS_4 ((uint64_t) 0x1111111111111111ULL)
+
+/* one line of 64 bytes: counts of the regular symbols before the
+ * line, followed by the packed symbols of the line, least significant
+ * bits first */
+struct interleavedRankLine
+{
+  uint32_t counts[IRI_MAX_RANK_SYMS];
+  uint64_t syms[IRI_LINE_WORDS];
+};
+
+struct interleavedRankIdx
+{
+  const struct interleavedRankLine *lines;
+  const uint64_t *superBlockCounts; /* IRI_MAX_RANK_SYMS per superblock */
+  void *mapping;
+  GtUword seqLen,
+          termPos;                  /* position of the terminator, in the
+                                     * 2 bit variant it is stored as 0 */
+  Symbol termSym;
+  unsigned symBits,
+           numRankSyms;
+};
+
+static inline unsigned
+IRIBitCount64(uint64_t v)
+{
+#if defined (__GNUC__) && defined (__POPCNT__)
+  return (unsigned) __builtin_popcountll(v);
+#else
+  v = v - ((v >> 1) & (uint64_t) 0x5555555555555555ULL);
+  v = (v & (uint64_t) 0x3333333333333333ULL)
+      + ((v >> 2) & (uint64_t) 0x3333333333333333ULL);
+  return (unsigned) ((((v + (v >> 4)) & (uint64_t) 0x0F0F0F0F0F0F0F0FULL)
+                      * (uint64_t) 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/* returns a word with the lowest bit of every symbol equal to tSym set */
+static inline uint64_t
+IRIMatchMask(uint64_t word, Symbol tSym, unsigned symBits)
+{
+  uint64_t x;
+  if (symBits == 2U)
+  {
+    x = word ^ ((uint64_t) tSym * IRI_LOW_BITS_2);
+    return ~(x | (x >> 1)) & IRI_LOW_BITS_2;
+  }
+  x = word ^ ((uint64_t) tSym * IRI_LOW_BITS_4);
+  x |= x >> 1;
+  x |= x >> 2;
+  return ~x & IRI_LOW_BITS_4;
+}
+
+static inline GtUword
+IRIPos2Line(const InterleavedRankIdx *rankIdx, GtUword pos,
+            unsigned *inLinePos)
+{
+  /* separate constant divisors avoid a real division */
+  if (rankIdx->symBits == 2U)
+  {
+    *inLinePos = (unsigned) (pos % IRI_SYMS_PER_LINE_2);
+    return pos / IRI_SYMS_PER_LINE_2;
+  }
+  *inLinePos = (unsigned) (pos % IRI_SYMS_PER_LINE_4);
+  return pos / IRI_SYMS_PER_LINE_4;
+}
+
+static inline bool
+IRIHasRankSym(const InterleavedRankIdx *rankIdx, Symbol tSym)
+{
+  return rankIdx != NULL && tSym < rankIdx->numRankSyms;
+}
+
+static inline GtUword
+IRIRank(const InterleavedRankIdx *rankIdx, Symbol tSym, GtUword pos)
+{
+  const struct interleavedRankLine *line;
+  GtUword lineNum, rank;
+  unsigned inLinePos, symBits = rankIdx->symBits,
+           symsPerWord = 64U / symBits, wordNum, lastWord, rest;
+  gt_assert(IRIHasRankSym(rankIdx, tSym) && pos <= rankIdx->seqLen);
+  lineNum = IRIPos2Line(rankIdx, pos, &inLinePos);
+  line = rankIdx->lines + lineNum;
+  rank = rankIdx->superBlockCounts[(lineNum >> IRI_SUPERBLOCK_LINES_LOG)
+                                   * IRI_MAX_RANK_SYMS + tSym]
+         + line->counts[tSym];
+  lastWord = inLinePos / symsPerWord;
+  rest = inLinePos % symsPerWord;
+  for (wordNum = 0; wordNum < lastWord; ++wordNum)
+    rank += IRIBitCount64(IRIMatchMask(line->syms[wordNum], tSym, symBits));
+  if (rest > 0)
+    rank += IRIBitCount64(IRIMatchMask(line->syms[lastWord], tSym, symBits)
+                          & ((((uint64_t) 1) << (rest * symBits)) - 1));
+  if (symBits == 2U && tSym == 0 && rankIdx->termPos < pos
+      && rankIdx->termPos >= pos - inLinePos)
+    --rank;
+  return rank;
+}
+
+static inline void
+IRIPrefetch(const InterleavedRankIdx *rankIdx, GtUword pos)
+{
+#ifdef __GNUC__
+  unsigned inLinePos;
+  __builtin_prefetch(rankIdx->lines + IRIPos2Line(rankIdx, pos, &inLinePos));
+#else
+  (void) rankIdx;
+  (void) pos;
+#endif
+}
+
+static inline GtUwordPair
+IRIPosPairRank(const InterleavedRankIdx *rankIdx, Symbol tSym,
+               GtUword posA, GtUword posB)
+{
+  GtUwordPair occ;
+  gt_assert(posA <= posB);
+  occ.a = IRIRank(rankIdx, tSym, posA);
+  occ.b = IRIRank(rankIdx, tSym, posB);
+  return occ;
+}
+
+static inline Symbol
+IRIGetTransformedSym(const InterleavedRankIdx *rankIdx, GtUword pos)
+{
+  const struct interleavedRankLine *line;
+  unsigned inLinePos, symBits = rankIdx->symBits,
+           symsPerWord = 64U / symBits;
+  gt_assert(pos < rankIdx->seqLen);
+  if (symBits == 2U && pos == rankIdx->termPos)
+    return rankIdx->termSym;
+  line = rankIdx->lines + IRIPos2Line(rankIdx, pos, &inLinePos);
+  return (Symbol) ((line->syms[inLinePos / symsPerWord]
+                    >> ((inLinePos % symsPerWord) * symBits))
+                   & ((((uint64_t) 1) << symBits) - 1));
+}
+
+#endif
@@ -0,0 +1,248 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/fa_api.h"
+#include "core/ma_api.h"
+#include "core/str_api.h"
+#include "core/xansi_api.h"
+#include "match/eis-interleavedrank.h"
+#include "match/eis-mrangealphabet.h"
+
+struct interleavedRankHeader
+{
+  uint64_t seqLen,
+           termPos,
+           termSym,
+           symBits,
+           numRankSyms,
+           numLines,
+           numSuperBlocks,
+           reserved;
+};
+
+static GtUword
+iriNumOfLines(GtUword seqLen, unsigned symBits)
+{
+  /* one extra line answers queries for position seqLen */
+  return seqLen / (symBits == 2U ? IRI_SYMS_PER_LINE_2
+                                 : IRI_SYMS_PER_LINE_4) + 1;
+}
+
+static GtUword
+iriNumOfSuperBlocks(GtUword numLines)
+{
+  return ((numLines - 1) >> IRI_SUPERBLOCK_LINES_LOG) + 1;
+}
+
+static GtStr *
+iriFileName(const char *projectName)
+{
+  GtStr *irxName = gt_str_new_cstr(projectName);
+  gt_str_append_cstr(irxName, IRI_FILE_SUFFIX);
+  return irxName;
+}
+
+int
+gt_writeInterleavedRankIdx(EISeq *seqIdx, EISHint hint, GtUword termPos,
+                           const char *projectName, GtError *err)
+{
+  const MRAEnc *alphabet;
+  struct interleavedRankHeader header;
+  GtUword seqLen, regularSyms = 0, pos = 0, lineNum, numLines,
+          numSuperBlocks, counts[IRI_MAX_RANK_SYMS],
+          superBlockBase[IRI_MAX_RANK_SYMS];
+  uint64_t *superBlockCounts;
+  unsigned numRankSyms, symBits, symsPerLine, symsPerWord;
+  Symbol sym;
+  GtStr *irxName;
+  FILE *fp;
+
+  gt_error_check(err);
+  gt_assert(seqIdx && hint && projectName);
+  alphabet = EISGetAlphabet(seqIdx);
+  seqLen = EISLength(seqIdx);
+  numRankSyms = MRAEncGetRangeSize(alphabet, 0);
+  if (numRankSyms > (unsigned) IRI_MAX_RANK_SYMS)
+  {
+    gt_error_set(err, "interleaved rank index requires an alphabet with at "
+                 "most %d regular symbols, but it has %u",
+                 IRI_MAX_RANK_SYMS, numRankSyms);
+    return -1;
+  }
+  gt_assert(termPos < seqLen);
+  for (sym = 0; sym < (Symbol) numRankSyms; sym++)
+    regularSyms += EISSymTransformedRank(seqIdx, sym, seqLen, hint);
+  if (regularSyms + 1 == seqLen)
+    symBits = 2U;
+  else if (gt_MRAEncGetSize(alphabet) <= 16U)
+    symBits = 4U;
+  else
+  {
+    gt_error_set(err, "interleaved rank index requires an alphabet of at "
+                 "most 16 symbols, but it has %u",
+                 (unsigned) gt_MRAEncGetSize(alphabet));
+    return -1;
+  }
+  symsPerLine = symBits == 2U ? IRI_SYMS_PER_LINE_2 : IRI_SYMS_PER_LINE_4;
+  symsPerWord = 64U / symBits;
+  numLines = iriNumOfLines(seqLen, symBits);
+  numSuperBlocks = iriNumOfSuperBlocks(numLines);
+
+  irxName = iriFileName(projectName);
+  fp = gt_fa_fopen(gt_str_get(irxName), "wb", err);
+  gt_str_delete(irxName);
+  if (fp == NULL)
+    return -1;
+  memset(&header, 0, sizeof (header));
+  header.seqLen = (uint64_t) seqLen;
+  header.termPos = (uint64_t) termPos;
+  header.termSym = (uint64_t) EISGetTransformedSym(seqIdx, termPos, hint);
+  header.symBits = (uint64_t) symBits;
+  header.numRankSyms = (uint64_t) numRankSyms;
+  header.numLines = (uint64_t) numLines;
+  header.numSuperBlocks = (uint64_t) numSuperBlocks;
+  gt_xfwrite(&header, sizeof (header), (size_t) 1, fp);
+
+  superBlockCounts = gt_calloc((size_t) numSuperBlocks * IRI_MAX_RANK_SYMS,
+                               sizeof (*superBlockCounts));
+  memset(counts, 0, sizeof (counts));
+  memset(superBlockBase, 0, sizeof (superBlockBase));
+  for (lineNum = 0; lineNum < numLines; lineNum++)
+  {
+    struct interleavedRankLine line;
+    unsigned inLinePos;
+
+    if ((lineNum & ((1UL << IRI_SUPERBLOCK_LINES_LOG) - 1)) == 0)
+    {
+      for (sym = 0; sym < (Symbol) IRI_MAX_RANK_SYMS; sym++)
+      {
+        superBlockCounts[(lineNum >> IRI_SUPERBLOCK_LINES_LOG)
+                         * IRI_MAX_RANK_SYMS + sym] = (uint64_t) counts[sym];
+        superBlockBase[sym] = counts[sym];
+      }
+    }
+    memset(&line, 0, sizeof (line));
+    for (sym = 0; sym < (Symbol) IRI_MAX_RANK_SYMS; sym++)
+      line.counts[sym] = (uint32_t) (counts[sym] - superBlockBase[sym]);
+    for (inLinePos = 0; inLinePos < symsPerLine && pos < seqLen;
+         inLinePos++, pos++)
+    {
+      sym = EISGetTransformedSym(seqIdx, pos, hint);
+      if (sym < (Symbol) numRankSyms)
+        counts[sym]++;
+      else if (symBits == 2U)
+      {
+        gt_assert(pos == termPos);
+        sym = 0;
+      }
+      line.syms[inLinePos / symsPerWord]
+        |= (uint64_t) sym << ((inLinePos % symsPerWord) * symBits);
+    }
+    gt_xfwrite(&line, sizeof (line), (size_t) 1, fp);
+  }
+  gt_xfwrite(superBlockCounts, sizeof (*superBlockCounts),
+             (size_t) numSuperBlocks * IRI_MAX_RANK_SYMS, fp);
+  gt_free(superBlockCounts);
+  gt_fa_xfclose(fp);
+  return 0;
+}
+
+InterleavedRankIdx *
+gt_loadInterleavedRankIdx(const char *projectName, EISeq *seqIdx,
+                          EISHint hint, GtError *err)
+{
+  InterleavedRankIdx *rankIdx = NULL;
+  const struct interleavedRankHeader *header;
+  GtStr *irxName;
+  void *mapping;
+  size_t mappedLen = 0;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(projectName && seqIdx && hint);
+  irxName = iriFileName(projectName);
+  mapping = gt_fa_mmap_read(gt_str_get(irxName), &mappedLen, err);
+  if (mapping == NULL)
+  {
+    gt_str_delete(irxName);
+    return NULL;
+  }
+  header = mapping;
+  if (mappedLen < sizeof (*header)
+      || (header->symBits != 2 && header->symBits != 4)
+      || header->numRankSyms > IRI_MAX_RANK_SYMS
+      || header->numLines != iriNumOfLines((GtUword) header->seqLen,
+                                           (unsigned) header->symBits)
+      || header->numSuperBlocks
+         != iriNumOfSuperBlocks((GtUword) header->numLines)
+      || mappedLen != sizeof (*header)
+                      + header->numLines * sizeof (struct interleavedRankLine)
+                      + header->numSuperBlocks * IRI_MAX_RANK_SYMS
+                        * sizeof (uint64_t))
+  {
+    gt_error_set(err, "interleaved rank index %s is corrupt",
+                 gt_str_get(irxName));
+    had_err = -1;
+  }
+  if (!had_err)
+  {
+    rankIdx = gt_malloc(sizeof (*rankIdx));
+    rankIdx->mapping = mapping;
+    rankIdx->lines = (const struct interleavedRankLine *) (header + 1);
+    rankIdx->superBlockCounts
+      = (const uint64_t *) (rankIdx->lines + header->numLines);
+    rankIdx->seqLen = (GtUword) header->seqLen;
+    rankIdx->termPos = (GtUword) header->termPos;
+    rankIdx->termSym = (Symbol) header->termSym;
+    rankIdx->symBits = (unsigned) header->symBits;
+    rankIdx->numRankSyms = (unsigned) header->numRankSyms;
+    if (rankIdx->seqLen != EISLength(seqIdx)
+        || rankIdx->numRankSyms
+           != MRAEncGetRangeSize(EISGetAlphabet(seqIdx), 0))
+      had_err = -1;
+    else
+    {
+      Symbol sym;
+      for (sym = 0; !had_err && sym < (Symbol) rankIdx->numRankSyms; sym++)
+      {
+        if (IRIRank(rankIdx, sym, rankIdx->seqLen)
+            != EISSymTransformedRank(seqIdx, sym, rankIdx->seqLen, hint))
+          had_err = -1;
+      }
+    }
+    if (had_err)
+    {
+      gt_error_set(err, "interleaved rank index %s does not match the "
+                   "sequence index", gt_str_get(irxName));
+      gt_free(rankIdx);
+      rankIdx = NULL;
+    }
+  }
+  if (had_err)
+    gt_fa_xmunmap(mapping);
+  gt_str_delete(irxName);
+  return rankIdx;
+}
+
+void
+gt_deleteInterleavedRankIdx(InterleavedRankIdx *rankIdx)
+{
+  if (rankIdx == NULL)
+    return;
+  gt_fa_xmunmap(rankIdx->mapping);
+  gt_free(rankIdx);
+}
@@ -0,0 +1,108 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef EIS_INTERLEAVEDRANK_H
+#define EIS_INTERLEAVEDRANK_H
+
+/**
+ * \file eis-interleavedrank.h
+ * Rank index for small alphabets which stores the cumulative symbol
+ * counts together with the packed symbols of one cache line, so that
+ * a rank query for a regular symbol touches a single line of memory.
+ */
+
+#include "core/error_api.h"
+#include "core/types_api.h"
+#include "match/eis-encidxseq.h"
+
+/** file name suffix of an interleaved rank index */
+#define IRI_FILE_SUFFIX ".irx"
+
+typedef struct interleavedRankIdx InterleavedRankIdx;
+
+/**
+ * @brief Writes an interleaved rank index for the sequence stored in
+ * seqIdx to file projectName.irx.
+ *
+ * Only the regular symbols (range 0 of the alphabet of seqIdx) are
+ * accelerated, of which there may be at most four. Symbols are stored
+ * with 2 bits if all positions except termPos hold a regular symbol
+ * and with 4 bits otherwise, which requires an alphabet of at most 16
+ * symbols.
+ * @param seqIdx sequence to build the rank index for
+ * @param hint hint to use for sequential access to seqIdx
+ * @param termPos position of the terminator in seqIdx
+ * @param projectName base name of the index file
+ * @param err
+ * @return 0 on success, -1 on error
+ */
+int
+gt_writeInterleavedRankIdx(EISeq *seqIdx, EISHint hint, GtUword termPos,
+                           const char *projectName, GtError *err);
+
+/**
+ * @brief Maps the interleaved rank index projectName.irx into memory.
+ * @param projectName base name of the index file
+ * @param seqIdx sequence the rank index was built for, used to validate
+ * the stored counts
+ * @param hint hint to use for queries to seqIdx
+ * @param err
+ * @return new rank index object or NULL on error
+ */
+InterleavedRankIdx *
+gt_loadInterleavedRankIdx(const char *projectName, EISeq *seqIdx,
+                          EISHint hint, GtError *err);
+
+void
+gt_deleteInterleavedRankIdx(InterleavedRankIdx *rankIdx);
+
+/**
+ * @return true if rank queries for the transformed symbol tSym can be
+ * answered by rankIdx
+ */
+static inline bool
+IRIHasRankSym(const InterleavedRankIdx *rankIdx, Symbol tSym);
+
+/**
+ * @brief Return number of occurrences of transformed symbol tSym up to
+ * but not including position pos. Requires IRIHasRankSym(rankIdx, tSym).
+ */
+static inline GtUword
+IRIRank(const InterleavedRankIdx *rankIdx, Symbol tSym, GtUword pos);
+
+/**
+ * @brief As IRIRank but for both bounds posA <= posB of an interval.
+ */
+static inline GtUwordPair
+IRIPosPairRank(const InterleavedRankIdx *rankIdx, Symbol tSym,
+               GtUword posA, GtUword posB);
+
+/**
+ * @brief Starts loading the line needed for rank queries at position
+ * pos into the cache, without waiting for it.
+ */
+static inline void
+IRIPrefetch(const InterleavedRankIdx *rankIdx, GtUword pos);
+
+/**
+ * @return transformed symbol stored at position pos
+ */
+static inline Symbol
+IRIGetTransformedSym(const InterleavedRankIdx *rankIdx, GtUword pos);
+
+#include "match/eis-interleavedrank-priv.h"
+
+#endif
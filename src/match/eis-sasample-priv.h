@@ -0,0 +1,79 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef EIS_SASAMPLE_PRIV_H
+#define EIS_SASAMPLE_PRIV_H
+
+#include <inttypes.h>
+#include "core/assert_api.h"
+#include "core/bitpackstring.h"
+#include "match/eis-bitpackseqpos.h"
+#include "match/eis-sasample.h"
+
+enum {
+  /* the number of marks before every block of 2^9 positions is stored
+   * explicitly, the remainder is counted in the mark bit string */
+  SSI_RANK_BLOCK_LOG = 9,
+};
+
+struct saSampleIdx
+{
+  const uint64_t *blockRanks;  /* marks before each block */
+  constBitString marks,        /* one bit per BWT position */
+                 samples;      /* bitsPerSample bits per marked position */
+  void *mapping;
+  GtUword seqLen,
+          rot0Pos;
+  unsigned sampleRate,
+           bitsPerSample;
+};
+
+static inline unsigned
+SSISampleRate(const SASampleIdx *saSample)
+{
+  gt_assert(saSample);
+  return saSample->sampleRate;
+}
+
+static inline GtUword
+SSIRot0Pos(const SASampleIdx *saSample)
+{
+  gt_assert(saSample);
+  return saSample->rot0Pos;
+}
+
+static inline bool
+SSIIsSampled(const SASampleIdx *saSample, GtUword pos)
+{
+  gt_assert(saSample && pos < saSample->seqLen);
+  return gt_bsGetBit(saSample->marks, pos) != 0;
+}
+
+static inline GtUword
+SSIGetSample(const SASampleIdx *saSample, GtUword pos)
+{
+  GtUword blockStart, sampleIdx;
+  gt_assert(SSIIsSampled(saSample, pos));
+  blockStart = (pos >> SSI_RANK_BLOCK_LOG) << SSI_RANK_BLOCK_LOG;
+  sampleIdx = (GtUword) saSample->blockRanks[pos >> SSI_RANK_BLOCK_LOG]
+              + (GtUword) gt_bs1BitsCount(saSample->marks, blockStart,
+                                          pos - blockStart);
+  return gt_bsGetUlong(saSample->samples,
+                       (BitOffset) sampleIdx * saSample->bitsPerSample,
+                       saSample->bitsPerSample);
+}
+
+#endif
@@ -0,0 +1,241 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <limits.h>
+#include <string.h>
+#include "core/arraydef_api.h"
+#include "core/fa_api.h"
+#include "core/fileutils_api.h"
+#include "core/ma_api.h"
+#include "core/minmax_api.h"
+#include "core/str_api.h"
+#include "core/undef_api.h"
+#include "core/xansi_api.h"
+#include "match/eis-bwtseq.h"
+#include "match/eis-bwtseq-priv.h"
+#include "match/eis-mrangealphabet.h"
+#include "match/eis-sasample.h"
+
+struct saSampleHeader
+{
+  uint64_t seqLen,
+           rot0Pos,
+           sampleRate,
+           bitsPerSample,
+           numSamples,
+           numRankBlocks,
+           reserved[2];
+};
+
+enum {
+  SSI_READ_BUFFER_SIZE = 4096,
+};
+
+static GtUword
+ssiNumOfRankBlocks(GtUword seqLen)
+{
+  return (seqLen >> SSI_RANK_BLOCK_LOG) + 1;
+}
+
+static GtStr *
+ssiFileName(const char *projectName)
+{
+  GtStr *ssxName = gt_str_new_cstr(projectName);
+  gt_str_append_cstr(ssxName, SSI_FILE_SUFFIX);
+  return ssxName;
+}
+
+/* LF-mapping is only done by symbol counts, rows with symbols needing
+ * anything else must be sampled */
+static bool
+ssiPosRequiresSample(const BWTSeq *bwtSeq, GtUword pos)
+{
+  Symbol tSym = BWTSeqGetTransformedSym(bwtSeq, pos);
+  return tSym == bwtSeq->bwtTerminatorFallback
+    || bwtSeq->rangeSort[MRAEncGetRangeOfSymbol(bwtSeq->alphabet, tSym)]
+       != SORTMODE_VALUE;
+}
+
+int
+gt_writeSASampleIdx(const BWTSeq *bwtSeq, SeqDataReader readSfxIdx,
+                    unsigned sampleRate, const char *projectName,
+                    GtError *err)
+{
+  struct saSampleHeader header;
+  GtUword seqLen, pos = 0, numRankBlocks, rot0Pos = GT_UNDEF_UWORD,
+          buf[SSI_READ_BUFFER_SIZE];
+  GtArrayGtUword sampleValues;
+  BitString marks, samples;
+  uint64_t *blockRanks;
+  unsigned bitsPerSample;
+  size_t marksSize, samplesSize;
+  GtStr *ssxName;
+  FILE *fp = NULL;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(bwtSeq && projectName && sampleRate > 0);
+  seqLen = BWTSeqLength(bwtSeq);
+  numRankBlocks = ssiNumOfRankBlocks(seqLen);
+  bitsPerSample = requiredUlongBits(seqLen - 1);
+  marksSize = bitElemsAllocSize(seqLen);
+  marks = gt_calloc(marksSize, sizeof (*marks));
+  blockRanks = gt_malloc(sizeof (*blockRanks) * numRankBlocks);
+  GT_INITARRAY(&sampleValues, GtUword);
+  while (!had_err && pos < seqLen)
+  {
+    GtUword idx, len = GT_MIN((GtUword) SSI_READ_BUFFER_SIZE, seqLen - pos);
+    if (SDRRead(readSfxIdx, buf, len) != len)
+    {
+      gt_error_set(err, "short read of suffix array values when sampling "
+                   "position " GT_WU, pos);
+      had_err = -1;
+      break;
+    }
+    for (idx = 0; idx < len; idx++, pos++)
+    {
+      if ((pos & ((1UL << SSI_RANK_BLOCK_LOG) - 1)) == 0)
+        blockRanks[pos >> SSI_RANK_BLOCK_LOG]
+          = (uint64_t) sampleValues.nextfreeGtUword;
+      if (buf[idx] == 0)
+        rot0Pos = pos;
+      if (buf[idx] % sampleRate == 0 || ssiPosRequiresSample(bwtSeq, pos))
+      {
+        bsSetBit(marks, pos);
+        GT_STOREINARRAY(&sampleValues, GtUword, 128, buf[idx]);
+      }
+    }
+  }
+  if (!had_err && rot0Pos == GT_UNDEF_UWORD)
+  {
+    gt_error_set(err, "suffix array values do not contain position 0");
+    had_err = -1;
+  }
+  if (!had_err)
+  {
+    GtUword idx;
+    if ((seqLen & ((1UL << SSI_RANK_BLOCK_LOG) - 1)) == 0)
+      blockRanks[seqLen >> SSI_RANK_BLOCK_LOG]
+        = (uint64_t) sampleValues.nextfreeGtUword;
+    samplesSize = bitElemsAllocSize((BitOffset) sampleValues.nextfreeGtUword
+                                    * bitsPerSample);
+    samples = gt_calloc(samplesSize, sizeof (*samples));
+    for (idx = 0; idx < sampleValues.nextfreeGtUword; idx++)
+      gt_bsStoreUlong(samples, (BitOffset) idx * bitsPerSample, bitsPerSample,
+                      sampleValues.spaceGtUword[idx]);
+
+    /* the old table may still be mapped by bwtSeq, so it is replaced by
+     * a new file instead of being overwritten */
+    ssxName = ssiFileName(projectName);
+    if (gt_file_exists(gt_str_get(ssxName)))
+      gt_xremove(gt_str_get(ssxName));
+    fp = gt_fa_fopen(gt_str_get(ssxName), "wb", err);
+    gt_str_delete(ssxName);
+    if (fp == NULL)
+      had_err = -1;
+    else
+    {
+      memset(&header, 0, sizeof (header));
+      header.seqLen = (uint64_t) seqLen;
+      header.rot0Pos = (uint64_t) rot0Pos;
+      header.sampleRate = (uint64_t) sampleRate;
+      header.bitsPerSample = (uint64_t) bitsPerSample;
+      header.numSamples = (uint64_t) sampleValues.nextfreeGtUword;
+      header.numRankBlocks = (uint64_t) numRankBlocks;
+      gt_xfwrite(&header, sizeof (header), (size_t) 1, fp);
+      gt_xfwrite(blockRanks, sizeof (*blockRanks), (size_t) numRankBlocks,
+                 fp);
+      gt_xfwrite(marks, sizeof (*marks), marksSize, fp);
+      gt_xfwrite(samples, sizeof (*samples), samplesSize, fp);
+      gt_fa_xfclose(fp);
+    }
+    gt_free(samples);
+  }
+  GT_FREEARRAY(&sampleValues, GtUword);
+  gt_free(blockRanks);
+  gt_free(marks);
+  return had_err;
+}
+
+SASampleIdx *
+gt_loadSASampleIdx(const char *projectName, GtUword seqLen, GtError *err)
+{
+  SASampleIdx *saSample = NULL;
+  const struct saSampleHeader *header;
+  GtStr *ssxName;
+  void *mapping;
+  size_t mappedLen = 0;
+
+  gt_error_check(err);
+  gt_assert(projectName);
+  ssxName = ssiFileName(projectName);
+  mapping = gt_fa_mmap_read(gt_str_get(ssxName), &mappedLen, err);
+  if (mapping == NULL)
+  {
+    gt_str_delete(ssxName);
+    return NULL;
+  }
+  header = mapping;
+  if (mappedLen < sizeof (*header)
+      || header->sampleRate == 0
+      || header->bitsPerSample == 0
+      || header->bitsPerSample > sizeof (GtUword) * CHAR_BIT
+      || header->seqLen == 0
+      || header->rot0Pos >= header->seqLen
+      || header->numSamples > header->seqLen
+      || header->numRankBlocks != ssiNumOfRankBlocks((GtUword) header->seqLen)
+      || mappedLen != sizeof (*header)
+                      + header->numRankBlocks * sizeof (uint64_t)
+                      + bitElemsAllocSize((BitOffset) header->seqLen)
+                      + bitElemsAllocSize((BitOffset) header->numSamples
+                                          * header->bitsPerSample))
+  {
+    gt_error_set(err, "suffix array sample table %s is corrupt",
+                 gt_str_get(ssxName));
+  }
+  else if ((GtUword) header->seqLen != seqLen)
+  {
+    gt_error_set(err, "suffix array sample table %s does not match the "
+                 "sequence index", gt_str_get(ssxName));
+  }
+  else
+  {
+    saSample = gt_malloc(sizeof (*saSample));
+    saSample->mapping = mapping;
+    saSample->blockRanks = (const uint64_t *) (header + 1);
+    saSample->marks
+      = (constBitString) (saSample->blockRanks + header->numRankBlocks);
+    saSample->samples
+      = saSample->marks + bitElemsAllocSize((BitOffset) header->seqLen);
+    saSample->seqLen = (GtUword) header->seqLen;
+    saSample->rot0Pos = (GtUword) header->rot0Pos;
+    saSample->sampleRate = (unsigned) header->sampleRate;
+    saSample->bitsPerSample = (unsigned) header->bitsPerSample;
+  }
+  if (saSample == NULL)
+    gt_fa_xmunmap(mapping);
+  gt_str_delete(ssxName);
+  return saSample;
+}
+
+void
+gt_deleteSASampleIdx(SASampleIdx *saSample)
+{
+  if (saSample == NULL)
+    return;
+  gt_fa_xmunmap(saSample->mapping);
+  gt_free(saSample);
+}
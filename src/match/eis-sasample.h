@@ -0,0 +1,101 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef EIS_SASAMPLE_H
+#define EIS_SASAMPLE_H
+
+/**
+ * \file eis-sasample.h
+ * Suffix array samples of a BWT sequence index kept in a file of their
+ * own, so that the sampling rate can be changed without rebuilding the
+ * index. Every row whose suffix starts at a multiple of the sampling
+ * rate is sampled, which bounds the number of LF-mapping steps needed
+ * to locate any row.
+ */
+
+#include "core/error_api.h"
+#include "core/types_api.h"
+#include "match/eis-seqdatasrc.h"
+
+/** file name suffix of a suffix array sample table */
+#define SSI_FILE_SUFFIX ".ssx"
+
+typedef struct saSampleIdx SASampleIdx;
+
+struct BWTSeq;
+
+/**
+ * @brief Writes the suffix array samples of bwtSeq to file
+ * projectName.ssx, replacing an existing file.
+ *
+ * Besides the rows whose suffix array value is a multiple of
+ * sampleRate, all rows whose BWT symbol cannot be LF-mapped by symbol
+ * counts alone (the terminator and, depending on the index, special
+ * symbols) are sampled.
+ * @param bwtSeq index to sample
+ * @param readSfxIdx reader delivering the suffix array of bwtSeq in
+ * order
+ * @param sampleRate distance of sampled suffix array values, at least 1
+ * @param projectName base name of the sample file
+ * @param err
+ * @return 0 on success, -1 on error
+ */
+int
+gt_writeSASampleIdx(const struct BWTSeq *bwtSeq, SeqDataReader readSfxIdx,
+                    unsigned sampleRate, const char *projectName,
+                    GtError *err);
+
+/**
+ * @brief Maps the suffix array samples projectName.ssx into memory.
+ * @param projectName base name of the sample file
+ * @param seqLen length of the BWT sequence the samples were built for
+ * @param err
+ * @return new sample table or NULL on error
+ */
+SASampleIdx *
+gt_loadSASampleIdx(const char *projectName, GtUword seqLen, GtError *err);
+
+void
+gt_deleteSASampleIdx(SASampleIdx *saSample);
+
+/**
+ * @return sampling rate the table was built with
+ */
+static inline unsigned
+SSISampleRate(const SASampleIdx *saSample);
+
+/**
+ * @return BWT position of the rotation starting at position 0
+ */
+static inline GtUword
+SSIRot0Pos(const SASampleIdx *saSample);
+
+/**
+ * @return true if the suffix array value of BWT position pos is sampled
+ */
+static inline bool
+SSIIsSampled(const SASampleIdx *saSample, GtUword pos);
+
+/**
+ * @brief Return the suffix array value of BWT position pos. Requires
+ * SSIIsSampled(saSample, pos).
+ */
+static inline GtUword
+SSIGetSample(const SASampleIdx *saSample, GtUword pos);
+
+#include "match/eis-sasample-priv.h"
+
+#endif
@@ -413,6 +413,16 @@ void gt_deletevoidBWTSeq(FMindex *fmindex)
   gt_deleteBWTSeq(bwtseq);
 }
 
+FMindex *gt_newvoidBWTSeqView(const FMindex *fmindex)
+{
+  return (FMindex *) gt_newBWTSeqView((const BWTSeq *) fmindex);
+}
+
+void gt_deletevoidBWTSeqView(FMindex *view)
+{
+  gt_deleteBWTSeqView((BWTSeq *) view);
+}
+
 GtUword gt_voidpackedindexuniqueforward(const void *fmindex,
                                               GT_UNUSED GtUword offset,
                                               GT_UNUSED GtUword left,
@@ -83,6 +83,14 @@ FMindex *gt_loadvoidBWTSeqForSA(const char *indexname,
 
 void gt_deletevoidBWTSeq(FMindex *packedindex);
 
+/* returns a view of <fmindex> with query state of its own, so that
+   several threads can query the index at once, each using a separate
+   view; returns NULL if the index does not support this */
+
+FMindex *gt_newvoidBWTSeqView(const FMindex *fmindex);
+
+void gt_deletevoidBWTSeqView(FMindex *view);
+
 /* the parameter is const void *, as this is required by the other
    indexed based methods */
 
@@ -34,7 +34,8 @@ typedef struct GtGenomediffArguments {
        with_pck,
        with_units;
   int user_max_depth;
-  GtUword max_ln_n_fac;
+  GtUword max_ln_n_fac,
+          split_depth;
   double divergence_abs_err, /* kr2 T */
          divergence_m, /* kr2 M */
          divergence_rel_err, /* kr2 E */
@@ -20,6 +20,7 @@
 #include "core/types_api.h"
 #include "core/minmax_api.h"
 #include "core/encseq_metadata.h"
+#include "extended/wavefrontalign.h"
 #include "revcompl.h"
 #include "seed-extend.h"
 #include "ft-polish.h"
@@ -41,7 +42,8 @@ struct GtQuerymatchoutoptions
   GtEncseqMetadata *emd;
   GtUchar wildcardshow;
   GtSeqpaircoordinates correction_info;
-  bool always_polished_ends;
+  bool always_polished_ends,
+       wfa_realign;
   GtFtPolishing_info *pol_info;
 };
 
@@ -95,9 +97,24 @@ GtQuerymatchoutoptions *gt_querymatchoutoptions_new(const
   querymatchoutoptions->db_esr_for_align_show = NULL;
   querymatchoutoptions->query_esr_for_align_show = NULL;
   querymatchoutoptions->always_polished_ends = true;
+  querymatchoutoptions->wfa_realign = false;
   return querymatchoutoptions;
 }
 
+void gt_querymatchoutoptions_wfa_set(GtQuerymatchoutoptions
+                                       *querymatchoutoptions)
+{
+  gt_assert(querymatchoutoptions != NULL);
+  querymatchoutoptions->wfa_realign = true;
+}
+
+bool gt_querymatchoutoptions_wfa(const GtQuerymatchoutoptions
+                                   *querymatchoutoptions)
+{
+  gt_assert(querymatchoutoptions != NULL);
+  return querymatchoutoptions->wfa_realign;
+}
+
 void gt_querymatchoutoptions_reset(GtQuerymatchoutoptions *querymatchoutoptions)
 {
   if (querymatchoutoptions != NULL)
@@ -591,6 +608,22 @@ void gt_querymatchoutoptions_extract_seq(GtQuerymatchoutoptions
       gt_assert(query_readmode == GT_READMODE_FORWARD);
     }
   }
+  if (withcorrection && querymatchoutoptions->wfa_realign)
+  {
+    /* replace the alignment delivered by the extension by an optimal
+       alignment of the same region */
+    GtSeqpaircoordinates *coords = &querymatchoutoptions->correction_info;
+
+    gt_eoplist_reset(querymatchoutoptions->eoplist);
+    coords->sumdist
+      = gt_wavefrontalign_unit_eoplist(querymatchoutoptions->eoplist,
+                                       querymatchoutoptions->useqbuffer +
+                                         coords->uoffset,
+                                       coords->ulen,
+                                       querymatchoutoptions->vseqbuffer +
+                                         coords->voffset,
+                                       coords->vlen);
+  }
   gt_querymatchoutoptions_set_sequences(querymatchoutoptions,
                                         dbstart_relative,
                                         dblen,
@@ -141,6 +141,14 @@ void gt_querymatchoutoptions_seededmatch2eoplist(
                                 bool verify_alignment,
                                 bool greedyextension);
 
+/* Realign the region delivered by the extension of a seed with an optimal
+   unit cost alignment computed by the wavefront algorithm. */
+void gt_querymatchoutoptions_wfa_set(GtQuerymatchoutoptions
+                                       *querymatchoutoptions);
+
+bool gt_querymatchoutoptions_wfa(const GtQuerymatchoutoptions
+                                   *querymatchoutoptions);
+
 GtEoplist *gt_querymatchoutoptions_eoplist(const GtQuerymatchoutoptions
                                              *querymatchoutoptions);
 
@@ -894,7 +894,9 @@ static void gt_querymatch_alignment_prepare(GtQuerymatch *querymatch,
                                       abs_querystart_fwdstrand,
                                       querymatch->querylen,
                                       seeded_alignment);
-  if (seeded_alignment && !greedyextension)
+  if (seeded_alignment &&
+      (!greedyextension ||
+       gt_querymatchoutoptions_wfa(querymatch->ref_querymatchoutoptions)))
   {
     gt_querymatch_applycorrection(querymatch);
   }
@@ -0,0 +1,277 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/assert_api.h"
+#include "core/ensure_api.h"
+#include "core/fa_api.h"
+#include "core/fileutils_api.h"
+#include "core/ma_api.h"
+#include "core/minmax_api.h"
+#include "core/str_api.h"
+#include "core/unused_api.h"
+#include "core/xansi_api.h"
+#include "match/rdj-spmlist.h"
+#include "match/rdj-spmbuffer.h"
+
+/* spilled buffers are written to their file in blocks of this size */
+#define GT_SPMBUFFER_BLOCKSIZE ((size_t)1 << 16)
+
+struct GtSpmbuffer {
+  GtUchar *space;
+  size_t nextfree, allocated, maxspace;
+  GtUword previous_suffix_seqnum, nofspm;
+  GtStr *path;
+  FILE *fp;
+  bool spilled, closed,
+       removefile; /* the file is a temporary file created by the buffer */
+};
+
+GtSpmbuffer* gt_spmbuffer_new(GtUword maxspace)
+{
+  GtSpmbuffer *spmbuffer = gt_malloc(sizeof (*spmbuffer));
+  spmbuffer->space = NULL;
+  spmbuffer->nextfree = 0;
+  spmbuffer->allocated = 0;
+  spmbuffer->maxspace = (size_t)maxspace;
+  spmbuffer->previous_suffix_seqnum = 0;
+  spmbuffer->nofspm = 0;
+  spmbuffer->path = NULL;
+  spmbuffer->fp = NULL;
+  spmbuffer->spilled = false;
+  spmbuffer->closed = false;
+  spmbuffer->removefile = false;
+  return spmbuffer;
+}
+
+/* opens the file of <spmbuffer>; if it has none, a temporary file is
+   created, which is removed when the buffer is deleted */
+static void gt_spmbuffer_spill(GtSpmbuffer *spmbuffer)
+{
+  gt_assert(!spmbuffer->spilled);
+  if (spmbuffer->path == NULL)
+  {
+    spmbuffer->path = gt_str_new();
+    spmbuffer->fp = gt_xtmpfp_generic(spmbuffer->path, GT_TMPFP_OPENBINARY);
+    spmbuffer->removefile = true;
+  }
+  else
+    spmbuffer->fp = gt_fa_xfopen(gt_str_get(spmbuffer->path), "wb");
+  gt_spmlist_write_header_varint(spmbuffer->fp);
+  spmbuffer->spilled = true;
+}
+
+GtSpmbuffer* gt_spmbuffer_new_file(const char *path)
+{
+  GtSpmbuffer *spmbuffer;
+  gt_assert(path != NULL);
+  spmbuffer = gt_spmbuffer_new(0);
+  spmbuffer->path = gt_str_new_cstr(path);
+  gt_spmbuffer_spill(spmbuffer);
+  return spmbuffer;
+}
+
+static void gt_spmbuffer_flush(GtSpmbuffer *spmbuffer)
+{
+  gt_assert(spmbuffer->fp != NULL);
+  gt_xfwrite(spmbuffer->space, sizeof (*spmbuffer->space),
+             spmbuffer->nextfree, spmbuffer->fp);
+  spmbuffer->nextfree = 0;
+}
+
+void gt_spmproc_spmbuffer_add(GtUword suffix_seqnum, GtUword prefix_seqnum,
+    GtUword length, bool suffixseq_direct, bool prefixseq_direct, void *data)
+{
+  GtSpmbuffer *spmbuffer = data;
+
+  gt_assert(spmbuffer != NULL && !(spmbuffer->spilled && spmbuffer->closed));
+  if (spmbuffer->nextfree + GT_SPMLIST_VARINT_MAXRECORDSIZE >
+      spmbuffer->allocated)
+  {
+    if (!spmbuffer->spilled && spmbuffer->maxspace > 0 &&
+        spmbuffer->allocated >= spmbuffer->maxspace)
+      gt_spmbuffer_spill(spmbuffer);
+    if (spmbuffer->spilled && spmbuffer->nextfree > 0)
+      gt_spmbuffer_flush(spmbuffer);
+    if (spmbuffer->nextfree + GT_SPMLIST_VARINT_MAXRECORDSIZE >
+        spmbuffer->allocated)
+    {
+      spmbuffer->allocated = spmbuffer->spilled ? GT_SPMBUFFER_BLOCKSIZE :
+        GT_MAX(GT_SPMBUFFER_BLOCKSIZE, spmbuffer->allocated +
+               (spmbuffer->allocated >> 1));
+      if (spmbuffer->maxspace > 0 && !spmbuffer->spilled)
+        spmbuffer->allocated = GT_MIN(spmbuffer->allocated,
+            GT_MAX(spmbuffer->maxspace, GT_SPMLIST_VARINT_MAXRECORDSIZE));
+      spmbuffer->space = gt_realloc(spmbuffer->space,
+          sizeof (*spmbuffer->space) * spmbuffer->allocated);
+    }
+  }
+  spmbuffer->nextfree += gt_spmlist_varint_encode(
+      spmbuffer->space + spmbuffer->nextfree,
+      &spmbuffer->previous_suffix_seqnum, suffix_seqnum, prefix_seqnum,
+      length, suffixseq_direct, prefixseq_direct);
+  spmbuffer->nofspm++;
+}
+
+void gt_spmbuffer_close(GtSpmbuffer *spmbuffer)
+{
+  gt_assert(spmbuffer != NULL);
+  if (spmbuffer->spilled && !spmbuffer->closed)
+  {
+    gt_spmbuffer_flush(spmbuffer);
+    gt_fa_xfclose(spmbuffer->fp);
+    spmbuffer->fp = NULL;
+    gt_free(spmbuffer->space);
+    spmbuffer->space = NULL;
+    spmbuffer->allocated = 0;
+  }
+  spmbuffer->closed = true;
+}
+
+int gt_spmbuffer_parse(GtSpmbuffer *spmbuffer, GtUword min_length,
+    GtSpmproc processoverlap, void *data, GtError *err)
+{
+  int had_err = 0;
+  GtUword previous_suffix_seqnum = 0;
+
+  gt_error_check(err);
+  gt_assert(spmbuffer != NULL);
+  if (spmbuffer->spilled)
+  {
+    gt_spmbuffer_close(spmbuffer);
+    had_err = gt_spmlist_parse(gt_str_get(spmbuffer->path), min_length,
+        processoverlap, data, err);
+  }
+  else
+  {
+    GT_UNUSED size_t used;
+    used = gt_spmlist_varint_decode(spmbuffer->space, spmbuffer->nextfree,
+        &previous_suffix_seqnum, min_length, processoverlap, data);
+    gt_assert(used == spmbuffer->nextfree);
+  }
+  return had_err;
+}
+
+GtUword gt_spmbuffer_nofspm(const GtSpmbuffer *spmbuffer)
+{
+  gt_assert(spmbuffer != NULL);
+  return spmbuffer->nofspm;
+}
+
+bool gt_spmbuffer_is_spilled(const GtSpmbuffer *spmbuffer)
+{
+  gt_assert(spmbuffer != NULL);
+  return spmbuffer->spilled;
+}
+
+void gt_spmbuffer_delete(GtSpmbuffer *spmbuffer)
+{
+  if (spmbuffer == NULL)
+    return;
+  gt_spmbuffer_close(spmbuffer);
+  if (spmbuffer->spilled && spmbuffer->removefile)
+    gt_xremove(gt_str_get(spmbuffer->path));
+  gt_free(spmbuffer->space);
+  gt_str_delete(spmbuffer->path);
+  gt_free(spmbuffer);
+}
+
+/* ---------------------- Unit Test ---------------------- */
+
+typedef struct {
+  GtUword nofspm;
+  bool ok;
+} GtSpmbufferTestCheck;
+
+#define GT_SPMBUFFER_TEST_SPM(I, S, P, L, SD, PD)\
+  do {\
+    S = ((I) * 7919UL) % 1000UL;\
+    P = ((I) * 104729UL) % 100000UL;\
+    L = 1UL + (I) % 500UL;\
+    SD = ((I) & 1) != 0;\
+    PD = ((I) & 2) != 0 || !(SD);\
+  } while (false)
+
+static void gt_spmbuffer_test_check(GtUword suffix_seqnum,
+    GtUword prefix_seqnum, GtUword length, bool suffixseq_direct,
+    bool prefixseq_direct, void *data)
+{
+  GtSpmbufferTestCheck *check = data;
+  GtUword s, p, l;
+  bool sd, pd;
+
+  GT_SPMBUFFER_TEST_SPM(check->nofspm, s, p, l, sd, pd);
+  if (s != suffix_seqnum || p != prefix_seqnum || l != length ||
+      sd != suffixseq_direct || pd != prefixseq_direct)
+    check->ok = false;
+  check->nofspm++;
+}
+
+int gt_spmbuffer_unit_test(GtError *err)
+{
+  int had_err = 0, i;
+  const GtUword nofspm = 100000UL, maxspace[] = {0, 1000UL, 0};
+  GtStr *path = gt_str_new(), *tmppath = gt_str_new();
+  FILE *fp;
+
+  gt_error_check(err);
+  fp = gt_xtmpfp(path);
+  gt_fa_xfclose(fp);
+  for (i = 0; !had_err && i < 3; i++)
+  {
+    GtSpmbuffer *spmbuffer;
+    GtSpmbufferTestCheck check;
+    GtUword idx, s, p, l;
+    bool sd, pd;
+
+    /* in memory; spilled to a temporary file after 1000 bytes; written to
+       the file <path> */
+    spmbuffer = i < 2 ? gt_spmbuffer_new(maxspace[i])
+                      : gt_spmbuffer_new_file(gt_str_get(path));
+    for (idx = 0; idx < nofspm; idx++)
+    {
+      GT_SPMBUFFER_TEST_SPM(idx, s, p, l, sd, pd);
+      gt_spmproc_spmbuffer_add(s, p, l, sd, pd, spmbuffer);
+    }
+    gt_ensure(gt_spmbuffer_nofspm(spmbuffer) == nofspm);
+    gt_ensure(gt_spmbuffer_is_spilled(spmbuffer) == (i > 0));
+    /* parse twice, as done for counting and inserting edges */
+    for (idx = 0; !had_err && idx < 2UL; idx++)
+    {
+      check.nofspm = 0;
+      check.ok = true;
+      had_err = gt_spmbuffer_parse(spmbuffer, 0, gt_spmbuffer_test_check,
+          &check, err);
+      gt_ensure(check.ok);
+      gt_ensure(check.nofspm == nofspm);
+    }
+    if (i == 1)
+    {
+      gt_ensure(strcmp(gt_str_get(spmbuffer->path), gt_str_get(path)) != 0);
+      gt_str_set(tmppath, gt_str_get(spmbuffer->path));
+    }
+    gt_spmbuffer_delete(spmbuffer);
+    /* a spilled buffer removes its temporary file and leaves <path> alone,
+       a file buffer keeps its file */
+    gt_ensure(gt_file_exists(gt_str_get(path)));
+    if (i == 1)
+      gt_ensure(!gt_file_exists(gt_str_get(tmppath)));
+  }
+  gt_xremove(gt_str_get(path));
+  gt_str_delete(tmppath);
+  gt_str_delete(path);
+  return had_err;
+}
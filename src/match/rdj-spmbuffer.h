@@ -0,0 +1,67 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef RDJ_SPMBUFFER_H
+#define RDJ_SPMBUFFER_H
+
+#include "core/error_api.h"
+#include "match/rdj-spmproc.h"
+
+/* A buffer for exact SPMs, which are stored in the compact varint format
+   (see rdj-spmlist.h). The SPMs are kept in memory until their space
+   exceeds a given limit; then they are moved to a temporary SPM file and
+   all further SPMs are appended to that file. */
+typedef struct GtSpmbuffer GtSpmbuffer;
+
+/* Returns a new buffer keeping at most <maxspace> bytes of SPMs in memory
+   before spilling them to a temporary SPM file. If <maxspace> is 0, the
+   space is unlimited. The temporary file is removed when the buffer is
+   deleted. */
+GtSpmbuffer* gt_spmbuffer_new(GtUword maxspace);
+
+/* Returns a new buffer writing all SPMs to the SPM file <path>, which is
+   kept when the buffer is deleted. */
+GtSpmbuffer* gt_spmbuffer_new_file(const char *path);
+
+/* GtSpmproc appending an SPM to the GtSpmbuffer <data>. */
+void         gt_spmproc_spmbuffer_add(GtUword suffix_seqnum,
+                                      GtUword prefix_seqnum, GtUword length,
+                                      bool suffixseq_direct,
+                                      bool prefixseq_direct, void *data);
+
+/* Writes pending SPMs to the file of <spmbuffer>, if it was spilled, and
+   closes it. After this no SPMs may be appended to a spilled buffer. */
+void         gt_spmbuffer_close(GtSpmbuffer *spmbuffer);
+
+/* Calls <processoverlap> for each SPM in <spmbuffer> of length at least
+   <min_length>, in the order in which the SPMs were appended. */
+int          gt_spmbuffer_parse(GtSpmbuffer *spmbuffer, GtUword min_length,
+                                GtSpmproc processoverlap, void *data,
+                                GtError *err);
+
+/* Returns the number of SPMs appended to <spmbuffer>. */
+GtUword      gt_spmbuffer_nofspm(const GtSpmbuffer *spmbuffer);
+
+/* Returns true if the SPMs of <spmbuffer> were moved to its file. */
+bool         gt_spmbuffer_is_spilled(const GtSpmbuffer *spmbuffer);
+
+/* Deletes <spmbuffer> and removes the temporary file it was spilled to, if
+   any. */
+void         gt_spmbuffer_delete(GtSpmbuffer *spmbuffer);
+
+int          gt_spmbuffer_unit_test(GtError *err);
+
+#endif
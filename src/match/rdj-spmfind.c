@@ -21,11 +21,16 @@
 #include "core/ma_api.h"
 #include "core/intbits.h"
 #include "core/log_api.h"
+#include "core/minmax_api.h"
 #include "core/spacecalc.h"
 #include "core/types_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
+#ifdef GT_THREADS_ENABLED
+#include "core/thread_api.h"
+#endif
 #include "match/esa-bottomup.h"
+#include "match/firstcodes.h"
 #include "match/rdj-cntlist.h"
 #include "match/rdj-filesuf-def.h"
 #include "match/rdj-revcompl-def.h"
@@ -83,6 +88,7 @@ struct GtBUstate_spm {
   bool w_overflow;
 
   /* function called when results are found, and its data pointer: */
+  GtSpmfindOutput output;
   GtSpmproc proc;
   void* procdata;
   GtUword nofvalidspm;
@@ -621,8 +627,9 @@ static void showstatistics_spm(GtBUstate_spmeq *state)
 
 static GtBUstate_spm *gt_spmfind_state_new(bool eqlen, const GtEncseq *encseq,
     GtUword minmatchlength, GtUword w_maxsize, bool elimtrans,
-    bool showspm, const char *indexname, unsigned int threadnum,
-    GtLogger *default_logger, GtLogger *verbose_logger, GtError *err)
+    GtSpmfindOutput output, GtSpmbuffer *spmbuffer, const char *indexname,
+    unsigned int threadnum, GtLogger *default_logger,
+    GtLogger *verbose_logger, GtError *err)
 {
   GtBUstate_spmeq *state = gt_calloc((size_t)1, sizeof (*state));
 
@@ -686,14 +693,32 @@ static GtBUstate_spm *gt_spmfind_state_new(bool eqlen, const GtEncseq *encseq,
         state->elimtrans ? "true" : "false");
   }
 
-  if (showspm)
+  state->output = output;
+  if (output == GT_SPMFIND_OUTPUT_SHOW)
   {
     state->proc = gt_spmproc_show_ascii;
     state->procdata = NULL;
   }
+  else if (output == GT_SPMFIND_OUTPUT_BUFFER)
+  {
+    gt_assert(spmbuffer != NULL);
+    state->proc = gt_spmproc_spmbuffer_add;
+    state->procdata = spmbuffer;
+  }
+  else if (output == GT_SPMFIND_OUTPUT_VARINT)
+  {
+    GtStr *path = gt_str_new_cstr(indexname);
+    gt_str_append_char(path, '.');
+    gt_str_append_uint(path, threadnum);
+    gt_str_append_cstr(path, GT_READJOINER_SUFFIX_SPMLIST);
+    state->proc = gt_spmproc_spmbuffer_add;
+    state->procdata = gt_spmbuffer_new_file(gt_str_get(path));
+    gt_str_delete(path);
+  }
   else
   {
     GtStr *suffix = gt_str_new();
+    gt_assert(output == GT_SPMFIND_OUTPUT_BIN);
     gt_str_append_char(suffix, '.');
     gt_str_append_uint(suffix, threadnum);
     gt_str_append_cstr(suffix, GT_READJOINER_SUFFIX_SPMLIST);
@@ -742,22 +767,24 @@ static GtBUstate_spm *gt_spmfind_state_new(bool eqlen, const GtEncseq *encseq,
 
 GtBUstate_spmeq *gt_spmfind_eqlen_state_new(const GtEncseq *encseq,
     GtUword minmatchlength, GtUword w_maxsize, bool elimtrans,
-    bool showspm, const char *indexname, unsigned int threadnum,
-    GtLogger *default_logger, GtLogger *verbose_logger, GtError *err)
+    GtSpmfindOutput output, GtSpmbuffer *spmbuffer, const char *indexname,
+    unsigned int threadnum, GtLogger *default_logger,
+    GtLogger *verbose_logger, GtError *err)
 {
   return (GtBUstate_spmeq *)gt_spmfind_state_new(true, encseq, minmatchlength,
-      w_maxsize, elimtrans, showspm, indexname, threadnum, default_logger,
-      verbose_logger, err);
+      w_maxsize, elimtrans, output, spmbuffer, indexname, threadnum,
+      default_logger, verbose_logger, err);
 }
 
 GtBUstate_spmvar *gt_spmfind_varlen_state_new(const GtEncseq *encseq,
     GtUword minmatchlength, GtUword w_maxsize, bool elimtrans,
-    bool showspm, const char *indexname, unsigned int threadnum,
-    GtLogger *default_logger, GtLogger *verbose_logger, GtError *err)
+    GtSpmfindOutput output, GtSpmbuffer *spmbuffer, const char *indexname,
+    unsigned int threadnum, GtLogger *default_logger,
+    GtLogger *verbose_logger, GtError *err)
 {
   return (GtBUstate_spmvar *)gt_spmfind_state_new(false, encseq, minmatchlength,
-      w_maxsize, elimtrans, showspm, indexname, threadnum, default_logger,
-      verbose_logger, err);
+      w_maxsize, elimtrans, output, spmbuffer, indexname, threadnum,
+      default_logger, verbose_logger, err);
 }
 
 static GtUword gt_spmfind_nof_trans_spm(GtBUstate_spm *state)
@@ -826,7 +853,9 @@ static void gt_spmfind_state_delete(bool eqlen, GtBUstate_spm *state)
           (GtArrayGtBUItvinfo_spmvar *)state->stack, state);
       gt_fa_fclose(state->cntfile);
     }
-    if (state->procdata != NULL)
+    if (state->output == GT_SPMFIND_OUTPUT_VARINT)
+      gt_spmbuffer_delete((GtSpmbuffer*)state->procdata);
+    else if (state->output == GT_SPMFIND_OUTPUT_BIN)
       /*@ignore@*/
       gt_fa_fclose((FILE*)state->procdata);
       /*@end@*/
@@ -922,3 +951,52 @@ int gt_spmfind_varlen_process(void *data,
   } while (state->w_overflow);
   return 0;
 }
+
+int gt_spmfind_all(const GtEncseq *encseq, unsigned int minmatchlength,
+    GtUword w_maxsize, bool elimtrans, GtSpmfindOutput output,
+    GtSpmbuffer **spmbuffers, const char *indexname, unsigned int numofparts,
+    GtUword maximumspace, GtUword phase2extra, bool radixsmall,
+    unsigned int radixparts, bool onlyallfirstcodes, GtUword *nof_irr_spm,
+    GtUword *nof_trans_spm, GtLogger *default_logger,
+    GtLogger *verbose_logger, GtError *err)
+{
+  int had_err = 0;
+  unsigned int threadcount,
+               kmersize = GT_MIN((unsigned int) GT_UNITSIN2BITENC,
+                                 minmatchlength);
+#ifdef GT_THREADS_ENABLED
+  const unsigned int threads = gt_jobs;
+#else
+  const unsigned int threads = 1U;
+#endif
+  bool eqlen = gt_encseq_accesstype_get(encseq) == GT_ACCESS_TYPE_EQUALLENGTH;
+  GtBUstate_spm **state_table = gt_malloc(sizeof (*state_table) * threads);
+
+  gt_assert(output != GT_SPMFIND_OUTPUT_BUFFER || spmbuffers != NULL);
+  for (threadcount = 0; threadcount < threads; threadcount++)
+  {
+    state_table[threadcount] = gt_spmfind_state_new(eqlen, encseq,
+        (GtUword)minmatchlength, w_maxsize, elimtrans, output,
+        output == GT_SPMFIND_OUTPUT_BUFFER ? spmbuffers[threadcount] : NULL,
+        indexname, threadcount, default_logger, verbose_logger, err);
+  }
+  if (storefirstcodes_getencseqkmers_twobitencoding(encseq, kmersize,
+        numofparts, maximumspace, minmatchlength, false, false,
+        onlyallfirstcodes, 5U, phase2extra, radixsmall, radixparts,
+        eqlen ? gt_spmfind_eqlen_process : gt_spmfind_varlen_process,
+        eqlen ? gt_spmfind_eqlen_process_end : gt_spmfind_varlen_process_end,
+        state_table, verbose_logger, err) != 0)
+  {
+    had_err = -1;
+  }
+  *nof_irr_spm = 0;
+  *nof_trans_spm = 0;
+  for (threadcount = 0; threadcount < threads; threadcount++)
+  {
+    *nof_irr_spm += gt_spmfind_nof_irr_spm(state_table[threadcount]);
+    *nof_trans_spm += gt_spmfind_nof_trans_spm(state_table[threadcount]);
+    gt_spmfind_state_delete(eqlen, state_table[threadcount]);
+  }
+  gt_free(state_table);
+  return had_err;
+}
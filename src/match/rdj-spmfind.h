@@ -21,21 +21,32 @@
 #include <stdint.h>
 #include "core/error_api.h"
 #include "core/encseq_api.h"
+#include "match/rdj-spmbuffer.h"
 #include "match/seqnumrelpos.h"
 
+/* destination of the SPMs found by a thread */
+typedef enum {
+  GT_SPMFIND_OUTPUT_SHOW,   /* text format on stdout */
+  GT_SPMFIND_OUTPUT_BIN,    /* file <indexname>.<threadnum>.spm, bin format */
+  GT_SPMFIND_OUTPUT_VARINT, /* file <indexname>.<threadnum>.spm, varint
+                               format */
+  GT_SPMFIND_OUTPUT_BUFFER  /* a GtSpmbuffer given by the caller */
+} GtSpmfindOutput;
+
 /*
  * elimtrans: if false, the blindtrie are never actually used and
  *            all SPM are output, not only the irreducible ones
- * showspm: if true, SPM are shown on stdout in text format; otherwise
- *          they are saved to file in binary format
+ * output: where SPM are output; <spmbuffer> is only used (and must not be
+ *         NULL) for GT_SPMFIND_OUTPUT_BUFFER
  */
 
 typedef struct GtBUstate_spm GtBUstate_spmeq;
 
 GtBUstate_spmeq *gt_spmfind_eqlen_state_new(const GtEncseq *encseq,
     GtUword minmatchlength, GtUword w_maxsize, bool elimtrans,
-    bool showspm, const char *indexname, unsigned int threadnum,
-    GtLogger *default_logger, GtLogger *verbose_logger, GtError *err);
+    GtSpmfindOutput output, GtSpmbuffer *spmbuffer, const char *indexname,
+    unsigned int threadnum, GtLogger *default_logger,
+    GtLogger *verbose_logger, GtError *err);
 
 void gt_spmfind_eqlen_state_delete(GtBUstate_spmeq *state);
 
@@ -50,8 +61,9 @@ typedef struct GtBUstate_spm GtBUstate_spmvar;
 
 GtBUstate_spmvar *gt_spmfind_varlen_state_new(const GtEncseq *encseq,
     GtUword minmatchlength, GtUword w_maxsize, bool elimtrans,
-    bool showspm, const char *indexname, unsigned int threadnum,
-    GtLogger *default_logger, GtLogger *verbose_logger, GtError *err);
+    GtSpmfindOutput output, GtSpmbuffer *spmbuffer, const char *indexname,
+    unsigned int threadnum, GtLogger *default_logger,
+    GtLogger *verbose_logger, GtError *err);
 
 void gt_spmfind_varlen_state_delete(GtBUstate_spmvar *state);
 
@@ -70,4 +82,33 @@ GtUword gt_spmfind_eqlen_nof_trans_spm(GtBUstate_spmeq *state);
 
 GtUword gt_spmfind_eqlen_nof_irr_spm(GtBUstate_spmeq *state);
 
+/* Defaults of the parameters of gt_spmfind_all(), which are options of
+   gt readjoiner overlap; gt readjoiner assembly -overlap does not offer
+   these options and always uses the defaults. A <numofparts>,
+   <maximumspace> and <phase2extra> of 0 let the number of parts be
+   determined automatically without a space limit. */
+#define GT_SPMFIND_DEFAULT_W_MAXSIZE         32U
+#define GT_SPMFIND_DEFAULT_ELIMTRANS         true
+#define GT_SPMFIND_DEFAULT_NUMOFPARTS        0U
+#define GT_SPMFIND_DEFAULT_MAXIMUMSPACE      0UL
+#define GT_SPMFIND_DEFAULT_PHASE2EXTRA       0UL
+#define GT_SPMFIND_DEFAULT_RADIXSMALL        false
+#define GT_SPMFIND_DEFAULT_RADIXPARTS        1U
+#define GT_SPMFIND_DEFAULT_ONLYALLFIRSTCODES false
+
+/* Find the SPMs of the reads in <encseq> of length at least <minmatchlength>
+   using <gt_jobs> threads (see storefirstcodes_getencseqkmers_twobitencoding()
+   for <numofparts>, <maximumspace>, <phase2extra>, <radixsmall>,
+   <radixparts> and <onlyallfirstcodes>). The SPMs found by thread <t> are
+   output to <spmbuffers[t]> for GT_SPMFIND_OUTPUT_BUFFER. The number of
+   irreducible and transitive SPMs is stored in <nof_irr_spm> and
+   <nof_trans_spm>. Returns 0 on success, -1 on error. */
+int gt_spmfind_all(const GtEncseq *encseq, unsigned int minmatchlength,
+    GtUword w_maxsize, bool elimtrans, GtSpmfindOutput output,
+    GtSpmbuffer **spmbuffers, const char *indexname, unsigned int numofparts,
+    GtUword maximumspace, GtUword phase2extra, bool radixsmall,
+    unsigned int radixparts, bool onlyallfirstcodes, GtUword *nof_irr_spm,
+    GtUword *nof_trans_spm, GtLogger *default_logger,
+    GtLogger *verbose_logger, GtError *err);
+
 #endif
@@ -124,6 +124,131 @@ static int gt_spmlist_parse_bin ## BITS(FILE *file, GtUword min_length,\
 DEFINE_GT_SPMLIST_BIN_FORMAT(32);
 DEFINE_GT_SPMLIST_BIN_FORMAT(64);
 
+/* ---------------- Readjoiner varint format ---------------- */
+
+#define GT_SPMLIST_VARINT_ZIGZAG(A, B)\
+  ((A) >= (B) ? (GtUword)((A) - (B)) << 1 : (((GtUword)((B) - (A)) << 1) - 1))
+
+#define GT_SPMLIST_VARINT_UNZIGZAG(BASE, Z)\
+  (((Z) & 1) ? (BASE) - (((Z) + 1) >> 1) : (BASE) + ((Z) >> 1))
+
+#define GT_SPMLIST_VARINT_PARSE_BUFSIZE ((size_t)1 << 16)
+
+void gt_spmlist_write_header_varint(FILE *file)
+{
+  gt_xfputc((int)GT_SPMLIST_VARINT, file);
+}
+
+static inline size_t gt_spmlist_varint_put(GtUchar *buffer, GtUword value)
+{
+  size_t idx = 0;
+  while (value >= (GtUword)0x80)
+  {
+    buffer[idx++] = (GtUchar)(value | 0x80);
+    value >>= 7;
+  }
+  buffer[idx++] = (GtUchar)value;
+  return idx;
+}
+
+/* returns the number of bytes read or 0 if the value is incomplete */
+static inline size_t gt_spmlist_varint_get(const GtUchar *buffer, size_t len,
+    GtUword *value)
+{
+  size_t idx;
+  unsigned int shift = 0;
+  *value = 0;
+  for (idx = 0; idx < len; idx++)
+  {
+    *value |= (GtUword)(buffer[idx] & 0x7f) << shift;
+    if ((buffer[idx] & 0x80) == 0)
+      return idx + 1;
+    shift += 7U;
+  }
+  return 0;
+}
+
+size_t gt_spmlist_varint_encode(GtUchar *buffer,
+    GtUword *previous_suffix_seqnum, GtUword suffix_seqnum,
+    GtUword prefix_seqnum, GtUword length, bool suffixseq_direct,
+    bool prefixseq_direct)
+{
+  size_t pos;
+  gt_assert(length <= (ULONG_MAX >> 2));
+  pos = gt_spmlist_varint_put(buffer,
+      GT_SPMLIST_VARINT_ZIGZAG(suffix_seqnum, *previous_suffix_seqnum));
+  pos += gt_spmlist_varint_put(buffer + pos,
+      GT_SPMLIST_VARINT_ZIGZAG(prefix_seqnum, suffix_seqnum));
+  pos += gt_spmlist_varint_put(buffer + pos, (length << 2) |
+      (suffixseq_direct ? 2UL : 0) | (prefixseq_direct ? 1UL : 0));
+  gt_assert(pos <= GT_SPMLIST_VARINT_MAXRECORDSIZE);
+  *previous_suffix_seqnum = suffix_seqnum;
+  return pos;
+}
+
+size_t gt_spmlist_varint_decode(const GtUchar *buffer, size_t len,
+    GtUword *previous_suffix_seqnum, GtUword min_length,
+    GtSpmproc processoverlap, void *data)
+{
+  size_t pos = 0, n1, n2, n3;
+  GtUword v1, v2, v3, suffix_seqnum;
+
+  while (pos < len)
+  {
+    if ((n1 = gt_spmlist_varint_get(buffer + pos, len - pos, &v1)) == 0 ||
+        (n2 = gt_spmlist_varint_get(buffer + pos + n1, len - pos - n1, &v2))
+        == 0 ||
+        (n3 = gt_spmlist_varint_get(buffer + pos + n1 + n2,
+                                    len - pos - n1 - n2, &v3)) == 0)
+      break;
+    pos += n1 + n2 + n3;
+    suffix_seqnum = GT_SPMLIST_VARINT_UNZIGZAG(*previous_suffix_seqnum, v1);
+    *previous_suffix_seqnum = suffix_seqnum;
+    if ((v3 >> 2) >= min_length)
+      processoverlap(suffix_seqnum,
+          GT_SPMLIST_VARINT_UNZIGZAG(suffix_seqnum, v2), v3 >> 2,
+          (v3 & 2) != 0, (v3 & 1) != 0, data);
+  }
+  return pos;
+}
+
+static int gt_spmlist_parse_varint(FILE *file, GtUword min_length,
+    GtSpmproc processoverlap, void *data, GtError *err)
+{
+  int had_err = 0;
+  GtUchar *buffer = gt_malloc(sizeof (*buffer) *
+                              GT_SPMLIST_VARINT_PARSE_BUFSIZE);
+  size_t filled = 0, retval, used;
+  GtUword previous_suffix_seqnum = 0;
+
+  while (!had_err)
+  {
+    retval = fread(buffer + filled, sizeof (*buffer),
+        GT_SPMLIST_VARINT_PARSE_BUFSIZE - filled, file);
+    if (retval == 0)
+    {
+      if (ferror(file))
+      {
+        gt_error_set(err, "SPM varint file error: %s", strerror(errno));
+        had_err = -1;
+      }
+      else if (filled > 0)
+      {
+        gt_error_set(err, "SPM varint file error: premature EOF");
+        had_err = -1;
+      }
+      break;
+    }
+    filled += retval;
+    used = gt_spmlist_varint_decode(buffer, filled, &previous_suffix_seqnum,
+        min_length, processoverlap, data);
+    filled -= used;
+    memmove(buffer, buffer + used, filled);
+  }
+  gt_free(buffer);
+  return had_err;
+}
+
 /* ---------------- Plain text format ---------------- */
 
 /*@notfunction@*/
@@ -279,6 +404,11 @@ int gt_spmlist_parse(const char* filename, GtUword min_length,
       retval = gt_spmlist_parse_bin64(file, min_length, processoverlap, data,
           err);
       break;
+    case GT_SPMLIST_VARINT:
+      gt_log_log("Spm file %s format: readjoiner-varint", filename);
+      retval = gt_spmlist_parse_varint(file, min_length, processoverlap, data,
+          err);
+      break;
     default:
       gt_file_unget_char(infp, c);
       gt_log_log("Spm file %s format: readjoiner-text", filename);
@@ -504,11 +634,101 @@ static int gt_spmproc_show_unit_test(GtError *err)
   return had_err;
 }
 
+#define GT_SPMLIST_VARINT_TEST_NOFSPM 5
+
+static const struct GtSpmParseExactResult gt_spmlist_varint_test_spm[] =
+{
+  {7UL, 3UL, 10UL, true, true},
+  {7UL, 1000000UL, 127UL, false, true},
+  {0, 7UL, 128UL, true, false},
+  {1UL << 31, 0, 1UL << 20, false, false},
+  {5UL, 5UL, 2UL, true, true}
+};
+
+typedef struct {
+  GtUword next;
+  bool ok;
+} GtSpmlistVarintTestCheck;
+
+static void gt_spmlist_varint_test_check(GtUword suffix_seqnum,
+    GtUword prefix_seqnum, GtUword length, bool suffixseq_direct,
+    bool prefixseq_direct, void *data)
+{
+  GtSpmlistVarintTestCheck *check = data;
+  const struct GtSpmParseExactResult *expected;
+
+  /* the SPM of length 2 is skipped when decoding with min_length 3 */
+  if (check->next >= (GtUword)GT_SPMLIST_VARINT_TEST_NOFSPM)
+  {
+    check->ok = false;
+    return;
+  }
+  expected = gt_spmlist_varint_test_spm + check->next;
+  if (expected->suffix_seqnum != suffix_seqnum ||
+      expected->prefix_seqnum != prefix_seqnum ||
+      expected->length != length ||
+      expected->suffixseq_direct != suffixseq_direct ||
+      expected->prefixseq_direct != prefixseq_direct)
+    check->ok = false;
+  check->next++;
+}
+
+static int gt_spmlist_varint_unit_test(GtError *err)
+{
+  int had_err = 0;
+  GtUchar buffer[GT_SPMLIST_VARINT_TEST_NOFSPM *
+                 GT_SPMLIST_VARINT_MAXRECORDSIZE];
+  size_t len = 0, used, split;
+  GtUword previous = 0, i;
+  GtSpmlistVarintTestCheck check;
+
+  gt_error_check(err);
+  for (i = 0; i < (GtUword)GT_SPMLIST_VARINT_TEST_NOFSPM; i++)
+  {
+    len += gt_spmlist_varint_encode(buffer + len, &previous,
+        gt_spmlist_varint_test_spm[i].suffix_seqnum,
+        gt_spmlist_varint_test_spm[i].prefix_seqnum,
+        gt_spmlist_varint_test_spm[i].length,
+        gt_spmlist_varint_test_spm[i].suffixseq_direct,
+        gt_spmlist_varint_test_spm[i].prefixseq_direct);
+  }
+  gt_ensure(previous == 5UL);
+  /* decode in two parts split at every position */
+  for (split = 0; !had_err && split <= len; split++)
+  {
+    check.next = 0;
+    check.ok = true;
+    previous = 0;
+    used = gt_spmlist_varint_decode(buffer, split, &previous, 0,
+        gt_spmlist_varint_test_check, &check);
+    gt_ensure(used <= split);
+    used += gt_spmlist_varint_decode(buffer + used, len - used, &previous, 0,
+        gt_spmlist_varint_test_check, &check);
+    gt_ensure(used == len);
+    gt_ensure(check.ok);
+    gt_ensure(check.next == (GtUword)GT_SPMLIST_VARINT_TEST_NOFSPM);
+  }
+  if (!had_err)
+  {
+    check.next = 0;
+    check.ok = true;
+    previous = 0;
+    used = gt_spmlist_varint_decode(buffer, len, &previous, 3UL,
+        gt_spmlist_varint_test_check, &check);
+    gt_ensure(used == len);
+    gt_ensure(check.ok);
+    gt_ensure(check.next == (GtUword)GT_SPMLIST_VARINT_TEST_NOFSPM - 1);
+  }
+  return had_err;
+}
+
 int gt_spmlist_unit_test(GtError *err)
 {
   int had_err = 0;
   had_err = gt_spmproc_show_unit_test(err);
   if (had_err == 0)
     had_err = gt_spmlist_parse_unit_test(err);
+  if (had_err == 0)
+    had_err = gt_spmlist_varint_unit_test(err);
   return had_err;
 }
@@ -25,6 +25,7 @@
 typedef enum {
   GT_SPMLIST_BIN32      = 2,
   GT_SPMLIST_BIN64      = 3,
+  GT_SPMLIST_VARINT     = 4,
   GT_SPMLIST_ASCII   /* = any other value */,
 } GtSpmlistFormat;
 
@@ -37,6 +38,32 @@ void gt_spmproc_show_bin ## BITS(GtUword suffix_seqnum,\
 DECLARE_GT_SPMLIST_BIN_FORMAT(32);
 DECLARE_GT_SPMLIST_BIN_FORMAT(64);
 
+/* varint format:
+ * each SPM is stored as three LEB128 coded integers, i.e. the difference of
+ * the suffix_seqnum to the suffix_seqnum of the previous SPM (zigzag coded),
+ * the difference of the prefix_seqnum to the suffix_seqnum (zigzag coded)
+ * and length << 2 + suffixseq_direct << 1 + prefixseq_direct */
+
+#define GT_SPMLIST_VARINT_MAXRECORDSIZE (size_t)30
+
+void gt_spmlist_write_header_varint(FILE *file);
+
+/* encode a SPM into <buffer>, which must have space for at least
+   GT_SPMLIST_VARINT_MAXRECORDSIZE bytes; <previous_suffix_seqnum> must be 0
+   for the first SPM and is updated; returns the number of bytes written */
+size_t gt_spmlist_varint_encode(GtUchar *buffer,
+    GtUword *previous_suffix_seqnum, GtUword suffix_seqnum,
+    GtUword prefix_seqnum, GtUword length, bool suffixseq_direct,
+    bool prefixseq_direct);
+
+/* decode all complete SPMs in the first <len> bytes of <buffer> and call
+   <processoverlap> for those of length at least <min_length>; returns
+   the number of bytes read, i.e. the incomplete rest begins at
+   <buffer> + return value */
+size_t gt_spmlist_varint_decode(const GtUchar *buffer, size_t len,
+    GtUword *previous_suffix_seqnum, GtUword min_length,
+    GtSpmproc processoverlap, void *data);
+
 /* parse a spmlist file; format is recognized by reading the first byte */
 int gt_spmlist_parse(const char* filename, GtUword min_length,
     GtSpmproc processoverlap, void *data, GtError *err);
@@ -27,10 +27,12 @@
 #include "core/hashmap-generic.h"
 #include "core/log.h"
 #include "core/ma_api.h"
+#include "core/minmax_api.h"
 #include "core/progressbar.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "core/spacecalc.h"
+#include "core/thread_api.h"
 #include "extended/assembly_stats_calculator.h"
 #include "match/asqg_writer.h"
 #include "match/gfa_writer.h"
@@ -257,6 +259,10 @@ typedef enum {
   GT_STRGRAPH_LOADED_FROM_FILE,
 } GtStrgraphState;
 
+/* default minimal number of vertices processed by each thread in the passes
+   over vertex ranges */
+#define GT_STRGRAPH_VRANGE_MINSIZE ((GtStrgraphVnum)1 << 16)
+
 struct GtStrgraph {
   const GtEncseq        *encseq;
   GtStrgraphLength      fixlen;
@@ -266,6 +272,7 @@ struct GtStrgraph {
   bool                  load_self_spm;
   bool                  binary_spmlist;
   GtStrgraphLength      minmatchlen;
+  GtStrgraphVnum        vrange_minsize;
   GtReadsLibrariesTable *rlt;
   GT_STRGRAPH_DECLARE_COUNTS;
   GT_STRGRAPH_DECLARE_VERTICES;
@@ -402,6 +409,7 @@ GtStrgraph* gt_strgraph_new(GtUword nofreads)
   strgraph->state = GT_STRGRAPH_PREPARATION;
   strgraph->load_self_spm = false;
   strgraph->minmatchlen = GT_STRGRAPH_LENGTH_MAX;
+  strgraph->vrange_minsize = GT_STRGRAPH_VRANGE_MINSIZE;
   strgraph->rlt = NULL;
   gt_strgraph_show_limits_debug_log();
   GT_STRGRAPH_CHECK_NOFREADS(nofreads);
@@ -574,6 +582,7 @@ GtStrgraph* gt_strgraph_new_from_file(const GtEncseq *encseq,
   strgraph->state = GT_STRGRAPH_LOADED_FROM_FILE;
   strgraph->load_self_spm = false;
   strgraph->minmatchlen = GT_STRGRAPH_LENGTH_MAX;
+  strgraph->vrange_minsize = GT_STRGRAPH_VRANGE_MINSIZE;
   strgraph->rlt = NULL;
   strgraph->encseq = encseq;
   strgraph->fixlen = (GtStrgraphLength)fixlen;
@@ -701,12 +710,179 @@ void gt_strgraph_close_spmlist_file(GtStrgraph *strgraph)
   gt_free(strgraph->spmfile_buffer);
 }
 
-static void gt_strgraph_mark_empty_edges(GtStrgraph *strgraph)
+/* --- processing of vertex ranges --- */
+
+/*
+ * The passes over all vertices which only modify the vertex itself and its
+ * outgoing edges are applied to disjoint ranges of vertices by <gt_jobs>
+ * threads. As vertices and edges are stored in bitpacked arrays, two
+ * threads may not modify neighbouring vertices or edges, which share a
+ * machine word. Hence each range begins with a gap of at least
+ * GT_STRGRAPH_VRANGE_GAP vertices and edges, which is processed by the main
+ * thread after all threads have finished. As each vertex is processed
+ * independently of all other vertices, the result equals that of processing
+ * all vertices in order.
+ */
+
+typedef struct {
+  GtStrgraphVnum     v;
+  GtStrgraphVEdgenum edgenum;
+} GtStrgraphEdgeref;
+
+GT_DECLAREARRAYSTRUCT(GtStrgraphEdgeref);
+
+typedef struct GtStrgraphVrange GtStrgraphVrange;
+
+typedef void (*GtStrgraphVrangeFunc)(GtStrgraphVrange *vrange);
+
+struct GtStrgraphVrange {
+  GtStrgraph               *strgraph;
+  GtStrgraphVnum           from, to;
+  GtUword                  counter;
+  GtArrayGtStrgraphEdgeref marked;
+  GtStrgraphVnum           *dests;
+  GtUword                  dests_size;
+  GtUint64                 *progress;
+  GtStrgraphVrangeFunc     func;
+  bool                     onlyrange;
+};
+
+#define GT_STRGRAPH_VRANGE_GAP     ((GtStrgraphVnum)64)
+
+#ifdef GT_THREADS_ENABLED
+static void *gt_strgraph_vrange_thread(void *data)
+{
+  GtStrgraphVrange *vrange = data;
+  vrange->func(vrange);
+  return NULL;
+}
+
+/* return the first vertex after the gap beginning at vertex <from>, which is
+   at most <limit> */
+static GtStrgraphVnum gt_strgraph_vrange_gap_end(GtStrgraph *strgraph,
+    GtStrgraphVnum from, GtStrgraphVnum limit)
+{
+  GtStrgraphVnum v;
+  GtStrgraphEdgenum from_offset = GT_STRGRAPH_V_OFFSET(strgraph, from);
+
+  for (v = from; v < limit; v++)
+  {
+    if (v - from >= GT_STRGRAPH_VRANGE_GAP &&
+        GT_STRGRAPH_V_OFFSET(strgraph, v) - from_offset >=
+        (GtStrgraphEdgenum)GT_STRGRAPH_VRANGE_GAP)
+      break;
+  }
+  return v;
+}
+#endif
+
+/* apply <func> to all vertices; the edges collected in the <marked> arrays
+   of the ranges are appended to <marked>, if not NULL; <progress> is only
+   incremented by the main thread, if not NULL;
+   return value: sum of the counters of the ranges */
+static GtUword gt_strgraph_process_vranges(GtStrgraph *strgraph,
+    GtStrgraphVrangeFunc func, GtArrayGtStrgraphEdgeref *marked,
+    GtUint64 *progress)
+{
+  GtStrgraphVrange *vranges;
+  GtStrgraphVnum nofvertices = GT_STRGRAPH_NOFVERTICES(strgraph);
+  GtUword nofvranges = 1UL, idx, counter = 0;
+
+#ifdef GT_THREADS_ENABLED
+  if (gt_jobs > 1U && nofvertices >= strgraph->vrange_minsize)
+    nofvranges = GT_MIN((GtUword)gt_jobs,
+                        (GtUword)(nofvertices / strgraph->vrange_minsize));
+#endif
+  /* the ranges after the first one are followed by their gaps */
+  vranges = gt_malloc(sizeof (*vranges) * (2 * nofvranges - 1));
+  for (idx = 0; idx < 2 * nofvranges - 1; idx++)
+  {
+    vranges[idx].strgraph = strgraph;
+    vranges[idx].counter = 0;
+    vranges[idx].func = func;
+    vranges[idx].dests = NULL;
+    vranges[idx].dests_size = 0;
+    vranges[idx].progress = (idx == 0 || idx >= nofvranges) ? progress : NULL;
+    vranges[idx].onlyrange = nofvranges == 1UL;
+    GT_INITARRAY(&vranges[idx].marked, GtStrgraphEdgeref);
+  }
+  vranges[0].from = 0;
+  vranges[0].to = nofvertices;
+#ifdef GT_THREADS_ENABLED
+  if (nofvranges > 1UL)
+  {
+    GtThread **threads = gt_malloc(sizeof (*threads) * nofvranges);
+    GtStrgraphVnum gap_begin;
+
+    for (idx = 1UL; idx < nofvranges; idx++)
+    {
+      GtStrgraphVrange *range = vranges + idx, *gap = vranges + nofvranges +
+                                idx - 1;
+      gap_begin = (GtStrgraphVnum)(nofvertices * idx / nofvranges);
+      vranges[idx - 1].to = gap_begin;
+      gap->from = gap_begin;
+      gap->to = gt_strgraph_vrange_gap_end(strgraph, gap_begin,
+          (GtStrgraphVnum)(nofvertices * (idx + 1) / nofvranges));
+      range->from = gap->to;
+      range->to = nofvertices;
+    }
+    for (idx = 1UL; idx < nofvranges; idx++)
+    {
+      threads[idx] = gt_thread_new(gt_strgraph_vrange_thread, vranges + idx,
+                                   NULL);
+      if (threads[idx] == NULL)
+      {
+        /* process the range in the main thread */
+        vranges[idx].progress = progress;
+        func(vranges + idx);
+      }
+    }
+    func(vranges);
+    for (idx = 1UL; idx < nofvranges; idx++)
+    {
+      if (threads[idx] != NULL)
+      {
+        gt_thread_join(threads[idx]);
+        gt_thread_delete(threads[idx]);
+        if (progress != NULL)
+          *progress += (GtUint64)(vranges[idx].to - vranges[idx].from);
+      }
+    }
+    for (idx = nofvranges; idx < 2 * nofvranges - 1; idx++)
+      func(vranges + idx);
+    gt_free(threads);
+  }
+  else
+#endif
+  {
+    func(vranges);
+  }
+  for (idx = 0; idx < 2 * nofvranges - 1; idx++)
+  {
+    counter += vranges[idx].counter;
+    if (marked != NULL)
+    {
+      GtUword i;
+      for (i = 0; i < vranges[idx].marked.nextfreeGtStrgraphEdgeref; i++)
+      {
+        GT_STOREINARRAY(marked, GtStrgraphEdgeref, 1024,
+            vranges[idx].marked.spaceGtStrgraphEdgeref[i]);
+      }
+    }
+    GT_FREEARRAY(&vranges[idx].marked, GtStrgraphEdgeref);
+    gt_free(vranges[idx].dests);
+  }
+  gt_free(vranges);
+  return counter;
+}
+
+static void gt_strgraph_mark_empty_edges_vrange(GtStrgraphVrange *vrange)
 {
+  GtStrgraph *strgraph = vrange->strgraph;
   GtStrgraphVnum i;
   GtStrgraphVEdgenum j, n_empty;
 
-  for (i = 0; i < GT_STRGRAPH_NOFVERTICES(strgraph); i++)
+  for (i = vrange->from; i < vrange->to; i++)
   {
     gt_assert(GT_STRGRAPH_V_OUTDEG(strgraph, i)
         <= GT_STRGRAPH_V_NOFEDGES(strgraph, i));
@@ -723,14 +899,52 @@ static void gt_strgraph_mark_empty_edges(GtStrgraph *strgraph)
   }
 }
 
-int gt_strgraph_load_spm_from_file(GtStrgraph *strgraph,
-    GtUword min_length, bool load_self_spm, GtBitsequence *contained,
-    const char *indexname, unsigned int nspmfiles, const char *suffix,
+static void gt_strgraph_mark_empty_edges(GtStrgraph *strgraph)
+{
+  (void) gt_strgraph_process_vranges(strgraph,
+      gt_strgraph_mark_empty_edges_vrange, NULL, NULL);
+}
+
+/* apply <proc> to the SPMs of length at least <min_length> of the
+   spm file <indexname>.<source><suffix> or, if <spmbuffers> is not NULL, of
+   the spm buffer <spmbuffers>[<source>]; <filename> is used as buffer */
+static int gt_strgraph_parse_spm_source(const char *indexname,
+    const char *suffix, GtSpmbuffer **spmbuffers, unsigned int source,
+    GtUword min_length, GtSpmproc proc, void *procdata, GtStr *filename,
+    GtError *err)
+{
+  int had_err;
+
+  if (spmbuffers != NULL)
+  {
+    had_err = gt_spmbuffer_parse(spmbuffers[source], min_length, proc,
+        procdata, err);
+  }
+  else
+  {
+    gt_str_reset(filename);
+    gt_str_append_cstr(filename, indexname);
+    gt_str_append_char(filename, '.');
+    gt_str_append_uint(filename, source);
+    gt_str_append_cstr(filename, suffix);
+    had_err = gt_spmlist_parse(gt_str_get(filename), min_length, proc,
+        procdata, err);
+  }
+  return had_err;
+}
+
+/* either the spm files <indexname>.<i><suffix> or the <spmbuffers> are
+   read, for i in [0, <nofsources>) */
+static int gt_strgraph_load_spm(GtStrgraph *strgraph, GtUword min_length,
+    bool load_self_spm, GtBitsequence *contained, const char *indexname,
+    const char *suffix, GtSpmbuffer **spmbuffers, unsigned int nofsources,
     GtError *err)
 {
   int had_err = 0;
   GtStr *filename = gt_str_new();
   GtSpmprocSkipData skipdata;
+  GtSpmproc proc;
+  void *procdata;
   unsigned int i;
 
   gt_assert(strgraph != NULL);
@@ -740,18 +954,19 @@ int gt_strgraph_load_spm_from_file(GtStrgraph *strgraph,
     skipdata.to_skip = contained;
     skipdata.out.e.data = strgraph;
     skipdata.skipped_counter = 0;
+    proc = gt_spmproc_skip;
+    procdata = &skipdata;
+  }
+  else
+  {
+    proc = gt_spmproc_strgraph_add;
+    procdata = strgraph;
   }
   strgraph->load_self_spm = load_self_spm;
-  for (i = 0; i < nspmfiles; i++)
+  for (i = 0; i < nofsources && had_err == 0; i++)
   {
-    gt_str_append_cstr(filename, indexname);
-    gt_str_append_char(filename, '.');
-    gt_str_append_uint(filename, i);
-    gt_str_append_cstr(filename, suffix);
-    had_err = gt_spmlist_parse(gt_str_get(filename), min_length,
-        contained != NULL ? gt_spmproc_skip : gt_spmproc_strgraph_add,
-        contained != NULL ? (void*)&skipdata : (void*)strgraph, err);
-    gt_str_reset(filename);
+    had_err = gt_strgraph_parse_spm_source(indexname, suffix, spmbuffers, i,
+        min_length, proc, procdata, filename, err);
   }
   gt_str_delete(filename);
   if (!had_err)
@@ -759,6 +974,231 @@ int gt_strgraph_load_spm_from_file(GtStrgraph *strgraph,
   return had_err;
 }
 
+int gt_strgraph_load_spm_from_file(GtStrgraph *strgraph,
+    GtUword min_length, bool load_self_spm, GtBitsequence *contained,
+    const char *indexname, unsigned int nspmfiles, const char *suffix,
+    GtError *err)
+{
+  return gt_strgraph_load_spm(strgraph, min_length, load_self_spm, contained,
+      indexname, suffix, NULL, nspmfiles, err);
+}
+
+int gt_strgraph_load_spm_from_spmbuffers(GtStrgraph *strgraph,
+    GtUword min_length, bool load_self_spm, GtBitsequence *contained,
+    GtSpmbuffer **spmbuffers, unsigned int nofspmbuffers, GtError *err)
+{
+  gt_assert(spmbuffers != NULL);
+  return gt_strgraph_load_spm(strgraph, min_length, load_self_spm, contained,
+      NULL, NULL, spmbuffers, nofspmbuffers, err);
+}
+
+#ifdef GT_THREADS_ENABLED
+/* the counting threads parse disjoint sets of SPM sources; as the counts are
+   stored in a char array with a hash table for larger counts, the vertices
+   of the SPMs are collected in a buffer of each thread and counted under
+   the mutex, when the buffer is full */
+
+#define GT_STRGRAPH_COUNTBUF_SIZE 4096UL
+
+typedef struct {
+  GtStrgraph    *strgraph;
+  GtUword       min_length;
+  GtBitsequence *contained;
+  const char    *indexname, *suffix;
+  GtSpmbuffer   **spmbuffers;
+  unsigned int  nofsources, nextsource;
+  GtMutex       *mutex;
+  int           had_err;
+  GtError       *err;
+} GtStrgraphCountInfo;
+
+typedef struct {
+  GtStrgraphCountInfo *info;
+  GtStrgraphVnum      positions[GT_STRGRAPH_COUNTBUF_SIZE];
+  GtUword             nofpositions;
+  GtStrgraphLength    minmatchlen;
+} GtStrgraphCountbuf;
+
+static void gt_strgraph_countbuf_flush(GtStrgraphCountbuf *countbuf)
+{
+  GtStrgraph *strgraph = countbuf->info->strgraph;
+  GtUword idx;
+
+  gt_mutex_lock(countbuf->info->mutex);
+  for (idx = 0; idx < countbuf->nofpositions; idx++)
+  {
+    GT_STRGRAPH_INC_COUNT(strgraph, countbuf->positions[idx]);
+  }
+  if (strgraph->minmatchlen > countbuf->minmatchlen)
+    strgraph->minmatchlen = countbuf->minmatchlen;
+  gt_mutex_unlock(countbuf->info->mutex);
+  countbuf->nofpositions = 0;
+}
+
+/* as gt_spmproc_strgraph_count(), but <data> is a GtStrgraphCountbuf */
+static void gt_spmproc_strgraph_countbuf(GtUword suffix_readnum,
+    GtUword prefix_readnum, GtUword length,
+    bool suffixseq_direct, bool prefixseq_direct, void *data)
+{
+  GtStrgraphCountbuf *countbuf = data;
+
+  if (countbuf->nofpositions + 2 > GT_STRGRAPH_COUNTBUF_SIZE)
+    gt_strgraph_countbuf_flush(countbuf);
+  countbuf->positions[countbuf->nofpositions++] = suffixseq_direct
+    ? GT_STRGRAPH_V_E(suffix_readnum) : GT_STRGRAPH_V_B(suffix_readnum);
+  countbuf->positions[countbuf->nofpositions++] = prefixseq_direct
+    ? GT_STRGRAPH_V_B(prefix_readnum) : GT_STRGRAPH_V_E(prefix_readnum);
+  if (countbuf->minmatchlen > (GtStrgraphLength)length)
+    countbuf->minmatchlen = (GtStrgraphLength)length;
+}
+
+static void *gt_strgraph_count_spm_thread(void *data)
+{
+  GtStrgraphCountInfo *info = data;
+  GtStrgraphCountbuf *countbuf = gt_malloc(sizeof (*countbuf));
+  GtSpmprocSkipData skipdata;
+  GtSpmproc proc = gt_spmproc_strgraph_countbuf;
+  void *procdata = countbuf;
+  GtStr *filename = gt_str_new();
+  GtError *err = gt_error_new();
+  unsigned int source;
+  int had_err = 0;
+
+  countbuf->info = info;
+  countbuf->nofpositions = 0;
+  countbuf->minmatchlen = GT_STRGRAPH_LENGTH_MAX;
+  if (info->contained != NULL)
+  {
+    skipdata.out.e.proc = gt_spmproc_strgraph_countbuf;
+    skipdata.to_skip = info->contained;
+    skipdata.out.e.data = countbuf;
+    skipdata.skipped_counter = 0;
+    proc = gt_spmproc_skip;
+    procdata = &skipdata;
+  }
+  while (had_err == 0)
+  {
+    gt_mutex_lock(info->mutex);
+    source = info->had_err == 0 ? info->nextsource++ : info->nofsources;
+    gt_mutex_unlock(info->mutex);
+    if (source >= info->nofsources)
+      break;
+    had_err = gt_strgraph_parse_spm_source(info->indexname, info->suffix,
+        info->spmbuffers, source, info->min_length, proc, procdata, filename,
+        err);
+  }
+  gt_strgraph_countbuf_flush(countbuf);
+  if (had_err != 0)
+  {
+    gt_mutex_lock(info->mutex);
+    if (info->had_err == 0)
+    {
+      info->had_err = had_err;
+      gt_error_set(info->err, "%s", gt_error_get(err));
+    }
+    gt_mutex_unlock(info->mutex);
+  }
+  gt_error_delete(err);
+  gt_str_delete(filename);
+  gt_free(countbuf);
+  return NULL;
+}
+#endif
+
+/* count the edges of the SPMs of either the spm files <indexname>.<i><suffix>
+   or the <spmbuffers>, for i in [0, <nofsources>); the sources are parsed by
+   up to <gt_jobs> threads */
+static int gt_strgraph_count_spm(GtStrgraph *strgraph, GtUword min_length,
+    GtBitsequence *contained, const char *indexname, const char *suffix,
+    GtSpmbuffer **spmbuffers, unsigned int nofsources, GtError *err)
+{
+  int had_err = 0;
+  GtStr *filename;
+  GtSpmprocSkipData skipdata;
+  GtSpmproc proc;
+  void *procdata;
+  unsigned int i;
+
+  gt_assert(strgraph != NULL);
+  gt_assert(strgraph->state == GT_STRGRAPH_PREPARATION);
+#ifdef GT_THREADS_ENABLED
+  if (gt_jobs > 1U && nofsources > 1U)
+  {
+    GtStrgraphCountInfo info;
+    GtThread **threads;
+    unsigned int nofthreads = GT_MIN(gt_jobs, nofsources);
+
+    info.strgraph = strgraph;
+    info.min_length = min_length;
+    info.contained = contained;
+    info.indexname = indexname;
+    info.suffix = suffix;
+    info.spmbuffers = spmbuffers;
+    info.nofsources = nofsources;
+    info.nextsource = 0;
+    info.mutex = gt_mutex_new();
+    info.had_err = 0;
+    info.err = err;
+    threads = gt_malloc(sizeof (*threads) * nofthreads);
+    /* sources not taken by a thread which could not be created are parsed
+       by the other threads */
+    for (i = 1U; i < nofthreads; i++)
+      threads[i] = gt_thread_new(gt_strgraph_count_spm_thread, &info, NULL);
+    (void) gt_strgraph_count_spm_thread(&info);
+    for (i = 1U; i < nofthreads; i++)
+    {
+      if (threads[i] != NULL)
+      {
+        gt_thread_join(threads[i]);
+        gt_thread_delete(threads[i]);
+      }
+    }
+    gt_free(threads);
+    gt_mutex_delete(info.mutex);
+    return info.had_err;
+  }
+#endif
+  if (contained != NULL)
+  {
+    skipdata.out.e.proc = gt_spmproc_strgraph_count;
+    skipdata.to_skip = contained;
+    skipdata.out.e.data = strgraph;
+    skipdata.skipped_counter = 0;
+    proc = gt_spmproc_skip;
+    procdata = &skipdata;
+  }
+  else
+  {
+    proc = gt_spmproc_strgraph_count;
+    procdata = strgraph;
+  }
+  filename = gt_str_new();
+  for (i = 0; i < nofsources && had_err == 0; i++)
+  {
+    had_err = gt_strgraph_parse_spm_source(indexname, suffix, spmbuffers, i,
+        min_length, proc, procdata, filename, err);
+  }
+  gt_str_delete(filename);
+  return had_err;
+}
+
+int gt_strgraph_count_spm_from_file(GtStrgraph *strgraph, GtUword min_length,
+    GtBitsequence *contained, const char *indexname, unsigned int nspmfiles,
+    const char *suffix, GtError *err)
+{
+  return gt_strgraph_count_spm(strgraph, min_length, contained, indexname,
+      suffix, NULL, nspmfiles, err);
+}
+
+int gt_strgraph_count_spm_from_spmbuffers(GtStrgraph *strgraph,
+    GtUword min_length, GtBitsequence *contained, GtSpmbuffer **spmbuffers,
+    unsigned int nofspmbuffers, GtError *err)
+{
+  gt_assert(spmbuffers != NULL);
+  return gt_strgraph_count_spm(strgraph, min_length, contained, NULL, NULL,
+      spmbuffers, nofspmbuffers, err);
+}
+
 /* --- construction --- */
 
 void gt_strgraph_set_encseq(GtStrgraph *strgraph, const GtEncseq *encseq)
@@ -767,6 +1207,13 @@ void gt_strgraph_set_encseq(GtStrgraph *strgraph, const GtEncseq *encseq)
   strgraph->encseq = encseq;
 }
 
+void gt_strgraph_set_vrange_minsize(GtStrgraph *strgraph, GtUword minsize)
+{
+  gt_assert(strgraph != NULL);
+  strgraph->vrange_minsize = minsize > 0 ? (GtStrgraphVnum)minsize
+                                         : GT_STRGRAPH_VRANGE_MINSIZE;
+}
+
 static inline void gt_strgraph_add_edge(GtStrgraph *strgraph,
     GtStrgraphVnum from, GtStrgraphVnum to, GtStrgraphLength spmlen)
 {
@@ -824,9 +1271,21 @@ void gt_spmproc_strgraph_add(GtUword suffix_readnum,
   }
 }
 
-void gt_strgraph_sort_edges_by_len(GtStrgraph *strgraph, bool show_progressbar)
+static void gt_strgraph_sort_edges_by_len_vrange(GtStrgraphVrange *vrange)
 {
+  GtStrgraph *strgraph = vrange->strgraph;
   GtStrgraphVnum i;
+
+  for (i = vrange->from; i < vrange->to; i++)
+  {
+    GT_STRGRAPH_SORT_V_EDGES(strgraph, i);
+    if (vrange->progress != NULL)
+      (*vrange->progress)++;
+  }
+}
+
+void gt_strgraph_sort_edges_by_len(GtStrgraph *strgraph, bool show_progressbar)
+{
   GtUint64 progress = 0;
 
   gt_assert(strgraph != NULL);
@@ -835,12 +1294,9 @@ void gt_strgraph_sort_edges_by_len(GtStrgraph *strgraph, bool show_progressbar)
     gt_progressbar_start(&progress,
         (GtUint64)GT_STRGRAPH_NOFVERTICES(strgraph));
 
-  for (i = 0; i < GT_STRGRAPH_NOFVERTICES(strgraph); i++)
-  {
-    GT_STRGRAPH_SORT_V_EDGES(strgraph, i);
-    if (show_progressbar)
-      progress++;
-  }
+  (void) gt_strgraph_process_vranges(strgraph,
+      gt_strgraph_sort_edges_by_len_vrange, NULL,
+      show_progressbar ? &progress : NULL);
 
   strgraph->state = GT_STRGRAPH_SORTED_BY_L;
 
@@ -864,13 +1320,13 @@ static void gt_strgraph_check_outdegs(GtStrgraph *strgraph)
 }
 #endif
 
-static GtUword gt_strgraph_reduce_marked_edges(GtStrgraph *strgraph)
+static void gt_strgraph_reduce_marked_edges_vrange(GtStrgraphVrange *vrange)
 {
+  GtStrgraph *strgraph = vrange->strgraph;
   GtStrgraphVnum i;
-  GtUword counter = 0;
   GtStrgraphVEdgenum j;
 
-  for (i = 0; i < GT_STRGRAPH_NOFVERTICES(strgraph); i++)
+  for (i = vrange->from; i < vrange->to; i++)
   {
     if (GT_STRGRAPH_V_OUTDEG(strgraph, i) == 0)
       continue;
@@ -882,28 +1338,25 @@ static GtUword gt_strgraph_reduce_marked_edges(GtStrgraph *strgraph)
       {
         GT_STRGRAPH_EDGE_REDUCE(strgraph, i, j);
         GT_STRGRAPH_V_DEC_OUTDEG(strgraph, i);
-        counter++;
+        vrange->counter++;
       }
     }
   }
-  return counter;
 }
 
-/* return value: number of self edges */
-GtUword gt_strgraph_redself(GtStrgraph *strgraph, bool show_progressbar)
+static GtUword gt_strgraph_reduce_marked_edges(GtStrgraph *strgraph)
 {
+  return gt_strgraph_process_vranges(strgraph,
+      gt_strgraph_reduce_marked_edges_vrange, NULL, NULL);
+}
+
+static void gt_strgraph_redself_vrange(GtStrgraphVrange *vrange)
+{
+  GtStrgraph *strgraph = vrange->strgraph;
   GtStrgraphVnum vnum;
   GtStrgraphVEdgenum edgenum;
-  GtUword counter = 0;
-  GtUint64 progress = 0;
-
-  gt_assert(strgraph != NULL);
 
-  counter = 0;
-  if (show_progressbar)
-    gt_progressbar_start(&(progress),
-        (GtUint64)GT_STRGRAPH_NOFVERTICES(strgraph));
-  for (vnum = 0; vnum < GT_STRGRAPH_NOFVERTICES(strgraph); vnum++)
+  for (vnum = vrange->from; vnum < vrange->to; vnum++)
   {
     if (GT_STRGRAPH_V_OUTDEG(strgraph, vnum) > 0)
     {
@@ -913,15 +1366,30 @@ GtUword gt_strgraph_redself(GtStrgraph *strgraph, bool show_progressbar)
         if (!GT_STRGRAPH_EDGE_IS_REDUCED(strgraph, vnum, edgenum) &&
             GT_STRGRAPH_EDGE_DEST(strgraph, vnum, edgenum) == vnum)
         {
-          counter++;
+          vrange->counter++;
           GT_STRGRAPH_EDGE_REDUCE(strgraph, vnum, edgenum);
           GT_STRGRAPH_V_DEC_OUTDEG(strgraph, vnum);
         }
       }
     }
-    if (show_progressbar)
-      progress++;
+    if (vrange->progress != NULL)
+      (*vrange->progress)++;
   }
+}
+
+/* return value: number of self edges */
+GtUword gt_strgraph_redself(GtStrgraph *strgraph, bool show_progressbar)
+{
+  GtUword counter;
+  GtUint64 progress = 0;
+
+  gt_assert(strgraph != NULL);
+
+  if (show_progressbar)
+    gt_progressbar_start(&progress,
+        (GtUint64)GT_STRGRAPH_NOFVERTICES(strgraph));
+  counter = gt_strgraph_process_vranges(strgraph, gt_strgraph_redself_vrange,
+      NULL, show_progressbar ? &progress : NULL);
   if (show_progressbar)
     gt_progressbar_stop();
 
@@ -934,25 +1402,13 @@ GtUword gt_strgraph_redself(GtStrgraph *strgraph, bool show_progressbar)
   return (counter >> 1);
 }
 
-/* return value: number of with-rc edges */
-GtUword gt_strgraph_redwithrc(GtStrgraph *strgraph, bool show_progressbar)
+static void gt_strgraph_redwithrc_vrange(GtStrgraphVrange *vrange)
 {
+  GtStrgraph *strgraph = vrange->strgraph;
   GtStrgraphVnum vnum;
   GtStrgraphVEdgenum edgenum;
-  GtUword counter = 0;
-  GtUint64 progress = 0;
-
-  gt_assert(strgraph != NULL);
 
-  if (show_progressbar)
-    gt_progressbar_start(&progress,
-        (GtUint64)GT_STRGRAPH_NOFVERTICES(strgraph));
-
-  counter = 0;
-  if (show_progressbar)
-    gt_progressbar_start(&(progress),
-        (GtUint64)GT_STRGRAPH_NOFVERTICES(strgraph));
-  for (vnum = 0; vnum < GT_STRGRAPH_NOFVERTICES(strgraph); vnum++)
+  for (vnum = vrange->from; vnum < vrange->to; vnum++)
   {
     if (GT_STRGRAPH_V_OUTDEG(strgraph, vnum) > 0)
     {
@@ -963,15 +1419,30 @@ GtUword gt_strgraph_redwithrc(GtStrgraph *strgraph, bool show_progressbar)
             GT_STRGRAPH_EDGE_DEST(strgraph, vnum, edgenum) ==
             GT_STRGRAPH_V_OTHER(vnum))
         {
-          counter++;
+          vrange->counter++;
           GT_STRGRAPH_EDGE_REDUCE(strgraph, vnum, edgenum);
           GT_STRGRAPH_V_DEC_OUTDEG(strgraph, vnum);
         }
       }
     }
-    if (show_progressbar)
-      progress++;
+    if (vrange->progress != NULL)
+      (*vrange->progress)++;
   }
+}
+
+/* return value: number of with-rc edges */
+GtUword gt_strgraph_redwithrc(GtStrgraph *strgraph, bool show_progressbar)
+{
+  GtUword counter;
+  GtUint64 progress = 0;
+
+  gt_assert(strgraph != NULL);
+
+  if (show_progressbar)
+    gt_progressbar_start(&progress,
+        (GtUint64)GT_STRGRAPH_NOFVERTICES(strgraph));
+  counter = gt_strgraph_process_vranges(strgraph, gt_strgraph_redwithrc_vrange,
+      NULL, show_progressbar ? &progress : NULL);
   if (show_progressbar)
     gt_progressbar_stop();
 
@@ -984,35 +1455,56 @@ GtUword gt_strgraph_redwithrc(GtStrgraph *strgraph, bool show_progressbar)
   return (counter >> 1);
 }
 
-/* return value: number of transitive edges */
-GtUword gt_strgraph_redtrans(GtStrgraph *strgraph, bool show_progressbar)
+static int gt_strgraph_vnum_compare(const void *a, const void *b)
 {
+  GtStrgraphVnum va = *(const GtStrgraphVnum*)a,
+                 vb = *(const GtStrgraphVnum*)b;
+  return va < vb ? -1 : (va > vb ? 1 : 0);
+}
+
+/* if the range covers all vertices, the destinations of the edges of a vertex
+   are found by the vertex marks and the transitive edges are marked at once;
+   otherwise the edges to be marked are only collected, as the edges of the
+   destinations of the edges of a vertex may be outside of the range */
+static void gt_strgraph_redtrans_vrange(GtStrgraphVrange *vrange)
+{
+  GtStrgraph *strgraph = vrange->strgraph;
   GtStrgraphLength jlen, klen, longest;
-  GtStrgraphVEdgenum j, k, l;
+  GtStrgraphVEdgenum j, k, l, nofedges;
   GtStrgraphVnum i, jdest, kdest;
-  GtUword counter;
-  GtUint64 progress = 0;
+  GtStrgraphEdgeref edgeref;
+  bool is_dest;
 
-  gt_assert(strgraph != NULL);
-  gt_assert(strgraph->state == GT_STRGRAPH_SORTED_BY_L);
-
-  for (i = 0; i < GT_STRGRAPH_NOFVERTICES(strgraph); i++)
-    GT_STRGRAPH_V_SET_MARK(strgraph, i, GT_STRGRAPH_V_VACANT);
-
-  if (show_progressbar)
-    gt_progressbar_start(&progress,
-        (GtUint64)GT_STRGRAPH_NOFVERTICES(strgraph));
-  for (i = 0; i < GT_STRGRAPH_NOFVERTICES(strgraph); i++)
+  for (i = vrange->from; i < vrange->to; i++)
   {
     if (GT_STRGRAPH_V_OUTDEG(strgraph, i) > 0)
     {
-      for (j = 0; j < GT_STRGRAPH_V_NOFEDGES(strgraph, i); j++)
+      nofedges = GT_STRGRAPH_V_NOFEDGES(strgraph, i);
+      if (vrange->onlyrange)
       {
-        GT_STRGRAPH_V_SET_MARK(strgraph, GT_STRGRAPH_EDGE_DEST(strgraph, i, j),
-            GT_STRGRAPH_V_INPLAY);
+        for (j = 0; j < nofedges; j++)
+        {
+          GT_STRGRAPH_V_SET_MARK(strgraph,
+              GT_STRGRAPH_EDGE_DEST(strgraph, i, j), GT_STRGRAPH_V_INPLAY);
+        }
+      }
+      else
+      {
+        if ((GtUword)nofedges > vrange->dests_size)
+        {
+          vrange->dests_size = (GtUword)nofedges;
+          vrange->dests = gt_realloc(vrange->dests,
+              sizeof (*vrange->dests) * vrange->dests_size);
+        }
+        /* the sorted destinations replace the marks of the vertices,
+           which are shared among the ranges */
+        for (j = 0; j < nofedges; j++)
+          vrange->dests[j] = GT_STRGRAPH_EDGE_DEST(strgraph, i, j);
+        qsort(vrange->dests, (size_t)nofedges, sizeof (*vrange->dests),
+              gt_strgraph_vnum_compare);
       }
       GT_STRGRAPH_FIND_LONGEST_EDGE(strgraph, i, longest);
-      for (j = 0; j < GT_STRGRAPH_V_NOFEDGES(strgraph, i); j++)
+      for (j = 0; j < nofedges; j++)
       {
         jdest = GT_STRGRAPH_EDGE_DEST(strgraph, i, j);
         jlen = GT_STRGRAPH_EDGE_LEN(strgraph, i, j);
@@ -1021,30 +1513,78 @@ GtUword gt_strgraph_redtrans(GtStrgraph *strgraph, bool show_progressbar)
         {
           kdest = GT_STRGRAPH_EDGE_DEST(strgraph, jdest, k);
           klen = GT_STRGRAPH_EDGE_LEN(strgraph, jdest, k);
-          if (GT_STRGRAPH_V_MARK(strgraph, kdest) == GT_STRGRAPH_V_INPLAY)
+          if (vrange->onlyrange)
+            is_dest = GT_STRGRAPH_V_MARK(strgraph, kdest)
+                      == GT_STRGRAPH_V_INPLAY;
+          else
+            is_dest = bsearch(&kdest, vrange->dests, (size_t)nofedges,
+                              sizeof (*vrange->dests),
+                              gt_strgraph_vnum_compare) != NULL;
+          if (is_dest)
           {
-            for (l = 0; l < GT_STRGRAPH_V_NOFEDGES(strgraph, i); l++)
+            for (l = 0; l < nofedges; l++)
             {
               if (GT_STRGRAPH_EDGE_DEST(strgraph, i, l) == kdest &&
                   GT_STRGRAPH_EDGE_LEN(strgraph, i, l) == jlen + klen)
               {
-                GT_STRGRAPH_EDGE_SET_MARK(strgraph, i, l);
+                if (vrange->onlyrange)
+                {
+                  GT_STRGRAPH_EDGE_SET_MARK(strgraph, i, l);
+                }
+                else
+                {
+                  edgeref.v = i;
+                  edgeref.edgenum = l;
+                  GT_STOREINARRAY(&vrange->marked, GtStrgraphEdgeref, 256,
+                                  edgeref);
+                }
               }
             }
           }
         }
       }
-      for (j = 0; j < GT_STRGRAPH_V_NOFEDGES(strgraph, i); j++)
+      if (vrange->onlyrange)
       {
-        GT_STRGRAPH_V_SET_MARK(strgraph, GT_STRGRAPH_EDGE_DEST(strgraph, i, j),
-            GT_STRGRAPH_V_VACANT);
+        for (j = 0; j < nofedges; j++)
+        {
+          GT_STRGRAPH_V_SET_MARK(strgraph,
+              GT_STRGRAPH_EDGE_DEST(strgraph, i, j), GT_STRGRAPH_V_VACANT);
+        }
       }
     }
-    if (show_progressbar)
-      progress++;
+    if (vrange->progress != NULL)
+      (*vrange->progress)++;
   }
+}
+
+/* return value: number of transitive edges */
+GtUword gt_strgraph_redtrans(GtStrgraph *strgraph, bool show_progressbar)
+{
+  GtArrayGtStrgraphEdgeref marked;
+  GtUword counter, idx;
+  GtUint64 progress = 0;
+
+  gt_assert(strgraph != NULL);
+  gt_assert(strgraph->state == GT_STRGRAPH_SORTED_BY_L);
+
+  for (idx = 0; idx < (GtUword)GT_STRGRAPH_NOFVERTICES(strgraph); idx++)
+    GT_STRGRAPH_V_SET_MARK(strgraph, idx, GT_STRGRAPH_V_VACANT);
+
+  GT_INITARRAY(&marked, GtStrgraphEdgeref);
+  if (show_progressbar)
+    gt_progressbar_start(&progress,
+        (GtUint64)GT_STRGRAPH_NOFVERTICES(strgraph));
+  (void) gt_strgraph_process_vranges(strgraph, gt_strgraph_redtrans_vrange,
+      &marked, show_progressbar ? &progress : NULL);
   if (show_progressbar)
     gt_progressbar_stop();
+  for (idx = 0; idx < marked.nextfreeGtStrgraphEdgeref; idx++)
+  {
+    GT_STRGRAPH_EDGE_SET_MARK(strgraph,
+        marked.spaceGtStrgraphEdgeref[idx].v,
+        marked.spaceGtStrgraphEdgeref[idx].edgenum);
+  }
+  GT_FREEARRAY(&marked, GtStrgraphEdgeref);
 
   counter = gt_strgraph_reduce_marked_edges(strgraph);
   gt_log_log("transitive counter: "GT_WU"", counter);
@@ -22,6 +22,7 @@
 #include "core/encseq_api.h"
 #include "core/logger_api.h"
 #include "core/error_api.h"
+#include "match/rdj-spmbuffer.h"
 
 typedef struct GtStrgraph GtStrgraph;
 
@@ -39,11 +40,29 @@ int gt_strgraph_save_counts(GtStrgraph *strgraph, const char *indexname,
 int gt_strgraph_load_counts(GtStrgraph *strgraph, const char *indexname,
     const char *suffix, GtError *err);
 
+/* count the edges of the SPMs of length at least <min_length> in the spm files
+   <indexname>.<i><suffix>, for i in [0, <nspmfiles>), skipping the SPMs of
+   the reads in <contained>, if not NULL; the files are parsed by up to
+   <gt_jobs> threads */
+int gt_strgraph_count_spm_from_file(GtStrgraph *strgraph, GtUword min_length,
+    GtBitsequence *contained, const char *indexname, unsigned int nspmfiles,
+    const char *suffix, GtError *err);
+
+/* as gt_strgraph_count_spm_from_file(), but the SPMs are read from the
+   <nofspmbuffers> buffers in <spmbuffers> */
+int gt_strgraph_count_spm_from_spmbuffers(GtStrgraph *strgraph,
+    GtUword min_length, GtBitsequence *contained, GtSpmbuffer **spmbuffers,
+    unsigned int nofspmbuffers, GtError *err);
+
 /* to reduce the memory requirement, the encseq may be freed during the life of
  * strgraph and later reloaded; this method allows one to communicate the
  * changes to the strgraph object (set to NULL by deletion) */
 void gt_strgraph_set_encseq(GtStrgraph *strgraph, const GtEncseq *encseq);
 
+/* set the minimal number of vertices processed by each thread in the passes
+   over vertex ranges to <minsize>; 0 restores the default of 65536 */
+void gt_strgraph_set_vrange_minsize(GtStrgraph *strgraph, GtUword minsize);
+
 /* --- spmlist file --- */
 
 int gt_strgraph_open_spmlist_file(GtStrgraph *strgraph, const char *indexname,
@@ -60,6 +79,12 @@ int gt_strgraph_load_spm_from_file(GtStrgraph *strgraph,
     const char *indexname, unsigned int nspmfiles, const char *suffix,
     GtError *err);
 
+/* as gt_strgraph_load_spm_from_file(), but the SPMs are read from the
+   <nofspmbuffers> buffers in <spmbuffers> */
+int gt_strgraph_load_spm_from_spmbuffers(GtStrgraph *strgraph,
+    GtUword min_length, bool load_self_spm, GtBitsequence *contained,
+    GtSpmbuffer **spmbuffers, unsigned int nofspmbuffers, GtError *err);
+
 /* --- construction --- */
 
 void gt_strgraph_allocate_graph(GtStrgraph *strgraph, GtUword fixlen,
@@ -17,15 +17,20 @@
 
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "core/array2dim_api.h"
+#include "core/array_api.h"
 #include "core/chardef_api.h"
 #include "core/divmodmul_api.h"
 #include "core/format64.h"
 #include "core/log_api.h"
 #include "core/logger.h"
+#include "core/minmax_api.h"
 #include "core/safearith_api.h"
 #include "core/stack-inlined.h"
+#include "core/thread_api.h"
+#include "core/undef_api.h"
 #include "core/unused_api.h"
 
 #include "match/eis-voiditf.h"
@@ -149,6 +154,29 @@ static inline GtUword get_start_idx_binary_search(ShuNode *parent,
   return start_idx;
 }
 
+static inline void reset_shu_node(ShuNode *node,
+                                  GtUword numofchars,
+                                  GtUword num_of_genomes)
+{
+  if (node->countTermSubtree == NULL)
+  {
+    gt_array2dim_calloc(node->countTermSubtree,
+                        numofchars+1UL,
+                        num_of_genomes);
+  }
+  else
+  {
+    GtUword y_idx, file_idx;
+    for (y_idx = 0; y_idx < numofchars+1UL; y_idx++)
+    {
+      for (file_idx = 0; file_idx < num_of_genomes; file_idx++)
+      {
+        node->countTermSubtree[y_idx][file_idx] = 0;
+      }
+    }
+  }
+}
+
 static int visit_shu_children(const FMindex *index,
                               ShuNode *parent,
                               GtStackShuNode *stack,
@@ -213,25 +241,7 @@ static int visit_shu_children(const FMindex *index,
           ShuNode *child = NULL;
 
           GT_STACK_NEXT_FREE(stack,child);
-          if (child->countTermSubtree == NULL)
-          {
-            gt_array2dim_calloc(child->countTermSubtree,
-                                numofchars+1UL,
-                                unit_info->num_of_genomes);
-          }
-          else
-          {
-            GtUword y_idx, file_idx;
-            for (y_idx = 0; y_idx < numofchars+1UL; y_idx++)
-            {
-              for (file_idx = 0;
-                   file_idx < unit_info->num_of_genomes;
-                   file_idx++)
-              {
-                child->countTermSubtree[y_idx][file_idx] = 0;
-              }
-            }
-          }
+          reset_shu_node(child, numofchars, unit_info->num_of_genomes);
           child->process = false;
           child->lower = tmpmbtab[idx].lowerbound;
           child->upper = tmpmbtab[idx].upperbound;
@@ -393,101 +403,455 @@ static int initialise_node(void *node)
   return had_err;
 }
 
-int gt_pck_calculate_shulen(const FMindex *index,
-                            const GtShuUnitFileInfo *unit_info,
-                            uint64_t **shulen,
-                            GtUword numofchars,
-                            GtUword total_length,
-                            GtTimer *timer,
-                            GtLogger *logger,
-                            GtError *err)
-{
-  int had_err = 0;
+/* A subtree of the virtual suffix tree below the split depth, which is
+   traversed independently of the other subtrees. <counts> receives the
+   number of suffixes of each genome in the subtree. */
+typedef struct {
+  GtUword lower,
+          upper,
+          depth,
+          *counts;
+} ShuSubtree;
+
+typedef enum {
+  SHU_DFS_FULL,     /* traverse the whole tree below the root */
+  SHU_DFS_COLLECT,  /* only collect the subtrees at the split depth */
+  SHU_DFS_COMBINE   /* use the counts of the collected subtrees */
+} ShuDfsMode;
+
+typedef struct {
+  const FMindex *index;
+  const GtShuUnitFileInfo *unit_info;
   GtStackShuNode stack;
-  ShuNode *root;
   Mbtab *tmpmbtab;
-  const GtUword resize = 64UL;
-  GtUword *rangeOccs,
-                **special_char_rows_and_pos,
-                depth_idx,
-                processed_nodes,
-                max_idx = gt_pck_special_occ_in_nonspecial_intervals(index) - 1;
   BwtSeqpositionextractor *pos_extractor;
-  const GtEncseq *encseq = unit_info->encseq;
+  GtUword *rangeOccs,
+          **special_pos,
+          numofchars,
+          total_length,
+          max_idx,
+          processed_nodes;
+} ShuDfsState;
+
+static void shu_dfs_state_init(ShuDfsState *state,
+                               const FMindex *index,
+                               const GtShuUnitFileInfo *unit_info,
+                               GtUword numofchars,
+                               GtUword total_length,
+                               GtUword max_idx)
+{
+  const GtUword resize = 64UL;
 
-  gt_assert(max_idx < total_length);
-  rangeOccs = gt_calloc((size_t) GT_MULT2(numofchars), sizeof (*rangeOccs));
-  tmpmbtab = gt_calloc((size_t) (numofchars + 3), sizeof (*tmpmbtab ));
-  GT_STACK_INIT_WITH_INITFUNC(&stack, resize, initialise_node);
-  pos_extractor = gt_newBwtSeqpositionextractor(index, total_length + 1);
-  if (timer != NULL)
+  state->index = index;
+  state->unit_info = unit_info;
+  state->numofchars = numofchars;
+  state->total_length = total_length;
+  state->max_idx = max_idx;
+  state->special_pos = NULL;
+  state->processed_nodes = 0;
+  state->rangeOccs = gt_calloc((size_t) GT_MULT2(numofchars),
+                               sizeof (*state->rangeOccs));
+  state->tmpmbtab = gt_calloc((size_t) (numofchars + 3),
+                              sizeof (*state->tmpmbtab));
+  GT_STACK_INIT_WITH_INITFUNC(&state->stack, resize, initialise_node);
+  state->pos_extractor = gt_newBwtSeqpositionextractor(index,
+                                                       total_length + 1);
+}
+
+static void shu_dfs_state_delete(ShuDfsState *state)
+{
+  GtUword depth_idx;
+
+  for (depth_idx = 0; depth_idx < GT_STACK_MAXSIZE(&state->stack);
+       depth_idx++)
   {
-    gt_timer_show_progress(timer, "obtain special pos", stdout);
+    gt_array2dim_delete(state->stack.space[depth_idx].countTermSubtree);
   }
-  special_char_rows_and_pos = get_special_pos(index,
-                                              pos_extractor,
-                                              max_idx + 1);
-  GT_STACK_NEXT_FREE(&stack,root);
-  gt_array2dim_calloc(root->countTermSubtree,
-                      numofchars+1UL,
-                      unit_info->num_of_genomes);
+  GT_STACK_DELETE(&state->stack);
+  gt_free(state->rangeOccs);
+  gt_free(state->tmpmbtab);
+  gt_freeBwtSeqpositionextractor(state->pos_extractor);
+}
+
+/* Traverses the virtual suffix tree below the node with the given bounds
+   and depth and adds the shulen contributions of its nodes to <shulen>.
+   Unvisited nodes other than the root which have reached <split_depth>
+   are appended to <subtrees> in mode SHU_DFS_COLLECT and skipped, and
+   replaced by the counts of the next entry of <subtrees> in mode
+   SHU_DFS_COMBINE. Both modes visit the nodes above the split depth in
+   the same order. */
+static int shu_dfs(ShuDfsState *state,
+                   GtUword lower,
+                   GtUword upper,
+                   GtUword depth,
+                   ShuDfsMode mode,
+                   GtUword split_depth,
+                   GtArray *subtrees,
+                   uint64_t **shulen,
+                   GtLogger *logger,
+                   GtError *err)
+{
+  int had_err = 0;
+  GtUword num_of_genomes = state->unit_info->num_of_genomes,
+          next_subtree = 0;
+  GtStackShuNode *stack = &state->stack;
+  ShuNode *root;
+
+  gt_assert(GT_STACK_ISEMPTY(stack));
+  GT_STACK_NEXT_FREE(stack,root);
+  reset_shu_node(root, state->numofchars, num_of_genomes);
   root->process = false;
   root->parentOffset = 0;
-  root->depth = 0;
-  root->lower = 0;
-  root->upper = total_length + 1;
+  root->depth = depth;
+  root->lower = lower;
+  root->upper = upper;
 
-  if (timer != NULL)
-  {
-    gt_timer_show_progress(timer, "traverse virtual tree", stdout);
-  }
-  processed_nodes = 0;
-  while (!had_err && !GT_STACK_ISEMPTY(&stack))
+  while (!had_err && !GT_STACK_ISEMPTY(stack))
   {
     ShuNode *current;
 
-    gt_assert(stack.nextfree > 0);
-    current = stack.space + stack.nextfree -1;
-    if (current->process)
+    gt_assert(stack->nextfree > 0);
+    current = stack->space + stack->nextfree -1;
+    if (mode != SHU_DFS_FULL && !current->process &&
+        current->parentOffset > 0 && current->depth >= split_depth)
+    {
+      GT_STACK_DECREMENTTOP(stack);
+      if (mode == SHU_DFS_COLLECT)
+      {
+        ShuSubtree subtree;
+
+        subtree.lower = current->lower;
+        subtree.upper = current->upper;
+        subtree.depth = current->depth;
+        subtree.counts = NULL;
+        gt_array_add(subtrees, subtree);
+      }
+      else
+      {
+        ShuNode *parent = stack->space + stack->nextfree -
+                          current->parentOffset;
+        ShuSubtree *subtree = gt_array_get(subtrees, next_subtree++);
+        GtUword idx_i;
+
+        gt_assert(subtree->lower == current->lower &&
+                  subtree->upper == current->upper);
+        for (idx_i = 0; idx_i < num_of_genomes; idx_i++)
+        {
+          if (subtree->counts[idx_i] > 0)
+          {
+            parent->countTermSubtree[0][idx_i] += subtree->counts[idx_i];
+            parent->countTermSubtree[current->parentOffset][idx_i] =
+                                                       subtree->counts[idx_i];
+          }
+        }
+      }
+    }
+    else if (current->process)
     {
-      GT_STACK_DECREMENTTOP(&stack);
+      GT_STACK_DECREMENTTOP(stack);
+      if (mode != SHU_DFS_COLLECT)
+      {
         had_err = process_shu_node(current,
-                                   &stack,
+                                   stack,
                                    shulen,
-                                   unit_info->num_of_genomes,
-                                   numofchars,
+                                   num_of_genomes,
+                                   state->numofchars,
                                    logger,
                                    err);
-      processed_nodes++;
+      }
+      state->processed_nodes++;
     }
     else
     {
-      had_err = visit_shu_children(index,
+      had_err = visit_shu_children(state->index,
                                    current,
-                                   &stack,
-                                   encseq,
-                                   tmpmbtab,
-                                   pos_extractor,
-                                   rangeOccs,
-                                   special_char_rows_and_pos,
-                                   numofchars,
-                                   unit_info,
-                                   total_length,
-                                   max_idx,
+                                   stack,
+                                   state->unit_info->encseq,
+                                   state->tmpmbtab,
+                                   state->pos_extractor,
+                                   state->rangeOccs,
+                                   state->special_pos,
+                                   state->numofchars,
+                                   state->unit_info,
+                                   state->total_length,
+                                   state->max_idx,
                                    logger,
                                    err);
     }
   }
-  gt_logger_log(logger, "max stack depth = "GT_WU"", GT_STACK_MAXSIZE(&stack));
-  gt_log_log("processed nodes= "GT_WU"", processed_nodes);
-  for (depth_idx = 0; depth_idx < GT_STACK_MAXSIZE(&stack); depth_idx++)
+  gt_assert(had_err || mode != SHU_DFS_COMBINE ||
+            next_subtree == gt_array_size(subtrees));
+  stack->nextfree = 0;
+  return had_err;
+}
+
+typedef struct {
+  GtArray *subtrees;
+  GtUword next_subtree;
+  GtMutex *mutex;
+} ShuSubtreeQueue;
+
+typedef struct {
+  ShuDfsState state;
+  ShuSubtreeQueue *queue;
+  uint64_t **shulen;
+  GtLogger *logger;
+  GtError *err;
+  int had_err;
+} ShuWorker;
+
+static void *shu_worker_run(void *data)
+{
+  ShuWorker *worker = (ShuWorker *) data;
+  ShuSubtreeQueue *queue = worker->queue;
+  GtUword num_of_genomes = worker->state.unit_info->num_of_genomes;
+
+  while (!worker->had_err)
+  {
+    ShuSubtree *subtree = NULL;
+
+    gt_mutex_lock(queue->mutex);
+    if (queue->next_subtree < gt_array_size(queue->subtrees))
+    {
+      subtree = gt_array_get(queue->subtrees, queue->next_subtree++);
+    }
+    gt_mutex_unlock(queue->mutex);
+    if (subtree == NULL)
+    {
+      break;
+    }
+    worker->had_err = shu_dfs(&worker->state,
+                              subtree->lower,
+                              subtree->upper,
+                              subtree->depth,
+                              SHU_DFS_FULL,
+                              GT_UNDEF_UWORD,
+                              NULL,
+                              worker->shulen,
+                              worker->logger,
+                              worker->err);
+    if (!worker->had_err)
+    {
+      /* the root of the traversal stays in place after it is popped */
+      memcpy(subtree->counts,
+             worker->state.stack.space[0].countTermSubtree[0],
+             sizeof (*subtree->counts) * num_of_genomes);
+    }
+  }
+  return NULL;
+}
+
+/* Traverses the subtrees in <queue> with up to <gt_jobs> threads, each
+   of which sums up the shulen of its subtrees separately. The sums are
+   added to <shulen> in the order of the threads, the result does not
+   depend on which thread processed which subtree. */
+static int shu_traverse_subtrees(const ShuDfsState *main_state,
+                                 ShuSubtreeQueue *queue,
+                                 uint64_t **shulen,
+                                 GtLogger *logger,
+                                 GtError *err)
+{
+  int had_err = 0;
+  GtUword idx, idx_i, idx_j, numthreads = 1UL,
+          num_of_genomes = main_state->unit_info->num_of_genomes;
+  ShuWorker *workers;
+#ifdef GT_THREADS_ENABLED
+  GtThread **threads;
+#endif
+
+#ifdef GT_THREADS_ENABLED
+  numthreads = GT_MIN((GtUword) gt_jobs, gt_array_size(queue->subtrees));
+  if (numthreads == 0)
+    numthreads = 1UL;
+  threads = gt_calloc((size_t) numthreads, sizeof (*threads));
+#endif
+  workers = gt_calloc((size_t) numthreads, sizeof (*workers));
+  for (idx = 0; idx < numthreads; idx++)
+  {
+    const FMindex *index = main_state->index;
+
+    if (idx > 0)
+    {
+      /* each thread needs its own query state of the index */
+      index = gt_newvoidBWTSeqView(main_state->index);
+      if (index == NULL)
+      {
+        gt_log_log("index does not support concurrent queries, using "
+                   GT_WU " thread(s)", idx);
+        numthreads = idx;
+        break;
+      }
+    }
+    shu_dfs_state_init(&workers[idx].state,
+                       index,
+                       main_state->unit_info,
+                       main_state->numofchars,
+                       main_state->total_length,
+                       main_state->max_idx);
+    workers[idx].state.special_pos = main_state->special_pos;
+    workers[idx].queue = queue;
+    workers[idx].logger = logger;
+    if (idx == 0)
+    {
+      workers[idx].shulen = shulen;
+      workers[idx].err = err;
+    }
+    else
+    {
+      gt_array2dim_calloc(workers[idx].shulen, num_of_genomes,
+                          num_of_genomes);
+      workers[idx].err = gt_error_new();
+    }
+  }
+#ifdef GT_THREADS_ENABLED
+  for (idx = 1UL; idx < numthreads; idx++)
+  {
+    threads[idx] = gt_thread_new(shu_worker_run, workers + idx, NULL);
+  }
+#endif
+  (void) shu_worker_run(workers);
+#ifdef GT_THREADS_ENABLED
+  for (idx = 1UL; idx < numthreads; idx++)
+  {
+    if (threads[idx] != NULL)
+    {
+      gt_thread_join(threads[idx]);
+      gt_thread_delete(threads[idx]);
+    }
+    else
+    {
+      /* could not start the thread, run it here instead */
+      (void) shu_worker_run(workers + idx);
+    }
+  }
+  gt_free(threads);
+#endif
+  for (idx = 0; idx < numthreads; idx++)
+  {
+    if (!had_err && workers[idx].had_err)
+    {
+      had_err = -1;
+      if (idx > 0)
+      {
+        gt_error_set(err, "%s", gt_error_get(workers[idx].err));
+      }
+    }
+    if (idx > 0)
+    {
+      for (idx_i = 0; !had_err && idx_i < num_of_genomes; idx_i++)
+      {
+        for (idx_j = 0; !had_err && idx_j < num_of_genomes; idx_j++)
+        {
+          uint64_t old = shulen[idx_i][idx_j];
+
+          shulen[idx_i][idx_j] += workers[idx].shulen[idx_i][idx_j];
+          if (shulen[idx_i][idx_j] < old)
+          {
+            had_err = -1;
+            gt_error_set(err, "overflow in addition of shuSums! "
+                              Formatuint64_t "+ " Formatuint64_t "\n",
+                         PRINTuint64_tcast(old),
+                         PRINTuint64_tcast(workers[idx].shulen[idx_i][idx_j]));
+          }
+        }
+      }
+      gt_array2dim_delete(workers[idx].shulen);
+      gt_error_delete(workers[idx].err);
+      gt_deletevoidBWTSeqView((FMindex *) workers[idx].state.index);
+    }
+    gt_log_log("thread " GT_WU " processed nodes= " GT_WU, idx,
+               workers[idx].state.processed_nodes);
+    shu_dfs_state_delete(&workers[idx].state);
+  }
+  gt_free(workers);
+  return had_err;
+}
+
+int gt_pck_calculate_shulen(const FMindex *index,
+                            const GtShuUnitFileInfo *unit_info,
+                            uint64_t **shulen,
+                            GtUword numofchars,
+                            GtUword total_length,
+                            GtUword split_depth,
+                            GtTimer *timer,
+                            GtLogger *logger,
+                            GtError *err)
+{
+  int had_err = 0;
+  ShuDfsState state;
+  GtUword max_idx = gt_pck_special_occ_in_nonspecial_intervals(index) - 1;
+
+  gt_assert(max_idx < total_length);
+  shu_dfs_state_init(&state, index, unit_info, numofchars, total_length,
+                     max_idx);
+  if (timer != NULL)
+  {
+    gt_timer_show_progress(timer, "obtain special pos", stdout);
+  }
+  state.special_pos = get_special_pos(index,
+                                      state.pos_extractor,
+                                      max_idx + 1);
+  if (split_depth == 0)
+  {
+    if (timer != NULL)
+    {
+      gt_timer_show_progress(timer, "traverse virtual tree", stdout);
+    }
+    had_err = shu_dfs(&state, 0, total_length + 1, 0, SHU_DFS_FULL,
+                      GT_UNDEF_UWORD, NULL, shulen, logger, err);
+  }
+  else
   {
-    gt_array2dim_delete(stack.space[depth_idx].countTermSubtree);
+    ShuSubtreeQueue queue;
+    GtUword idx;
+
+    if (timer != NULL)
+    {
+      gt_timer_show_progress(timer, "split virtual tree", stdout);
+    }
+    queue.subtrees = gt_array_new(sizeof (ShuSubtree));
+    queue.next_subtree = 0;
+    queue.mutex = gt_mutex_new();
+    had_err = shu_dfs(&state, 0, total_length + 1, 0, SHU_DFS_COLLECT,
+                      split_depth, queue.subtrees, NULL, logger, err);
+    gt_logger_log(logger, "subtrees at depth " GT_WU " = " GT_WU,
+                  split_depth, gt_array_size(queue.subtrees));
+    for (idx = 0; idx < gt_array_size(queue.subtrees); idx++)
+    {
+      ShuSubtree *subtree = gt_array_get(queue.subtrees, idx);
+      subtree->counts = gt_calloc((size_t) unit_info->num_of_genomes,
+                                  sizeof (*subtree->counts));
+    }
+    if (!had_err)
+    {
+      if (timer != NULL)
+      {
+        gt_timer_show_progress(timer, "traverse subtrees", stdout);
+      }
+      had_err = shu_traverse_subtrees(&state, &queue, shulen, logger, err);
+    }
+    if (!had_err)
+    {
+      if (timer != NULL)
+      {
+        gt_timer_show_progress(timer, "traverse virtual tree top",
+                               stdout);
+      }
+      had_err = shu_dfs(&state, 0, total_length + 1, 0, SHU_DFS_COMBINE,
+                        split_depth, queue.subtrees, shulen, logger, err);
+    }
+    for (idx = 0; idx < gt_array_size(queue.subtrees); idx++)
+    {
+      ShuSubtree *subtree = gt_array_get(queue.subtrees, idx);
+      gt_free(subtree->counts);
+    }
+    gt_array_delete(queue.subtrees);
+    gt_mutex_delete(queue.mutex);
   }
-  GT_STACK_DELETE(&stack);
-  gt_free(rangeOccs);
-  gt_free(tmpmbtab);
-  gt_freeBwtSeqpositionextractor(pos_extractor);
-  gt_array2dim_delete(special_char_rows_and_pos);
+  gt_logger_log(logger, "max stack depth = "GT_WU"",
+                GT_STACK_MAXSIZE(&state.stack));
+  gt_log_log("processed nodes= "GT_WU"", state.processed_nodes);
+  gt_array2dim_delete(state.special_pos);
+  shu_dfs_state_delete(&state);
   return had_err;
 }
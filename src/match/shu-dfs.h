@@ -40,6 +40,7 @@ int gt_pck_calculate_shulen(const FMindex *index,
                             uint64_t **shulen,
                             GtUword numofchars,
                             GtUword total_length,
+                            GtUword split_depth,
                             GtTimer *timer,
                             GT_UNUSED GtLogger *logger,
                             GT_UNUSED GtError *err);
@@ -311,6 +311,7 @@ uint64_t **gt_genomediff_shulen_sum(const GtGenomediffArguments *arguments,
                                         shulensums,
                                         num_of_chars,
                                         total_length,
+                                        arguments->split_depth,
                                         timer,
                                         logger,
                                         err);
@@ -0,0 +1,363 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/divmodmul_api.h"
+#include "core/ma_api.h"
+#include "core/minmax_api.h"
+#include "core/multithread_api.h"
+#include "core/mathsupport_api.h"
+#include "core/timer_api.h"
+#include "core/unused_api.h"
+#include "extended/alignment.h"
+#include "extended/batchalign.h"
+#include "extended/linearalign.h"
+#include "extended/linearalign_affinegapcost.h"
+#include "extended/linspace_management.h"
+#include "extended/scorehandler.h"
+#include "tools/gt_alignbench.h"
+
+typedef struct {
+  GtStr *impl;
+  GtUword numofpairs,
+          length,
+          errorpercentage,
+          matchcost,
+          mismatchcost,
+          gap_opening,
+          gap_extension,
+          runs;
+  bool with_alignments,
+       verify;
+} GtAlignbenchArguments;
+
+static void* gt_alignbench_arguments_new(void)
+{
+  GtAlignbenchArguments *arguments = gt_calloc((size_t) 1, sizeof *arguments);
+  arguments->impl = gt_str_new();
+  return arguments;
+}
+
+static void gt_alignbench_arguments_delete(void *tool_arguments)
+{
+  GtAlignbenchArguments *arguments = tool_arguments;
+  if (arguments != NULL) {
+    gt_str_delete(arguments->impl);
+    gt_free(arguments);
+  }
+}
+
+static const char *gt_alignbench_implementation_names[]
+  = {"batch", "single", NULL};
+
+static GtOptionParser* gt_alignbench_option_parser_new(void *tool_arguments)
+{
+  GtAlignbenchArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option;
+
+  gt_assert(arguments);
+
+  /* init */
+  op = gt_option_parser_new("[option ...]",
+                            "Benchmark global alignment of many pairs of "
+                            "short random DNA sequences.");
+
+  option = gt_option_new_choice("impl", "implementation\n"
+                                "batch: all pairs by one batch\n"
+                                "single: one pair at a time by each of "
+                                "-j threads",
+                                arguments->impl,
+                                gt_alignbench_implementation_names[0],
+                                gt_alignbench_implementation_names);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword("pairs", "number of sequence pairs",
+                               &arguments->numofpairs, 100000UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("length", "length of the sequences",
+                                   &arguments->length, 150UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min_max("err", "percentage of random edit "
+                                       "operations between the sequences of "
+                                       "a pair",
+                                       &arguments->errorpercentage, 10UL,
+                                       0, 100UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword("match", "match cost",
+                               &arguments->matchcost, 0);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword("mismatch", "mismatch cost",
+                               &arguments->mismatchcost, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword("gapopen", "gap opening cost, 0 for linear "
+                               "gap costs",
+                               &arguments->gap_opening, 0);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword("gapext", "gap extension cost",
+                               &arguments->gap_extension, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("runs", "number of times all pairs are "
+                                   "aligned",
+                                   &arguments->runs, 1UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_bool("alignments", "compute alignments, not only "
+                              "costs",
+                              &arguments->with_alignments, false);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_bool("verify", "compare the costs with those "
+                              "computed one pair at a time",
+                              &arguments->verify, false);
+  gt_option_parser_add_option(op, option);
+
+  return op;
+}
+
+/* generate <numofpairs> pairs, where the second sequence of each pair is
+   derived from the first one by random edit operations */
+static GtUchar *gt_alignbench_pairs_new(GtUword *lengths,
+                                        const GtAlignbenchArguments *arguments)
+{
+  const GtUword maxlen = GT_MULT2(arguments->length);
+  GtUchar *sequences = gt_malloc(sizeof *sequences * GT_MULT2(maxlen) *
+                                 arguments->numofpairs);
+  GtUword idx;
+
+  for (idx = 0; idx < arguments->numofpairs; idx++)
+  {
+    GtUchar *useq = sequences + GT_MULT2(idx) * maxlen,
+            *vseq = useq + maxlen;
+    GtUword pos, vlen = 0;
+
+    for (pos = 0; pos < arguments->length; pos++)
+    {
+      useq[pos] = (GtUchar) gt_rand_max(3);
+    }
+    for (pos = 0; pos < arguments->length && vlen < maxlen; pos++)
+    {
+      if (gt_rand_max(99) < arguments->errorpercentage)
+      {
+        switch (gt_rand_max(2))
+        {
+          case 0:
+            vseq[vlen++] = (GtUchar) gt_rand_max(3);
+            break;
+          case 1:
+            break;
+          default:
+            vseq[vlen++] = (GtUchar) gt_rand_max(3);
+            if (vlen < maxlen)
+            {
+              vseq[vlen++] = useq[pos];
+            }
+        }
+      } else
+      {
+        vseq[vlen++] = useq[pos];
+      }
+    }
+    lengths[GT_MULT2(idx)] = arguments->length;
+    lengths[GT_MULT2(idx) + 1] = vlen;
+  }
+  return sequences;
+}
+
+#define GT_ALIGNBENCH_CHUNK 64
+
+typedef struct
+{
+  const GtAlignbenchArguments *arguments;
+  const GtScoreHandler *scorehandler;
+  const GtUchar *sequences;
+  const GtUword *lengths;
+  GtUword *distances,
+          nextpair;
+  GtLinspaceManagementPool *pool;
+  GtMutex *mutex;
+} GtAlignbenchThreadinfo;
+
+/* align chunks of consecutive pairs one at a time, until all pairs are
+   processed, using a space manager of the pool */
+static void *gt_alignbench_single_thread(void *data)
+{
+  GtAlignbenchThreadinfo *threadinfo = data;
+  const GtUword maxlen = GT_MULT2(threadinfo->arguments->length),
+                numofpairs = threadinfo->arguments->numofpairs;
+  const bool affine = threadinfo->arguments->gap_opening > 0;
+  GtLinspaceManagement *spacemanager
+    = gt_linspace_management_pool_get(threadinfo->pool);
+  GtAlignment *align = gt_alignment_new();
+
+  while (true)
+  {
+    GtUword idx, firstpair;
+
+    gt_mutex_lock(threadinfo->mutex);
+    firstpair = threadinfo->nextpair;
+    threadinfo->nextpair += GT_ALIGNBENCH_CHUNK;
+    gt_mutex_unlock(threadinfo->mutex);
+    if (firstpair >= numofpairs)
+    {
+      break;
+    }
+    for (idx = firstpair;
+         idx < GT_MIN(firstpair + GT_ALIGNBENCH_CHUNK, numofpairs); idx++)
+    {
+      const GtUchar *useq = threadinfo->sequences + GT_MULT2(idx) * maxlen;
+      const GtUword ulen = threadinfo->lengths[GT_MULT2(idx)],
+                    vlen = threadinfo->lengths[GT_MULT2(idx) + 1];
+
+      gt_alignment_reset(align);
+      threadinfo->distances[idx]
+        = (affine ? gt_linearalign_affinegapcost_compute_generic
+                  : gt_linearalign_compute_generic)
+            (spacemanager, threadinfo->scorehandler, align,
+             useq, 0, ulen, useq + maxlen, 0, vlen);
+    }
+  }
+  gt_alignment_delete(align);
+  gt_linspace_management_pool_put(threadinfo->pool, spacemanager);
+  return NULL;
+}
+
+static int gt_alignbench_runner(GT_UNUSED int argc,
+                                GT_UNUSED const char **argv,
+                                GT_UNUSED int parsed_args,
+                                void *tool_arguments,
+                                GtError *err)
+{
+  GtAlignbenchArguments *arguments = tool_arguments;
+  const GtUword maxlen = GT_MULT2(arguments->length);
+  const bool batch = strcmp(gt_str_get(arguments->impl), "batch") == 0;
+  GtUword *lengths, *distances, idx, run, sumdistance = 0;
+  GtUchar *sequences;
+  GtScoreHandler *scorehandler;
+  GtLinspaceManagement *spacemanager;
+  GtAlignbenchThreadinfo threadinfo;
+  GtBatchalign *batchalign;
+  GtAlignment *align;
+  GtTimer *timer;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(arguments != NULL);
+  lengths = gt_malloc(sizeof *lengths * GT_MULT2(arguments->numofpairs));
+  distances = gt_malloc(sizeof *distances * arguments->numofpairs);
+  sequences = gt_alignbench_pairs_new(lengths, arguments);
+  scorehandler = gt_scorehandler_new((GtWord) arguments->matchcost,
+                                     (GtWord) arguments->mismatchcost,
+                                     (GtWord) arguments->gap_opening,
+                                     (GtWord) arguments->gap_extension);
+  spacemanager = gt_linspace_management_new();
+  batchalign = gt_batchalign_new(scorehandler);
+  align = gt_alignment_new();
+  for (idx = 0; idx < arguments->numofpairs; idx++)
+  {
+    gt_batchalign_add(batchalign, sequences + GT_MULT2(idx) * maxlen,
+                      lengths[GT_MULT2(idx)],
+                      sequences + (GT_MULT2(idx) + 1) * maxlen,
+                      lengths[GT_MULT2(idx) + 1]);
+  }
+  threadinfo.arguments = arguments;
+  threadinfo.scorehandler = scorehandler;
+  threadinfo.sequences = sequences;
+  threadinfo.lengths = lengths;
+  threadinfo.distances = distances;
+  threadinfo.pool = gt_linspace_management_pool_new();
+  threadinfo.mutex = gt_mutex_new();
+  timer = gt_timer_new();
+  gt_timer_start(timer);
+  for (run = 0; !had_err && run < arguments->runs; run++)
+  {
+    if (batch)
+    {
+      gt_batchalign_compute(batchalign, spacemanager,
+                            arguments->with_alignments);
+      for (idx = 0; idx < arguments->numofpairs; idx++)
+      {
+        distances[idx] = gt_batchalign_distance(batchalign, idx);
+      }
+    } else
+    {
+      threadinfo.nextpair = 0;
+      had_err = gt_multithread(gt_alignbench_single_thread, &threadinfo, err);
+    }
+  }
+  gt_timer_stop(timer);
+  for (idx = 0; !had_err && idx < arguments->numofpairs; idx++)
+  {
+    sumdistance += distances[idx];
+  }
+  if (!had_err)
+  {
+    printf("# pairs: " GT_WU ", runs: " GT_WU ", sum of costs: " GT_WU "\n",
+           arguments->numofpairs, arguments->runs, sumdistance);
+    gt_timer_show_formatted(timer, "# TIME " GT_WD ".%06ld\n", stdout);
+  }
+  if (!had_err && arguments->verify)
+  {
+    for (idx = 0; !had_err && idx < arguments->numofpairs; idx++)
+    {
+      GtUword distance;
+
+      gt_alignment_reset(align);
+      distance = (arguments->gap_opening > 0
+                   ? gt_linearalign_affinegapcost_compute_generic
+                   : gt_linearalign_compute_generic)
+                  (spacemanager, scorehandler, align,
+                   sequences + GT_MULT2(idx) * maxlen, 0,
+                   lengths[GT_MULT2(idx)],
+                   sequences + (GT_MULT2(idx) + 1) * maxlen, 0,
+                   lengths[GT_MULT2(idx) + 1]);
+      if (distance != distances[idx])
+      {
+        gt_error_set(err, "pair " GT_WU ": cost " GT_WU " differs from cost "
+                     GT_WU " of single pair alignment", idx, distances[idx],
+                     distance);
+        had_err = -1;
+      }
+    }
+  }
+  gt_timer_delete(timer);
+  gt_mutex_delete(threadinfo.mutex);
+  gt_linspace_management_pool_delete(threadinfo.pool);
+  gt_alignment_delete(align);
+  gt_batchalign_delete(batchalign);
+  gt_linspace_management_delete(spacemanager);
+  gt_scorehandler_delete(scorehandler);
+  gt_free(sequences);
+  gt_free(distances);
+  gt_free(lengths);
+  return had_err;
+}
+
+GtTool* gt_alignbench(void)
+{
+  return gt_tool_new(gt_alignbench_arguments_new,
+                     gt_alignbench_arguments_delete,
+                     gt_alignbench_option_parser_new,
+                     NULL,
+                     gt_alignbench_runner);
+}
@@ -0,0 +1,413 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/array_api.h"
+#include "core/fa_api.h"
+#include "core/fileutils_api.h"
+#include "core/ma_api.h"
+#include "core/seq_iterator_fastq_api.h"
+#include "core/str_api.h"
+#include "core/str_array_api.h"
+#include "core/timer_api.h"
+#include "core/unused_api.h"
+#include "core/xansi_api.h"
+#include "extended/bitinstream.h"
+#include "extended/bitoutstream.h"
+#include "extended/elias_gamma.h"
+#include "extended/golomb.h"
+#include "extended/huffcode.h"
+#include "tools/gt_codecbench.h"
+
+/* symbols of the Huffman code are <base, quality> pairs like in HCR */
+#define CODECBENCH_BASES 5UL
+#define CODECBENCH_QUALS 256UL
+
+typedef struct {
+  GtUword runs,
+          pages_to_map;
+} GtCodecbenchArguments;
+
+typedef enum {
+  CODECBENCH_HUFFMAN,
+  CODECBENCH_GOLOMB,
+  CODECBENCH_ELIAS_GAMMA,
+  CODECBENCH_NUM_OF_CODECS
+} CodecbenchType;
+
+static const char *codecbench_names[] = {
+  "huffman (base,qual)",
+  "golomb (qual runs)",
+  "elias gamma (qual runs)"
+};
+
+typedef struct {
+  GtArray                    *values;
+  GtStr                      *filename;
+  GtHuffman                  *huffman;
+  GtGolomb                   *golomb;
+  GtHuffmanBitwiseDecoder    *hbwd;
+  GtGolombBitwiseDecoder     *gbwd;
+  GtEliasGammaBitwiseDecoder *egbd;
+  GtUint64                    bytes; /* number of FASTQ bytes represented */
+  CodecbenchType              type;
+} CodecbenchCodec;
+
+static void* gt_codecbench_arguments_new(void)
+{
+  GtCodecbenchArguments *arguments = gt_calloc((size_t) 1, sizeof *arguments);
+  return arguments;
+}
+
+static void gt_codecbench_arguments_delete(void *tool_arguments)
+{
+  GtCodecbenchArguments *arguments = tool_arguments;
+  if (arguments != NULL) {
+    gt_free(arguments);
+  }
+}
+
+static GtOptionParser* gt_codecbench_option_parser_new(void *tool_arguments)
+{
+  GtCodecbenchArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option;
+  gt_assert(arguments);
+
+  /* init */
+  op = gt_option_parser_new("[option ...] fastq_file [fastq_file ...]",
+                            "Benchmark decoding of Huffman, Golomb and Elias "
+                            "gamma codes from a GtBitInStream bit by bit and "
+                            "word-wise.\nThe codes are built from the "
+                            "qualities of the given FASTQ files, speed is "
+                            "reported in MB of FASTQ data decoded per "
+                            "second.");
+
+  /* -runs */
+  option = gt_option_new_uword_min("runs", "number of times each encoding is "
+                                   "decoded", &arguments->runs, 10UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  /* -pages */
+  option = gt_option_new_uword_min("pages", "number of pages the bitstream "
+                                   "maps at a time",
+                                   &arguments->pages_to_map, 5UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  gt_option_parser_set_min_args(op, 1U);
+  return op;
+}
+
+static GtUint64 codecbench_distr_func(const void *distr, GtUword symbol)
+{
+  const GtUint64 *counts = distr;
+  return counts[symbol];
+}
+
+static GtUword codecbench_base_index(GtUchar base)
+{
+  switch (base) {
+    case 'a': case 'A': return 0;
+    case 'c': case 'C': return 1UL;
+    case 'g': case 'G': return 2UL;
+    case 't': case 'T': return 3UL;
+    default: return 4UL;
+  }
+}
+
+/* Collects the <base, quality> pairs and the lengths of runs of equal
+   qualities of all reads in <files>. */
+static int codecbench_read_fastq(const GtStrArray *files,
+                                 CodecbenchCodec *codecs,
+                                 GtUint64 *distr,
+                                 GtError *err)
+{
+  int had_err = 0,
+      status;
+  const GtUchar *seq,
+                *qual;
+  char *desc;
+  GtUword len, idx, symbol, runlength;
+  GtSeqIterator *seqit = gt_seq_iterator_fastq_new(files, err);
+
+  if (seqit == NULL)
+    return -1;
+  gt_seq_iterator_set_quality_buffer(seqit, &qual);
+  while ((status = gt_seq_iterator_next(seqit, &seq, &len, &desc, err)) == 1) {
+    for (idx = 0, runlength = 0; idx < len; idx++) {
+      symbol = codecbench_base_index(seq[idx]) * CODECBENCH_QUALS + qual[idx];
+      distr[symbol]++;
+      gt_array_add(codecs[CODECBENCH_HUFFMAN].values, symbol);
+      runlength++;
+      if (idx + 1 == len || qual[idx + 1] != qual[idx]) {
+        /* Golomb codes start at 0, Elias gamma codes at 1 */
+        symbol = runlength - 1;
+        gt_array_add(codecs[CODECBENCH_GOLOMB].values, symbol);
+        gt_array_add(codecs[CODECBENCH_ELIAS_GAMMA].values, runlength);
+        runlength = 0;
+      }
+    }
+    codecs[CODECBENCH_HUFFMAN].bytes += (GtUint64) len * 2;
+    codecs[CODECBENCH_GOLOMB].bytes += (GtUint64) len;
+    codecs[CODECBENCH_ELIAS_GAMMA].bytes += (GtUint64) len;
+  }
+  if (status == -1)
+    had_err = -1;
+  if (!had_err && gt_array_size(codecs[CODECBENCH_HUFFMAN].values) == 0) {
+    gt_error_set(err, "input files contain no bases");
+    had_err = -1;
+  }
+  gt_seq_iterator_delete(seqit);
+  return had_err;
+}
+
+static void codecbench_encode(CodecbenchCodec *codec)
+{
+  GtUword idx, value;
+  GtBitsequence code;
+  unsigned int codelength;
+  GtBittab *bittab = NULL;
+  FILE *fp = gt_xtmpfp(codec->filename);
+  GtBitOutStream *outstream = gt_bitoutstream_new(fp);
+
+  for (idx = 0; idx < gt_array_size(codec->values); idx++) {
+    value = *(GtUword *) gt_array_get(codec->values, idx);
+    switch (codec->type) {
+      case CODECBENCH_HUFFMAN:
+        gt_huffman_encode(codec->huffman, value, &code, &codelength);
+        gt_bitoutstream_append(outstream, code, codelength);
+        break;
+      case CODECBENCH_GOLOMB:
+        bittab = gt_golomb_encode(codec->golomb, value);
+        break;
+      default:
+        bittab = gt_elias_gamma_encode(value);
+    }
+    if (bittab != NULL) {
+      gt_bitoutstream_append_bittab(outstream, bittab);
+      gt_bittab_delete(bittab);
+      bittab = NULL;
+    }
+  }
+  gt_bitoutstream_flush(outstream);
+  gt_bitoutstream_delete(outstream);
+  gt_fa_xfclose(fp);
+}
+
+/* Decodes all values of <codec> from <instream> to <values>. If <wordwise> is
+   true whole codes are decoded from the bits returned by
+   <gt_bitinstream_peek_bits()>, falling back to the bitwise decoders only for
+   codes crossing the end of a mapped chunk. */
+static int codecbench_decode(CodecbenchCodec *codec,
+                             GtBitInStream *instream,
+                             bool wordwise,
+                             GtUword *values,
+                             GtError *err)
+{
+  int had_err = 0,
+      stat;
+  bool bit;
+  GtBitsequence bits;
+  unsigned int numofbits;
+  GtUword idx,
+          num_of_values = gt_array_size(codec->values);
+
+  for (idx = 0; !had_err && idx < num_of_values; idx++) {
+    if (wordwise) {
+      numofbits = gt_bitinstream_peek_bits(instream, &bits);
+      switch (codec->type) {
+        case CODECBENCH_HUFFMAN:
+          numofbits = gt_huffman_bitwise_decoder_next_bits(codec->hbwd, bits,
+                                                           numofbits,
+                                                           values + idx);
+          break;
+        case CODECBENCH_GOLOMB:
+          numofbits = gt_golomb_bitwise_decoder_next_bits(codec->gbwd, bits,
+                                                          numofbits,
+                                                          values + idx);
+          break;
+        default:
+          numofbits = gt_elias_gamma_bitwise_decoder_next_bits(codec->egbd,
+                                                               bits,
+                                                               numofbits,
+                                                               values + idx);
+      }
+      if (numofbits > 0) {
+        gt_bitinstream_skip_bits(instream, numofbits);
+        continue;
+      }
+    }
+    stat = 1;
+    while (!had_err && stat != 0) {
+      if (gt_bitinstream_get_next_bit(instream, &bit) != 1) {
+        gt_error_set(err, "could not get next bit");
+        had_err = -1;
+      }
+      else {
+        switch (codec->type) {
+          case CODECBENCH_HUFFMAN:
+            stat = gt_huffman_bitwise_decoder_next(codec->hbwd, bit,
+                                                   values + idx, err);
+            break;
+          case CODECBENCH_GOLOMB:
+            stat = gt_golomb_bitwise_decoder_next(codec->gbwd, bit,
+                                                  values + idx);
+            break;
+          default:
+            stat = gt_elias_gamma_bitwise_decoder_next(codec->egbd, bit,
+                                                       values + idx);
+        }
+        if (stat == -1)
+          had_err = -1;
+      }
+    }
+  }
+  return had_err;
+}
+
+/* Decodes the encoding of <codec> <runs> times and returns the speed in MB of
+   FASTQ data per second, or a negative value on error. */
+static double codecbench_measure(CodecbenchCodec *codec,
+                                 const GtCodecbenchArguments *arguments,
+                                 bool wordwise,
+                                 GtUword *values,
+                                 GtError *err)
+{
+  int had_err = 0;
+  GtUword run, idx;
+  GtWord usec;
+  GtBitInStream *instream = gt_bitinstream_new(gt_str_get(codec->filename), 0,
+                                               arguments->pages_to_map);
+  GtTimer *timer = gt_timer_new();
+
+  gt_timer_start(timer);
+  for (run = 0; !had_err && run < arguments->runs; run++) {
+    if (run > 0)
+      gt_bitinstream_reinit(instream, 0);
+    had_err = codecbench_decode(codec, instream, wordwise, values, err);
+  }
+  gt_timer_stop(timer);
+  usec = gt_timer_elapsed_usec(timer);
+  gt_timer_delete(timer);
+  gt_bitinstream_delete(instream);
+
+  for (idx = 0; !had_err && idx < gt_array_size(codec->values); idx++) {
+    if (values[idx] != *(GtUword *) gt_array_get(codec->values, idx)) {
+      gt_error_set(err, "%s: value " GT_WU " decoded %s differs from the "
+                   "encoded one", codecbench_names[codec->type], idx,
+                   wordwise ? "word-wise" : "bitwise");
+      had_err = -1;
+    }
+  }
+  if (had_err)
+    return -1.0;
+  if (usec <= 0)
+    usec = 1L;
+  /* bytes per microsecond equals MB per second */
+  return (double) codec->bytes * arguments->runs / (double) usec;
+}
+
+static int gt_codecbench_runner(int argc, const char **argv, int parsed_args,
+                                void *tool_arguments, GtError *err)
+{
+  GtCodecbenchArguments *arguments = tool_arguments;
+  int had_err = 0,
+      type;
+  GtUword idx, sum,
+          *values = NULL;
+  GtUint64 *distr = gt_calloc((size_t) (CODECBENCH_BASES * CODECBENCH_QUALS),
+                              sizeof (*distr));
+  GtStrArray *files = gt_str_array_new();
+  CodecbenchCodec codecs[CODECBENCH_NUM_OF_CODECS];
+
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  for (idx = (GtUword) parsed_args; idx < (GtUword) argc; idx++)
+    gt_str_array_add_cstr(files, argv[idx]);
+  for (type = 0; type < (int) CODECBENCH_NUM_OF_CODECS; type++) {
+    codecs[type].type = (CodecbenchType) type;
+    codecs[type].values = gt_array_new(sizeof (GtUword));
+    codecs[type].filename = gt_str_new();
+    codecs[type].bytes = 0;
+    codecs[type].huffman = NULL;
+    codecs[type].golomb = NULL;
+    codecs[type].hbwd = NULL;
+    codecs[type].gbwd = NULL;
+    codecs[type].egbd = NULL;
+  }
+
+  had_err = codecbench_read_fastq(files, codecs, distr, err);
+
+  if (!had_err) {
+    CodecbenchCodec *golomb = codecs + CODECBENCH_GOLOMB;
+    codecs[CODECBENCH_HUFFMAN].huffman =
+      gt_huffman_new(distr, codecbench_distr_func,
+                     CODECBENCH_BASES * CODECBENCH_QUALS);
+    codecs[CODECBENCH_HUFFMAN].hbwd =
+      gt_huffman_bitwise_decoder_new(codecs[CODECBENCH_HUFFMAN].huffman, err);
+    /* use the mean run length as parameter of the Golomb code */
+    for (idx = 0, sum = 0; idx < gt_array_size(golomb->values); idx++)
+      sum += *(GtUword *) gt_array_get(golomb->values, idx);
+    golomb->golomb = gt_golomb_new(sum / gt_array_size(golomb->values) + 1);
+    golomb->gbwd = gt_golomb_bitwise_decoder_new(golomb->golomb);
+    codecs[CODECBENCH_ELIAS_GAMMA].egbd = gt_elias_gamma_bitwise_decoder_new();
+
+    values = gt_malloc(sizeof (*values) *
+                       gt_array_size(codecs[CODECBENCH_HUFFMAN].values));
+    printf("# codec\tvalues\tencoded MB\tbitwise MB/s\tword-wise MB/s\n");
+  }
+
+  for (type = 0; !had_err && type < (int) CODECBENCH_NUM_OF_CODECS; type++) {
+    double bitwise, wordwise = -1.0;
+    codecbench_encode(codecs + type);
+    bitwise = codecbench_measure(codecs + type, arguments, false, values, err);
+    if (bitwise >= 0.0)
+      wordwise = codecbench_measure(codecs + type, arguments, true, values,
+                                    err);
+    if (bitwise < 0.0 || wordwise < 0.0)
+      had_err = -1;
+    else
+      printf("%s\t" GT_WU "\t%.3f\t%.2f\t%.2f\n",
+             codecbench_names[type], gt_array_size(codecs[type].values),
+             (double) gt_file_estimate_size(gt_str_get(codecs[type].filename))
+               / 1000000.0, bitwise, wordwise);
+  }
+
+  for (type = 0; type < (int) CODECBENCH_NUM_OF_CODECS; type++) {
+    if (gt_str_length(codecs[type].filename) > 0)
+      gt_xremove(gt_str_get(codecs[type].filename));
+    gt_str_delete(codecs[type].filename);
+    gt_array_delete(codecs[type].values);
+    gt_huffman_bitwise_decoder_delete(codecs[type].hbwd);
+    gt_huffman_delete(codecs[type].huffman);
+    gt_golomb_bitwise_decoder_delete(codecs[type].gbwd);
+    gt_golomb_delete(codecs[type].golomb);
+    gt_elias_gamma_bitwise_decoder_delete(codecs[type].egbd);
+  }
+  gt_free(values);
+  gt_free(distr);
+  gt_str_array_delete(files);
+  return had_err;
+}
+
+GtTool* gt_codecbench(void)
+{
+  return gt_tool_new(gt_codecbench_arguments_new,
+                     gt_codecbench_arguments_delete,
+                     gt_codecbench_option_parser_new,
+                     NULL,
+                     gt_codecbench_runner);
+}
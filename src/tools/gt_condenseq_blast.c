@@ -301,6 +301,8 @@ static inline int gt_condenseq_avg_helper(GtUword current_len,
 }
 
 #define GT_CONDENSEQ_HITS_INIT_SIZE ((GtUword) 100UL)
+/* number of symbols to extract in parallel before writing them */
+#define GT_CONDENSEQ_BLAST_EXTRACT_CHUNK ((GtUword) 1 << 22)
 
 typedef struct {
   GtRange range;
@@ -663,6 +665,12 @@ static int gt_condenseq_blast_runner(GT_UNUSED int argc,
     GtFile *outfp = gt_file_new(gt_str_get(coarse_fname), "w", err);
     GtStr *orig_seqid = gt_str_new(),
           *coarse_seqid = gt_str_new();
+    GtRange *chunk_ranges = NULL;
+    char **chunk_buffers = NULL,
+         *chunk_buffer = NULL;
+    GtUword jdx,
+            chunk_size = 0,
+            chunk_buffer_size = 0;
     if (info.timer != NULL)
       gt_timer_show_progress(info.timer, "identify ranges", stderr);
 
@@ -721,44 +729,79 @@ static int gt_condenseq_blast_runner(GT_UNUSED int argc,
     if (info.source == NULL)
       info.source = gt_str_new_cstr("Extracted");
 
-    for (idx = 0; !had_err && idx < pinfo.sorted.nextfreeHitRange; idx++) {
-      GtRange current = pinfo.sorted.spaceHitRange[idx].range;
-      GtUword len = gt_range_length(&current),
-              seqid = pinfo.sorted.spaceHitRange[idx].seqid;
-      gt_str_reset(coarse_seqid);
-      gt_str_append_uword(coarse_seqid, seqid);
-      gt_str_append_cstr(coarse_seqid, "|");
-      gt_str_append_uword(coarse_seqid, current.start);
-      gt_str_append_cstr(coarse_seqid, "|");
-      gt_str_append_uword(coarse_seqid, current.end);
-      gt_fasta_show_entry_nt(gt_str_get(coarse_seqid),
-                             gt_str_length(coarse_seqid),
-                             gt_condenseq_extract_decoded_range(info.ces,
-                                                                current,
-                                                                '\0'),
-                             len, (GtUword) 100, outfp);
-      coarse_db_len += len;
-      if (info.gff_node_visitor != NULL) {
-        GtGenomeNode *node;
-        GtUword seqnum, desclen, seqstart;
-        const char *desc;
-        seqnum = gt_condenseq_pos2seqnum(info.ces,
-                                         current.start);
-        seqstart = gt_condenseq_seqstartpos(info.ces,
-                                            seqnum);
-        desc = gt_condenseq_description(info.ces,
-                                        &desclen, seqnum);
-        gt_str_reset(orig_seqid);
-        gt_str_append_cstr_nt(orig_seqid, desc, desclen);
-        node = gt_feature_node_new(orig_seqid, "experimental_feature",
-                                   current.start + 1 - seqstart,
-                                   current.end + 1 - seqstart,
-                                   GT_STRAND_BOTH);
-        gt_feature_node_set_source((GtFeatureNode *) node, info.source);
-        gt_feature_node_set_attribute((GtFeatureNode *) node,
-                                      "Name", "Fine Extract");
-        had_err = gt_genome_node_accept(node, info.gff_node_visitor, info.err);
-        gt_genome_node_delete(node);
+    /* extract the ranges in chunks in parallel, output in sorted order */
+    for (idx = 0; !had_err && idx < pinfo.sorted.nextfreeHitRange;) {
+      GtUword chunk_end, chunk_len = 0, chunk_start = idx;
+      for (chunk_end = chunk_start;
+           chunk_end < pinfo.sorted.nextfreeHitRange &&
+           (chunk_end == chunk_start ||
+            chunk_len < GT_CONDENSEQ_BLAST_EXTRACT_CHUNK);
+           chunk_end++) {
+        GtUword len =
+          gt_range_length(&pinfo.sorted.spaceHitRange[chunk_end].range);
+        if (chunk_end - chunk_start == chunk_size) {
+          chunk_size = chunk_size * 2 + 1;
+          chunk_ranges = gt_realloc(chunk_ranges,
+                                    sizeof (*chunk_ranges) * chunk_size);
+          chunk_buffers = gt_realloc(chunk_buffers,
+                                     sizeof (*chunk_buffers) * chunk_size);
+        }
+        chunk_ranges[chunk_end - chunk_start] =
+          pinfo.sorted.spaceHitRange[chunk_end].range;
+        if (chunk_len + len > chunk_buffer_size) {
+          chunk_buffer_size = chunk_len + len;
+          chunk_buffer = gt_realloc(chunk_buffer,
+                                    sizeof (*chunk_buffer) * chunk_buffer_size);
+        }
+        chunk_len += len;
+      }
+      chunk_len = 0;
+      for (jdx = chunk_start; jdx < chunk_end; jdx++) {
+        chunk_buffers[jdx - chunk_start] = chunk_buffer + chunk_len;
+        chunk_len += gt_range_length(&chunk_ranges[jdx - chunk_start]);
+      }
+      had_err = gt_condenseq_extract_decoded_ranges(info.ces, chunk_ranges,
+                                                    chunk_end - chunk_start,
+                                                    chunk_buffers, '\0',
+                                                    err);
+      for (; !had_err && idx < chunk_end; idx++) {
+        GtRange current = pinfo.sorted.spaceHitRange[idx].range;
+        GtUword len = gt_range_length(&current),
+                seqid = pinfo.sorted.spaceHitRange[idx].seqid;
+        gt_str_reset(coarse_seqid);
+        gt_str_append_uword(coarse_seqid, seqid);
+        gt_str_append_cstr(coarse_seqid, "|");
+        gt_str_append_uword(coarse_seqid, current.start);
+        gt_str_append_cstr(coarse_seqid, "|");
+        gt_str_append_uword(coarse_seqid, current.end);
+        gt_fasta_show_entry_nt(gt_str_get(coarse_seqid),
+                               gt_str_length(coarse_seqid),
+                               chunk_buffers[idx - chunk_start],
+                               len, (GtUword) 100, outfp);
+        coarse_db_len += len;
+        if (info.gff_node_visitor != NULL) {
+          GtGenomeNode *node;
+          GtUword seqnum, desclen, seqstart;
+          const char *desc;
+          seqnum = gt_condenseq_pos2seqnum(info.ces,
+                                           current.start);
+          seqstart = gt_condenseq_seqstartpos(info.ces,
+                                              seqnum);
+          desc = gt_condenseq_description(info.ces,
+                                          &desclen, seqnum);
+          gt_str_reset(orig_seqid);
+          gt_str_append_cstr_nt(orig_seqid, desc, desclen);
+          node = gt_feature_node_new(orig_seqid, "experimental_feature",
+                                     current.start + 1 - seqstart,
+                                     current.end + 1 - seqstart,
+                                     GT_STRAND_BOTH);
+          gt_feature_node_set_source((GtFeatureNode *) node, info.source);
+          gt_feature_node_set_attribute((GtFeatureNode *) node,
+                                        "Name", "Fine Extract");
+          had_err = gt_genome_node_accept(node, info.gff_node_visitor,
+                                          info.err);
+          gt_genome_node_delete(node);
+        }
       }
     }
     gt_str_delete(info.source);
@@ -768,6 +811,9 @@ static int gt_condenseq_blast_runner(GT_UNUSED int argc,
     GT_FREEARRAY(&pinfo.sorted, HitRange);
     gt_str_delete(coarse_seqid);
     gt_str_delete(orig_seqid);
+    gt_free(chunk_ranges);
+    gt_free(chunk_buffers);
+    gt_free(chunk_buffer);
   }
 
   /* create BLAST database from decompressed database file */
@@ -38,7 +38,8 @@ typedef struct {
   GtUword                minalignlength,
                          cutoff_value,
                          fraction,
-                         initsize;
+                         initsize,
+                         batchsize;
   GtWord                 xdrop;
   unsigned int           kmersize,
                          windowsize,
@@ -214,6 +215,17 @@ gt_condenseq_compress_option_parser_new(void *tool_arguments)
   gt_option_is_development_option(option);
   gt_option_parser_add_option(op, option);
 
+  /* -batchsize */
+  option = gt_option_new_uword("batchsize", "process sequences in batches of "
+                               "this many sequences, which are compared only "
+                               "to the uniques found before the batch. The "
+                               "sequences of a batch are processed with -j "
+                               "threads, the result does not depend on -j. "
+                               "0 processes the sequences one after another. "
+                               "Incompatible with -full_diags yes.",
+                               &arguments->batchsize, 0);
+  gt_option_parser_add_option(op, option);
+
   /* -clean_percent */
   option = gt_option_new_uint("diags_clean",
                               "Percentage of sparse diagonals that is allowed "
@@ -262,6 +274,10 @@ static int gt_condenseq_compress_arguments_check(int rest_argc,
                  "'-full_diags'");
     had_err = -1;
   }
+  if (arguments->batchsize > 0 && arguments->full_diags) {
+    gt_error_set(err, "'-batchsize' is not compatible with '-full_diags'");
+    had_err = -1;
+  }
   if (arguments->cutoff_value == 0 && arguments->prune) {
     gt_error_set(err, "'-cutoff 0' disables cutoffs, so '-disable_prune' should"
                  " not be set.");
@@ -395,6 +411,7 @@ static int gt_condenseq_compress_runner(GT_UNUSED int argc, const char **argv,
       if (arguments->clean_percent != GT_UNDEF_UINT)
         gt_condenseq_creator_set_diags_clean_limit(ces_c,
                                                    arguments->clean_percent);
+      gt_condenseq_creator_set_batch_size(ces_c, arguments->batchsize);
 
       had_err = gt_condenseq_creator_create(ces_c,
                                             arguments->indexname,
@@ -40,7 +40,8 @@ typedef struct {
   GtOption         *sepchar_opt;
   GtRange           range,
                     seqrange;
-  GtUword           seq,
+  GtUword           cachesize,
+                    seq,
                     width;
   bool              verbose;
 } GtCondenserExtractArguments;
@@ -141,6 +142,14 @@ gt_condenseq_extract_option_parser_new(void *tool_arguments)
   option = gt_option_new_width(&arguments->width);
   gt_option_parser_add_option(op, option);
 
+  /* -cachesize */
+  option = gt_option_new_uword("cachesize", "number of symbols of decoded "
+                               "uniques and links to keep in memory, 0 "
+                               "disables the cache",
+                               &arguments->cachesize, 0);
+  gt_option_is_development_option(option);
+  gt_option_parser_add_option(op, option);
+
   /* -verbose */
   option = gt_option_new_bool("verbose", "Print out verbose output to stderr.",
                               &arguments->verbose, false);
@@ -227,13 +236,14 @@ static int gt_condenseq_extract_runner(GT_UNUSED int argc,
     if (condenseq == NULL) {
       had_err = -1;
     }
+    else
+      gt_condenseq_set_cache_size(condenseq, arguments->cachesize);
   }
 
   if (!had_err) {
     const char *buffer = NULL;
     const char *desc = NULL;
     GtUword desclen,
-            seqlen,
             rend = gt_condenseq_total_length(condenseq),
             send = gt_condenseq_num_of_sequences(condenseq);
     bool concat = strcmp(gt_str_get(arguments->mode), "concat") == 0;
@@ -318,8 +328,14 @@ static int gt_condenseq_extract_runner(GT_UNUSED int argc,
       }
     }
     else if (!had_err) { /* extract seqwise and always fasta */
+      const GtUword maxchunklen = ((GtUword) 1) << 22;
       GtUword seqnum,
-              sstart = arguments->seqrange.start;
+              sstart = arguments->seqrange.start,
+              chunk_size = 0,
+              buffer_size = 0;
+      GtRange *chunk_ranges = NULL;
+      char **chunk_buffers = NULL,
+           *chunk_buffer = NULL;
 
       if (timer)
         gt_timer_show_progress(timer, "extract sequence(s)", stderr);
@@ -330,16 +346,50 @@ static int gt_condenseq_extract_runner(GT_UNUSED int argc,
                      arguments->seqrange.end, send);
       }
       send = arguments->seqrange.end;
-      for (seqnum = sstart;
-           !had_err && seqnum <= send;
-           ++seqnum) {
-        buffer = gt_condenseq_extract_decoded(condenseq, &seqlen, seqnum);
-        desc = gt_condenseq_description(condenseq, &desclen, seqnum);
-        gt_fasta_show_entry_nt(desc, desclen,
-                               buffer, seqlen,
-                               arguments->width,
-                               arguments->outfp);
+      /* extract chunks of sequences in parallel and output them in order */
+      for (seqnum = sstart; !had_err && seqnum <= send;) {
+        GtUword idx, chunk_num = 0, chunk_len = 0;
+        while (seqnum + chunk_num <= send && chunk_len < maxchunklen) {
+          if (chunk_num == chunk_size) {
+            chunk_size = chunk_size * 2 + 16;
+            chunk_ranges = gt_realloc(chunk_ranges,
+                                      sizeof (*chunk_ranges) * chunk_size);
+            chunk_buffers = gt_realloc(chunk_buffers,
+                                       sizeof (*chunk_buffers) * chunk_size);
+          }
+          chunk_ranges[chunk_num].start =
+            gt_condenseq_seqstartpos(condenseq, seqnum + chunk_num);
+          chunk_ranges[chunk_num].end =
+            chunk_ranges[chunk_num].start +
+            gt_condenseq_seqlength(condenseq, seqnum + chunk_num) - 1;
+          chunk_len += gt_range_length(chunk_ranges + chunk_num);
+          chunk_num++;
+        }
+        if (buffer_size < chunk_len) {
+          buffer_size = chunk_len;
+          chunk_buffer = gt_realloc(chunk_buffer,
+                                    sizeof (*chunk_buffer) * buffer_size);
+        }
+        chunk_len = 0;
+        for (idx = 0; idx < chunk_num; idx++) {
+          chunk_buffers[idx] = chunk_buffer + chunk_len;
+          chunk_len += gt_range_length(chunk_ranges + idx);
+        }
+        had_err = gt_condenseq_extract_decoded_ranges(condenseq, chunk_ranges,
+                                                      chunk_num, chunk_buffers,
+                                                      '\0', err);
+        for (idx = 0; !had_err && idx < chunk_num; idx++, seqnum++) {
+          desc = gt_condenseq_description(condenseq, &desclen, seqnum);
+          gt_fasta_show_entry_nt(desc, desclen,
+                                 chunk_buffers[idx],
+                                 gt_range_length(chunk_ranges + idx),
+                                 arguments->width,
+                                 arguments->outfp);
+        }
       }
+      gt_free(chunk_ranges);
+      gt_free(chunk_buffers);
+      gt_free(chunk_buffer);
     }
   }
   if (timer)
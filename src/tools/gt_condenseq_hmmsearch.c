@@ -173,6 +173,7 @@ static int gt_condenseq_hmmsearch_arguments_check(int rest_argc,
 }
 
 #define HMMSEARCH_INFO_RESIZE 100
+#define HMMSEARCH_EXTRACT_CHUNK ((GtUword) 1 << 22)
 
 static void hmmsearch_tree_free_node(void *ptr) {
   gt_free(ptr);
@@ -207,29 +208,82 @@ static int hmmsearch_cmp_seqnum(const void *a, const void *b,
   return 0;
 }
 
-static void hmmsearch_create_fine_fas(GtStr *fine_fasta_filename,
-                                      GtRBTree *seqnums,
-                                      GtCondenseq *ces) {
+/* extracts the sequences in <seqnums> in parallel, in chunks of about
+   HMMSEARCH_EXTRACT_CHUNK symbols */
+static int hmmsearch_create_fine_fas(GtStr *fine_fasta_filename,
+                                     GtRBTree *seqnums,
+                                     GtCondenseq *ces,
+                                     GtError *err) {
   GtRBTreeIter *tree_iter;
-  GtUword *seqnum;
+  GtUword *seqnum,
+          idx,
+          chunk_num = 0,
+          chunk_size = 0,
+          chunk_len = 0,
+          buffer_size = 0;
+  GtUword *chunk_seqnums = NULL;
+  GtRange *chunk_ranges = NULL;
+  char **chunk_buffers = NULL,
+       *buffer = NULL;
   GtFile *gt_outfp;
   FILE *outfp;
+  int had_err = 0;
 
   tree_iter = gt_rbtree_iter_new_from_first(seqnums);
   outfp = gt_xtmpfp_generic(fine_fasta_filename, GT_TMPFP_USETEMPLATE);
   gt_outfp = gt_file_new_from_fileptr(outfp);
   seqnum = gt_rbtree_iter_data(tree_iter);
-  while (seqnum != NULL) {
-    const char *seq, *desc;
-    GtUword seqlen, desclen;
-    seq = gt_condenseq_extract_decoded(ces, &seqlen, *seqnum);
-    desc = gt_condenseq_description(ces, &desclen, *seqnum);
-    gt_fasta_show_entry_nt(desc, desclen, seq, seqlen,
-                           GT_FASTA_DEFAULT_WIDTH, gt_outfp);
-    seqnum = gt_rbtree_iter_next(tree_iter);
+  while (!had_err && (seqnum != NULL || chunk_num != 0)) {
+    if (seqnum != NULL && chunk_len < HMMSEARCH_EXTRACT_CHUNK) {
+      if (chunk_num == chunk_size) {
+        chunk_size += HMMSEARCH_INFO_RESIZE;
+        chunk_seqnums = gt_realloc(chunk_seqnums,
+                                   sizeof (*chunk_seqnums) * chunk_size);
+        chunk_ranges = gt_realloc(chunk_ranges,
+                                  sizeof (*chunk_ranges) * chunk_size);
+        chunk_buffers = gt_realloc(chunk_buffers,
+                                   sizeof (*chunk_buffers) * chunk_size);
+      }
+      chunk_seqnums[chunk_num] = *seqnum;
+      chunk_ranges[chunk_num].start = gt_condenseq_seqstartpos(ces, *seqnum);
+      chunk_ranges[chunk_num].end = chunk_ranges[chunk_num].start +
+                                    gt_condenseq_seqlength(ces, *seqnum) - 1;
+      chunk_len += gt_range_length(chunk_ranges + chunk_num);
+      chunk_num++;
+      seqnum = gt_rbtree_iter_next(tree_iter);
+    }
+    else {
+      if (buffer_size < chunk_len) {
+        buffer_size = chunk_len;
+        buffer = gt_realloc(buffer, sizeof (*buffer) * buffer_size);
+      }
+      chunk_len = 0;
+      for (idx = 0; idx < chunk_num; idx++) {
+        chunk_buffers[idx] = buffer + chunk_len;
+        chunk_len += gt_range_length(chunk_ranges + idx);
+      }
+      had_err = gt_condenseq_extract_decoded_ranges(ces, chunk_ranges,
+                                                    chunk_num, chunk_buffers,
+                                                    '\0', err);
+      for (idx = 0; !had_err && idx < chunk_num; idx++) {
+        const char *desc;
+        GtUword desclen;
+        desc = gt_condenseq_description(ces, &desclen, chunk_seqnums[idx]);
+        gt_fasta_show_entry_nt(desc, desclen, chunk_buffers[idx],
+                               gt_range_length(chunk_ranges + idx),
+                               GT_FASTA_DEFAULT_WIDTH, gt_outfp);
+      }
+      chunk_num =
+        chunk_len = 0;
+    }
   }
   gt_file_delete(gt_outfp);
   gt_rbtree_iter_delete(tree_iter);
+  gt_free(chunk_seqnums);
+  gt_free(chunk_ranges);
+  gt_free(chunk_buffers);
+  gt_free(buffer);
+  return had_err;
 }
 
 static int hmmsearch_call_fine_search(GtStr *table_filename,
@@ -415,7 +469,8 @@ static int hmmsearch_process_coarse_hits(
       }
       if (!had_err && arguments->max_queries != 0 &&
           querycount > arguments->max_queries) {
-        hmmsearch_create_fine_fas(fine_fasta_filename, sequences, ces);
+        had_err = hmmsearch_create_fine_fas(fine_fasta_filename, sequences,
+                                            ces, err);
         gt_logger_log(logger, "fine fasta: %s",
                       gt_str_get(fine_fasta_filename));
         if (table_name_length != 0) {
@@ -424,15 +479,16 @@ static int hmmsearch_process_coarse_hits(
           gt_logger_log(logger, "out table: %s",
                         gt_str_get(arguments->outtable_filename));
         }
-        had_err =
-          hmmsearch_call_fine_search(table_name_length != 0 ?
-                                     arguments->outtable_filename :
-                                     NULL,
-                                     gt_str_get(fine_fasta_filename),
-                                     gt_str_get(arguments->hmmsearch_path),
-                                     gt_str_get(arguments->hmm),
-                                     arguments->hmm_num_threads,
-                                     logger, err);
+        if (!had_err)
+          had_err =
+            hmmsearch_call_fine_search(table_name_length != 0 ?
+                                       arguments->outtable_filename :
+                                       NULL,
+                                       gt_str_get(fine_fasta_filename),
+                                       gt_str_get(arguments->hmmsearch_path),
+                                       gt_str_get(arguments->hmm),
+                                       arguments->hmm_num_threads,
+                                       logger, err);
         if (hmmtimer != NULL)
           gt_timer_show_progress_formatted(hmmtimer, stderr, "ran " GT_WU
                                            " fine hmmsearch", ++hmmcounter);
@@ -459,7 +515,10 @@ static int hmmsearch_process_coarse_hits(
   gt_xfclose(table);
 
   if (!had_err) {
-    hmmsearch_create_fine_fas(fine_fasta_filename, sequences, ces);
+    had_err = hmmsearch_create_fine_fas(fine_fasta_filename, sequences, ces,
+                                        err);
+  }
+  if (!had_err) {
     gt_logger_log(logger, "fine fasta: %s",
                   gt_str_get(fine_fasta_filename));
     if (table_name_length != 0) {
@@ -20,6 +20,8 @@
 #include "core/tool.h"
 #include "core/toolbox.h"
 #include "core/versionfunc_api.h"
+#include "tools/gt_alignbench.h"
+#include "tools/gt_codecbench.h"
 #include "tools/gt_compressedbits.h"
 #include "tools/gt_consensus_sa.h"
 #include "tools/gt_extracttarget.h"
@@ -58,6 +60,8 @@ static void* gt_dev_arguments_new(void)
   gt_toolbox_add(dev_toolbox, "patternmatch", gt_patternmatch);
   gt_toolbox_add(dev_toolbox, "regioncov", gt_regioncov);
   gt_toolbox_add(dev_toolbox, "trieins", gt_trieins);
+  gt_toolbox_add_tool(dev_toolbox, "alignbench", gt_alignbench());
+  gt_toolbox_add_tool(dev_toolbox, "codecbench", gt_codecbench());
   gt_toolbox_add_tool(dev_toolbox, "compbits", gt_compressedbits());
   gt_toolbox_add_tool(dev_toolbox, "consensus_sa", gt_consensus_sa_tool());
   gt_toolbox_add_tool(dev_toolbox, "extracttarget", gt_extracttarget());
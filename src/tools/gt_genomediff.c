@@ -133,6 +133,16 @@ static GtOptionParser* gt_genomediff_option_parser_new(void *tool_arguments)
   gt_option_is_development_option(option);
   gt_option_parser_add_option(op, option);
 
+  /* -splitdepth */
+  option = gt_option_new_uword("splitdepth", "depth of the virtual suffix "
+                               "tree below which its subtrees are traversed "
+                               "independently and with -j in parallel, "
+                               "0 disables the split, use with -indextype "
+                               "pck.",
+                               &arguments->split_depth, 4UL);
+  gt_option_is_development_option(option);
+  gt_option_parser_add_option(op, option);
+
   /* thresholds */
   /* divergence error */
   option = gt_option_new_double("thr",
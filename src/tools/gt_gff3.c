@@ -32,6 +32,7 @@
 #include "extended/gtdatahelp.h"
 #include "extended/load_stream.h"
 #include "extended/merge_feature_stream_api.h"
+#include "extended/pipeline_stream_api.h"
 #include "extended/set_source_visitor_api.h"
 #include "extended/sort_stream.h"
 #include "extended/typecheck_info.h"
@@ -53,7 +54,8 @@ typedef struct {
        strict,
        tidy,
        show,
-       fixboundaries;
+       fixboundaries,
+       threads;
   GtWord offset;
   GtStr *offsetfile, *newsource;
   GtUword width;
@@ -94,7 +96,7 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
   GtOption *sort_option, *load_option, *strict_option, *tidy_option,
            *mergefeat_option, *addintrons_option, *offset_option,
            *offsetfile_option, *setsource_option, *sortlines_option,
-           *sortnum_option, *option;
+           *sortnum_option, *checkids_option, *option;
   gt_assert(arguments);
 
   /* init */
@@ -146,7 +148,7 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
   gt_option_parser_add_option(op, option);
 
   /* -checkids */
-  option = gt_option_new_bool("checkids",
+  checkids_option = gt_option_new_bool("checkids",
                               "make sure the ID attributes are unique "
                               "within the scope of each GFF3_file, as required "
                               "by GFF3 specification\n"
@@ -158,7 +160,7 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
                               "to treat them as a multi-line feature. This "
                               "requires at least matching sequence IDs and "
                               "types.", &arguments->checkids, false);
-  gt_option_parser_add_option(op, option);
+  gt_option_parser_add_option(op, checkids_option);
 
   /* -addids */
   option = gt_option_new_bool("addids", "add missing \""
@@ -226,6 +228,16 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
                               true);
   gt_option_parser_add_option(op, option);
 
+  /* -threads */
+  option = gt_option_new_bool("threads", "run parsing, processing, and output "
+                              "of the features concurrently on separate "
+                              "threads (pipelined execution)",
+                              &arguments->threads, false);
+  gt_option_parser_add_option(op, option);
+  /* the parser keeps references to all nodes to check the IDs, while the
+     pipeline hands them over to other threads */
+  gt_option_exclude(option, checkids_option);
+
   /* -v */
   option = gt_option_new_verbose(&arguments->verbose);
   gt_option_parser_add_option(op, option);
@@ -256,6 +268,8 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
                *add_introns_stream = NULL,
                *set_source_stream = NULL,
                *gff3_out_stream = NULL,
+               *in_pipeline_stream = NULL,
+               *out_pipeline_stream = NULL,
                *last_stream;
   int had_err = 0;
 
@@ -312,6 +326,12 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
   if (!had_err && arguments->fixboundaries)
     gt_gff3_in_stream_fix_region_boundaries((GtGFF3InStream*) gff3_in_stream);
 
+  /* parse on a separate thread (if necessary) */
+  if (!had_err && arguments->threads) {
+    in_pipeline_stream = gt_pipeline_stream_new(last_stream, 0);
+    last_stream = in_pipeline_stream;
+  }
+
   /* create load stream (if necessary) */
   if (!had_err && arguments->load) {
     load_stream = gt_load_stream_new(last_stream);
@@ -347,6 +367,12 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
     last_stream = set_source_stream;
   }
 
+  /* process on a separate thread (if necessary) */
+  if (!had_err && arguments->threads && last_stream != in_pipeline_stream) {
+    out_pipeline_stream = gt_pipeline_stream_new(last_stream, 0);
+    last_stream = out_pipeline_stream;
+  }
+
   /* create gff3 output stream */
   if (!had_err && arguments->show) {
     if (arguments->sortlines) {
@@ -385,6 +411,8 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
 
   /* free */
   gt_node_stream_delete(gff3_out_stream);
+  gt_node_stream_delete(out_pipeline_stream);
+  gt_node_stream_delete(in_pipeline_stream);
   gt_node_stream_delete(sort_stream);
   gt_node_stream_delete(load_stream);
   gt_node_stream_delete(merge_feature_stream);
@@ -0,0 +1,170 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/ma_api.h"
+#include "core/option_api.h"
+#include "core/output_file_api.h"
+#include "core/undef_api.h"
+#include "core/unused_api.h"
+#include "extended/gff3_out_stream_api.h"
+#include "extended/gff3_region_in_stream_api.h"
+#include "extended/gff3_region_index.h"
+#include "tools/gt_gff3_index.h"
+
+typedef struct {
+  bool compress,
+       verbose;
+  GtStr *seqid;
+  GtRange range;
+  GtOutputFileInfo *ofi;
+  GtFile *outfp;
+} GFF3IndexArguments;
+
+static void* gt_gff3_index_arguments_new(void)
+{
+  GFF3IndexArguments *arguments = gt_calloc((size_t) 1, sizeof *arguments);
+  arguments->seqid = gt_str_new();
+  arguments->ofi = gt_output_file_info_new();
+  return arguments;
+}
+
+static void gt_gff3_index_arguments_delete(void *tool_arguments)
+{
+  GFF3IndexArguments *arguments = tool_arguments;
+  if (arguments != NULL) {
+    gt_file_delete(arguments->outfp);
+    gt_output_file_info_delete(arguments->ofi);
+    gt_str_delete(arguments->seqid);
+    gt_free(arguments);
+  }
+}
+
+static GtOptionParser* gt_gff3_index_option_parser_new(void *tool_arguments)
+{
+  GFF3IndexArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option, *seqid_option, *range_option, *compress_option;
+  static GtRange default_range = {1, GT_UNDEF_UWORD};
+  gt_assert(arguments);
+
+  /* init */
+  op = gt_option_parser_new("[option ...] GFF3_file",
+                            "Index a BGZF compressed, sorted GFF3_file for "
+                            "fast region queries or query such an index.");
+
+  /* -compress */
+  compress_option = gt_option_new_bool("compress", "compress the plain, "
+                                       "sorted GFF3_file to GFF3_file.gz in "
+                                       "BGZF format and index the result",
+                                       &arguments->compress, false);
+  gt_option_parser_add_option(op, compress_option);
+
+  /* -seqid */
+  seqid_option = gt_option_new_string("seqid", "query the index: output all "
+                                      "top-level features on the given "
+                                      "sequence region which overlap -range",
+                                      arguments->seqid, NULL);
+  gt_option_parser_add_option(op, seqid_option);
+
+  /* -range */
+  range_option = gt_option_new_range("range", "range of the index query",
+                                     &arguments->range, &default_range);
+  gt_option_parser_add_option(op, range_option);
+
+  /* -v */
+  option = gt_option_new_verbose(&arguments->verbose);
+  gt_option_parser_add_option(op, option);
+
+  gt_option_imply(range_option, seqid_option);
+  gt_option_exclude(compress_option, seqid_option);
+
+  /* output file options */
+  gt_output_file_info_register_options(arguments->ofi, op, &arguments->outfp);
+
+  gt_option_parser_set_min_max_args(op, 1, 1);
+
+  return op;
+}
+
+static int gff3_index_create(GFF3IndexArguments *arguments,
+                             const char *gff3file, GtError *err)
+{
+  GtGFF3RegionIndex *ri = NULL;
+  GtStr *bgzffile;
+  int had_err = 0;
+
+  bgzffile = gt_str_new_cstr(gff3file);
+  if (arguments->compress) {
+    gt_str_append_cstr(bgzffile, ".gz");
+    had_err = gt_gff3_region_index_bgzip(gff3file, gt_str_get(bgzffile), err);
+  }
+  if (!had_err &&
+      !(ri = gt_gff3_region_index_new_from_gff3(gt_str_get(bgzffile), err)))
+    had_err = -1;
+  if (!had_err)
+    had_err = gt_gff3_region_index_write(ri, gt_str_get(bgzffile), err);
+  if (!had_err && arguments->verbose) {
+    printf("# indexed "GT_WU" sequence regions of file \"%s\"\n",
+           gt_gff3_region_index_num_of_seqids(ri), gt_str_get(bgzffile));
+  }
+  gt_gff3_region_index_delete(ri);
+  gt_str_delete(bgzffile);
+  return had_err;
+}
+
+static int gff3_index_query(GFF3IndexArguments *arguments,
+                            const char *gff3file, GtError *err)
+{
+  GtNodeStream *region_in_stream, *gff3_out_stream;
+  int had_err;
+
+  if (!(region_in_stream = gt_gff3_region_in_stream_new(gff3file,
+                                                   gt_str_get(arguments->seqid),
+                                                   &arguments->range, err)))
+    return -1;
+  if (arguments->verbose) {
+    printf("# "GT_WU" overlapping top-level features\n",
+           gt_gff3_region_in_stream_num_of_features((GtGFF3RegionInStream*)
+                                                    region_in_stream));
+  }
+  gff3_out_stream = gt_gff3_out_stream_new(region_in_stream, arguments->outfp);
+  had_err = gt_node_stream_pull(gff3_out_stream, err);
+  gt_node_stream_delete(gff3_out_stream);
+  gt_node_stream_delete(region_in_stream);
+  return had_err;
+}
+
+static int gt_gff3_index_runner(GT_UNUSED int argc, const char **argv,
+                                int parsed_args, void *tool_arguments,
+                                GtError *err)
+{
+  GFF3IndexArguments *arguments = tool_arguments;
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  if (gt_str_length(arguments->seqid))
+    return gff3_index_query(arguments, argv[parsed_args], err);
+  return gff3_index_create(arguments, argv[parsed_args], err);
+}
+
+GtTool* gt_gff3_index(void)
+{
+  return gt_tool_new(gt_gff3_index_arguments_new,
+                     gt_gff3_index_arguments_delete,
+                     gt_gff3_index_option_parser_new,
+                     NULL,
+                     gt_gff3_index_runner);
+}
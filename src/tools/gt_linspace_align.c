@@ -40,6 +40,7 @@
 #include "extended/linearalign_affinegapcost.h"
 #include "extended/linspace_management.h"
 #include "extended/scorehandler.h"
+#include "extended/wavefrontalign.h"
 #include "tools/gt_linspace_align.h"
 
 #define LEFT_DIAGONAL_SHIFT(similarity, ulen, vlen) \
@@ -62,6 +63,7 @@ typedef struct{
   bool       global,
              local,
              diagonal, /* call diagonalband algorithm */
+             wavefront, /* call wavefront algorithm */
              dna,
              protein,
              has_costmatrix, /* special case of substitution matrix*/
@@ -139,7 +141,7 @@ static GtOptionParser* gt_linspace_align_option_parser_new(void *tool_arguments)
            *optionaffinecosts, *optionoutputfile, *optionshowscore,
            *optionshowsequences, *optiondiagonal, *optiondiagonalbonds,
            *optionsimilarity, *optiontsfactor, *optionspacetime,
-           *optionscoreonly, *optionwildcardsymbol;
+           *optionscoreonly, *optionwildcardsymbol, *optionwavefront;
 
   gt_assert(arguments);
 
@@ -164,6 +166,11 @@ static GtOptionParser* gt_linspace_align_option_parser_new(void *tool_arguments)
                                       &arguments->diagonal, false);
   gt_option_parser_add_option(op, optiondiagonal);
 
+  optionwavefront = gt_option_new_bool("wfa", "wavefront alignment, requires "
+                                       "mismatch cost > match cost",
+                                       &arguments->wavefront, false);
+  gt_option_parser_add_option(op, optionwavefront);
+
   optiondna = gt_option_new_bool("dna", "type of sequences: DNA",
                                  &arguments->dna, false);
   gt_option_parser_add_option(op, optiondna);
@@ -274,6 +281,9 @@ static GtOptionParser* gt_linspace_align_option_parser_new(void *tool_arguments)
   gt_option_imply_either_2(optionshowsequences, optionstrings, optionfiles);
   gt_option_imply_either_2(optionscoreonly,optionlinearcosts,optionaffinecosts);
   gt_option_imply(optiondiagonal, optionglobal);
+  gt_option_imply(optionwavefront, optionglobal);
+  gt_option_exclude(optionwavefront, optiondiagonal);
+  gt_option_exclude(optionwavefront, optionprotein);
   gt_option_imply(optiondiagonalbonds, optiondiagonal);
   gt_option_imply(optionsimilarity, optiondiagonal);
   gt_option_imply(optioncostmatrix, optionprotein);
@@ -528,7 +538,12 @@ static int gt_all_against_all_alignment_check(bool affine,
       gt_alignment_reset(align);
       if (arguments->global)
       {
-        if (arguments->diagonal)
+        if (arguments->wavefront)
+        {
+          (void) gt_wavefrontalign_compute_generic(scorehandler, align,
+                                                   useq, 0, ulen,
+                                                   vseq, 0, vlen);
+        } else if (arguments->diagonal)
         {
           if (gt_str_array_size(arguments->diagonalbonds) == 0)
           {
@@ -800,6 +815,10 @@ static int gt_linspace_align_runner(GT_UNUSED int argc,
       }
     }
   }
+  if (!had_err && arguments->wavefront)
+  {
+    had_err = gt_wavefrontalign_check_scorehandler(scorehandler, err);
+  }
   /* get diagonal band */
   if (!had_err && arguments->diagonal)
   {
@@ -25,6 +25,7 @@
 #include "match/sfx-run.h"
 #include "tools/gt_packedindex.h"
 #include "tools/gt_packedindex_mkctxmap.h"
+#include "tools/gt_packedindex_mksample.h"
 #include "tools/gt_packedindex_trsuftab.h"
 #include "tools/gt_packedindex_chk_integrity.h"
 #include "tools/gt_packedindex_chk_search.h"
@@ -40,6 +41,7 @@ static void* gt_packedindex_arguments_new(void)
   GtToolbox *packedindex_toolbox = gt_toolbox_new();
   gt_toolbox_add(packedindex_toolbox, "mkindex", gt_packedindex_make);
   gt_toolbox_add(packedindex_toolbox, "mkctxmap", gt_packedindex_mkctxmap);
+  gt_toolbox_add(packedindex_toolbox, "mksample", gt_packedindex_mksample);
   gt_toolbox_add(packedindex_toolbox, "trsuftab", gt_packedindex_trsuftab);
   gt_toolbox_add(packedindex_toolbox, "chkintegrity",
               gt_packedindex_chk_integrity );
@@ -18,6 +18,7 @@
 #include <string.h>
 #include "core/error_api.h"
 #include "core/logger.h"
+#include "core/ma_api.h"
 #include "core/minmax_api.h"
 #include "core/option_api.h"
 #include "core/str_api.h"
@@ -38,7 +39,8 @@ struct chkSearchOptions
 {
   struct bwtOptions idx;
   GtWord minPatLen, maxPatLen;
-  GtUword numOfSamples, progressInterval;
+  GtUword numOfSamples, progressInterval, batchSize;
+  unsigned locateCacheLog;
   int flags;
   bool verboseOutput;
 };
@@ -48,6 +50,106 @@ parseChkBWTOptions(int *parsed_args, int argc, const char **argv,
                    struct chkSearchOptions *params, const GtStr *projectName,
                    GtError *err);
 
+/* searches the patterns in batches with gt_BWTSeqMatchBoundsBatch and
+ * compares the results with those of the suffix array */
+static int
+chkSearchBatches(const BWTSeq *bwtSeq, const Suffixarray *suffixarray,
+                 GtUword totalLen, Enumpatterniterator *epi,
+                 const struct chkSearchOptions *params, GtUword *trial,
+                 GtError *err)
+{
+  GtUword batchSize = params->batchSize,
+          maxPatLen = (GtUword) params->maxPatLen,
+          *positions = NULL, positionsAlloc = 0;
+  GtUchar *patterns = gt_malloc(sizeof (*patterns) * batchSize * maxPatLen);
+  const Symbol **queries = gt_malloc(sizeof (*queries) * batchSize);
+  size_t *queryLens = gt_malloc(sizeof (*queryLens) * batchSize);
+  struct matchBound *bounds = gt_malloc(sizeof (*bounds) * batchSize);
+  BWTSeqLocateCache *cache = NULL;
+  int had_err = 0;
+
+  if (params->locateCacheLog > 0)
+    cache = gt_newBWTSeqLocateCache(params->locateCacheLog);
+  for (*trial = 0; !had_err && *trial < params->numOfSamples; /* Nothing */)
+  {
+    GtUword idx, posIdx = 0, numPositions = 0,
+            numQueries = GT_MIN(batchSize, params->numOfSamples - *trial);
+
+    for (idx = 0; idx < numQueries; idx++)
+    {
+      GtUword patternLen;
+      const GtUchar *pptr = gt_nextEnumpatterniterator(&patternLen, epi);
+      gt_assert(patternLen <= maxPatLen);
+      memcpy(patterns + idx * maxPatLen, pptr,
+             sizeof (*patterns) * patternLen);
+      queries[idx] = patterns + idx * maxPatLen;
+      queryLens[idx] = (size_t) patternLen;
+    }
+    gt_BWTSeqMatchBoundsBatch(bwtSeq, queries, queryLens, numQueries, false,
+                              bounds);
+    if (BWTSeqHasLocateInformation(bwtSeq))
+    {
+      for (idx = 0; idx < numQueries; idx++)
+      {
+        if (bounds[idx].start < bounds[idx].end)
+          numPositions += bounds[idx].end - bounds[idx].start;
+      }
+      if (numPositions > positionsAlloc)
+      {
+        positionsAlloc = numPositions;
+        positions = gt_realloc(positions,
+                               sizeof (*positions) * positionsAlloc);
+      }
+      gt_BWTSeqLocateBatch(bwtSeq, bounds, numQueries, positions, cache);
+    }
+    for (idx = 0; !had_err && idx < numQueries; idx++)
+    {
+      GtUword dbstart, numFMIMatches = bounds[idx].start < bounds[idx].end
+                                       ? bounds[idx].end - bounds[idx].start
+                                       : 0;
+      GtMMsearchiterator *mmsi =
+        gt_mmsearchiterator_new_complete_plain(suffixarray->encseq,
+                                               suffixarray->suftab,
+                                               0, /* leftbound */
+                                               totalLen, /* rightbound */
+                                               0, /* offset */
+                                               suffixarray->readmode,
+                                               queries[idx],
+                                               queryLens[idx]);
+      if (numFMIMatches != gt_mmsearchiterator_count(mmsi))
+      {
+        gt_error_set(err, "Number of matches not equal for suffix array ("
+                     GT_WU") and batch search ("GT_WU").",
+                     gt_mmsearchiterator_count(mmsi), numFMIMatches);
+        had_err = -1;
+      }
+      while (!had_err && BWTSeqHasLocateInformation(bwtSeq)
+             && gt_mmsearchiterator_next(&dbstart, mmsi))
+      {
+        if (positions[posIdx] != dbstart)
+        {
+          gt_error_set(err, "batch search match doesn't equal mmsearch "
+                       "match result: "GT_WU" vs. "GT_WU,
+                       positions[posIdx], dbstart);
+          had_err = -1;
+        }
+        posIdx++;
+      }
+      gt_mmsearchiterator_delete(mmsi);
+      (*trial)++;
+      if (params->progressInterval && !(*trial % params->progressInterval))
+        putc('.', stderr);
+    }
+  }
+  gt_deleteBWTSeqLocateCache(cache);
+  gt_free(positions);
+  gt_free(bounds);
+  gt_free(queryLens);
+  gt_free(queries);
+  gt_free(patterns);
+  return had_err;
+}
+
 extern int
 gt_packedindex_chk_search(int argc, const char *argv[], GtError *err)
 {
@@ -174,7 +276,11 @@ gt_packedindex_chk_search(int argc, const char *argv[], GtError *err)
         fputs("Creation of pattern iterator failed!\n", stderr);
         break;
       }
-      for (trial = 0; !had_err && trial < params.numOfSamples; ++trial)
+      trial = 0;
+      if (params.batchSize > 0)
+        had_err = chkSearchBatches(bwtSeq, &suffixarray, totalLen, epi,
+                                   &params, &trial, err) != 0;
+      for (/* Nothing */; !had_err && trial < params.numOfSamples; ++trial)
       {
         const GtUchar *pptr = gt_nextEnumpatterniterator(&patternLen, epi);
         GtMMsearchiterator *mmsi =
@@ -297,6 +403,21 @@ parseChkBWTOptions(int *parsed_args, int argc, const char **argv,
                             &params->numOfSamples, 1000);
   gt_option_parser_add_option(op, option);
 
+  option = gt_option_new_uword("batch",
+                            "search the patterns in batches of this size "
+                            "with the interleaved batch search\n"
+                            "0 searches them one at a time",
+                            &params->batchSize, 0);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uint_max("loccache",
+                                  "keep the positions of the last located "
+                                  "rows in a cache of 2^loccache entries "
+                                  "for the batch search\n"
+                                  "0 disables the cache",
+                                  &params->locateCacheLog, 0, 30U);
+  gt_option_parser_add_option(op, option);
+
   option = gt_option_new_bool("chksfxarray",
                            "verify integrity of stored suffix array positions",
                            &checkSuffixArrayValues, false);
@@ -0,0 +1,174 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/error_api.h"
+#include "core/fileutils_api.h"
+#include "core/logger.h"
+#include "core/option_api.h"
+#include "core/str_api.h"
+#include "core/versionfunc_api.h"
+#include "core/xansi_api.h"
+#include "match/eis-bwtseq.h"
+#include "match/eis-bwtseq-construct.h"
+#include "match/eis-bwtseq-sass.h"
+#include "match/eis-sasample.h"
+
+#include "match/sarr-def.h"
+#include "match/esa-fileend.h"
+#include "match/esa-map.h"
+#include "tools/gt_packedindex_mksample.h"
+
+struct mkSampleOptions
+{
+  unsigned sampleRate;
+  bool verboseOutput;
+};
+
+static GtOPrval
+parseMkSampleOptions(int *parsed_args, int argc, const char **argv,
+                     struct mkSampleOptions *params, GtError *err);
+
+extern int
+gt_packedindex_mksample(int argc, const char *argv[], GtError *err)
+{
+  struct mkSampleOptions params;
+  const char *projectName;
+  GtLogger *logger = NULL;
+  BWTSeq *bwtSeq = NULL;
+  SASeqSrc *src = NULL;
+  GtStr *suftabName;
+  int parsedArgs;
+  bool had_err = false, haveSuftab;
+  bool saInitialized = false, saiInitialized = false;
+  Suffixarray sa;
+  SuffixarrayFileInterface sai;
+
+  do {
+    gt_error_check(err);
+    {
+      bool exitNow = false;
+      switch (parseMkSampleOptions(&parsedArgs, argc, argv, &params, err))
+      {
+      case GT_OPTION_PARSER_OK:
+        break;
+      case GT_OPTION_PARSER_ERROR:
+        had_err = true;
+        exitNow = true;
+        break;
+      case GT_OPTION_PARSER_REQUESTS_EXIT:
+        exitNow = true;
+        break;
+      }
+      if (exitNow)
+        break;
+    }
+    projectName = argv[parsedArgs];
+    if (params.sampleRate == 0)
+    {
+      /* fall back to the locate information of the index */
+      GtStr *ssxName = gt_str_new_cstr(projectName);
+      gt_str_append_cstr(ssxName, SSI_FILE_SUFFIX);
+      if (gt_file_exists(gt_str_get(ssxName)))
+        gt_xremove(gt_str_get(ssxName));
+      gt_str_delete(ssxName);
+      break;
+    }
+    logger = gt_logger_new(params.verboseOutput,
+                           GT_LOGGER_DEFLT_PREFIX, stdout);
+    suftabName = gt_str_new_cstr(projectName);
+    gt_str_append_cstr(suftabName, GT_SUFTABSUFFIX);
+    haveSuftab = gt_file_exists(gt_str_get(suftabName));
+    gt_str_delete(suftabName);
+    if (streamsuffixarray(&sa, haveSuftab ? SARR_SUFTAB : 0, projectName,
+                          logger, err))
+    {
+      had_err = true;
+      break;
+    }
+    saInitialized = true;
+    bwtSeq = gt_loadBWTSeqForSA(projectName, BWT_ON_BLOCK_ENC,
+                                BWTDEFOPT_MULTI_QUERY,
+                                gt_encseq_alphabet(sa.encseq), err);
+    if (bwtSeq == NULL)
+    {
+      had_err = true;
+      break;
+    }
+    if (haveSuftab)
+    {
+      gt_initSuffixarrayFileInterface(&sai,
+                                      gt_encseq_total_length(sa.encseq) + 1,
+                                      &sa);
+      saiInitialized = true;
+      src = SAI2SASS(&sai);
+    }
+    else if (!(src = gt_BWTSeqNewSASeqSrc(bwtSeq, NULL)))
+    {
+      gt_error_set(err, "The project %s does not contain sufficient"
+                   " information to regenerate the suffix array.",
+                   projectName);
+      had_err = true;
+      break;
+    }
+    if (gt_writeSASampleIdx(bwtSeq, SASSCreateReader(src, SFX_REQUEST_SUFTAB),
+                            params.sampleRate, projectName, err) != 0)
+      had_err = true;
+  } while (0);
+  if (src != NULL && !saiInitialized)
+    SASSDelete(src);
+  if (bwtSeq)
+    gt_deleteBWTSeq(bwtSeq);
+  if (saiInitialized) gt_destructSuffixarrayFileInterface(&sai);
+  if (saInitialized) gt_freesuffixarray(&sa);
+  if (logger) gt_logger_delete(logger);
+  return had_err?-1:0;
+}
+
+static GtOPrval
+parseMkSampleOptions(int *parsed_args, int argc, const char **argv,
+                     struct mkSampleOptions *params, GtError *err)
+{
+  GtOptionParser *op;
+  GtOption *option;
+  GtOPrval oprval;
+
+  gt_error_check(err);
+  op = gt_option_parser_new("indexname",
+                            "Build suffix array samples for locating "
+                            "matches in BWT packedindex <indexname>.");
+
+  option = gt_option_new_uint("rate",
+                              "sample every suffix starting at a multiple "
+                              "of this value\n"
+                              "0 removes the samples, locating then uses "
+                              "the locate information stored in the index",
+                              &params->sampleRate, 16U);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_bool("v",
+                              "print verbose progress information",
+                              &params->verboseOutput,
+                              false);
+  gt_option_parser_add_option(op, option);
+
+  gt_option_parser_set_min_max_args(op, 1, 1);
+  oprval = gt_option_parser_parse(op, parsed_args, argc, argv, gt_versionfunc,
+                                  err);
+
+  gt_option_parser_delete(op);
+
+  return oprval;
+}
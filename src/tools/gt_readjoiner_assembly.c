@@ -20,12 +20,17 @@
 #include "core/logger.h"
 #include "core/fa_api.h"
 #include "core/ma_api.h"
+#include "core/minmax_api.h"
 #include "core/unused_api.h"
 #include "core/showtime.h"
 #include "core/spacecalc.h"
+#ifdef GT_THREADS_ENABLED
+#include "core/thread_api.h"
+#endif
 #include "match/rdj-contigpaths.h"
 #include "match/rdj-cntlist.h"
-#include "match/rdj-spmlist.h"
+#include "match/rdj-spmbuffer.h"
+#include "match/rdj-spmfind.h"
 #include "match/rdj-strgraph.h"
 #include "match/rdj-filesuf-def.h"
 #include "match/rdj-version.h"
@@ -35,12 +40,12 @@ typedef struct {
   bool verbose, quiet;
   unsigned int minmatchlength;
   unsigned int lengthcutoff, depthcutoff;
-  GtStr  *readset, *buffersizearg;
+  GtStr  *readset, *buffersizearg, *spmmemlimitarg;
   bool errors, paths2seq, redtrans, save, load, vd, astat, copynum,
-       show_contigs_info;
+       show_contigs_info, overlap;
   unsigned int deadend, bubble, deadend_depth;
-  GtOption *refoptionbuffersize;
-  GtUword buffersize;
+  GtOption *refoptionbuffersize, *refoptionspmmemlimit;
+  GtUword buffersize, spmmemlimit, vrangeminsize;
   unsigned int nspmfiles;
   double coverage;
 } GtReadjoinerAssemblyArguments;
@@ -52,6 +57,8 @@ static void* gt_readjoiner_assembly_arguments_new(void)
   arguments->readset = gt_str_new();
   arguments->buffersizearg = gt_str_new();
   arguments->buffersize = 0UL; /* in bytes */
+  arguments->spmmemlimitarg = gt_str_new();
+  arguments->spmmemlimit = 0UL; /* in bytes */
   return arguments;
 }
 
@@ -62,7 +69,9 @@ static void gt_readjoiner_assembly_arguments_delete(void *tool_arguments)
     return;
   gt_str_delete(arguments->readset);
   gt_str_delete(arguments->buffersizearg);
+  gt_str_delete(arguments->spmmemlimitarg);
   gt_option_delete(arguments->refoptionbuffersize);
+  gt_option_delete(arguments->refoptionspmmemlimit);
   gt_free(arguments);
 }
 
@@ -72,7 +81,8 @@ static GtOptionParser* gt_readjoiner_assembly_option_parser_new(
   GtReadjoinerAssemblyArguments *arguments = tool_arguments;
   GtOptionParser *op;
   GtOption *option, *errors_option, *deadend_option, *v_option,
-           *q_option, *bubble_option, *deadend_depth_option;
+           *q_option, *bubble_option, *deadend_depth_option, *spmfiles_option,
+           *l_option, *overlap_option, *load_option;
   gt_assert(arguments);
 
   /* init */
@@ -86,17 +96,38 @@ static GtOptionParser* gt_readjoiner_assembly_option_parser_new(
   gt_option_is_mandatory(option);
 
   /* -spmfiles */
-  option = gt_option_new_uint_min("spmfiles", "number of SPM files to read\n"
-      "this must be equal to the value of -j for the overlap phase",
+  spmfiles_option = gt_option_new_uint_min("spmfiles", "number of SPM files "
+      "to read\nthis must be equal to the value of -j for the overlap phase",
       &arguments->nspmfiles, 1U, 1U);
-  gt_option_is_extended_option(option);
-  gt_option_parser_add_option(op, option);
+  gt_option_is_extended_option(spmfiles_option);
+  gt_option_parser_add_option(op, spmfiles_option);
 
   /* -l */
-  option = gt_option_new_uint_min("l", "specify the minimum SPM length",
+  l_option = gt_option_new_uint_min("l", "specify the minimum SPM length",
       &arguments->minmatchlength, 0, 2U);
+  gt_option_is_extended_option(l_option);
+  gt_option_parser_add_option(op, l_option);
+
+  /* -overlap */
+  overlap_option = gt_option_new_bool("overlap", "compute the SPMs of length "
+      "at least the value of -l and pass them to the assembly in memory, "
+      "instead of reading the SPM files of the overlap phase",
+      &arguments->overlap, false);
+  gt_option_is_extended_option(overlap_option);
+  gt_option_imply(overlap_option, l_option);
+  gt_option_exclude(overlap_option, spmfiles_option);
+  gt_option_parser_add_option(op, overlap_option);
+
+  /* -spmmemlimit */
+  option = gt_option_new_string("spmmemlimit", "specify maximal amount of "
+      "memory for the SPMs computed using -overlap; SPMs exceeding it are "
+      "written to temporary files, which are removed after loading (a "
+      "number followed by one of the keywords 'MB' and 'GB')",
+      arguments->spmmemlimitarg, NULL);
   gt_option_is_extended_option(option);
+  gt_option_imply(option, overlap_option);
   gt_option_parser_add_option(op, option);
+  arguments->refoptionspmmemlimit = gt_option_ref(option);
 
   /* -depthcutoff */
   option = gt_option_new_uint_min("depthcutoff", "specify the minimal "
@@ -201,10 +232,11 @@ static GtOptionParser* gt_readjoiner_assembly_option_parser_new(
   gt_option_exclude(q_option, v_option);
 
   /* -load */
-  option = gt_option_new_bool("load", "save the string graph from file",
+  load_option = gt_option_new_bool("load", "save the string graph from file",
       &arguments->load, false);
-  gt_option_is_development_option(option);
-  gt_option_parser_add_option(op, option);
+  gt_option_is_development_option(load_option);
+  gt_option_exclude(load_option, overlap_option);
+  gt_option_parser_add_option(op, load_option);
 
   /* -save */
   option = gt_option_new_bool("save", "save the string graph to file",
@@ -212,6 +244,13 @@ static GtOptionParser* gt_readjoiner_assembly_option_parser_new(
   gt_option_is_development_option(option);
   gt_option_parser_add_option(op, option);
 
+  /* -vrangeminsize */
+  option = gt_option_new_uword("vrangeminsize", "minimal number of vertices "
+      "processed by each thread in the string graph passes over vertex "
+      "ranges (0: use the default)", &arguments->vrangeminsize, 0);
+  gt_option_is_development_option(option);
+  gt_option_parser_add_option(op, option);
+
   /* -show_contigs_info */
   option = gt_option_new_bool("cinfo", "output additional files required "
       "for contigs graph construction (eqlen only)",
@@ -235,9 +274,15 @@ static int gt_readjoiner_assembly_arguments_check(GT_UNUSED int rest_argc,
     if (gt_option_parse_spacespec(&arguments->buffersize,
           "buffersize", arguments->buffersizearg, err) != 0)
       had_err = -1;
+  if (had_err == 0 && gt_option_is_set(arguments->refoptionspmmemlimit))
+    if (gt_option_parse_spacespec(&arguments->spmmemlimit,
+          "spmmemlimit", arguments->spmmemlimitarg, err) != 0)
+      had_err = -1;
   return had_err;
 }
 
+#define GT_READJOINER_ASSEMBLY_MSG_OVERLAP \
+  "compute suffix-prefix matches"
 #define GT_READJOINER_ASSEMBLY_MSG_COUNTSPM \
   "calculate edges space for each vertex"
 #define GT_READJOINER_ASSEMBLY_MSG_BUILDSG \
@@ -258,35 +303,18 @@ static int gt_readjoiner_assembly_arguments_check(GT_UNUSED int rest_argc,
   "save string graph to file"
 
 static int gt_readjoiner_assembly_count_spm(const char *readset, bool eqlen,
-    unsigned int minmatchlength, unsigned int nspmfiles, GtStrgraph *strgraph,
-    GtBitsequence *contained, GtLogger *default_logger, GtError *err)
+    unsigned int minmatchlength, unsigned int nspmfiles,
+    GtSpmbuffer **spmbuffers, GtStrgraph *strgraph, GtBitsequence *contained,
+    GtLogger *default_logger, GtError *err)
 {
-  GtSpmprocSkipData skipdata;
-  int had_err = 0;
-  unsigned int i;
-  GtStr *filename = gt_str_new();
   gt_logger_log(default_logger, GT_READJOINER_ASSEMBLY_MSG_COUNTSPM);
-  if (!eqlen)
-  {
-    skipdata.out.e.proc = gt_spmproc_strgraph_count;
-    skipdata.to_skip = contained;
-    skipdata.out.e.data = strgraph;
-    skipdata.skipped_counter = 0;
-  }
-  for (i = 0; i < nspmfiles; i++)
-  {
-    gt_str_append_cstr(filename, readset);
-    gt_str_append_char(filename, '.');
-    gt_str_append_uint(filename, i);
-    gt_str_append_cstr(filename, GT_READJOINER_SUFFIX_SPMLIST);
-    had_err = gt_spmlist_parse(gt_str_get(filename),
-        (GtUword)minmatchlength,
-        eqlen ? gt_spmproc_strgraph_count : gt_spmproc_skip,
-        eqlen ? (void*)strgraph : (void*)&skipdata, err);
-    gt_str_reset(filename);
-  }
-  gt_str_delete(filename);
-  return had_err;
+  if (spmbuffers != NULL)
+    return gt_strgraph_count_spm_from_spmbuffers(strgraph,
+        (GtUword)minmatchlength, eqlen ? NULL : contained, spmbuffers,
+        nspmfiles, err);
+  return gt_strgraph_count_spm_from_file(strgraph, (GtUword)minmatchlength,
+      eqlen ? NULL : contained, readset, nspmfiles,
+      GT_READJOINER_SUFFIX_SPMLIST, err);
 }
 
 static int gt_readjoiner_assembly_error_correction(GtStrgraph *strgraph,
@@ -402,19 +430,21 @@ static inline void gt_readjoiner_assembly_show_current_space(const char *label)
 static int gt_readjoiner_assembly_build_graph(
     GtReadjoinerAssemblyArguments *arguments, GtStrgraph **strgraph,
     GtEncseq *reads, const char *readset, bool eqlen, GtUword rlen,
-    GtUword nreads, GtBitsequence *contained, GtLogger *default_logger,
-    GtLogger *verbose_logger, GtTimer *timer, GtError *err)
+    GtUword nreads, GtBitsequence *contained, GtSpmbuffer **spmbuffers,
+    GtLogger *default_logger, GtLogger *verbose_logger, GtTimer *timer,
+    GtError *err)
 {
   int had_err = 0;
   *strgraph = gt_strgraph_new(nreads);
+  gt_strgraph_set_vrange_minsize(*strgraph, arguments->vrangeminsize);
 
   if (arguments->minmatchlength > 0)
     gt_logger_log(verbose_logger, "SPM length cutoff = %u",
         arguments->minmatchlength);
 
   had_err = gt_readjoiner_assembly_count_spm(readset, eqlen,
-      arguments->minmatchlength, arguments->nspmfiles, *strgraph, contained,
-      default_logger, err);
+      arguments->minmatchlength, arguments->nspmfiles, spmbuffers, *strgraph,
+      contained, default_logger, err);
   gt_readjoiner_assembly_show_current_space("(edges counted)");
   if (gt_showtime_enabled())
     gt_timer_show_progress(timer, GT_READJOINER_ASSEMBLY_MSG_BUILDSG, stdout);
@@ -426,10 +456,15 @@ static int gt_readjoiner_assembly_build_graph(
         (!eqlen && rlen == 0 && reads != NULL));
     gt_strgraph_allocate_graph(*strgraph, rlen, reads);
     gt_readjoiner_assembly_show_current_space("(graph allocated)");
-    had_err = gt_strgraph_load_spm_from_file(*strgraph,
-        (GtUword)arguments->minmatchlength, arguments->redtrans,
-        contained, readset, arguments->nspmfiles,
-        GT_READJOINER_SUFFIX_SPMLIST, err);
+    if (spmbuffers != NULL)
+      had_err = gt_strgraph_load_spm_from_spmbuffers(*strgraph,
+          (GtUword)arguments->minmatchlength, arguments->redtrans,
+          contained, spmbuffers, arguments->nspmfiles, err);
+    else
+      had_err = gt_strgraph_load_spm_from_file(*strgraph,
+          (GtUword)arguments->minmatchlength, arguments->redtrans,
+          contained, readset, arguments->nspmfiles,
+          GT_READJOINER_SUFFIX_SPMLIST, err);
   }
   return had_err;
 }
@@ -476,6 +511,66 @@ static int gt_readjoiner_assembly_build_contained_reads_list(
   return had_err;
 }
 
+/* compute the SPMs of the readset using one GtSpmbuffer for each thread;
+   the number of buffers is stored in arguments->nspmfiles */
+static int gt_readjoiner_assembly_overlap(
+    GtReadjoinerAssemblyArguments *arguments, GtSpmbuffer ***spmbuffers,
+    GtLogger *default_logger, GtLogger *verbose_logger, GtError *err)
+{
+  int had_err = 0;
+  GtEncseqLoader *el;
+  GtEncseq *encseq;
+  GtUword nof_irr_spm = 0, nof_trans_spm = 0;
+  unsigned int i;
+#ifdef GT_THREADS_ENABLED
+  const unsigned int threads = gt_jobs;
+#else
+  const unsigned int threads = 1U;
+#endif
+
+  gt_logger_log(default_logger, GT_READJOINER_ASSEMBLY_MSG_OVERLAP);
+  el = gt_encseq_loader_new();
+  gt_encseq_loader_drop_description_support(el);
+  gt_encseq_loader_disable_autosupport(el);
+  encseq = gt_encseq_loader_load(el, gt_str_get(arguments->readset), err);
+  if (encseq == NULL || gt_encseq_mirror(encseq, err) != 0)
+    had_err = -1;
+  if (had_err == 0)
+  {
+    arguments->nspmfiles = threads;
+    *spmbuffers = gt_malloc(sizeof (**spmbuffers) * threads);
+    for (i = 0; i < threads; i++)
+    {
+      (*spmbuffers)[i] = gt_spmbuffer_new(arguments->spmmemlimit > 0
+          ? GT_MAX(arguments->spmmemlimit / threads, 1UL) : 0);
+    }
+    had_err = gt_spmfind_all(encseq, arguments->minmatchlength,
+        (GtUword) GT_SPMFIND_DEFAULT_W_MAXSIZE, GT_SPMFIND_DEFAULT_ELIMTRANS,
+        GT_SPMFIND_OUTPUT_BUFFER, *spmbuffers,
+        gt_str_get(arguments->readset), GT_SPMFIND_DEFAULT_NUMOFPARTS,
+        GT_SPMFIND_DEFAULT_MAXIMUMSPACE, GT_SPMFIND_DEFAULT_PHASE2EXTRA,
+        GT_SPMFIND_DEFAULT_RADIXSMALL, GT_SPMFIND_DEFAULT_RADIXPARTS,
+        GT_SPMFIND_DEFAULT_ONLYALLFIRSTCODES, &nof_irr_spm, &nof_trans_spm,
+        default_logger, verbose_logger, err);
+  }
+  if (had_err == 0)
+  {
+    gt_logger_log(default_logger, "number of irreducible suffix-prefix "
+        "matches = "GT_WU"", nof_irr_spm);
+    gt_logger_log(verbose_logger, "number of transitive suffix-prefix "
+        "matches = "GT_WU"", nof_trans_spm);
+    for (i = 0; i < threads; i++)
+    {
+      if (gt_spmbuffer_is_spilled((*spmbuffers)[i]))
+        gt_logger_log(verbose_logger, "SPMs of thread %u written to "
+            "temporary file", i);
+    }
+  }
+  gt_encseq_delete(encseq);
+  gt_encseq_loader_delete(el);
+  return had_err;
+}
+
 static int gt_readjoiner_assembly_runner(GT_UNUSED int argc,
     GT_UNUSED const char **argv, GT_UNUSED int parsed_args,
     void *tool_arguments, GtError *err)
@@ -487,9 +582,11 @@ static int gt_readjoiner_assembly_runner(GT_UNUSED int argc,
   GtTimer *timer = NULL;
   GtStrgraph *strgraph = NULL;
   GtBitsequence *contained = NULL;
+  GtSpmbuffer **spmbuffers = NULL;
   const char *readset = gt_str_get(arguments->readset);
   bool eqlen = true;
   GtUword nreads, tlen, rlen;
+  unsigned int i;
   int had_err = 0;
 
   gt_assert(arguments);
@@ -504,13 +601,23 @@ static int gt_readjoiner_assembly_runner(GT_UNUSED int argc,
   gt_logger_log(verbose_logger, "readset name = %s", readset);
   if (gt_showtime_enabled())
   {
-    timer = gt_timer_new_with_progress_description(
-        GT_READJOINER_ASSEMBLY_MSG_COUNTSPM);
+    timer = gt_timer_new_with_progress_description(arguments->overlap
+        ? GT_READJOINER_ASSEMBLY_MSG_OVERLAP
+        : GT_READJOINER_ASSEMBLY_MSG_COUNTSPM);
     gt_timer_start(timer);
     gt_timer_show_cpu_time_by_progress(timer);
   }
 
-  if (!arguments->paths2seq)
+  if (!arguments->paths2seq && arguments->overlap)
+  {
+    had_err = gt_readjoiner_assembly_overlap(arguments, &spmbuffers,
+        default_logger, verbose_logger, err);
+    if (gt_showtime_enabled())
+      gt_timer_show_progress(timer, GT_READJOINER_ASSEMBLY_MSG_COUNTSPM,
+          stdout);
+  }
+
+  if (!arguments->paths2seq && had_err == 0)
   {
     el = gt_encseq_loader_new();
     gt_encseq_loader_drop_description_support(el);
@@ -552,13 +659,21 @@ static int gt_readjoiner_assembly_runner(GT_UNUSED int argc,
       if (!arguments->load)
       {
         had_err = gt_readjoiner_assembly_build_graph(arguments, &strgraph,
-            reads, readset, eqlen, rlen, nreads, contained, default_logger,
-            verbose_logger, timer, err);
+            reads, readset, eqlen, rlen, nreads, contained, spmbuffers,
+            default_logger, verbose_logger, timer, err);
+        if (spmbuffers != NULL)
+        {
+          for (i = 0; i < arguments->nspmfiles; i++)
+            gt_spmbuffer_delete(spmbuffers[i]);
+          gt_free(spmbuffers);
+          spmbuffers = NULL;
+        }
       }
       else
       {
         gt_readjoiner_assembly_load_graph(&strgraph, reads, readset, rlen,
             default_logger, timer);
+        gt_strgraph_set_vrange_minsize(strgraph, arguments->vrangeminsize);
       }
     }
 
@@ -641,6 +756,12 @@ static int gt_readjoiner_assembly_runner(GT_UNUSED int argc,
         arguments->buffersize, default_logger, &timer, err);
   }
 
+  if (spmbuffers != NULL)
+  {
+    for (i = 0; i < arguments->nspmfiles; i++)
+      gt_spmbuffer_delete(spmbuffers[i]);
+    gt_free(spmbuffers);
+  }
   if (gt_showtime_enabled())
   {
     gt_timer_show_progress_final(timer, stdout);
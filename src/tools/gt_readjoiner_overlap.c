@@ -23,13 +23,8 @@
 #include "core/encseq.h"
 #include "core/intbits.h"
 #include "core/logger.h"
-#include "core/minmax_api.h"
-#ifdef GT_THREADS_ENABLED
-#include "core/thread_api.h"
-#endif
 #include "match/rdj-spmfind.h"
 #include "match/rdj-version.h"
-#include "match/firstcodes.h"
 #include "tools/gt_readjoiner_overlap.h"
 
 typedef struct {
@@ -45,7 +40,8 @@ typedef struct {
                 phase2extra;
   GtStr *encseqinput,
         *memlimitarg,
-        *phase2extraarg;
+        *phase2extraarg,
+        *spmformat;
   GtOption *refoptionmemlimit,
            *refoptionphase2extra;
   bool radixsmall;
@@ -58,11 +54,12 @@ static void* gt_readjoiner_overlap_arguments_new(void)
   GtReadjoinerOverlapArguments *arguments = gt_calloc((size_t) 1,
       sizeof *arguments);
   arguments->encseqinput = gt_str_new();
-  arguments->numofparts = 0;
+  arguments->numofparts = GT_SPMFIND_DEFAULT_NUMOFPARTS;
   arguments->memlimitarg = gt_str_new();
   arguments->phase2extraarg = gt_str_new();
-  arguments->phase2extra = 0UL; /* in bytes */
-  arguments->maximumspace = 0UL; /* in bytes */
+  arguments->spmformat = gt_str_new();
+  arguments->phase2extra = GT_SPMFIND_DEFAULT_PHASE2EXTRA; /* in bytes */
+  arguments->maximumspace = GT_SPMFIND_DEFAULT_MAXIMUMSPACE; /* in bytes */
   return arguments;
 }
 
@@ -75,9 +72,13 @@ static void gt_readjoiner_overlap_arguments_delete(void *tool_arguments)
   gt_option_delete(arguments->refoptionphase2extra);
   gt_str_delete(arguments->memlimitarg);
   gt_str_delete(arguments->phase2extraarg);
+  gt_str_delete(arguments->spmformat);
   gt_free(arguments);
 }
 
+static const char *gt_readjoiner_overlap_spmformat_names[]
+  = {"bin", "varint", NULL};
+
 static GtOptionParser* gt_readjoiner_overlap_option_parser_new(
     void *tool_arguments)
 {
@@ -106,7 +107,8 @@ static GtOptionParser* gt_readjoiner_overlap_option_parser_new(
 
   /* -parts */
   optionparts = gt_option_new_uint("parts", "specify the number of parts",
-                                  &arguments->numofparts, 0U);
+                                  &arguments->numofparts,
+                                  GT_SPMFIND_DEFAULT_NUMOFPARTS);
   gt_option_parser_add_option(op, optionparts);
 
   /* -memlimit */
@@ -119,6 +121,17 @@ static GtOptionParser* gt_readjoiner_overlap_option_parser_new(
   gt_option_exclude(optionmemlimit, optionparts);
   arguments->refoptionmemlimit = gt_option_ref(optionmemlimit);
 
+  /* -spmformat */
+  option = gt_option_new_choice("spmformat", "format of the SPM files\n"
+                                "bin: fixed size integers\n"
+                                "varint: compact delta and variable length "
+                                "coded integers",
+                                arguments->spmformat,
+                                gt_readjoiner_overlap_spmformat_names[0],
+                                gt_readjoiner_overlap_spmformat_names);
+  gt_option_is_extended_option(option);
+  gt_option_parser_add_option(op, option);
+
   /* -singlestrand */
   option = gt_option_new_bool("singlestrand", "do not use reverse complements "
       "of the reads", &arguments->singlestrand, false);
@@ -127,14 +140,15 @@ static GtOptionParser* gt_readjoiner_overlap_option_parser_new(
 
   /* -elimtrans */
   option = gt_option_new_bool("elimtrans", "output only irreducible SPMs",
-      &arguments->elimtrans, true);
+      &arguments->elimtrans, GT_SPMFIND_DEFAULT_ELIMTRANS);
   gt_option_is_development_option(option);
   gt_option_parser_add_option(op, option);
 
   /* -wmax */
   option = gt_option_new_uint("wmax", "specify the maximum width of w set;\n"
                               "use 0 to disable w set partitioning",
-                              &arguments->w_maxsize, 32U);
+                              &arguments->w_maxsize,
+                              GT_SPMFIND_DEFAULT_W_MAXSIZE);
   gt_option_is_development_option(option);
   gt_option_parser_add_option(op, option);
 
@@ -167,19 +181,20 @@ static GtOptionParser* gt_readjoiner_overlap_option_parser_new(
 
   /* -radixparts */
   option = gt_option_new_uint("radixparts", "specify the radixpart parameter",
-      &arguments->radixparts, 1U);
+      &arguments->radixparts, GT_SPMFIND_DEFAULT_RADIXPARTS);
   gt_option_is_development_option(option);
   gt_option_parser_add_option(op, option);
 
   /* -radixsmall */
   option = gt_option_new_bool("radixsmall", "specify the radixsmall parameter",
-      &arguments->radixsmall, false);
+      &arguments->radixsmall, GT_SPMFIND_DEFAULT_RADIXSMALL);
   gt_option_is_development_option(option);
   gt_option_parser_add_option(op, option);
 
   /* -onlyallfirstcodes */
   option = gt_option_new_bool("onlyallfirstcodes", "only determines allcodes",
-                              &arguments->onlyallfirstcodes, false);
+                              &arguments->onlyallfirstcodes,
+                              GT_SPMFIND_DEFAULT_ONLYALLFIRSTCODES);
   gt_option_is_development_option(option);
   gt_option_parser_add_option(op, option);
 
@@ -233,9 +248,8 @@ static int gt_readjoiner_overlap_runner(GT_UNUSED int argc,
   GtEncseqLoader *el = NULL;
   GtEncseq *encseq = NULL;
   GtLogger *default_logger, *verbose_logger;
-  unsigned int kmersize;
+  GtSpmfindOutput output;
   bool haserr = false;
-  bool eqlen;
   GtUword total_nof_irr_spm = 0, total_nof_trans_spm = 0;
 
   gt_error_check(err);
@@ -248,7 +262,12 @@ static int gt_readjoiner_overlap_runner(GT_UNUSED int argc,
   verbose_logger = gt_logger_new(arguments->verbose, GT_LOGGER_DEFLT_PREFIX,
       stdout);
   gt_logger_log(verbose_logger, "verbose output activated");
-  kmersize = GT_MIN((unsigned int) GT_UNITSIN2BITENC,arguments->minmatchlength);
+  if (arguments->showspm)
+    output = GT_SPMFIND_OUTPUT_SHOW;
+  else if (strcmp(gt_str_get(arguments->spmformat), "varint") == 0)
+    output = GT_SPMFIND_OUTPUT_VARINT;
+  else
+    output = GT_SPMFIND_OUTPUT_BIN;
 
   el = gt_encseq_loader_new();
   gt_encseq_loader_drop_description_support(el);
@@ -258,9 +277,6 @@ static int gt_readjoiner_overlap_runner(GT_UNUSED int argc,
   if (encseq == NULL)
     haserr = true;
 
-  if (!haserr)
-    eqlen = gt_encseq_accesstype_get(encseq) == GT_ACCESS_TYPE_EQUALLENGTH;
-
   if (!haserr && !arguments->singlestrand)
   {
     if (gt_encseq_mirror(encseq, err) != 0)
@@ -268,81 +284,15 @@ static int gt_readjoiner_overlap_runner(GT_UNUSED int argc,
   }
   if (!haserr)
   {
-    unsigned int threadcount;
-#ifdef GT_THREADS_ENABLED
-    const unsigned int threads = gt_jobs;
-#else
-    const unsigned int threads = 1U;
-#endif
-    if (eqlen)
-    {
-      GtBUstate_spmeq **state_table
-        = gt_malloc(sizeof (*state_table) * threads);
-
-      for (threadcount = 0; threadcount < threads; threadcount++)
-      {
-        state_table[threadcount]
-          = gt_spmfind_eqlen_state_new(encseq,
-                (GtUword)arguments->minmatchlength,
-                (GtUword)arguments->w_maxsize, arguments->elimtrans,
-                arguments->showspm, gt_str_get(arguments->encseqinput),
-                threadcount, default_logger, verbose_logger, err);
-      }
-      if (storefirstcodes_getencseqkmers_twobitencoding(encseq, kmersize,
-            arguments->numofparts, arguments->maximumspace,
-            arguments->minmatchlength, false, false,
-            arguments->onlyallfirstcodes, 5U, arguments->phase2extra,
-            arguments->radixsmall, arguments->radixparts,
-            gt_spmfind_eqlen_process, gt_spmfind_eqlen_process_end,
-            state_table, verbose_logger, err)
-            != 0)
-      {
-        haserr = true;
-      }
-      for (threadcount = 0; threadcount < threads; threadcount++)
-      {
-        total_nof_irr_spm +=
-          gt_spmfind_eqlen_nof_irr_spm(state_table[threadcount]);
-        total_nof_trans_spm +=
-          gt_spmfind_eqlen_nof_trans_spm(state_table[threadcount]);
-        gt_spmfind_eqlen_state_delete(state_table[threadcount]);
-      }
-      gt_free(state_table);
-    }
-    else
+    if (gt_spmfind_all(encseq, arguments->minmatchlength,
+          (GtUword)arguments->w_maxsize, arguments->elimtrans, output, NULL,
+          gt_str_get(arguments->encseqinput), arguments->numofparts,
+          arguments->maximumspace, arguments->phase2extra,
+          arguments->radixsmall, arguments->radixparts,
+          arguments->onlyallfirstcodes, &total_nof_irr_spm,
+          &total_nof_trans_spm, default_logger, verbose_logger, err) != 0)
     {
-      GtBUstate_spmvar **state_table
-        = gt_malloc(sizeof (*state_table) * threads);
-
-      for (threadcount = 0; threadcount < threads; threadcount++)
-      {
-        state_table[threadcount]
-           = gt_spmfind_varlen_state_new(encseq,
-                  (GtUword)arguments->minmatchlength,
-                  (GtUword)arguments->w_maxsize, arguments->elimtrans,
-                  arguments->showspm, gt_str_get(arguments->encseqinput),
-                  threadcount, default_logger, verbose_logger, err);
-      }
-      if (storefirstcodes_getencseqkmers_twobitencoding(encseq, kmersize,
-            arguments->numofparts, arguments->maximumspace,
-            arguments->minmatchlength, false, false,
-            arguments->onlyallfirstcodes, 5U, arguments->phase2extra,
-            arguments->radixsmall, arguments->radixparts,
-            gt_spmfind_varlen_process, gt_spmfind_varlen_process_end,
-            state_table, verbose_logger, err)
-          != 0)
-      {
-        haserr = true;
-      }
-      for (threadcount = 0; threadcount < threads; threadcount++)
-      {
-        gt_spmfind_varlen_state_delete(state_table[threadcount]);
-        total_nof_irr_spm +=
-          gt_spmfind_varlen_nof_irr_spm(state_table[threadcount]);
-        total_nof_trans_spm +=
-          gt_spmfind_varlen_nof_trans_spm(state_table[threadcount]);
-      }
-      gt_free(state_table);
+      haserr = true;
     }
   }
   if (!haserr)
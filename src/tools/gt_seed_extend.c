@@ -78,6 +78,7 @@ typedef struct {
   GtStr *char_access_mode, *splt_string, *kmplt_string;
   bool bias_parameters;
   bool relax_polish;
+  bool wfa_realign;
   bool verify_alignment;
   bool only_selected_seqpairs;
   bool cam_generic;
@@ -156,7 +157,7 @@ static GtOptionParser* gt_seed_extend_option_parser_new(void *tool_arguments)
     *op_norev, *op_nofwd, *op_part, *op_pick, *op_overl, *op_trimstat,
     *op_cam_generic, *op_diagbandwidth, *op_mincoverage, *op_maxmat,
     *op_use_apos, *op_use_apos_track_all, *op_chain, *op_diagband_statistics,
-    *op_ani, *op_benchmark;
+    *op_ani, *op_benchmark, *op_wfa;
 
   static GtRange seedpairdistance_defaults = {1UL, GT_UWORD_MAX};
   /* When extending the following array, do not forget to update
@@ -498,6 +499,17 @@ static GtOptionParser* gt_seed_extend_option_parser_new(void *tool_arguments)
   /*gt_option_exclude(op_maxmat, op_relax_polish);*/
   gt_option_is_development_option(op_relax_polish);
 
+  /* -wfa */
+  op_wfa = gt_option_new_bool("wfa",
+                              "realign the matches delivered by the extension "
+                              "with the wavefront algorithm, such that the "
+                              "reported alignments and distances are optimal "
+                              "for unit edit costs",
+                              &arguments->wfa_realign,false);
+  gt_option_parser_add_option(op, op_wfa);
+  gt_option_exclude(op_maxmat, op_wfa);
+  gt_option_exclude(op_onlyseeds, op_wfa);
+
   /* -verify-alignment */
   op_verify_alignment
     = gt_option_new_bool("verify-alignment",
@@ -655,6 +667,7 @@ static GtOptionParser* gt_seed_extend_option_parser_new(void *tool_arguments)
   gt_option_exclude(op_diagband_statistics, op_use_apos_track_all);
   gt_option_exclude(op_diagband_statistics, op_minlen);
   gt_option_exclude(op_diagband_statistics, op_ani);
+  gt_option_exclude(op_diagband_statistics, op_wfa);
   gt_option_exclude(op_ani, op_outfmt);
   gt_option_exclude(op_ani, op_onlyseeds);
   gt_option_exclude(op_ani, op_verify_alignment);
@@ -1203,6 +1216,7 @@ static int gt_seed_extend_runner(int argc,
                                              !arguments->relax_polish,
                                              arguments->verify_alignment,
                                              arguments->only_selected_seqpairs,
+                                             arguments->wfa_realign,
                                              arguments->compute_ani
                                                ? &ani_accumulate[0]
                                                : NULL);
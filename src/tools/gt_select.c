@@ -29,6 +29,7 @@
 #include "extended/gff3_parser.h"
 #include "extended/gff3_visitor.h"
 #include "extended/gtdatahelp.h"
+#include "extended/pipeline_stream_api.h"
 #include "extended/select_stream.h"
 #include "extended/targetbest_select_stream.h"
 #include "tools/gt_select.h"
@@ -40,7 +41,8 @@ typedef struct {
   bool verbose,
        has_CDS,
        targetbest,
-       retainids;
+       retainids,
+       threads;
   GtStr *seqid,
         *source,
         *gt_strand_char,
@@ -256,6 +258,13 @@ static GtOptionParser* gt_select_option_parser_new(void *tool_arguments)
                                              arguments->dropped_file);
   gt_option_parser_add_option(op, optiondroppedfile);
 
+  /* -threads */
+  option = gt_option_new_bool("threads", "run parsing, selection, and output "
+                              "of the features concurrently on separate "
+                              "threads (pipelined execution)",
+                              &arguments->threads, false);
+  gt_option_parser_add_option(op, option);
+
   /* -v */
   option = gt_option_new_verbose(&arguments->verbose);
   gt_option_parser_add_option(op, option);
@@ -332,7 +341,8 @@ static int gt_select_runner(int argc, const char **argv, int parsed_args,
 {
   SelectArguments *arguments = tool_arguments;
   GtNodeStream *gff3_in_stream, *select_stream,
-               *targetbest_select_stream = NULL, *gff3_out_stream;
+               *targetbest_select_stream = NULL, *gff3_out_stream,
+               *in_pipeline_stream = NULL, *out_pipeline_stream = NULL;
   int had_err;
   GtFile *drop_file = NULL;
   GtNodeVisitor *gff3outvis = NULL;
@@ -345,8 +355,14 @@ static int gt_select_runner(int argc, const char **argv, int parsed_args,
   if (arguments->verbose && arguments->outfp)
     gt_gff3_in_stream_show_progress_bar((GtGFF3InStream*) gff3_in_stream);
 
+  /* parse on a separate thread (if necessary) */
+  if (arguments->threads)
+    in_pipeline_stream = gt_pipeline_stream_new(gff3_in_stream, 0);
+
   /* create a filter stream */
-  select_stream = gt_select_stream_new(gff3_in_stream, arguments->seqid,
+  select_stream = gt_select_stream_new(in_pipeline_stream
+                                       ? in_pipeline_stream
+                                       : gff3_in_stream, arguments->seqid,
                                        arguments->source,
                                        &arguments->contain_range,
                                        &arguments->overlap_range,
@@ -381,10 +397,19 @@ static int gt_select_runner(int argc, const char **argv, int parsed_args,
     if (arguments->targetbest)
       targetbest_select_stream = gt_targetbest_select_stream_new(select_stream);
 
+    /* select on a separate thread (if necessary) */
+    if (arguments->threads) {
+      out_pipeline_stream = gt_pipeline_stream_new(arguments->targetbest
+                                                   ? targetbest_select_stream
+                                                   : select_stream, 0);
+    }
+
     /* create a gff3 output stream */
-    gff3_out_stream = gt_gff3_out_stream_new(arguments->targetbest
-                                             ? targetbest_select_stream
-                                             : select_stream,
+    gff3_out_stream = gt_gff3_out_stream_new(out_pipeline_stream
+                                             ? out_pipeline_stream
+                                             : arguments->targetbest
+                                               ? targetbest_select_stream
+                                               : select_stream,
                                              arguments->outfp);
 
     if (arguments->retainids)
@@ -396,6 +421,7 @@ static int gt_select_runner(int argc, const char **argv, int parsed_args,
 
     /* free */
     gt_node_stream_delete(gff3_out_stream);
+    gt_node_stream_delete(out_pipeline_stream);
     gt_node_stream_delete(select_stream);
     gt_node_stream_delete(targetbest_select_stream);
   } else {
@@ -403,6 +429,7 @@ static int gt_select_runner(int argc, const char **argv, int parsed_args,
   }
   gt_file_delete(drop_file);
   gt_node_visitor_delete(gff3outvis);
+  gt_node_stream_delete(in_pipeline_stream);
   gt_node_stream_delete(gff3_in_stream);
   return had_err;
 }
@@ -23,7 +23,9 @@ opt_arr = ["-brute_force yes -diagonals no",
            "-diagonals no",
            "-diagonals yes",
            "-full_diags yes",
-           "-diagonals no -full_diags yes"]
+           "-diagonals no -full_diags yes",
+           "-diagonals no -batchsize 5",
+           "-diagonals yes -batchsize 5"]
 
 [["-range 0 5", "option \"-range\" requires option \"-output\""]
 ].each_with_index do |arr, num|
@@ -216,6 +218,61 @@ opt_arr.each do |opt|
   end
 end
 
+Name "gt condenseq compress batches independent of threads"
+Keywords "gt_condenseq compress batchsize"
+Test do
+  file = "#{$testdata}condenseq/varlen_50.fas"
+  basename = File.basename(file)
+  run_test "#{$bin}gt encseq encode -clipdesc -indexname #{basename} " \
+    "-md5 no #{file}"
+  ["-diagonals no", "-diagonals yes",
+   "-brute_force yes -diagonals no"].each do |opt|
+    [1, 3].each do |jobs|
+      run_test "#{$bin}gt -j #{jobs} condenseq compress #{opt} " \
+        "-batchsize 7 -indexname #{basename}_j#{jobs} -cutoff 0 " \
+        "-alignlength 100 -kmersize 4 #{basename}", :maxtime => 600
+    end
+    run "cmp #{basename}_j1.cse #{basename}_j3.cse"
+    run "cmp #{basename}_j1.fas #{basename}_j3.fas"
+    run_test "#{$bin}gt condenseq extract #{basename}_j3 > #{basename}_j3.ext"
+    run_test "#{$bin}gt encseq decode -output fasta #{basename} > " \
+      "#{basename}.dec"
+    run "diff #{basename}.dec #{basename}_j3.ext"
+  end
+end
+
+Name "gt condenseq extract with cache and threads"
+Keywords "gt_condenseq extract cachesize"
+Test do
+  file = "#{$testdata}condenseq/varlen_50.fas"
+  basename = File.basename(file)
+  run_test "#{$bin}gt encseq encode -clipdesc -indexname #{basename} " \
+    "-md5 no #{file}"
+  run_test "#{$bin}gt condenseq compress -indexname #{basename}_nr " \
+    "-cutoff 0 -alignlength 100 -kmersize 4 #{basename}", :maxtime => 600
+  run_test "#{$bin}gt encseq decode -output fasta #{basename} > " \
+    "#{basename}.dec"
+  run_test "#{$bin}gt encseq decode -output concat -range 3000 10000 " \
+    "#{basename} > #{basename}_range.dec"
+  run_test "#{$bin}gt encseq decode -output fasta -seqrange 5 20 " \
+    "#{basename} > #{basename}_seqs.dec"
+  # a small cache forces evictions, a large one keeps all elements
+  [0, 150, 1000000].each do |cachesize|
+    [1, 3].each do |jobs|
+      run_test "#{$bin}gt -j #{jobs} condenseq extract " \
+        "-cachesize #{cachesize} #{basename}_nr"
+      run "diff #{last_stdout} #{basename}.dec"
+      run_test "#{$bin}gt -j #{jobs} condenseq extract " \
+        "-cachesize #{cachesize} -range 3000 10000 -output concat " \
+        "#{basename}_nr"
+      run "diff #{last_stdout} #{basename}_range.dec"
+      run_test "#{$bin}gt -j #{jobs} condenseq extract " \
+        "-cachesize #{cachesize} -seqrange 5 20 #{basename}_nr"
+      run "diff #{last_stdout} #{basename}_seqs.dec"
+    end
+  end
+end
+
 Name "gt condenseq compress options fail"
 Keywords "gt_condenseq compress options fail"
 Test do
@@ -238,6 +295,8 @@ Test do
      /not compatible/],
     ["-full_diags yes -indexname foo -brute_force #{basename}",
      /not compatible/],
+    ["-full_diags yes -indexname foo -batchsize 4 #{basename}",
+     /not compatible/],
     ["-indexname foo -kmersize 8 -windowsize 8 -cutoff 0 -disable_prune " \
      "#{basename}",
      "'-cutoff 0' disables cutoffs, so '-disable_prune' should not be set"],
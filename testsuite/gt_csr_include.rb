@@ -86,6 +86,26 @@ Test do
   end
 end
 
+Name "gt hcr decompress ranges in parallel"
+Keywords "gt_csr hcr sampling parallel"
+Test do
+  file = "#$testdata/#{hcr_testfiles[0]}"
+  ["-stype regular -srate 7", "-stype regular -srate 1",
+   "-stype page -srate 1"].each do |testcase|
+    run_test "#$bin/gt compreads compress -descs #{testcase} " \
+             "-files #{file} -name test"
+    [1, 3].each do |jobs|
+      run_test "#$bin/gt -j #{jobs} compreads decompress -descs -file test"
+      run_test "diff test.fastq #{file}"
+      [[0, 0], [5, 30], [13, 99], [99, 99]].each do |first, last|
+        run_test "#$bin/gt -j #{jobs} compreads decompress -descs " \
+                 "-range #{first} #{last} -file test"
+        run "sed -n '#{first * 4 + 1},#{(last + 1) * 4}p' #{file}"
+        run_test "diff test.fastq #{last_stdout}"
+      end
+    end
+  end
+end
 
 rcr_testfiles = {
   "rcr_testreads_on_seq.bam" => "rcr_testseq.fa",
@@ -95,7 +115,7 @@ rcr_testfiles = {
 Name "gt rcr reads noqual"
 Keywords "gt_csr rcr"
 Test do
-  rcr_testfiles.keys do |file|
+  rcr_testfiles.keys.each do |file|
     run_test "#$bin/gt encseq encode -dna"          \
              " -indexname ./#{rcr_testfiles[file]}" \
              " #$testdata/#{rcr_testfiles[file]}"
@@ -112,7 +132,7 @@ end
 Name "gt rcr reads qual"
 Keywords "gt_csr rcr"
 Test do
-  rcr_testfiles.keys do |file|
+  rcr_testfiles.keys.each do |file|
     run_test "#$bin/gt encseq encode -dna"          \
              " -indexname ./#{rcr_testfiles[file]}" \
              " #$testdata/#{rcr_testfiles[file]}"
@@ -130,7 +150,7 @@ end
 Name "gt rcr reads variant qual"
 Keywords "gt_csr rcr"
 Test do
-  rcr_testfiles.keys do |file|
+  rcr_testfiles.keys.each do |file|
     run_test "#$bin/gt encseq encode -dna"          \
              " -indexname ./#{rcr_testfiles[file]}" \
              " #$testdata/#{rcr_testfiles[file]}"
@@ -148,7 +168,7 @@ end
 Name "gt rcr reads variant qual, descriptions"
 Keywords "gt_csr rcr"
 Test do
-  rcr_testfiles.keys do |file|
+  rcr_testfiles.keys.each do |file|
     run_test "#$bin/gt encseq encode -dna"          \
              " -indexname ./#{rcr_testfiles[file]}" \
              " #$testdata/#{rcr_testfiles[file]}"
@@ -159,7 +179,18 @@ Test do
              " -name #{file}"
     run_test "#$bin/gt compreads refdecompress" \
              " -ref ./#{rcr_testfiles[file]}"   \
-             " -rcr ./#{file}"
+             " -rcr ./#{file}"   \
              " -qnames"
   end
 end
+
+Name "gt dev codecbench"
+Keywords "gt_csr codecbench"
+Test do
+  run_test "#$bin/gt dev codecbench -runs 2" \
+           " #$testdata/fastq_long.fastq #$testdata/csr_testcase.fastq"
+  grep last_stdout, /^elias gamma \(qual runs\)\t5753\t/
+  run_test "#$bin/gt dev codecbench -runs 1 -pages 1" \
+           " #$testdata/fastq_long.fastq"
+  run_test "#$bin/gt dev codecbench #$testdata/test1.fasta", :retval => 1
+end
@@ -66,3 +66,69 @@ if not $arguments["nordb"] then
   end
 
 end
+
+Name "gt featureindex file backend (empty file)"
+Keywords "gt_featureindex"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend file -filename tmp.idx " +
+      "#{$testdata}/gt_view_prob_1.gff3"
+  run "#{$bin}gt featureindex -backend file -filename tmp.idx", :retval => 1
+  grep(last_stderr, /no sequence regions in index/)
+end
+
+Name "gt featureindex file backend (existing file)"
+Keywords "gt_featureindex"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend file -filename tmp.idx " +
+      "#{$testdata}/standard_gene_simple.gff3"
+  run "#{$bin}gt mkfeatureindex -backend file -filename tmp.idx " +
+      "#{$testdata}/standard_gene_simple.gff3", :retval => 1
+  grep(last_stderr, /exists already/)
+  run "#{$bin}gt mkfeatureindex -force -backend file -filename tmp.idx " +
+      "#{$testdata}/standard_gene_simple.gff3"
+end
+
+Name "gt featureindex file backend (invalid sequence ID)"
+Keywords "gt_featureindex"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend file -filename tmp.idx " +
+      "#{$testdata}/standard_gene_simple.gff3"
+  run "#{$bin}gt featureindex -backend file -seqid foo -filename tmp.idx",
+      :retval => 1
+  grep(last_stderr, /does not contain/)
+end
+
+Name "gt featureindex file backend (corrupt file)"
+Keywords "gt_featureindex"
+Test do
+  File.open("corrupt.idx", "w") do |file|
+    file.write("sdfnhsnlsdfnhsnlsdfnhsnlsdfnhsnlsdfnhsnlsdfnhsnlsdfnhsnl")
+  end
+  run "#{$bin}gt featureindex -backend file -filename corrupt.idx",
+      :retval => 1
+  grep(last_stderr, /is not a feature index file/)
+end
+
+["eden.gff3",
+ "standard_gene_simple.gff3",
+ "standard_gene_as_tree.gff3",
+ "standard_gene_with_introns_as_tree.gff3",
+ "encode_known_genes_Mar07.gff3"].each do |file|
+  Name "gt featureindex file backend vs. parser (#{file})"
+  Keywords "gt_featureindex"
+  Test do
+    run "#{$bin}gt seqids #{$testdata}/#{file}"
+    seqids = File.open(last_stdout).readlines
+    run "#{$bin}gt mkfeatureindex -backend file -filename tmp.idx " +
+        "#{$testdata}/#{file}"
+    seqids.each do |seqid|
+      seqid.chomp!
+      # the file backend reports the range covered by the features
+      run "#{$bin}gt featureindex -backend file -seqid #{seqid} -retain no " +
+          "-filename tmp.idx | grep -v sequence-region > out.gff3"
+      run "#{$bin}gt gff3 -retainids no #{$testdata}/#{file} | " +
+          "#{$bin}gt select -seqid #{seqid} | grep -v sequence-region"
+      run "diff out.gff3 #{last_stdout}"
+    end
+  end
+end
@@ -379,3 +379,22 @@ Test do
     failtest("different results pck-esa #{result[0]},#{result[1]}")
   end
 end
+
+Name "gt genomediff pck split traversal"
+Keywords "gt_genomediff pck splitdepth"
+Test do
+  realfiles = allfiles.collect {|file| "#{$testdata}#{file}"}.join(" ")
+  test_pck(realfiles, "-splitdepth 0", "")
+  run "mv #{last_stdout} nosplit.out"
+  [1, 2, 4, 9, 100].each do |depth|
+    run_test "#{$bin}gt genomediff -splitdepth #{depth} -indextype pck pck"
+    run "diff #{last_stdout} nosplit.out"
+    run_test "#{$bin}gt -j 3 genomediff -splitdepth #{depth} " +
+             "-indextype pck pck"
+    run "diff #{last_stdout} nosplit.out"
+  end
+  test_pck("#{smallfilecodes[0]}*.fas", "-splitdepth 0", "-mirrored")
+  run "mv #{last_stdout} nosplit.out"
+  run_test "#{$bin}gt -j 2 genomediff -splitdepth 3 -indextype pck pck"
+  run "diff #{last_stdout} nosplit.out"
+end
@@ -68,6 +68,29 @@ Test do
   run "diff #{last_stdout} #{$testdata}gt_gff3_prob_5.out"
 end
 
+Name "gt gff3 prob 5 (-threads)"
+Keywords "gt_gff3 threads"
+Test do
+  run_test "#{$bin}gt gff3 -threads -sort #{$testdata}gt_gff3_prob_5.in"
+  run "diff #{last_stdout} #{$testdata}gt_gff3_prob_5.out"
+end
+
+Name "gt gff3 prob 6 (-threads)"
+Keywords "gt_gff3 threads"
+Test do
+  run_test("#{$bin}gt gff3 -threads -sort #{$testdata}gt_gff3_prob_6.in",
+           :retval => 1)
+  grep(last_stderr, /does not contain/);
+end
+
+Name "gt gff3 -threads -checkids"
+Keywords "gt_gff3 threads checkids"
+Test do
+  run_test("#{$bin}gt gff3 -threads -checkids -sort " +
+           "#{$testdata}gt_gff3_prob_5.in", :retval => 1)
+  grep(last_stderr, /exclude each other/);
+end
+
 Name "gt gff3 prob 6"
 Keywords "gt_gff3"
 Test do
@@ -0,0 +1,45 @@
+Name "gt gff3_index (no index)"
+Keywords "gt_gff3_index"
+Test do
+  run "#{$bin}gt gff3 -sort #{$testdata}encode_known_genes_Mar07.gff3 > " +
+      "sorted.gff3"
+  run "#{$bin}gt gff3_index -compress sorted.gff3"
+  run "rm sorted.gff3.gz.gti"
+  run_test("#{$bin}gt gff3_index -seqid chr1 sorted.gff3.gz", :retval => 1)
+  grep(last_stderr, /no index found/)
+end
+
+Name "gt gff3_index (unsorted input)"
+Keywords "gt_gff3_index"
+Test do
+  run "cp #{$testdata}unsorted_gff3_file.txt unsorted.gff3"
+  run_test("#{$bin}gt gff3_index -compress unsorted.gff3", :retval => 1)
+  grep(last_stderr, /is not sorted/)
+end
+
+Name "gt gff3_index (plain input)"
+Keywords "gt_gff3_index"
+Test do
+  run_test("#{$bin}gt gff3_index #{$testdata}standard_gene_as_tree.gff3",
+           :retval => 1)
+  grep(last_stderr, /is not BGZF compressed/)
+end
+
+[["chr1", ""],
+ ["chr1", "-range 147990000 148100000"],
+ ["chr22", "-range 1 30000000"],
+ ["chrX", ""],
+ ["chr2", "-range 1 10"]].each do |seqid, range|
+  Name "gt gff3_index (-seqid #{seqid} #{range})"
+  Keywords "gt_gff3_index"
+  Test do
+    run "#{$bin}gt gff3 -sort #{$testdata}encode_known_genes_Mar07.gff3 > " +
+        "sorted.gff3"
+    run_test "#{$bin}gt gff3_index -compress sorted.gff3"
+    run_test "#{$bin}gt gff3_index -seqid #{seqid} #{range} sorted.gff3.gz"
+    run "mv #{last_stdout} indexed.gff3"
+    overlap = range.sub(/-range/, "-overlap")
+    run_test "#{$bin}gt select -seqid #{seqid} #{overlap} sorted.gff3"
+    run "diff #{last_stdout} indexed.gff3"
+  end
+end
@@ -106,6 +106,21 @@ Test do
   end
 end
 
+Name "gt linspace_align global threads"
+Keywords "gt_linspace_align threads"
+Test do
+  ["-l 0 1 1", "-a 0 4 1 3"].each do |costs|
+    [1, 2, 4].each do |j|
+      run_test "#{$bin}gt -j #{j} dev linspace_align -ff "\
+               "#{$testdata}gt_linspace_align_threads_1.fna "\
+               "#{$testdata}gt_linspace_align_threads_2.fna "\
+               "-dna -global #{costs} > out_j#{j}.txt", :maxtime => 120
+    end
+    run "diff out_j1.txt out_j2.txt"
+    run "diff out_j1.txt out_j4.txt"
+  end
+end
+
 Name "gt linspace_align diagonalband (invalid bounds)"
 Keywords "gt_linspace_align"
 Test do
@@ -159,6 +174,48 @@ Test do
   run "diff -i #{last_stdout} #{$testdata}gt_linspace_align_global_affine_special_cases.out"
 end
 
+Name "gt linspace_align wavefront alignment"
+Keywords "gt_linspace_align wfa"
+Test do
+  ["-l 0 1 1", "-l 1 3 2", "-a 0 2 3 1", "-a 1 4 3 2"].each do |costs|
+    run_test "#{$bin}gt dev linspace_align -ff "\
+             "#{$testdata}Ecoli-section1.fna #{$testdata}Ecoli-section2.fna "\
+             "-dna -global #{costs} -showonlyscore"
+    temp = last_stdout
+    run_test "#{$bin}gt dev linspace_align -ff "\
+             "#{$testdata}Ecoli-section1.fna #{$testdata}Ecoli-section2.fna "\
+             "-dna -global #{costs} -showonlyscore -wfa"
+    run "diff #{last_stdout} #{temp}"
+  end
+  1.upto(2) do |i|
+    run_test "#{$bin}gt dev linspace_align -ff "\
+             "#{$testdata}gt_linspace_align_affine_test_#{i}.fas "\
+             "#{$testdata}gt_linspace_align_affine_test_#{i+1}.fas "\
+             "-dna -global -a 0 2 3 1 -showonlyscore"
+    temp = last_stdout
+    run_test "#{$bin}gt dev linspace_align -ff "\
+             "#{$testdata}gt_linspace_align_affine_test_#{i}.fas "\
+             "#{$testdata}gt_linspace_align_affine_test_#{i+1}.fas "\
+             "-dna -global -a 0 2 3 1 -showonlyscore -wfa"
+    run "diff #{last_stdout} #{temp}"
+  end
+  run_test "#{$bin}gt dev linspace_align -ss acg acgt -dna -global "\
+           "-l 1 1 1 -wfa", :retval => 1
+  grep last_stderr, "wavefront alignment requires"
+end
+
+Name "gt alignbench batch alignment"
+Keywords "gt_linspace_align alignbench"
+Test do
+  ["", "-match 1 -mismatch 3", "-gapopen 3 -mismatch 2",
+   "-gapopen 300 -gapext 150"].each do |costs|
+    run_test "#{$bin}gt dev alignbench -pairs 2000 -length 100 #{costs} " \
+             "-verify"
+    run_test "#{$bin}gt dev alignbench -pairs 200 -length 100 #{costs} " \
+             "-alignments -verify"
+  end
+end
+
 Name "gt linspace_align all checkfun with gt_paircmp (dna)"
 Keywords "gt_linspace_align"
 Test do
@@ -196,6 +196,33 @@ Test do
   run_test "#{$bin}gt ltrdigest -matchdescstart -outfileprefix foo -encseq in.fasta < out.gff3"
 end
 
+Name "gt ltrdigest -pdomengine builtin"
+Keywords "gt_ltrdigest pdomengine"
+Test do
+  run "cp #{$testdata}/gt_encseq_col_test1.fasta in.fasta"
+  run_test "#{$bin}gt suffixerator -lossless -suf -lcp -dna -des -ssp -tis -v -db in.fasta"
+  run_test "#{$bin}gt ltrharvest -tabout no -seqids yes -index in.fasta > out.gff3"
+  run_test "#{$bin}gt ltrdigest -matchdescstart -encseq in.fasta -pdomengine builtin -hmms #{$testdata}ltrdigest_builtin.hmm -- out.gff3"
+  if File.read(last_stdout).lines.grep(/\tprotein_match\t/).size != 4 then
+    raise TestFailed, "expected one protein_match per candidate"
+  end
+  grep(last_stdout, /^test1\t.*protein_match\t1077\t1167\t.*\t\+\t.*name=test_plus/)
+  grep(last_stdout, /^test2\t.*protein_match\t2206\t2296\t.*\t-\t.*name=test_minus/)
+end
+
+Name "gt ltrdigest -j output independent of number of jobs"
+Keywords "gt_ltrdigest pdomengine threads"
+Test do
+  run "cp #{$testdata}/gt_encseq_col_test1.fasta in.fasta"
+  run_test "#{$bin}gt suffixerator -lossless -suf -lcp -dna -des -ssp -tis -v -db in.fasta"
+  run_test "#{$bin}gt ltrharvest -tabout no -seqids yes -index in.fasta > out.gff3"
+  [1, 2, 4].each do |j|
+    run_test "#{$bin}gt -j #{j} ltrdigest -matchdescstart -encseq in.fasta -pdomengine builtin -hmms #{$testdata}ltrdigest_builtin.hmm -- out.gff3 > out_j#{j}.gff3"
+  end
+  run "diff out_j1.gff3 out_j2.gff3"
+  run "diff out_j1.gff3 out_j4.gff3"
+end
+
 if $gttestdata then
   Name "gt ltrdigest missing input GFF"
   Keywords "gt_ltrdigest"
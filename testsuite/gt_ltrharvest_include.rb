@@ -87,6 +87,22 @@ if $gttestdata then
       run "diff #{k}_inner.fas #{$gttestdata}ltrharvest/s_cer/#{k}_inner.fas"
     end
 
+    Name "gt ltrharvest test #{k} yeast windowsize"
+    Keywords "gt_ltrharvest windowsize"
+    Test do
+      run_test "#{$bin}gt suffixerator -db #{$gttestdata}ltrharvest/s_cer/#{v}"\
+             + " -dna -tis -des -sds -ssp", :maxtime => 720
+      run_test "#{$bin}gt -j 2 ltrharvest -index #{v} -seed 100 -minlenltr 100"\
+             + " -maxlenltr 1000 -mindistltr 1500 -maxdistltr 15000 -similar 80"\
+             + " -mintsd 5 -maxtsd 20 -motif tgca -motifmis 0 -vic 60"\
+             + " -overlaps best -xdrop 5 -mat 2 -mis -2 -ins -3 -del -3"\
+             + " -windowsize 100000"\
+             + " -gff3 #{k}.gff3 -out #{k}.fas -outinner #{k}_inner.fas", \
+             :maxtime => 25000
+      run "diff #{k}.fas #{$gttestdata}ltrharvest/s_cer/#{k}.fas"
+      run "diff #{k}_inner.fas #{$gttestdata}ltrharvest/s_cer/#{k}_inner.fas"
+    end
+
     Name "gt ltrharvest test #{k} yeast longoutput"
     Keywords "gt_ltrharvest"
     Test do
@@ -284,6 +300,27 @@ Test do
   grep(last_stderr, "cannot open file 'Random159.fna.suf'")
 end
 
+Name "gt ltrharvest windowsize without suffix array"
+Keywords "gt_ltrharvest windowsize"
+Test do
+  run_test "#{$bin}gt suffixerator -db #{$testdata}Random.fna -dna -suf -sds -lcp -tis -des -ssp"
+  run_test "#{$bin}gt ltrharvest -index Random.fna -maxdistltr 2000"
+  run "grep -v '^# args' #{last_stdout} > full.out"
+  run_test "#{$bin}gt suffixerator -db #{$testdata}Random.fna -dna -sds -tis -des -ssp -indexname esqonly"
+  run_test "#{$bin}gt ltrharvest -index esqonly -maxdistltr 2000 -windowsize 4000"
+  run "grep -v '^# args' #{last_stdout} > window.out"
+  run "diff full.out window.out"
+end
+
+Name "gt ltrharvest windowsize too small"
+Keywords "gt_ltrharvest windowsize"
+Test do
+  run_test "#{$bin}gt suffixerator -db #{$testdata}Random.fna -dna -sds -tis -des -ssp"
+  run_test "#{$bin}gt ltrharvest -index Random.fna -windowsize 1000", \
+           :retval => 1
+  grep(last_stderr, "window size must be larger")
+end
+
 # test all combinations of options, test only some of them
 outlist = (["-seed 100",
             "-minlenltr 100",# "-maxlenltr 1000",
@@ -19,10 +19,11 @@ def runAndCheckPackedIndex(indexName,dbFiles, extraParams=Hash.new)
     :create => { '-tis' => nil, '-des' => nil },
     :timeOuts => { :bdxcreat => 100, :suffixerator => 100,
       :chkintegrity => 400, :chksearch => 400, :trsuftab => 100,
-      :mkctxmap => 100 },
+      :mkctxmap => 100, :mksample => 100 },
     :bdx => {},
     :chksearch => { '-chksfxarray' => nil, '-nsamples' => '100' },
-    :mkctxmap => { '-ctxilog' => -1 }
+    :mkctxmap => { '-ctxilog' => -1 },
+    :mksample => {}
   }
   extraParams.keys.each do |key|
     params[key].merge!(extraParams[key]) if params.has_key?(key)
@@ -56,6 +57,11 @@ def runAndCheckPackedIndex(indexName,dbFiles, extraParams=Hash.new)
               paramList(params[:mkctxmap]) + [indexName]).join(' '),
              :maxtime => params[:timeOuts][:mkctxmap])    
   end
+  if extraParams.has_key?(:mksample)
+    run_test((["#{$bin}gt", '-debug', 'packedindex', 'mksample'] +
+              paramList(params[:mksample]) + [indexName]).join(' '),
+             :maxtime => params[:timeOuts][:mksample])
+  end
   run_test(["#{$bin}gt", '-debug', 'packedindex', 'chkintegrity',
             '-ticks', '1000', indexName].join(' '),
            :maxtime => params[:timeOuts][:chkintegrity])
@@ -147,6 +153,78 @@ Test do
                          :bdx => { '-bsize' => 10 })
 end
 
+Name "gt packedindex check tools with interleaved rank index"
+Keywords "gt_packedindex gt_packedindex_irank"
+Test do
+  runAndCheckPackedIndex('miniindex', prependTestdata(myfilelist),
+                         :bdx => { '-irank' => nil, '-sprank' => nil },
+                         :chksearch => { '-full-lfmap' => nil },
+                         :timeOuts => { :chksearch => 800 })
+  run "test -e miniindex.irx"
+  runAndCheckPackedIndex(nil, prependTestdata(['U89959_genomic.fas']),
+                         :bdx => { '-irank' => nil })
+  run "test -e U89959_genomic.fas.irx"
+  run_test "#{$bin}gt packedindex mkindex -tis -indexname miniindex " +
+           "-db #{$testdata}trna_glutamine.fna"
+  run "test ! -e miniindex.irx"
+  run_test "#{$bin}gt packedindex mkindex -tis -irank " +
+           "-db #{$testdata}sw100K2.fsa", :retval => 1
+  grep last_stderr, "at most 4 regular symbols"
+end
+
+Name "gt packedindex batch search"
+Keywords "gt_packedindex gt_packedindex_batch"
+Test do
+  allfiles = prependTestdata(myfilelist)
+  runAndCheckPackedIndex('miniindex', allfiles,
+                         :chksearch => { '-batch' => 100,
+                                         '-nsamples' => 1000 })
+  runAndCheckPackedIndex('miniindex', allfiles,
+                         :bdx => { '-irank' => nil },
+                         :chksearch => { '-batch' => 7,
+                                         '-nsamples' => 1000,
+                                         '-minpatlen' => 2,
+                                         '-maxpatlen' => 12 })
+  runAndCheckPackedIndex('miniindex', allfiles,
+                         :bdx => { '-irank' => nil, '-locfreq' => 0 },
+                         :chksearch => { '-batch' => 3000,
+                                         '-nsamples' => 5000,
+                                         '-chksfxarray' => 'no' })
+end
+
+Name "gt packedindex suffix array samples"
+Keywords "gt_packedindex gt_packedindex_mksample"
+Test do
+  allfiles = prependTestdata(myfilelist)
+  runAndCheckPackedIndex('miniindex', allfiles,
+                         :mksample => { '-rate' => 5 },
+                         :chksearch => { '-nsamples' => 1000 })
+  run "test -e miniindex.ssx"
+  run_test "#{$bin}gt packedindex chksearch -nsamples 1000 -batch 50 " +
+           "-loccache 8 -minpatlen 1 -maxpatlen 6 miniindex"
+  runAndCheckPackedIndex('miniindex', allfiles,
+                         :bdx => { '-locfreq' => 0 },
+                         :mksample => { '-rate' => 3 })
+  runAndCheckPackedIndex('miniindex', allfiles,
+                         :bdx => { '-sprank' => nil },
+                         :mksample => { '-rate' => 1 },
+                         :chksearch => { '-batch' => 20 })
+  # regenerate the suffix array from the index for a new sampling rate
+  run "mv miniindex.suf miniindex.suf.bak"
+  run_test "#{$bin}gt packedindex mksample -rate 17 miniindex"
+  run "mv miniindex.suf.bak miniindex.suf"
+  run_test "#{$bin}gt packedindex chksearch -chksfxarray -batch 20 miniindex"
+  run_test "#{$bin}gt packedindex mksample -rate 0 miniindex"
+  run "test ! -e miniindex.ssx"
+  run_test "#{$bin}gt packedindex mksample -rate 4 miniindex"
+  run_test "#{$bin}gt packedindex mkindex -tis -locfreq 0 " +
+           "-indexname miniindex -db #{allfiles.join(' ')}"
+  run "test ! -e miniindex.ssx"
+  run "rm -f miniindex.suf"
+  run_test "#{$bin}gt packedindex mksample miniindex", :retval => 1
+  grep last_stderr, "does not contain sufficient information"
+end
+
 Name "gt packedindex check tools for at1MB"
 Keywords "gt_packedindex"
 Test do
@@ -1093,6 +1093,61 @@ Test do
   run "diff reads.contigs.fas #$testdata/readjoiner/3_varlen_seq.contigs.fas"
 end
 
+%w{30x_long_varlen 30x_800nt 70x_100nt}.each do |fasta|
+  Name "gt readjoiner: varint SPM files and -overlap: #{fasta}"
+  Keywords "gt_readjoiner gt_readjoiner_overlap gt_readjoiner_varint"
+  Test do
+    run_prefilter("#$testdata/readjoiner/#{fasta}.fas")
+    run_overlap(30)
+    run_assembly("-errors")
+    run "mv reads.contigs.fas reads.bin.contigs.fas"
+    run_overlap(30, "-spmformat varint")
+    run_assembly("-errors")
+    run "diff reads.contigs.fas reads.bin.contigs.fas"
+    run "rm reads.contigs.fas"
+    run "cp reads.0.spm reads.0.spm.orig"
+    run_assembly("-errors -overlap -l 30 -spmmemlimit 1MB")
+    run "diff reads.contigs.fas reads.bin.contigs.fas"
+    # the SPM files of the overlap phase are left alone
+    run "cmp reads.0.spm reads.0.spm.orig"
+  end
+end
+
+Name "gt readjoiner assembly: output independent of number of jobs"
+Keywords "gt_readjoiner gt_readjoiner_assembly gt_readjoiner_threads"
+Test do
+  # reads of length 100 every 10 positions of the first 30 kb of at1MB,
+  # every second one reverse complemented
+  genome = File.read("#$testdata/at1MB").split(/^>.*\n/).join.delete("\n")
+  genome = genome[0, 30000].upcase.tr("^ACGT", "A")
+  File.open("genome_reads.fas", "w") do |f|
+    0.step(genome.length - 100, 10).each_with_index do |pos, i|
+      read = genome[pos, 100]
+      read = read.reverse.tr("ACGT", "TGCA") if i.odd?
+      f.puts ">r#{i}", read
+    end
+  end
+  run_prefilter("genome_reads.fas")
+  # the small vertex ranges let all threads process parts of the graph
+  [1, 2, 4].each do |jobs|
+    rdjA_jobs = "#{$bin}gt -j #{jobs} readjoiner assembly -readset reads " +
+                "-vrangeminsize 256"
+    run "rm -f reads.*.spm"
+    run "#{$bin}gt -j #{jobs} readjoiner overlap -readset reads -l 40 " +
+        "-elimtrans false"
+    nspmfiles = Dir.glob("reads.*.spm").length
+    run_test "#{rdjA_jobs} -spmfiles #{nspmfiles} -redtrans -errors"
+    run "mv reads.contigs.fas contigs.redtrans.#{jobs}"
+    run_test "#{rdjA_jobs} -overlap -l 40 -errors"
+    run "mv reads.contigs.fas contigs.overlap.#{jobs}"
+  end
+  ["redtrans", "overlap"].each do |mode|
+    [2, 4].each do |jobs|
+      run "diff contigs.#{mode}.1 contigs.#{mode}.#{jobs}"
+    end
+  end
+end
+
 # gfa
 [1, 2].each do |gfa_version|
   %w{30x_long_varlen contained_varlen 30x_800nt 70x_100nt}.each do |fasta|
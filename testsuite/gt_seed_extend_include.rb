@@ -470,6 +470,40 @@ Test do
   end
 end
 
+Name "gt seed_extend: realignment with wavefront algorithm"
+Keywords "gt_seed_extend wfa"
+Test do
+  run_test build_encseq("at1MB", "#{$testdata}at1MB")
+  for ext in ["greedy", "xdrop"] do
+    run_test "#{$bin}gt seed_extend -extend#{ext} -l 100 -minidentity 80 " +
+             "-ii at1MB -wfa -verify-alignment -outfmt alignment=70",
+             :retval => 0
+    run_test "#{$bin}gt seed_extend -extend#{ext} -l 100 -minidentity 80 " +
+             "-ii at1MB -wfa -outfmt cigar", :retval => 0
+    run "diff -I '^#' #{last_stdout} #{$testdata}see-ext-at1MB-wfa-#{ext}.cigar"
+  end
+  # the realigned matches keep their coordinates, but never have a larger
+  # edit distance than the matches of the default greedy extension
+  run_test "#{$bin}gt seed_extend -extendgreedy -l 100 -minidentity 80 " +
+           "-ii at1MB -outfmt cigar", :retval => 0
+  default = File.readlines(last_stdout).grep_v(/^#/)
+  realigned = File.readlines("#{$testdata}see-ext-at1MB-wfa-greedy.cigar").
+                   grep_v(/^#/)
+  if default.length != realigned.length then
+    raise TestFailed, "-wfa changed the number of matches"
+  end
+  default.zip(realigned).each do |d, r|
+    d_fields = d.split
+    r_fields = r.split
+    if d_fields[0..6] != r_fields[0..6] then
+      raise TestFailed, "-wfa changed match coordinates: #{r}"
+    end
+    if r_fields[8].to_i > d_fields[8].to_i then
+      raise TestFailed, "-wfa increased the edit distance: #{r}"
+    end
+  end
+end
+
 # Greedy extension options
 Name "gt seed_extend: history, percmathistory, maxalilendiff"
 Keywords "gt_seed_extend extendgreedy history percmathistory maxalilendiff"
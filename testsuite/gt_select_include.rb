@@ -12,6 +12,14 @@ Test do
   run "diff #{last_stdout} #{$testdata}standard_gene_as_tree.gff3"
 end
 
+Name "gt select test (-seqid ctg123 -threads)"
+Keywords "gt_select threads"
+Test do
+  run_test "#{$bin}gt select -threads -seqid ctg123 " +
+           "#{$testdata}standard_gene_as_tree.gff3"
+  run "diff #{last_stdout} #{$testdata}standard_gene_as_tree.gff3"
+end
+
 Name "gt select test (-seqid undef)"
 Keywords "gt_select"
 Test do